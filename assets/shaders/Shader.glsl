@@ -245,15 +245,61 @@ uniform mat4 uMV;
 uniform mat4 uViewMat;
 uniform mat3 uNormalMat;
 uniform vec3 uSunDirection;
+#ifdef USE_QUANTIZED_POSITIONS
+// The quantized positions are relative to the bounding box of the mesh, it's the identity for the other formats
+uniform vec3 uPositionScale;
+uniform vec3 uPositionOffset;
+#endif
+#ifdef USE_MULTI_DRAW
+// The parameters of the draws of the multi draw indirect, with the layout of IndirectDrawer::DrawParams
+struct DrawParams {
+    mat4 mvp;
+    mat4 mv;
+    mat3 normalMat;
+    vec4 positionScale;
+    vec4 positionOffset;
+};
+layout (std430, binding = 0) readonly buffer DrawParamsBuffer {
+    DrawParams uDrawParams[];
+};
+uniform bool uUseDrawParams;
+// The index of the parameters of the first draw of the multi draw, gl_DrawID starts at 0 in each call
+uniform int uDrawOffset;
+#endif
 // ==========================================
 
 void main() {
+    mat4 mvp = uMVP;
+    mat4 mv = uMV;
+    mat3 normalMat = uNormalMat;
+    #ifdef USE_QUANTIZED_POSITIONS
+    vec3 positionScale = uPositionScale;
+    vec3 positionOffset = uPositionOffset;
+    #endif
+    #ifdef USE_MULTI_DRAW
+    if (uUseDrawParams) {
+        DrawParams drawParams = uDrawParams[uDrawOffset + gl_DrawID];
+        mvp = drawParams.mvp;
+        mv = drawParams.mv;
+        normalMat = drawParams.normalMat;
+        #ifdef USE_QUANTIZED_POSITIONS
+        positionScale = drawParams.positionScale.xyz;
+        positionOffset = drawParams.positionOffset.xyz;
+        #endif
+    }
+    #endif
+
     vec4 transformedPosition;
+    #ifdef USE_QUANTIZED_POSITIONS
+    vec3 position = aPos * positionScale + positionOffset;
+    #else
+    vec3 position = aPos;
+    #endif
 
     #ifdef USE_INSTANCING
-    transformedPosition = uMVP * vec4(aPos + instancePos, 1.0);
+    transformedPosition = mvp * vec4(position + instancePos, 1.0);
     #else
-    transformedPosition = uMVP * vec4(aPos, 1.0);
+    transformedPosition = mvp * vec4(position, 1.0);
     #endif
 
     gl_Position = transformedPosition;
@@ -263,8 +309,8 @@ void main() {
     #else
     VertexTexCoord = aTexCoord;// Pass the texture coordinate to the fragment shader.
     #endif
-    NormalViewSpace = normalize(uNormalMat * aNormal);
-    FragPosViewSpace = vec3(uMV * vec4(aPos, 1.0));
+    NormalViewSpace = normalize(normalMat * aNormal);
+    FragPosViewSpace = vec3(mv * vec4(position, 1.0));
 
     // Transform sun direction to view space using the normal matrix
     SunDirViewSpace = normalize((uViewMat * vec4(uSunDirection, 0.0)).xyz);
@@ -0,0 +1,192 @@
+/**************************************************************************************************
+ * @file   GeometryBenchmarks.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Throughput of the plane, bounding box, frustum and plane set queries.
+ * @details The figures are only defined for floats, so there are no double variants.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include "math/MathBenchmarkData.h"
+#include "engine/core/math/geometry/figures/BoundingVolume.h"
+#include "engine/core/math/geometry/figures/plane/Plane.h"
+#include "engine/core/math/geometry/figures/plane/PlaneSet.h"
+#include "engine/subsystems/renderer/math/Frustum.h"
+
+using namespace GLESC;
+using Benchmark::objectCount;
+
+namespace {
+    /**
+     * @brief Boxes of the same size as the objects of a scene, spread so some of them are outside the frustum.
+     */
+    std::vector<Math::BoundingVolume> randomBoxes(Benchmark::BenchmarkRandom& random) {
+        const auto centers = random.vectors<float, 3>(objectCount, -200, 200);
+        const auto halfSizes = random.vectors<float, 3>(objectCount, 0.5f, 5);
+        std::vector<Math::BoundingVolume> boxes;
+        boxes.reserve(objectCount);
+        for (size_t i = 0; i < objectCount; ++i) {
+            boxes.emplace_back(centers[i] - halfSizes[i], centers[i] + halfSizes[i]);
+        }
+        return boxes;
+    }
+
+    /**
+     * @brief The planes of the box from -50 to 50, facing inwards.
+     */
+    Math::PlaneSet boxPlanes() {
+        return Math::PlaneSet({
+            Math::Plane(Vec3F(1, 0, 0), 50.0f), Math::Plane(Vec3F(-1, 0, 0), 50.0f),
+            Math::Plane(Vec3F(0, 1, 0), 50.0f), Math::Plane(Vec3F(0, -1, 0), 50.0f),
+            Math::Plane(Vec3F(0, 0, 1), 50.0f), Math::Plane(Vec3F(0, 0, -1), 50.0f)
+        });
+    }
+
+    Render::Frustum cameraFrustum() {
+        Mat4F view;
+        view.makeViewMatrixPosRot(Vec3F(0, 0, 10), Vec3F(0.1f, 0.4f, 0));
+        Mat4F projection;
+        projection.makeProjectionMatrix(60.0f, 0.1f, 300.0f, 1920.0f, 1080.0f);
+        return Render::Frustum(projection * view);
+    }
+} // namespace
+
+static void planeDistanceToPoint(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const Math::Plane plane(Vec3F(1, 2, 3).normalize(), 5.0f);
+    const auto points = random.vectors<float, 3>(objectCount, -100, 100);
+    for (auto _ : state) {
+        float sum = 0;
+        for (size_t i = 0; i < objectCount; ++i) {
+            sum += plane.distanceToPoint(points[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+static void boundingVolumeIntersects(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto boxes = randomBoxes(random);
+    const Math::BoundingVolume other(Vec3F(-50, -50, -50), Vec3F(50, 50, 50));
+    for (auto _ : state) {
+        size_t intersections = 0;
+        for (size_t i = 0; i < objectCount; ++i) {
+            intersections += boxes[i].intersects(other);
+        }
+        benchmark::DoNotOptimize(intersections);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+/**
+ * @brief One box at a time, as the renderer used to test each mesh.
+ */
+static void frustumContains(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto boxes = randomBoxes(random);
+    const Render::Frustum frustum = cameraFrustum();
+    for (auto _ : state) {
+        size_t visible = 0;
+        for (size_t i = 0; i < objectCount; ++i) {
+            visible += frustum.contains(boxes[i]);
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+/**
+ * @brief The batch culling, with the kernel given by the argument.
+ */
+static void frustumCullAABBs(benchmark::State& state) {
+    const auto kernel = static_cast<Render::CullingKernel>(state.range(0));
+    if (!Render::Frustum::isCullingKernelSupported(kernel)) {
+        state.SkipWithError("The culling kernel is not supported by this processor");
+        return;
+    }
+    Benchmark::BenchmarkRandom random;
+    Render::AABBArrays boxes;
+    for (const Math::BoundingVolume& box : randomBoxes(random)) {
+        boxes.push_back(box.getBoundingBox());
+    }
+    const Render::Frustum frustum = cameraFrustum();
+    std::vector<std::uint8_t> visible(objectCount);
+    for (auto _ : state) {
+        frustum.cullAABBs(boxes, visible.data(), kernel);
+        benchmark::DoNotOptimize(visible.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+/**
+ * @brief Point in convex region for many points, with the six planes of a box and the kernel given by the argument.
+ */
+static void planeSetHasInside(benchmark::State& state) {
+    const auto kernel = static_cast<Math::GeometryKernel>(state.range(0));
+    if (!Math::PlaneSet::isKernelSupported(kernel)) {
+        state.SkipWithError("The geometry kernel is not supported by this processor");
+        return;
+    }
+    Benchmark::BenchmarkRandom random;
+    Math::PointArrays points;
+    for (const Vec3F& point : random.vectors<float, 3>(objectCount, -100, 100)) {
+        points.push_back(point);
+    }
+    const Math::PlaneSet planes = boxPlanes();
+    std::vector<std::uint8_t> inside(objectCount);
+    for (auto _ : state) {
+        planes.hasInside(points, inside.data(), kernel);
+        benchmark::DoNotOptimize(inside.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+/**
+ * @brief Clipping of many segments against the six planes of a box, with the kernel given by the argument.
+ */
+static void planeSetClipSegments(benchmark::State& state) {
+    const auto kernel = static_cast<Math::GeometryKernel>(state.range(0));
+    if (!Math::PlaneSet::isKernelSupported(kernel)) {
+        state.SkipWithError("The geometry kernel is not supported by this processor");
+        return;
+    }
+    Benchmark::BenchmarkRandom random;
+    const auto starts = random.vectors<float, 3>(objectCount, -100, 100);
+    const auto ends = random.vectors<float, 3>(objectCount, -100, 100);
+    Math::SegmentArrays segments;
+    for (size_t i = 0; i < objectCount; ++i) {
+        segments.push_back(starts[i], ends[i]);
+    }
+    const Math::PlaneSet planes = boxPlanes();
+    std::vector<float> enter(objectCount);
+    std::vector<float> exit(objectCount);
+    std::vector<std::uint8_t> intersects(objectCount);
+    for (auto _ : state) {
+        planes.clipSegments(segments, enter.data(), exit.data(), intersects.data(), kernel);
+        benchmark::DoNotOptimize(intersects.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+BENCHMARK(planeDistanceToPoint);
+BENCHMARK(boundingVolumeIntersects);
+BENCHMARK(frustumContains);
+BENCHMARK(frustumCullAABBs)
+    ->Arg(static_cast<int64_t>(Render::CullingKernel::Scalar))
+    ->Arg(static_cast<int64_t>(Render::CullingKernel::SSE))
+    ->Arg(static_cast<int64_t>(Render::CullingKernel::AVX2));
+BENCHMARK(planeSetHasInside)
+    ->Arg(static_cast<int64_t>(Math::GeometryKernel::Scalar))
+    ->Arg(static_cast<int64_t>(Math::GeometryKernel::SSE))
+    ->Arg(static_cast<int64_t>(Math::GeometryKernel::AVX2));
+BENCHMARK(planeSetClipSegments)
+    ->Arg(static_cast<int64_t>(Math::GeometryKernel::Scalar))
+    ->Arg(static_cast<int64_t>(Math::GeometryKernel::SSE))
+    ->Arg(static_cast<int64_t>(Math::GeometryKernel::AVX2));
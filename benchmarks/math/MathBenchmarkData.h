@@ -0,0 +1,71 @@
+/**************************************************************************************************
+ * @file   MathBenchmarkData.h
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Deterministic inputs of the benchmarks of the math kernels.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <random>
+#include <vector>
+#include "engine/core/math/algebra/matrix/Matrix.h"
+
+namespace GLESC::Benchmark {
+    /**
+     * @brief The number of objects processed by each iteration of a benchmark.
+     * @details Like a scene, the inputs don't fit in the registers and the compiler can't hoist the operation out
+     * of the loop. The results are given per object with SetItemsProcessed.
+     */
+    constexpr size_t objectCount = 1024;
+
+    /**
+     * @brief Generates random numbers with a fixed seed, so every run of the benchmarks uses the same inputs.
+     */
+    class BenchmarkRandom {
+    public:
+        explicit BenchmarkRandom(unsigned int seed = 42) : engine(seed) {}
+
+        template <typename Type>
+        Type value(Type min, Type max) {
+            return std::uniform_real_distribution<Type>(min, max)(engine);
+        }
+
+        template <typename Type, size_t N>
+        std::vector<Math::Vector<Type, N>> vectors(size_t count, Type min, Type max) {
+            std::vector<Math::Vector<Type, N>> result(count);
+            for (Math::Vector<Type, N>& vector : result) {
+                for (size_t i = 0; i < N; ++i) {
+                    vector[i] = value(min, max);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Model matrices of objects spread around the origin, with a rotation and a positive scale.
+         * @param uniformScale If true, the scale is the same in every axis, like most of the objects of a scene.
+         */
+        template <typename Type>
+        std::vector<Math::Matrix<Type, 4, 4>> modelMatrices(size_t count, bool uniformScale) {
+            std::vector<Math::Matrix<Type, 4, 4>> result(count);
+            for (Math::Matrix<Type, 4, 4>& matrix : result) {
+                const Math::Vector<Type, 3> position(value<Type>(-100, 100), value<Type>(-100, 100),
+                                                     value<Type>(-100, 100));
+                const Math::Vector<Type, 3> rotation(value<Type>(-3, 3), value<Type>(-3, 3), value<Type>(-3, 3));
+                const Type scaleX = value<Type>(Type(0.5), 2);
+                const Math::Vector<Type, 3> scale = uniformScale
+                                                        ? Math::Vector<Type, 3>(scaleX, scaleX, scaleX)
+                                                        : Math::Vector<Type, 3>(scaleX, value<Type>(Type(0.5), 2),
+                                                                                value<Type>(Type(0.5), 2));
+                matrix.makeModelMatrix(position, rotation, scale);
+            }
+            return result;
+        }
+
+    private:
+        std::mt19937 engine;
+    }; // class BenchmarkRandom
+} // namespace GLESC::Benchmark
@@ -0,0 +1,209 @@
+/**************************************************************************************************
+ * @file   MatrixBenchmarks.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Throughput of the 4x4 matrix products, inverses and the matrices built every frame.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include "math/MathBenchmarkData.h"
+
+using namespace GLESC;
+using Benchmark::objectCount;
+
+template <typename Type>
+using Matrix4 = Math::Matrix<Type, 4, 4>;
+template <typename Type>
+using Matrix3 = Math::Matrix<Type, 3, 3>;
+
+template <typename Type>
+static void matrixMultiply(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto models = random.modelMatrices<Type>(objectCount, false);
+    const Matrix4<Type> viewProjection = random.modelMatrices<Type>(1, false)[0];
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = viewProjection * models[i];
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void matrixVectorMultiply(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const Matrix4<Type> model = random.modelMatrices<Type>(1, false)[0];
+    const auto vectors = random.vectors<Type, 4>(objectCount, -100, 100);
+    std::vector<Math::Vector<Type, 4>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = model * vectors[i];
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+/**
+ * @brief The general inverse of a 4x4 matrix, the baseline of the affine and rigid inverses.
+ */
+template <typename Type>
+static void matrixInverse(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto models = random.modelMatrices<Type>(objectCount, false);
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = models[i].inverse();
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void matrixAffineInverse(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto models = random.modelMatrices<Type>(objectCount, false);
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = models[i].affineInverse();
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void matrixRigidInverse(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    std::vector<Matrix4<Type>> views(objectCount);
+    for (Matrix4<Type>& view : views) {
+        const Math::Vector<Type, 3> position(random.value<Type>(-100, 100), random.value<Type>(-100, 100),
+                                             random.value<Type>(-100, 100));
+        const Math::Vector<Type, 3> rotation(random.value<Type>(-3, 3), random.value<Type>(-3, 3),
+                                             random.value<Type>(-3, 3));
+        view.makeViewMatrixPosRot(position, rotation);
+    }
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = views[i].rigidInverse();
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void modelMatrix(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto positions = random.vectors<Type, 3>(objectCount, -100, 100);
+    const auto rotations = random.vectors<Type, 3>(objectCount, -3, 3);
+    const auto scales = random.vectors<Type, 3>(objectCount, Type(0.5), 2);
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i].makeModelMatrix(positions[i], rotations[i], scales[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void viewMatrix(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto positions = random.vectors<Type, 3>(objectCount, -100, 100);
+    const auto rotations = random.vectors<Type, 3>(objectCount, -3, 3);
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i].makeViewMatrixPosRot(positions[i], rotations[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void projectionMatrix(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    std::vector<float> fovs(objectCount);
+    for (float& fov : fovs) {
+        fov = random.value(30.0f, 120.0f);
+    }
+    std::vector<Matrix4<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i].makeProjectionMatrix(fovs[i], 0.1f, 1000.0f, 1920.0f, 1080.0f);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void normalMatrix(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto modelViews = random.modelMatrices<Type>(objectCount, false);
+    std::vector<Matrix3<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i].makeNormalMatrix(modelViews[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void normalMatrixUniformScale(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto modelViews = random.modelMatrices<Type>(objectCount, true);
+    std::vector<Matrix3<Type>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i].makeNormalMatrixUniformScale(modelViews[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+BENCHMARK_TEMPLATE(matrixMultiply, float);
+BENCHMARK_TEMPLATE(matrixMultiply, double);
+BENCHMARK_TEMPLATE(matrixVectorMultiply, float);
+BENCHMARK_TEMPLATE(matrixVectorMultiply, double);
+BENCHMARK_TEMPLATE(matrixInverse, float);
+BENCHMARK_TEMPLATE(matrixInverse, double);
+BENCHMARK_TEMPLATE(matrixAffineInverse, float);
+BENCHMARK_TEMPLATE(matrixAffineInverse, double);
+BENCHMARK_TEMPLATE(matrixRigidInverse, float);
+BENCHMARK_TEMPLATE(matrixRigidInverse, double);
+BENCHMARK_TEMPLATE(modelMatrix, float);
+BENCHMARK_TEMPLATE(modelMatrix, double);
+BENCHMARK_TEMPLATE(viewMatrix, float);
+BENCHMARK_TEMPLATE(viewMatrix, double);
+BENCHMARK_TEMPLATE(projectionMatrix, float);
+BENCHMARK_TEMPLATE(projectionMatrix, double);
+BENCHMARK_TEMPLATE(normalMatrix, float);
+BENCHMARK_TEMPLATE(normalMatrix, double);
+BENCHMARK_TEMPLATE(normalMatrixUniformScale, float);
+BENCHMARK_TEMPLATE(normalMatrixUniformScale, double);
@@ -0,0 +1,63 @@
+/**************************************************************************************************
+ * @file   RandomBenchmarks.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Throughput of the generation of random numbers, against the generator of the standard library.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include "math/MathBenchmarkData.h"
+#include "engine/core/math/Math.h"
+
+using namespace GLESC;
+using Benchmark::objectCount;
+
+/**
+ * @brief The baseline, a distribution over std::mt19937 created for each number.
+ */
+static void randomStandardLibrary(benchmark::State& state) {
+    std::mt19937 engine(42);
+    std::vector<float> result(objectCount);
+    for (auto _ : state) {
+        for (float& value : result) {
+            value = std::uniform_real_distribution<float>(-100, 100)(engine);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+static void randomGenerateNumber(benchmark::State& state) {
+    Math::RandomGenerator::setThreadsSeed(42);
+    std::vector<float> result(objectCount);
+    for (auto _ : state) {
+        for (float& value : result) {
+            value = Math::generateRandomNumber(-100.0f, 100.0f);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void randomFillUniform(benchmark::State& state) {
+    Math::RandomGenerator generator(42);
+    std::vector<Type> result(objectCount);
+    for (auto _ : state) {
+        generator.fillUniform(result.data(), result.size(), Type(-100), Type(100));
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+BENCHMARK(randomStandardLibrary);
+BENCHMARK(randomGenerateNumber);
+BENCHMARK_TEMPLATE(randomFillUniform, float);
+BENCHMARK_TEMPLATE(randomFillUniform, double);
+BENCHMARK_TEMPLATE(randomFillUniform, int);
@@ -0,0 +1,111 @@
+/**************************************************************************************************
+ * @file   VectorBenchmarks.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Throughput of the operations of the vectors of 3 and 4 elements.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include "math/MathBenchmarkData.h"
+
+using namespace GLESC;
+using Benchmark::objectCount;
+
+template <typename Type, size_t N>
+static void vectorAdd(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto left = random.vectors<Type, N>(objectCount, -100, 100);
+    const auto right = random.vectors<Type, N>(objectCount, -100, 100);
+    std::vector<Math::Vector<Type, N>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = left[i] + right[i];
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type, size_t N>
+static void vectorScalarMul(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto vectors = random.vectors<Type, N>(objectCount, -100, 100);
+    std::vector<Math::Vector<Type, N>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = vectors[i] * Type(1.5);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type, size_t N>
+static void vectorDot(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto left = random.vectors<Type, N>(objectCount, -100, 100);
+    const auto right = random.vectors<Type, N>(objectCount, -100, 100);
+    for (auto _ : state) {
+        Type sum = 0;
+        for (size_t i = 0; i < objectCount; ++i) {
+            sum += left[i].dot(right[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type, size_t N>
+static void vectorNormalize(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto vectors = random.vectors<Type, N>(objectCount, 1, 100);
+    std::vector<Math::Vector<Type, N>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = vectors[i].normalize();
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+template <typename Type>
+static void vectorCross(benchmark::State& state) {
+    Benchmark::BenchmarkRandom random;
+    const auto left = random.vectors<Type, 3>(objectCount, -100, 100);
+    const auto right = random.vectors<Type, 3>(objectCount, -100, 100);
+    std::vector<Math::Vector<Type, 3>> result(objectCount);
+    for (auto _ : state) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            result[i] = left[i].cross(right[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objectCount));
+}
+
+BENCHMARK_TEMPLATE(vectorAdd, float, 3);
+BENCHMARK_TEMPLATE(vectorAdd, float, 4);
+BENCHMARK_TEMPLATE(vectorAdd, double, 3);
+BENCHMARK_TEMPLATE(vectorAdd, double, 4);
+BENCHMARK_TEMPLATE(vectorScalarMul, float, 3);
+BENCHMARK_TEMPLATE(vectorScalarMul, float, 4);
+BENCHMARK_TEMPLATE(vectorScalarMul, double, 3);
+BENCHMARK_TEMPLATE(vectorScalarMul, double, 4);
+BENCHMARK_TEMPLATE(vectorDot, float, 3);
+BENCHMARK_TEMPLATE(vectorDot, float, 4);
+BENCHMARK_TEMPLATE(vectorDot, double, 3);
+BENCHMARK_TEMPLATE(vectorDot, double, 4);
+BENCHMARK_TEMPLATE(vectorNormalize, float, 3);
+BENCHMARK_TEMPLATE(vectorNormalize, float, 4);
+BENCHMARK_TEMPLATE(vectorNormalize, double, 3);
+BENCHMARK_TEMPLATE(vectorNormalize, double, 4);
+BENCHMARK_TEMPLATE(vectorCross, float);
+BENCHMARK_TEMPLATE(vectorCross, double);
@@ -0,0 +1,46 @@
+# ==========================================================
+# ================= BENCHMARKING MODULE ====================
+# ==========================================================
+# Module description:
+#   This module is responsible for setting up the
+#   benchmarking environment. It will download the google
+#   benchmark library and add a target that runs the
+#   benchmarks and saves their results as JSON, so they can
+#   be compared between commits. It's only used when the
+#   GLESC_BUILD_BENCHMARKS option is ON in a non debug build.
+
+# ··························································
+# ··················Module Dependencies·····················
+
+include_once(FetchContent)
+include_cmake_once(core/FileLocations.cmake)
+
+# ··························································
+
+function(prepare_benchmarks target)
+  FetchContent_Declare(
+      googlebenchmark
+      URL https://github.com/google/benchmark/archive/refs/tags/v1.8.3.zip
+  )
+  # Only the library is needed, not its own tests
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+  FetchContent_GetProperties(googlebenchmark)
+  important_info("Downloading google benchmark library...")
+  FetchContent_Populate(googlebenchmark)
+  add_subdirectory(${googlebenchmark_SOURCE_DIR} ${googlebenchmark_BINARY_DIR})
+  success("Google benchmark library downloaded successfully!")
+
+  # Running 'run_game_benchmark' writes the results of every
+  # benchmark to benchmark-results/game_benchmark.json
+  file(MAKE_DIRECTORY ${BENCHMARK_RESULTS_DIR})
+  add_custom_target(run_${target}
+      COMMAND ${target}
+              --benchmark_out=${BENCHMARK_RESULTS_DIR}/${target}.json
+              --benchmark_out_format=json
+      DEPENDS ${target}
+      WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+      COMMENT "Running the benchmarks of ${target}"
+  )
+endfunction()
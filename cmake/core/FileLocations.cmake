@@ -129,6 +129,12 @@ endif ()
 set_new_dir(TEST_DIR tests)
 # ..........................................................
 
+# ..................... Benchmark Dirs .....................
+set_new_dir(BENCHMARK_DIR benchmarks)
+# The results of the benchmarks are saved here as JSON
+set_new_dir(BENCHMARK_RESULTS_DIR ${CMAKE_BINARY_DIR}/benchmark-results)
+# ..........................................................
+
 
 
 # ...................... Source Files ......................
@@ -139,6 +145,7 @@ set_new_dir(TEST_DIR tests)
 set_all_files_of_type(SOURCE_FILES ${SRC_DIR} cpp)
 set_all_files_of_type(LIB_SOURCE_FILES ${LIB_SRC_DIR} cpp)
 set_all_files_of_type(TEST_SOURCE_FILES ${TEST_DIR} cpp)
+set_all_files_of_type(BENCHMARK_SOURCE_FILES ${BENCHMARK_DIR} cpp)
 # ..........................................................
 
 
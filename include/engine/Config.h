@@ -101,6 +101,30 @@
 #define GLESC_GLSL_CORE_PROFILE true
 #endif
 
+// #################################################################################################
+// ########################################## RENDER THREAD ########################################
+
+/**
+ * @brief If true, the frames are rendered in a dedicated thread while the update of the next frame is executed.
+ * Set it to false to update and render in the same thread, which is easier to debug.
+ */
+#define GLESC_MULTITHREADED_RENDERING true
+
+// #################################################################################################
+// ############################################# MATH ##############################################
+
+/**
+ * @brief If true, the vectors of 4 floats and the 4x4 float matrices use SSE or NEON for their hot operations.
+ * Set it to false to use the scalar algorithms everywhere.
+ */
+#define GLESC_MATH_SIMD true
+/**
+ * @brief If true, the vectors keep an alignment of 1 byte, like the structures packed to be uploaded to the GPU,
+ * which contain vectors at any offset (the color of the vertices is a vector of 4 floats).
+ * Set it to false to align the vectors of 4 floats to 16 bytes, only if no packed structure contains them.
+ */
+#define GLESC_MATH_PACKED_VECTORS true
+
 // #################################################################################################
 // ################################### ENTITY COMPONENT SYSTEM #####################################
 
@@ -25,6 +25,7 @@
 #include "engine/subsystems/hud/engine-hud/EngineHUDManager.h"
 #include "engine/subsystems/hud/HUDManager.h"
 #include "engine/subsystems/renderer/Renderer.h"
+#include "engine/subsystems/renderer/RenderThread.h"
 #include "engine/subsystems/input/InputManager.h"
 #include "engine/subsystems/physics/PhysicsManager.h"
 #include "subsystems/physics/CollisionManager.h"
@@ -75,10 +76,23 @@ namespace GLESC {
         /**
          * @brief Processes the rendering of the game
          * Can be called at variable intervals of time as it uses elapsed
+         * @details If GLESC_MULTITHREADED_RENDERING is enabled it only asks the render thread to render the frame
+         * and returns immediately.
          * @param timeOfFrame The time of the frame
          */
         void render(double timeOfFrame);
 
+        /**
+         * @brief Renders a frame, in the render thread if there is one
+         * @param timeOfFrame The time of the frame
+         */
+        void renderFrame(double timeOfFrame);
+
+        /**
+         * @brief Updates all the systems and hands the render data they generate to the renderer
+         */
+        void updateSystems();
+
 
         /**
          * @brief If true, the game is running. If false, the game is stopped.
@@ -163,5 +177,10 @@ namespace GLESC {
          * @brief The game, handles the game logic
          */
         Game game;
+        /**
+         * @brief The thread that renders the frames if GLESC_MULTITHREADED_RENDERING is enabled
+         * @details If it's not enabled, it's never started and the frames are rendered in the main thread.
+         */
+        Render::RenderThread renderThread;
     }; // class Engine
 } // namespace GLESC
@@ -0,0 +1,45 @@
+/**************************************************************************************************
+ * @file   MappedFile.h
+ * @author Valentin Dumitru
+ * @date   2024-06-18
+ * @brief  Read only view of a file mapped in memory.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Maps a whole file in memory to read it without copying it to a buffer first.
+ * @details The pages of the file are loaded by the operating system when they're read, and they're shared with the
+ * file cache, so reading a big binary file is as fast as copying from memory.
+ * If the file can't be opened or is empty, the mapping is not open and the data is null.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] bool isOpen() const { return data != nullptr; }
+    [[nodiscard]] const std::uint8_t* getData() const { return data; }
+    [[nodiscard]] std::size_t getSize() const { return size; }
+
+private:
+    void close();
+
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+}; // class MappedFile
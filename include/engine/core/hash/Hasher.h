@@ -10,6 +10,7 @@
 #pragma once
 #include <functional>
 #include <cstddef>
+#include <cstdint>
 
 namespace GLESC {
     namespace Hasher {
@@ -18,9 +19,28 @@ namespace GLESC {
         static Hash hash(const Hashable& hashable) {
             return std::hash<Hashable>{}(hashable);
         }
-        static void hashCombine(std::size_t seed, std::size_t hash) {
+        static void hashCombine(std::size_t& seed, std::size_t hash) {
             seed = seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
         }
 
+        /**
+         * @brief Hashes raw bytes with 64 bits FNV-1a.
+         * @details Unlike std::hash, the result only depends on the bytes, so it's the same between runs and builds.
+         * It can be used for data stored on disk.
+         * @param data The bytes to hash.
+         * @param size The number of bytes.
+         * @param seed The hash of the previous bytes, to hash data in several parts.
+         */
+        static std::uint64_t hashBytes(const void* data, std::size_t size,
+                                       std::uint64_t seed = 0xcbf29ce484222325ull) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            std::uint64_t hash = seed;
+            for (std::size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
     }// class Hasher
 } // namespace GLESC
@@ -0,0 +1,75 @@
+/**************************************************************************************************
+ * @file   BufferRangeAllocator.h
+ * @author Valentin Dumitru
+ * @date   2024-06-22
+ * @brief  Allocator of the ranges of a big GPU buffer, with a best fit free list.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace GLESC::GAPI {
+    /**
+     * @brief Keeps track of the free ranges of a buffer, so many objects can share it.
+     * @details It only does the bookkeeping, the units of the ranges are the ones of the caller (vertices, indices
+     * or bytes) and the buffer itself isn't touched.
+     *
+     * The free ranges are indexed by size, to take the smallest one that fits, and by offset, to merge a freed
+     * range with its free neighbours so the buffer doesn't fragment in ranges too small to be used.
+     */
+    class BufferRangeAllocator {
+    public:
+        struct Allocation {
+            size_t offset = 0;
+            size_t size = 0;
+
+            [[nodiscard]] bool isValid() const { return size > 0; }
+        };
+
+        /**
+         * @param capacityParam The size of the buffer, in the units of the ranges.
+         */
+        explicit BufferRangeAllocator(size_t capacityParam);
+
+        /**
+         * @brief Takes a range from the smallest free range where it fits.
+         * @param size The size of the range, it can't be 0.
+         * @return The range, or an invalid allocation if no free range is big enough.
+         */
+        [[nodiscard]] Allocation allocate(size_t size);
+        /**
+         * @brief Gives back a range taken with allocate, it can be allocated again.
+         */
+        void free(const Allocation& allocation);
+        /**
+         * @brief Frees every range at once.
+         */
+        void reset();
+
+        [[nodiscard]] size_t getCapacity() const { return capacity; }
+        [[nodiscard]] size_t getUsed() const { return used; }
+        [[nodiscard]] size_t getFreeRangeCount() const { return freeByOffset.size(); }
+        [[nodiscard]] size_t getLargestFreeRange() const;
+
+    private:
+        void insertFreeRange(size_t offset, size_t size);
+        void eraseFreeRange(std::map<size_t, size_t>::iterator freeRange);
+
+        size_t capacity;
+        size_t used = 0;
+        /**
+         * @brief The free ranges, the key is the offset and the value the size.
+         */
+        std::map<size_t, size_t> freeByOffset;
+        /**
+         * @brief The free ranges ordered by size and then by offset.
+         */
+        std::set<std::pair<size_t, size_t>> freeBySize;
+    }; // class BufferRangeAllocator
+} // namespace GLESC::GAPI
@@ -0,0 +1,125 @@
+/**************************************************************************************************
+ * @file   StreamingRing.h
+ * @author Valentin Dumitru
+ * @date   2024-06-22
+ * @brief  Persistently mapped buffer split in regions, for the data uploaded every frame.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/core/low-level-renderer/graphic-api/IGraphicInterface.h"
+
+namespace GLESC::GAPI {
+    /**
+     * @brief A buffer that stays mapped and is written directly by the CPU, split in one region per frame in
+     * flight.
+     * @details Each frame writes its data in the next region, while the GPU can still be reading the regions of the
+     * previous frames. When a frame ends a fence is inserted, and the region is only written again once its fence
+     * is signaled. The writes never reallocate the buffer or wait for the driver, the CPU only waits if it gets
+     * more frames ahead than the number of regions.
+     *
+     * The buffer is bound to any target, or used as the source of a copy, with the offsets of the allocations.
+     * It's created the first time something is allocated, from the thread that owns the graphic context.
+     */
+    class StreamingRing {
+    public:
+        struct Allocation {
+            /**
+             * @brief Where the data is written, valid until the end of the frame.
+             */
+            Void* data = nullptr;
+            /**
+             * @brief The offset of the data in the buffer, in bytes.
+             */
+            Size offset = 0;
+            Size size = 0;
+
+            [[nodiscard]] bool isValid() const { return data != nullptr; }
+        };
+
+        /**
+         * @brief Three regions let the CPU write a frame while the GPU draws the previous one and the driver
+         * queues the one before.
+         */
+        static constexpr UInt defaultRegionCount = 3;
+
+        /**
+         * @param gapiParam The graphic interface the buffer is created with.
+         * @param regionSizeParam The bytes that can be allocated in a frame.
+         * @param regionCountParam The frames that can be in flight.
+         */
+        StreamingRing(IGraphicInterface& gapiParam, Size regionSizeParam,
+                      UInt regionCountParam = defaultRegionCount);
+        ~StreamingRing();
+        StreamingRing(const StreamingRing&) = delete;
+        StreamingRing& operator=(const StreamingRing&) = delete;
+
+        /**
+         * @brief Takes space for data of the current frame.
+         * @details The first allocation of a frame waits for the GPU to finish reading the region, if it hadn't.
+         * @throw GAPIException If the wait for the region fails, like when the context was lost.
+         * @param size The bytes to allocate.
+         * @param alignment The offset of the allocation in the buffer is a multiple of it.
+         * @return The allocation, or an invalid one if the region of the frame doesn't have space left.
+         */
+        [[nodiscard]] Allocation allocate(Size size, Size alignment);
+        /**
+         * @brief Fences the region of the frame after the commands that read it, the next frame uses the next region.
+         */
+        void endFrame();
+        /**
+         * @brief Destroys the buffer and the fences, must be called before the graphic context is destroyed.
+         */
+        void destroyGpuBuffers();
+
+        [[nodiscard]] UInt getBufferId() const { return buffer; }
+        [[nodiscard]] Size getRegionSize() const { return regionSize; }
+        [[nodiscard]] UInt getRegionCount() const { return regionCount; }
+        [[nodiscard]] UInt getCurrentRegion() const { return currentRegion; }
+        /**
+         * @brief The bytes allocated in the current frame, including the padding of the alignments.
+         */
+        [[nodiscard]] Size getUsedBytes() const { return regionCursor; }
+        /**
+         * @brief Number of times the CPU had to wait for the GPU to release a region.
+         */
+        [[nodiscard]] size_t getStallCount() const { return stalls; }
+
+    private:
+        /**
+         * @brief Each wait gives up after this time, to count how long the CPU waits for the GPU.
+         */
+        static constexpr std::uint64_t waitTimeoutNanoseconds = 1000000;
+
+        void createBuffer();
+        /**
+         * @brief Waits until the GPU has read the current region in a previous frame.
+         * @throw GAPIException If the wait fails, waiting again would never end.
+         */
+        void acquireRegion();
+
+        IGraphicInterface& gapi;
+        Size regionSize;
+        UInt regionCount;
+
+        UInt buffer = 0;
+        bool bufferCreated = false;
+        std::uint8_t* mapping = nullptr;
+        /**
+         * @brief The fence of the last frame that used each region, nullptr if the region is free.
+         */
+        std::vector<FenceID> regionFences;
+        UInt currentRegion = 0;
+        Size regionCursor = 0;
+        /**
+         * @brief If the current region can be written, it's acquired by the first allocation of a frame.
+         */
+        bool regionAcquired = false;
+        size_t stalls = 0;
+    }; // class StreamingRing
+} // namespace GLESC::GAPI
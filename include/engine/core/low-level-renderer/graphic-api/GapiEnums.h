@@ -145,7 +145,10 @@ namespace GLESC::GAPI::Enums {
 
     enum class BufferTypes {
         Vertex [[maybe_unused]] = GL_ARRAY_BUFFER,
-        Index [[maybe_unused]] = GL_ELEMENT_ARRAY_BUFFER
+        Index [[maybe_unused]] = GL_ELEMENT_ARRAY_BUFFER,
+        DrawIndirect [[maybe_unused]] = GL_DRAW_INDIRECT_BUFFER,
+        ShaderStorage [[maybe_unused]] = GL_SHADER_STORAGE_BUFFER,
+        CopyWrite [[maybe_unused]] = GL_COPY_WRITE_BUFFER
     };
 
     enum class BufferUsages {
@@ -249,6 +252,9 @@ namespace GLESC::GAPI::Enums {
         UByte [[maybe_unused]] = GL_UNSIGNED_BYTE,
         Short [[maybe_unused]] = GL_SHORT,
         UShort [[maybe_unused]] = GL_UNSIGNED_SHORT,
+        HalfFloat [[maybe_unused]] = GL_HALF_FLOAT,
+        // Four signed components of 10, 10, 10 and 2 bits packed in 32 bits, only for vertex attributes
+        Int2101010Rev [[maybe_unused]] = GL_INT_2_10_10_10_REV,
 
         Vec2F [[maybe_unused]] = GL_FLOAT_VEC2,
         Vec3F [[maybe_unused]] = GL_FLOAT_VEC3,
@@ -270,6 +276,12 @@ namespace GLESC::GAPI::Enums {
         Vec3D [[maybe_unused]] = GL_DOUBLE_VEC3,
         Vec4D [[maybe_unused]] = GL_DOUBLE_VEC4,
 
+        // Vectors of the compact vertex attributes, OpenGL only names the type of their components so they have no
+        // OpenGL enum, their values are above the range of the OpenGL enums
+        Vec4H [[maybe_unused]] = 0x10000,
+        Vec4S [[maybe_unused]] = 0x10001,
+        Vec4UB [[maybe_unused]] = 0x10002,
+
         Mat2F [[maybe_unused]] = GL_FLOAT_MAT2,
         Mat3F [[maybe_unused]] = GL_FLOAT_MAT3,
         Mat4F [[maybe_unused]] = GL_FLOAT_MAT4,
@@ -290,6 +302,8 @@ namespace GLESC::GAPI::Enums {
         Byte [[maybe_unused]] = sizeof(GLbyte),
         Short [[maybe_unused]] = sizeof(GLshort),
         UnsignedShort [[maybe_unused]] = sizeof(GLushort),
+        HalfFloat [[maybe_unused]] = sizeof(GLhalf),
+        Int2101010Rev [[maybe_unused]] = sizeof(GLuint),
 
         Vec2F [[maybe_unused]] = sizeof(GLfloat) * static_cast<GLsizei>(TypeCount::Vec2),
         Vec3F [[maybe_unused]] = sizeof(GLfloat) * static_cast<GLsizei>(TypeCount::Vec3),
@@ -299,6 +313,10 @@ namespace GLESC::GAPI::Enums {
         Vec3D [[maybe_unused]] = sizeof(GLdouble) * static_cast<GLsizei>(TypeCount::Vec3),
         Vec4D [[maybe_unused]] = sizeof(GLdouble) * static_cast<GLsizei>(TypeCount::Vec4),
 
+        Vec4H [[maybe_unused]] = sizeof(GLhalf) * static_cast<GLsizei>(TypeCount::Vec4),
+        Vec4S [[maybe_unused]] = sizeof(GLshort) * static_cast<GLsizei>(TypeCount::Vec4),
+        Vec4UB [[maybe_unused]] = sizeof(GLubyte) * static_cast<GLsizei>(TypeCount::Vec4),
+
         Vec2I [[maybe_unused]] = sizeof(GLint) * static_cast<GLsizei>(TypeCount::Vec2),
         Vec3I [[maybe_unused]] = sizeof(GLint) * static_cast<GLsizei>(TypeCount::Vec3),
         Vec4I [[maybe_unused]] = sizeof(GLint) * static_cast<GLsizei>(TypeCount::Vec4),
@@ -354,7 +372,8 @@ namespace GLESC::GAPI::Enums {
             case Types::UByte:
             case Types::Byte:
             case Types::Short:
-            case Types::UShort: return TypeCount::Value;
+            case Types::UShort:
+            case Types::HalfFloat: return TypeCount::Value;
             case Types::Vec2F:
             case Types::Vec2D:
             case Types::Vec2I:
@@ -368,7 +387,11 @@ namespace GLESC::GAPI::Enums {
             case Types::Vec4F:
             case Types::Vec4I:
             case Types::Vec4UI:
-            case Types::Vec4B: return TypeCount::Vec4;
+            case Types::Vec4B:
+            case Types::Vec4H:
+            case Types::Vec4S:
+            case Types::Vec4UB:
+            case Types::Int2101010Rev: return TypeCount::Vec4;
             case Types::Mat2D:
             case Types::Mat2F: return TypeCount::Mat2;
             case Types::Mat3D:
@@ -390,6 +413,8 @@ namespace GLESC::GAPI::Enums {
             case Types::Byte: return TypeSize::Byte;
             case Types::Short: return TypeSize::Short;
             case Types::UShort: return TypeSize::UnsignedShort;
+            case Types::HalfFloat: return TypeSize::HalfFloat;
+            case Types::Int2101010Rev: return TypeSize::Int2101010Rev;
 
             case Types::Vec2F: return TypeSize::Vec2F;
             case Types::Vec3F: return TypeSize::Vec3F;
@@ -399,6 +424,10 @@ namespace GLESC::GAPI::Enums {
             case Types::Vec3D: return TypeSize::Vec3D;
             case Types::Vec4D: return TypeSize::Vec4D;
 
+            case Types::Vec4H: return TypeSize::Vec4H;
+            case Types::Vec4S: return TypeSize::Vec4S;
+            case Types::Vec4UB: return TypeSize::Vec4UB;
+
             case Types::Vec2I: return TypeSize::Vec2I;
             case Types::Vec3I: return TypeSize::Vec3I;
             case Types::Vec4I: return TypeSize::Vec4I;
@@ -442,6 +471,11 @@ namespace GLESC::GAPI::Enums {
             case Types::Vec2B:
             case Types::Vec3B:
             case Types::Vec4B: return Types::Bool;
+            case Types::Vec4H: return Types::HalfFloat;
+            case Types::Vec4S: return Types::Short;
+            case Types::Vec4UB: return Types::UByte;
+            // The components are packed, the type is the same for the whole vector
+            case Types::Int2101010Rev: return Types::Int2101010Rev;
             case Types::Vec2D:
             case Types::Vec3D:
             case Types::Vec4D:
@@ -484,6 +518,10 @@ namespace GLESC::GAPI::Enums {
 
     MAP_TYPE(Types::UShort, GLushort);
 
+    MAP_TYPE(Types::HalfFloat, GLhalf);
+
+    MAP_TYPE(Types::Int2101010Rev, GLuint);
+
     MAP_TYPE(Types::Vec2F, GLfloat);
 
     MAP_TYPE(Types::Vec3F, GLfloat);
@@ -496,6 +534,12 @@ namespace GLESC::GAPI::Enums {
 
     MAP_TYPE(Types::Vec4D, GLdouble);
 
+    MAP_TYPE(Types::Vec4H, GLhalf);
+
+    MAP_TYPE(Types::Vec4S, GLshort);
+
+    MAP_TYPE(Types::Vec4UB, GLubyte);
+
     MAP_TYPE(Types::Vec2I, GLint);
 
     MAP_TYPE(Types::Vec3I, GLint);
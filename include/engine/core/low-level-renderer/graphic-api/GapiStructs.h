@@ -71,6 +71,28 @@ namespace GLESC::GAPI {
             x(x), y(y), width(width), height(height) {
         }
     }; // struct Viewport
+
+    /**
+     * @brief A draw of the multi draw indirect, with the layout the GPU reads from the indirect buffer.
+     * @details The indices of the draw are count indices starting at firstIndex in the bound index buffer, and
+     * baseVertex is added to each index, so many meshes can share the same vertex and index buffers.
+     */
+    struct DrawElementsIndirectCommand {
+        UInt count = 0;
+        UInt instanceCount = 1;
+        UInt firstIndex = 0;
+        Int baseVertex = 0;
+        UInt baseInstance = 0;
+
+        bool operator==(const DrawElementsIndirectCommand& other) const {
+            return count == other.count && instanceCount == other.instanceCount &&
+                firstIndex == other.firstIndex && baseVertex == other.baseVertex &&
+                baseInstance == other.baseInstance;
+        }
+    }; // struct DrawElementsIndirectCommand
+
+    static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(UInt),
+                  "The indirect commands are read by the GPU, they can't have padding");
 } // namespace GAPI
 
 namespace GLESC {
@@ -37,6 +37,21 @@ namespace GLESC::GAPI{
     using TextureID = UInt;
     using ShaderProgramID = UInt;
     using TextureSlot = UInt;
+    /**
+     * @brief A fence inserted in the command stream, signaled when the GPU executes it.
+     */
+    using FenceID = GLsync;
+    /**
+     * @brief The result of waiting for a fence.
+     */
+    enum class FenceWaitResult {
+        Signaled,
+        TimedOut,
+        /**
+         * @brief The wait can't complete, like when the fence isn't valid or the context was lost.
+         */
+        Failed
+    };
 
 } // namespace GAPI
 
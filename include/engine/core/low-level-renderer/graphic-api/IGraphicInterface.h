@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <set>
 #include <SDL2/SDL.h>
@@ -46,6 +47,16 @@ namespace GLESC::GAPI {
 
         virtual Void deleteContext() = 0;
 
+        /**
+         * @brief Makes the context current in the calling thread, the context can only be current in one thread.
+         */
+        virtual Void makeContextCurrent(SDL_Window& window) = 0;
+
+        /**
+         * @brief Detaches the context from the calling thread, so another thread can make it current.
+         */
+        virtual Void releaseContext(SDL_Window& window) = 0;
+
         virtual void enableDepthBuffer(Bool enabled) = 0;
 
         virtual void setDepthFunction(Enums::DepthFuncs depthFunction) = 0;
@@ -56,6 +67,15 @@ namespace GLESC::GAPI {
 
         virtual Void drawTrianglesIndexedInstanced(UInt count, UInt instanceCount) = 0;
 
+        /**
+         * @brief Draws several indexed meshes with a single call, reading the draws from the bound indirect buffer
+         * (Enums::BufferTypes::DrawIndirect).
+         * @details The shaders know which draw they're executing with gl_DrawID, which starts at 0 in each call.
+         * @param firstCommand The index of the first DrawElementsIndirectCommand of the buffer that is drawn.
+         * @param drawCount The number of commands drawn.
+         */
+        virtual Void multiDrawTrianglesIndexedIndirect(UInt firstCommand, UInt drawCount) = 0;
+
         virtual RGBAColor readPixelColor(int x, int y) = 0;
 
         virtual RGBAColorNormalized readPixelColorNormalized(UInt x, UInt y) = 0;
@@ -82,6 +102,74 @@ namespace GLESC::GAPI {
 
         virtual Void setDynamicBufferData(UInt size, Enums::BufferTypes bufferType) = 0;
 
+        /**
+         * @brief Overwrites a range of the bound buffer, without reallocating it.
+         * @param data The new data of the range.
+         * @param offset The offset of the range in bytes.
+         * @param size The size of the range in bytes, offset + size can't be bigger than the buffer.
+         * @param bufferType The target the buffer is bound to.
+         */
+        virtual Void setBufferSubData(const Void* data, Size offset, Size size, Enums::BufferTypes bufferType) = 0;
+
+        /**
+         * @brief Binds a buffer to an indexed binding point of the shaders, like the storage buffers.
+         */
+        virtual Void bindBufferBase(Enums::BufferTypes bufferType, UInt index, UInt buffer) = 0;
+
+        /**
+         * @brief Binds a range of a buffer to an indexed binding point of the shaders.
+         * @param offset The offset of the range in bytes, it must be aligned as the binding point requires.
+         * @param size The size of the range in bytes.
+         */
+        virtual Void bindBufferRange(Enums::BufferTypes bufferType, UInt index, UInt buffer, Size offset,
+                                     Size size) = 0;
+
+        /**
+         * @brief Get the alignment required for the offsets of the ranges bound to the storage buffer binding points.
+         * @details It depends on the device, so it must be queried after the context is created.
+         */
+        [[nodiscard]] virtual Size getStorageBufferOffsetAlignment() = 0;
+
+        /**
+         * @brief Allocates immutable storage for the bound buffer that can stay mapped while it's used.
+         * @details The buffer can't be reallocated afterwards, only written through its mapping or copied to.
+         * @param size The size of the buffer in bytes.
+         * @param bufferType The target the buffer is bound to.
+         */
+        virtual Void setPersistentBufferStorage(Size size, Enums::BufferTypes bufferType) = 0;
+
+        /**
+         * @brief Maps a range of the bound persistent buffer for writing.
+         * @details The mapping is coherent and stays valid while the GPU uses the buffer, so the writes don't need
+         * to be flushed. The caller must not write the ranges the GPU is still reading, @see createFence.
+         * @return The address the range is mapped to.
+         */
+        [[nodiscard]] virtual Void* mapPersistentBuffer(Size offset, Size size, Enums::BufferTypes bufferType) = 0;
+
+        virtual Void unmapBuffer(Enums::BufferTypes bufferType) = 0;
+
+        /**
+         * @brief Copies a range from a buffer to another in the GPU, without binding them.
+         */
+        virtual Void copyBufferSubData(UInt readBuffer, UInt writeBuffer, Size readOffset, Size writeOffset,
+                                       Size size) = 0;
+
+        /**
+         * @brief Inserts a fence after the commands issued so far.
+         * @return The fence, it must be deleted with deleteFence.
+         */
+        [[nodiscard]] virtual FenceID createFence() = 0;
+
+        /**
+         * @brief Waits until the GPU executes the commands before the fence.
+         * @param fence The fence to wait for.
+         * @param timeoutNanoseconds The maximum time to wait, 0 only checks the fence.
+         * @return Signaled if the fence was signaled before the timeout, Failed if waiting again won't help.
+         */
+        [[nodiscard]] virtual FenceWaitResult waitFence(FenceID fence, std::uint64_t timeoutNanoseconds) = 0;
+
+        virtual Void deleteFence(FenceID fence) = 0;
+
         virtual Void setIndexBufferData(const UInt* data, Size count, Enums::BufferUsages buferUsage) =
         0;
 
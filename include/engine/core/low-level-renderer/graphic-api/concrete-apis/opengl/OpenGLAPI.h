@@ -41,6 +41,20 @@ namespace GLESC::GAPI {
             SDL_GL_DeleteContext(this->context);
         }
 
+        void makeContextCurrent(SDL_Window& window) override {
+            GAPI_FUNCTION_LOG("makeContextCurrent", "SDL_Window");
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("SDL_GL_MakeCurrent", "SDL_Window", this->context);
+            int err = SDL_GL_MakeCurrent(&window, this->context);
+            D_ASSERT_EQUAL(err, 0, "Unable to make context current: " + std::string(SDL_GetError()));
+        }
+
+        void releaseContext(SDL_Window& window) override {
+            GAPI_FUNCTION_LOG("releaseContext", "SDL_Window");
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("SDL_GL_MakeCurrent", "SDL_Window", "nullptr");
+            int err = SDL_GL_MakeCurrent(&window, nullptr);
+            D_ASSERT_EQUAL(err, 0, "Unable to release context: " + std::string(SDL_GetError()));
+        }
+
         void setViewport(Int width, Int height) override {
             this->setViewport(0, 0, width, height);
         }
@@ -192,6 +206,20 @@ namespace GLESC::GAPI {
                                     static_cast<int>(instanceCount));
         }
 
+        void multiDrawTrianglesIndexedIndirect(UInt firstCommand, UInt drawCount) override {
+            GAPI_FUNCTION_LOG("multiDrawTrianglesIndexedIndirect", firstCommand, drawCount);
+            // The indirect pointer is an offset in the bound indirect buffer
+            const auto* commandOffset = reinterpret_cast<const void*>(
+                static_cast<uintptr_t>(firstCommand) * sizeof(DrawElementsIndirectCommand));
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glMultiDrawElementsIndirect", GL_TRIANGLES, GL_UNSIGNED_INT,
+                                             firstCommand, drawCount, 0);
+            glMultiDrawElementsIndirect(static_cast<GLenum>(Enums::PrimitiveTypes::Triangles),
+                                        static_cast<GLenum>(Enums::Types::UInt),
+                                        commandOffset,
+                                        static_cast<GLsizei>(drawCount),
+                                        0);
+        }
+
 
         RGBAColor readPixelColor(int x, int y) override {
             GAPI_FUNCTION_LOG("readPixelColor", x, y);
@@ -491,6 +519,95 @@ namespace GLESC::GAPI {
             glBufferData(bufferTypeGL, size, nullptr, GL_DYNAMIC_DRAW);
         }
 
+        void setBufferSubData(const Void* data, Size offset, Size size, Enums::BufferTypes bufferType) override {
+            GAPI_FUNCTION_LOG("setBufferSubData", "data (is a pointer,can't be printed)", offset, size, bufferType);
+            auto bufferTypeGL = static_cast<GLenum>(bufferType);
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glBufferSubData", bufferTypeGL, offset, size, data);
+            glBufferSubData(bufferTypeGL, offset, size, data);
+        }
+
+        void bindBufferBase(Enums::BufferTypes bufferType, UInt index, UInt buffer) override {
+            GAPI_FUNCTION_LOG("bindBufferBase", bufferType, index, buffer);
+            auto bufferTypeGL = static_cast<GLenum>(bufferType);
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glBindBufferBase", bufferTypeGL, index, buffer);
+            glBindBufferBase(bufferTypeGL, index, buffer);
+        }
+
+        void bindBufferRange(Enums::BufferTypes bufferType, UInt index, UInt buffer, Size offset,
+                             Size size) override {
+            GAPI_FUNCTION_LOG("bindBufferRange", bufferType, index, buffer, offset, size);
+            auto bufferTypeGL = static_cast<GLenum>(bufferType);
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glBindBufferRange", bufferTypeGL, index, buffer, offset, size);
+            glBindBufferRange(bufferTypeGL, index, buffer, static_cast<GLintptr>(offset),
+                              static_cast<GLsizeiptr>(size));
+        }
+
+        Size getStorageBufferOffsetAlignment() override {
+            GAPI_FUNCTION_NO_ARGS_LOG("getStorageBufferOffsetAlignment");
+            Int alignment = 0;
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glGetIntegerv", GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, alignment);
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            D_ASSERT_TRUE(alignment > 0, "Failed to query the alignment of the storage buffers");
+            return static_cast<Size>(alignment);
+        }
+
+        void setPersistentBufferStorage(Size size, Enums::BufferTypes bufferType) override {
+            GAPI_FUNCTION_LOG("setPersistentBufferStorage", size, bufferType);
+            auto bufferTypeGL = static_cast<GLenum>(bufferType);
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glBufferStorage", bufferTypeGL, size, nullptr, flags);
+            glBufferStorage(bufferTypeGL, static_cast<GLsizeiptr>(size), nullptr, flags);
+        }
+
+        Void* mapPersistentBuffer(Size offset, Size size, Enums::BufferTypes bufferType) override {
+            GAPI_FUNCTION_LOG("mapPersistentBuffer", offset, size, bufferType);
+            auto bufferTypeGL = static_cast<GLenum>(bufferType);
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glMapBufferRange", bufferTypeGL, offset, size, flags);
+            Void* mapping = glMapBufferRange(bufferTypeGL, static_cast<GLintptr>(offset),
+                                             static_cast<GLsizeiptr>(size), flags);
+            D_ASSERT_NOT_NULLPTR(mapping, "The buffer couldn't be mapped");
+            return mapping;
+        }
+
+        void unmapBuffer(Enums::BufferTypes bufferType) override {
+            GAPI_FUNCTION_LOG("unmapBuffer", bufferType);
+            auto bufferTypeGL = static_cast<GLenum>(bufferType);
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glUnmapBuffer", bufferTypeGL);
+            glUnmapBuffer(bufferTypeGL);
+        }
+
+        void copyBufferSubData(UInt readBuffer, UInt writeBuffer, Size readOffset, Size writeOffset,
+                               Size size) override {
+            GAPI_FUNCTION_LOG("copyBufferSubData", readBuffer, writeBuffer, readOffset, writeOffset, size);
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glCopyNamedBufferSubData", readBuffer, writeBuffer, readOffset,
+                                             writeOffset, size);
+            glCopyNamedBufferSubData(readBuffer, writeBuffer, static_cast<GLintptr>(readOffset),
+                                     static_cast<GLintptr>(writeOffset), static_cast<GLsizeiptr>(size));
+        }
+
+        FenceID createFence() override {
+            GAPI_FUNCTION_NO_ARGS_LOG("createFence");
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glFenceSync", GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        FenceWaitResult waitFence(FenceID fence, std::uint64_t timeoutNanoseconds) override {
+            GAPI_FUNCTION_LOG("waitFence", "fence (is a pointer,can't be printed)", timeoutNanoseconds);
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glClientWaitSync", GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds);
+            // Flushing makes sure the fence reaches the GPU, otherwise the wait could never end
+            const GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNanoseconds);
+            if (result == GL_WAIT_FAILED) return FenceWaitResult::Failed;
+            if (result == GL_TIMEOUT_EXPIRED) return FenceWaitResult::TimedOut;
+            return FenceWaitResult::Signaled;
+        }
+
+        void deleteFence(FenceID fence) override {
+            GAPI_FUNCTION_LOG("deleteFence", "fence (is a pointer,can't be printed)");
+            GAPI_FUNCTION_IMPLEMENTATION_LOG("glDeleteSync", "fence (is a pointer,can't be printed)");
+            glDeleteSync(fence);
+        }
+
         void setIndexBufferData(const UInt* data, Size count, Enums::BufferUsages buferUsage) override {
             GAPI_FUNCTION_LOG("setIndexBufferData", "vectorData (is a pointer,can't be printed)",
                               count);
@@ -0,0 +1,315 @@
+/**************************************************************************************************
+ * @file   RecordingAPI.h
+ * @author Valentin Dumitru
+ * @date   2024-06-21
+ * @brief  Graphic API that keeps the buffers in memory and records the draws, without a GPU.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/low-level-renderer/graphic-api/IGraphicInterface.h"
+
+namespace GLESC::GAPI {
+    /**
+     * @brief Implementation of the graphic interface for the tests of the code that submits work to the GPU.
+     * @details The buffers, vertex arrays and textures are stored in memory and the draws are recorded with the
+     * state they were issued with, so a test can check what would be drawn without a graphic context. The multi
+     * draws record the commands read from the bound indirect buffer. The persistent buffers are mapped to their
+     * memory, and the fences are signaled after a configurable number of waits to simulate a busy GPU.
+     *
+     * The context, window and shader functions do nothing, the shaders always compile and link.
+     */
+    class RecordingAPI final : public IGraphicInterface {
+    public:
+        enum class DrawKind {
+            Triangles,
+            TrianglesIndexed,
+            TrianglesIndexedInstanced,
+            MultiTrianglesIndexedIndirect
+        };
+
+        /**
+         * @brief A vertex attribute of a vertex array, as it was configured.
+         */
+        struct VertexAttribute {
+            UInt buffer = 0;
+            UInt count = 0;
+            Enums::Types type = Enums::Types::Float;
+            Bool normalized = Bool::False;
+            UInt stride = 0;
+            UInt offset = 0;
+            UInt divisor = 0;
+            bool enabled = false;
+        };
+
+        /**
+         * @brief A range of a buffer bound to an indexed binding point.
+         */
+        struct BufferBinding {
+            UInt buffer = 0;
+            Size offset = 0;
+            /**
+             * @brief The size of the range, 0 if the whole buffer is bound.
+             */
+            Size size = 0;
+        };
+
+        /**
+         * @brief A draw call with the state it was issued with.
+         */
+        struct DrawCall {
+            DrawKind kind = DrawKind::Triangles;
+            UInt vertexArray = 0;
+            UInt indexBuffer = 0;
+            UInt shaderProgram = 0;
+            UInt start = 0;
+            UInt count = 0;
+            UInt instanceCount = 1;
+            /**
+             * @brief The commands of the multi draw, in the order they're drawn.
+             */
+            std::vector<DrawElementsIndirectCommand> commands;
+            /**
+             * @brief The buffers bound to the binding points of the storage buffers.
+             */
+            std::map<UInt, BufferBinding> storageBuffers;
+        };
+
+        RecordingAPI() = default;
+        ~RecordingAPI() override = default;
+
+        // ------------------------------------------------------------------------------
+        // ------------------------------- Recorded state -------------------------------
+
+        [[nodiscard]] const std::vector<DrawCall>& getDrawCalls() const { return drawCalls; }
+        void clearDrawCalls() { drawCalls.clear(); }
+
+        /**
+         * @brief The contents of a buffer, it must exist.
+         */
+        [[nodiscard]] const std::vector<std::uint8_t>& getBufferBytes(UInt buffer) const;
+        [[nodiscard]] size_t getBufferCount() const { return buffers.size(); }
+        /**
+         * @brief The attributes of a vertex array, indexed by their location.
+         */
+        [[nodiscard]] const std::map<UInt, VertexAttribute>& getVertexAttributes(UInt vertexArray) const;
+        /**
+         * @brief Number of bytes written to the buffers since the API was created, the uploads of the tests.
+         */
+        [[nodiscard]] size_t getUploadedBytes() const { return uploadedBytes; }
+        /**
+         * @brief Number of bytes copied between buffers since the API was created.
+         */
+        [[nodiscard]] size_t getCopiedBytes() const { return copiedBytes; }
+        /**
+         * @brief The bytes of a buffer in a range, for the buffers written through their mapping.
+         */
+        [[nodiscard]] std::vector<std::uint8_t> getBufferBytes(UInt buffer, Size offset, Size size) const;
+
+        /**
+         * @brief Simulates a busy GPU, the fences created from now on are signaled after being waited that many
+         * times.
+         */
+        void setFenceLatency(size_t waitsParam) { fenceLatency = waitsParam; }
+        /**
+         * @brief Number of fences that weren't deleted yet.
+         */
+        [[nodiscard]] size_t getFenceCount() const { return fences.size(); }
+        /**
+         * @brief Number of waits that timed out since the API was created.
+         */
+        [[nodiscard]] size_t getFenceTimeouts() const { return fenceTimeouts; }
+        /**
+         * @brief Simulates a lost context, the waits of the fences fail from now on.
+         */
+        void setFenceWaitsFail(bool failParam) { fenceWaitsFail = failParam; }
+        /**
+         * @brief Simulates another device, the offsets bound to the storage buffers must be multiples of it.
+         */
+        void setStorageBufferOffsetAlignment(Size alignmentParam) { storageBufferOffsetAlignment = alignmentParam; }
+
+        // ------------------------------------------------------------------------------
+        // ------------------------------ Graphic interface -----------------------------
+
+        Void preWindowCreationInit() override {}
+        Void postWindowCreationInit() override {}
+        Void clear(const std::initializer_list<Enums::ClearBits>& /*values*/) override {}
+        Void clearColor(Float r, Float g, Float b, Float a) override;
+        Void setViewport(Int width, Int height) override { setViewport(0, 0, width, height); }
+        Void setViewport(Int x, Int y, Int width, Int height) override { viewport = Viewport(x, y, width, height); }
+        Viewport getViewport() override { return viewport; }
+        Void swapBuffers(SDL_Window& /*window*/) override {}
+        Void createContext(SDL_Window& /*window*/) override {}
+        Void deleteContext() override {}
+        Void makeContextCurrent(SDL_Window& /*window*/) override {}
+        Void releaseContext(SDL_Window& /*window*/) override {}
+        void enableDepthBuffer(Bool /*enabled*/) override {}
+        void setDepthFunction(Enums::DepthFuncs /*depthFunction*/) override {}
+
+        Void drawTriangles(UInt start, UInt count) override;
+        Void drawTrianglesIndexed(UInt count) override;
+        Void drawTrianglesIndexedInstanced(UInt count, UInt instanceCount) override;
+        Void multiDrawTrianglesIndexedIndirect(UInt firstCommand, UInt drawCount) override;
+
+        RGBAColor readPixelColor(int x, int y) override;
+        RGBAColorNormalized readPixelColorNormalized(UInt /*x*/, UInt /*y*/) override { return clearColorValue; }
+
+        Bool isBuffer(UInt bufferID) override;
+        Void genBuffers(UInt amount, UInt& bufferID) override;
+        Void bindBuffer(Enums::BufferTypes bufferType, UInt buffer) override;
+        Void unbindBuffer(Enums::BufferTypes bufferType) override { bindBuffer(bufferType, 0); }
+        std::vector<float> getBufferDataF(UInt bufferId) override { return getBufferData<float>(bufferId); }
+        std::vector<unsigned int> getBufferDataUI(UInt bufferId) override {
+            return getBufferData<unsigned int>(bufferId);
+        }
+        std::vector<int> getBufferDataI(UInt bufferId) override { return getBufferData<int>(bufferId); }
+        Void deleteBuffer(UInt& buffer) override;
+        Void setDynamicBufferData(UInt size, Enums::BufferTypes bufferType) override;
+        Void bindBufferRange(Enums::BufferTypes bufferType, UInt index, UInt buffer, Size offset,
+                             Size size) override;
+        [[nodiscard]] Size getStorageBufferOffsetAlignment() override { return storageBufferOffsetAlignment; }
+        Void setPersistentBufferStorage(Size size, Enums::BufferTypes bufferType) override;
+        [[nodiscard]] Void* mapPersistentBuffer(Size offset, Size size, Enums::BufferTypes bufferType) override;
+        Void unmapBuffer(Enums::BufferTypes bufferType) override;
+        Void copyBufferSubData(UInt readBuffer, UInt writeBuffer, Size readOffset, Size writeOffset,
+                               Size size) override;
+        [[nodiscard]] FenceID createFence() override;
+        [[nodiscard]] FenceWaitResult waitFence(FenceID fence, std::uint64_t timeoutNanoseconds) override;
+        Void deleteFence(FenceID fence) override;
+        Void setIndexBufferData(const UInt* data, Size count, Enums::BufferUsages buferUsage) override {
+            setBufferData(data, count, sizeof(UInt), Enums::BufferTypes::Index, buferUsage);
+        }
+        Void setBufferData(const Void* data, Size count, Size size, Enums::BufferTypes bufferType,
+                           Enums::BufferUsages bufferUsage) override;
+        Void setBufferSubData(const Void* data, Size offset, Size size, Enums::BufferTypes bufferType) override;
+        Void bindBufferBase(Enums::BufferTypes bufferType, UInt index, UInt buffer) override;
+
+        Void genVertexArray(UInt& vertexArrayID) override;
+        Void setVertexAttribDivisor(UInt index, UInt divisor) override;
+        Void bindVertexArray(UInt vertexArrayID) override;
+        Void unbindVertexArray() override { bindVertexArray(0); }
+        Void deleteVertexArray(UInt& vertexArrayID) override;
+        Void enableVertexData(UInt index) override;
+        Void createVertexData(UInt vertexArray, UInt count, Enums::Types type, Bool isNormalized, UInt stride,
+                              UInt offset) override;
+
+        TextureID createTexture(Enums::Texture::Types textureType,
+                                Enums::Texture::Filters::Min minFilter,
+                                Enums::Texture::Filters::Mag magFilter,
+                                Enums::Texture::Filters::WrapMode wrapS,
+                                Enums::Texture::Filters::WrapMode wrapT,
+                                Enums::Texture::Filters::WrapMode wrapR) override;
+        Void setTextureData(Enums::Texture::Types textureType, Int level, UInt width, UInt height,
+                            Enums::Texture::CPUBufferFormat inputFormat, Enums::Texture::BitDepth bitsPerPixel,
+                            const UByte* texelBuffer) override;
+        [[nodiscard]] std::vector<UByte> getTextureData(TextureID textureID,
+                                                        Enums::Texture::Types textureType) override;
+        Enums::Texture::GPUBufferFormat getTextureColorFormat(TextureID /*textureID*/) override {
+            return Enums::Texture::GPUBufferFormat::RGBA;
+        }
+        UInt getTextureWidth(TextureID textureID) override { return textures.at(textureID).width; }
+        UInt getTextureHeight(TextureID textureID) override { return textures.at(textureID).height; }
+        Void bindTexture(TextureID textureID, Enums::Texture::Types /*textureType*/) override {
+            boundTexture = textureID;
+        }
+        Void bindTextureOnSlot(TextureID textureID, Enums::Texture::Types /*textureType*/, UInt /*slot*/) override {
+            boundTexture = textureID;
+        }
+        Void unbindTexture(Enums::Texture::Types /*textureType*/) override { boundTexture = 0; }
+        Void deleteTexture(TextureID textureID) override;
+
+        Void useShaderProgram(UInt shaderProgram) override { boundShaderProgram = shaderProgram; }
+        [[nodiscard]] bool isShaderProgram(UInt shaderProgram) override { return shaderProgram != 0; }
+        Void deleteShaderProgram(UInt /*shaderProgram*/) override {}
+        UInt loadAndCompileShader(Enums::ShaderTypes /*shaderType*/, const std::string& /*shaderSource*/) override {
+            return nextObjectId++;
+        }
+        bool compilationOK(UInt /*shaderID*/, Char* /*message*/) override { return true; }
+        UInt createShaderProgram(UInt /*vertexShaderID*/, UInt /*fragmentShaderID*/) override { return nextObjectId++; }
+        Void destroyShaderProgram(UInt /*shaderProgram*/) override {}
+        [[nodiscard]] bool linkOK(UInt /*programID*/, Char* /*message*/) override { return true; }
+        Void deleteShader(UInt /*shaderID*/) override {}
+
+        [[nodiscard]] std::vector<std::string> getAllUniforms() const override { return {}; }
+        Int getUniformLocation(const std::string& /*uName*/) const override { return -1; }
+
+    protected:
+        [[nodiscard]] Bool isTexture(UInt textureID) override {
+            return textures.count(textureID) > 0 ? Bool::True : Bool::False;
+        }
+        [[nodiscard]] Bool isTextureBound(UInt textureID) override {
+            return boundTexture == textureID ? Bool::True : Bool::False;
+        }
+        [[nodiscard]] Bool anyTextureBound() override { return boundTexture != 0 ? Bool::True : Bool::False; }
+
+    private:
+        struct VertexArrayState {
+            /**
+             * @brief The index buffer is part of the state of the vertex array, like in OpenGL.
+             */
+            UInt indexBuffer = 0;
+            std::map<UInt, VertexAttribute> attributes;
+        };
+
+        struct TextureState {
+            UInt width = 0;
+            UInt height = 0;
+            std::vector<UByte> texels;
+        };
+
+        template <typename Type>
+        std::vector<Type> getBufferData(UInt bufferId) const {
+            const std::vector<std::uint8_t>& bytes = getBufferBytes(bufferId);
+            std::vector<Type> data(bytes.size() / sizeof(Type));
+            std::memcpy(data.data(), bytes.data(), data.size() * sizeof(Type));
+            return data;
+        }
+
+        /**
+         * @brief The buffer bound to the target, it must exist.
+         */
+        [[nodiscard]] std::vector<std::uint8_t>& getBoundBuffer(Enums::BufferTypes bufferType);
+        [[nodiscard]] DrawCall createDrawCall(DrawKind kind) const;
+
+        std::unordered_map<UInt, std::vector<std::uint8_t>> buffers;
+        std::unordered_map<Enums::BufferTypes, UInt> boundBuffers;
+        std::map<UInt, BufferBinding> storageBuffers;
+        /**
+         * @brief The buffers with immutable storage, they can be mapped but not reallocated.
+         */
+        std::set<UInt> persistentBuffers;
+        /**
+         * @brief The biggest alignment OpenGL allows, so the code that works here works in any device.
+         */
+        Size storageBufferOffsetAlignment = 256;
+        /**
+         * @brief The waits left until each fence is signaled.
+         */
+        std::unordered_map<FenceID, size_t> fences;
+        size_t fenceLatency = 0;
+        size_t fenceTimeouts = 0;
+        bool fenceWaitsFail = false;
+        std::uintptr_t nextFenceId = 1;
+        std::unordered_map<UInt, VertexArrayState> vertexArrays;
+        UInt boundVertexArray = 0;
+        std::unordered_map<TextureID, TextureState> textures;
+        std::vector<DrawCall> drawCalls;
+        Viewport viewport;
+        RGBAColorNormalized clearColorValue;
+        size_t uploadedBytes = 0;
+        size_t copiedBytes = 0;
+        /**
+         * @brief The objects of every type share the ids, 0 is never used as in OpenGL.
+         */
+        UInt nextObjectId = 1;
+    }; // class RecordingAPI
+} // namespace GLESC::GAPI
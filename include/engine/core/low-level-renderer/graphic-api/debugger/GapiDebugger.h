@@ -135,6 +135,8 @@ namespace GLESC::GAPI::Enums {
         case Types::Byte: return "Byte";
         case Types::Short: return "Short";
         case Types::UShort: return "UShort";
+        case Types::HalfFloat: return "HalfFloat";
+        case Types::Int2101010Rev: return "Int2101010Rev";
         case Types::Vec2F: return "Vec2F";
         case Types::Vec3F: return "Vec3F";
         case Types::Vec4F: return "Vec4F";
@@ -147,6 +149,9 @@ namespace GLESC::GAPI::Enums {
         case Types::Vec2B: return "Vec2B";
         case Types::Vec3B: return "Vec3B";
         case Types::Vec4B: return "Vec4B";
+        case Types::Vec4H: return "Vec4H";
+        case Types::Vec4S: return "Vec4S";
+        case Types::Vec4UB: return "Vec4UB";
         case Types::Mat2F: return "Mat2F";
         case Types::Mat3F: return "Mat3F";
         case Types::Mat4F: return "Mat4F";
@@ -162,6 +167,9 @@ namespace GLESC::GAPI::Enums {
         switch (type) {
         case BufferTypes::Vertex: return "Vertex";
         case BufferTypes::Index: return "Index";
+        case BufferTypes::DrawIndirect: return "DrawIndirect";
+        case BufferTypes::ShaderStorage: return "ShaderStorage";
+        case BufferTypes::CopyWrite: return "CopyWrite";
         default: return "Invalid type";
         }
     }
@@ -21,7 +21,16 @@ namespace GLESC::GAPI {
     public:
         enum ShaderMacros {
             USE_COLOR,
-            USE_INSTANCE
+            USE_INSTANCE,
+            /**
+             * @brief The positions are dequantized with the uniforms uPositionScale and uPositionOffset
+             */
+            USE_QUANTIZED_POSITIONS,
+            /**
+             * @brief If the uniform uUseDrawParams is true, the matrices are read from the storage buffer of the
+             * draw parameters at uDrawOffset + gl_DrawID instead of the uniforms
+             */
+            USE_MULTI_DRAW
         };
 
         /**
@@ -10,10 +10,11 @@
 #pragma once
 
 #include <type_traits>
-#include <random>
 #include <cstring>
+#include <limits>
 #include <cmath>
 #include "engine/core/asserts/Asserts.h"
+#include "engine/core/math/random-generator/RandomGenerator.h"
 
 
 namespace GLESC::Math {
@@ -115,7 +116,7 @@ namespace GLESC::Math {
      * @return The value in radians
      */
     template <typename Type>
-    Type radians(const Type& degrees) noexcept {
+    constexpr Type radians(const Type& degrees) noexcept {
         return degrees * Type(PI) / Type(180);
     }
 
@@ -127,7 +128,7 @@ namespace GLESC::Math {
      * @return The value in degrees
      */
     template <typename Type>
-    Type degrees(const Type& radians) noexcept {
+    constexpr Type degrees(const Type& radians) noexcept {
         S_ASSERT_TRUE(std::is_floating_point_v<Type>, "Type must be floating point");
         return radians * Type(180) / Type(PI);
     }
@@ -593,43 +594,194 @@ namespace GLESC::Math {
         return result;
     }
 
+    /**
+     * @brief Checks if the call is being evaluated at compile time
+     * @details Lets a constexpr function use the functions of the standard library at runtime, which aren't
+     * constexpr, and an approximation at compile time. It's always false in the compilers without the builtin, there
+     * the constexpr approximations must be called directly to be evaluated at compile time.
+     * @return True if the call is being evaluated at compile time, false otherwise
+     */
+    constexpr bool isConstantEvaluated() noexcept {
+#if (defined(__GNUC__) && __GNUC__ >= 9) || (defined(__clang__) && __clang_major__ >= 9) \
+    || (defined(_MSC_VER) && _MSC_VER >= 1925)
+        return __builtin_is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Calculates the square root of a value at compile time
+     * @details Uses the Newton-Raphson method starting above the root, so each step gets closer until the value
+     * stops decreasing. The result is within one unit in the last place of the root, but it's much slower than
+     * std::sqrt, use Math::sqrt at runtime.
+     * @tparam Type The floating point type of the value
+     * @param value The value to calculate the square root of
+     * @return The square root of the value, NaN if the value is negative
+     */
+    template <typename Type>
+    constexpr Type constexprSqrt(Type value) {
+        S_ASSERT_TRUE(std::is_floating_point_v<Type>, "Type must be floating point");
+        if (value < Type(0)) {
+            return std::numeric_limits<Type>::quiet_NaN();
+        }
+        // Zero, infinity and NaN are their own root
+        if (value == Type(0) || value == std::numeric_limits<Type>::infinity() || value != value) {
+            return value;
+        }
+        Type root = value > Type(1) ? value : Type(1);
+        while (true) {
+            const Type next = (root + value / root) / Type(2);
+            if (next >= root) {
+                return root;
+            }
+            root = next;
+        }
+    }
+
+    /**
+     * @brief Reduces an angle to the range [-PI, PI]
+     * @details The angle is rounded to the nearest number of turns in long double, so it's exact for any angle used
+     * in a table or a transform, it loses precision beyond millions of turns.
+     */
+    template <typename Type>
+    constexpr Type constexprReduceAngle(Type radians) {
+        const long double turns = static_cast<long double>(radians) / (2 * PI);
+        const auto wholeTurns = static_cast<long long>(turns >= 0 ? turns + 0.5L : turns - 0.5L);
+        return static_cast<Type>(static_cast<long double>(radians) - static_cast<long double>(wholeTurns) * 2 * PI);
+    }
+
+    /**
+     * @brief Calculates the sine of a value at compile time
+     * @details The angle is reduced to [-PI/2, PI/2] with the symmetries of the sine and then the Taylor series is
+     * added until the terms are too small to change the result. The error is of a few units in the last place.
+     * @tparam Type The floating point type of the value
+     * @param radians The angle in radians
+     * @return The sine of the angle
+     */
+    template <typename Type>
+    constexpr Type constexprSin(Type radians) {
+        S_ASSERT_TRUE(std::is_floating_point_v<Type>, "Type must be floating point");
+        // The series is added in double at least, so the result of the floats is rounded only once
+        using Real = std::conditional_t<(sizeof(Type) > sizeof(double)), Type, double>;
+        Real angle = constexprReduceAngle(static_cast<Real>(radians));
+        // sin(x) = sin(PI - x), moves the angle to [-PI/2, PI/2]
+        if (angle > Real(PI) / 2) {
+            angle = Real(PI) - angle;
+        }
+        else if (angle < -Real(PI) / 2) {
+            angle = -Real(PI) - angle;
+        }
+        const Real squared = angle * angle;
+        Real term = angle;
+        Real sum = angle;
+        for (int n = 1; n < 30; ++n) {
+            term *= -squared / static_cast<Real>((2 * n) * (2 * n + 1));
+            const Real nextSum = sum + term;
+            if (nextSum == sum) {
+                break;
+            }
+            sum = nextSum;
+        }
+        return static_cast<Type>(sum);
+    }
+
+    /**
+     * @brief Calculates the cosine of a value at compile time
+     * @details Same method as constexprSin, with the series of the cosine.
+     * @see constexprSin
+     * @tparam Type The floating point type of the value
+     * @param radians The angle in radians
+     * @return The cosine of the angle
+     */
+    template <typename Type>
+    constexpr Type constexprCos(Type radians) {
+        S_ASSERT_TRUE(std::is_floating_point_v<Type>, "Type must be floating point");
+        using Real = std::conditional_t<(sizeof(Type) > sizeof(double)), Type, double>;
+        Real angle = constexprReduceAngle(static_cast<Real>(radians));
+        angle = angle < 0 ? -angle : angle;
+        // cos(x) = -cos(PI - x), moves the angle to [0, PI/2]
+        Real sign = 1;
+        if (angle > Real(PI) / 2) {
+            angle = Real(PI) - angle;
+            sign = -1;
+        }
+        const Real squared = angle * angle;
+        Real term = 1;
+        Real sum = 1;
+        for (int n = 1; n < 30; ++n) {
+            term *= -squared / static_cast<Real>((2 * n - 1) * (2 * n));
+            const Real nextSum = sum + term;
+            if (nextSum == sum) {
+                break;
+            }
+            sum = nextSum;
+        }
+        return static_cast<Type>(sign * sum);
+    }
+
+    /**
+     * @brief Calculates the tangent of a value at compile time
+     * @see constexprSin
+     * @tparam Type The floating point type of the value
+     * @param radians The angle in radians
+     * @return The tangent of the angle
+     */
+    template <typename Type>
+    constexpr Type constexprTan(Type radians) {
+        S_ASSERT_TRUE(std::is_floating_point_v<Type>, "Type must be floating point");
+        using Real = std::conditional_t<(sizeof(Type) > sizeof(double)), Type, double>;
+        return static_cast<Type>(constexprSin(static_cast<Real>(radians)) / constexprCos(static_cast<Real>(radians)));
+    }
+
     /**
      * @brief Calculates the cosine of a value
      * @details The cosine of an angle is the ratio of the length of the adjacent side to the length of the hypotenuse.
+     * At compile time it uses constexprCos, at runtime std::cos.
      * @tparam Type The type of the value
      * @param value The value to calculate the cosine of
      * @return The cosine of the value
      */
     template <typename Type>
-    auto cos(const Type& value) {
+    constexpr auto cos(const Type& value) {
         S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic");
+        if (isConstantEvaluated()) {
+            return constexprCos(static_cast<decltype(std::cos(value))>(value));
+        }
         return std::cos(value);
     }
 
     /**
      * @brief Calculates the sine of a value
      * @details The sine of an angle is the ratio of the length of the opposite side to the length of the hypotenuse.
+     * At compile time it uses constexprSin, at runtime std::sin.
      * @tparam Type The type of the value
      * @param value The value to calculate the sine of
      * @return The sine of the value
      */
     template <typename Type>
-    auto sin(const Type& value) {
+    constexpr auto sin(const Type& value) {
         S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic");
+        if (isConstantEvaluated()) {
+            return constexprSin(static_cast<decltype(std::sin(value))>(value));
+        }
         return std::sin(value);
     }
 
     /**
      * @brief Calculates the tangent of a value
      * @details The tangent of an angle is the ratio of the length of the opposite side to the
-     * length of the adjacent side.
+     * length of the adjacent side. At compile time it uses constexprTan, at runtime std::tan.
      * @tparam Type The type of the value
      * @param value The value to calculate the tangent of
      * @return The tangent of the value
      */
     template <typename Type>
-    auto tan(const Type& value) {
+    constexpr auto tan(const Type& value) {
         S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic");
+        if (isConstantEvaluated()) {
+            return constexprTan(static_cast<decltype(std::tan(value))>(value));
+        }
         return std::tan(value);
     }
 
@@ -649,15 +801,17 @@ namespace GLESC::Math {
 
 
     /**
-     * @brief Generates a random number between min and max, specifically [min, max)
-     * @details The random number is generated using the Mersenne Twister algorithm
+     * @brief Generates a random number between min and max, [min, max] for integers and [min, max) for floats
+     * @details The random number is generated with the generator of the calling thread, so it can be called from
+     * several threads at the same time. The sequence is reproducible with RandomGenerator::setThreadsSeed.
      * The min and max values parameters must follow the following rules:
      * - (max - min) < std::numeric_limits<Type>::max()
      * - max >= min
+     * @see RandomGenerator
      * @tparam Type The type of the random number
      * @param min The minimum value of the random number
      * @param max The maximum value of the random number
-     * @return A random number of the given type in the range [min, max)
+     * @return A random number of the given type in the range
      */
     template <typename Type, typename = std::enable_if_t<std::is_arithmetic_v<Type>>>
     [[nodiscard]] Type generateRandomNumber(Type min, Type max) {
@@ -665,33 +819,29 @@ namespace GLESC::Math {
         D_ASSERT_TRUE(max >= min, "Max must be greater than min");
         D_ASSERT_TRUE((max + GLESC::Math::abs(min)) < std::numeric_limits<Type>::max(),
                       "(Max - min) must be less than the max value of the type");
-        static std::random_device rd;
-        static std::mt19937 mt(rd());
+        return RandomGenerator::getThreadGenerator().uniform(min, max);
+    }
 
-        // If the type is uint, we use the fast unsigned int type for the distribution
-        if constexpr (std::is_unsigned_v<Type> && std::is_integral_v<Type>) {
-            std::uniform_int_distribution<std::mt19937::result_type> dist(min, max);
-            return dist(mt);
-        }
-        // If the type is int, we just use the int type for the int distribution
-        else if constexpr (std::is_integral_v<Type>) {
-            std::uniform_int_distribution<Type> dist(min, max);
-            return dist(mt);
-        }
-        else if constexpr (std::is_floating_point_v<Type>) {
-            // For other types (int, etc.), use the type directly
-            std::uniform_real_distribution<Type> dist(min, max);
-            return dist(mt);
-        }
-        else {
-            D_ASSERT_TRUE(false, "Type not supported for random number generation");
-        }
+    /**
+     * @brief Fills the array with random numbers between min and max, the same ranges as generateRandomNumber
+     * @details Faster than calling generateRandomNumber for each element, the generator of the thread is looked up
+     * only once and the floats are made two at a time.
+     * @see RandomGenerator::fillUniform
+     * @tparam Type The type of the random numbers
+     * @param values The array to fill
+     * @param count The number of elements of the array
+     * @param min The minimum value of the random numbers
+     * @param max The maximum value of the random numbers
+     */
+    template <typename Type>
+    void fillUniform(Type* values, size_t count, Type min, Type max) {
+        RandomGenerator::getThreadGenerator().fillUniform(values, count, min, max);
     }
 
     /**
      * @brief Simulates a perfect coin toss with a given chance of success
      * @details The function returns true with the given chance of success, and false otherwise.
-     * Makes use of the generateRandomNumber function to generate a random number between 0 and 1.
+     * Uses the generator of the calling thread, like generateRandomNumber.
      * @see generateRandomNumber
      * @tparam Type The type of the chance
      * @param chance The chance of success
@@ -701,7 +851,7 @@ namespace GLESC::Math {
     [[nodiscard]] bool tossCoinWithChance(Type chance) {
         S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic");
         D_ASSERT_TRUE(chance >= 0.0f && chance <= 1.0f, "Chance must be between 0 and 1");
-        return generateRandomNumber<float>(0.0f, 1.0f) < chance;
+        return RandomGenerator::getThreadGenerator().chance(static_cast<float>(chance));
     }
 
     /**
@@ -15,6 +15,7 @@
 
 #include "engine/core/exceptions/core/math/MathException.h"
 #include "engine/core/math/algebra/matrix/MatrixMixedAlgorithms.h"
+#include "engine/core/math/algebra/quaternion/Quaternion.h"
 #include "engine/core/math/algebra/vector/Vector.h"
 #include "MatrixAlgorithms.h"
 
@@ -27,7 +28,7 @@ namespace GLESC::Math {
      * @tparam M The number of columns in the matrix
      */
     template <typename Type, size_t N, size_t M>
-    class Matrix {
+    class alignas(matrixAlignment<Type, N, M>) Matrix {
         S_ASSERT_TRUE(N > 0 && M > 0, "Matrix must have at least one row and one column.");
 
     public:
@@ -37,14 +38,14 @@ namespace GLESC::Math {
         /**
          * @brief Constructs a matrix with all elements set to zero.
          */
-        Matrix() {
+        constexpr Matrix() {
             MatrixAlgorithms::setMatrixZero(this->data);
         }
         /**
          * @brief Constructs a matrix with the diagonal elements set to the given value.
          * @param diagonal The value to set the diagonal elements to.
          */
-        explicit Matrix(const Type diagonal) {
+        constexpr explicit Matrix(const Type diagonal) {
             MatrixAlgorithms::setMatrixDiagonal(this->data, diagonal);
         }
 
@@ -53,7 +54,7 @@ namespace GLESC::Math {
          * @details The array list must have N * M elements
          * @param data
          */
-        explicit Matrix(const Type (&data)[N][M]) {
+        constexpr explicit Matrix(const Type (&data)[N][M]) {
             MatrixAlgorithms::setMatrix(this->data, data);
         }
 
@@ -61,23 +62,21 @@ namespace GLESC::Math {
          * @brief Constructor from a 2D array
          * @param other The 2D array to copy from
          */
-        explicit Matrix(const MatrixData<Type, N, M>& other) {
-            MatrixAlgorithms::setMatrix(this->data, other);
+        constexpr explicit Matrix(const MatrixData<Type, N, M>& other) : data(other) {
         }
         /**
          * @brief Constructor from MatrixData
          * @see MatrixData
          * @param other The 2D array to move from
          */
-        explicit Matrix(const MatrixData<Type, N, M>&& other) {
-            MatrixAlgorithms::setMatrix(this->data, other);
+        constexpr explicit Matrix(const MatrixData<Type, N, M>&& other) : data(other) {
         }
         /**
          * @brief Constructor from another matrix
          * @param other The matrix to copy from
          */
         template <typename OtherType, size_t OtherN, size_t OtherM>
-        explicit Matrix(const Matrix<OtherType, OtherN, OtherM>& other) {
+        constexpr explicit Matrix(const Matrix<OtherType, OtherN, OtherM>& other) {
             MatrixAlgorithms::resizeMatrix(other.data, this->data);
         }
 
@@ -86,16 +85,14 @@ namespace GLESC::Math {
          * @brief Copy constructor
          * @param other The matrix to copy from
          */
-        Matrix(const Matrix& other) {
-            MatrixAlgorithms::copyMatrix(this->data, other.data);
+        constexpr Matrix(const Matrix& other) : data(other.data) {
         }
 
         /**
          * @brief Move constructor
          * @param other The matrix to move from
          */
-        Matrix(Matrix&& other) noexcept {
-            MatrixAlgorithms::moveMatrix(this->data, std::move(other.data));
+        constexpr Matrix(Matrix&& other) noexcept : data(std::move(other.data)) {
         }
 
 
@@ -177,7 +174,12 @@ namespace GLESC::Math {
          */
         Matrix& operator*=(const Matrix& rhs) {
             S_ASSERT_TRUE(N == M, "Matrix must be square for in-place multiplication");
-            MatrixAlgorithms::matrixMatrixMulInPlace(this->data, rhs.data, this->data);
+            if constexpr (SimdAlgorithms::isMat4Mul<Type, N, M, N> && MatrixAlgorithms::columnMajorMatrix) {
+                MatrixAlgorithms::matrixMatrixMulFastColMaj(this->data, rhs.data, this->data);
+            }
+            else {
+                MatrixAlgorithms::matrixMatrixMulInPlace(this->data, rhs.data, this->data);
+            }
             return *this;
         }
 
@@ -320,6 +322,7 @@ namespace GLESC::Math {
          * | 4 5 6 | * | 9  10 | = | 139 154 |
          *             | 11 12 |
          * 2x3      *     3x2    =     2x2
+         * The 4x4 float matrices, the ones of the renderer, use the fast product without compensation.
          * @tparam X
          * @param other
          * @return
@@ -328,7 +331,12 @@ namespace GLESC::Math {
         [[nodiscard]] auto operator*(const Matrix<Type, X, N>& other) const {
             if constexpr (MatrixAlgorithms::columnMajorMatrix) {
                 Matrix<Type, X, M> result;
-                MatrixAlgorithms::matrixMatrixMulColMaj(this->data, other.data, result.data);
+                if constexpr (SimdAlgorithms::isMat4Mul<Type, M, N, X>) {
+                    MatrixAlgorithms::matrixMatrixMulFastColMaj(this->data, other.data, result.data);
+                }
+                else {
+                    MatrixAlgorithms::matrixMatrixMulColMaj(this->data, other.data, result.data);
+                }
                 return result;
             }
             else {
@@ -410,7 +418,7 @@ namespace GLESC::Math {
          * @param index The row index
          * @return The const row at the given index
          */
-        [[nodiscard]] const std::array<Type, M>& operator[](size_t index) const {
+        [[nodiscard]] constexpr const std::array<Type, M>& operator[](size_t index) const {
             return data[index];
         }
 
@@ -419,7 +427,7 @@ namespace GLESC::Math {
          * @param index The row index
          * @return The row at the given index
          */
-        [[nodiscard]] std::array<Type, M>& operator[](size_t index) {
+        [[nodiscard]] constexpr std::array<Type, M>& operator[](size_t index) {
             return data[index];
         }
 
@@ -429,7 +437,7 @@ namespace GLESC::Math {
          * @param j The column index
          * @return The value at the given row and column
          */
-        [[nodiscard]] const Type& get(size_t i, size_t j) const {
+        [[nodiscard]] constexpr const Type& get(size_t i, size_t j) const {
             return data[i][j];
         }
 
@@ -438,7 +446,7 @@ namespace GLESC::Math {
          * @param i The row index
          * @return The const row at the given index
          */
-        [[nodiscard]] const MatrixRow<Type, M>& get(size_t i) const {
+        [[nodiscard]] constexpr const MatrixRow<Type, M>& get(size_t i) const {
             return data[i];
         }
 
@@ -537,6 +545,30 @@ namespace GLESC::Math {
             return inv;
         }
 
+        /**
+         * @brief Calculates the inverse of an affine 4x4 matrix, like a model or a view matrix.
+         * @details Much faster than inverse(), the last row of the matrix must be (0, 0, 0, 1).
+         * @return The inverse of the matrix
+         */
+        [[nodiscard]] Matrix<Type, 4, 4> affineInverse() const {
+            S_ASSERT_TRUE(N == 4 && M == 4, "Affine inverse can only be calculated for 4x4 matrices");
+            Matrix<Type, 4, 4> inv;
+            MatrixAlgorithms::affineInverse(this->data, inv.data);
+            return inv;
+        }
+
+        /**
+         * @brief Calculates the inverse of a matrix made only of a rotation and a translation.
+         * @details The fastest inverse, the rotation is transposed and the translation negated, there is no division.
+         * @return The inverse of the matrix
+         */
+        [[nodiscard]] Matrix<Type, 4, 4> rigidInverse() const {
+            S_ASSERT_TRUE(N == 4 && M == 4, "Rigid inverse can only be calculated for 4x4 matrices");
+            Matrix<Type, 4, 4> inv;
+            MatrixAlgorithms::rigidInverse(this->data, inv.data);
+            return inv;
+        }
+
         /**
          * @brief Creates a model matrix from the given position, rotation and scale vectors.
          * @details This operation will overwrite the current matrix with the result of the model matrix
@@ -557,6 +589,27 @@ namespace GLESC::Math {
             return *this;
         }
 
+        /**
+         * @brief Creates a model matrix from the given position, rotation quaternion and scale.
+         * @details Gives the same matrix as the overload with the Euler angles, but it's built directly from the
+         * quaternion, without trigonometry or matrix products.
+         * @tparam PosType The type of the position vector
+         * @tparam RotType The type of the quaternion components
+         * @tparam ScaleType The type of the scale vector
+         * @param position The position vector
+         * @param rotation The rotation, as a unit quaternion
+         * @param scale The scale vector
+         */
+        template <typename PosType, typename RotType, typename ScaleType>
+        Matrix& makeModelMatrix(const Vector<PosType, 3>& position,
+                                const Quaternion<RotType>& rotation,
+                                const Vector<ScaleType, 3>& scale) {
+            S_ASSERT_TRUE(N == 4 && M == 4, "Model matrix can only be created for 4x4 matrices");
+            MatrixMixedAlgorithms::calculateModelMatrixFromQuaternion<Type, PosType, RotType, ScaleType>
+                (position.data, rotation.getData(), scale.data, this->data);
+            return *this;
+        }
+
         /**
          * @brief Creates a translation matrix from the given position vector.
          * @details This operation will overwrite the current matrix with the result of the translation matrix
@@ -565,7 +618,7 @@ namespace GLESC::Math {
          * @param position The position vector
          */
         template  <typename PosType>
-        Matrix& makeTranslationMatrix(const Vector<PosType, 3>& position) {
+        constexpr Matrix& makeTranslationMatrix(const Vector<PosType, 3>& position) {
             S_ASSERT_TRUE(N == 4 && M == 4, "Translation matrix can only be created for 4x4 matrices");
             MatrixAlgorithms::getTranslationMatrix<Type, PosType>(position.data, this->data);
             return *this;
@@ -585,6 +638,18 @@ namespace GLESC::Math {
             return *this;
         }
 
+        /**
+         * @brief Creates a rotation matrix from the given quaternion.
+         * @tparam RotType The type of the quaternion components
+         * @param rotation The rotation, as a unit quaternion
+         */
+        template <typename RotType>
+        Matrix& makeRotationMatrix(const Quaternion<RotType>& rotation) {
+            S_ASSERT_TRUE(N == 4 && M == 4, "Rotation matrix can only be created for 4x4 matrices");
+            MatrixMixedAlgorithms::getRotate3DMatrixFromQuaternion<RotType, Type>(rotation.getData(), this->data);
+            return *this;
+        }
+
         /**
          * @brief Creates a scale matrix from the given scale vector.
          * @details This operation will overwrite the current matrix with the result of the scale matrix
@@ -593,7 +658,7 @@ namespace GLESC::Math {
          * @param scale The scale vector
          */
         template <typename ScaleType>
-        Matrix& makeScaleMatrix(const Vector<ScaleType, 3>& scale) {
+        constexpr Matrix& makeScaleMatrix(const Vector<ScaleType, 3>& scale) {
             S_ASSERT_TRUE(N == 4 && M == 4, "Scale matrix can only be created for 4x4 matrices");
             MatrixAlgorithms::getScaleMatrix<Type, ScaleType>(scale.data, this->data);
             return *this;
@@ -613,6 +678,20 @@ namespace GLESC::Math {
             return *this;
         }
 
+        /**
+         * @brief Creates a normal matrix from a model-view matrix that has the same scale in every axis.
+         * @details Faster than makeNormalMatrix, the normal matrix is the model-view matrix divided by the square of
+         * its scale, there is nothing to invert.
+         * @tparam ModelType The type of the model-view matrix
+         * @param MVMat The model-view matrix, without non-uniform scale
+         */
+        template <typename ModelType>
+        Matrix& makeNormalMatrixUniformScale(const Matrix<ModelType, 4, 4>& MVMat) {
+            S_ASSERT_TRUE(N == 3 && M == 3, "Normal matrix can only be created for 4x4 matrices");
+            MatrixAlgorithms::calculateNormalMatrixUniformScale(MVMat.data, this->data);
+            return *this;
+        }
+
         /**
          * @brief Creates a view matrix from the given position, rotation and scale vectors.
          * @details This operation will overwrite the current matrix with the result of the view matrix
@@ -660,11 +739,11 @@ namespace GLESC::Math {
          * @param viewWidth The width of the view
          * @param viewHeight The height of the view
          */
-        Matrix& makeProjectionMatrix(float fovDegrees,
-                                  float nearPlane,
-                                  float farPlane,
-                                  float viewWidth,
-                                  float viewHeight) {
+        constexpr Matrix& makeProjectionMatrix(float fovDegrees,
+                                               float nearPlane,
+                                               float farPlane,
+                                               float viewWidth,
+                                               float viewHeight) {
             S_ASSERT_TRUE(N == 4 && M == 4, "Projection matrix can only be created for 4x4 matrices");
             MatrixAlgorithms::perspective<Type>(Math::radians(fovDegrees), nearPlane, farPlane, viewWidth, viewHeight,
                                                 this->data);
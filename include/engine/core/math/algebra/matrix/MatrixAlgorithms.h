@@ -10,6 +10,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iostream>
 #include <map>
@@ -20,6 +21,7 @@
 #include "engine/core/exceptions/core/math/MathException.h"
 #include "engine/core/math/Math.h"
 #include "engine/core/math/algebra/matrix/MatrixTypes.h"
+#include "engine/core/math/algebra/simd/SimdAlgorithms.h"
 #include "engine/core/math/algebra/vector/VectorTypes.h"
 
 namespace GLESC::Math {
@@ -49,7 +51,7 @@ namespace GLESC::Math {
          * @param result The new matrix.
          */
         template <typename Type1, size_t N1, size_t M1, typename Type2, size_t N2, size_t M2>
-        static void resizeMatrix(const MatrixData<Type1, N1, M1>& matrix, MatrixData<Type2, N2, M2>& result) {
+        static constexpr void resizeMatrix(const MatrixData<Type1, N1, M1>& matrix, MatrixData<Type2, N2, M2>& result) {
             for (size_t i = 0; i < N2; ++i) {
                 for (size_t j = 0; j < M2; ++j) {
                     // Check if current indices are within the bounds of the original matrix
@@ -94,7 +96,7 @@ namespace GLESC::Math {
          * @param matrixObjective The matrix to be set.
          */
         template <typename Type, size_t N, size_t M>
-        static void setMatrixZero(MatrixData<Type, N, M>& matrixObjective) {
+        static constexpr void setMatrixZero(MatrixData<Type, N, M>& matrixObjective) {
             MatrixAlgorithms::fillMatrix(matrixObjective, Type(0));
         }
 
@@ -106,7 +108,7 @@ namespace GLESC::Math {
          * @param matrixObjective The matrix to be set.
          */
         template <typename Type, size_t N, size_t M>
-        static void fillMatrix(MatrixData<Type, N, M>& matrixObjective, const Type& value) {
+        static constexpr void fillMatrix(MatrixData<Type, N, M>& matrixObjective, const Type& value) {
             for (size_t i = 0; i < N; ++i)
                 for (size_t j = 0; j < M; ++j)
                     matrixObjective[i][j] = value;
@@ -121,7 +123,7 @@ namespace GLESC::Math {
          * @param value The value to be set on the diagonal.
          */
         template <typename Type, size_t N>
-        static void setMatrixDiagonal(MatrixData<Type, N, N>& matrixObjective, const Type& value) {
+        static constexpr void setMatrixDiagonal(MatrixData<Type, N, N>& matrixObjective, const Type& value) {
             for (size_t i = 0; i < N; ++i)
                 matrixObjective[i][i] = value;
         }
@@ -138,7 +140,7 @@ namespace GLESC::Math {
          * @param rightMat The raw array containing the values to be copied into the matrix.
          */
         template <typename Type1, typename Type2, size_t N, size_t M>
-        static void setMatrix(MatrixData<Type1, N, M>& leftMat, const MatrixData<Type2, N, M>& rightMat) {
+        static constexpr void setMatrix(MatrixData<Type1, N, M>& leftMat, const MatrixData<Type2, N, M>& rightMat) {
             MatrixAlgorithms::copyMatrix(leftMat, rightMat);
         }
 
@@ -152,7 +154,7 @@ namespace GLESC::Math {
          * @param values The raw array containing the values to be copied into the matrix.
          */
         template <typename Type, size_t N, size_t M>
-        static void setMatrix(MatrixData<Type, N, M>& matrixObjective, const Type (&values)[N][M]) {
+        static constexpr void setMatrix(MatrixData<Type, N, M>& matrixObjective, const Type (&values)[N][M]) {
             for (size_t i = 0; i < N; ++i)
                 for (size_t j = 0; j < M; ++j)
                     matrixObjective[i][j] = values[i][j];
@@ -169,8 +171,8 @@ namespace GLESC::Math {
          * @param matrixToCopy The source matrix from which the data will be copied.
          */
         template <typename Type1, typename Type2, size_t N, size_t M>
-        static void copyMatrix(MatrixData<Type1, N, M>& matrixObjective,
-                               const MatrixData<Type2, N, M>& matrixToCopy) {
+        static constexpr void copyMatrix(MatrixData<Type1, N, M>& matrixObjective,
+                                         const MatrixData<Type2, N, M>& matrixToCopy) {
             S_ASSERT_TRUE(std::is_copy_assignable_v<Type2>, "Type1 must be copy assignable.");
             S_ASSERT_TRUE((std::is_convertible_v<Type2, Type1>), "Type1 must be convertible from Type2.");
 
@@ -197,7 +199,8 @@ namespace GLESC::Math {
          * @param matrixToMove The source matrix from which the data will be moved.
          */
         template <typename Type, size_t N, size_t M>
-        static void moveMatrix(MatrixData<Type, N, M>& matrixObjective, MatrixData<Type, N, M>&& matrixToMove) {
+        static constexpr void moveMatrix(MatrixData<Type, N, M>& matrixObjective,
+                                         MatrixData<Type, N, M>&& matrixToMove) {
             if (&matrixObjective == &matrixToMove)
                 return;
 
@@ -217,7 +220,7 @@ namespace GLESC::Math {
          * @param values The rvalue raw array containing the values to be moved into the matrix.
          */
         template <typename Type, size_t N, size_t M>
-        static void setMatrix(MatrixData<Type, N, M>& matrixObjective, const Type (&&values)[N][M]) {
+        static constexpr void setMatrix(MatrixData<Type, N, M>& matrixObjective, const Type (&&values)[N][M]) {
             if (&matrixObjective == &values)
                 return;
             for (size_t i = 0; i < N; ++i)
@@ -456,6 +459,25 @@ namespace GLESC::Math {
             }
         }
 
+        /**
+         * @brief Matrix multiplication without the compensation of matrixMatrixMulColMaj, for the hot paths.
+         * @details The product of two 4x4 float matrices, the one of the renderer, goes through SimdAlgorithms and
+         * can be computed in place. The rest of the sizes use the naive product. With only 4 products per element
+         * the compensation barely changes the result, but it prevents computing the elements in parallel.
+         */
+        template <typename Type, size_t N, size_t M, size_t X>
+        static void matrixMatrixMulFastColMaj(const MatrixData<Type, M, N>& matrix1,
+                                              const MatrixData<Type, X, M>& matrix2,
+                                              MatrixData<Type, X, N>& result) {
+            if constexpr (SimdAlgorithms::isMat4Mul<Type, N, M, X>) {
+                S_ASSERT_TRUE(sizeof(MatrixData<Type, 4, 4>) == sizeof(float) * 16, "The columns must be contiguous");
+                SimdAlgorithms::mat4Mul(matrix1[0].data(), matrix2[0].data(), result[0].data());
+            }
+            else {
+                matrixMatrixMulNaiveColMaj(matrix1, matrix2, result);
+            }
+        }
+
         template <typename Type, size_t N, size_t M, size_t X>
         static void matrixMatrixMulNaiveRowMaj(const MatrixData<Type, N, M>& matrix1,
                                                const MatrixData<Type, M, X>& matrix2,
@@ -491,6 +513,10 @@ namespace GLESC::Math {
         static void matrixVectorMulColMaj(const MatrixData<Type, M, N>& matrix,
                                           const VectorData<Type, M>& vector,
                                           VectorData<Type, N>& result) {
+            if constexpr (SimdAlgorithms::isMat4<Type, N, M>) {
+                SimdAlgorithms::mat4VecMul(matrix[0].data(), vector.data(), result.data());
+                return;
+            }
             for (size_t i = 0; i < N; ++i) {
                 Type sum = 0;
                 for (size_t j = 0; j < M; ++j) {
@@ -626,8 +652,8 @@ namespace GLESC::Math {
          * @param result The result matrix.
          */
         template <typename TypeMat, typename TypePos>
-        static void getTranslationMatrix(const VectorData<TypePos, 3>& translation,
-                                         MatrixData<TypeMat, 4, 4>& result) {
+        static constexpr void getTranslationMatrix(const VectorData<TypePos, 3>& translation,
+                                                   MatrixData<TypeMat, 4, 4>& result) {
             // Create the translation matrix
             MatrixAlgorithms::setMatrixZero(result);
             MatrixAlgorithms::setMatrixDiagonal(result, TypeMat(1));
@@ -648,8 +674,8 @@ namespace GLESC::Math {
          * @param result The result matrix.
          */
         template <typename Type1, typename Type2, size_t N>
-        static void getScaleMatrix(const VectorData<Type2, N - 1>& scale,
-                                   MatrixData<Type1, N, N>& result) {
+        static constexpr void getScaleMatrix(const VectorData<Type2, N - 1>& scale,
+                                             MatrixData<Type1, N, N>& result) {
             static_assert(N == 3 || N == 4, "Scaling only makes sense for 3x3 and 4x4 matrices.");
 
             // Create the scale matrix
@@ -665,7 +691,10 @@ namespace GLESC::Math {
 
         /**
          * @brief Calculates the normal matrix given the model-view matrix.
-         * @details The normal matrix is used to transform the normal vectors from model space to eye space.
+         * @details The normal matrix is used to transform the normal vectors from model space to eye space. It's the
+         * inverse transpose of the upper 3x3 part, which is its cofactor matrix divided by its determinant, so the
+         * 4x4 matrix is never inverted. The columns of the cofactor matrix are the cross products of the columns.
+         * The model-view matrix must be affine, like every model and view matrix.
          * @tparam ModelType The data type of the model-view matrix elements (e.g., float, double).
          * @tparam NormalMatType The data type of the normal matrix elements (e.g., float, double).
          * @param MVMat The model-view matrix.
@@ -674,20 +703,65 @@ namespace GLESC::Math {
         template <typename ModelType, typename NormalMatType>
         static void calculateNormalMatrix(const MatrixData<ModelType, 4, 4>& MVMat,
                                           MatrixData<NormalMatType, 3, 3>& normalMat) {
-            // Calculate the inverse of the 3x3 matrix
-            MatrixData<ModelType, 4, 4> inverseMat;
-            MatrixAlgorithms::inverse4x4(MVMat, inverseMat);
-
-            MatrixData<ModelType, 4, 4> transposedMVMat;
-            MatrixAlgorithms::transpose(inverseMat, transposedMVMat);
-
-            // Now extract the upper-left 3x3 part from the transposed matrix
-            MatrixData<ModelType, 3, 3> resizedMVMat;
-            MatrixAlgorithms::resizeMatrix(transposedMVMat, resizedMVMat);
+            ModelType cofactors[3][3];
+            MatrixAlgorithms::crossProductOfColumns(MVMat[1], MVMat[2], cofactors[0]);
+            MatrixAlgorithms::crossProductOfColumns(MVMat[2], MVMat[0], cofactors[1]);
+            MatrixAlgorithms::crossProductOfColumns(MVMat[0], MVMat[1], cofactors[2]);
+            const ModelType determinant =
+                MVMat[0][0] * cofactors[0][0] + MVMat[0][1] * cofactors[0][1] + MVMat[0][2] * cofactors[0][2];
+            D_ASSERT_FALSE(Math::eq(determinant, 0), "Matrix is not invertible.");
+            const ModelType inverseDeterminant = ModelType(1) / determinant;
+            for (size_t column = 0; column < 3; ++column) {
+                for (size_t row = 0; row < 3; ++row) {
+                    normalMat[column][row] = static_cast<NormalMatType>(cofactors[column][row] * inverseDeterminant);
+                }
+            }
+        }
 
+        /**
+         * @brief Calculates the normal matrix of a model-view matrix without non-uniform scale.
+         * @details If the upper 3x3 part is a rotation scaled by s in every axis, its inverse transpose is the same
+         * part divided by s^2, so there is nothing to invert. It gives the same result as calculateNormalMatrix,
+         * which is needed when the scale isn't uniform.
+         * @tparam ModelType The data type of the model-view matrix elements (e.g., float, double).
+         * @tparam NormalMatType The data type of the normal matrix elements (e.g., float, double).
+         * @param MVMat The model-view matrix, with the same scale in every axis.
+         * @param normalMat The result normal matrix.
+         */
+        template <typename ModelType, typename NormalMatType>
+        static void calculateNormalMatrixUniformScale(const MatrixData<ModelType, 4, 4>& MVMat,
+                                                      MatrixData<NormalMatType, 3, 3>& normalMat) {
+            const ModelType squaredScale =
+                MVMat[0][0] * MVMat[0][0] + MVMat[0][1] * MVMat[0][1] + MVMat[0][2] * MVMat[0][2];
+            D_ASSERT_FALSE(Math::eq(squaredScale, 0), "Matrix is not invertible.");
+            D_ASSERT_TRUE(MatrixAlgorithms::hasUniformScale(MVMat), "The scale of the matrix must be uniform.");
+            const ModelType inverseSquaredScale = ModelType(1) / squaredScale;
+            for (size_t column = 0; column < 3; ++column) {
+                for (size_t row = 0; row < 3; ++row) {
+                    normalMat[column][row] = static_cast<NormalMatType>(MVMat[column][row] * inverseSquaredScale);
+                }
+            }
+        }
 
-            // Assign the result to normalMat, no further transpose needed as we already transposed the whole matrix
-            normalMat = resizedMVMat;
+        /**
+         * @brief Checks if the upper 3x3 part of a matrix is a rotation scaled by the same value in every axis.
+         * @details Its columns are orthogonal and have the same length, compared relative to that length.
+         * @tparam Type The data type of the matrix elements (e.g., float, double).
+         * @param matrix The matrix.
+         * @return True if the scale of the matrix is uniform, false otherwise.
+         */
+        template <typename Type>
+        static bool hasUniformScale(const MatrixData<Type, 4, 4>& matrix) {
+            auto dot = [&matrix](size_t column1, size_t column2) {
+                return matrix[column1][0] * matrix[column2][0] + matrix[column1][1] * matrix[column2][1] +
+                    matrix[column1][2] * matrix[column2][2];
+            };
+            const Type squaredScale = dot(0, 0);
+            const Type tolerance = squaredScale * Type(1e-3);
+            return squaredScale > Type(0) &&
+                Math::abs(dot(1, 1) - squaredScale) <= tolerance && Math::abs(dot(2, 2) - squaredScale) <= tolerance &&
+                Math::abs(dot(0, 1)) <= tolerance && Math::abs(dot(0, 2)) <= tolerance &&
+                Math::abs(dot(1, 2)) <= tolerance;
         }
 
         /**
@@ -718,7 +792,7 @@ namespace GLESC::Math {
         inverse2x2(const MatrixData<Type, N, N>& matrix, MatrixData<Type, N, N>& result) {
             Type determinant;
             MatrixAlgorithms::determinant2x2(matrix, determinant);
-            D_ASSERT_TRUE(MatrixAlgorithms::isInvertible(matrix), "Matrix is not invertible.");
+            D_ASSERT_FALSE(Math::eq(determinant, 0), "Matrix is not invertible.");
             D_ASSERT_FALSE(&matrix == &result, "Cannot invert matrix in place.");
             result[0][0] = matrix[1][1] / determinant;
             result[0][1] = -matrix[0][1] / determinant;
@@ -742,7 +816,7 @@ namespace GLESC::Math {
         inverse3x3(const MatrixData<Type, N, N>& matrix, MatrixData<Type, N, N>& result) {
             Type determinant;
             MatrixAlgorithms::determinant3x3(matrix, determinant);
-            D_ASSERT_TRUE(MatrixAlgorithms::isInvertible(matrix), "Matrix is not invertible.");
+            D_ASSERT_FALSE(Math::eq(determinant, 0), "Matrix is not invertible.");
             D_ASSERT_FALSE(&matrix == &result, "Cannot invert matrix in place.");
             result[0][0] = (matrix[1][1] * matrix[2][2] - matrix[1][2] * matrix[2][1]) / determinant;
             result[0][1] = (matrix[0][2] * matrix[2][1] - matrix[0][1] * matrix[2][2]) / determinant;
@@ -757,7 +831,8 @@ namespace GLESC::Math {
 
         /**
          * @brief Calculates the inverse of a 4x4 matrix.
-         * @details The inverse matrix is calculated using the formula of the adjugate matrix.
+         * @details The inverse matrix is calculated using the formula of the adjugate matrix. The determinant is the
+         * dot product of the first row of the matrix and the first column of the adjugate, so it reuses its minors.
          * @cite https://en.wikipedia.org/wiki/Invertible_matrix#Inversion_of_4_%C3%97_4_matrices
          * @tparam N The size of the matrix.
          * @param matrix The matrix.
@@ -766,9 +841,6 @@ namespace GLESC::Math {
         template <typename Type, size_t N>
         static void
         inverse4x4(const MatrixData<Type, N, N>& matrix, MatrixData<Type, N, N>& result) {
-            Type determinant;
-            MatrixAlgorithms::determinant4x4(matrix, determinant);
-            D_ASSERT_TRUE(MatrixAlgorithms::isInvertible(matrix), "Matrix is not invertible.");
             D_ASSERT_FALSE(&matrix == &result, "Cannot invert matrix in place.");
             Type A2323 = matrix[2][2] * matrix[3][3] - matrix[2][3] * matrix[3][2];
             Type A1323 = matrix[2][1] * matrix[3][3] - matrix[2][3] * matrix[3][1];
@@ -789,24 +861,118 @@ namespace GLESC::Math {
             Type A0113 = matrix[1][0] * matrix[3][1] - matrix[1][1] * matrix[3][0];
             Type A0112 = matrix[1][0] * matrix[2][1] - matrix[1][1] * matrix[2][0];
 
-            Type invDet = 1.0 / determinant;
-
-            result[0][0] = invDet * (matrix[1][1] * A2323 - matrix[1][2] * A1323 + matrix[1][3] * A1223);
-            result[0][1] = invDet * -(matrix[0][1] * A2323 - matrix[0][2] * A1323 + matrix[0][3] * A1223);
-            result[0][2] = invDet * (matrix[0][1] * A2313 - matrix[0][2] * A1313 + matrix[0][3] * A1213);
-            result[0][3] = invDet * -(matrix[0][1] * A2312 - matrix[0][2] * A1312 + matrix[0][3] * A1212);
-            result[1][0] = invDet * -(matrix[1][0] * A2323 - matrix[1][2] * A0323 + matrix[1][3] * A0223);
-            result[1][1] = invDet * (matrix[0][0] * A2323 - matrix[0][2] * A0323 + matrix[0][3] * A0223);
-            result[1][2] = invDet * -(matrix[0][0] * A2313 - matrix[0][2] * A0313 + matrix[0][3] * A0213);
-            result[1][3] = invDet * (matrix[0][0] * A2312 - matrix[0][2] * A0312 + matrix[0][3] * A0212);
-            result[2][0] = invDet * (matrix[1][0] * A1323 - matrix[1][1] * A0323 + matrix[1][3] * A0123);
-            result[2][1] = invDet * -(matrix[0][0] * A1323 - matrix[0][1] * A0323 + matrix[0][3] * A0123);
-            result[2][2] = invDet * (matrix[0][0] * A1313 - matrix[0][1] * A0313 + matrix[0][3] * A0113);
-            result[2][3] = invDet * -(matrix[0][0] * A1312 - matrix[0][1] * A0312 + matrix[0][3] * A0112);
-            result[3][0] = invDet * -(matrix[1][0] * A1223 - matrix[1][1] * A0223 + matrix[1][2] * A0123);
-            result[3][1] = invDet * (matrix[0][0] * A1223 - matrix[0][1] * A0223 + matrix[0][2] * A0123);
-            result[3][2] = invDet * -(matrix[0][0] * A1213 - matrix[0][1] * A0213 + matrix[0][2] * A0113);
-            result[3][3] = invDet * (matrix[0][0] * A1212 - matrix[0][1] * A0212 + matrix[0][2] * A0112);
+            // Kept apart from the result, which would have to be loaded again to be divided by the determinant
+            Type adjugate[4][4];
+            adjugate[0][0] = matrix[1][1] * A2323 - matrix[1][2] * A1323 + matrix[1][3] * A1223;
+            adjugate[0][1] = -(matrix[0][1] * A2323 - matrix[0][2] * A1323 + matrix[0][3] * A1223);
+            adjugate[0][2] = matrix[0][1] * A2313 - matrix[0][2] * A1313 + matrix[0][3] * A1213;
+            adjugate[0][3] = -(matrix[0][1] * A2312 - matrix[0][2] * A1312 + matrix[0][3] * A1212);
+            adjugate[1][0] = -(matrix[1][0] * A2323 - matrix[1][2] * A0323 + matrix[1][3] * A0223);
+            adjugate[1][1] = matrix[0][0] * A2323 - matrix[0][2] * A0323 + matrix[0][3] * A0223;
+            adjugate[1][2] = -(matrix[0][0] * A2313 - matrix[0][2] * A0313 + matrix[0][3] * A0213);
+            adjugate[1][3] = matrix[0][0] * A2312 - matrix[0][2] * A0312 + matrix[0][3] * A0212;
+            adjugate[2][0] = matrix[1][0] * A1323 - matrix[1][1] * A0323 + matrix[1][3] * A0123;
+            adjugate[2][1] = -(matrix[0][0] * A1323 - matrix[0][1] * A0323 + matrix[0][3] * A0123);
+            adjugate[2][2] = matrix[0][0] * A1313 - matrix[0][1] * A0313 + matrix[0][3] * A0113;
+            adjugate[2][3] = -(matrix[0][0] * A1312 - matrix[0][1] * A0312 + matrix[0][3] * A0112);
+            adjugate[3][0] = -(matrix[1][0] * A1223 - matrix[1][1] * A0223 + matrix[1][2] * A0123);
+            adjugate[3][1] = matrix[0][0] * A1223 - matrix[0][1] * A0223 + matrix[0][2] * A0123;
+            adjugate[3][2] = -(matrix[0][0] * A1213 - matrix[0][1] * A0213 + matrix[0][2] * A0113);
+            adjugate[3][3] = matrix[0][0] * A1212 - matrix[0][1] * A0212 + matrix[0][2] * A0112;
+
+            const Type determinant = matrix[0][0] * adjugate[0][0] + matrix[0][1] * adjugate[1][0] +
+                matrix[0][2] * adjugate[2][0] + matrix[0][3] * adjugate[3][0];
+            D_ASSERT_FALSE(Math::eq(determinant, 0), "Matrix is not invertible.");
+            const Type invDet = Type(1) / determinant;
+            for (size_t column = 0; column < 4; ++column) {
+                for (size_t row = 0; row < 4; ++row) {
+                    result[column][row] = adjugate[column][row] * invDet;
+                }
+            }
+        }
+
+        /**
+         * @brief Calculates the inverse of an affine 4x4 matrix, like a model or a view matrix.
+         * @details The last row of an affine matrix is (0, 0, 0, 1), so its inverse is the inverse of the upper 3x3
+         * part, calculated with the cross products of its columns, and the translation transformed by it and
+         * negated. It's about half the operations of inverse4x4.
+         * @tparam Type The data type of the matrix elements (e.g., float, double).
+         * @param matrix The affine matrix.
+         * @param result The result matrix.
+         */
+        template <typename Type>
+        static void affineInverse(const MatrixData<Type, 4, 4>& matrix, MatrixData<Type, 4, 4>& result) {
+            D_ASSERT_FALSE(&matrix == &result, "Cannot invert matrix in place.");
+            D_ASSERT_TRUE(MatrixAlgorithms::isAffine(matrix), "The matrix must be affine.");
+            // Each row of the inverse of the 3x3 part is the cross product of the other two columns
+            Type inverseRows[3][3];
+            MatrixAlgorithms::crossProductOfColumns(matrix[1], matrix[2], inverseRows[0]);
+            MatrixAlgorithms::crossProductOfColumns(matrix[2], matrix[0], inverseRows[1]);
+            MatrixAlgorithms::crossProductOfColumns(matrix[0], matrix[1], inverseRows[2]);
+            const Type translation[3] = {matrix[3][0], matrix[3][1], matrix[3][2]};
+            const Type determinant =
+                matrix[0][0] * inverseRows[0][0] + matrix[0][1] * inverseRows[0][1] + matrix[0][2] * inverseRows[0][2];
+            D_ASSERT_FALSE(Math::eq(determinant, 0), "Matrix is not invertible.");
+            const Type invDet = Type(1) / determinant;
+            for (size_t row = 0; row < 3; ++row) {
+                const Type x = inverseRows[row][0] * invDet;
+                const Type y = inverseRows[row][1] * invDet;
+                const Type z = inverseRows[row][2] * invDet;
+                result[0][row] = x;
+                result[1][row] = y;
+                result[2][row] = z;
+                result[3][row] = -(x * translation[0] + y * translation[1] + z * translation[2]);
+            }
+            result[0][3] = Type(0);
+            result[1][3] = Type(0);
+            result[2][3] = Type(0);
+            result[3][3] = Type(1);
+        }
+
+        /**
+         * @brief Calculates the inverse of a rigid body transformation, a rotation and a translation.
+         * @details The inverse of a rotation is its transpose, so the inverse is the transposed rotation and the
+         * translation rotated by it and negated, without any division. It's the fastest way to get the view matrix
+         * of a camera from its transform.
+         * @tparam Type The data type of the matrix elements (e.g., float, double).
+         * @param matrix The matrix, the columns of its upper 3x3 part must be orthonormal and the last row
+         * (0, 0, 0, 1).
+         * @param result The result matrix.
+         */
+        template <typename Type>
+        static void rigidInverse(const MatrixData<Type, 4, 4>& matrix, MatrixData<Type, 4, 4>& result) {
+            D_ASSERT_FALSE(&matrix == &result, "Cannot invert matrix in place.");
+            D_ASSERT_TRUE(MatrixAlgorithms::isAffine(matrix), "The matrix must be affine.");
+            D_ASSERT_TRUE(MatrixAlgorithms::hasUniformScale(matrix) &&
+                          Math::abs(matrix[0][0] * matrix[0][0] + matrix[0][1] * matrix[0][1] +
+                              matrix[0][2] * matrix[0][2] - Type(1)) <= Type(1e-3),
+                          "The matrix must be a rotation and a translation.");
+            const Type translation[3] = {matrix[3][0], matrix[3][1], matrix[3][2]};
+            for (size_t row = 0; row < 3; ++row) {
+                const Type x = matrix[row][0];
+                const Type y = matrix[row][1];
+                const Type z = matrix[row][2];
+                result[0][row] = x;
+                result[1][row] = y;
+                result[2][row] = z;
+                result[3][row] = -(x * translation[0] + y * translation[1] + z * translation[2]);
+            }
+            result[0][3] = Type(0);
+            result[1][3] = Type(0);
+            result[2][3] = Type(0);
+            result[3][3] = Type(1);
+        }
+
+        /**
+         * @brief Checks if the last row of a 4x4 matrix is (0, 0, 0, 1), so it doesn't project.
+         * @tparam Type The data type of the matrix elements (e.g., float, double).
+         * @param matrix The matrix.
+         * @return True if the matrix is affine, false otherwise.
+         */
+        template <typename Type>
+        static bool isAffine(const MatrixData<Type, 4, 4>& matrix) {
+            return Math::eq(matrix[0][3], 0) && Math::eq(matrix[1][3], 0) && Math::eq(matrix[2][3], 0) &&
+                Math::eq(matrix[3][3], 1);
         }
 
 
@@ -824,12 +990,12 @@ namespace GLESC::Math {
          * @param result The result matrix.
          */
         template <typename Type>
-        static void perspective(float fovRad,
-                                float nearPlane,
-                                float farPlane,
-                                float viewWidth,
-                                float viewHeight,
-                                MatrixData<Type, 4, 4>& result) {
+        static constexpr void perspective(float fovRad,
+                                          float nearPlane,
+                                          float farPlane,
+                                          float viewWidth,
+                                          float viewHeight,
+                                          MatrixData<Type, 4, 4>& result) {
             S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic.");
 
 
@@ -856,7 +1022,7 @@ namespace GLESC::Math {
          * @param projection The result matrix.
          */
         template <typename Type>
-        static void
+        static constexpr void
         calculateProjectionMatrix(float fovDegrees,
                                   float nearPlane,
                                   float farPlane,
@@ -870,13 +1036,14 @@ namespace GLESC::Math {
 
         /**
          * @brief Calculates the inverse of any square matrix.
-         * @details The inverse matrix is calculated using the adjugate matrix.
+         * @details The matrices up to 4x4 are inverted with the formulas of their adjugate matrix, the bigger ones
+         * with the LU decomposition.
          * @tparam Type The data type of the matrix elements (e.g., float, double).
          * @tparam N The size of the matrix.
          * @param matrix The matrix.
          * @param result The result matrix.
          */
-        template <typename Type, size_t N, typename = std::enable_if_t<N == 2 || N == 3 || N == 4>>
+        template <typename Type, size_t N>
         static void
         matrixInverse(const MatrixData<Type, N, N>& matrix, MatrixData<Type, N, N>& result) {
             if constexpr (N == 2) {
@@ -889,14 +1056,15 @@ namespace GLESC::Math {
                 MatrixAlgorithms::inverse4x4(matrix, result);
             }
             else {
-                // TODO: Implement general inverse
-                //result = MatrixAlgorithms::gaussianElimination(matrix).inverse;
+                MatrixAlgorithms::luInverse(matrix, result);
             }
         }
 
         /**
          * @brief Checks if a matrix is invertible.
-         * @details A matrix is invertible if its determinant is not zero.
+         * @details A matrix is invertible if its determinant is not zero. The determinant of the floating point
+         * matrices bigger than 4x4 is calculated with the LU decomposition, the Laplace expansion grows with the
+         * factorial of the size.
          * @tparam Type The data type of the matrix elements (e.g., float, double).
          * @tparam N The size of the square matrix.
          * @param matrix The matrix.
@@ -904,8 +1072,127 @@ namespace GLESC::Math {
          */
         template <typename Type, size_t N>
         static bool isInvertible(const MatrixData<Type, N, N>& matrix) {
-            Type determinant = MatrixAlgorithms::laplaceExpansionDeterminant(matrix);
-            return !Math::eq(determinant, 0);
+            if constexpr (N > 4 && std::is_floating_point_v<Type>) {
+                return !Math::eq(MatrixAlgorithms::luDeterminant(matrix), 0);
+            }
+            else {
+                Type determinant = MatrixAlgorithms::laplaceExpansionDeterminant(matrix);
+                return !Math::eq(determinant, 0);
+            }
+        }
+
+        /**
+         * @brief Decomposes a square matrix into a lower and an upper triangular matrix, P * A = L * U.
+         * @details Doolittle's algorithm with partial pivoting, the row with the biggest value of each column is
+         * moved to the diagonal before eliminating the column from the rows below, which keeps it stable. It's
+         * O(N^3) and the decomposition can be reused for the inverse and the determinant.
+         * The first index of the data is taken as the row, like the rest of the general algorithms. It doesn't matter
+         * for the inverse and the determinant, the inverse of the transpose is the transpose of the inverse.
+         * @tparam Type The data type of the matrix elements, a floating point type.
+         * @tparam N The size of the square matrix.
+         * @param matrix The matrix.
+         * @param lu L below the diagonal, without its diagonal of ones, and U from the diagonal up.
+         * @param permutation The row of the matrix that ended in each row of the decomposition.
+         * @param sign The sign of the permutation, -1 if the number of row swaps is odd, 1 otherwise.
+         * @return False if the matrix is singular, then the decomposition is incomplete.
+         */
+        template <typename Type, size_t N>
+        static bool luDecomposition(const MatrixData<Type, N, N>& matrix,
+                                    MatrixData<Type, N, N>& lu,
+                                    std::array<size_t, N>& permutation,
+                                    Type& sign) {
+            S_ASSERT_TRUE(std::is_floating_point_v<Type>, "The LU decomposition needs a floating point type.");
+            lu = matrix;
+            sign = Type(1);
+            for (size_t row = 0; row < N; ++row) {
+                permutation[row] = row;
+            }
+            for (size_t pivot = 0; pivot < N; ++pivot) {
+                size_t maxRow = pivot;
+                Type maxValue = Math::abs(lu[pivot][pivot]);
+                for (size_t row = pivot + 1; row < N; ++row) {
+                    if (Math::abs(lu[row][pivot]) > maxValue) {
+                        maxValue = Math::abs(lu[row][pivot]);
+                        maxRow = row;
+                    }
+                }
+                if (maxValue == Type(0)) {
+                    return false;
+                }
+                if (maxRow != pivot) {
+                    std::swap(lu[pivot], lu[maxRow]);
+                    std::swap(permutation[pivot], permutation[maxRow]);
+                    sign = -sign;
+                }
+                for (size_t row = pivot + 1; row < N; ++row) {
+                    lu[row][pivot] /= lu[pivot][pivot];
+                    const Type factor = lu[row][pivot];
+                    for (size_t column = pivot + 1; column < N; ++column) {
+                        lu[row][column] -= factor * lu[pivot][column];
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Calculates the inverse of any square matrix with the LU decomposition.
+         * @details Each column of the inverse is the solution of A * x = e, the column of the identity, solved by
+         * forward substitution with L and backward substitution with U.
+         * @tparam Type The data type of the matrix elements, a floating point type.
+         * @tparam N The size of the square matrix.
+         * @param matrix The matrix.
+         * @param result The result matrix.
+         */
+        template <typename Type, size_t N>
+        static void luInverse(const MatrixData<Type, N, N>& matrix, MatrixData<Type, N, N>& result) {
+            D_ASSERT_FALSE(&matrix == &result, "Cannot invert matrix in place.");
+            MatrixData<Type, N, N> lu;
+            std::array<size_t, N> permutation;
+            Type sign;
+            [[maybe_unused]] const bool invertible = MatrixAlgorithms::luDecomposition(matrix, lu, permutation, sign);
+            D_ASSERT_TRUE(invertible, "Matrix is not invertible.");
+            for (size_t column = 0; column < N; ++column) {
+                std::array<Type, N> solution;
+                for (size_t row = 0; row < N; ++row) {
+                    solution[row] = permutation[row] == column ? Type(1) : Type(0);
+                    for (size_t k = 0; k < row; ++k) {
+                        solution[row] -= lu[row][k] * solution[k];
+                    }
+                }
+                for (size_t row = N; row-- > 0;) {
+                    for (size_t k = row + 1; k < N; ++k) {
+                        solution[row] -= lu[row][k] * solution[k];
+                    }
+                    solution[row] /= lu[row][row];
+                }
+                for (size_t row = 0; row < N; ++row) {
+                    result[row][column] = solution[row];
+                }
+            }
+        }
+
+        /**
+         * @brief Calculates the determinant of any square matrix with the LU decomposition.
+         * @details It's the product of the diagonal of U with the sign of the permutation, O(N^3) instead of the
+         * O(N!) of the Laplace expansion.
+         * @tparam Type The data type of the matrix elements, a floating point type.
+         * @tparam N The size of the square matrix.
+         * @param matrix The matrix.
+         * @return The determinant of the matrix.
+         */
+        template <typename Type, size_t N>
+        static Type luDeterminant(const MatrixData<Type, N, N>& matrix) {
+            MatrixData<Type, N, N> lu;
+            std::array<size_t, N> permutation;
+            Type determinant;
+            if (!MatrixAlgorithms::luDecomposition(matrix, lu, permutation, determinant)) {
+                return Type(0);
+            }
+            for (size_t i = 0; i < N; ++i) {
+                determinant *= lu[i][i];
+            }
+            return determinant;
         }
 
 
@@ -1093,6 +1380,18 @@ namespace GLESC::Math {
         }
 
     private:
+        /**
+         * @brief The cross product of the first three elements of two columns of a matrix.
+         */
+        template <typename Type, size_t M>
+        static void crossProductOfColumns(const MatrixRow<Type, M>& column1,
+                                          const MatrixRow<Type, M>& column2,
+                                          Type (&result)[3]) {
+            result[0] = column1[1] * column2[2] - column1[2] * column2[1];
+            result[1] = column1[2] * column2[0] - column1[0] * column2[2];
+            result[2] = column1[0] * column2[1] - column1[1] * column2[0];
+        }
+
         /**
          * @brief Struct that holds the result of Gaussian elimination with tracking.
          */
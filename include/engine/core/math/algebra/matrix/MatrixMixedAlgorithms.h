@@ -166,7 +166,7 @@ namespace GLESC::Math {
         static void getRotate3DMatrix(const VectorData<TypeDgrs, 3>& rads,
                                       MatrixData<TypeRes, 4, 4>& result) {
             MatrixAlgorithms::setMatrixZero(result);
-            MatrixAlgorithms::setMatrixDiagonal(result, 1.0f);
+            MatrixAlgorithms::setMatrixDiagonal(result, TypeRes(1));
 
             MatrixData<TypeRes, 4, 4> rotX;
             VectorData<TypeDgrs, 3> rotXAxis = {1, 0, 0};
@@ -227,33 +227,92 @@ namespace GLESC::Math {
             MatrixAlgorithms::matrixMatrixMulInPlace(model, scaleMatrix, model);
         }
 
+        /**
+         * @brief Calculate the 3D rotation matrix of a unit quaternion.
+         * @details Unlike the Euler angles, the quaternion is turned into a matrix with products only.
+         * @tparam TypeQuat The data type of the quaternion components (e.g., float, double).
+         * @tparam TypeRes The data type of the result matrix elements (e.g., float, double).
+         * @param quaternion The components of the quaternion, in x, y, z, w order.
+         * @param result A 4x4 matrix which will contain the result of the rotation.
+         */
+        template <typename TypeQuat, typename TypeRes>
+        static void getRotate3DMatrixFromQuaternion(const VectorData<TypeQuat, 4>& quaternion,
+                                                    MatrixData<TypeRes, 4, 4>& result) {
+            const VectorData<TypeRes, 3> position = {0, 0, 0};
+            const VectorData<TypeRes, 3> scale = {1, 1, 1};
+            MatrixMixedAlgorithms::calculateModelMatrixFromQuaternion(position, quaternion, scale, result);
+        }
+
+        /**
+         * @brief Calculate the model matrix from the position, the rotation as a quaternion, and the scale.
+         * @details It gives the same matrix as calculateModelMatrix, translation * rotation * scale, but it writes
+         * the elements directly instead of building and multiplying the three matrices. Each column of the rotation
+         * is multiplied by its scale and the translation is the last column.
+         *
+         * @tparam ModelType The data type of the matrix elements (e.g., float, double).
+         * @tparam TypePos The data type of the position vector elements (e.g., float, double).
+         * @tparam TypeQuat The data type of the quaternion components (e.g., float, double).
+         * @tparam TypeScale The data type of the scale vector elements (e.g., float, double).
+         * @param position A 3D vector containing the position of the model.
+         * @param quaternion The components of the unit quaternion of the rotation, in x, y, z, w order.
+         * @param scale A 3D vector containing the scale factors for the model.
+         * @param model A 4x4 matrix which will contain the result of the model matrix.
+         */
+        template <typename ModelType, typename TypePos, typename TypeQuat, typename TypeScale>
+        static void calculateModelMatrixFromQuaternion(const VectorData<TypePos, 3>& position,
+                                                       const VectorData<TypeQuat, 4>& quaternion,
+                                                       const VectorData<TypeScale, 3>& scale,
+                                                       MatrixData<ModelType, 4, 4>& model) {
+            const ModelType x = static_cast<ModelType>(quaternion[0]);
+            const ModelType y = static_cast<ModelType>(quaternion[1]);
+            const ModelType z = static_cast<ModelType>(quaternion[2]);
+            const ModelType w = static_cast<ModelType>(quaternion[3]);
+            const ModelType xx = x * x, yy = y * y, zz = z * z;
+            const ModelType xy = x * y, xz = x * z, yz = y * z;
+            const ModelType wx = w * x, wy = w * y, wz = w * z;
+            const ModelType sx = static_cast<ModelType>(scale[0]);
+            const ModelType sy = static_cast<ModelType>(scale[1]);
+            const ModelType sz = static_cast<ModelType>(scale[2]);
+
+            // Same layout as getRotate3DMatrixForAxis, the first index is the column
+            model[0][0] = (ModelType(1) - ModelType(2) * (yy + zz)) * sx;
+            model[0][1] = ModelType(2) * (xy + wz) * sx;
+            model[0][2] = ModelType(2) * (xz - wy) * sx;
+            model[0][3] = 0;
+
+            model[1][0] = ModelType(2) * (xy - wz) * sy;
+            model[1][1] = (ModelType(1) - ModelType(2) * (xx + zz)) * sy;
+            model[1][2] = ModelType(2) * (yz + wx) * sy;
+            model[1][3] = 0;
+
+            model[2][0] = ModelType(2) * (xz + wy) * sz;
+            model[2][1] = ModelType(2) * (yz - wx) * sz;
+            model[2][2] = (ModelType(1) - ModelType(2) * (xx + yy)) * sz;
+            model[2][3] = 0;
+
+            model[3][0] = static_cast<ModelType>(position[0]);
+            model[3][1] = static_cast<ModelType>(position[1]);
+            model[3][2] = static_cast<ModelType>(position[2]);
+            model[3][3] = 1;
+        }
+
+        /**
+         * @brief Calculates the view matrix of a camera from its position and rotation.
+         * @details The view matrix is the inverse of the transform of the camera, the rotation by the negated angles
+         * followed by the translation by the negated position. Both are a rigid transformation, so the translation
+         * is the negated position rotated, and the only products are the ones of the rotations of each axis.
+         * @param position The position of the camera.
+         * @param rotationRads The rotation of the camera in radians.
+         * @param viewMat The result view matrix.
+         */
         template <typename TypePos, typename TypeRot, typename TypeRes>
         static void calculateViewMatrixPosRot(const VectorData<TypePos, 3>& position,
                                               const VectorData<TypeRot, 3>& rotationRads,
                                               MatrixData<TypeRes, 4, 4>& viewMat) {
-            // Negate position for translation
-            VectorData<TypePos, 3> negatedPos;
-            VectorAlgorithms::vectorNegate(position, negatedPos);
-
             VectorData<TypeRes, 3> negatedRotationRads;
             VectorAlgorithms::vectorNegate(rotationRads, negatedRotationRads);
 
-            VectorData<TypeRes, 3> scale = {1, 1, 1};
-
-            // Initialize matrices
-            MatrixAlgorithms::setMatrixZero(viewMat);
-            MatrixAlgorithms::setMatrixDiagonal(viewMat, TypePos(1));
-
-            MatrixData<TypePos, 4, 4> scaleMatrix;
-            MatrixData<TypePos, 4, 4> rotationMatrix;
-            MatrixData<TypePos, 4, 4> translationMatrix;
-            // First, create the scale matrix
-            MatrixAlgorithms::getScaleMatrix(scale, scaleMatrix);
             // Create rotation matrices around X, Y, and Z axes
-
-            MatrixAlgorithms::setMatrixZero(rotationMatrix);
-            MatrixAlgorithms::setMatrixDiagonal(rotationMatrix, TypePos(1));
-
             MatrixData<TypeRes, 4, 4> rotX;
             VectorData<TypeRot, 3> rotXAxis = {1, 0, 0};
             MatrixMixedAlgorithms::getRotate3DMatrixForAxis(negatedRotationRads[0], rotXAxis, rotX);
@@ -264,15 +323,16 @@ namespace GLESC::Math {
             VectorData<TypeRot, 3> rotZAxis = {0, 0, 1};
             MatrixMixedAlgorithms::getRotate3DMatrixForAxis(negatedRotationRads[2], rotZAxis, rotZ);
 
-            MatrixAlgorithms::matrixMatrixMulInPlace(rotationMatrix, rotZ, rotationMatrix);
-            MatrixAlgorithms::matrixMatrixMulInPlace(rotationMatrix, rotX, rotationMatrix);
-            MatrixAlgorithms::matrixMatrixMulInPlace(rotationMatrix, rotY, rotationMatrix);
-            // Create the translation matrix
-            MatrixAlgorithms::getTranslationMatrix(negatedPos, translationMatrix);
+            MatrixData<TypeRes, 4, 4> rotZX;
+            MatrixAlgorithms::matrixMatrixMulFastColMaj(rotZ, rotX, rotZX);
+            MatrixAlgorithms::matrixMatrixMulFastColMaj(rotZX, rotY, viewMat);
 
-            MatrixAlgorithms::matrixMatrixMulInPlace(viewMat, scaleMatrix, viewMat);
-            MatrixAlgorithms::matrixMatrixMulInPlace(viewMat, rotationMatrix, viewMat);
-            MatrixAlgorithms::matrixMatrixMulInPlace(viewMat, translationMatrix, viewMat);
+            // The translation by the negated position, rotated
+            for (size_t row = 0; row < 3; ++row) {
+                viewMat[3][row] = -(viewMat[0][row] * static_cast<TypeRes>(position[0]) +
+                    viewMat[1][row] * static_cast<TypeRes>(position[1]) +
+                    viewMat[2][row] * static_cast<TypeRes>(position[2]));
+            }
         }
 
 
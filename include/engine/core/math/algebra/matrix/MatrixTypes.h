@@ -10,6 +10,8 @@
 #pragma once
 
 #include <array>
+#include <type_traits>
+#include "engine/Config.h"
 
 namespace GLESC::Math {
     /**
@@ -27,5 +29,16 @@ namespace GLESC::Math {
      */
     template<typename Type, std::size_t N, std::size_t M>
     using MatrixData = std::array<MatrixRow<Type, M>, N>;
-    
+
+    /**
+     * @brief The alignment of the matrices.
+     * @details The 4x4 float matrices are aligned to 16 bytes with GLESC_MATH_SIMD, so their columns never cross a
+     * cache line. The matrices are never inside the packed structures uploaded to the GPU, they are uploaded
+     * through pointers to their data.
+     */
+    template<typename Type, std::size_t N, std::size_t M>
+    constexpr std::size_t matrixAlignment = GLESC_MATH_SIMD && std::is_same_v<Type, float> && N == 4 && M == 4
+                                                ? 16
+                                                : alignof(MatrixData<Type, N, M>);
+
 }
\ No newline at end of file
@@ -0,0 +1,222 @@
+/**************************************************************************************************
+ * @file   Quaternion.h
+ * @author Valentin Dumitru
+ * @date   2024-06-23
+ * @brief  Unit quaternions to represent and interpolate 3D rotations.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cmath>
+#include <string>
+
+#include "engine/core/math/Math.h"
+#include "engine/core/math/algebra/vector/Vector.h"
+
+namespace GLESC::Math {
+    /**
+     * @brief A rotation in 3D space, stored as a unit quaternion.
+     * @details Unlike the Euler angles, a quaternion has no gimbal lock, composes with a product and can be
+     * interpolated on the shortest arc between two rotations. Turning it into a rotation matrix only takes products,
+     * so it doesn't need the sines and cosines the Euler angles need every time the matrix is built.
+     *
+     * The components are stored as x, y, z (the vector part) and w (the scalar part), the same order GLSL and most
+     * libraries use. The Euler conversions use the same order as the rotation matrices of the engine, the rotation
+     * around X is applied first, then the one around Y and then the one around Z.
+     * @tparam Type The type of the components
+     */
+    template <typename Type>
+    class Quaternion {
+    public:
+        using ValueType = Type;
+
+        /**
+         * @brief Creates the identity, the quaternion that doesn't rotate.
+         */
+        constexpr Quaternion() noexcept : data{Type(0), Type(0), Type(0), Type(1)} {
+        }
+
+        constexpr Quaternion(Type x, Type y, Type z, Type w) noexcept : data{x, y, z, w} {
+        }
+
+        /**
+         * @brief Creates the rotation of the given angle around the given axis.
+         * @param axis The axis of the rotation, it's normalized.
+         * @param rads The angle of the rotation, in radians.
+         */
+        [[nodiscard]] static Quaternion fromAxisAngle(const Vector<Type, 3>& axis, Type rads) {
+            const Vector<Type, 3> unitAxis = axis.normalize();
+            const Type halfSin = Math::sin(rads * Type(0.5));
+            return {unitAxis.getX() * halfSin, unitAxis.getY() * halfSin, unitAxis.getZ() * halfSin,
+                    Math::cos(rads * Type(0.5))};
+        }
+
+        /**
+         * @brief Creates the rotation of the given Euler angles.
+         * @details It's the same rotation the Euler rotation matrix of the engine applies, first around X, then
+         * around Y and then around Z.
+         * @param rads The rotation around the X, Y and Z axes, in radians.
+         */
+        [[nodiscard]] static Quaternion fromEuler(const Vector<Type, 3>& rads) {
+            const Type cx = Math::cos(rads.getX() * Type(0.5));
+            const Type sx = Math::sin(rads.getX() * Type(0.5));
+            const Type cy = Math::cos(rads.getY() * Type(0.5));
+            const Type sy = Math::sin(rads.getY() * Type(0.5));
+            const Type cz = Math::cos(rads.getZ() * Type(0.5));
+            const Type sz = Math::sin(rads.getZ() * Type(0.5));
+            // Product of the rotations around Z, Y and X, in that order
+            return {
+                sx * cy * cz - cx * sy * sz,
+                cx * sy * cz + sx * cy * sz,
+                cx * cy * sz - sx * sy * cz,
+                cx * cy * cz + sx * sy * sz
+            };
+        }
+
+        /**
+         * @brief Converts the rotation back to Euler angles.
+         * @details The rotation around Y is in [-pi/2, pi/2] and the others in [-pi, pi], so the angles can be
+         * different from the ones the quaternion was created with, even if they give the same rotation.
+         * @return The rotation around the X, Y and Z axes, in radians.
+         */
+        [[nodiscard]] Vector<Type, 3> toEuler() const {
+            const Type x = getX(), y = getY(), z = getZ(), w = getW();
+            const Type sinY = Math::clamp(Type(2) * (w * y - z * x), Type(-1), Type(1));
+            return {
+                static_cast<Type>(std::atan2(Type(2) * (w * x + y * z), Type(1) - Type(2) * (x * x + y * y))),
+                static_cast<Type>(std::asin(sinY)),
+                static_cast<Type>(std::atan2(Type(2) * (w * z + x * y), Type(1) - Type(2) * (y * y + z * z)))
+            };
+        }
+
+        [[nodiscard]] Type getX() const { return data[0]; }
+        [[nodiscard]] Type getY() const { return data[1]; }
+        [[nodiscard]] Type getZ() const { return data[2]; }
+        [[nodiscard]] Type getW() const { return data[3]; }
+        /**
+         * @brief The components in x, y, z, w order.
+         */
+        [[nodiscard]] const VectorData<Type, 4>& getData() const { return data; }
+
+        [[nodiscard]] Type dot(const Quaternion& other) const {
+            return VectorAlgorithms::dotProduct(data, other.data);
+        }
+
+        [[nodiscard]] Type length() const {
+            return Math::sqrt(dot(*this));
+        }
+
+        /**
+         * @brief Returns the quaternion with a length of 1.
+         * @details The products of unit quaternions slowly drift from a length of 1 with the rounding, normalizing
+         * them keeps them rotations.
+         */
+        [[nodiscard]] Quaternion normalize() const {
+            const Type quaternionLength = length();
+            if (Math::eq(quaternionLength, Type(0))) return {};
+            const Type inverseLength = Type(1) / quaternionLength;
+            return {getX() * inverseLength, getY() * inverseLength, getZ() * inverseLength, getW() * inverseLength};
+        }
+
+        /**
+         * @brief Returns the inverse rotation, for unit quaternions.
+         */
+        [[nodiscard]] Quaternion conjugate() const {
+            return {-getX(), -getY(), -getZ(), getW()};
+        }
+
+        /**
+         * @brief Composes two rotations, the result applies the other rotation first and then this one.
+         */
+        [[nodiscard]] Quaternion operator*(const Quaternion& other) const {
+            const Type x = getX(), y = getY(), z = getZ(), w = getW();
+            const Type ox = other.getX(), oy = other.getY(), oz = other.getZ(), ow = other.getW();
+            return {
+                w * ox + x * ow + y * oz - z * oy,
+                w * oy - x * oz + y * ow + z * ox,
+                w * oz + x * oy - y * ox + z * ow,
+                w * ow - x * ox - y * oy - z * oz
+            };
+        }
+
+        /**
+         * @brief Rotates a vector by this rotation.
+         * @details Uses the expanded form of q * v * q^-1, which doesn't need to build the matrix.
+         */
+        [[nodiscard]] Vector<Type, 3> rotate(const Vector<Type, 3>& vector) const {
+            const Vector<Type, 3> axis(getX(), getY(), getZ());
+            const Vector<Type, 3> twiceCross = axis.cross(vector) * Type(2);
+            return vector + twiceCross * getW() + axis.cross(twiceCross);
+        }
+
+        /**
+         * @brief Normalized linear interpolation between this rotation and the other.
+         * @details It takes the shortest arc, but the angular speed isn't constant, it's faster in the middle. The
+         * difference is negligible for the small steps between two updates and it doesn't need any trigonometry.
+         * @param other The rotation at a factor of 1.
+         * @param factor The interpolation factor, between 0 and 1.
+         */
+        [[nodiscard]] Quaternion nlerp(const Quaternion& other, Type factor) const {
+            // q and -q are the same rotation, the one closest to this one is the shortest arc
+            const Type sign = dot(other) < Type(0) ? Type(-1) : Type(1);
+            return Quaternion(Math::lerp(getX(), other.getX() * sign, factor),
+                              Math::lerp(getY(), other.getY() * sign, factor),
+                              Math::lerp(getZ(), other.getZ() * sign, factor),
+                              Math::lerp(getW(), other.getW() * sign, factor)).normalize();
+        }
+
+        /**
+         * @brief Spherical linear interpolation between this rotation and the other.
+         * @details It takes the shortest arc with a constant angular speed. When the rotations are almost the same
+         * the angle can't be divided precisely, and it falls back to nlerp, which gives the same result there.
+         * @param other The rotation at a factor of 1.
+         * @param factor The interpolation factor, between 0 and 1.
+         */
+        [[nodiscard]] Quaternion slerp(const Quaternion& other, Type factor) const {
+            Type cosAngle = dot(other);
+            Type sign = Type(1);
+            if (cosAngle < Type(0)) {
+                cosAngle = -cosAngle;
+                sign = Type(-1);
+            }
+            if (cosAngle > slerpThreshold) return nlerp(other, factor);
+
+            const Type angle = static_cast<Type>(std::acos(cosAngle));
+            const Type inverseSin = Type(1) / Math::sin(angle);
+            const Type thisWeight = Math::sin((Type(1) - factor) * angle) * inverseSin;
+            const Type otherWeight = Math::sin(factor * angle) * inverseSin * sign;
+            return {
+                getX() * thisWeight + other.getX() * otherWeight,
+                getY() * thisWeight + other.getY() * otherWeight,
+                getZ() * thisWeight + other.getZ() * otherWeight,
+                getW() * thisWeight + other.getW() * otherWeight
+            };
+        }
+
+        [[nodiscard]] bool operator==(const Quaternion& other) const {
+            return data == other.data;
+        }
+
+        [[nodiscard]] bool operator!=(const Quaternion& other) const {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] std::string toString() const {
+            return "[" + std::to_string(getX()) + ", " + std::to_string(getY()) + ", " + std::to_string(getZ()) +
+                ", " + std::to_string(getW()) + "]";
+        }
+
+    private:
+        /**
+         * @brief Cosine of the angle between the rotations above which slerp uses nlerp.
+         */
+        static constexpr Type slerpThreshold = Type(0.9995);
+
+        VectorData<Type, 4> data;
+    }; // class Quaternion
+} // namespace GLESC::Math
+
+using QuatF = GLESC::Math::Quaternion<float>;
+using QuatD = GLESC::Math::Quaternion<double>;
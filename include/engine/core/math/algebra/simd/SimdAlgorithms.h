@@ -0,0 +1,209 @@
+/**************************************************************************************************
+ * @file   SimdAlgorithms.h
+ * @author Valentin Dumitru
+ * @date   2024-06-26
+ * @brief  SIMD implementations of the hot operations of the vectors of 4 floats and the 4x4 float matrices.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include "engine/Config.h"
+
+#if GLESC_MATH_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define GLESC_MATH_SSE
+#elif GLESC_MATH_SIMD && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GLESC_MATH_NEON
+#endif
+
+namespace GLESC::Math {
+    /**
+     * @brief The operations of 4 floats at a time used by the vectors and matrices of 4 floats.
+     * @details SSE on x86-64 and NEON on 64 bit ARM, which are always available in those architectures so there is
+     * no detection at runtime. Elsewhere, or with GLESC_MATH_SIMD set to false, the same operations are done one
+     * float at a time.
+     * The loads and stores are unaligned, the data doesn't need any alignment, so it works with the packed vectors
+     * too. The matrices are stored by columns, like MatrixAlgorithms::columnMajorMatrix.
+     */
+    class SimdAlgorithms {
+    public:
+#if defined(GLESC_MATH_SSE) || defined(GLESC_MATH_NEON)
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;
+#endif
+
+        /**
+         * @brief True if the vector has a SIMD implementation, the vectors of 4 floats.
+         */
+        template <typename Type, size_t N>
+        static constexpr bool isFloat4 = std::is_same_v<Type, float> && N == 4;
+        /**
+         * @brief True if the matrix has a SIMD implementation, the 4x4 float matrices.
+         */
+        template <typename Type, size_t N, size_t M>
+        static constexpr bool isMat4 = std::is_same_v<Type, float> && N == 4 && M == 4;
+        /**
+         * @brief True if the product of a NxM matrix by a XxN matrix, in the layout of the matrices, has a SIMD
+         * implementation, the product of two 4x4 float matrices.
+         */
+        template <typename Type, size_t N, size_t M, size_t X>
+        static constexpr bool isMat4Mul = isMat4<Type, N, M> && X == 4;
+
+        /**
+         * @brief Multiplies two 4x4 matrices, result = left * right.
+         * @details Each column of the result is the sum of the columns of the left matrix weighted by the elements of
+         * the column of the right matrix, so the four rows are computed at once. The result can be one of the
+         * operands.
+         * @param left The 16 floats of the left matrix.
+         * @param right The 16 floats of the right matrix.
+         * @param result The 16 floats of the result.
+         */
+        static void mat4Mul(const float* left, const float* right, float* result) {
+#ifdef GLESC_MATH_SSE
+            const __m128 column0 = _mm_loadu_ps(left);
+            const __m128 column1 = _mm_loadu_ps(left + 4);
+            const __m128 column2 = _mm_loadu_ps(left + 8);
+            const __m128 column3 = _mm_loadu_ps(left + 12);
+            __m128 resultColumns[4];
+            for (size_t column = 0; column < 4; ++column) {
+                const float* weights = right + column * 4;
+                resultColumns[column] = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(weights[0])),
+                               _mm_mul_ps(column1, _mm_set1_ps(weights[1]))),
+                    _mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(weights[2])),
+                               _mm_mul_ps(column3, _mm_set1_ps(weights[3]))));
+            }
+            // Stored after every column is computed, so the result can alias the right matrix
+            for (size_t column = 0; column < 4; ++column) {
+                _mm_storeu_ps(result + column * 4, resultColumns[column]);
+            }
+#elif defined(GLESC_MATH_NEON)
+            const float32x4_t column0 = vld1q_f32(left);
+            const float32x4_t column1 = vld1q_f32(left + 4);
+            const float32x4_t column2 = vld1q_f32(left + 8);
+            const float32x4_t column3 = vld1q_f32(left + 12);
+            float32x4_t resultColumns[4];
+            for (size_t column = 0; column < 4; ++column) {
+                const float* weights = right + column * 4;
+                float32x4_t sum = vmulq_n_f32(column0, weights[0]);
+                sum = vmlaq_n_f32(sum, column1, weights[1]);
+                sum = vmlaq_n_f32(sum, column2, weights[2]);
+                resultColumns[column] = vmlaq_n_f32(sum, column3, weights[3]);
+            }
+            for (size_t column = 0; column < 4; ++column) {
+                vst1q_f32(result + column * 4, resultColumns[column]);
+            }
+#else
+            float resultData[16];
+            for (size_t column = 0; column < 4; ++column) {
+                for (size_t row = 0; row < 4; ++row) {
+                    resultData[column * 4 + row] = left[row] * right[column * 4] +
+                        left[4 + row] * right[column * 4 + 1] + left[8 + row] * right[column * 4 + 2] +
+                        left[12 + row] * right[column * 4 + 3];
+                }
+            }
+            for (size_t i = 0; i < 16; ++i) result[i] = resultData[i];
+#endif
+        }
+
+        /**
+         * @brief Multiplies a 4x4 matrix by a vector of 4 floats, result = matrix * vector.
+         * @details The result can be the vector.
+         */
+        static void mat4VecMul(const float* matrix, const float* vector, float* result) {
+#ifdef GLESC_MATH_SSE
+            const __m128 sum = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(matrix), _mm_set1_ps(vector[0])),
+                           _mm_mul_ps(_mm_loadu_ps(matrix + 4), _mm_set1_ps(vector[1]))),
+                _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(matrix + 8), _mm_set1_ps(vector[2])),
+                           _mm_mul_ps(_mm_loadu_ps(matrix + 12), _mm_set1_ps(vector[3]))));
+            _mm_storeu_ps(result, sum);
+#elif defined(GLESC_MATH_NEON)
+            float32x4_t sum = vmulq_n_f32(vld1q_f32(matrix), vector[0]);
+            sum = vmlaq_n_f32(sum, vld1q_f32(matrix + 4), vector[1]);
+            sum = vmlaq_n_f32(sum, vld1q_f32(matrix + 8), vector[2]);
+            vst1q_f32(result, vmlaq_n_f32(sum, vld1q_f32(matrix + 12), vector[3]));
+#else
+            float resultData[4];
+            for (size_t row = 0; row < 4; ++row) {
+                resultData[row] = matrix[row] * vector[0] + matrix[4 + row] * vector[1] +
+                    matrix[8 + row] * vector[2] + matrix[12 + row] * vector[3];
+            }
+            for (size_t row = 0; row < 4; ++row) result[row] = resultData[row];
+#endif
+        }
+
+        static void vec4Add(const float* left, const float* right, float* result) {
+#ifdef GLESC_MATH_SSE
+            _mm_storeu_ps(result, _mm_add_ps(_mm_loadu_ps(left), _mm_loadu_ps(right)));
+#elif defined(GLESC_MATH_NEON)
+            vst1q_f32(result, vaddq_f32(vld1q_f32(left), vld1q_f32(right)));
+#else
+            for (size_t i = 0; i < 4; ++i) result[i] = left[i] + right[i];
+#endif
+        }
+
+        static void vec4Sub(const float* left, const float* right, float* result) {
+#ifdef GLESC_MATH_SSE
+            _mm_storeu_ps(result, _mm_sub_ps(_mm_loadu_ps(left), _mm_loadu_ps(right)));
+#elif defined(GLESC_MATH_NEON)
+            vst1q_f32(result, vsubq_f32(vld1q_f32(left), vld1q_f32(right)));
+#else
+            for (size_t i = 0; i < 4; ++i) result[i] = left[i] - right[i];
+#endif
+        }
+
+        static void vec4Mul(const float* left, const float* right, float* result) {
+#ifdef GLESC_MATH_SSE
+            _mm_storeu_ps(result, _mm_mul_ps(_mm_loadu_ps(left), _mm_loadu_ps(right)));
+#elif defined(GLESC_MATH_NEON)
+            vst1q_f32(result, vmulq_f32(vld1q_f32(left), vld1q_f32(right)));
+#else
+            for (size_t i = 0; i < 4; ++i) result[i] = left[i] * right[i];
+#endif
+        }
+
+        static void vec4Div(const float* dividend, const float* divisor, float* result) {
+#ifdef GLESC_MATH_SSE
+            _mm_storeu_ps(result, _mm_div_ps(_mm_loadu_ps(dividend), _mm_loadu_ps(divisor)));
+#elif defined(GLESC_MATH_NEON)
+            vst1q_f32(result, vdivq_f32(vld1q_f32(dividend), vld1q_f32(divisor)));
+#else
+            for (size_t i = 0; i < 4; ++i) result[i] = dividend[i] / divisor[i];
+#endif
+        }
+
+        static void vec4ScalarMul(const float* vector, float scalar, float* result) {
+#ifdef GLESC_MATH_SSE
+            _mm_storeu_ps(result, _mm_mul_ps(_mm_loadu_ps(vector), _mm_set1_ps(scalar)));
+#elif defined(GLESC_MATH_NEON)
+            vst1q_f32(result, vmulq_n_f32(vld1q_f32(vector), scalar));
+#else
+            for (size_t i = 0; i < 4; ++i) result[i] = vector[i] * scalar;
+#endif
+        }
+
+        /**
+         * @brief The dot product of two vectors of 4 floats.
+         * @details The products are added in pairs, (x + z) + (y + w), so the last bits can differ from adding them
+         * in order.
+         */
+        static float vec4Dot(const float* left, const float* right) {
+#ifdef GLESC_MATH_SSE
+            const __m128 products = _mm_mul_ps(_mm_loadu_ps(left), _mm_loadu_ps(right));
+            const __m128 pairs = _mm_add_ps(products, _mm_movehl_ps(products, products));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+#elif defined(GLESC_MATH_NEON)
+            return vaddvq_f32(vmulq_f32(vld1q_f32(left), vld1q_f32(right)));
+#else
+            return (left[0] * right[0] + left[2] * right[2]) + (left[1] * right[1] + left[3] * right[3]);
+#endif
+        }
+    }; // class SimdAlgorithms
+} // namespace GLESC::Math
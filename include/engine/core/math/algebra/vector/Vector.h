@@ -22,7 +22,7 @@
 namespace GLESC::Math {
 #pragma pack(push, 1)  // Push the current alignment to the stack and set new alignment to 1 byte
     template <typename Type, size_t N>
-    [[nodiscard]] class Vector {
+    [[nodiscard]] class alignas(vectorAlignment<Type, N>) Vector {
     public:
         using ValueType = Type;
         // =========================================================================================
@@ -9,6 +9,7 @@
  **************************************************************************************************/
 #pragma once
 
+#include "engine/core/math/algebra/simd/SimdAlgorithms.h"
 #include "engine/core/math/algebra/vector/VectorTypes.h"
 #include "engine/core/exceptions/core/math/MathException.h"
 #include "engine/core/math/Math.h"
@@ -79,6 +80,10 @@ namespace GLESC::Math {
         template <typename Type, size_t N>
         static void
         vectorAdd(const VectorData<Type, N>& a, const VectorData<Type, N>& b, VectorData<Type, N>& result) {
+            if constexpr (SimdAlgorithms::isFloat4<Type, N>) {
+                SimdAlgorithms::vec4Add(a.data(), b.data(), result.data());
+                return;
+            }
             for (size_t i = 0; i < N; ++i) {
                 result[i] = a[i] + b[i];
             }
@@ -117,6 +122,11 @@ namespace GLESC::Math {
             const VectorData<TypeLeft, N>& vecLeft,
             const VectorData<TypeRight, N>& vecRight,
             VectorData<TypeResult, N>& result) {
+            if constexpr (SimdAlgorithms::isFloat4<TypeResult, N> && std::is_same_v<TypeLeft, float> &&
+                std::is_same_v<TypeRight, float>) {
+                SimdAlgorithms::vec4Sub(vecLeft.data(), vecRight.data(), result.data());
+                return;
+            }
             for (size_t i = 0; i < N; ++i) {
                 result[i] = vecLeft[i] - vecRight[i];
             }
@@ -166,6 +176,10 @@ namespace GLESC::Math {
         template <typename Type, size_t N>
         static void
         vectorMul(const VectorData<Type, N>& vec1, const VectorData<Type, N>& vec2, VectorData<Type, N>& result) {
+            if constexpr (SimdAlgorithms::isFloat4<Type, N>) {
+                SimdAlgorithms::vec4Mul(vec1.data(), vec2.data(), result.data());
+                return;
+            }
             for (size_t i = 0; i < N; ++i) {
                 result[i] = vec1[i] * vec2[i];
             }
@@ -183,6 +197,10 @@ namespace GLESC::Math {
         template <typename Type, size_t N>
         static void
         vectorScalarMul(const VectorData<Type, N>& vec, const Type& scalar, VectorData<Type, N>& result) {
+            if constexpr (SimdAlgorithms::isFloat4<Type, N>) {
+                SimdAlgorithms::vec4ScalarMul(vec.data(), scalar, result.data());
+                return;
+            }
             for (size_t i = 0; i < N; ++i) {
                 result[i] = vec[i] * scalar;
             }
@@ -202,6 +220,10 @@ namespace GLESC::Math {
         static void
         vectorDiv(const VectorData<Type, N>& dividend, const VectorData<Type, N>& divisor,
                   VectorData<Type, N>& result) {
+            if constexpr (SimdAlgorithms::isFloat4<Type, N>) {
+                SimdAlgorithms::vec4Div(dividend.data(), divisor.data(), result.data());
+                return;
+            }
             for (size_t i = 0; i < N; ++i) {
                 result[i] = dividend[i] / divisor[i];
             }
@@ -368,6 +390,9 @@ namespace GLESC::Math {
         template <typename TypeLeft, typename TypeRight, size_t N>
         static auto dotProduct(const VectorData<TypeLeft, N>& leftVec, const VectorData<TypeRight, N>& rightVec) {
             using CommonType = std::common_type_t<TypeLeft, TypeRight>;
+            if constexpr (SimdAlgorithms::isFloat4<TypeLeft, N> && std::is_same_v<TypeRight, float>) {
+                return SimdAlgorithms::vec4Dot(leftVec.data(), rightVec.data());
+            }
             CommonType result = 0;
             for (size_t i = 0; i < N; ++i) {
                 result += leftVec[i] * rightVec[i];
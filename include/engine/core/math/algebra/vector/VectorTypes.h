@@ -10,6 +10,8 @@
 #pragma once
 
 #include <array>
+#include <type_traits>
+#include "engine/Config.h"
 
 namespace GLESC::Math {
     /**
@@ -22,5 +24,15 @@ namespace GLESC::Math {
     template<typename Type, std::size_t N>
     using VectorData = std::array<Type, N>;
 
+    /**
+     * @brief The alignment of the vectors.
+     * @details The vectors are packed with an alignment of 1 byte, unless GLESC_MATH_PACKED_VECTORS is false, then
+     * the vectors of 4 floats are aligned to 16 bytes, the size of a SIMD register.
+     */
+    template<typename Type, std::size_t N>
+    constexpr std::size_t vectorAlignment = !GLESC_MATH_PACKED_VECTORS && std::is_same_v<Type, float> && N == 4
+                                                ? 16
+                                                : 1;
+
 
 } // namespace GLESC::Math
\ No newline at end of file
@@ -0,0 +1,284 @@
+/**************************************************************************************************
+ * @file   AABBTree.h
+ * @author Valentin Dumitru
+ * @date   2024-06-06
+ * @brief  Dynamic bounding volume hierarchy of axis-aligned bounding boxes.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/core/asserts/Asserts.h"
+#include "engine/core/math/geometry/figures/BoundingVolume.h"
+
+namespace GLESC::Math {
+    /**
+     * @brief Result of testing a bounding box against a volume (for example a frustum).
+     */
+    enum class Containment {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    /**
+     * @brief Dynamic tree of axis-aligned bounding boxes, each leaf is a proxy of an object.
+     * @details The tree keeps, for every proxy, a "fat" box that is the box of the object enlarged by a margin.
+     * Moving an object whose box stays inside its fat box doesn't modify the tree, so objects that barely move
+     * (or don't move at all) have no cost.
+     * The internal nodes enclose the boxes of their children, a query that rejects a node rejects the whole
+     * subtree, and a query that fully accepts a node accepts all the leaves below it without testing them.
+     * The tree is kept balanced with rotations when leaves are inserted or removed.
+     * @cite Erin Catto, Dynamic Bounding Volume Hierarchies, GDC 2019.
+     */
+    class AABBTree {
+    public:
+        using AABB = BoundingVolume::AABB;
+        /**
+         * @brief Identifies a proxy, stays valid until the proxy is destroyed.
+         */
+        using ProxyId = int;
+        static constexpr ProxyId nullNode = -1;
+
+        /**
+         * @brief Counters of the last query, to know how much work the hierarchy saved.
+         */
+        struct QueryStats {
+            /**
+             * @brief Nodes (internal and leaves) whose box was tested.
+             */
+            size_t testedNodes = 0;
+            /**
+             * @brief Nodes that were rejected with all their subtree.
+             */
+            size_t rejectedNodes = 0;
+            /**
+             * @brief Internal nodes that were accepted with all their subtree without testing it.
+             */
+            size_t acceptedSubtrees = 0;
+            /**
+             * @brief Leaves reported to the visitor.
+             */
+            size_t visitedLeaves = 0;
+            /**
+             * @brief Leaves handed to the caller without testing them, only in queryDeferringLeaves.
+             */
+            size_t deferredLeaves = 0;
+        };
+
+        /**
+         * @brief Construct a new empty tree.
+         * @param marginParam How much the boxes of the proxies are enlarged in each direction.
+         */
+        explicit AABBTree(float marginParam = 0.1f) : margin(marginParam) {
+        }
+
+        /**
+         * @brief Creates a proxy for an object.
+         * @param aabb The box of the object.
+         * @param userData Data returned by the queries when the proxy is found.
+         * @return The id of the proxy.
+         */
+        ProxyId createProxy(const AABB& aabb, size_t userData);
+        /**
+         * @brief Destroys a proxy, its id can be reused by the next proxy created.
+         */
+        void destroyProxy(ProxyId proxyId);
+        /**
+         * @brief Updates the box of a proxy.
+         * @details The tree is only modified if the box is not contained in the fat box of the proxy anymore, or if
+         * the fat box became much bigger than the box.
+         * @return True if the proxy was reinserted in the tree.
+         */
+        bool moveProxy(ProxyId proxyId, const AABB& aabb);
+
+        void setUserData(ProxyId proxyId, size_t userData) {
+            D_ASSERT_TRUE(isLeaf(proxyId), "Proxy id is not a leaf of the tree");
+            nodes[proxyId].userData = userData;
+        }
+
+        [[nodiscard]] size_t getUserData(ProxyId proxyId) const {
+            D_ASSERT_TRUE(isLeaf(proxyId), "Proxy id is not a leaf of the tree");
+            return nodes[proxyId].userData;
+        }
+
+        /**
+         * @brief Get the enlarged box of the proxy, the one stored in the tree.
+         */
+        [[nodiscard]] const AABB& getFatAABB(ProxyId proxyId) const {
+            D_ASSERT_TRUE(isLeaf(proxyId), "Proxy id is not a leaf of the tree");
+            return nodes[proxyId].aabb;
+        }
+
+        [[nodiscard]] size_t getProxyCount() const { return proxyCount; }
+        [[nodiscard]] bool empty() const { return proxyCount == 0; }
+        /**
+         * @brief Get the height of the tree, 0 if it only has one leaf and -1 if it's empty.
+         */
+        [[nodiscard]] int getHeight() const { return root == nullNode ? -1 : nodes[root].height; }
+
+        /**
+         * @brief Removes all the proxies, the memory is kept.
+         */
+        void clear();
+
+        /**
+         * @brief Checks the structure of the tree, the links, the heights and that every node encloses its children.
+         * @return True if the tree is valid.
+         */
+        [[nodiscard]] bool isValid() const;
+
+        /**
+         * @brief Visits all the leaves whose box is not outside the volume tested by the classifier.
+         * @details The classifier is called as `Containment classify(const AABB& aabb, std::uint8_t& state)`.
+         * The state starts at initialState for the root and is inherited by the children of a node, so the
+         * classifier can skip tests already passed by the parent (for example the planes of a frustum that contain
+         * the parent entirely).
+         * The visitor is called as `visit(size_t userData)` for every accepted leaf.
+         * @return The counters of the query.
+         */
+        template <typename Classifier, typename Visitor>
+        QueryStats query(const Classifier& classify, std::uint8_t initialState, Visitor&& visit) const {
+            auto noDeferredLeaves = [](const AABB&, size_t) {
+            };
+            return traverse<false>(classify, initialState, visit, noDeferredLeaves);
+        }
+
+        /**
+         * @brief Same as query, but the leaves that would need to be classified are not, they are handed to
+         * deferLeaf instead.
+         * @details This allows the caller to test all those leaves at once, for example with a batch test that is
+         * faster than classifying them one by one. Only the internal nodes are classified, the leaves of accepted
+         * subtrees are still reported to visit.
+         * deferLeaf is called as `deferLeaf(const AABB& aabb, size_t userData)`.
+         * @return The counters of the query.
+         */
+        template <typename Classifier, typename Visitor, typename LeafVisitor>
+        QueryStats queryDeferringLeaves(const Classifier& classify, std::uint8_t initialState, Visitor&& visit,
+                                        LeafVisitor&& deferLeaf) const {
+            return traverse<true>(classify, initialState, visit, deferLeaf);
+        }
+
+    private:
+        template <bool deferLeaves, typename Classifier, typename Visitor, typename LeafVisitor>
+        QueryStats traverse(const Classifier& classify, std::uint8_t initialState, Visitor& visit,
+                            LeafVisitor& deferLeaf) const {
+            QueryStats stats;
+            if (root == nullNode) return stats;
+
+            struct StackEntry {
+                ProxyId node;
+                std::uint8_t state;
+            };
+            std::vector<StackEntry> stack;
+            stack.reserve(static_cast<size_t>(nodes[root].height) + 1);
+            stack.push_back({root, initialState});
+            while (!stack.empty()) {
+                StackEntry entry = stack.back();
+                stack.pop_back();
+                const Node& node = nodes[entry.node];
+
+                if constexpr (deferLeaves) {
+                    if (node.isLeaf()) {
+                        stats.deferredLeaves++;
+                        deferLeaf(node.aabb, node.userData);
+                        continue;
+                    }
+                }
+                stats.testedNodes++;
+                Containment containment = classify(node.aabb, entry.state);
+                if (containment == Containment::Outside) {
+                    stats.rejectedNodes++;
+                    continue;
+                }
+                if (node.isLeaf()) {
+                    stats.visitedLeaves++;
+                    visit(node.userData);
+                    continue;
+                }
+                if (containment == Containment::Inside) {
+                    stats.acceptedSubtrees++;
+                    stats.visitedLeaves += visitSubtree(entry.node, visit);
+                    continue;
+                }
+                stack.push_back({node.child2, entry.state});
+                stack.push_back({node.child1, entry.state});
+            }
+            return stats;
+        }
+
+        struct Node {
+            AABB aabb;
+            size_t userData = 0;
+            /**
+             * @brief Parent of the node, or next free node if the node is in the free list.
+             */
+            ProxyId parentOrNext = nullNode;
+            ProxyId child1 = nullNode;
+            ProxyId child2 = nullNode;
+            /**
+             * @brief Height of the subtree, 0 for leaves and -1 for free nodes.
+             */
+            int height = -1;
+
+            [[nodiscard]] bool isLeaf() const { return child1 == nullNode; }
+        };
+
+        /**
+         * @brief Reports all the leaves of a subtree without testing them.
+         * @return The number of leaves reported.
+         */
+        template <typename Visitor>
+        size_t visitSubtree(ProxyId subtreeRoot, Visitor& visit) const {
+            size_t visited = 0;
+            std::vector<ProxyId> stack;
+            stack.reserve(static_cast<size_t>(nodes[subtreeRoot].height) + 1);
+            stack.push_back(subtreeRoot);
+            while (!stack.empty()) {
+                const Node& node = nodes[stack.back()];
+                stack.pop_back();
+                if (node.isLeaf()) {
+                    visited++;
+                    visit(node.userData);
+                    continue;
+                }
+                stack.push_back(node.child2);
+                stack.push_back(node.child1);
+            }
+            return visited;
+        }
+
+        [[nodiscard]] bool isLeaf(ProxyId nodeId) const {
+            return nodeId >= 0 && static_cast<size_t>(nodeId) < nodes.size() && nodes[nodeId].height == 0;
+        }
+
+        ProxyId allocateNode();
+        void freeNode(ProxyId nodeId);
+
+        void insertLeaf(ProxyId leaf);
+        void removeLeaf(ProxyId leaf);
+        /**
+         * @brief Walks from a node to the root, balancing and refitting the boxes and heights of the ancestors.
+         */
+        void refitAncestors(ProxyId nodeId);
+        /**
+         * @brief Performs a rotation if the subtree of the node is unbalanced.
+         * @return The node that replaces it in the tree.
+         */
+        ProxyId balance(ProxyId nodeId);
+
+        [[nodiscard]] bool isSubtreeValid(ProxyId nodeId, ProxyId parent) const;
+
+        [[nodiscard]] AABB fatten(const AABB& aabb) const;
+
+        std::vector<Node> nodes;
+        ProxyId root = nullNode;
+        ProxyId freeList = nullNode;
+        size_t proxyCount = 0;
+        float margin;
+    }; // class AABBTree
+} // namespace GLESC::Math
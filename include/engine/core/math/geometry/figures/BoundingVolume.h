@@ -8,6 +8,7 @@
  * See LICENSE.txt in the project root for license information.
  **************************************************************************************************/
 #pragma once
+#include <algorithm>
 #include "engine/core/math/algebra/vector/Vector.h"
 
 namespace GLESC::Math {
@@ -27,6 +28,33 @@ namespace GLESC::Math {
         struct AABB {
             Vec3F min{-1, -1, -1};
             Vec3F max{1, 1, 1};
+
+            /**
+             * @brief Get the smallest box that encloses this box and another one.
+             * @param other The other box
+             * @return The box that encloses both
+             */
+            [[nodiscard]] AABB combine(const AABB& other) const {
+                AABB combined;
+                for (size_t axis = 0; axis < 3; axis++) {
+                    combined.min.set(axis, std::min(min.get(axis), other.min.get(axis)));
+                    combined.max.set(axis, std::max(max.get(axis), other.max.get(axis)));
+                }
+                return combined;
+            }
+
+            /**
+             * @brief Checks if another box is entirely inside this box.
+             * @param other The other box
+             * @return True if the other box is inside this box (touching the faces counts as inside)
+             */
+            [[nodiscard]] bool encloses(const AABB& other) const {
+                for (size_t axis = 0; axis < 3; axis++) {
+                    if (other.min.get(axis) < min.get(axis) || other.max.get(axis) > max.get(axis))
+                        return false;
+                }
+                return true;
+            }
         };
 
         /**
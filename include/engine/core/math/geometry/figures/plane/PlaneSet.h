@@ -0,0 +1,187 @@
+/**************************************************************************************************
+ * @file   PlaneSet.h
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Set of planes that answers queries for many points or segments at a time.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "engine/core/math/geometry/GeometryTypes.h"
+#include "engine/core/math/geometry/figures/plane/Plane.h"
+#include "engine/core/math/geometry/figures/polyhedron/Polyhedron.h"
+
+namespace GLESC::Math {
+    /**
+     * @brief The implementations of the batch queries of the plane sets, they all give the same result.
+     */
+    enum class GeometryKernel {
+        /**
+         * @brief One element at a time, available everywhere.
+         */
+        Scalar,
+        /**
+         * @brief Four elements at a time with SSE, available in all the x86-64 processors.
+         */
+        SSE,
+        /**
+         * @brief Eight elements at a time with AVX2, checked at runtime.
+         */
+        AVX2
+    };
+
+    /**
+     * @brief Points stored as a structure of arrays, the layout read by the batch queries.
+     */
+    struct PointArrays {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void push_back(const Point& point) {
+            x.push_back(point.getX());
+            y.push_back(point.getY());
+            z.push_back(point.getZ());
+        }
+
+        void reserve(size_t count) {
+            for (std::vector<float>* component : {&x, &y, &z}) {
+                component->reserve(count);
+            }
+        }
+
+        void clear() {
+            for (std::vector<float>* component : {&x, &y, &z}) {
+                component->clear();
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return x.size(); }
+        [[nodiscard]] bool empty() const { return x.empty(); }
+    };
+
+    /**
+     * @brief Segments stored as a structure of arrays, the layout read by the batch queries.
+     */
+    struct SegmentArrays {
+        std::vector<float> startX;
+        std::vector<float> startY;
+        std::vector<float> startZ;
+        std::vector<float> endX;
+        std::vector<float> endY;
+        std::vector<float> endZ;
+
+        void push_back(const Point& start, const Point& end) {
+            startX.push_back(start.getX());
+            startY.push_back(start.getY());
+            startZ.push_back(start.getZ());
+            endX.push_back(end.getX());
+            endY.push_back(end.getY());
+            endZ.push_back(end.getZ());
+        }
+
+        void reserve(size_t count) {
+            for (std::vector<float>* component : {&startX, &startY, &startZ, &endX, &endY, &endZ}) {
+                component->reserve(count);
+            }
+        }
+
+        void clear() {
+            for (std::vector<float>* component : {&startX, &startY, &startZ, &endX, &endY, &endZ}) {
+                component->clear();
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return startX.size(); }
+        [[nodiscard]] bool empty() const { return startX.empty(); }
+    };
+
+    /**
+     * @brief A set of planes, which bounds a convex region when the inside of every plane is taken.
+     * @details The planes are kept packed as [normal x, normal y, normal z, distance] so the batch queries can
+     * broadcast them, and the points and segments are read as structures of arrays so consecutive elements can be
+     * loaded into SIMD registers without shuffling. Inside has the same meaning as in Plane::hasInside, the side
+     * where the normal points.
+     */
+    class PlaneSet {
+    public:
+        PlaneSet() = default;
+
+        explicit PlaneSet(const std::vector<Plane>& planesParam);
+
+        /**
+         * @brief Creates the set with the planes of the faces of a convex polyhedron.
+         * @details The planes are computed from the vertices of each face and turned towards the center of the
+         * polyhedron, so the inside of the set is the inside of the polyhedron whatever the winding of the faces.
+         * @param convexPolyhedron The polyhedron, it must be convex and have faces.
+         */
+        explicit PlaneSet(const Polyhedron& convexPolyhedron);
+
+        void addPlane(const Plane& plane);
+
+        [[nodiscard]] Plane getPlane(size_t index) const;
+        [[nodiscard]] size_t size() const { return packedPlanes.size(); }
+        [[nodiscard]] bool empty() const { return packedPlanes.empty(); }
+
+        /**
+         * @brief Checks if a point is inside all the planes.
+         */
+        [[nodiscard]] bool hasInside(const Point& point) const;
+
+        /**
+         * @brief Checks which points are inside all the planes, a point in convex region test for many points.
+         * @param points The points to check.
+         * @param insideOut Receives 1 for each point inside all the planes and 0 for the rest, must have as many
+         * elements as points.
+         * @param kernel The implementation to use, it must be supported by the processor.
+         */
+        void hasInside(const PointArrays& points, std::uint8_t* insideOut, GeometryKernel kernel) const;
+        void hasInside(const PointArrays& points, std::uint8_t* insideOut) const;
+
+        /**
+         * @brief Computes the signed distance of the points to one of the planes, the same as Plane::distanceToPoint.
+         * @param planeIndex The index of the plane.
+         * @param points The points to measure.
+         * @param distancesOut Receives the distance of each point, must have as many elements as points.
+         * @param kernel The implementation to use, it must be supported by the processor.
+         */
+        void distancesToPoints(size_t planeIndex, const PointArrays& points, float* distancesOut,
+                               GeometryKernel kernel) const;
+        void distancesToPoints(size_t planeIndex, const PointArrays& points, float* distancesOut) const;
+
+        /**
+         * @brief Clips the segments against the planes, keeping the part inside all of them.
+         * @details The part of each segment inside the region goes from start + enter * (end - start) to
+         * start + exit * (end - start). With a single plane, the parameter of the crossing is enter when the start is
+         * outside and exit when the start is inside.
+         * @param segments The segments to clip.
+         * @param enterOut Receives the parameter in [0, 1] where each segment enters the region. Only meaningful
+         * for the segments that intersect it.
+         * @param exitOut Receives the parameter in [0, 1] where each segment leaves the region. Only meaningful for
+         * the segments that intersect it.
+         * @param intersectsOut Receives 1 for each segment with a part inside the region and 0 for the rest.
+         * @param kernel The implementation to use, it must be supported by the processor.
+         */
+        void clipSegments(const SegmentArrays& segments, float* enterOut, float* exitOut,
+                          std::uint8_t* intersectsOut, GeometryKernel kernel) const;
+        void clipSegments(const SegmentArrays& segments, float* enterOut, float* exitOut,
+                          std::uint8_t* intersectsOut) const;
+
+        /**
+         * @brief Get the fastest kernel supported by the processor, it's detected once.
+         */
+        [[nodiscard]] static GeometryKernel getBestKernel();
+        [[nodiscard]] static bool isKernelSupported(GeometryKernel kernel);
+
+    private:
+        /**
+         * @brief The planes as [normal x, normal y, normal z, distance], the format read by the kernels.
+         */
+        std::vector<std::array<float, 4>> packedPlanes;
+    }; // class PlaneSet
+} // namespace GLESC::Math
@@ -9,6 +9,7 @@
  **************************************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include "engine/core/math/geometry/GeometryTypes.h"
 #include "engine/core/math/geometry/figures/polyhedron/PolyhedronFace.h"
 
@@ -94,6 +95,8 @@ namespace GLESC::Math {
 
         /**
          * @brief Checks if a point is inside the polyhedron.
+         * @details The polyhedron must be convex, the point is inside if it's inside the planes of all the faces.
+         * To check many points, build a PlaneSet from the polyhedron once and use its batch query.
          * @param point The point to check.
          * @return True if the point is inside the polyhedron, false otherwise.
          */
@@ -162,6 +165,12 @@ namespace GLESC::Math {
          * @return True if the face indices are out of bounds, false otherwise.
          */
         [[nodiscard]] bool isOutOfBounds(const FaceIndices& face) const;
+        /**
+         * @brief Checks which vertices of another polyhedron are inside this one, all of them in one batch.
+         * @param polyhedron The polyhedron whose vertices are checked.
+         * @return 1 for each vertex inside this polyhedron and 0 for the rest.
+         */
+        [[nodiscard]] std::vector<std::uint8_t> verticesInside(const Polyhedron& polyhedron) const;
         std::vector<Vec3F> vertices;
         std::vector<PolyhedronFace> faces;
     }; // class Polyhedron
@@ -0,0 +1,196 @@
+/**************************************************************************************************
+ * @file   RandomGenerator.h
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Fast seedable pseudo random number generator, with one instance per thread.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "engine/core/asserts/Asserts.h"
+
+namespace GLESC::Math {
+    /**
+     * @brief Pseudo random number generator with the xoshiro256** algorithm.
+     * @details The state is four 64 bit words and each number costs a few shifts and multiplications, so it is
+     * much faster than std::mt19937 with a std::uniform_*_distribution and it's cheap to have one per thread or
+     * per task. It isn't cryptographically secure.
+     *
+     * The same seed always gives the same sequence, in every platform, which makes the generation of scenes and
+     * the inputs of the benchmarks reproducible.
+     */
+    class RandomGenerator {
+    public:
+        /**
+         * @brief Creates a generator with the given seed.
+         * @details The seed is expanded to the state with splitmix64, so close seeds give unrelated sequences.
+         */
+        explicit RandomGenerator(uint64_t seed) { setSeed(seed); }
+
+        /**
+         * @brief Restarts the sequence of the generator from the given seed.
+         */
+        void setSeed(uint64_t seed) {
+            for (uint64_t& word : state) {
+                word = splitMix64(seed);
+            }
+        }
+
+        /**
+         * @brief Generates the next 64 random bits.
+         */
+        uint64_t next() {
+            const uint64_t result = rotateLeft(state[1] * 5, 7) * 9;
+            const uint64_t shifted = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= shifted;
+            state[3] = rotateLeft(state[3], 45);
+            return result;
+        }
+
+        /**
+         * @brief Generates a random number between min and max.
+         * @details Integers are in the range [min, max] and floating point numbers in the range [min, max),
+         * the same as the distributions of the standard library.
+         */
+        template <typename Type>
+        Type uniform(Type min, Type max) {
+            S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic");
+            D_ASSERT_TRUE(max >= min, "Max must be greater than min");
+            if constexpr (std::is_floating_point_v<Type>) {
+                return min + unitInterval<Type>(next()) * (max - min);
+            }
+            else {
+                using Unsigned = std::make_unsigned_t<Type>;
+                // The range wraps to 0 when it covers all the values of a 64 bit type
+                const uint64_t range = static_cast<uint64_t>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min))
+                                       + 1;
+                return static_cast<Type>(static_cast<Unsigned>(min) + static_cast<Unsigned>(bounded(range)));
+            }
+        }
+
+        /**
+         * @brief Returns true with the given chance, between 0 and 1.
+         */
+        bool chance(float probability) {
+            D_ASSERT_TRUE(probability >= 0.0f && probability <= 1.0f, "Chance must be between 0 and 1");
+            return unitInterval<float>(next()) < probability;
+        }
+
+        /**
+         * @brief Fills the array with random numbers between min and max, the same ranges as uniform.
+         * @details Floats take only 24 bits, so two of them are made from each 64 bit number. This halves the cost
+         * of filling big arrays, like the positions of the vegetation of a scene.
+         */
+        template <typename Type>
+        void fillUniform(Type* values, size_t count, Type min, Type max) {
+            S_ASSERT_TRUE(std::is_arithmetic_v<Type>, "Type must be arithmetic");
+            D_ASSERT_TRUE(max >= min, "Max must be greater than min");
+            if constexpr (std::is_same_v<Type, float>) {
+                const float scale = (max - min) * 0x1.0p-24f;
+                size_t i = 0;
+                for (; i + 1 < count; i += 2) {
+                    const uint64_t bits = next();
+                    values[i] = min + static_cast<float>(bits >> 40) * scale;
+                    values[i + 1] = min + static_cast<float>((bits >> 8) & 0xFFFFFF) * scale;
+                }
+                if (i < count) {
+                    values[i] = min + static_cast<float>(next() >> 40) * scale;
+                }
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    values[i] = uniform(min, max);
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the generator of the calling thread.
+         * @details It's created the first time each thread calls it, with the seed given by setThreadsSeed or,
+         * if it was never called, with a seed from std::random_device. Threads don't share any state, so they
+         * can generate numbers at the same time without locks.
+         */
+        static RandomGenerator& getThreadGenerator() {
+            thread_local RandomGenerator generator(nextThreadSeed());
+            return generator;
+        }
+
+        /**
+         * @brief Makes the generators of the threads deterministic.
+         * @details The generator of the calling thread is restarted with the given seed, and each thread that
+         * creates its generator afterwards gets a seed derived from it and from the order of creation. The
+         * threads that already have a generator keep their sequence.
+         */
+        static void setThreadsSeed(uint64_t seed);
+
+    private:
+        uint64_t state[4]{};
+
+        /**
+         * @brief Returns the seed of the generator of a new thread.
+         */
+        static uint64_t nextThreadSeed();
+
+        static uint64_t rotateLeft(uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        /**
+         * @brief Advances the seed and returns the next word of the splitmix64 sequence.
+         */
+        static uint64_t splitMix64(uint64_t& seed) {
+            uint64_t result = (seed += 0x9E3779B97F4A7C15);
+            result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
+            result = (result ^ (result >> 27)) * 0x94D049BB133111EB;
+            return result ^ (result >> 31);
+        }
+
+        /**
+         * @brief Converts the random bits to a number in the range [0, 1), with all the precision of the type.
+         */
+        template <typename Type>
+        static Type unitInterval(uint64_t bits) {
+            if constexpr (sizeof(Type) <= sizeof(float)) {
+                return static_cast<Type>(bits >> 40) * Type(0x1.0p-24);
+            }
+            else {
+                return static_cast<Type>(bits >> 11) * Type(0x1.0p-53);
+            }
+        }
+
+        /**
+         * @brief Generates a number in the range [0, range) without bias. A range of 0 means all the 64 bit values.
+         * @details Small ranges use the multiplication of Lemire, which almost never needs a second number. The
+         * others reject the numbers above the biggest multiple of the range.
+         */
+        uint64_t bounded(uint64_t range) {
+            if (range == 0) {
+                return next();
+            }
+            if (range <= 0xFFFFFFFF) {
+                uint64_t product = (next() >> 32) * range;
+                if (static_cast<uint32_t>(product) < range) {
+                    const uint32_t threshold = static_cast<uint32_t>(-static_cast<uint32_t>(range) % range);
+                    while (static_cast<uint32_t>(product) < threshold) {
+                        product = (next() >> 32) * range;
+                    }
+                }
+                return product >> 32;
+            }
+            const uint64_t threshold = -range % range;
+            uint64_t bits = next();
+            while (bits < threshold) {
+                bits = next();
+            }
+            return bits % range;
+        }
+    }; // class RandomGenerator
+} // namespace GLESC::Math
@@ -0,0 +1,90 @@
+/**************************************************************************************************
+ * @file   ThreadPool.h
+ * @author Valentin Dumitru
+ * @date   2024-06-02
+ * @brief  Persistent pool of worker threads for data-parallel loops.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GLESC {
+    /**
+     * @brief Persistent pool of worker threads used to run data-parallel loops.
+     * @details The threads are created once and sleep between jobs, so dispatching a loop every frame does not pay
+     * the cost of creating threads. The range of a loop is split in contiguous chunks, one per thread, and the
+     * calling thread always executes the first chunk. Each index is processed by exactly one thread, so tasks that
+     * only write to the slot of their own index do not need any synchronization.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief The task executed for each chunk, receives the half-open range [begin, end) of indices.
+         */
+        using RangeTask = std::function<void(size_t begin, size_t end)>;
+
+        /**
+         * @brief Creates the pool.
+         * @param threadCount The total number of threads that process a loop, including the calling thread.
+         * A value of 0 uses the number of hardware threads. A value of 1 creates no workers, loops run serially.
+         */
+        explicit ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Returns the number of threads that process a loop, including the calling thread.
+         */
+        [[nodiscard]] size_t getThreadCount() const { return workers.size() + 1; }
+
+        /**
+         * @brief Runs the task over the range [0, count) splitting it among all the threads of the pool.
+         * @details Blocks until every chunk has been processed. If any chunk throws, the first exception is
+         * rethrown in the calling thread once all the chunks have finished.
+         * @param count The number of indices to process.
+         * @param task The task to execute for each chunk.
+         */
+        void parallelFor(size_t count, const RangeTask& task);
+
+    private:
+        /**
+         * @brief Main loop of the worker threads, waits for jobs and executes their chunk.
+         * @param chunkIndex The chunk of each job this worker is responsible for.
+         */
+        void workerLoop(size_t chunkIndex);
+
+        /**
+         * @brief Executes a chunk of the current job, storing the exception if the task throws.
+         */
+        void runChunk(size_t chunkIndex);
+
+        std::vector<std::thread> workers;
+
+        std::mutex jobMutex;
+        std::condition_variable jobAvailable;
+        std::condition_variable jobFinished;
+
+        /**
+         * @brief The task of the current job, only valid while parallelFor is running.
+         */
+        const RangeTask* currentTask = nullptr;
+        size_t currentCount = 0;
+        /**
+         * @brief Increased every time a job is dispatched, workers use it to detect new jobs.
+         */
+        size_t jobGeneration = 0;
+        size_t pendingWorkers = 0;
+        std::exception_ptr firstException = nullptr;
+        bool stopping = false;
+    }; // class ThreadPool
+} // namespace GLESC
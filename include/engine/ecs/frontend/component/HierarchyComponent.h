@@ -0,0 +1,47 @@
+/**************************************************************************************************
+ * @file   HierarchyComponent.h
+ * @author Valentin Dumitru
+ * @date   2024-06-23
+ * @brief  Component that attaches an entity to a parent entity.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include "engine/ecs/backend/component/IComponent.h"
+#include "engine/ecs/backend/entity/EntityManager.h"
+#include "engine/subsystems/transform/Transform.h"
+
+namespace GLESC::ECS {
+    /**
+     * @brief Makes the entity follow its parent, like a prop held by a character.
+     * @details The local transform is relative to the transform of the parent. The transform system computes the
+     * world transform from both and writes it to the transform component of the entity, which is the one the other
+     * systems read, so the entity must be moved through the local transform and not the transform component.
+     * If the parent is destroyed the entity stays where it was.
+     */
+    struct HierarchyComponent : IComponent {
+        /**
+         * @brief The entity this one is attached to, it needs a transform component.
+         */
+        EntityID parent = EntityManager::nullEntity;
+        Transform::Transform localTransform;
+
+        [[nodiscard]] std::string toString() const override {
+            return "Parent: " + std::to_string(parent) + "\n" + localTransform.toString();
+        }
+
+        [[nodiscard]] std::string getName() const override {
+            return "HierarchyComponent";
+        }
+
+#ifndef NDEBUG_GLESC
+        void setDebuggingValues() override {
+            for (auto& value : localTransform.getDebuggingValues()) {
+                values.push_back(value);
+            }
+        }
+#endif
+    }; // struct HierarchyComponent
+} // namespace GLESC::ECS
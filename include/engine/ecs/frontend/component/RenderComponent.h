@@ -12,12 +12,14 @@
 #include "engine/ecs/frontend/entity/Entity.h"
 #include "engine/subsystems/renderer/material/Material.h"
 #include "engine/subsystems/renderer/mesh/Mesh.h"
+#include "engine/subsystems/renderer/mesh/MeshLod.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
 #include "engine/ecs/backend/component/IComponent.h"
 
 namespace GLESC::ECS {
     struct RenderComponent : IComponent {
         std::string toString() const override {
-            return "RenderComponent:\n" + mesh.toString();
+            return "RenderComponent:\n" + (mesh ? mesh->toString() : std::string("No mesh"));
         }
 
         std::string getName() const override {
@@ -29,43 +31,89 @@ namespace GLESC::ECS {
             for (auto& value : material.getDebuggingValues()) {
                 values.push_back(value);
             }
-            for (auto& value : mesh.getDebuggingValues()) {
-                values.push_back(value);
-            }
         }
 
         void setUpdatedDebuggingValues() override {
-            for (auto& value : mesh.getUpdatedDebuggingValues()) {
-                updatedValues.push_back(value);
-            }
+            if (!mesh) return;
+            EntityStatsManager::Value vertexCountValue;
+            vertexCountValue.name = "Vertex Count";
+            vertexCountValue.stringData = std::to_string(mesh->getVertices().size());
+            vertexCountValue.isString = true;
+            updatedValues.push_back(vertexCountValue);
+
+            EntityStatsManager::Value faceCountValue;
+            faceCountValue.name = "Face Count";
+            faceCountValue.stringData = std::to_string(mesh->getIndices().size() / 3);
+            faceCountValue.isString = true;
+            updatedValues.push_back(faceCountValue);
         }
 #endif
 
+        /**
+         * @brief Registers a copy of the mesh in the mesh registry and renders it.
+         * @details If an equal mesh was already registered, the component shares it instead of storing another copy.
+         */
+        void copyMesh(const Render::ColorMesh& meshParam) {
+            mesh = Render::MeshRegistry::get().registerMesh(meshParam);
+            lods.reset();
+        }
 
-        void copyMesh(const Render::ColorMesh& mesh) {
-            this->mesh = mesh;
+        /**
+         * @brief Registers the mesh in the mesh registry moving its data and renders it.
+         * @details If an equal mesh was already registered, the component shares it instead of storing another copy.
+         */
+        void moveMesh(Render::ColorMesh& meshParam) {
+            mesh = Render::MeshRegistry::get().registerMesh(std::move(meshParam));
+            lods.reset();
         }
 
-        void moveMesh(Render::ColorMesh& mesh) {
-            this->mesh = std::move(mesh);
+        void moveMesh(Render::ColorMesh&& meshParam) {
+            mesh = Render::MeshRegistry::get().registerMesh(std::move(meshParam));
+            lods.reset();
         }
 
-        void moveMesh(Render::ColorMesh&& mesh) {
-            this->mesh = std::move(mesh);
+        /**
+         * @brief Renders a mesh already registered, sharing it with the other components that render it.
+         */
+        void setMesh(const Render::MeshHandle& meshParam) {
+            mesh = meshParam;
+            lods.reset();
         }
 
-        void copyMaterial(const Render::Material& material) {
-            this->material = material;
+        /**
+         * @brief Renders a chain of levels of detail, the renderer draws the level that fits the size of the object
+         * on the screen.
+         * @details The mesh of the component is the level 0 of the chain, it's the one used for the culling.
+         */
+        void setLods(std::shared_ptr<const Render::MeshLodChain> lodsParam) {
+            D_ASSERT_TRUE(lodsParam && lodsParam->getLevelCount() > 0, "The chain must have at least one level");
+            mesh = lodsParam->getLevel(0).mesh;
+            lods = std::move(lodsParam);
+        }
+
+        void copyMaterial(const Render::Material& materialParam) {
+            material = materialParam;
         }
 
-        void moveMaterial(Render::Material&& material) {
-            this->material = std::move(material);
+        void moveMaterial(Render::Material&& materialParam) {
+            material = std::move(materialParam);
         }
 
-        Render::ColorMesh& getMesh() {
+        /**
+         * @brief The mesh is shared with other components, so it can't be modified.
+         */
+        const Render::ColorMesh& getMesh() const {
+            return mesh.get();
+        }
+
+        const Render::MeshHandle& getMeshHandle() const {
             return mesh;
         }
 
+        const std::shared_ptr<const Render::MeshLodChain>& getLods() const {
+            return lods;
+        }
+
         Render::Material& getMaterial() {
             return material;
         }
@@ -73,9 +121,14 @@ namespace GLESC::ECS {
     private:
         /**
          * @brief The mesh of the object
-         * Contains the vertices and indices of the object.
+         * Contains the vertices and indices of the object. The mesh data is owned by the mesh registry and shared
+         * by every component that renders the same mesh.
+         */
+        Render::MeshHandle mesh;
+        /**
+         * @brief The levels of detail of the mesh, nullptr if the mesh is always drawn at full detail.
          */
-        Render::ColorMesh mesh;
+        std::shared_ptr<const Render::MeshLodChain> lods;
 
         /**
          * @brief The material of the object
@@ -103,6 +103,17 @@ namespace GLESC::ECS {
             return ecs.getComponent<Component>(entityId);
         }
 
+        /**
+         * @brief Checks if an entity has a component, for the components that aren't required by the system
+         * @tparam Component The type of the component
+         * @param entityId The ID of the entity
+         * @return True if the entity has the component
+         */
+        template<class Component>
+        [[nodiscard]] bool hasComponent(EntityID entityId) const {
+            return ecs.hasComponent<Component>(entityId);
+        }
+
         /**
          * @brief Easy access to the value of nullEntity
          */
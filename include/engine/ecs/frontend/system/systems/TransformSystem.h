@@ -10,12 +10,30 @@
 #pragma once
 
 #include "engine/ecs/frontend/system/System.h"
+#include "engine/subsystems/transform/TransformHierarchy.h"
 
 
 namespace GLESC::ECS {
+    /**
+     * @brief Keeps the rotations in range and computes the world transform of the entities attached to a parent.
+     * @details The entities with a hierarchy component get the world transform from their local transform and the
+     * transform of their parent. It must run before the systems that read the transforms, so the children are
+     * where their parents are in the same frame.
+     */
     class TransformSystem : public System {
     public:
         explicit TransformSystem(ECSCoordinator& ecs);
         void update() override;
+
+    private:
+        /**
+         * @brief If the entity is attached to a parent that still exists.
+         */
+        [[nodiscard]] bool hasValidParent(EntityID entity);
+
+        /**
+         * @brief Every entity with a transform is a node, the entities are the roots unless they have a parent.
+         */
+        Transform::TransformHierarchy hierarchy;
     };
-} // namespace GLESC::ECS
\ No newline at end of file
+} // namespace GLESC::ECS
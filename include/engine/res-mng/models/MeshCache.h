@@ -0,0 +1,119 @@
+/**************************************************************************************************
+ * @file   MeshCache.h
+ * @author Valentin Dumitru
+ * @date   2024-06-18
+ * @brief  Directory of built meshes stored in binary files, to avoid building them again in every run.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "engine/subsystems/renderer/mesh/Mesh.h"
+
+namespace GLESC {
+    /**
+     * @brief Stores built meshes in a directory, each one in a mesh file (@see MeshFile) named by a key.
+     * @details The key must identify the content of the mesh: the hash of the source file of an imported model
+     * (@see hashFile), or the hash of a description of a procedural mesh with the parameters and the version of its
+     * generator (@see hashString). If the source or the generator changes, the key changes too, so an old file is
+     * never used by mistake; it just stays in the directory unused.
+     * The files that can't be read (from another version of the format, or corrupted) are treated as missing and
+     * written again.
+     */
+    class MeshCache {
+    public:
+        using Key = std::uint64_t;
+
+        struct Stats {
+            /**
+             * @brief Number of meshes loaded from the cache.
+             */
+            size_t hits = 0;
+            /**
+             * @brief Number of meshes that weren't in the cache.
+             */
+            size_t misses = 0;
+            /**
+             * @brief Time spent loading meshes from the cache, in milliseconds.
+             */
+            double loadMillis = 0.0;
+            /**
+             * @brief Time spent creating the meshes that weren't in the cache, in milliseconds.
+             */
+            double createMillis = 0.0;
+        };
+
+        /**
+         * @brief The cache shared by the engine, in the directory cache/meshes next to the executable.
+         */
+        static MeshCache& get();
+
+        /**
+         * @brief Creates a cache in the directory, creating the directory if it doesn't exist.
+         */
+        explicit MeshCache(std::string directoryParam);
+
+        /**
+         * @brief Loads the mesh stored with the key.
+         * @return The mesh, or nothing if there is no valid file for the key.
+         */
+        [[nodiscard]] std::optional<Render::ColorMesh> load(Key key);
+        /**
+         * @brief Stores the mesh with the key, replacing the previous one.
+         * @return True if the mesh was written.
+         */
+        bool store(Key key, const Render::ColorMesh& mesh);
+        /**
+         * @brief Loads the mesh stored with the key, or creates and stores it if there is none.
+         * @param key The key of the mesh.
+         * @param create Builds the mesh, only called if the mesh is not in the cache.
+         */
+        [[nodiscard]] Render::ColorMesh getOrCreate(Key key, const std::function<Render::ColorMesh()>& create);
+
+        /**
+         * @brief Loads the meshes stored together with the key, for example the meshes of an imported model.
+         * @return The meshes in the order they were stored, or nothing if any of them is missing.
+         */
+        [[nodiscard]] std::optional<std::vector<Render::ColorMesh>> loadGroup(Key key);
+        /**
+         * @brief Stores the meshes together with the key.
+         * @details Each mesh is stored in its own file, and the list of the group is written last, so a group is
+         * never loaded without all its meshes.
+         * @return True if every mesh and the group were written.
+         */
+        bool storeGroup(Key key, const std::vector<const Render::ColorMesh*>& meshes);
+
+        [[nodiscard]] std::string getPath(Key key) const;
+        [[nodiscard]] const std::string& getDirectory() const { return directory; }
+        [[nodiscard]] Stats getStats() const;
+
+        /**
+         * @brief Key of the content of a file, for the meshes imported from it.
+         * @return The hash of the bytes of the file, or 0 if it can't be read.
+         */
+        [[nodiscard]] static Key hashFile(const std::string& path);
+        /**
+         * @brief Key of a description, for the procedural meshes.
+         */
+        [[nodiscard]] static Key hashString(const std::string& description);
+
+    private:
+        static constexpr const char* groupExtension = ".glgroup";
+
+        [[nodiscard]] static Key getGroupMeshKey(Key groupKey, size_t meshIndex);
+        [[nodiscard]] std::string getGroupPath(Key key) const;
+
+        std::string directory;
+
+        mutable std::mutex statsMutex;
+        Stats stats;
+    }; // class MeshCache
+} // namespace GLESC
@@ -0,0 +1,92 @@
+/**************************************************************************************************
+ * @file   MeshFile.h
+ * @author Valentin Dumitru
+ * @date   2024-06-18
+ * @brief  Binary file format of the meshes, to store them already built.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "engine/subsystems/renderer/mesh/Mesh.h"
+
+namespace GLESC {
+    /**
+     * @brief Reads and writes meshes in a binary format with the same layout they have in memory.
+     * @details The file is a header followed by the vertices, as they are in the vertex buffer of the float format
+     * (@see Render::ColorVertex), and the indices as 32 bits integers. The file is memory mapped when it's read,
+     * so loading a mesh is copying the blobs to the mesh, without parsing anything.
+     * The format is only meant to be read by the same engine that wrote it, for that reason the header stores the
+     * version of the format and the layout of the vertices, and the files that don't match are rejected.
+     */
+    class MeshFile {
+    public:
+        static constexpr char magic[4] = {'G', 'L', 'M', 'S'};
+        /**
+         * @brief Version of the format, it must be increased if the header or the layout of the blobs change.
+         */
+        static constexpr uint32_t version = 1;
+        static constexpr uint32_t maxAttributes = 4;
+        static constexpr const char* extension = ".glmesh";
+
+#pragma pack(push, 1)
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t vertexFormat;
+            uint32_t renderType;
+            /**
+             * @brief Bit 0: the mesh stores its faces.
+             */
+            uint32_t flags;
+            uint32_t vertexStride;
+            uint32_t attributeCount;
+            uint32_t attributeTypes[maxAttributes];
+            uint64_t vertexCount;
+            uint64_t indexCount;
+            float boundsMin[3];
+            float boundsMax[3];
+            /**
+             * @brief Hash of the vertex and index blobs, to detect truncated or corrupted files.
+             */
+            uint64_t contentHash;
+        };
+#pragma pack(pop)
+        static_assert(sizeof(Header) % alignof(Render::ColorVertex) == 0,
+                      "The vertices after the header must be aligned");
+
+        /**
+         * @brief Writes the mesh to the file, replacing it if it exists.
+         * @details The mesh is written to a temporary file that is renamed at the end, so a crash in the middle
+         * never leaves a half written file with the final name.
+         * @return True if the file was written.
+         */
+        static bool write(const std::string& path, const Render::ColorMesh& mesh);
+
+        /**
+         * @brief Reads a mesh written with write.
+         * @return The mesh, already built, or nothing if the file doesn't exist, is from another version of the
+         * format or is corrupted.
+         */
+        [[nodiscard]] static std::optional<Render::ColorMesh> read(const std::string& path);
+
+        /**
+         * @brief Reads only the header of the file, to know the size and bounds of the mesh without loading it.
+         */
+        [[nodiscard]] static std::optional<Header> readHeader(const std::string& path);
+
+    private:
+        static constexpr uint32_t storeFacesFlag = 1u << 0;
+
+        /**
+         * @brief Checks that the header was written by this version of the engine for a mesh of ColorVertex, and
+         * that the file has the size the header says.
+         */
+        [[nodiscard]] static bool isValid(const Header& header, size_t fileSize);
+    }; // class MeshFile
+} // namespace GLESC
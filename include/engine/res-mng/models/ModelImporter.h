@@ -0,0 +1,203 @@
+/**************************************************************************************************
+ * @file   ModelImporter.h
+ * @author Valentin Dumitru
+ * @date   2024-06-19
+ * @brief  Imports model files into engine meshes in background threads.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include "engine/core/threading/ThreadPool.h"
+#include "engine/res-mng/models/MeshCache.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+
+namespace GLESC {
+    /**
+     * @brief Converts the meshes of model files to ColorMesh and registers them in the mesh registry, without
+     * blocking the thread that requests them.
+     * @details The importer has its own worker threads. Reading a model is a task for one worker, with the
+     * Assimp::Importer of that worker (the importers are not thread safe, so they're never shared). When the model
+     * is read, the conversion of each of its meshes is a task for any worker, so the meshes of a big model are
+     * converted in parallel. Each mesh is registered as soon as it's converted, and its handle can be collected
+     * with collectImported, usually once per frame. The registry uploads the meshes from the render side as usual.
+     * If a cache is given, the meshes of a model are stored in it keyed by the content of the file, and the next
+     * imports of the same file load them from it without reading the model with Assimp.
+     */
+    class ModelImporter {
+    public:
+        /**
+         * @brief A mesh of a model that was imported.
+         */
+        struct ImportedMesh {
+            /**
+             * @brief The file of the model.
+             */
+            std::string path;
+            /**
+             * @brief The index of the mesh in the model.
+             */
+            size_t meshIndex = 0;
+            Render::MeshHandle mesh;
+        };
+
+        struct Stats {
+            /**
+             * @brief Models requested that aren't finished yet.
+             */
+            size_t pendingModels = 0;
+            size_t importedModels = 0;
+            /**
+             * @brief Models that were loaded from the cache instead of being read with Assimp.
+             */
+            size_t cachedModels = 0;
+            size_t failedModels = 0;
+            size_t importedMeshes = 0;
+            /**
+             * @brief Time spent reading models with Assimp, adding the time of every worker, in milliseconds.
+             */
+            double readMillis = 0.0;
+            /**
+             * @brief Time spent converting meshes, adding the time of every worker, in milliseconds.
+             */
+            double convertMillis = 0.0;
+        };
+
+        /**
+         * @brief Creates the importer and its workers.
+         * @param registryParam The registry where the meshes are registered.
+         * @param cacheParam The cache of the imported meshes, or nullptr to always read the models.
+         * @param workerCount The number of worker threads, 0 uses the number of hardware threads minus one (the
+         * thread of the frame loop).
+         */
+        explicit ModelImporter(Render::MeshRegistry& registryParam = Render::MeshRegistry::get(),
+                               MeshCache* cacheParam = &MeshCache::get(), size_t workerCount = 0);
+        /**
+         * @brief Stops the workers, the models that weren't read yet are not imported.
+         */
+        ~ModelImporter();
+
+        ModelImporter(const ModelImporter&) = delete;
+        ModelImporter& operator=(const ModelImporter&) = delete;
+
+        /**
+         * @brief Requests the import of a model, returns immediately.
+         * @param path The path of the model file.
+         */
+        void importModel(const std::string& path);
+
+        /**
+         * @brief Returns the meshes imported since the last call, without waiting for the pending ones.
+         */
+        [[nodiscard]] std::vector<ImportedMesh> collectImported();
+
+        /**
+         * @brief Blocks until every requested model has been imported.
+         */
+        void waitUntilIdle();
+        [[nodiscard]] bool isIdle() const;
+        [[nodiscard]] size_t getWorkerCount() const { return workers.size(); }
+        [[nodiscard]] Stats getStats() const;
+
+        /**
+         * @brief The post processing done by Assimp to every model, the meshes must be made of triangles.
+         */
+        [[nodiscard]] static unsigned int getImportFlags();
+        /**
+         * @brief Sets the properties of the post processing to an importer, it must be done before reading models.
+         * @details The meshes of points and lines are removed, they can't be converted and would keep the models
+         * out of the mesh cache.
+         */
+        static void configureImporter(Assimp::Importer& importer);
+
+        /**
+         * @brief Converts a mesh of Assimp to a ColorMesh, with its bounding volume computed.
+         * @details The color of the vertices is the first color set of the mesh, or the base color if it has none.
+         * The faces that aren't triangles (points and lines) are ignored.
+         * @param mesh The mesh to convert.
+         * @param baseColor The color of the material of the mesh.
+         * @return The mesh, or nothing if it has no triangles.
+         */
+        [[nodiscard]] static std::optional<Render::ColorMesh> convertMesh(
+            const aiMesh& mesh, const Render::ColorRgba& baseColor);
+
+        /**
+         * @brief Converts every mesh of the scene in parallel, in the threads of the pool.
+         * @return The meshes in the order of the scene, the ones without triangles are empty.
+         */
+        [[nodiscard]] static std::vector<std::optional<Render::ColorMesh>> convertScene(
+            const aiScene& scene, ThreadPool& pool);
+
+    private:
+        /**
+         * @brief A model read by a worker, shared by the tasks that convert its meshes.
+         */
+        struct ModelScene {
+            std::string path;
+            std::optional<MeshCache::Key> cacheKey;
+            std::unique_ptr<const aiScene> scene;
+            /**
+             * @brief The diffuse color of each material of the scene.
+             */
+            std::vector<Render::ColorRgba> materialColors;
+            /**
+             * @brief The handles of the converted meshes, to store them in the cache when all are converted.
+             */
+            std::vector<Render::MeshHandle> meshes;
+            std::atomic<size_t> remainingMeshes{0};
+            std::atomic<bool> allMeshesConverted{true};
+        };
+
+        /**
+         * @brief Reads the model of the path, or converts a mesh of the model if it is set.
+         */
+        struct Task {
+            std::string path;
+            std::shared_ptr<ModelScene> model;
+            size_t meshIndex = 0;
+        };
+
+        void workerLoop();
+        void readModel(Assimp::Importer& importer, const std::string& path);
+        void convertModelMesh(ModelScene& model, size_t meshIndex);
+        /**
+         * @brief Registers an imported mesh and makes it available to collectImported.
+         */
+        Render::MeshHandle publish(const std::string& path, size_t meshIndex, Render::ColorMesh&& mesh);
+        void finishModel(bool cached, bool failed);
+
+        [[nodiscard]] static MeshCache::Key getCacheKey(MeshCache::Key fileHash);
+        [[nodiscard]] static Render::ColorRgba getMaterialColor(const aiMaterial& material);
+
+        Render::MeshRegistry& registry;
+        MeshCache* cache;
+        std::vector<std::thread> workers;
+
+        mutable std::mutex mutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable idle;
+        /**
+         * @brief The tasks waiting for a worker. The conversions go to the front, so the models already read are
+         * finished before reading new ones, which keeps few scenes in memory.
+         */
+        std::deque<Task> tasks;
+        size_t runningTasks = 0;
+        bool stopping = false;
+        std::vector<ImportedMesh> imported;
+        Stats stats;
+    }; // class ModelImporter
+} // namespace GLESC
@@ -14,21 +14,24 @@
 #include <assimp/postprocess.h>
 
 #include "engine/core/asserts/Asserts.h"
+#include "engine/res-mng/models/ModelImporter.h"
 
 class ModelLoader {
 public:
+    /**
+     * @brief Reads a model with Assimp, in the calling thread.
+     * @details Each thread has its own importer, as the importers are not thread safe. The scene belongs to the
+     * importer of the thread, and is valid until the next model is loaded in the same thread. To convert the model
+     * to engine meshes without blocking, use ModelImporter.
+     */
     static const aiScene* loadModel(const std::string& path) {
-        const aiScene* scene = importer.ReadFile(path,
-                                                 aiProcess_Triangulate // Convert all the models to triangles
-                                                 | aiProcess_FlipUVs // OpenGL uses inverted UVs
-                                                 | aiProcess_GenNormals // Generate normals if they are missing
-                                                 | aiProcess_JoinIdenticalVertices // Join identical vertices/positions
-        );
+        thread_local Assimp::Importer importer;
+        // Setting the properties only stores them, it's cheap enough to do before every read
+        GLESC::ModelImporter::configureImporter(importer);
+        const aiScene* scene = importer.ReadFile(path, GLESC::ModelImporter::getImportFlags());
         D_ASSERT_NOT_NULLPTR(scene, "Failed to load model: " + path);
         D_ASSERT_FALSE(scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE, "Model is incomplete: " + path);
         D_ASSERT_NOT_NULLPTR(scene->mRootNode, "Model has no root node: " + path);
         return scene;
     }
-
-    static Assimp::Importer importer;
 }; // class ModelLoader
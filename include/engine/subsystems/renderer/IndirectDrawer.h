@@ -0,0 +1,180 @@
+/**************************************************************************************************
+ * @file   IndirectDrawer.h
+ * @author Valentin Dumitru
+ * @date   2024-06-21
+ * @brief  Draws the visible meshes with one multi draw indirect per vertex format and material.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/low-level-renderer/buffers/StreamingRing.h"
+#include "engine/core/low-level-renderer/graphic-api/IGraphicInterface.h"
+#include "engine/subsystems/renderer/RendererTypes.h"
+#include "engine/subsystems/renderer/material/Material.h"
+#include "engine/subsystems/renderer/mesh/MeshArena.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief Collects the draws of a frame and submits them with a multi draw indirect per group of draws that
+     * share the vertex format and the material, instead of binding a vertex array and drawing each mesh.
+     * @details The meshes are stored in the arenas of their vertex format (@see MeshArena). Each frame the draws
+     * are sorted by group, their commands are written to the indirect buffer and their matrices to the storage
+     * buffer of the draw parameters, bound at drawParamsBinding. The shader reads the parameters of a draw at the
+     * index uDrawOffset + gl_DrawID, where the offset is the first draw of the group.
+     *
+     * The commands, the parameters and the new meshes are written to a streaming ring (@see GAPI::StreamingRing),
+     * so the uploads of a frame don't wait for the GPU to finish the previous ones. If a frame doesn't fit in the
+     * ring, the commands and the parameters are uploaded reallocating their own buffers.
+     *
+     * The draws that can't be stored in an arena are rejected, the caller draws them on their own.
+     */
+    class IndirectDrawer {
+    public:
+        /**
+         * @brief The parameters of a draw, with the std430 layout of the storage buffer of the shader.
+         * @details The matrices are stored by columns, like the matrices of the uniforms. The columns of the
+         * normal matrix are aligned to 4 floats.
+         */
+        struct DrawParams {
+            float mvp[16];
+            float mv[16];
+            float normalMat[12];
+            float positionScale[4];
+            float positionOffset[4];
+        };
+
+        struct Stats {
+            size_t draws = 0;
+            size_t multiDraws = 0;
+            size_t triangles = 0;
+            /**
+             * @brief Bytes of commands and parameters written to the streaming ring.
+             */
+            size_t streamedBytes = 0;
+            /**
+             * @brief Times the CPU waited for the GPU to release the streaming ring, since the drawer was created.
+             */
+            size_t streamingStalls = 0;
+            /**
+             * @brief Draws that didn't fit in the arenas.
+             */
+            size_t rejectedDraws = 0;
+        };
+
+        /**
+         * @brief Prepares the shader for the draws of a group.
+         * @param material The material of the group.
+         * @param firstDraw The index of the parameters of the first draw of the group.
+         */
+        using GroupCallback = std::function<void(const Material& material, GAPI::UInt firstDraw)>;
+
+        static constexpr size_t defaultArenaVertices = 1 << 20;
+        static constexpr size_t defaultArenaIndices = 3 << 20;
+        static constexpr GAPI::Size defaultStreamingBytes = 8 << 20;
+        static constexpr GAPI::UInt drawParamsBinding = 0;
+
+        /**
+         * @brief Creates a drawer without buffers, they're created when the first frame is submitted.
+         * @param gapiParam The graphic interface used to draw.
+         * @param arenaVerticesParam The vertices of the arena of each vertex format.
+         * @param arenaIndicesParam The indices of the arena of each vertex format.
+         * @param streamingBytesParam The bytes of each frame in the streaming ring.
+         */
+        explicit IndirectDrawer(GAPI::IGraphicInterface& gapiParam,
+                                size_t arenaVerticesParam = defaultArenaVertices,
+                                size_t arenaIndicesParam = defaultArenaIndices,
+                                GAPI::Size streamingBytesParam = defaultStreamingBytes);
+        ~IndirectDrawer();
+        IndirectDrawer(const IndirectDrawer&) = delete;
+        IndirectDrawer& operator=(const IndirectDrawer&) = delete;
+
+        /**
+         * @brief Adds a draw to the frame, the mesh is uploaded to its arena if it isn't there yet.
+         * @return False if the mesh doesn't fit in its arena, the draw isn't added.
+         */
+        bool add(const MeshHandle& mesh, const Material& material, const MV& mv, const MVP& mvp,
+                 const NormalMat& normalMat);
+
+        /**
+         * @brief Draws the draws added since the last submit.
+         * @param prepareGroup Called before the multi draw of each group, to apply its material.
+         */
+        void submit(const GroupCallback& prepareGroup);
+
+        /**
+         * @brief Destroys the buffers, must be called before the graphic context is destroyed.
+         */
+        void destroyGpuBuffers();
+
+        /**
+         * @brief The counters of the last frame submitted.
+         */
+        [[nodiscard]] const Stats& getStats() const { return stats; }
+        /**
+         * @brief The parameters of the draws of the last frame submitted, in the order of the draws.
+         */
+        [[nodiscard]] const std::vector<DrawParams>& getDrawParams() const { return drawParams; }
+        [[nodiscard]] const MeshArena* getArena(VertexFormat format) const;
+        [[nodiscard]] const GAPI::StreamingRing& getStreamingRing() const { return streamingRing; }
+        /**
+         * @brief The alignment of the offsets of the storage buffers, 0 until the first frame is submitted.
+         */
+        [[nodiscard]] GAPI::Size getStorageBufferAlignment() const { return storageBufferAlignment; }
+
+        [[nodiscard]] static DrawParams createDrawParams(const MV& mv, const MVP& mvp, const NormalMat& normalMat,
+                                                         const VertexPacker::PositionDequantization& dequantization);
+
+    private:
+        struct PendingDraw {
+            MeshArena* arena;
+            const MeshArena::Range* range;
+            size_t materialGroup;
+            DrawParams params;
+        };
+
+        [[nodiscard]] MeshArena& getOrCreateArena(VertexFormat format);
+        /**
+         * @brief Writes the commands and the parameters of the frame to the GPU and binds them.
+         * @return The index of the first command in the bound indirect buffer.
+         */
+        [[nodiscard]] GAPI::UInt uploadDraws();
+
+        GAPI::IGraphicInterface& gapi;
+        size_t arenaVertices;
+        size_t arenaIndices;
+        /**
+         * @brief Declared before the arenas, they upload the meshes through it.
+         */
+        GAPI::StreamingRing streamingRing;
+        std::vector<std::unique_ptr<MeshArena>> arenas;
+
+        std::vector<PendingDraw> pendingDraws;
+        /**
+         * @brief The different materials of the frame, the draws reference them by index.
+         */
+        std::vector<Material> materials;
+        std::unordered_map<Material, size_t> materialGroups;
+        size_t rejectedDraws = 0;
+
+        std::vector<DrawParams> drawParams;
+        std::vector<GAPI::DrawElementsIndirectCommand> commands;
+        /**
+         * @brief The buffers used when a frame doesn't fit in the streaming ring.
+         */
+        GAPI::UInt drawParamsBuffer = 0;
+        GAPI::UInt commandBuffer = 0;
+        bool buffersCreated = false;
+        /**
+         * @brief Queried from the device when the first frame is uploaded, the context may not exist before.
+         */
+        GAPI::Size storageBufferAlignment = 0;
+        Stats stats;
+    }; // class IndirectDrawer
+} // namespace GLESC::Render
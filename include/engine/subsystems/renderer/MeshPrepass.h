@@ -0,0 +1,147 @@
+/**************************************************************************************************
+ * @file   MeshPrepass.h
+ * @author Valentin Dumitru
+ * @date   2024-06-02
+ * @brief  Per-mesh matrix and culling stage of the renderer.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/core/threading/ThreadPool.h"
+#include "engine/subsystems/renderer/RenderSnapshot.h"
+#include "engine/subsystems/renderer/RendererTypes.h"
+#include "engine/subsystems/renderer/math/Frustum.h"
+#include "engine/subsystems/transform/TransformStore.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief Computes, for every mesh of a frame, whether it is inside the frustum and the matrices needed to draw
+     * it.
+     * @details The visible meshes are found traversing the tree of mesh bounds, which rejects or accepts whole
+     * groups of meshes at once, the meshes in groups that intersect the frustum are then tested all together with
+     * the batch culling of the frustum. Then the interpolated transforms of the visible meshes are gathered into a
+     * structure of arrays and their matrices computed in batches, only for the visible meshes.
+     * The output arrays are resized to the number of meshes before the pass, and every mesh only writes to
+     * the slot of its own index. This makes the result independent of the order in which the meshes are processed,
+     * so the pass can be split among the threads of a pool without any lock. The matrices of the meshes that are
+     * not visible are left undefined.
+     * The pass also selects the level of detail of the visible meshes that have a chain of levels, by the size of
+     * their bounding sphere on the screen. The level of each object is kept between passes, keyed by its culling
+     * proxy, so the hysteresis of the chain can be applied.
+     * The pass does not touch the graphics API, so it can be executed without a context.
+     */
+    class MeshPrepass {
+    public:
+        /**
+         * @brief Runs the pass for all the meshes.
+         * @param meshes The meshes to process, it's only read.
+         * @param transforms The interpolated transforms of the frame, indexed by the transform handles of the meshes.
+         * @param meshBounds The bounds of the meshes, the user data of the proxies are indices into meshes.
+         * @param view The view matrix of the frame.
+         * @param projection The projection matrix of the frame, used to compute the screen size of the meshes.
+         * @param viewProjection The view projection matrix of the frame.
+         * @param frustum The frustum of the frame, must be already updated.
+         * @param workers The pool that executes the pass.
+         */
+        void run(const std::vector<MeshRenderData>& meshes,
+                 const Transform::TransformStore& transforms,
+                 const Math::AABBTree& meshBounds,
+                 const View& view,
+                 const Projection& projection,
+                 const VP& viewProjection,
+                 const Frustum& frustum,
+                 ThreadPool& workers);
+
+        /**
+         * @brief Empties the results of the pass.
+         */
+        void clear();
+
+        [[nodiscard]] size_t size() const { return mvs.size(); }
+        [[nodiscard]] const std::vector<MV>& getMVs() const { return mvs; }
+        [[nodiscard]] const std::vector<MVP>& getMVPs() const { return mvps; }
+        [[nodiscard]] const std::vector<NormalMat>& getNormalMats() const { return normalMats; }
+        [[nodiscard]] bool isVisible(size_t meshIndex) const { return visible[meshIndex] != 0; }
+        [[nodiscard]] size_t getVisibleCount() const { return visibleMeshes.size(); }
+        /**
+         * @brief Get the level of detail selected for a visible mesh, always 0 for the meshes without levels.
+         */
+        [[nodiscard]] size_t getLodLevel(size_t meshIndex) const { return lodLevels[meshIndex]; }
+        /**
+         * @brief Get the mesh selected to draw a visible mesh, its level of detail or the mesh itself.
+         */
+        [[nodiscard]] const ColorMesh& getDrawnMesh(const MeshRenderData& meshData, size_t meshIndex) const {
+            return getDrawnMeshHandle(meshData, meshIndex).get();
+        }
+        [[nodiscard]] const MeshHandle& getDrawnMeshHandle(const MeshRenderData& meshData, size_t meshIndex) const {
+            return meshData.lods ? meshData.lods->getLevel(lodLevels[meshIndex]).mesh : meshData.mesh;
+        }
+        /**
+         * @brief Get the counters of the traversal of the mesh bounds in the last pass, the deferred leaves are the
+         * meshes tested with the batch culling.
+         */
+        [[nodiscard]] const Math::AABBTree::QueryStats& getCullingStats() const { return cullingStats; }
+
+    private:
+        /**
+         * @brief Computes the matrices of the visible meshes [begin, end), writing the results in the slots of
+         * their mesh indices.
+         */
+        void processVisibleMeshes(size_t begin,
+                                  size_t end,
+                                  const std::vector<MeshRenderData>& meshes,
+                                  const Transform::TransformStore& transforms,
+                                  const View& view,
+                                  const VP& viewProjection,
+                                  float projectionScale);
+        /**
+         * @brief Selects the level of detail of a mesh with its matrices already computed.
+         */
+        void selectLod(size_t meshIndex, const MeshRenderData& meshData, const Transform::Scale& scale,
+                       float projectionScale);
+
+        std::vector<MV> mvs;
+        std::vector<MVP> mvps;
+        std::vector<NormalMat> normalMats;
+        /**
+         * @brief Bytes instead of bools, std::vector<bool> packs bits and concurrent writes to different indices
+         * would race.
+         */
+        std::vector<std::uint8_t> visible;
+        std::vector<std::uint8_t> lodLevels;
+        /**
+         * @brief The level of detail of an object in the last pass it was visible.
+         */
+        struct LodState {
+            /**
+             * @brief The chain the level belongs to, if the object changes of chain its level is selected again.
+             */
+            const MeshLodChain* chain = nullptr;
+            std::uint8_t level = 0;
+        };
+        /**
+         * @brief The level of detail of each object, indexed by the id of its culling proxy.
+         */
+        std::vector<LodState> lodStates;
+        /**
+         * @brief The indices of the visible meshes, in the order the traversal found them.
+         */
+        std::vector<size_t> visibleMeshes;
+        /**
+         * @brief The transforms of the visible meshes, in the order of visibleMeshes.
+         */
+        Transform::TransformStore visibleTransforms;
+        /**
+         * @brief The meshes whose group intersects the frustum, waiting for the batch culling.
+         */
+        AABBArrays candidateBounds;
+        std::vector<size_t> candidateMeshes;
+        std::vector<std::uint8_t> candidateVisible;
+        Math::AABBTree::QueryStats cullingStats;
+    }; // class MeshPrepass
+} // namespace GLESC::Render
@@ -0,0 +1,20 @@
+/**************************************************************************************************
+ * @file   RenderHandle.h
+ * @author Valentin Dumitru
+ * @date   2024-06-20
+ * @brief  The handle that identifies the objects of the renderer across updates.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include "engine/subsystems/transform/InterpolationStore.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief Identifies an object of the renderer across updates, like the id of its entity.
+     * @details It's the index of the transforms of the object in the snapshot.
+     */
+    using RenderHandle = Transform::InterpolationStore::Handle;
+} // namespace GLESC::Render
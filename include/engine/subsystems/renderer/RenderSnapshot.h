@@ -0,0 +1,225 @@
+/**************************************************************************************************
+ * @file   RenderSnapshot.h
+ * @author Valentin Dumitru
+ * @date   2024-06-04
+ * @brief  Immutable copy of everything the renderer needs to draw a frame.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "engine/core/math/geometry/AABBTree.h"
+#include "engine/subsystems/renderer/RenderHandle.h"
+#include "engine/subsystems/renderer/StaticBatcher.h"
+#include "engine/subsystems/renderer/camera/CameraPerspective.h"
+#include "engine/subsystems/renderer/fog/Fog.h"
+#include "engine/subsystems/renderer/lighting/GlobalAmbientLight.h"
+#include "engine/subsystems/renderer/lighting/GlobalSun.h"
+#include "engine/subsystems/renderer/lighting/LightPoint.h"
+#include "engine/subsystems/renderer/material/Material.h"
+#include "engine/subsystems/renderer/mesh/MeshLod.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+#include "engine/subsystems/transform/InterpolationStore.h"
+#include "engine/subsystems/transform/Transform.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief The data needed to draw a mesh.
+     * @details The material is a copy, the mesh is a handle to the shared mesh data, which keeps it alive while the
+     * snapshot can be rendered. The transforms are in the transforms of the snapshot.
+     */
+    struct MeshRenderData {
+        MeshHandle mesh;
+        Material material;
+        RenderHandle transformHandle = 0;
+        /**
+         * @brief The levels of detail of the mesh, or nullptr to always draw the mesh.
+         */
+        std::shared_ptr<const MeshLodChain> lods;
+        /**
+         * @brief The proxy of the mesh in the bounds, it identifies the object across snapshots.
+         */
+        Math::AABBTree::ProxyId cullingProxy = Math::AABBTree::nullNode;
+    };
+
+    /**
+     * @brief The data needed to render a light point.
+     */
+    struct LightRenderData {
+        LightPoint light;
+        RenderHandle transformHandle = 0;
+    };
+
+    /**
+     * @brief The data needed to create the view and projection matrices.
+     */
+    struct CameraRenderData {
+        CameraPerspective perspective;
+        Transform::Interpolator interpolator;
+    };
+
+    /**
+     * @brief The data needed to apply the global illumination.
+     */
+    struct SunRenderData {
+        GlobalSun sun;
+        GlobalAmbientLight ambientLight;
+    };
+
+    /**
+     * @brief Everything the renderer needs to draw a frame.
+     * @details It's filled by the update side of the renderer and then handed to the render side, which only reads
+     * it. As it doesn't point to any component, the update can keep modifying the components while the frame is being
+     * rendered.
+     */
+    struct RenderSnapshot {
+        std::vector<MeshRenderData> meshes;
+        /**
+         * @brief The last two transforms of the meshes and the lights, indexed by their handles.
+         */
+        Transform::InterpolationStore transforms;
+        /**
+         * @brief The world bounds of the meshes, the user data of each proxy is the index of its mesh in meshes.
+         * @details The bounds enclose the mesh in the last and the current transform of its interpolator, so they
+         * are valid for any time of the frame.
+         */
+        Math::AABBTree meshBounds;
+        /**
+         * @brief The version of the bounds of the renderer that meshBounds is a copy of, 0 if it was modified after
+         * the copy.
+         */
+        size_t meshBoundsVersion = 0;
+        /**
+         * @brief The clusters of the static meshes, shared by every snapshot until a static mesh changes.
+         */
+        std::shared_ptr<const StaticBatches> staticBatches;
+        std::vector<LightRenderData> lights;
+        CameraRenderData camera;
+        std::optional<SunRenderData> sun;
+        std::optional<Fog> fog;
+
+        /**
+         * @brief Empties the snapshot, the vectors keep their capacity so refilling doesn't allocate.
+         * @details The bounds of the meshes are kept with their version, so they're only copied again if they change.
+         */
+        void clear() {
+            meshes.clear();
+            transforms.clear();
+            staticBatches.reset();
+            lights.clear();
+            camera = CameraRenderData();
+            sun.reset();
+            fog.reset();
+        }
+
+        /**
+         * @brief Removes the meshes and the lights of an object, so they aren't drawn anymore.
+         * @details The last mesh takes the place of each removed one, and its proxy in the bounds is pointed to its
+         * new index.
+         * @param handle The handle the object was sent with.
+         */
+        void removeObject(RenderHandle handle) {
+            for (size_t meshIndex = 0; meshIndex < meshes.size();) {
+                if (meshes[meshIndex].transformHandle != handle) {
+                    meshIndex++;
+                    continue;
+                }
+                // The bounds are no longer a copy of the ones of the renderer
+                meshBoundsVersion = 0;
+                if (meshes[meshIndex].cullingProxy != Math::AABBTree::nullNode) {
+                    meshBounds.destroyProxy(meshes[meshIndex].cullingProxy);
+                }
+                if (meshIndex != meshes.size() - 1) {
+                    meshes[meshIndex] = std::move(meshes.back());
+                    if (meshes[meshIndex].cullingProxy != Math::AABBTree::nullNode) {
+                        meshBounds.setUserData(meshes[meshIndex].cullingProxy, meshIndex);
+                    }
+                }
+                meshes.pop_back();
+            }
+            const size_t lightCount = lights.size();
+            lights.erase(std::remove_if(lights.begin(), lights.end(), [handle](const LightRenderData& light) {
+                return light.transformHandle == handle;
+            }), lights.end());
+            // The uniforms of the lights are indexed by their position, which changed for the lights that moved
+            if (lights.size() != lightCount) {
+                for (const LightRenderData& light : lights) {
+                    light.light.isDirty() = true;
+                }
+            }
+        }
+
+        /**
+         * @brief Keeps the changes of the lights of a snapshot that is replaced before being rendered.
+         * @details The lights are only uploaded when they're dirty, and they're only dirty in the first snapshot
+         * after they change.
+         * @param skipped The snapshot that won't be rendered.
+         */
+        void keepDirtyLights(const RenderSnapshot& skipped) {
+            for (size_t lightIndex = 0; lightIndex < lights.size() && lightIndex < skipped.lights.size();
+                 lightIndex++) {
+                if (skipped.lights[lightIndex].light.isDirty()) lights[lightIndex].light.isDirty() = true;
+            }
+            if (sun && skipped.sun) {
+                if (skipped.sun->sun.isDirty()) sun->sun.setDirty();
+                if (skipped.sun->ambientLight.isDirty()) sun->ambientLight.isDirty() = true;
+            }
+        }
+    };
+
+    /**
+     * @brief Hands render snapshots from the update side to the render side.
+     * @details The update side fills its own snapshot and publishes it, the render side acquires the latest
+     * published snapshot at the start of each frame. The exchange swaps the snapshots instead of copying them, so
+     * each side always has a snapshot of its own and neither waits for the other more than the swap.
+     * If several snapshots are published before the render side acquires one, only the latest is kept.
+     */
+    class RenderSnapshotExchange {
+    public:
+        /**
+         * @brief Publishes the snapshot, it will be the next one acquired by the render side.
+         * @param written The snapshot filled by the update side. After the call it contains an old snapshot,
+         * which must be cleared before filling it again.
+         */
+        void publish(RenderSnapshot& written) {
+            std::lock_guard lock(mutex);
+            if (hasNewSnapshot) written.keepDirtyLights(ready);
+            std::swap(written, ready);
+            hasNewSnapshot = true;
+        }
+
+        /**
+         * @brief Takes the latest published snapshot, if any was published since the last call.
+         * @param reading The snapshot the render side reads from, it's only replaced if there is a new one.
+         * @return True if a new snapshot was acquired.
+         */
+        bool acquire(RenderSnapshot& reading) {
+            std::lock_guard lock(mutex);
+            if (!hasNewSnapshot) return false;
+            std::swap(reading, ready);
+            hasNewSnapshot = false;
+            return true;
+        }
+
+        /**
+         * @brief Removes an object from the published snapshot that wasn't acquired yet.
+         * @see RenderSnapshot::removeObject
+         */
+        void removeObject(RenderHandle handle) {
+            std::lock_guard lock(mutex);
+            ready.removeObject(handle);
+        }
+
+    private:
+        std::mutex mutex;
+        RenderSnapshot ready;
+        bool hasNewSnapshot = false;
+    }; // class RenderSnapshotExchange
+} // namespace GLESC::Render
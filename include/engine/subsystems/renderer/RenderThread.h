@@ -0,0 +1,122 @@
+/**************************************************************************************************
+ * @file   RenderThread.h
+ * @author Valentin Dumitru
+ * @date   2024-06-04
+ * @brief  Thread that owns the graphics context and renders the frames.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <SDL2/SDL.h>
+
+namespace GLESC::Render {
+    /**
+     * @brief Runs the rendering of the frames in its own thread, so the update of the next frame can be executed
+     * while the current one is being sent to the GPU.
+     * @details The graphics context can only be current in one thread, while the render thread runs it's current
+     * in the render thread. Work of other threads that needs the context, or that modifies data the render thread
+     * reads (for example destroying meshes), must be done inside an ExclusiveAccess scope.
+     *
+     * If the thread is not started every method is a no-op, so the engine can run single-threaded with the same
+     * code.
+     */
+    class RenderThread {
+    public:
+        /**
+         * @brief The function that renders a frame, receives the time of the frame in fraction.
+         */
+        using FrameFunction = std::function<void(double timeOfFrame)>;
+
+        /**
+         * @brief Gives the calling thread exclusive access to the context and the data read by the render thread.
+         * @details Waits until the render thread finishes the frame it is rendering, then the render thread gives
+         * the context to the calling thread and waits until the scope ends.
+         * The scopes can be nested in the same thread, only the outermost one pauses and resumes the render thread.
+         */
+        class ExclusiveAccess {
+        public:
+            explicit ExclusiveAccess(RenderThread& renderThreadParam);
+            ~ExclusiveAccess();
+
+            ExclusiveAccess(const ExclusiveAccess&) = delete;
+            ExclusiveAccess& operator=(const ExclusiveAccess&) = delete;
+
+        private:
+            RenderThread& renderThread;
+            bool acquired = false;
+        }; // class ExclusiveAccess
+
+        RenderThread(SDL_Window& windowParam, FrameFunction renderFrameParam);
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        /**
+         * @brief Starts the render thread, the context is moved from the calling thread to the render thread.
+         */
+        void start();
+        /**
+         * @brief Stops the render thread after the frame it is rendering, the context is moved back to the calling
+         * thread.
+         */
+        void stop();
+
+        [[nodiscard]] bool isRunning() const { return running; }
+
+        /**
+         * @brief Asks the render thread to render a frame, it doesn't wait for the frame to be rendered.
+         * @details If the render thread is still busy with the previous frame the requests are merged, only the
+         * time of the last one is used. If the render thread failed, its exception is rethrown here.
+         * @param timeOfFrame The time of the frame in fraction, used for interpolation.
+         */
+        void requestFrame(double timeOfFrame);
+
+    private:
+        /**
+         * @brief Main loop of the render thread.
+         */
+        void renderLoop();
+
+        /**
+         * @brief Waits until the render thread gives up the context, then makes it current in the calling thread.
+         */
+        void pause();
+        /**
+         * @brief Gives the context back to the render thread and wakes it up.
+         */
+        void resume();
+
+        /**
+         * @brief Rethrows the exception of the render thread, if it failed.
+         */
+        void rethrowRenderException();
+
+        SDL_Window& window;
+        FrameFunction renderFrame;
+        std::thread thread;
+        bool running = false;
+
+        std::mutex mutex;
+        std::condition_variable renderThreadWakeUp;
+        std::condition_variable renderThreadParked;
+
+        bool frameRequested = false;
+        double requestedTimeOfFrame = 0.0;
+        bool pauseRequested = false;
+        bool parked = false;
+        bool stopping = false;
+        std::exception_ptr renderException = nullptr;
+        /**
+         * @brief Number of nested ExclusiveAccess scopes alive, only used by the thread that opens them.
+         */
+        int exclusiveAccessDepth = 0;
+    }; // class RenderThread
+} // namespace GLESC::Render
@@ -11,14 +11,17 @@
 #pragma once
 
 
-#include <mutex>
-
 #include "engine/core/counter/Counter.h"
+#include "engine/core/threading/ThreadPool.h"
 #include "engine/core/low-level-renderer/shader/Shader.h"
 #include "engine/core/window/WindowManager.h"
 
+#include "engine/subsystems/renderer/IndirectDrawer.h"
+#include "engine/subsystems/renderer/MeshPrepass.h"
+#include "engine/subsystems/renderer/RenderSnapshot.h"
 #include "engine/subsystems/renderer/RendererTypes.h"
 #include "engine/subsystems/renderer/Skybox.h"
+#include "engine/subsystems/renderer/StaticBatcher.h"
 #include "engine/subsystems/renderer/camera/CameraPerspective.h"
 #include "engine/subsystems/renderer/fog/Fog.h"
 #include "engine/subsystems/renderer/lighting/GlobalAmbientLight.h"
@@ -27,6 +30,8 @@
 #include "engine/subsystems/renderer/material/Material.h"
 #include "engine/subsystems/renderer/math/Frustum.h"
 #include "engine/subsystems/renderer/mesh/Mesh.h"
+#include "engine/subsystems/renderer/mesh/MeshLod.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
 #include "engine/subsystems/transform/Transform.h"
 
 class MeshRenderingTest;
@@ -41,30 +46,15 @@ namespace GLESC::Render {
      * it.
      *
      * @details The public methods are the update side of the renderer (with some exceptions).
-     * It must be executed in the update loop of the engine.
+     * It must be executed in the update loop of the engine. It copies the data it receives into a render snapshot,
+     * which is handed to the render side with publishSnapshot().
      * While the private methods are the render side of the renderer. It must be executed in the render loop of the
-     * engine.
+     * engine, which can run in its own thread. It only reads the last snapshot it acquired.
      */
     class Renderer {
         friend class GLESC::Engine;
         friend class ::MeshRenderingTest;
 
-        struct Camera {
-            const CameraPerspective* camera = nullptr;
-            const Transform::Transform* transform = nullptr;
-        };
-
-        struct Sun {
-            const GlobalSun* sun = nullptr;
-            const GlobalAmbientLight* ambientLight = nullptr;
-            const Transform::Transform* transform = nullptr;
-        };
-
-        struct FogData {
-            const Fog* fog = nullptr;
-            const Transform::Transform* transform = nullptr;
-        };
-
     public:
         explicit Renderer(WindowManager& windowManager);
         ~Renderer();
@@ -76,39 +66,80 @@ namespace GLESC::Render {
         void setProjection(const Projection& projectionParam) { this->projection = projectionParam; }
 
         [[nodiscard]] const VP& getViewProjection() const { return viewProjection; }
-        bool hasRenderBeenCalledThisFrame() const { return hasRenderBeenCalled; }
-        void setRendererUpdated() { hasRenderBeenCalled = false; }
 
         [[nodiscard]] WindowDimensions getViewportSize() const { return windowManager.getSize(); }
-        [[nodiscard]] Camera getCamera() const { return this->camera; }
 
 
         [[nodiscard]] Shader& getDefaultShader() { return shader; }
         [[nodiscard]] Frustum& getFrustum() { return frustum; }
         [[nodiscard]] const Frustum& getFrustum() const { return frustum; }
         [[nodiscard]] float getMeshRenderCount() const { return drawCounter.getCount(); }
+        /**
+         * @brief Get the number of triangles submitted to the GPU in the last frame rendered, after the culling and
+         * the selection of the levels of detail.
+         */
+        [[nodiscard]] float getTriangleRenderCount() const { return triangleCounter.getCount(); }
+        /**
+         * @brief Get the counters of the frustum culling of the last frame rendered.
+         */
+        [[nodiscard]] const Math::AABBTree::QueryStats& getCullingStats() const {
+            return meshPrepass.getCullingStats();
+        }
+        /**
+         * @brief Get the number of meshes that passed the frustum culling in the last frame rendered.
+         */
+        [[nodiscard]] size_t getVisibleMeshCount() const { return meshPrepass.getVisibleCount(); }
+        /**
+         * @brief Get the counters of the static batches, of the update side.
+         */
+        [[nodiscard]] StaticBatcher::Stats getStaticBatchStats() const { return staticBatcher.getStats(); }
+        /**
+         * @brief Get the number of static clusters that passed the frustum culling in the last frame rendered.
+         */
+        [[nodiscard]] size_t getVisibleStaticClusterCount() const { return visibleStaticClusters; }
+        /**
+         * @brief Get the counters of the multi draw indirect of the last frame rendered.
+         */
+        [[nodiscard]] const IndirectDrawer::Stats& getIndirectDrawStats() const { return indirectDrawer.getStats(); }
+        /**
+         * @brief Enables or disables the multi draw indirect, when disabled each mesh is drawn with its own call.
+         */
+        void setIndirectDrawing(bool enabled) { indirectDrawing = enabled; }
+        [[nodiscard]] bool isIndirectDrawing() const { return indirectDrawing; }
 
 
         /**
-         * @brief This will remove the mesh and transform from the renderer data structures.
-         * @param mesh
-         * @param transform
+         * @brief This will remove the object and its transform from the renderer data structures.
+         * @details It's also removed from the snapshots already published, so it isn't drawn in the next frames.
+         * While the render thread runs, it must be called inside a RenderThread::ExclusiveAccess scope.
+         * @param handle The handle the object was sent with, the id of its entity.
          */
-        void remove(const ColorMesh& mesh, const Transform::Transform& transform);
+        void remove(RenderHandle handle);
 
         /**
          * @brief This sends the light point reference to the renderer so it can be rendered.
+         * @param handle Identifies the light across updates to interpolate its transform, like the id of its entity.
          * @param LightPoint
          * @param transform
          */
-        void sendLightPoint(const LightPoint& LightPoint, const Transform::Transform& transform);
+        void sendLightPoint(RenderHandle handle, const LightPoint& LightPoint, const Transform::Transform& transform);
         /**
          * @brief This sends the mesh data to the renderer so it can be rendered.
+         * @details The snapshot keeps a handle to the mesh, so the mesh is alive until the frame is rendered even
+         * if the entity is destroyed meanwhile.
+         * The meshes with RenderType::BatchedStatic are merged with the other static meshes instead of being drawn
+         * on their own (@see StaticBatcher), they're rebuilt only if the mesh, the material or the transform
+         * change, so they should be objects that don't move.
+         * @param handle Identifies the mesh across updates to interpolate its transform, like the id of its entity.
          * @param mesh
          * @param material
          * @param transform
+         * @param lods The levels of detail of the mesh, the level 0 must be the mesh. If it's nullptr the mesh is
+         * always drawn.
          */
-        void sendMeshData(const ColorMesh& mesh, const Material& material, const Transform::Transform& transform);
+        void sendMeshData(RenderHandle handle, const MeshHandle& mesh, const Material& material,
+                          const Transform::Transform& transform,
+                          const std::shared_ptr<const MeshLodChain>& lods = nullptr);
         /**
          * @brief This sets the camera for the renderer.
          * @param cameraPerspective
@@ -119,15 +150,13 @@ namespace GLESC::Render {
          * @brief This sets the sun for the renderer.
          * @param sun
          * @param ambientLight
-         * @param transform
          */
-        void setSun(const GlobalSun& sun, const GlobalAmbientLight& ambientLight, const Transform::Transform& transform);
+        void setSun(const GlobalSun& sun, const GlobalAmbientLight& ambientLight);
         /**
          * @brief This seets the fog for the renderer.
          * @param fogParam
-         * @param transform
          */
-        void setFog(const Fog& fogParam, const Transform::Transform& transform);
+        void setFog(const Fog& fogParam);
 
         /**
          * @brief This empties all the data from the renderer. Nothing will be rendered.
@@ -137,6 +166,14 @@ namespace GLESC::Render {
          * @brief This empties all the light data from the renderer. No lights will be rendered.
          */
         void clearLightData();
+
+        /**
+         * @brief This hands all the data sent during the update to the render side.
+         * @details Must be called once all the data of the update has been sent. The next frame rendered will use
+         * it. After the call, the update side starts with an empty snapshot, so the data must be sent again
+         * every update.
+         */
+        void publishSnapshot();
     private:
         /**
          * @brief This starts the frame of rendering
@@ -163,12 +200,10 @@ namespace GLESC::Render {
         /**
          * @brief This encapsulates the rendering of the lights, setting the uniforms
          * @param lights
-         * @param lightTransforms
-         * @param timeOfFrame
+         * @param transforms The interpolated transforms of the frame, indexed by the handles of the lights
          */
-        void renderLights(const std::vector<const LightPoint*>& lights,
-                          const std::vector<const Transform::Transform*>& lightTransforms,
-                          double timeOfFrame) const;
+        void renderLights(const std::vector<LightRenderData>& lights,
+                          const Transform::TransformStore& transforms) const;
         /**
          * @brief This encapsulates the setting of transforms of the transforms of a mesh
          * @param MVMat The model view matrix
@@ -186,7 +221,7 @@ namespace GLESC::Render {
          * @param fogParam
          * @param cameraPosition
          */
-        static void applyFog(const FogData& fogParam, const Position& cameraPosition);
+        static void applyFog(const std::optional<Fog>& fogParam, const Position& cameraPosition);
         /**
          * @brief This encapsulates the application of the skybox, calling the skybox draw method
          * @param skyboxParam
@@ -198,7 +233,7 @@ namespace GLESC::Render {
          * @brief This encapsulates the application of the sun, setting the uniforms
          * @param sunParam
          */
-        static void applySun(const Sun& sunParam);
+        static void applySun(const std::optional<SunRenderData>& sunParam);
         /**
          * @brief This encapsulates the application of the material, setting all the uniforms of the material
          * shader
@@ -212,6 +247,18 @@ namespace GLESC::Render {
          * @param mesh
          */
         static void renderMesh(const ColorMesh& mesh);
+        /**
+         * @brief Draws the static clusters that are inside the frustum.
+         * @param batches The clusters of the snapshot.
+         * @param frameView The view matrix of the frame, the clusters are already in world space.
+         * @param frameViewProjection The view projection matrix of the frame.
+         */
+        void renderStaticBatches(const StaticBatches& batches, const View& frameView, const VP& frameViewProjection);
+        /**
+         * @brief Draws the meshes added to the indirect drawer in this frame, one call per group.
+         * @param frameView The view matrix of the frame, the same for every draw.
+         */
+        void submitIndirectDraws(const View& frameView);
         static void renderInstances(MeshIndex adaptedInstances);
 
         /**
@@ -227,51 +274,140 @@ namespace GLESC::Render {
          */
         static View createViewMatrix(const Transform::Transform& transform);
 
+        /**
+         * @brief Adds the mesh to the snapshot being filled and updates its bounds in the culling tree.
+         * @param handle
+         * @param mesh
+         * @param material
+         * @param transform
+         * @param lods The levels of detail of the mesh, or nullptr.
+         */
+        void pushMeshRenderData(RenderHandle handle, const MeshHandle& mesh, const Material& material,
+                                const Transform::Transform& transform,
+                                const std::shared_ptr<const MeshLodChain>& lods);
+        /**
+         * @brief Creates or moves the proxy of the mesh in the culling tree.
+         * @details The world bounds are only recomputed if the transform or the mesh bounds changed in this update
+         * or in the previous one (the bounds enclose both).
+         * @param handle
+         * @param mesh
+         * @param transform
+         * @param meshIndex The index of the mesh in the snapshot being filled.
+         * @return The id of the proxy of the mesh.
+         */
+        Math::AABBTree::ProxyId updateCullingProxy(RenderHandle handle, const ColorMesh& mesh,
+                                                   const Transform::Transform& transform, size_t meshIndex);
+        /**
+         * @brief Destroys the proxies of the meshes that weren't sent in this update.
+         */
+        void removeStaleCullingProxies();
+
         WindowManager& windowManager;
 
-        std::vector<const ColorMesh*> meshesToRender;
-        std::vector<const Material*> meshMaterials;
-        std::vector<const Transform::Transform*> meshTransforms;
+        // ---------------------------------------------- Update side ----------------------------------------------
+
+        /**
+         * @brief The snapshot being filled by the update side.
+         */
+        RenderSnapshot updateSnapshot;
 
         std::unordered_map<const ColorMesh*, std::vector<MeshTransformIndex>> instances;
 
-        std::vector<const LightPoint*> lights;
-        std::vector<const Transform::Transform*> lightTransforms;
+        /**
+         * @brief The last two transforms of the meshes and the lights, indexed by their handles.
+         * @details Only used by the update side, the snapshot receives a copy of it when it's published.
+         */
+        Transform::InterpolationStore interpolations;
+        /**
+         * @brief The camera keeps its Euler angles, which its view matrix is built from.
+         */
+        Transform::Interpolator cameraInterpolator;
+
+        /**
+         * @brief The proxy of a mesh in the culling tree, with what its bounds were computed from.
+         */
+        struct CullingProxy {
+            Math::AABBTree::ProxyId proxyId = Math::AABBTree::nullNode;
+            /**
+             * @brief The world bounds of the mesh with the transform of the last update.
+             */
+            Math::BoundingVolume::AABB bounds;
+            Math::BoundingVolume::AABB meshBounds;
+            Transform::Position position;
+            Transform::Rotation rotation;
+            Transform::Scale scale;
+            /**
+             * @brief If the transform changed in the last update, the bounds enclose the previous transform too.
+             */
+            bool moved = false;
+            size_t lastUpdateSent = 0;
+        };
+
+        /**
+         * @brief The bounds of the meshes, maintained incrementally across updates and copied to each snapshot.
+         */
+        Math::AABBTree meshBoundsTree;
+        /**
+         * @brief Incremented each time meshBoundsTree changes, the snapshots with the same version have the same tree.
+         */
+        size_t meshBoundsVersion = 1;
+        /**
+         * @brief The proxies of the meshes indexed by their handles, the ones without a proxy id are unused.
+         */
+        std::vector<CullingProxy> cullingProxies;
+        /**
+         * @brief Merges the static meshes sent in the updates into the clusters of the snapshots.
+         */
+        StaticBatcher staticBatcher;
+        /**
+         * @brief Number of snapshots published, used to find the meshes that weren't sent in an update.
+         */
+        size_t updateNumber = 0;
 
         /**
-         * @brief This is the interpolation data structure. It stores the interpolation data for each transform.
+         * @brief Hands the snapshots from the update side to the render side.
          */
-        std::unordered_map<const Transform::Transform*, Transform::Interpolator> interpolationTransforms;
+        RenderSnapshotExchange snapshotExchange;
 
-        std::vector<MVP> mvps;
-        std::vector<MV> mvs;
-        std::vector<NormalMat> normalMats;
-        std::vector<bool> isContainedInFrustum;
+        // ---------------------------------------------- Render side ----------------------------------------------
 
-        bool hasRenderBeenCalled = false;
+        /**
+         * @brief The snapshot being rendered, acquired at the start of each frame.
+         */
+        RenderSnapshot renderSnapshot;
+        /**
+         * @brief The transforms of the snapshot interpolated at the time of the frame, indexed by handle.
+         */
+        Transform::TransformStore interpolatedTransforms;
 
+        /**
+         * @brief Computes the matrices and the frustum test of every mesh, indexed like the meshes of the snapshot.
+         */
+        MeshPrepass meshPrepass;
+        /**
+         * @brief The result of the frustum culling of the static clusters, indexed like the clusters.
+         */
+        std::vector<std::uint8_t> staticClusterVisible;
+        size_t visibleStaticClusters = 0;
+        /**
+         * @brief Draws the visible meshes that fit in its arenas with the multi draw indirect.
+         */
+        IndirectDrawer indirectDrawer;
+        bool indirectDrawing = true;
+        /**
+         * @brief The worker threads that execute the per-mesh stage of the rendering.
+         */
+        ThreadPool renderWorkers;
 
         Shader shader;
-        CameraPerspective defaultCameraPerspective;
-        Transform::Transform defaultCameraTransform;
         Skybox skybox;
-        FogData fog;
-        Sun sun;
-        GlobalAmbientLight ambientLight;
 
-        Camera camera;
         Projection projection;
         View view;
         VP viewProjection;
         Frustum frustum;
 
         static Counter drawCounter;
-
-
-        mutable std::mutex interpolationMutex{};
-        mutable std::mutex mvpMutex{};
-        mutable std::mutex mvMutex{};
-        mutable std::mutex normalMatMutex{};
-        mutable std::mutex frustumMutex{};
+        static Counter triangleCounter;
     }; // class Renderer
 } // namespace GLESC
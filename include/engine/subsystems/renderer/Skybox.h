@@ -59,6 +59,5 @@ namespace GLESC::Render {
 
         std::unique_ptr<VertexArray> skyboxVAO;
         std::unique_ptr<VertexBuffer> skyboxVBO;
-        float skyboxVertices[108];
     }; // class Skybox
 }
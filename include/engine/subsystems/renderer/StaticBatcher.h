@@ -0,0 +1,184 @@
+/**************************************************************************************************
+ * @file   StaticBatcher.h
+ * @author Valentin Dumitru
+ * @date   2024-06-20
+ * @brief  Merges the static meshes into big world space meshes grouped by material and region.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/subsystems/renderer/RenderHandle.h"
+#include "engine/subsystems/renderer/RendererTypes.h"
+#include "engine/subsystems/renderer/material/Material.h"
+#include "engine/subsystems/renderer/math/Frustum.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+#include "engine/subsystems/transform/Transform.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief A group of static meshes merged into a single mesh, drawn with one call.
+     */
+    struct StaticCluster {
+        /**
+         * @brief The merged mesh, its vertices are in world space so it's drawn without model matrix.
+         */
+        MeshHandle mesh;
+        Material material;
+        /**
+         * @brief The number of objects merged in the cluster.
+         */
+        size_t objectCount = 0;
+    };
+
+    /**
+     * @brief The clusters of the static meshes of a scene, immutable once built.
+     */
+    struct StaticBatches {
+        std::vector<StaticCluster> clusters;
+        /**
+         * @brief The world bounds of the clusters, in the same order, ready for the batch culling of the frustum.
+         */
+        AABBArrays bounds;
+    };
+
+    /**
+     * @brief Bakes the meshes that never move into a few big meshes, so the static parts of the scene (trees,
+     * bushes, terrain chunks...) are drawn with one call per visible cluster instead of one per object.
+     * @details The update side submits the static meshes every update, like the dynamic ones. The batcher keeps the
+     * objects between updates and compares them with the submitted ones; only when an object is added, removed,
+     * moved or changes of mesh or material the clusters are rebuilt.
+     *
+     * The objects are grouped by material and by the cell of a regular grid where the center of their bounds is,
+     * so the clusters are spatially compact and can be culled. Each group is split in clusters of a maximum number
+     * of vertices. Only the groups affected by a change are rebuilt, the others keep their clusters.
+     *
+     * The vertices are transformed to world space when they're baked, the clusters are registered in the mesh
+     * registry, which uploads them from the render side and releases them when no snapshot uses them anymore.
+     */
+    class StaticBatcher {
+    public:
+        struct Stats {
+            size_t objects = 0;
+            size_t clusters = 0;
+            size_t vertices = 0;
+            /**
+             * @brief Number of times a group of objects was rebuilt.
+             */
+            size_t rebuiltGroups = 0;
+            double rebuildMillis = 0.0;
+        };
+
+        static constexpr float defaultCellSize = 64.0f;
+        static constexpr size_t defaultMaxClusterVertices = 65536;
+
+        /**
+         * @brief Creates an empty batcher.
+         * @param registryParam The registry where the clusters are registered.
+         * @param cellSizeParam The size of the cells of the grid that groups the objects.
+         * @param maxClusterVerticesParam The maximum number of vertices of a cluster, unless a single object has
+         * more.
+         */
+        explicit StaticBatcher(MeshRegistry& registryParam = MeshRegistry::get(),
+                               float cellSizeParam = defaultCellSize,
+                               size_t maxClusterVerticesParam = defaultMaxClusterVertices);
+
+        /**
+         * @brief Submits a static mesh for the current update.
+         * @param handle The handle of the object, it identifies the object between updates.
+         * @param mesh The mesh, in the space of the object.
+         * @param material The material of the mesh.
+         * @param transform The transform of the object.
+         */
+        void submit(RenderHandle handle, const MeshHandle& mesh, const Material& material,
+                    const Transform::Transform& transform);
+
+        /**
+         * @brief Removes an object before the end of the update, if it's static.
+         */
+        void remove(RenderHandle handle);
+
+        /**
+         * @brief Ends the update, the objects that weren't submitted are removed and the changed groups rebuilt.
+         * @return The clusters of all the static objects, the same pointer as in the last update if nothing changed.
+         */
+        std::shared_ptr<const StaticBatches> finishUpdate();
+
+        [[nodiscard]] const std::shared_ptr<const StaticBatches>& getBatches() const { return batches; }
+        [[nodiscard]] Stats getStats() const { return stats; }
+
+        /**
+         * @brief Transforms the vertices of a mesh to world space.
+         * @param mesh The mesh to bake.
+         * @param model The model matrix of the object.
+         * @param vertices The vertices where the baked vertices are appended.
+         * @param indices The indices where the triangles are appended, rebased to the appended vertices.
+         */
+        static void bake(const ColorMesh& mesh, const Model& model,
+                         std::vector<ColorVertex>& vertices, std::vector<ColorMesh::Index>& indices);
+
+    private:
+        /**
+         * @brief The cell of the grid and the material, the objects with the same key are merged together.
+         */
+        struct GroupKey {
+            Material material;
+            int cellX = 0;
+            int cellY = 0;
+            int cellZ = 0;
+
+            bool operator==(const GroupKey& other) const {
+                return cellX == other.cellX && cellY == other.cellY && cellZ == other.cellZ &&
+                    material == other.material;
+            }
+        };
+
+        struct GroupKeyHash {
+            size_t operator()(const GroupKey& key) const;
+        };
+
+        struct StaticObject {
+            MeshHandle mesh;
+            Material material;
+            Transform::Position position;
+            Transform::Rotation rotation;
+            Transform::Scale scale;
+            Model model;
+            GroupKey group;
+            size_t lastUpdateSent = 0;
+        };
+
+        struct Group {
+            std::vector<RenderHandle> objects;
+            std::vector<StaticCluster> clusters;
+            std::vector<Math::BoundingVolume::AABB> clusterBounds;
+            bool dirty = false;
+        };
+
+        [[nodiscard]] GroupKey getGroupKey(const StaticObject& object) const;
+        void addToGroup(RenderHandle handle, const StaticObject& object);
+        void removeFromGroup(RenderHandle handle, const StaticObject& object);
+        void rebuildGroup(Group& group);
+        void rebuildBatches();
+
+        MeshRegistry& registry;
+        float cellSize;
+        size_t maxClusterVertices;
+
+        std::unordered_map<RenderHandle, StaticObject> objects;
+        std::unordered_map<GroupKey, Group, GroupKeyHash> groups;
+        std::shared_ptr<const StaticBatches> batches;
+        /**
+         * @brief If any group changed since the batches were built.
+         */
+        bool changed = false;
+        size_t updateNumber = 0;
+        Stats stats;
+    }; // class StaticBatcher
+} // namespace GLESC::Render
@@ -9,11 +9,68 @@
  **************************************************************************************************/
 #pragma once
 
+#include "engine/core/math/geometry/AABBTree.h"
 #include "engine/core/math/geometry/figures/polyhedron/Polyhedron.h"
 #include "../../../core/math/geometry/figures/BoundingVolume.h"
 #include "engine/subsystems/renderer/RendererTypes.h"
 
 namespace GLESC::Render {
+    /**
+     * @brief Bounding boxes stored as a structure of arrays, the layout read by the batch culling of the frustum.
+     * @details Each component of the corners has its own array, so consecutive boxes can be loaded into SIMD
+     * registers without shuffling.
+     */
+    struct AABBArrays {
+        std::vector<float> minX;
+        std::vector<float> minY;
+        std::vector<float> minZ;
+        std::vector<float> maxX;
+        std::vector<float> maxY;
+        std::vector<float> maxZ;
+
+        void push_back(const Math::BoundingVolume::AABB& aabb) {
+            minX.push_back(aabb.min.getX());
+            minY.push_back(aabb.min.getY());
+            minZ.push_back(aabb.min.getZ());
+            maxX.push_back(aabb.max.getX());
+            maxY.push_back(aabb.max.getY());
+            maxZ.push_back(aabb.max.getZ());
+        }
+
+        void reserve(size_t count) {
+            for (std::vector<float>* component : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+                component->reserve(count);
+            }
+        }
+
+        void clear() {
+            for (std::vector<float>* component : {&minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+                component->clear();
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return minX.size(); }
+        [[nodiscard]] bool empty() const { return minX.empty(); }
+    };
+
+    /**
+     * @brief The implementations of the batch culling, they all give the same result.
+     */
+    enum class CullingKernel {
+        /**
+         * @brief One box at a time, available everywhere.
+         */
+        Scalar,
+        /**
+         * @brief Four boxes at a time with SSE, available in all the x86-64 processors.
+         */
+        SSE,
+        /**
+         * @brief Eight boxes at a time with AVX2, checked at runtime.
+         */
+        AVX2
+    };
+
     class Frustum {
     public:
         Frustum() = delete;
@@ -52,6 +109,54 @@ namespace GLESC::Render {
 
         [[nodiscard]] bool contains(const Position& position) const;
 
+        /**
+         * @brief Mask with a bit for each plane, used by classify to skip the planes already passed.
+         */
+        using PlaneMask = std::uint8_t;
+        static constexpr PlaneMask allPlanes = 0b111111;
+
+        /**
+         * @brief Classifies a bounding box as outside, intersecting or inside the frustum.
+         * @details Only the planes whose bit is set in the mask are tested. Per plane only two corners are tested:
+         * the corner furthest along the normal (if it's outside the box is outside) and the nearest one (if it's
+         * inside the box is inside that plane). The planes the box is inside of are removed from the mask, so
+         * the boxes enclosed by this one don't need to test them again.
+         *
+         * @param aabb The bounding box to classify.
+         * @param planeMask The planes to test, the planes that contain the box are removed.
+         * @return Inside if the box is inside all the planes, Outside if it's outside any plane, Intersecting if not.
+         */
+        [[nodiscard]] Math::Containment classify(const Math::BoundingVolume::AABB& aabb, PlaneMask& planeMask) const;
+
+        /**
+         * @brief Tests many bounding boxes against the frustum, with the fastest kernel the processor supports.
+         * @details The result for each box is the same as contains(), a box is culled only if all its corners are
+         * outside one of the planes.
+         * @param boxes The boxes to test.
+         * @param visibleOut Receives 1 for each box that is not culled and 0 for the rest, must have the size of
+         * boxes.
+         */
+        void cullAABBs(const AABBArrays& boxes, std::uint8_t* visibleOut) const;
+        /**
+         * @brief Same as cullAABBs but with a chosen kernel, which must be supported.
+         */
+        void cullAABBs(const AABBArrays& boxes, std::uint8_t* visibleOut, CullingKernel kernel) const;
+        /**
+         * @brief Tests an array of boxes stored one after the other.
+         * @details The boxes are copied to a structure of arrays in small chunks, prefer the other overload if the
+         * boxes can be stored that way from the start.
+         * @param boxes The boxes to test.
+         * @param count The number of boxes.
+         * @param visibleOut Receives 1 for each box that is not culled and 0 for the rest, must have count elements.
+         */
+        void cullAABBs(const Math::BoundingVolume::AABB* boxes, size_t count, std::uint8_t* visibleOut) const;
+
+        /**
+         * @brief Get the fastest kernel supported by the processor, it's detected once.
+         */
+        [[nodiscard]] static CullingKernel getBestCullingKernel();
+        [[nodiscard]] static bool isCullingKernelSupported(CullingKernel kernel);
+
     private:
        /**
         * @brief Extracts the frustum planes from a combined view-projection matrix. Uses Hartmann & Gribbs method.
@@ -62,6 +167,33 @@ namespace GLESC::Render {
         */
         void extractPlanes(const VP& VPMatrix);
 
+        /**
+         * @brief The planes as [normal x, normal y, normal z, distance], the format read by the culling kernels.
+         */
+        using PackedPlanes = std::array<std::array<float, 4>, 6>;
+
+        /**
+         * @brief Pointers to the components of the boxes processed by a culling kernel.
+         */
+        struct AABBComponents {
+            const float* minX;
+            const float* minY;
+            const float* minZ;
+            const float* maxX;
+            const float* maxY;
+            const float* maxZ;
+        };
+
+        static void cullScalar(const PackedPlanes& packed, const AABBComponents& boxes, size_t begin, size_t end,
+                               std::uint8_t* visibleOut);
+        static void cullSSE(const PackedPlanes& packed, const AABBComponents& boxes, size_t count,
+                            std::uint8_t* visibleOut);
+        static void cullAVX2(const PackedPlanes& packed, const AABBComponents& boxes, size_t count,
+                             std::uint8_t* visibleOut);
+        void cullComponents(const AABBComponents& boxes, size_t count, std::uint8_t* visibleOut,
+                            CullingKernel kernel) const;
+
         std::array<Math::Plane, 6> planes{};
+        PackedPlanes packedPlanes{};
     }; // class Frustum
 } // namespace GLESC::Render
@@ -0,0 +1,93 @@
+/**************************************************************************************************
+ * @file   MatrixBatch.h
+ * @author Valentin Dumitru
+ * @date   2024-06-24
+ * @brief  Computes the matrices needed to draw many objects at once from their transforms.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include "engine/subsystems/renderer/RendererTypes.h"
+#include "engine/subsystems/transform/TransformStore.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief The implementations of the batch matrices, they all give the same result.
+     */
+    enum class MatrixKernel {
+        /**
+         * @brief One object at a time, available everywhere.
+         */
+        Scalar,
+        /**
+         * @brief Four objects at a time with SSE, available in all the x86-64 processors.
+         */
+        SSE,
+        /**
+         * @brief Eight objects at a time with AVX2, checked at runtime.
+         */
+        AVX2
+    };
+
+    /**
+     * @brief Where the batch writes the matrices of each object.
+     * @details The matrices of the object i of the batch are written to the index slots[i] of each array, or to i
+     * if there are no slots. The arrays that are null are skipped.
+     */
+    struct MatrixBatchOutput {
+        Model* models = nullptr;
+        MV* mvs = nullptr;
+        MVP* mvps = nullptr;
+        NormalMat* normalMats = nullptr;
+        const size_t* slots = nullptr;
+    };
+
+    /**
+     * @brief Builds the model, model view, model view projection and normal matrices of many objects.
+     * @details The same matrices as building the model matrix of each transform, multiplying it by the view and
+     * view projection matrices and calling makeNormalMatrix with the result, but the matrices are never built
+     * one by one. Each kernel computes the elements of several objects at once straight from the quaternion, which
+     * is normalized on the way, and the products skip the row of the model matrix that is always (0, 0, 0, 1).
+     * The view must be affine, like every view matrix, so the normal matrix is the inverse transpose of the rotation
+     * and scale part of the model view matrix, computed with cross products.
+     */
+    class MatrixBatch {
+    public:
+        /**
+         * @brief Computes the matrices of the objects in [begin, end), with the fastest kernel the processor
+         * supports.
+         * @details Every object only writes to its own slots, so different ranges of the same store can be computed
+         * by different threads.
+         * @param transforms The transforms of the objects.
+         * @param begin The first object to compute.
+         * @param end One past the last object to compute.
+         * @param view The view matrix.
+         * @param viewProjection The view projection matrix.
+         * @param output The arrays that receive the matrices.
+         */
+        static void compute(const Transform::TransformStore& transforms, size_t begin, size_t end,
+                            const View& view, const VP& viewProjection, const MatrixBatchOutput& output);
+        /**
+         * @brief Same as compute but with a chosen kernel, which must be supported.
+         */
+        static void compute(const Transform::TransformStore& transforms, size_t begin, size_t end,
+                            const View& view, const VP& viewProjection, const MatrixBatchOutput& output,
+                            MatrixKernel kernel);
+
+        /**
+         * @brief Get the fastest kernel supported by the processor, it's detected once.
+         */
+        [[nodiscard]] static MatrixKernel getBestKernel();
+        [[nodiscard]] static bool isKernelSupported(MatrixKernel kernel);
+
+    private:
+        static void computeScalar(const Transform::TransformStore& transforms, size_t begin, size_t end,
+                                  const View& view, const VP& viewProjection, const MatrixBatchOutput& output);
+        static void computeSSE(const Transform::TransformStore& transforms, size_t begin, size_t end,
+                               const View& view, const VP& viewProjection, const MatrixBatchOutput& output);
+        static void computeAVX2(const Transform::TransformStore& transforms, size_t begin, size_t end,
+                                const View& view, const VP& viewProjection, const MatrixBatchOutput& output);
+    }; // class MatrixBatch
+} // namespace GLESC::Render
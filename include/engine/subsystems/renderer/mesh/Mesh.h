@@ -13,6 +13,7 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <utility>
 #include "engine/core/low-level-renderer/graphic-api/GapiEnums.h"
 #include "engine/core/low-level-renderer/buffers/IndexBuffer.h"
@@ -22,11 +23,14 @@
 #include "engine/core/hash/Hasher.h"
 #include "engine/core/math/geometry/figures/BoundingVolume.h"
 #include "engine/subsystems/EngineComponent.h"
+#include "engine/subsystems/renderer/mesh/MeshOptimizer.h"
 #include "engine/subsystems/renderer/mesh/Vertex.h"
+#include "engine/subsystems/renderer/mesh/VertexPacker.h"
 #include "engine/subsystems/renderer/RendererTypes.h"
 
 namespace GLESC::Render {
     class Renderer;
+    class MeshRegistry;
     /**
      * @brief A class that represents a mesh.
      * @details This is the mesh class for the engine. Is a template class that needs to be instantiated with the
@@ -39,6 +43,7 @@ namespace GLESC::Render {
     template <typename VertexT>
     class Mesh : public EngineComponent {
         friend class GLESC::Render::Renderer;
+        friend class GLESC::Render::MeshRegistry;
 
     public:
         /**
@@ -80,10 +85,13 @@ namespace GLESC::Render {
                                   boundingVolume(other.boundingVolume),
                                   vertexLayout(other.vertexLayout),
                                   faces(other.faces),
+                                  storeFaces(other.storeFaces),
+                                  vertexFormat(other.vertexFormat),
                                   dirtyFlag(other.dirtyFlag),
                                   renderType(other.renderType),
                                   hashDirty(other.hashDirty),
-                                  cachedHash(other.cachedHash) {
+                                  cachedHash(other.cachedHash),
+                                  optimizationReport(other.optimizationReport) {
         }
 
         Mesh(Mesh&& other) noexcept : vertices(std::move(other.vertices)),
@@ -91,10 +99,13 @@ namespace GLESC::Render {
                                       boundingVolume(std::move(other.boundingVolume)),
                                       vertexLayout(std::move(other.vertexLayout)),
                                       faces(std::move(other.faces)),
+                                      storeFaces(other.storeFaces),
+                                      vertexFormat(other.vertexFormat),
                                       dirtyFlag(other.dirtyFlag),
                                       renderType(other.renderType),
                                       hashDirty(other.hashDirty),
-                                      cachedHash(other.cachedHash){}
+                                      cachedHash(other.cachedHash),
+                                      optimizationReport(other.optimizationReport) {}
 
         Mesh& operator=(Mesh&& other) noexcept {
             if (this == &other)
@@ -104,10 +115,13 @@ namespace GLESC::Render {
             boundingVolume = std::move(other.boundingVolume);
             vertexLayout = std::move(other.vertexLayout);
             faces = std::move(other.faces);
+            storeFaces = other.storeFaces;
+            vertexFormat = other.vertexFormat;
             dirtyFlag = other.dirtyFlag;
             renderType = other.renderType;
             hashDirty = other.hashDirty;
             cachedHash = other.cachedHash;
+            optimizationReport = other.optimizationReport;
             return *this;
         }
 
@@ -123,6 +137,9 @@ namespace GLESC::Render {
             hashDirty = other.hashDirty;
             cachedHash = other.cachedHash;
             faces = other.faces;
+            storeFaces = other.storeFaces;
+            vertexFormat = other.vertexFormat;
+            optimizationReport = other.optimizationReport;
             return *this;
         }
 
@@ -134,6 +151,7 @@ namespace GLESC::Render {
          */
         void startBuilding() {
             dirtyFlag = true;
+            hashDirty = true;
             isBuilding = true;
         }
 
@@ -142,13 +160,35 @@ namespace GLESC::Render {
             indices.clear();
             faces.clear();
             dirtyFlag = true;
+            hashDirty = true;
         }
 
-        void finishBuilding() {
+        /**
+         * @brief Finishes the building of the mesh.
+         * @details Computes the bounding volume of the mesh, after this the mesh can't be modified until
+         * startBuilding is called again.
+         * @param optimize If true, the vertices are welded and the triangles and vertices are reordered for the
+         * caches of the GPU (@see MeshOptimizer). It's recommended for the meshes built attaching other meshes, as
+         * every attached face adds its own vertices. The report of the optimization can be get with
+         * getOptimizationReport.
+         */
+        void finishBuilding(bool optimize = false) {
             D_ASSERT_TRUE(isBuilding, "Mesh is not being built");
             D_ASSERT_TRUE(!vertices.empty(), "No vertices in mesh");
             D_ASSERT_TRUE(!indices.empty(), "No indices in mesh");
+            optimizationReport.reset();
+            if (optimize) {
+                optimizationReport = MeshOptimizer::optimize(vertices, indices);
+                faces.clear();
+                if (storeFaces) {
+                    faces.reserve(indices.size() / 3);
+                    for (size_t index = 0; index < indices.size(); index += 3) {
+                        faces.push_back({indices[index], indices[index + 1], indices[index + 2]});
+                    }
+                }
+            }
             boundingVolume.updateBoundingBox(vertices.data(), vertices.size() * sizeof(Vertex), sizeof(Vertex), 0);
+            hashDirty = true;
             isBuilding = false;
         }
 
@@ -164,19 +204,65 @@ namespace GLESC::Render {
 
         void reserveFaces(size_t size) {
             D_ASSERT_TRUE(isBuilding, "Mesh is not being built");
-            faces.reserve(size);
+            if (storeFaces) faces.reserve(size);
+        }
+
+        /**
+         * @brief Sets if the mesh keeps the faces array.
+         * @details The faces are the same data as the indices grouped by triangle, so big meshes that don't need
+         * them (for example the terrain) can drop them and save that memory. If they're dropped, getFaces is empty.
+         * @param storeFacesParam True to keep the faces (the default), false to drop them.
+         */
+        void setStoreFaces(bool storeFacesParam) {
+            storeFaces = storeFacesParam;
+            if (!storeFaces) {
+                faces.clear();
+                faces.shrink_to_fit();
+            }
+        }
+
+        /**
+         * @brief Sets the format of the vertices in the GPU, it must be set before the mesh is sent to the GPU.
+         * @details The compact formats take 16 bytes per vertex instead of 40, @see VertexFormat. Only the meshes of
+         * ColorVertex support them.
+         */
+        void setVertexFormat(VertexFormat vertexFormatParam) {
+            D_ASSERT_TRUE(vertexFormatParam == VertexFormat::Float || (std::is_same_v<Vertex, ColorVertex>),
+                          "Only the color meshes support the compact vertex formats");
+            D_ASSERT_FALSE(wasDataSentToGpu, "The format can't change after the mesh is sent to the GPU");
+            vertexFormat = vertexFormatParam;
+        }
+
+        [[nodiscard]] VertexFormat getVertexFormat() const { return vertexFormat; }
+
+        /**
+         * @brief The transformation the shader applies to the positions of the vertices in the GPU.
+         * @details It's the identity except for the quantized format, where it depends on the bounding volume.
+         */
+        [[nodiscard]] VertexPacker::PositionDequantization getPositionDequantization() const {
+            return VertexPacker::getDequantization(vertexFormat, boundingVolume.getMin(), boundingVolume.getMax());
         }
 
         [[nodiscard]] const std::vector<Vertex>& getVertices() const { return vertices; }
-        [[nodiscard]] std::vector<Vertex>& getModifiableVertices() { return vertices; }
+        [[nodiscard]] std::vector<Vertex>& getModifiableVertices() {
+            hashDirty = true;
+            return vertices;
+        }
         [[nodiscard]] const std::vector<Index>& getIndices() const { return indices; }
         [[nodiscard]] const std::vector<GLESC::GAPI::Enums::Types>& getVertexLayout() const { return vertexLayout; }
         [[nodiscard]] const std::vector<Math::FaceIndices>& getFaces() const { return faces; }
+        [[nodiscard]] bool areFacesStored() const { return storeFaces; }
         [[nodiscard]] const Math::BoundingVolume& getBoundingVolume() const { return boundingVolume; }
         [[nodiscard]] Math::BoundingVolume& getBoundingVolumeMutable() { return boundingVolume; }
         [[nodiscard]] bool isDirty() const { return dirtyFlag; }
         [[nodiscard]] const RenderType& getRenderType() const { return renderType; }
         [[nodiscard]] bool isBeingBuilt() const { return isBuilding; }
+        /**
+         * @brief The report of the optimization done when the mesh was built, if it was optimized.
+         */
+        [[nodiscard]] const std::optional<MeshOptimizer::Report>& getOptimizationReport() const {
+            return optimizationReport;
+        }
 
         void setRenderType(RenderType renderTypeParam) { renderType = renderTypeParam; }
 
@@ -247,19 +333,20 @@ namespace GLESC::Render {
 
         /**
          * @brief Attaches a mesh to the current mesh.
-         * @details This method will add the faces and vertices to the current mesh.
-         * It is an expesive operation as will iterate over all the faces of other mesh to add
-         * to this one.
+         * @details This method will add the triangles and vertices to the current mesh.
+         * It is an expesive operation as will iterate over all the triangles of other mesh to add
+         * to this one. For big meshes, appendGeometry is much faster.
          * @param mesh The mesh to be attached.
          */
         void attatchMesh(const Mesh& mesh) {
             D_ASSERT_TRUE(isBuilding, "Mesh is not being built");
 
 
-            for (Math::FaceIndices face : mesh.getFaces()) {
-                Index v1Index = face[0];
-                Index v2Index = face[1];
-                Index v3Index = face[2];
+            const std::vector<Index>& meshIndices = mesh.getIndices();
+            for (size_t index = 0; index < meshIndices.size(); index += 3) {
+                Index v1Index = meshIndices[index];
+                Index v2Index = meshIndices[index + 1];
+                Index v3Index = meshIndices[index + 2];
                 const Vertex& v1 = mesh.getVertices()[v1Index];
                 const Vertex& v2 = mesh.getVertices()[v2Index];
                 const Vertex& v3 = mesh.getVertices()[v3Index];
@@ -324,12 +411,10 @@ namespace GLESC::Render {
          */
         Index addVertex(const Vertex& vertexParam) {
             D_ASSERT_TRUE(isBuilding, "Mesh is not being built");
-            // Insert new vertex
+            // Insert new vertex, the index must be read inside the lock or two threads could get the same one
+            std::lock_guard<std::mutex> lock(verticesMutex);
             auto newIndex = static_cast<Index>(vertices.size());
-            {
-                std::lock_guard<std::mutex> lock(verticesMutex);
-                vertices.push_back(vertexParam);
-            }
+            vertices.push_back(vertexParam);
             return newIndex;
         }
 
@@ -367,11 +452,67 @@ namespace GLESC::Render {
                 indices.push_back(index1);
                 indices.push_back(index2);
                 indices.push_back(index3);
-                faces.push_back({index1, index2, index3});
+                if (storeFaces) faces.push_back({index1, index2, index3});
             }
             this->dirtyFlag = true;
         }
 
+        /**
+         * @brief Appends a block of vertices and the triangles that use them.
+         * @details The indices are relative to the appended vertices, they're rebased to the position where the
+         * vertices are inserted. The locks are taken once for the whole block instead of once per vertex and
+         * triangle, so it's the fast path to build big meshes (@see MeshBuilder).
+         * @param verticesParam The vertices to append.
+         * @param indicesParam The indices of the triangles, in the range of verticesParam.
+         */
+        void appendGeometry(const std::vector<Vertex>& verticesParam, const std::vector<Index>& indicesParam) {
+            D_ASSERT_TRUE(isBuilding, "Mesh is not being built");
+            D_ASSERT_TRUE(indicesParam.size() % 3 == 0, "Indices must be a list of triangles");
+            std::scoped_lock lock(verticesMutex, indicesMutex);
+            const auto baseIndex = static_cast<Index>(vertices.size());
+            vertices.insert(vertices.end(), verticesParam.begin(), verticesParam.end());
+            indices.reserve(indices.size() + indicesParam.size());
+            for (Index index : indicesParam) {
+                D_ASSERT_LESS(index, verticesParam.size(), "Index out of bounds");
+                indices.push_back(baseIndex + index);
+            }
+            if (storeFaces) {
+                faces.reserve(faces.size() + indicesParam.size() / 3);
+                for (size_t index = indices.size() - indicesParam.size(); index < indices.size(); index += 3) {
+                    faces.push_back({indices[index], indices[index + 1], indices[index + 2]});
+                }
+            }
+            dirtyFlag = true;
+        }
+
+        /**
+         * @brief Appends a block of vertices and the triangles that use them, taking their memory if the mesh is
+         * empty.
+         * @details Same as the copying version, but when the mesh has no geometry yet the vectors are moved instead
+         * of copied, which is the usual case of a mesh built from a single block.
+         */
+        void appendGeometry(std::vector<Vertex>&& verticesParam, std::vector<Index>&& indicesParam) {
+            D_ASSERT_TRUE(isBuilding, "Mesh is not being built");
+            {
+                std::scoped_lock lock(verticesMutex, indicesMutex);
+                if (vertices.empty() && indices.empty()) {
+                    D_ASSERT_TRUE(indicesParam.size() % 3 == 0, "Indices must be a list of triangles");
+                    vertices = std::move(verticesParam);
+                    indices = std::move(indicesParam);
+                    if (storeFaces) {
+                        faces.reserve(indices.size() / 3);
+                        for (size_t index = 0; index < indices.size(); index += 3) {
+                            faces.push_back({indices[index], indices[index + 1], indices[index + 2]});
+                        }
+                    }
+                    dirtyFlag = true;
+                    return;
+                }
+            }
+            appendGeometry(static_cast<const std::vector<Vertex>&>(verticesParam),
+                           static_cast<const std::vector<Index>&>(indicesParam));
+        }
+
         /**
          * @brief To check if a mesh is equal to another mesh we iterate over the vertices and indices and compare them.
          * If the vertices and indices are the same, the meshes are equal.
@@ -380,8 +521,12 @@ namespace GLESC::Render {
          * @return
          */
         [[nodiscard]] bool operator==(const Mesh& other) const {
+            if (vertices.size() != other.vertices.size() || indices.size() != other.indices.size()) {
+                return false;
+            }
+
             for (size_t i = 0; i < vertices.size(); ++i) {
-                if (vertices[i] != other.vertices[i]) {
+                if (!(vertices[i] == other.vertices[i])) {
                     return false;
                 }
             }
@@ -438,7 +583,7 @@ namespace GLESC::Render {
 
                 EntityStatsManager::Value faceCountValue;
                 faceCountValue.name = "Face Count";
-                faceCountValue.stringData = std::to_string(faces.size());
+                faceCountValue.stringData = std::to_string(indices.size() / 3);
                 faceCountValue.isString = true;
                 values.push_back(faceCountValue);
 
@@ -478,6 +623,17 @@ namespace GLESC::Render {
 
             vertexArray->bind();
 
+            // The packed vertices must live until they're copied to the buffer
+            VertexPacker::PackedVertices packedVertices;
+            if constexpr (std::is_same_v<Vertex, ColorVertex>) {
+                if (vertexFormat != VertexFormat::Float) {
+                    packedVertices = VertexPacker::pack(getVertices(), vertexFormat, boundingVolume.getMin(),
+                                                        boundingVolume.getMax());
+                    bufferData = packedVertices.data.data();
+                    vertexBytes = packedVertices.stride;
+                }
+            }
+
             vertexBuffer = std::make_unique<GLESC::GAPI::VertexBuffer>(
                 bufferData,
                 bufferCount,
@@ -490,8 +646,15 @@ namespace GLESC::Render {
                 getIndices().size());
 
             GLESC::GAPI::VertexBufferLayout layout;
-            for (GLESC::GAPI::Enums::Types type : getVertexLayout()) {
-                layout.push(type);
+            if (vertexFormat == VertexFormat::Float) {
+                for (GLESC::GAPI::Enums::Types type : getVertexLayout()) {
+                    layout.push(type);
+                }
+            }
+            else {
+                for (const GLESC::GAPI::VertexBufferElement& element : VertexPacker::getLayout(vertexFormat)) {
+                    layout.push(element.type, element.normalized);
+                }
             }
 
             vertexArray->addBuffer(*vertexBuffer, layout);
@@ -564,6 +727,14 @@ namespace GLESC::Render {
 
         RenderType renderType;
         std::vector<Math::FaceIndices> faces{};
+        /**
+         * @brief If false, the faces aren't stored, as they're a copy of the indices.
+         */
+        bool storeFaces = true;
+        /**
+         * @brief The format of the vertices in the GPU.
+         */
+        VertexFormat vertexFormat = VertexFormat::Float;
         std::vector<Index> indices{};
         std::vector<Vertex> vertices{};
 
@@ -597,6 +768,11 @@ namespace GLESC::Render {
         mutable size_t cachedHash = 0;
         mutable bool hashDirty = true;
 
+        /**
+         * @brief The report of the optimization of the mesh, empty if it wasn't optimized.
+         */
+        std::optional<MeshOptimizer::Report> optimizationReport;
+
         /**
          * @brief buffer that handles the indices of the mesh in the gpu.
          */
@@ -0,0 +1,151 @@
+/**************************************************************************************************
+ * @file   MeshArena.h
+ * @author Valentin Dumitru
+ * @date   2024-06-21
+ * @brief  Shared vertex and index buffers where many meshes of the same vertex format are stored.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/core/low-level-renderer/buffers/BufferRangeAllocator.h"
+#include "engine/core/low-level-renderer/buffers/StreamingRing.h"
+#include "engine/core/low-level-renderer/buffers/VertexBufferLayout.h"
+#include "engine/core/low-level-renderer/graphic-api/IGraphicInterface.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief A big vertex buffer and a big index buffer, with a single vertex array, that store the meshes drawn
+     * with the multi draw indirect.
+     * @details Every mesh of the arena is a range of indices and a base vertex, so all of them are drawn with the
+     * same vertex array and the draws only differ in their indirect command. The arena only stores meshes of one
+     * vertex format, as the format defines the layout of the vertex array.
+     *
+     * The ranges are sub-allocated from the buffers with a free list (@see GAPI::BufferRangeAllocator), so a mesh
+     * never moves and the range of a destroyed mesh is reused by the next ones. The meshes are watched with weak
+     * references, the ranges of the meshes destroyed by the registry are freed when the arena runs out of space.
+     * The meshes that don't fit after that can't be drawn from the arena.
+     *
+     * With a staging ring the meshes are written to the ring and copied to their ranges by the GPU, so adding a
+     * mesh doesn't wait for the draws that are still reading the buffers. Without it, or if the ring is full, the
+     * ranges are overwritten directly.
+     *
+     * The buffers are created the first time a mesh is added, from the thread that owns the graphic context.
+     */
+    class MeshArena {
+    public:
+        /**
+         * @brief The place of a mesh in the buffers of the arena.
+         */
+        struct Range {
+            GAPI::UInt firstIndex = 0;
+            GAPI::UInt indexCount = 0;
+            GAPI::Int baseVertex = 0;
+            GAPI::UInt vertexCount = 0;
+        };
+
+        /**
+         * @brief Creates an arena without buffers.
+         * @param gapiParam The graphic interface the buffers are created with.
+         * @param formatParam The format of the vertices of the meshes stored.
+         * @param vertexCapacityParam The number of vertices the vertex buffer can store.
+         * @param indexCapacityParam The number of indices the index buffer can store.
+         * @param stagingRingParam The ring the meshes are uploaded through, or nullptr to write them directly.
+         */
+        MeshArena(GAPI::IGraphicInterface& gapiParam, VertexFormat formatParam, size_t vertexCapacityParam,
+                  size_t indexCapacityParam, GAPI::StreamingRing* stagingRingParam = nullptr);
+        ~MeshArena();
+        MeshArena(const MeshArena&) = delete;
+        MeshArena& operator=(const MeshArena&) = delete;
+
+        /**
+         * @brief Gets the range of a mesh, uploading it if it isn't in the arena yet.
+         * @param mesh A mesh with the format of the arena.
+         * @return The range of the mesh, or nullptr if the mesh doesn't fit in the arena. The pointer is valid
+         * while the mesh is alive.
+         */
+        [[nodiscard]] const Range* getOrAdd(const MeshHandle& mesh);
+        /**
+         * @brief Frees the ranges of the meshes destroyed since the last call.
+         * @return The number of meshes released.
+         */
+        size_t releaseDestroyedMeshes();
+
+        /**
+         * @brief Binds the vertex array of the arena, with the vertex and the index buffers.
+         */
+        void bind() const;
+        /**
+         * @brief Destroys the buffers, the meshes are uploaded again the next time they're added.
+         */
+        void destroyGpuBuffers();
+
+        [[nodiscard]] VertexFormat getFormat() const { return format; }
+        [[nodiscard]] size_t getMeshCount() const { return entries.size(); }
+        [[nodiscard]] size_t getUsedVertices() const { return vertexAllocator.getUsed(); }
+        [[nodiscard]] size_t getUsedIndices() const { return indexAllocator.getUsed(); }
+        [[nodiscard]] size_t getVertexCapacity() const { return vertexAllocator.getCapacity(); }
+        [[nodiscard]] size_t getIndexCapacity() const { return indexAllocator.getCapacity(); }
+        /**
+         * @brief Number of destroyed meshes whose ranges were freed since the arena was created.
+         */
+        [[nodiscard]] size_t getReleasedMeshCount() const { return releasedMeshes; }
+        /**
+         * @brief Bytes uploaded through the staging ring since the arena was created.
+         */
+        [[nodiscard]] size_t getStagedBytes() const { return stagedBytes; }
+        [[nodiscard]] GAPI::UInt getVertexArrayId() const { return vertexArray; }
+
+        /**
+         * @brief The layout of the vertices of a format in the GPU, the same as the buffers of the meshes.
+         */
+        [[nodiscard]] static std::vector<GAPI::VertexBufferElement> getLayout(VertexFormat format);
+
+    private:
+        struct Entry {
+            std::weak_ptr<const ColorMesh> mesh;
+            Range range;
+            GAPI::BufferRangeAllocator::Allocation vertices;
+            GAPI::BufferRangeAllocator::Allocation indices;
+        };
+
+        void createBuffers();
+        /**
+         * @brief Allocates the ranges of the mesh and writes it there.
+         * @return If the mesh fit in the buffers.
+         */
+        bool upload(const ColorMesh& mesh, Entry& entry);
+        /**
+         * @brief Writes data to a range of a buffer of the arena, through the staging ring if it has space.
+         */
+        void write(GAPI::UInt buffer, GAPI::Enums::BufferTypes bufferType, const void* data, size_t offset,
+                   size_t size);
+        void release(Entry& entry);
+
+        GAPI::IGraphicInterface& gapi;
+        VertexFormat format;
+        GAPI::StreamingRing* stagingRing;
+        size_t vertexStride = 0;
+        GAPI::BufferRangeAllocator vertexAllocator;
+        GAPI::BufferRangeAllocator indexAllocator;
+
+        GAPI::UInt vertexArray = 0;
+        GAPI::UInt vertexBuffer = 0;
+        GAPI::UInt indexBuffer = 0;
+        bool buffersCreated = false;
+
+        size_t releasedMeshes = 0;
+        size_t stagedBytes = 0;
+        /**
+         * @brief The meshes of the arena. The address of a destroyed mesh can be reused by a new one, so the
+         * entries are only valid if their weak reference still points to the same mesh.
+         */
+        std::unordered_map<const ColorMesh*, Entry> entries;
+    }; // class MeshArena
+} // namespace GLESC::Render
@@ -0,0 +1,205 @@
+/**************************************************************************************************
+ * @file   MeshBuilder.h
+ * @author Valentin Dumitru
+ * @date   2024-06-16
+ * @brief  Builds meshes from several threads without locking per vertex.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "engine/subsystems/renderer/mesh/Mesh.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief Builds the geometry of a mesh in staging buffers, one per thread, and moves it to the mesh at the end.
+     * @details Adding vertices to a mesh takes a lock per vertex and per triangle. The builder instead gives each
+     * thread its own staging buffer, where vertices and triangles are added without any synchronization. When the
+     * building finishes, the staging buffers are appended to the mesh one after the other, rebasing their indices.
+     *
+     * The order of the staging buffers in the mesh is the order in which the threads first asked for one, so the
+     * order of the triangles can change between runs when building in parallel (the triangles are the same).
+     * @tparam VertexT The vertex of the mesh, @see Mesh
+     */
+    template <typename VertexT>
+    class MeshBuilder {
+    public:
+        using MeshType = Mesh<VertexT>;
+        using Vertex = VertexT;
+        using Index = typename MeshType::Index;
+        using VertexColorParam = typename MeshType::VertexColorParam;
+
+        /**
+         * @brief Vertices and triangles added by a single thread.
+         * @details The indices are relative to the vertices of the staging buffer. It mirrors the building methods
+         * of the mesh, but it's not thread safe, it must be used by one thread at a time.
+         */
+        class Staging {
+        public:
+            /**
+             * @brief Adds a vertex to the staging buffer.
+             * @return The index of the vertex in the staging buffer.
+             */
+            Index addVertex(const Vertex& vertexParam) {
+                vertices.push_back(vertexParam);
+                return static_cast<Index>(vertices.size() - 1);
+            }
+
+            /**
+             * @brief Adds a triangle with vertices already in the staging buffer.
+             */
+            void addTris(Index index1, Index index2, Index index3) {
+                D_ASSERT_NOT_EQUAL(index1, index2, "Index 1 and 2 are equal");
+                D_ASSERT_NOT_EQUAL(index1, index3, "Index 1 and 3 are equal");
+                D_ASSERT_NOT_EQUAL(index2, index3, "Index 2 and 3 are equal");
+                D_ASSERT_LESS(index1, vertices.size(), "Index 1 out of bounds");
+                D_ASSERT_LESS(index2, vertices.size(), "Index 2 out of bounds");
+                D_ASSERT_LESS(index3, vertices.size(), "Index 3 out of bounds");
+                indices.push_back(index1);
+                indices.push_back(index2);
+                indices.push_back(index3);
+            }
+
+            /**
+             * @brief Adds a triangle with new vertices, the vertices should be in counter-clockwise order.
+             */
+            void addTris(const Vertex& v1, const Vertex& v2, const Vertex& v3) {
+                const Index v1Index = addVertex(v1);
+                const Index v2Index = addVertex(v2);
+                const Index v3Index = addVertex(v3);
+                addTris(v1Index, v2Index, v3Index);
+            }
+
+            /**
+             * @brief Adds a triangle with new vertices and the normal of the face, the vertices should be in
+             * counter-clockwise order.
+             */
+            void addTris(const VertexColorParam& a, const VertexColorParam& b, const VertexColorParam& c) {
+                const Normal normal = calculateNormal(a.position, b.position, c.position);
+                addTris(Vertex(a.position, normal, a.color),
+                        Vertex(b.position, normal, b.color),
+                        Vertex(c.position, normal, c.color));
+            }
+
+            /**
+             * @brief Adds a quad with new vertices and the normal of the face, as two triangles that share two
+             * vertices. The vertices should be in counter-clockwise order.
+             */
+            void addQuad(const VertexColorParam& v1,
+                         const VertexColorParam& v2,
+                         const VertexColorParam& v3,
+                         const VertexColorParam& v4) {
+                const Normal normal = calculateNormal(v1.position, v2.position, v3.position);
+                const Index v1Index = addVertex(Vertex(v1.position, normal, v1.color));
+                const Index v2Index = addVertex(Vertex(v2.position, normal, v2.color));
+                const Index v3Index = addVertex(Vertex(v3.position, normal, v3.color));
+                const Index v4Index = addVertex(Vertex(v4.position, normal, v4.color));
+                addTris(v1Index, v2Index, v3Index);
+                addTris(v1Index, v3Index, v4Index);
+            }
+
+            void reserve(size_t vertexCount, size_t indexCount) {
+                vertices.reserve(vertexCount);
+                indices.reserve(indexCount);
+            }
+
+            [[nodiscard]] const std::vector<Vertex>& getVertices() const { return vertices; }
+            [[nodiscard]] const std::vector<Index>& getIndices() const { return indices; }
+
+        private:
+            friend class MeshBuilder;
+
+            static Normal calculateNormal(const Position& p1, const Position& p2, const Position& p3) {
+                return (p2 - p1).cross(p3 - p1).normalize();
+            }
+
+            std::vector<Vertex> vertices;
+            std::vector<Index> indices;
+        }; // class Staging
+
+        MeshBuilder() : builderId(nextBuilderId++) {
+        }
+
+        MeshBuilder(const MeshBuilder&) = delete;
+        MeshBuilder& operator=(const MeshBuilder&) = delete;
+
+        /**
+         * @brief Gets the staging buffer of the calling thread, creating it the first time.
+         * @details Only the first call of each thread takes a lock, the next ones are found in a thread local
+         * cache. If a thread alternates between builders, it gets a new staging buffer each time it switches,
+         * which is correct but wastes memory.
+         */
+        Staging& getThreadStaging() {
+            struct ThreadCache {
+                size_t builderId = 0;
+                Staging* staging = nullptr;
+            };
+            thread_local ThreadCache cache;
+            if (cache.builderId != builderId) {
+                cache.staging = &createStaging();
+                cache.builderId = builderId;
+            }
+            return *cache.staging;
+        }
+
+        /**
+         * @brief Creates a new staging buffer.
+         * @details The buffer can be used by any thread, but by only one at a time.
+         */
+        Staging& createStaging() {
+            std::lock_guard lock(stagingsMutex);
+            stagings.push_back(std::make_unique<Staging>());
+            return *stagings.back();
+        }
+
+        /**
+         * @brief Appends the geometry of every staging buffer to the mesh and finishes building it.
+         * @details No thread can be adding geometry to the builder during the call. After it, the builder is empty
+         * and can be used to build another mesh.
+         * @param mesh The mesh that receives the geometry, it must be being built.
+         * @param optimize If the mesh is optimized, @see Mesh::finishBuilding
+         */
+        void finishBuilding(MeshType& mesh, bool optimize = false) {
+            D_ASSERT_TRUE(mesh.isBeingBuilt(), "Mesh is not being built");
+            std::lock_guard lock(stagingsMutex);
+            size_t vertexCount = mesh.getVertices().size();
+            size_t indexCount = mesh.getIndices().size();
+            for (const auto& staging : stagings) {
+                vertexCount += staging->vertices.size();
+                indexCount += staging->indices.size();
+            }
+            for (size_t stagingIndex = 0; stagingIndex < stagings.size(); stagingIndex++) {
+                // The staging buffers are destroyed after this, so an empty mesh can take the memory of the first
+                Staging& staging = *stagings[stagingIndex];
+                mesh.appendGeometry(std::move(staging.vertices), std::move(staging.indices));
+                if (stagingIndex == 0) {
+                    mesh.reserveVertices(vertexCount);
+                    mesh.reserveIndices(indexCount);
+                    mesh.reserveFaces(indexCount / 3);
+                }
+            }
+            stagings.clear();
+            // The cached staging buffers of the threads were destroyed
+            builderId = nextBuilderId++;
+            mesh.finishBuilding(optimize);
+        }
+
+    private:
+        /**
+         * @brief Identifies the builder in the thread local caches, it's never reused (unlike the address).
+         */
+        size_t builderId;
+        inline static std::atomic<size_t> nextBuilderId{1};
+
+        std::mutex stagingsMutex;
+        std::vector<std::unique_ptr<Staging>> stagings;
+    }; // class MeshBuilder
+
+    using ColorMeshBuilder = MeshBuilder<ColorVertex>;
+} // namespace GLESC::Render
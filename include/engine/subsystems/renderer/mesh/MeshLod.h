@@ -0,0 +1,120 @@
+/**************************************************************************************************
+ * @file   MeshLod.h
+ * @author Valentin Dumitru
+ * @date   2024-06-20
+ * @brief  Chains of levels of detail of a mesh and the selection of the level drawn.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief The versions of a mesh with less triangles to draw it when it's small on the screen.
+     * @details The level 0 is the full mesh, each level after it has less triangles. Each level has the minimum
+     * screen size it's drawn at, the screen size is the fraction of the height of the viewport covered by the
+     * bounding sphere of the mesh (@see computeScreenSize). The last level is drawn at any size.
+     *
+     * The level of an object is selected with hysteresis: the object only changes to a coarser level when it's
+     * a bit smaller than the threshold, and back to the finer level when it's a bit bigger. Otherwise an object
+     * that moves around a threshold would switch levels every frame, which is noticed as popping.
+     *
+     * The levels are meshes of the registry, so they're uploaded and shared like any other mesh. A chain is
+     * immutable once it's built and it's shared with std::shared_ptr by the components that render it.
+     */
+    class MeshLodChain {
+    public:
+        struct Level {
+            MeshHandle mesh;
+            /**
+             * @brief The smallest screen size the level is drawn at.
+             */
+            float minScreenSize = 0.0f;
+        };
+
+        /**
+         * @brief The fraction of a threshold the screen size must pass it by to change of level.
+         */
+        static constexpr float defaultHysteresis = 0.15f;
+        /**
+         * @brief The screen size under which the full mesh is not drawn, in the generated chains.
+         */
+        static constexpr float defaultFirstScreenSize = 0.25f;
+
+        /**
+         * @brief Adds a level after the existing ones.
+         * @param mesh The mesh of the level, it should have less triangles than the previous level.
+         * @param minScreenSize The smallest screen size the level is drawn at, it must be smaller than the one of
+         * the previous level. It's ignored for the last level.
+         */
+        void addLevel(const MeshHandle& mesh, float minScreenSize);
+
+        [[nodiscard]] size_t getLevelCount() const { return levels.size(); }
+        [[nodiscard]] const Level& getLevel(size_t level) const { return levels[level]; }
+        [[nodiscard]] const ColorMesh& getMesh(size_t level) const { return levels[level].mesh.get(); }
+
+        void setHysteresis(float hysteresisParam) { hysteresis = hysteresisParam; }
+        [[nodiscard]] float getHysteresis() const { return hysteresis; }
+
+        /**
+         * @brief Selects the level for a screen size, without hysteresis, for an object drawn for the first time.
+         */
+        [[nodiscard]] size_t selectLevel(float screenSize) const;
+        /**
+         * @brief Selects the level for a screen size, for an object that was drawn with the current level.
+         * @details The thresholds are moved away from the current level by the hysteresis, so the level only
+         * changes if the screen size has clearly passed the threshold.
+         */
+        [[nodiscard]] size_t selectLevel(float screenSize, size_t currentLevel) const;
+
+        /**
+         * @brief The fraction of the height of the viewport covered by a sphere.
+         * @param radius The radius of the sphere.
+         * @param distance The distance from the camera to the center of the sphere.
+         * @param projectionScale The scale of the projection, the cotangent of half the vertical field of view
+         * (the element [1][1] of the perspective matrix).
+         * @return The screen size, it can be bigger than 1 if the sphere is closer than the height of the viewport.
+         */
+        [[nodiscard]] static float computeScreenSize(float radius, float distance, float projectionScale);
+
+        /**
+         * @brief Creates a chain simplifying the mesh for each level (@see MeshSimplifier).
+         * @param mesh The full mesh, registered as the level 0.
+         * @param levelCount The number of levels, including the full mesh.
+         * @param triangleRatio The fraction of the triangles of a level that are kept in the next one.
+         * @param firstScreenSize The smallest screen size of the level 0, it's halved for each next level.
+         * @param registry The registry where the levels are registered.
+         */
+        [[nodiscard]] static std::shared_ptr<const MeshLodChain> simplify(
+            const ColorMesh& mesh, size_t levelCount, float triangleRatio = 0.5f,
+            float firstScreenSize = defaultFirstScreenSize, MeshRegistry& registry = MeshRegistry::get());
+
+        /**
+         * @brief Creates a chain with a generator of the mesh of each level, for the procedural meshes that can be
+         * built with less detail, for example a sphere of MeshFactory with less slices and stacks.
+         * @param levelCount The number of levels, including the full mesh.
+         * @param createLevel Builds the mesh of a level, receives the index of the level.
+         * @param firstScreenSize The smallest screen size of the level 0, it's halved for each next level.
+         * @param registry The registry where the levels are registered.
+         */
+        [[nodiscard]] static std::shared_ptr<const MeshLodChain> generate(
+            size_t levelCount, const std::function<ColorMesh(size_t level)>& createLevel,
+            float firstScreenSize = defaultFirstScreenSize, MeshRegistry& registry = MeshRegistry::get());
+
+    private:
+        /**
+         * @brief The screen size of the threshold of a level in the generated chains.
+         */
+        [[nodiscard]] static float getGeneratedScreenSize(size_t level, size_t levelCount, float firstScreenSize);
+
+        std::vector<Level> levels;
+        float hysteresis = defaultHysteresis;
+    }; // class MeshLodChain
+} // namespace GLESC::Render
@@ -0,0 +1,193 @@
+/**************************************************************************************************
+ * @file   MeshRegistry.h
+ * @author Valentin Dumitru
+ * @date   2024-06-12
+ * @brief  Shared storage of the immutable meshes, each unique mesh is stored and uploaded once.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/subsystems/renderer/mesh/Mesh.h"
+
+namespace GLESC::Render {
+    class MeshRegistry;
+
+    /**
+     * @brief Lightweight reference to a mesh of the registry.
+     * @details Copying a handle only increases a reference count, the mesh data is shared by every handle.
+     * The mesh can't be modified through the handle, to render a different mesh a new one must be registered.
+     * The mesh is kept alive while there is a handle to it, so a handle can be safely copied into a render snapshot.
+     */
+    class MeshHandle {
+        friend class MeshRegistry;
+
+    public:
+        /**
+         * @brief Creates an invalid handle, that doesn't reference any mesh.
+         */
+        MeshHandle() = default;
+
+        [[nodiscard]] bool isValid() const { return mesh != nullptr; }
+        explicit operator bool() const { return isValid(); }
+
+        [[nodiscard]] const ColorMesh& get() const {
+            D_ASSERT_TRUE(isValid(), "Mesh handle doesn't reference any mesh");
+            return *mesh;
+        }
+
+        const ColorMesh& operator*() const { return get(); }
+        const ColorMesh* operator->() const { return &get(); }
+
+        /**
+         * @brief A reference that doesn't keep the mesh alive, to know if the mesh was released by the registry.
+         */
+        [[nodiscard]] std::weak_ptr<const ColorMesh> getWeakReference() const { return mesh; }
+
+        /**
+         * @brief Two handles are equal if they reference the same mesh of the registry.
+         */
+        bool operator==(const MeshHandle& other) const { return mesh == other.mesh; }
+        bool operator!=(const MeshHandle& other) const { return mesh != other.mesh; }
+
+    private:
+        explicit MeshHandle(std::shared_ptr<const ColorMesh> meshParam) : mesh(std::move(meshParam)) {
+        }
+
+        std::shared_ptr<const ColorMesh> mesh;
+    }; // class MeshHandle
+
+    /**
+     * @brief Owns the mesh data and the GPU buffers of every mesh rendered, once per unique mesh.
+     * @details Registering a mesh equal to one already registered returns a handle to the existing one, so the
+     * memory and the GPU uploads depend on the number of different meshes and not on the number of entities that
+     * render them.
+     *
+     * The update side registers meshes and copies handles, the render side uploads the new meshes and releases the
+     * meshes no longer referenced, as both operations need the graphic context. Both sides can use the registry at
+     * the same time.
+     */
+    class MeshRegistry {
+    public:
+        /**
+         * @brief Counters of the registry, used to report the memory and upload cost of the meshes.
+         */
+        struct Stats {
+            /**
+             * @brief Number of different meshes stored.
+             */
+            size_t uniqueMeshes = 0;
+            /**
+             * @brief Number of handles to the stored meshes (without counting the registry).
+             */
+            size_t references = 0;
+            /**
+             * @brief Bytes of the mesh data stored in the CPU (vertices, indices and faces).
+             */
+            size_t cpuBytes = 0;
+            /**
+             * @brief Bytes of the vertex and index buffers in the GPU.
+             */
+            size_t gpuBytes = 0;
+            /**
+             * @brief Number of meshes uploaded to the GPU since the registry was created.
+             */
+            size_t uploads = 0;
+            /**
+             * @brief Time spent uploading meshes to the GPU since the registry was created, in milliseconds.
+             */
+            double uploadMillis = 0.0;
+        };
+
+        /**
+         * @brief The registry shared by the engine, the render components register their meshes here.
+         */
+        static MeshRegistry& get() {
+            static MeshRegistry instance;
+            return instance;
+        }
+
+        MeshRegistry() = default;
+        ~MeshRegistry() = default;
+        MeshRegistry(const MeshRegistry&) = delete;
+        MeshRegistry& operator=(const MeshRegistry&) = delete;
+
+        /**
+         * @brief Registers a copy of the mesh, or finds an equal mesh already registered.
+         * @param mesh The mesh to register, it must be built.
+         * @return A handle to the registered mesh.
+         */
+        [[nodiscard]] MeshHandle registerMesh(const ColorMesh& mesh);
+        /**
+         * @brief Registers the mesh moving its data, or finds an equal mesh already registered.
+         * @param mesh The mesh to register, it must be built.
+         * @return A handle to the registered mesh.
+         */
+        [[nodiscard]] MeshHandle registerMesh(ColorMesh&& mesh);
+
+        /**
+         * @brief Sends to the GPU the meshes registered since the last call.
+         * @details Must be called from the thread that owns the graphic context. The meshes of the static batches
+         * (RenderType::BatchedStatic) are not sent, they're drawn as part of their clusters (@see StaticBatcher).
+         */
+        void uploadPendingMeshes();
+        /**
+         * @brief Sends a registered mesh to the GPU now, if it wasn't sent yet.
+         * @details For the renderers that draw most meshes from shared buffers and only need the buffers of some
+         * meshes, instead of uploading every mesh registered. Must be called from the thread that owns the graphic
+         * context.
+         */
+        void uploadMesh(const ColorMesh& mesh);
+        /**
+         * @brief Destroys the meshes that aren't referenced by any handle, with their GPU buffers.
+         * @details Must be called from the thread that owns the graphic context.
+         * @return The number of meshes destroyed.
+         */
+        size_t releaseUnusedMeshes();
+        /**
+         * @brief Destroys the GPU buffers of every mesh, they will be uploaded again if they're still used.
+         * @details Must be called before the graphic context is destroyed.
+         */
+        void destroyGpuBuffers();
+
+        [[nodiscard]] Stats getStats() const;
+
+    private:
+        /**
+         * @brief Finds a registered mesh equal to the given one.
+         * @return The registered mesh, or nullptr if none is equal.
+         */
+        [[nodiscard]] std::shared_ptr<const ColorMesh> find(const ColorMesh& mesh, size_t meshHash) const;
+        /**
+         * @brief Stores a new mesh and marks it to be uploaded.
+         */
+        MeshHandle store(std::shared_ptr<const ColorMesh> mesh, size_t meshHash);
+
+        [[nodiscard]] static bool areEqual(const ColorMesh& first, const ColorMesh& second);
+        [[nodiscard]] static size_t getCpuBytes(const ColorMesh& mesh);
+        [[nodiscard]] static size_t getGpuBytes(const ColorMesh& mesh);
+
+        mutable std::mutex mutex;
+        /**
+         * @brief The registered meshes, indexed by the hash of their content.
+         */
+        std::unordered_multimap<size_t, std::shared_ptr<const ColorMesh>> meshes;
+        /**
+         * @brief The meshes registered that weren't uploaded to the GPU yet.
+         * @details Only the render side destroys meshes, and it removes them from here, so the pointers are valid
+         * while the render side uploads them.
+         */
+        std::vector<const ColorMesh*> pendingUploads;
+
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        size_t uploads = 0;
+        double uploadMillis = 0.0;
+    }; // class MeshRegistry
+} // namespace GLESC::Render
@@ -0,0 +1,135 @@
+/**************************************************************************************************
+ * @file   MeshSimplifier.h
+ * @author Valentin Dumitru
+ * @date   2024-06-20
+ * @brief  Quadric error edge collapse simplification of the meshes, used to build levels of detail.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "engine/core/asserts/Asserts.h"
+#include "engine/subsystems/renderer/mesh/Mesh.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief Reduces the triangles of a mesh keeping its shape as much as possible.
+     * @details Implements the simplification of Garland and Heckbert ("Surface Simplification Using Quadric Error
+     * Metrics"). Every position accumulates the quadrics of the planes of its triangles, which measure the squared
+     * distance of a point to those planes. The edges are collapsed in the order of the error of moving one end onto
+     * the other, so the flat regions are simplified first and the silhouette and the sharp edges last.
+     *
+     * The collapses move a position onto the other end of the edge instead of to the optimal point, so the
+     * simplified positions are a subset of the original ones and the vertices keep their attributes.
+     * The collapses that would flip a triangle are rejected, and the open borders have an extra quadric so they
+     * don't shrink.
+     *
+     * The vertices are merged by position before simplifying, so the meshes with a vertex per face (every mesh
+     * built with addTris) are simplified as a connected surface. The normals of the flat faces are recomputed
+     * after the simplification, the smooth normals are kept.
+     */
+    class MeshSimplifier {
+    public:
+        using Index = unsigned int;
+
+        /**
+         * @brief The triangles left by the simplification.
+         */
+        struct Result {
+            /**
+             * @brief The triangles that are kept, as indices into the original vertices.
+             */
+            std::vector<Index> indices;
+            /**
+             * @brief The position of every original vertex after the collapses.
+             */
+            std::vector<Position> positions;
+            /**
+             * @brief The largest error of the collapses done.
+             */
+            float error = 0.0f;
+        };
+
+        /**
+         * @brief Simplifies the triangles given only their positions.
+         * @param positions The position of each vertex.
+         * @param indices The indices of the triangles.
+         * @param targetTriangleCount The simplification stops when there are this many triangles or less.
+         * @param maxError The simplification also stops before a collapse with a larger error. The error is the
+         * squared distance to the planes of the original triangles, weighted by their area.
+         * @return The triangles left and the new positions of the vertices.
+         */
+        [[nodiscard]] static Result simplifyPositions(const std::vector<Position>& positions,
+                                                      const std::vector<Index>& indices,
+                                                      size_t targetTriangleCount,
+                                                      float maxError = std::numeric_limits<float>::max());
+
+        /**
+         * @brief Creates a simplified copy of the mesh.
+         * @param mesh The mesh to simplify, it must be built.
+         * @param triangleRatio The fraction of the triangles to keep, between 0 and 1.
+         * @param maxError The maximum error of a collapse, @see simplifyPositions.
+         * @return The simplified mesh, built and optimized, with the same render type and vertex format.
+         */
+        template <typename Vertex>
+        [[nodiscard]] static Mesh<Vertex> simplify(const Mesh<Vertex>& mesh, float triangleRatio,
+                                                   float maxError = std::numeric_limits<float>::max()) {
+            D_ASSERT_FALSE(mesh.isBeingBuilt(), "The mesh must be built to be simplified");
+            D_ASSERT_TRUE(triangleRatio >= 0.0f && triangleRatio <= 1.0f, "The ratio must be between 0 and 1");
+            const std::vector<Vertex>& vertices = mesh.getVertices();
+            const std::vector<Index>& indices = mesh.getIndices();
+
+            std::vector<Position> positions;
+            positions.reserve(vertices.size());
+            for (const Vertex& vertex : vertices) {
+                positions.push_back(vertex.getPosition());
+            }
+            const auto targetTriangleCount =
+                static_cast<size_t>(static_cast<float>(indices.size() / 3) * triangleRatio);
+            const Result result = simplifyPositions(positions, indices, targetTriangleCount, maxError);
+
+            Mesh<Vertex> simplified;
+            simplified.setRenderType(mesh.getRenderType());
+            simplified.setVertexFormat(mesh.getVertexFormat());
+            simplified.setStoreFaces(mesh.areFacesStored());
+            simplified.startBuilding();
+            // Every triangle gets its own vertices, finishBuilding welds the ones that end up equal
+            std::vector<Vertex> simplifiedVertices;
+            simplifiedVertices.reserve(result.indices.size());
+            for (size_t index = 0; index < result.indices.size(); index += 3) {
+                const Index* triangle = &result.indices[index];
+                const Normal originalNormal = calculateNormal(vertices[triangle[0]].getPosition(),
+                                                              vertices[triangle[1]].getPosition(),
+                                                              vertices[triangle[2]].getPosition());
+                const Normal newNormal = calculateNormal(result.positions[triangle[0]],
+                                                         result.positions[triangle[1]],
+                                                         result.positions[triangle[2]]);
+                for (size_t corner = 0; corner < 3; corner++) {
+                    Vertex vertex = vertices[triangle[corner]];
+                    vertex.setPosition(result.positions[triangle[corner]]);
+                    // A vertex with the normal of its face is part of a flat face, it follows the new face
+                    if (vertex.getNormal() == originalNormal) vertex.setNormal(newNormal);
+                    simplifiedVertices.push_back(vertex);
+                }
+            }
+            std::vector<Index> simplifiedIndices(simplifiedVertices.size());
+            for (size_t index = 0; index < simplifiedIndices.size(); index++) {
+                simplifiedIndices[index] = static_cast<Index>(index);
+            }
+            simplified.appendGeometry(std::move(simplifiedVertices), std::move(simplifiedIndices));
+            simplified.finishBuilding(true);
+            return simplified;
+        }
+
+    private:
+        [[nodiscard]] static Normal calculateNormal(const Position& p1, const Position& p2, const Position& p3) {
+            Normal normal = (p2 - p1).cross(p3 - p1);
+            if (normal.lengthSquared() > 0.0f) normal.normalize();
+            return normal;
+        }
+    }; // class MeshSimplifier
+} // namespace GLESC::Render
@@ -0,0 +1,176 @@
+/**************************************************************************************************
+ * @file   VertexPacker.h
+ * @author Valentin Dumitru
+ * @date   2024-06-17
+ * @brief  Compact formats of the vertices in the GPU, and the conversion to them.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/core/low-level-renderer/buffers/VertexBufferLayout.h"
+#include "engine/subsystems/renderer/mesh/Vertex.h"
+
+namespace GLESC::Render {
+    /**
+     * @brief The format of the vertices of a mesh in the GPU.
+     * @details The mesh always keeps its vertices as ColorVertex in the CPU, the format only changes the data sent
+     * to the GPU. The shader receives the attributes converted to floats, so it doesn't depend on the format, except
+     * the quantized positions that need the USE_QUANTIZED_POSITIONS macro (@see VertexPacker::PositionDequantization).
+     */
+    enum class VertexFormat {
+        /**
+         * @brief The layout of ColorVertex: 3 floats position, 3 floats normal and 4 floats color, 40 bytes.
+         */
+        Float,
+        /**
+         * @brief Half float position, 10:10:10:2 normal and RGBA8 color, 16 bytes.
+         * @details The half floats have 11 bits of precision, so they're exact for the multiples of 0.5 below 1024
+         * (like the blocks of the terrain), but the error grows with the distance to the origin of the mesh.
+         */
+        Compact,
+        /**
+         * @brief 16 bits position relative to the bounding box of the mesh, 10:10:10:2 normal and RGBA8 color, 16 bytes.
+         * @details The precision is the size of the bounding box divided by 65534, the same everywhere in the mesh.
+         */
+        Quantized
+    };
+
+#pragma pack(push, 1)
+    /**
+     * @brief Vertex of the compact format. The position has a fourth unused component so the attributes stay
+     * aligned to 4 bytes.
+     */
+    struct CompactColorVertex {
+        uint16_t position[4];
+        uint32_t normal;
+        uint8_t color[4];
+    };
+
+    /**
+     * @brief Vertex of the quantized format. The position has a fourth unused component so the attributes stay
+     * aligned to 4 bytes.
+     */
+    struct QuantizedColorVertex {
+        int16_t position[4];
+        uint32_t normal;
+        uint8_t color[4];
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(CompactColorVertex) == 16, "The compact vertex must be 16 bytes");
+    static_assert(sizeof(QuantizedColorVertex) == 16, "The quantized vertex must be 16 bytes");
+
+    /**
+     * @brief Converts the vertices between the float format and the compact formats.
+     * @details The encodings are the ones OpenGL decodes by itself when the attribute is read, so no decoding is done in
+     * the shader. The normals and colors are normalized integers, and the positions half floats or normalized shorts.
+     */
+    class VertexPacker {
+    public:
+        /**
+         * @brief Transformation from the stored positions to the positions of the mesh:
+         * position = stored * scale + offset.
+         */
+        struct PositionDequantization {
+            Vec3F scale{1.0f, 1.0f, 1.0f};
+            Vec3F offset{0.0f, 0.0f, 0.0f};
+        };
+
+        /**
+         * @brief The vertices of a mesh in a GPU format, ready to be uploaded.
+         */
+        struct PackedVertices {
+            VertexFormat format = VertexFormat::Float;
+            std::vector<uint8_t> data;
+            size_t stride = 0;
+            PositionDequantization dequantization;
+
+            [[nodiscard]] size_t getCount() const { return stride == 0 ? 0 : data.size() / stride; }
+        };
+
+        /**
+         * @brief The largest difference between the original vertices and the packed ones.
+         */
+        struct ConversionError {
+            float position = 0.0f;
+            float normal = 0.0f;
+            /**
+             * @brief The error of the normalized color, between 0 and 1.
+             */
+            float color = 0.0f;
+        };
+
+        /**
+         * @brief Size in bytes of a vertex in the format.
+         */
+        [[nodiscard]] static size_t getStride(VertexFormat format);
+
+        /**
+         * @brief The attributes of the format, with the types and normalization of the vertex buffer.
+         * @details The attributes are always position, normal and color, in the locations 0, 1 and 2 of the shader.
+         */
+        [[nodiscard]] static const std::vector<GAPI::VertexBufferElement>& getLayout(VertexFormat format);
+
+        /**
+         * @brief The dequantization of the positions of the format for a mesh with the given bounds.
+         * @details Only the quantized format stores the positions relative to the bounds, the others store them as
+         * they are.
+         */
+        [[nodiscard]] static PositionDequantization getDequantization(VertexFormat format, const Position& min,
+                                                                      const Position& max);
+
+        /**
+         * @brief Converts the vertices to the format.
+         * @param vertices The vertices to convert.
+         * @param format The format of the result.
+         * @param min The minimum of the bounding box of the vertices, only used by the quantized format.
+         * @param max The maximum of the bounding box of the vertices, only used by the quantized format.
+         */
+        [[nodiscard]] static PackedVertices pack(const std::vector<ColorVertex>& vertices, VertexFormat format,
+                                                 const Position& min, const Position& max);
+
+        /**
+         * @brief Converts packed vertices back to the float format, as the shader would read them.
+         */
+        [[nodiscard]] static std::vector<ColorVertex> unpack(const PackedVertices& packed);
+
+        /**
+         * @brief Measures the error of converting the vertices to the format.
+         */
+        [[nodiscard]] static ConversionError measureError(const std::vector<ColorVertex>& vertices,
+                                                          VertexFormat format, const Position& min,
+                                                          const Position& max);
+
+        // ----------------------------------- Encodings -----------------------------------
+        /**
+         * @brief Converts a float to an IEEE 754 half float, rounding to the nearest even.
+         * @details The values too big for a half float become infinity, the ones too small zero.
+         */
+        [[nodiscard]] static uint16_t floatToHalf(float value);
+        [[nodiscard]] static float halfToFloat(uint16_t half);
+
+        /**
+         * @brief Converts a float in [-1, 1] to a normalized short, the values outside are clamped.
+         */
+        [[nodiscard]] static int16_t floatToSnorm16(float value);
+        [[nodiscard]] static float snorm16ToFloat(int16_t value);
+
+        /**
+         * @brief Packs a normal in the 2_10_10_10_REV format: x, y and z as 10 bits normalized integers from the least
+         * significant bit, the last 2 bits unused.
+         */
+        [[nodiscard]] static uint32_t packNormal(const Normal& normal);
+        [[nodiscard]] static Normal unpackNormal(uint32_t packed);
+
+        /**
+         * @brief Converts a normalized color to 8 bits per channel, in RGBA order.
+         */
+        static void packColor(const ColorRgbaNorm& color, uint8_t (&packed)[4]);
+        [[nodiscard]] static ColorRgba unpackColor(const uint8_t (&packed)[4]);
+    }; // class VertexPacker
+} // namespace GLESC::Render
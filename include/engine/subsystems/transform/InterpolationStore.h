@@ -0,0 +1,90 @@
+/**************************************************************************************************
+ * @file   InterpolationStore.h
+ * @author Valentin Dumitru
+ * @date   2024-06-25
+ * @brief  The previous and current transforms of many objects and their interpolation.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "engine/subsystems/transform/TransformStore.h"
+
+namespace GLESC::Transform {
+    /**
+     * @brief Keeps the transform of each object in the last two updates, to draw it between them.
+     * @details The objects are identified by a stable handle, like the id of their entity, which is the index of
+     * their transforms in dense structures of arrays. Pushing a transform is only a few stores, and the whole store
+     * is interpolated in a single vectorized pass.
+     * Unlike Interpolator it doesn't keep the Euler angles, so it's meant for the objects that are drawn with
+     * their model matrix, the rotation is interpolated with nlerp.
+     */
+    class InterpolationStore {
+    public:
+        using Handle = std::uint32_t;
+
+        /**
+         * @brief Sets the current transform of the object in this update, the previous one becomes the last.
+         * @details If the object wasn't pushed in the previous update, or it moved further than teleportDistance,
+         * it isn't interpolated and the last transform is the current one. Pushing the same object again in the
+         * same update only replaces its current transform.
+         */
+        void push(Handle handle, const Pose& pose);
+        void push(Handle handle, const Transform& transform);
+        /**
+         * @brief Starts a new update, the next pushes move the current transforms to the last ones.
+         */
+        void nextUpdate() { updateNumber++; }
+        /**
+         * @brief Forgets the object, the next push of its handle won't be interpolated.
+         */
+        void remove(Handle handle);
+        [[nodiscard]] bool contains(Handle handle) const;
+
+        /**
+         * @brief Interpolates the transforms of a single object.
+         * @param handle The object, it must have been pushed.
+         * @param alpha The fraction of the way from the last to the current transform, clamped to 1.
+         * @return The interpolated transform, with a unit quaternion.
+         */
+        [[nodiscard]] Pose interpolate(Handle handle, float alpha) const;
+        /**
+         * @brief Interpolates the objects of the handles [begin, end) into the same indices of the output.
+         * @details The output must have at least the size of the store. The quaternions aren't normalized, they are
+         * meant to be read by the batch matrices. Different ranges can be interpolated by different threads.
+         * @param alpha The fraction of the way from the last to the current transform, clamped to 1.
+         */
+        void interpolate(float alpha, size_t begin, size_t end, TransformStore& output) const;
+        /**
+         * @brief Interpolates every object, resizing the output to the size of the store.
+         */
+        void interpolate(float alpha, TransformStore& output) const;
+
+        /**
+         * @brief One past the highest handle pushed.
+         */
+        [[nodiscard]] size_t size() const { return current.size(); }
+        [[nodiscard]] const TransformStore& getLastTransforms() const { return last; }
+        [[nodiscard]] const TransformStore& getCurrentTransforms() const { return current; }
+
+        void clear();
+
+        /**
+         * @brief The objects that move further than this between two updates jump instead of being interpolated.
+         */
+        static constexpr float teleportDistance = 100.0f;
+
+    private:
+        TransformStore last;
+        TransformStore current;
+        /**
+         * @brief The update in which each handle was pushed last, 0 if it wasn't pushed.
+         */
+        std::vector<std::uint32_t> pushedIn;
+        std::uint32_t updateNumber = 1;
+    }; // class InterpolationStore
+} // namespace GLESC::Transform
@@ -38,9 +38,14 @@ namespace GLESC::Transform {
         Roll = static_cast<int>(Axis::Z)
     };
 
+    struct Interpolator;
+
     /**
      * @brief Struct that represents the position, rotation, and scale of an entity in the game world.
      * @details This is the component of Transform, and allows the entity to exist in the game world.
+     * The rotation is stored as a quaternion, which is what the model matrix is built from. The Euler angles in
+     * degrees are kept next to it for the code that works with angles (the camera, the game logic and the HUD), and
+     * both are updated together by the setters.
      */
     struct Transform : public EngineComponent {
         static Math::Direction worldUp;
@@ -48,7 +53,7 @@ namespace GLESC::Transform {
         static Math::Direction worldForward;
 
         Transform() {
-            modelMat.makeModelMatrix(position, rotationDegrees.toRads(), scale);
+            modelMat.makeModelMatrix(position, orientation, scale);
         }
 
 
@@ -61,43 +66,69 @@ namespace GLESC::Transform {
         Transform(Position position, Rotation rotation, Scale scale);
 
         const Position& getPosition() const { return position; }
+        /**
+         * @brief Returns the rotation as Euler angles in degrees.
+         */
         const Rotation& getRotation() const { return rotationDegrees; }
+        /**
+         * @brief Returns the rotation as a unit quaternion.
+         */
+        const Orientation& getOrientation() const {
+            syncDebugValues();
+            return orientation;
+        }
         const Scale& getScale() const { return scale; }
 
         void setPosition(const Position& position) {
             dirty = true;
+            modelDirty = true;
             translateDirty = true;
             this->position = position;
         }
 
         void setRotation(const Rotation& rotation) {
+            this->rotationDegrees = rotation;
+            setOrientationFromEuler();
+        }
+
+        /**
+         * @brief Sets the rotation from a quaternion.
+         * @details The Euler angles are recalculated from it, they can be different from the ones that were set
+         * before even if the rotation is the same, see Quaternion::toEuler.
+         * @param orientationParam The rotation, it's normalized.
+         */
+        void setOrientation(const Orientation& orientationParam) {
             dirty = true;
+            modelDirty = true;
             rotateDirty = true;
-            this->rotationDegrees = rotation;
+            orientation = orientationParam.normalize();
+            rotationDegrees = orientation.toEuler().toDegrees();
         }
 
         void setScale(const Scale& scale) {
             dirty = true;
+            modelDirty = true;
             scaleDirty = true;
             this->scale = scale;
         }
 
         void setPosition(Axis axis, PosComp value) {
             dirty = true;
+            modelDirty = true;
             translateDirty = true;
             int index = static_cast<int>(axis);
             position.set(index, value);
         }
 
         void setRotation(RotationAxis axis, RotComp value) {
-            dirty = true;
-            rotateDirty = true;
             int index = static_cast<int>(axis);
             rotationDegrees.set(index, value);
+            setOrientationFromEuler();
         }
 
         void setScale(Axis axis, ScaleComp value) {
             dirty = true;
+            modelDirty = true;
             scaleDirty = true;
             int index = static_cast<int>(axis);
             scale.set(index, value);
@@ -179,13 +210,15 @@ namespace GLESC::Transform {
 
         /**
          * @brief Returns the model matrix of the transform.
-         * @details Will not be recalculated if the transform has not changed as it is a heavy operation.
-         * It uses a dirty flag to check if the transform has changed.
+         * @details Will not be recalculated if the transform has not changed.
+         * It uses a dirty flag to check if the transform has changed. It's built directly from the quaternion, so it
+         * doesn't need any trigonometry.
          * @return The model matrix of the transform.
          */
         Render::Model getModelMatrix() const {
+            syncDebugValues();
             if (modelDirty) {
-                modelMat.makeModelMatrix(position, rotationDegrees.toRads(), scale);
+                modelMat.makeModelMatrix(position, orientation, scale);
                 modelDirty = false;
             }
             return modelMat;
@@ -198,6 +231,7 @@ namespace GLESC::Transform {
          * @return The translation matrix of the transform.
          */
         Render::TranslateMat getTranslationMatrix() const {
+            syncDebugValues();
             if (translateDirty) {
                 translateMat.makeTranslationMatrix(position);
                 translateDirty = false;
@@ -212,8 +246,9 @@ namespace GLESC::Transform {
          * @return The rotation matrix of the transform.
          */
         Render::RotateMat getRotationMatrix() const {
+            syncDebugValues();
             if (rotateDirty) {
-                rotateMat.makeRotationMatrix(rotationDegrees.toRads());
+                rotateMat.makeRotationMatrix(orientation);
                 rotateDirty = false;
             }
             return rotateMat;
@@ -226,6 +261,7 @@ namespace GLESC::Transform {
          * @return The scale matrix of the transform.
          */
         Render::ScaleMat getScaleMatrix() const {
+            syncDebugValues();
             if (scaleDirty) {
                 scaleMat.makeScaleMatrix(scale);
                 scaleDirty = false;
@@ -269,6 +305,44 @@ namespace GLESC::Transform {
         [[nodiscard]] std::string toString() const override;
 
     private:
+        friend struct Interpolator;
+
+        /**
+         * @brief Updates the quaternion after the Euler angles have been set.
+         */
+        void setOrientationFromEuler() {
+            dirty = true;
+            modelDirty = true;
+            rotateDirty = true;
+            orientation = Orientation::fromEuler(rotationDegrees.toRads());
+        }
+
+        /**
+         * @brief Sets both representations of the rotation without converting one into the other.
+         * @details Used by the interpolator, which interpolates each of them on its own.
+         */
+        void setInterpolatedRotation(const Rotation& rotation, const Orientation& orientationParam) {
+            dirty = true;
+            modelDirty = true;
+            rotateDirty = true;
+            rotationDegrees = rotation;
+            orientation = orientationParam;
+        }
+
+        /**
+         * @brief Applies the values edited from the HUD, which writes the members directly.
+         * @details The HUD edits the Euler angles, so the quaternion is recalculated from them.
+         */
+        void syncDebugValues() const {
+            if (!debugValuesEdited) return;
+            debugValuesEdited = false;
+            orientation = Orientation::fromEuler(rotationDegrees.toRads());
+            modelDirty = true;
+            translateDirty = true;
+            rotateDirty = true;
+            scaleDirty = true;
+        }
+
         /**
          * @brief Calculates the forward vector using the rotation.
          * @details This is a helper function for the forward function.
@@ -293,9 +367,14 @@ namespace GLESC::Transform {
          */
         Position position = Position(0.0f, 0.0f, 0.0f);
         /**
-         * @brief The rotation of the transform.
+         * @brief The rotation of the transform, as Euler angles in degrees.
          */
         Rotation rotationDegrees = Rotation(0.0f, 0.0f, 0.0f);
+        /**
+         * @brief The rotation of the transform, always the same rotation as rotationDegrees.
+         * @details It is mutable so the values edited from the HUD can be applied in the const getters.
+         */
+        mutable Orientation orientation;
         /**
          * @brief The scale of the transform.
          */
@@ -341,6 +420,10 @@ namespace GLESC::Transform {
         mutable bool scaleDirty = true;
 
         mutable bool dirty = true;
+        /**
+         * @brief Set by the HUD when it edits any of the values.
+         */
+        mutable bool debugValuesEdited = false;
     };
 
     /**
@@ -378,8 +461,8 @@ namespace GLESC::Transform {
 
         /**
          * @brief Transforms a bounding volume by a given transform.
-         * @details This function will transform all the points of the bounding volume by the given transform, iterating
-         * over all of them and applying the transform.
+         * @details The result is the axis-aligned box that encloses the transformed box, see the overload with the
+         * matrix.
          * @param boundingVolume The bounding volume to transform.
          * @param transform The transform to apply.
          * @return The transformed bounding volume.
@@ -388,8 +471,10 @@ namespace GLESC::Transform {
                                                             const Transform& transform);
         /**
          * @brief Transforms a bounding volume by a given matrix matrix.
-         * @details This function will transform all the points of the bounding volume by the given matrix,
-         * iterating over all of them and applying the matrix.
+         * @details The result is the smallest axis-aligned box that encloses the transformed box, so it stays
+         * correct when the matrix rotates. It uses Arvo's method, which transforms the center and the extent of the
+         * box instead of its corners.
+         * @cite James Arvo, Transforming Axis-Aligned Bounding Boxes, Graphics Gems, 1990.
          * @param boundingVolume The bounding volume to transform.
          * @param matrix The model matrix to apply.
          * @return The transformed bounding volume.
@@ -454,6 +539,9 @@ namespace GLESC::Transform {
         void pushTransform(const Transform& transform);
         /**
          * @brief Interpolates between the current and the last transform.
+         * @details The quaternions are interpolated with slerp, so the rotation takes the shortest arc even when the
+         * Euler angles wrap around. The Euler angles of the result are interpolated each on its shortest way, for
+         * the code that reads them instead of the model matrix.
          * @param alphaParam The alpha value of the interpolation (alpha is a value between 0 and 1 and represents the
          * percentage of the interpolation).
          * @return The interpolated transform.
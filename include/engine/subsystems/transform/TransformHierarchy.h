@@ -0,0 +1,137 @@
+/**************************************************************************************************
+ * @file   TransformHierarchy.h
+ * @author Valentin Dumitru
+ * @date   2024-06-23
+ * @brief  Parent and child relations between transforms and the update of their world transforms.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "engine/subsystems/transform/Transform.h"
+
+namespace GLESC::Transform {
+    /**
+     * @brief Tree of transforms, where the transform of each child is relative to the transform of its parent.
+     * @details The nodes are stored in arrays sorted so every parent comes before its children and every subtree is
+     * contiguous, so the world transforms are updated in a single linear pass. A node is only recomputed if its
+     * local transform changed or its parent was recomputed in the same pass, the rest of the tree isn't touched.
+     *
+     * The world transform is kept as a position, rotation and scale, which is what the rest of the engine works
+     * with. The scales multiply per axis, so a child rotated inside a parent with a non uniform scale doesn't get
+     * the shear the product of the matrices would have.
+     */
+    class TransformHierarchy {
+    public:
+        using NodeID = std::uint32_t;
+        static constexpr NodeID nullNode = std::numeric_limits<NodeID>::max();
+
+        using Pose = GLESC::Transform::Pose;
+
+        struct Stats {
+            size_t nodes = 0;
+            /**
+             * @brief Nodes whose world transform was recomputed in the last update.
+             */
+            size_t updatedNodes = 0;
+            /**
+             * @brief Times the nodes were sorted again because the relations changed.
+             */
+            size_t sorts = 0;
+        };
+
+        /**
+         * @brief Adds a node without a parent, with the identity as local transform.
+         */
+        void addNode(NodeID node);
+        /**
+         * @brief Removes a node, its children keep their local transform and become roots.
+         */
+        void removeNode(NodeID node);
+        [[nodiscard]] bool hasNode(NodeID node) const;
+
+        /**
+         * @brief Makes the local transform of the node relative to the parent.
+         * @details If the parent is the node or one of its descendants the hierarchy would have a cycle, so the
+         * parent is rejected and the node becomes a root.
+         * @param node The child node.
+         * @param parent The parent node, or nullNode to make the node a root.
+         * @return False if the parent was rejected.
+         */
+        bool setParent(NodeID node, NodeID parent);
+        [[nodiscard]] NodeID getParent(NodeID node) const;
+
+        /**
+         * @brief Sets the transform of the node relative to its parent, or to the world if it's a root.
+         * @details Nothing is recomputed if the transform is the same as the last one.
+         */
+        void setLocalPose(NodeID node, const Pose& pose);
+        void setLocalTransform(NodeID node, const Transform& transform);
+
+        /**
+         * @brief Recomputes the world transform of the nodes that changed and of their descendants.
+         */
+        void update();
+
+        /**
+         * @brief If the world transform of the node was recomputed in the last update.
+         */
+        [[nodiscard]] bool isWorldUpdated(NodeID node) const;
+        [[nodiscard]] const Pose& getWorldPose(NodeID node) const;
+        [[nodiscard]] const Render::Model& getWorldMatrix(NodeID node) const;
+        /**
+         * @brief Sets the position, rotation and scale of the transform to the world transform of the node.
+         */
+        void applyWorldPose(NodeID node, Transform& transform) const;
+
+        /**
+         * @brief The nodes in the order they are updated, parents before children.
+         */
+        [[nodiscard]] const std::vector<NodeID>& getUpdateOrder() const { return nodes; }
+        [[nodiscard]] const Stats& getStats() const { return stats; }
+
+        /**
+         * @brief Applies a local transform to the world transform of its parent.
+         */
+        [[nodiscard]] static Pose combine(const Pose& parentWorld, const Pose& local);
+
+    private:
+        static constexpr size_t noIndex = std::numeric_limits<size_t>::max();
+
+        [[nodiscard]] size_t indexOf(NodeID node) const;
+        /**
+         * @brief Sorts the nodes depth first, so the parents come before their children and the subtrees are
+         * contiguous. Siblings keep their relative order.
+         */
+        void sortNodes();
+
+        /**
+         * @brief The index of each node in the arrays below, indexed by the id of the node.
+         */
+        std::vector<size_t> nodeIndices;
+
+        // The arrays are in update order once sorted
+        std::vector<NodeID> nodes;
+        std::vector<NodeID> parents;
+        /**
+         * @brief The index of the parent of each node, only valid after sorting.
+         */
+        std::vector<size_t> parentIndices;
+        std::vector<Pose> localPoses;
+        std::vector<Pose> worldPoses;
+        std::vector<Render::Model> worldMatrices;
+        std::vector<std::uint8_t> localDirty;
+        std::vector<std::uint8_t> worldUpdated;
+
+        /**
+         * @brief Set when a node is added or removed or a relation changes.
+         */
+        bool orderDirty = false;
+        Stats stats;
+    }; // class TransformHierarchy
+} // namespace GLESC::Transform
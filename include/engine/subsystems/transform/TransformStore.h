@@ -0,0 +1,124 @@
+/**************************************************************************************************
+ * @file   TransformStore.h
+ * @author Valentin Dumitru
+ * @date   2024-06-24
+ * @brief  Transforms stored as a structure of arrays, the layout read by the batch matrix kernels.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "engine/subsystems/transform/Transform.h"
+
+namespace GLESC::Transform {
+    /**
+     * @brief Positions, rotations and scales of many objects, each component in its own contiguous array.
+     * @details Consecutive objects can be loaded into SIMD registers without shuffling, so the matrices of several
+     * objects are computed at once. Only the values that define the model matrix are stored, the rotation as the
+     * quaternion, the Euler angles and the cached matrices of Transform are left out. The quaternions don't need to
+     * be unit, like the ones interpolated without normalizing, the batch matrices normalize them.
+     * Setting different indices from different threads is safe once the store has its final size.
+     */
+    struct TransformStore {
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+        std::vector<float> orientationX;
+        std::vector<float> orientationY;
+        std::vector<float> orientationZ;
+        std::vector<float> orientationW;
+        std::vector<float> scaleX;
+        std::vector<float> scaleY;
+        std::vector<float> scaleZ;
+
+        void push_back(const Position& position, const Orientation& orientation, const Scale& scale) {
+            resize(size() + 1);
+            set(size() - 1, position, orientation, scale);
+        }
+
+        void push_back(const Transform& transform) {
+            push_back(transform.getPosition(), transform.getOrientation(), transform.getScale());
+        }
+
+        void set(size_t index, const Position& position, const Orientation& orientation, const Scale& scale) {
+            positionX[index] = position.getX();
+            positionY[index] = position.getY();
+            positionZ[index] = position.getZ();
+            orientationX[index] = orientation.getX();
+            orientationY[index] = orientation.getY();
+            orientationZ[index] = orientation.getZ();
+            orientationW[index] = orientation.getW();
+            scaleX[index] = scale.getX();
+            scaleY[index] = scale.getY();
+            scaleZ[index] = scale.getZ();
+        }
+
+        void set(size_t index, const Transform& transform) {
+            set(index, transform.getPosition(), transform.getOrientation(), transform.getScale());
+        }
+
+        void set(size_t index, const Pose& pose) {
+            set(index, pose.position, pose.orientation, pose.scale);
+        }
+
+        /**
+         * @brief Copies the transform of another store, or of another index of this one.
+         */
+        void set(size_t index, const TransformStore& source, size_t sourceIndex) {
+            positionX[index] = source.positionX[sourceIndex];
+            positionY[index] = source.positionY[sourceIndex];
+            positionZ[index] = source.positionZ[sourceIndex];
+            orientationX[index] = source.orientationX[sourceIndex];
+            orientationY[index] = source.orientationY[sourceIndex];
+            orientationZ[index] = source.orientationZ[sourceIndex];
+            orientationW[index] = source.orientationW[sourceIndex];
+            scaleX[index] = source.scaleX[sourceIndex];
+            scaleY[index] = source.scaleY[sourceIndex];
+            scaleZ[index] = source.scaleZ[sourceIndex];
+        }
+
+        [[nodiscard]] Pose getPose(size_t index) const {
+            return {
+                getPosition(index),
+                Orientation(orientationX[index], orientationY[index], orientationZ[index], orientationW[index]),
+                getScale(index)
+            };
+        }
+
+        [[nodiscard]] Position getPosition(size_t index) const {
+            return {positionX[index], positionY[index], positionZ[index]};
+        }
+
+        [[nodiscard]] Scale getScale(size_t index) const {
+            return {scaleX[index], scaleY[index], scaleZ[index]};
+        }
+
+        void resize(size_t count) {
+            for (std::vector<float>* component : components()) component->resize(count);
+        }
+
+        void reserve(size_t count) {
+            for (std::vector<float>* component : components()) component->reserve(count);
+        }
+
+        void clear() {
+            for (std::vector<float>* component : components()) component->clear();
+        }
+
+        [[nodiscard]] size_t size() const { return positionX.size(); }
+        [[nodiscard]] bool empty() const { return positionX.empty(); }
+
+    private:
+        [[nodiscard]] std::array<std::vector<float>*, 10> components() {
+            return {
+                &positionX, &positionY, &positionZ,
+                &orientationX, &orientationY, &orientationZ, &orientationW,
+                &scaleX, &scaleY, &scaleZ
+            };
+        }
+    }; // struct TransformStore
+} // namespace GLESC::Transform
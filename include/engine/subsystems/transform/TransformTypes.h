@@ -8,6 +8,7 @@
  * See LICENSE.txt in the project root for license information.
  **************************************************************************************************/
 #pragma once
+#include "engine/core/math/algebra/quaternion/Quaternion.h"
 #include "engine/core/math/algebra/vector/Vector.h"
 
 namespace GLESC::Transform {
@@ -41,6 +42,13 @@ namespace GLESC::Transform {
     using Rotation = Vec3F;
     using RotComp = Rotation::ValueType;
 
+    /**
+     * @brief Rotation in 3D space represented by a unit quaternion
+     * @details It's what the model matrix and the interpolation use, the Euler angles of Rotation are kept for the
+     * code that works with angles, like the camera or the HUD.
+     */
+    using Orientation = Math::Quaternion<RotComp>;
+
     /**
      * @brief Scale in 3D space
      * @details A scale in 3D space represented by a vector of 3 components
@@ -50,4 +58,20 @@ namespace GLESC::Transform {
      */
     using Scale = Vec3F;
     using ScaleComp = Scale::ValueType;
+
+    /**
+     * @brief The position, rotation and scale of an object, without the Euler angles and the cached matrices of
+     * Transform.
+     */
+    struct Pose {
+        Position position = Position(0.0f, 0.0f, 0.0f);
+        Orientation orientation;
+        Scale scale = Scale(1.0f, 1.0f, 1.0f);
+
+        [[nodiscard]] bool operator==(const Pose& other) const {
+            return position == other.position && orientation == other.orientation && scale == other.scale;
+        }
+
+        [[nodiscard]] bool operator!=(const Pose& other) const { return !(*this == other); }
+    };
 } // namespace GLESC::Transform
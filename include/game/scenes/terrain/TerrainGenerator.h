@@ -17,6 +17,7 @@
 #include "engine/core/math/algebra/vector/Vector.h"
 #include "engine/subsystems/renderer/RendererTypes.h"
 #include "engine/subsystems/renderer/mesh/Mesh.h"
+#include "engine/subsystems/renderer/mesh/MeshBuilder.h"
 #define CHUNK_SIZE 500
 #define MAP_SIZE_IN_CHUNKS 1
 #define CHUNK_HEIGHT 100
@@ -116,7 +117,13 @@ public:
     static GLESC::Render::ColorMesh generateChunkMeshFromMap(const Chunk& chunk, Vec2I chunkPosition,
                                                              const Map& map) {
         GLESC::Render::ColorMesh mesh;
+        // The faces are not used by the terrain, and they're a big part of the memory of the chunk
+        mesh.setStoreFaces(false);
+        // The corners of the blocks are multiples of 0.5 below 1024, the half floats of the compact format are exact
+        mesh.setVertexFormat(GLESC::Render::VertexFormat::Compact);
         mesh.startBuilding();
+        // Each thread adds its faces to its own staging buffer, so they don't wait for each other
+        GLESC::Render::ColorMeshBuilder builder;
         const Chunk& leftChunk = chunkPosition.getX() > 0
                                      ? map.at({chunkPosition.getX() - 1, chunkPosition.getY()})
                                      : chunk;
@@ -141,6 +148,7 @@ public:
                     if (currentTile.isEmpty()) continue; // Skip air blocks
 
                     GLESC::Render::ColorRgb color = getColorForTileType(currentTile.type);
+                    GLESC::Render::ColorMeshBuilder::Staging& staging = builder.getThreadStaging();
 
                     // Also, if the block is on the edge of the chunk, we need to check the neighboring chunks
 
@@ -165,32 +173,32 @@ public:
 
                     // Y axis
                     if (isThereAirOnTop) {
-                        putTopFace(mesh, color, x, y, z);
+                        putTopFace(staging, color, x, y, z);
                     }
                     if (isThereAirOnBottom) {
-                        putBottomFace(mesh, color, x, y, z);
+                        putBottomFace(staging, color, x, y, z);
                     }
 
 
                     // X axis
                     if (isThereAirOnRight) {
-                        putBackFace(mesh, color, x, y, z);
+                        putBackFace(staging, color, x, y, z);
                     }
                     if (isThereAirOnLeft) {
-                        putFrontFace(mesh, color, x, y, z);
+                        putFrontFace(staging, color, x, y, z);
                     }
 
                     // Z axis
                     if (isThereAirOnBack) {
-                        putLeftFace(mesh, color, x, y, z);
+                        putLeftFace(staging, color, x, y, z);
                     }
                     if (isThereAirOnFront) {
-                        putRightFace(mesh, color, x, y, z);
+                        putRightFace(staging, color, x, y, z);
                     }
                 }
             }
         }
-        mesh.finishBuilding();
+        builder.finishBuilding(mesh);
         return mesh;
     }
 
@@ -212,12 +220,12 @@ private:
         }
     }
 
-    static void putFace(GLESC::Render::ColorMesh& mesh,
+    static void putFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                         const GLESC::Render::ColorRgb& color, const GLESC::Render::Position& p1,
                         const GLESC::Render::Position& p2, const GLESC::Render::Position& p3,
                         const GLESC::Render::Position& p4, bool isTopFace) {
         if (isTopFace) {
-            mesh.addQuad(
+            staging.addQuad(
                 {p1, color},
                 {p2, color},
                 {p3, color},
@@ -225,7 +233,7 @@ private:
             );
         }
         else {
-            mesh.addQuad(
+            staging.addQuad(
                 {p4, color},
                 {p3, color},
                 {p2, color},
@@ -234,58 +242,58 @@ private:
         }
     }
 
-    static void putFrontFace(GLESC::Render::ColorMesh& mesh,
+    static void putFrontFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                              const GLESC::Render::ColorRgb& color, int posX, int posY, int posZ) {
         GLESC::Render::Position p1 = {posX - 0.5, posY + 0.5, posZ - 0.5};
         GLESC::Render::Position p2 = {posX - 0.5, posY + 0.5, posZ + 0.5};
         GLESC::Render::Position p3 = {posX - 0.5, posY - 0.5, posZ + 0.5};
         GLESC::Render::Position p4 = {posX - 0.5, posY - 0.5, posZ - 0.5};
-        putFace(mesh, color, p1, p2, p3, p4, false);
+        putFace(staging, color, p1, p2, p3, p4, false);
     }
 
-    static void putBackFace(GLESC::Render::ColorMesh& mesh,
+    static void putBackFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                             const GLESC::Render::ColorRgb& color, int posX, int posY, int posZ) {
         GLESC::Render::Position p1 = {posX + 0.5, posY + 0.5, posZ - 0.5};
         GLESC::Render::Position p2 = {posX + 0.5, posY + 0.5, posZ + 0.5};
         GLESC::Render::Position p3 = {posX + 0.5, posY - 0.5, posZ + 0.5};
         GLESC::Render::Position p4 = {posX + 0.5, posY - 0.5, posZ - 0.5};
-        putFace(mesh, color, p1, p2, p3, p4, true);
+        putFace(staging, color, p1, p2, p3, p4, true);
     }
 
-    static void putLeftFace(GLESC::Render::ColorMesh& mesh,
+    static void putLeftFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                             const GLESC::Render::ColorRgb& color, int posX, int posY, int posZ) {
         GLESC::Render::Position p1 = {posX - 0.5, posY + 0.5, posZ - 0.5};
         GLESC::Render::Position p2 = {posX + 0.5, posY + 0.5, posZ - 0.5};
         GLESC::Render::Position p3 = {posX + 0.5, posY - 0.5, posZ - 0.5};
         GLESC::Render::Position p4 = {posX - 0.5, posY - 0.5, posZ - 0.5};
-        putFace(mesh, color, p1, p2, p3, p4, true);
+        putFace(staging, color, p1, p2, p3, p4, true);
     }
 
-    static void putRightFace(GLESC::Render::ColorMesh& mesh,
+    static void putRightFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                              const GLESC::Render::ColorRgb& color, int posX, int posY, int posZ) {
         GLESC::Render::Position p1 = {posX - 0.5, posY + 0.5, posZ + 0.5};
         GLESC::Render::Position p2 = {posX + 0.5, posY + 0.5, posZ + 0.5};
         GLESC::Render::Position p3 = {posX + 0.5, posY - 0.5, posZ + 0.5};
         GLESC::Render::Position p4 = {posX - 0.5, posY - 0.5, posZ + 0.5};
-        putFace(mesh, color, p1, p2, p3, p4, false);
+        putFace(staging, color, p1, p2, p3, p4, false);
     }
 
-    static void putTopFace(GLESC::Render::ColorMesh& mesh,
+    static void putTopFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                            const GLESC::Render::ColorRgb& color, int posX, int posY, int posZ) {
         GLESC::Render::Position p1 = {posX - 0.5, posY + 0.5, posZ - 0.5};
         GLESC::Render::Position p2 = {posX + 0.5, posY + 0.5, posZ - 0.5};
         GLESC::Render::Position p3 = {posX + 0.5, posY + 0.5, posZ + 0.5};
         GLESC::Render::Position p4 = {posX - 0.5, posY + 0.5, posZ + 0.5};
-        putFace(mesh, color, p1, p2, p3, p4, false);
+        putFace(staging, color, p1, p2, p3, p4, false);
     }
 
-    static void putBottomFace(GLESC::Render::ColorMesh& mesh,
+    static void putBottomFace(GLESC::Render::ColorMeshBuilder::Staging& staging,
                               const GLESC::Render::ColorRgb& color, int posX, int posY, int posZ) {
         GLESC::Render::Position p1 = {posX - 0.5, posY - 0.5, posZ - 0.5};
         GLESC::Render::Position p2 = {posX + 0.5, posY - 0.5, posZ - 0.5};
         GLESC::Render::Position p3 = {posX + 0.5, posY - 0.5, posZ + 0.5};
         GLESC::Render::Position p4 = {posX - 0.5, posY - 0.5, posZ + 0.5};
-        putFace(mesh, color, p1, p2, p3, p4, true);
+        putFace(staging, color, p1, p2, p3, p4, true);
     }
 
     std::array<GLESC::Render::ColorMesh, MAP_SIZE_IN_CHUNKS * MAP_SIZE_IN_CHUNKS> chunkMeshes;
@@ -23,6 +23,7 @@
 #include "engine/ecs/frontend/system/systems/SunSystem.h"
 #include "engine/scene/Scene.h"
 #include "engine/subsystems/sound/SoundPlayer.h"
+#include "engine/res-mng/models/MeshCache.h"
 using namespace GLESC;
 
 Engine::Engine(FPSManager& fpsManager) :
@@ -39,27 +40,44 @@ Engine::Engine(FPSManager& fpsManager) :
     sceneManager(entityFactory, windowManager),
     sceneContainer(windowManager, entityFactory, inputManager, sceneManager, hudManager, engineCamera),
     physicsManager(fpsManager),
-    game(sceneManager, sceneContainer) {
+    game(sceneManager, sceneContainer),
+    renderThread(windowManager.getWindow(), [this](double timeOfFrame) { renderFrame(timeOfFrame); }) {
     engineCamera.setupCamera();
     engineCamera.setEngineHuds(&engineHuds);
     this->registerStats();
     SoundPlayer::init();
     createEngineEntities();
     game.init();
+#if GLESC_MULTITHREADED_RENDERING
+    // Everything that needs the context in the main thread has been created, the render thread takes it from here
+    renderThread.start();
+#endif
 }
 
 Engine::~Engine() {
+    // The context must be back in the main thread before the subsystems destroy their GPU resources
+    renderThread.stop();
     SoundPlayer::cleanup();
 }
 
 
 void Engine::processInput(float timeOfFrame) {
     Logger::get().importantInfoBlue("Engine processInput started");
+    // The HUD input and the window resizing need the context
+    Render::RenderThread::ExclusiveAccess renderAccess(renderThread);
     inputManager.update(running);
     Logger::get().importantInfoBlue("Engine processInput finished");
 }
 
 void Engine::render(double const timeOfFrame) {
+#if GLESC_MULTITHREADED_RENDERING
+    renderThread.requestFrame(timeOfFrame);
+#else
+    renderFrame(timeOfFrame);
+#endif
+}
+
+void Engine::renderFrame(double const timeOfFrame) {
     Logger::get().importantInfoPurple("Engine render started");
     renderer.start(timeOfFrame);
     renderer.render(timeOfFrame);
@@ -70,32 +88,38 @@ void Engine::render(double const timeOfFrame) {
 
 void Engine::update() {
     Logger::get().importantInfoWhite("Engine update started");
-
-    hudManager.update();
-    game.update();
-    for (ECS::EntityID id : ecs.getEntitiesToBeDestroyed()) {
+    {
+        // The HUD and the game modify data read while rendering (the meshes are shared through the mesh registry,
+        // so destroying entities doesn't destroy the meshes of the snapshot being rendered)
+        Render::RenderThread::ExclusiveAccess renderAccess(renderThread);
+        hudManager.update();
+        game.update();
+        for (ECS::EntityID id : ecs.getEntitiesToBeDestroyed()) {
 #ifndef NDEBUG_GLESC
-        EntityListManager::entityRemoved(ecs.getEntityName(id));
+            EntityListManager::entityRemoved(ecs.getEntityName(id));
 #endif
-        if (ecs.hasComponent<ECS::RenderComponent>(id) && ecs.hasComponent<ECS::TransformComponent>(id)) {
-            renderer.remove(ecs.getComponent<ECS::RenderComponent>(id).getMesh(),
-                            ecs.getComponent<ECS::TransformComponent>(id).transform);
+            // The id can be reused by a new entity, which must not be interpolated from this one
+            if (ecs.hasComponent<ECS::TransformComponent>(id)) {
+                renderer.remove(id);
+            }
         }
-    }
-    ecs.destroyEntities();
+        ecs.destroyEntities();
+        Console::log("Debug log message");
+        Console::warn("Debug warning message");
+        Console::error("Debug error message");
 #ifndef NDEBUG_GLESC
-    // We need to clear the hud items (Sun, Fog, etc) here, if not called here, juttering will occur
-    // Or we will get memory leaks
-    HudItemsManager::clearItems();
+        // We need to clear the hud items (Sun, Fog, etc) here, if not called here, juttering will occur
+        // Or we will get memory leaks
+        HudItemsManager::clearItems();
+        // The debug HUD reads the components while it's rendered, so the systems can't run at the same time
+        updateSystems();
 #endif
-
-
-    for (auto& system : systems) {
-        system->update();
     }
-    // This tells the renderer that all the data it needs to render has been updated
-    // (Update and render are decoupled, therefore not necesarily consecutive)
-    renderer.setRendererUpdated();
+#ifdef NDEBUG_GLESC
+    // Only the snapshot is read while rendering, so the systems can run while the last frame is rendered
+    updateSystems();
+#endif
+
     for (const auto& [name,id] : ecs.getAllEntities()) {
         if (ecs.isEntityInstanced(name))
             if ((engineCamera.getEntity().getComponent<ECS::TransformComponent>().transform.getPosition().distance(
@@ -103,17 +127,24 @@ void Engine::update() {
                 ecs.markForDestruction(id);
             }
     }
-    Console::log("Debug log message");
-    Console::warn("Debug warning message");
-    Console::error("Debug error message");
 
     Logger::get().importantInfoWhite("Engine update finished");
 }
 
+void Engine::updateSystems() {
+    for (auto& system : systems) {
+        system->update();
+    }
+    // This hands all the data the renderer needs to the render side
+    // (Update and render are decoupled, therefore not necesarily consecutive)
+    renderer.publishSnapshot();
+}
+
 std::vector<std::unique_ptr<ECS::System>> Engine::createSystems() {
     std::vector<std::unique_ptr<ECS::System>> systems;
-    systems.push_back(std::make_unique<ECS::RenderSystem>(renderer, ecs));
+    // The transform system places the children on their parents before the renderer reads them
     systems.push_back(std::make_unique<ECS::TransformSystem>(ecs));
+    systems.push_back(std::make_unique<ECS::RenderSystem>(renderer, ecs));
     // Physics system must update before the physics collision system
     systems.push_back(std::make_unique<ECS::PhysicsSystem>(physicsManager, ecs));
     systems.push_back(std::make_unique<ECS::PhysicsCollisionSystem>(physicsManager, collisionManager, ecs));
@@ -167,6 +198,48 @@ void Engine::registerStats() const {
     StatsManager::registerStatSource("Mesh Render Counter", [&]() -> std::string {
         return Stringer::toString(renderer.getMeshRenderCount());
     });
+    StatsManager::registerStatSource("Triangles per frame", [&]() -> std::string {
+        return Stringer::toString(renderer.getTriangleRenderCount());
+    });
+    StatsManager::registerStatSource("Culling (visible meshes / tested nodes / batch tested): ", [&]() -> std::string {
+        const Math::AABBTree::QueryStats& cullingStats = renderer.getCullingStats();
+        return Stringer::toString(renderer.getVisibleMeshCount()) + " / " +
+            Stringer::toString(cullingStats.testedNodes) + " / " +
+            Stringer::toString(cullingStats.deferredLeaves);
+    });
+    StatsManager::registerStatSource("Static batches (objects / clusters / visible / rebuilds): ",
+                                     [&]() -> std::string {
+        const Render::StaticBatcher::Stats staticStats = renderer.getStaticBatchStats();
+        return Stringer::toString(staticStats.objects) + " / " + Stringer::toString(staticStats.clusters) + " / " +
+            Stringer::toString(renderer.getVisibleStaticClusterCount()) + " / " +
+            Stringer::toString(staticStats.rebuiltGroups);
+    });
+    StatsManager::registerStatSource("Indirect draws (draws / multi draws / rejected): ", [&]() -> std::string {
+        const Render::IndirectDrawer::Stats& indirectStats = renderer.getIndirectDrawStats();
+        return Stringer::toString(indirectStats.draws) + " / " + Stringer::toString(indirectStats.multiDraws) +
+            " / " + Stringer::toString(indirectStats.rejectedDraws);
+    });
+    StatsManager::registerStatSource("Streamed per frame (KB / total stalls): ", [&]() -> std::string {
+        const Render::IndirectDrawer::Stats& indirectStats = renderer.getIndirectDrawStats();
+        return Stringer::toString(indirectStats.streamedBytes / 1024) + " / " +
+            Stringer::toString(indirectStats.streamingStalls);
+    });
+    StatsManager::registerStatSource("Meshes (unique / references / memory KB / GPU KB): ", [&]() -> std::string {
+        const Render::MeshRegistry::Stats meshStats = Render::MeshRegistry::get().getStats();
+        return Stringer::toString(meshStats.uniqueMeshes) + " / " +
+            Stringer::toString(meshStats.references) + " / " +
+            Stringer::toString(meshStats.cpuBytes / 1024) + " / " +
+            Stringer::toString(meshStats.gpuBytes / 1024);
+    });
+    StatsManager::registerStatSource("Mesh uploads (count / total ms): ", [&]() -> std::string {
+        const Render::MeshRegistry::Stats meshStats = Render::MeshRegistry::get().getStats();
+        return Stringer::toString(meshStats.uploads) + " / " + Stringer::toString(meshStats.uploadMillis);
+    });
+    StatsManager::registerStatSource("Mesh cache (hits / misses / load ms / create ms): ", [&]() -> std::string {
+        const MeshCache::Stats cacheStats = MeshCache::get().getStats();
+        return Stringer::toString(cacheStats.hits) + " / " + Stringer::toString(cacheStats.misses) + " / " +
+            Stringer::toString(cacheStats.loadMillis) + " / " + Stringer::toString(cacheStats.createMillis);
+    });
     StatsManager::registerStatSource("Pressed Keys: ", [&]() -> std::string {
         std::string keys = "[";
         for (const auto& key : inputManager.getPressedKeys()) {
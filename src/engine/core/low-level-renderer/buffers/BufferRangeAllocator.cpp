@@ -0,0 +1,71 @@
+#include "engine/core/low-level-renderer/buffers/BufferRangeAllocator.h"
+
+#include "engine/core/asserts/Asserts.h"
+
+using namespace GLESC::GAPI;
+
+BufferRangeAllocator::BufferRangeAllocator(size_t capacityParam) : capacity(capacityParam) {
+    reset();
+}
+
+void BufferRangeAllocator::reset() {
+    freeByOffset.clear();
+    freeBySize.clear();
+    used = 0;
+    if (capacity > 0) insertFreeRange(0, capacity);
+}
+
+size_t BufferRangeAllocator::getLargestFreeRange() const {
+    return freeBySize.empty() ? 0 : freeBySize.rbegin()->first;
+}
+
+void BufferRangeAllocator::insertFreeRange(size_t offset, size_t size) {
+    freeByOffset.emplace(offset, size);
+    freeBySize.emplace(size, offset);
+}
+
+void BufferRangeAllocator::eraseFreeRange(std::map<size_t, size_t>::iterator freeRange) {
+    freeBySize.erase({freeRange->second, freeRange->first});
+    freeByOffset.erase(freeRange);
+}
+
+BufferRangeAllocator::Allocation BufferRangeAllocator::allocate(size_t size) {
+    D_ASSERT_TRUE(size > 0, "Can't allocate an empty range");
+    // The smallest free range that fits, the lowest offset among the ones of the same size
+    auto bestFit = freeBySize.lower_bound({size, 0});
+    if (bestFit == freeBySize.end()) return {};
+
+    const auto [freeSize, freeOffset] = *bestFit;
+    eraseFreeRange(freeByOffset.find(freeOffset));
+    if (freeSize > size) insertFreeRange(freeOffset + size, freeSize - size);
+    used += size;
+    return {freeOffset, size};
+}
+
+void BufferRangeAllocator::free(const Allocation& allocation) {
+    D_ASSERT_TRUE(allocation.isValid(), "Can't free an invalid allocation");
+    D_ASSERT_TRUE(allocation.offset + allocation.size <= capacity, "The allocation isn't from this allocator");
+    size_t offset = allocation.offset;
+    size_t size = allocation.size;
+
+    // Merges with the free range after it
+    auto next = freeByOffset.lower_bound(offset);
+    D_ASSERT_TRUE(next == freeByOffset.end() || next->first >= offset + size, "The range is already free");
+    if (next != freeByOffset.end() && next->first == offset + size) {
+        size += next->second;
+        eraseFreeRange(next);
+    }
+    // Merges with the free range before it
+    auto previous = freeByOffset.lower_bound(offset);
+    if (previous != freeByOffset.begin()) {
+        --previous;
+        D_ASSERT_TRUE(previous->first + previous->second <= offset, "The range is already free");
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            eraseFreeRange(previous);
+        }
+    }
+    insertFreeRange(offset, size);
+    used -= allocation.size;
+}
@@ -0,0 +1,83 @@
+#include "engine/core/low-level-renderer/buffers/StreamingRing.h"
+
+#include "engine/core/asserts/Asserts.h"
+#include "engine/core/exceptions/core/low-level-renderer/GAPIException.h"
+
+using namespace GLESC::GAPI;
+
+StreamingRing::StreamingRing(IGraphicInterface& gapiParam, Size regionSizeParam, UInt regionCountParam) :
+    gapi(gapiParam), regionSize(regionSizeParam), regionCount(regionCountParam),
+    regionFences(regionCountParam, nullptr) {
+    D_ASSERT_TRUE(regionSize > 0, "The regions can't be empty");
+    D_ASSERT_TRUE(regionCount > 0, "The ring needs at least a region");
+}
+
+StreamingRing::~StreamingRing() {
+    destroyGpuBuffers();
+}
+
+void StreamingRing::createBuffer() {
+    gapi.genBuffers(1, buffer);
+    // The copy targets aren't used by the draws, binding the buffer there doesn't change any other state
+    gapi.bindBuffer(Enums::BufferTypes::CopyWrite, buffer);
+    gapi.setPersistentBufferStorage(regionSize * regionCount, Enums::BufferTypes::CopyWrite);
+    mapping = static_cast<std::uint8_t*>(
+        gapi.mapPersistentBuffer(0, regionSize * regionCount, Enums::BufferTypes::CopyWrite));
+    bufferCreated = true;
+}
+
+void StreamingRing::destroyGpuBuffers() {
+    for (FenceID& fence : regionFences) {
+        if (fence == nullptr) continue;
+        gapi.deleteFence(fence);
+        fence = nullptr;
+    }
+    if (!bufferCreated) return;
+    gapi.bindBuffer(Enums::BufferTypes::CopyWrite, buffer);
+    gapi.unmapBuffer(Enums::BufferTypes::CopyWrite);
+    gapi.deleteBuffer(buffer);
+    mapping = nullptr;
+    bufferCreated = false;
+    currentRegion = 0;
+    regionCursor = 0;
+    regionAcquired = false;
+}
+
+void StreamingRing::acquireRegion() {
+    FenceID& fence = regionFences[currentRegion];
+    if (fence != nullptr) {
+        FenceWaitResult result = gapi.waitFence(fence, waitTimeoutNanoseconds);
+        while (result == FenceWaitResult::TimedOut) {
+            stalls++;
+            result = gapi.waitFence(fence, waitTimeoutNanoseconds);
+        }
+        gapi.deleteFence(fence);
+        fence = nullptr;
+        // The region stays unacquired, writing it could overwrite data the GPU is still reading
+        if (result == FenceWaitResult::Failed) throw GAPIException("Failed to wait for a region of the streaming ring");
+    }
+    regionAcquired = true;
+}
+
+StreamingRing::Allocation StreamingRing::allocate(Size size, Size alignment) {
+    D_ASSERT_TRUE(size > 0, "Can't allocate an empty range");
+    D_ASSERT_TRUE(alignment > 0, "The alignment can't be 0");
+    if (!bufferCreated) createBuffer();
+    if (!regionAcquired) acquireRegion();
+
+    // The alignment is of the offset in the whole buffer, the regions don't need to be aligned
+    const Size regionStart = currentRegion * regionSize;
+    const Size alignedOffset = (regionStart + regionCursor + alignment - 1) / alignment * alignment;
+    if (alignedOffset + size > regionStart + regionSize) return {};
+    regionCursor = alignedOffset + size - regionStart;
+    return {mapping + alignedOffset, alignedOffset, size};
+}
+
+void StreamingRing::endFrame() {
+    // A frame that didn't write anything leaves the region to the next one
+    if (!regionAcquired) return;
+    regionFences[currentRegion] = gapi.createFence();
+    currentRegion = (currentRegion + 1) % regionCount;
+    regionCursor = 0;
+    regionAcquired = false;
+}
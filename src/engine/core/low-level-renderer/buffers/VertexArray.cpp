@@ -35,14 +35,15 @@ void VertexArray::addBuffer(const VertexBuffer &vb, const VertexBufferLayout &la
         auto const &element = elements[i];
         auto const typeCount = static_cast<UInt>(getTypeCount(element.type));
         auto const type = getTypePrimitiveType(element.type);
-        auto const typeSize = static_cast<UInt>(getTypeSize(type));
+        // The size of the whole attribute, the components of the packed types don't have a size of their own
+        auto const elementSize = static_cast<UInt>(getTypeSize(element.type));
 
         // Enable the vertex attribute array
         getGAPI().enableVertexData(static_cast<UInt>(i));
         // Set up the vertex attribute pointers
         getGAPI().createVertexData(static_cast<UInt>(i), typeCount, type, element.normalized, stride, offset);
         // Calculate the offset for the next attribute
-        offset += typeCount * typeSize;
+        offset += elementSize;
     }
 }
 
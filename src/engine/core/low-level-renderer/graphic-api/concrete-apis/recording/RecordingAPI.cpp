@@ -0,0 +1,279 @@
+#include "engine/core/low-level-renderer/graphic-api/concrete-apis/recording/RecordingAPI.h"
+
+#include "engine/core/asserts/Asserts.h"
+
+using namespace GLESC::GAPI;
+
+const std::vector<std::uint8_t>& RecordingAPI::getBufferBytes(UInt buffer) const {
+    auto bufferIt = buffers.find(buffer);
+    D_ASSERT_TRUE(bufferIt != buffers.end(), "The buffer doesn't exist");
+    return bufferIt->second;
+}
+
+std::vector<std::uint8_t> RecordingAPI::getBufferBytes(UInt buffer, Size offset, Size size) const {
+    const std::vector<std::uint8_t>& bytes = getBufferBytes(buffer);
+    D_ASSERT_TRUE(static_cast<size_t>(offset) + size <= bytes.size(), "The range is outside the buffer");
+    return {bytes.begin() + offset, bytes.begin() + offset + size};
+}
+
+const std::map<UInt, RecordingAPI::VertexAttribute>& RecordingAPI::getVertexAttributes(UInt vertexArray) const {
+    auto vertexArrayIt = vertexArrays.find(vertexArray);
+    D_ASSERT_TRUE(vertexArrayIt != vertexArrays.end(), "The vertex array doesn't exist");
+    return vertexArrayIt->second.attributes;
+}
+
+void RecordingAPI::clearColor(Float r, Float g, Float b, Float a) {
+    clearColorValue = RGBAColorNormalized(r, g, b, a);
+}
+
+RecordingAPI::DrawCall RecordingAPI::createDrawCall(DrawKind kind) const {
+    DrawCall drawCall;
+    drawCall.kind = kind;
+    drawCall.vertexArray = boundVertexArray;
+    auto vertexArrayIt = vertexArrays.find(boundVertexArray);
+    if (vertexArrayIt != vertexArrays.end()) drawCall.indexBuffer = vertexArrayIt->second.indexBuffer;
+    drawCall.shaderProgram = boundShaderProgram;
+    drawCall.storageBuffers = storageBuffers;
+    return drawCall;
+}
+
+void RecordingAPI::drawTriangles(UInt start, UInt count) {
+    DrawCall drawCall = createDrawCall(DrawKind::Triangles);
+    drawCall.start = start;
+    drawCall.count = count;
+    drawCalls.push_back(std::move(drawCall));
+}
+
+void RecordingAPI::drawTrianglesIndexed(UInt count) {
+    D_ASSERT_TRUE(boundVertexArray != 0, "No vertex array bound");
+    DrawCall drawCall = createDrawCall(DrawKind::TrianglesIndexed);
+    drawCall.count = count;
+    drawCalls.push_back(std::move(drawCall));
+}
+
+void RecordingAPI::drawTrianglesIndexedInstanced(UInt count, UInt instanceCount) {
+    D_ASSERT_TRUE(boundVertexArray != 0, "No vertex array bound");
+    DrawCall drawCall = createDrawCall(DrawKind::TrianglesIndexedInstanced);
+    drawCall.count = count;
+    drawCall.instanceCount = instanceCount;
+    drawCalls.push_back(std::move(drawCall));
+}
+
+void RecordingAPI::multiDrawTrianglesIndexedIndirect(UInt firstCommand, UInt drawCount) {
+    D_ASSERT_TRUE(boundVertexArray != 0, "No vertex array bound");
+    const std::vector<std::uint8_t>& indirectBuffer = getBoundBuffer(Enums::BufferTypes::DrawIndirect);
+    const size_t commandBytes = sizeof(DrawElementsIndirectCommand);
+    D_ASSERT_TRUE((static_cast<size_t>(firstCommand) + drawCount) * commandBytes <= indirectBuffer.size(),
+                  "The indirect buffer doesn't have the commands drawn");
+    DrawCall drawCall = createDrawCall(DrawKind::MultiTrianglesIndexedIndirect);
+    drawCall.start = firstCommand;
+    drawCall.count = drawCount;
+    drawCall.commands.resize(drawCount);
+    std::memcpy(drawCall.commands.data(), indirectBuffer.data() + firstCommand * commandBytes,
+                drawCount * commandBytes);
+    drawCalls.push_back(std::move(drawCall));
+}
+
+RGBAColor RecordingAPI::readPixelColor([[maybe_unused]] int x, [[maybe_unused]] int y) {
+    return RGBAColor(static_cast<UByte>(clearColorValue.r * 255.0f), static_cast<UByte>(clearColorValue.g * 255.0f),
+                     static_cast<UByte>(clearColorValue.b * 255.0f), static_cast<UByte>(clearColorValue.a * 255.0f));
+}
+
+Bool RecordingAPI::isBuffer(UInt bufferID) {
+    return buffers.count(bufferID) > 0 ? Bool::True : Bool::False;
+}
+
+void RecordingAPI::genBuffers(UInt amount, UInt& bufferID) {
+    D_ASSERT_EQUAL(amount, 1u, "Only one buffer can be generated at a time");
+    bufferID = nextObjectId++;
+    buffers[bufferID];
+}
+
+void RecordingAPI::bindBuffer(Enums::BufferTypes bufferType, UInt buffer) {
+    D_ASSERT_TRUE(buffer == 0 || buffers.count(buffer) > 0, "The buffer doesn't exist");
+    boundBuffers[bufferType] = buffer;
+    // The index buffer binding is stored in the vertex array
+    if (bufferType == Enums::BufferTypes::Index && boundVertexArray != 0) {
+        vertexArrays[boundVertexArray].indexBuffer = buffer;
+    }
+}
+
+void RecordingAPI::deleteBuffer(UInt& buffer) {
+    buffers.erase(buffer);
+    persistentBuffers.erase(buffer);
+    for (auto& [bufferType, boundBuffer] : boundBuffers) {
+        if (boundBuffer == buffer) boundBuffer = 0;
+    }
+}
+
+std::vector<std::uint8_t>& RecordingAPI::getBoundBuffer(Enums::BufferTypes bufferType) {
+    auto boundIt = boundBuffers.find(bufferType);
+    D_ASSERT_TRUE(boundIt != boundBuffers.end() && boundIt->second != 0, "No buffer bound to the target");
+    return buffers.at(boundIt->second);
+}
+
+void RecordingAPI::setDynamicBufferData(UInt size, Enums::BufferTypes bufferType) {
+    getBoundBuffer(bufferType).assign(size, 0);
+}
+
+void RecordingAPI::setBufferData(const Void* data, Size count, Size size, Enums::BufferTypes bufferType,
+                                 [[maybe_unused]] Enums::BufferUsages bufferUsage) {
+    D_ASSERT_EQUAL(persistentBuffers.count(boundBuffers[bufferType]), 0u, "The persistent buffers can't be resized");
+    std::vector<std::uint8_t>& buffer = getBoundBuffer(bufferType);
+    const size_t bytes = static_cast<size_t>(count) * size;
+    buffer.assign(bytes, 0);
+    if (data != nullptr) std::memcpy(buffer.data(), data, bytes);
+    uploadedBytes += bytes;
+}
+
+void RecordingAPI::setBufferSubData(const Void* data, Size offset, Size size, Enums::BufferTypes bufferType) {
+    D_ASSERT_EQUAL(persistentBuffers.count(boundBuffers[bufferType]), 0u,
+                   "The persistent buffers are only written through their mapping");
+    std::vector<std::uint8_t>& buffer = getBoundBuffer(bufferType);
+    D_ASSERT_TRUE(static_cast<size_t>(offset) + size <= buffer.size(), "The range is outside the buffer");
+    std::memcpy(buffer.data() + offset, data, size);
+    uploadedBytes += size;
+}
+
+void RecordingAPI::bindBufferBase(Enums::BufferTypes bufferType, UInt index, UInt buffer) {
+    D_ASSERT_TRUE(buffers.count(buffer) > 0, "The buffer doesn't exist");
+    boundBuffers[bufferType] = buffer;
+    if (bufferType == Enums::BufferTypes::ShaderStorage) storageBuffers[index] = {buffer, 0, 0};
+}
+
+void RecordingAPI::bindBufferRange(Enums::BufferTypes bufferType, UInt index, UInt buffer, Size offset,
+                                   Size size) {
+    D_ASSERT_TRUE(static_cast<size_t>(offset) + size <= getBufferBytes(buffer).size(),
+                  "The range is outside the buffer");
+    D_ASSERT_TRUE(bufferType != Enums::BufferTypes::ShaderStorage || offset % storageBufferOffsetAlignment == 0,
+                  "The offset isn't aligned as the storage buffers require");
+    boundBuffers[bufferType] = buffer;
+    if (bufferType == Enums::BufferTypes::ShaderStorage) storageBuffers[index] = {buffer, offset, size};
+}
+
+void RecordingAPI::setPersistentBufferStorage(Size size, Enums::BufferTypes bufferType) {
+    const UInt buffer = boundBuffers[bufferType];
+    D_ASSERT_EQUAL(persistentBuffers.count(buffer), 0u, "The storage of a buffer can only be set once");
+    // The mappings point into the vector, so it's never resized again
+    getBoundBuffer(bufferType).assign(size, 0);
+    persistentBuffers.insert(buffer);
+}
+
+Void* RecordingAPI::mapPersistentBuffer(Size offset, Size size, Enums::BufferTypes bufferType) {
+    D_ASSERT_EQUAL(persistentBuffers.count(boundBuffers[bufferType]), 1u, "Only the persistent buffers are mapped");
+    std::vector<std::uint8_t>& buffer = getBoundBuffer(bufferType);
+    D_ASSERT_TRUE(static_cast<size_t>(offset) + size <= buffer.size(), "The range is outside the buffer");
+    return buffer.data() + offset;
+}
+
+void RecordingAPI::unmapBuffer(Enums::BufferTypes bufferType) {
+    D_ASSERT_EQUAL(persistentBuffers.count(boundBuffers[bufferType]), 1u, "Only the persistent buffers are mapped");
+}
+
+void RecordingAPI::copyBufferSubData(UInt readBuffer, UInt writeBuffer, Size readOffset, Size writeOffset,
+                                     Size size) {
+    const std::vector<std::uint8_t>& source = buffers.at(readBuffer);
+    std::vector<std::uint8_t>& destination = buffers.at(writeBuffer);
+    D_ASSERT_TRUE(static_cast<size_t>(readOffset) + size <= source.size(), "The range is outside the source");
+    D_ASSERT_TRUE(static_cast<size_t>(writeOffset) + size <= destination.size(),
+                  "The range is outside the destination");
+    std::memmove(destination.data() + writeOffset, source.data() + readOffset, size);
+    copiedBytes += size;
+}
+
+FenceID RecordingAPI::createFence() {
+    // The fences are never dereferenced, any unique address works
+    const auto fence = reinterpret_cast<FenceID>(nextFenceId++);
+    fences[fence] = fenceLatency;
+    return fence;
+}
+
+FenceWaitResult RecordingAPI::waitFence(FenceID fence, [[maybe_unused]] std::uint64_t timeoutNanoseconds) {
+    auto fenceIt = fences.find(fence);
+    D_ASSERT_TRUE(fenceIt != fences.end(), "The fence doesn't exist");
+    if (fenceWaitsFail) return FenceWaitResult::Failed;
+    if (fenceIt->second == 0) return FenceWaitResult::Signaled;
+    fenceIt->second--;
+    fenceTimeouts++;
+    return FenceWaitResult::TimedOut;
+}
+
+void RecordingAPI::deleteFence(FenceID fence) {
+    const size_t erased = fences.erase(fence);
+    D_ASSERT_EQUAL(erased, 1u, "The fence doesn't exist");
+}
+
+void RecordingAPI::genVertexArray(UInt& vertexArrayID) {
+    vertexArrayID = nextObjectId++;
+    vertexArrays[vertexArrayID];
+}
+
+void RecordingAPI::setVertexAttribDivisor(UInt index, UInt divisor) {
+    D_ASSERT_TRUE(boundVertexArray != 0, "No vertex array bound");
+    vertexArrays[boundVertexArray].attributes[index].divisor = divisor;
+}
+
+void RecordingAPI::bindVertexArray(UInt vertexArrayID) {
+    D_ASSERT_TRUE(vertexArrayID == 0 || vertexArrays.count(vertexArrayID) > 0, "The vertex array doesn't exist");
+    boundVertexArray = vertexArrayID;
+}
+
+void RecordingAPI::deleteVertexArray(UInt& vertexArrayID) {
+    vertexArrays.erase(vertexArrayID);
+    if (boundVertexArray == vertexArrayID) boundVertexArray = 0;
+}
+
+void RecordingAPI::enableVertexData(UInt index) {
+    D_ASSERT_TRUE(boundVertexArray != 0, "No vertex array bound");
+    vertexArrays[boundVertexArray].attributes[index].enabled = true;
+}
+
+void RecordingAPI::createVertexData(UInt vertexArray, UInt count, Enums::Types type, Bool isNormalized,
+                                    UInt stride, UInt offset) {
+    // Like glVertexAttribPointer, the first parameter is the location of the attribute in the bound vertex array
+    D_ASSERT_TRUE(boundVertexArray != 0, "No vertex array bound");
+    VertexAttribute& attribute = vertexArrays[boundVertexArray].attributes[vertexArray];
+    attribute.buffer = boundBuffers[Enums::BufferTypes::Vertex];
+    attribute.count = count;
+    attribute.type = type;
+    attribute.normalized = isNormalized;
+    attribute.stride = stride;
+    attribute.offset = offset;
+}
+
+TextureID RecordingAPI::createTexture([[maybe_unused]] Enums::Texture::Types textureType,
+                                      [[maybe_unused]] Enums::Texture::Filters::Min minFilter,
+                                      [[maybe_unused]] Enums::Texture::Filters::Mag magFilter,
+                                      [[maybe_unused]] Enums::Texture::Filters::WrapMode wrapS,
+                                      [[maybe_unused]] Enums::Texture::Filters::WrapMode wrapT,
+                                      [[maybe_unused]] Enums::Texture::Filters::WrapMode wrapR) {
+    const TextureID textureID = nextObjectId++;
+    textures[textureID];
+    textureCache.insert(textureID);
+    boundTexture = textureID;
+    return textureID;
+}
+
+void RecordingAPI::setTextureData([[maybe_unused]] Enums::Texture::Types textureType, Int level, UInt width,
+                                  UInt height, [[maybe_unused]] Enums::Texture::CPUBufferFormat inputFormat,
+                                  Enums::Texture::BitDepth bitsPerPixel, const UByte* texelBuffer) {
+    D_ASSERT_TRUE(anyTextureBound() == Bool::True, "No texture bound");
+    // Only the base level is stored
+    if (level != 0) return;
+    TextureState& texture = textures.at(boundTexture);
+    texture.width = width;
+    texture.height = height;
+    const size_t bytes = static_cast<size_t>(width) * height * (static_cast<size_t>(bitsPerPixel) / 8);
+    texture.texels.assign(texelBuffer, texelBuffer + bytes);
+}
+
+std::vector<UByte> RecordingAPI::getTextureData(TextureID textureID,
+                                                [[maybe_unused]] Enums::Texture::Types textureType) {
+    return textures.at(textureID).texels;
+}
+
+void RecordingAPI::deleteTexture(TextureID textureID) {
+    textures.erase(textureID);
+    textureCache.erase(textureID);
+    if (boundTexture == textureID) boundTexture = 0;
+}
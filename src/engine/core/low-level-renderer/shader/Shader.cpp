@@ -16,6 +16,12 @@ inline std::vector<std::string> macrosToString(const std::vector<Shader::ShaderM
         case Shader::USE_INSTANCE:
             result.emplace_back("USE_INSTANCE");
             break;
+        case Shader::USE_QUANTIZED_POSITIONS:
+            result.emplace_back("USE_QUANTIZED_POSITIONS");
+            break;
+        case Shader::USE_MULTI_DRAW:
+            result.emplace_back("USE_MULTI_DRAW");
+            break;
         }
     }
     return result;
@@ -0,0 +1,282 @@
+#include "engine/core/math/geometry/AABBTree.h"
+
+#include <algorithm>
+
+using namespace GLESC::Math;
+
+namespace {
+    using AABB = AABBTree::AABB;
+
+    /**
+     * @brief Half of the surface area, it's the cost used to choose where to insert the leaves (the ratio between
+     * areas is what matters, so the factor 2 is not needed).
+     */
+    float halfSurfaceArea(const AABB& aabb) {
+        const float width = aabb.max.getX() - aabb.min.getX();
+        const float height = aabb.max.getY() - aabb.min.getY();
+        const float depth = aabb.max.getZ() - aabb.min.getZ();
+        return width * height + height * depth + depth * width;
+    }
+}
+
+AABBTree::ProxyId AABBTree::createProxy(const AABB& aabb, size_t userData) {
+    const ProxyId proxyId = allocateNode();
+    Node& node = nodes[proxyId];
+    node.aabb = fatten(aabb);
+    node.userData = userData;
+    node.height = 0;
+    insertLeaf(proxyId);
+    proxyCount++;
+    return proxyId;
+}
+
+void AABBTree::destroyProxy(ProxyId proxyId) {
+    D_ASSERT_TRUE(isLeaf(proxyId), "Proxy id is not a leaf of the tree");
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    proxyCount--;
+}
+
+bool AABBTree::moveProxy(ProxyId proxyId, const AABB& aabb) {
+    D_ASSERT_TRUE(isLeaf(proxyId), "Proxy id is not a leaf of the tree");
+    const AABB& fatAABB = nodes[proxyId].aabb;
+    if (fatAABB.encloses(aabb)) {
+        // A fat box much bigger than the object would make the queries accept it when it's far from the volume
+        AABB hugeAABB = aabb;
+        for (size_t axis = 0; axis < 3; axis++) {
+            hugeAABB.min.set(axis, aabb.min.get(axis) - 4.0f * margin);
+            hugeAABB.max.set(axis, aabb.max.get(axis) + 4.0f * margin);
+        }
+        if (hugeAABB.encloses(fatAABB)) return false;
+    }
+
+    removeLeaf(proxyId);
+    nodes[proxyId].aabb = fatten(aabb);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void AABBTree::clear() {
+    nodes.clear();
+    root = nullNode;
+    freeList = nullNode;
+    proxyCount = 0;
+}
+
+AABB AABBTree::fatten(const AABB& aabb) const {
+    AABB fatAABB;
+    for (size_t axis = 0; axis < 3; axis++) {
+        fatAABB.min.set(axis, aabb.min.get(axis) - margin);
+        fatAABB.max.set(axis, aabb.max.get(axis) + margin);
+    }
+    return fatAABB;
+}
+
+AABBTree::ProxyId AABBTree::allocateNode() {
+    if (freeList == nullNode) {
+        nodes.emplace_back();
+        return static_cast<ProxyId>(nodes.size() - 1);
+    }
+    const ProxyId nodeId = freeList;
+    freeList = nodes[nodeId].parentOrNext;
+    nodes[nodeId] = Node();
+    return nodeId;
+}
+
+void AABBTree::freeNode(ProxyId nodeId) {
+    nodes[nodeId].parentOrNext = freeList;
+    nodes[nodeId].height = -1;
+    freeList = nodeId;
+}
+
+void AABBTree::insertLeaf(ProxyId leaf) {
+    if (root == nullNode) {
+        root = leaf;
+        nodes[root].parentOrNext = nullNode;
+        return;
+    }
+
+    // Find the best sibling by descending the tree, choosing the child that increases less the surface area
+    const AABB leafAABB = nodes[leaf].aabb;
+    ProxyId index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+        const float area = halfSurfaceArea(node.aabb);
+        const float combinedArea = halfSurfaceArea(node.aabb.combine(leafAABB));
+
+        // Cost of creating a new parent for this node and the new leaf
+        const float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](ProxyId child) {
+            const Node& childNode = nodes[child];
+            const float newArea = halfSurfaceArea(childNode.aabb.combine(leafAABB));
+            if (childNode.isLeaf()) return newArea + inheritanceCost;
+            return newArea - halfSurfaceArea(childNode.aabb) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    const ProxyId sibling = index;
+
+    // Create a new parent for the sibling and the leaf
+    const ProxyId oldParent = nodes[sibling].parentOrNext;
+    const ProxyId newParent = allocateNode();
+    nodes[newParent].parentOrNext = oldParent;
+    nodes[newParent].aabb = leafAABB.combine(nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parentOrNext = newParent;
+    nodes[leaf].parentOrNext = newParent;
+
+    if (oldParent == nullNode) {
+        root = newParent;
+    }
+    else if (nodes[oldParent].child1 == sibling) {
+        nodes[oldParent].child1 = newParent;
+    }
+    else {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(nodes[leaf].parentOrNext);
+}
+
+void AABBTree::removeLeaf(ProxyId leaf) {
+    if (leaf == root) {
+        root = nullNode;
+        return;
+    }
+
+    const ProxyId parent = nodes[leaf].parentOrNext;
+    const ProxyId grandParent = nodes[parent].parentOrNext;
+    const ProxyId sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    // The sibling takes the place of the parent
+    if (grandParent == nullNode) {
+        root = sibling;
+        nodes[sibling].parentOrNext = nullNode;
+        freeNode(parent);
+        return;
+    }
+    if (nodes[grandParent].child1 == parent) {
+        nodes[grandParent].child1 = sibling;
+    }
+    else {
+        nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parentOrNext = grandParent;
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+void AABBTree::refitAncestors(ProxyId nodeId) {
+    ProxyId index = nodeId;
+    while (index != nullNode) {
+        index = balance(index);
+
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.aabb = child1.aabb.combine(child2.aabb);
+
+        index = node.parentOrNext;
+    }
+}
+
+AABBTree::ProxyId AABBTree::balance(ProxyId nodeId) {
+    Node& a = nodes[nodeId];
+    if (a.isLeaf() || a.height < 2) return nodeId;
+
+    const ProxyId bId = a.child1;
+    const ProxyId cId = a.child2;
+    Node& b = nodes[bId];
+    Node& c = nodes[cId];
+
+    const int heightDifference = c.height - b.height;
+
+    // The higher child (upper) takes the place of the node, the node keeps the lower subtree of that child and the
+    // higher subtree stays with the child
+    auto rotateUp = [&](ProxyId upperId, Node& upper, Node& other, bool upperIsChild1) {
+        const ProxyId fId = upper.child1;
+        const ProxyId gId = upper.child2;
+        Node& f = nodes[fId];
+        Node& g = nodes[gId];
+
+        upper.child1 = nodeId;
+        upper.parentOrNext = a.parentOrNext;
+        a.parentOrNext = upperId;
+
+        if (upper.parentOrNext == nullNode) {
+            root = upperId;
+        }
+        else if (nodes[upper.parentOrNext].child1 == nodeId) {
+            nodes[upper.parentOrNext].child1 = upperId;
+        }
+        else {
+            nodes[upper.parentOrNext].child2 = upperId;
+        }
+
+        const bool keepF = f.height > g.height;
+        const ProxyId keptId = keepF ? fId : gId;
+        const ProxyId movedId = keepF ? gId : fId;
+        Node& kept = nodes[keptId];
+        Node& moved = nodes[movedId];
+
+        upper.child2 = keptId;
+        if (upperIsChild1) {
+            a.child1 = movedId;
+        }
+        else {
+            a.child2 = movedId;
+        }
+        moved.parentOrNext = nodeId;
+
+        a.aabb = other.aabb.combine(moved.aabb);
+        upper.aabb = a.aabb.combine(kept.aabb);
+        a.height = 1 + std::max(other.height, moved.height);
+        upper.height = 1 + std::max(a.height, kept.height);
+    };
+
+    if (heightDifference > 1) {
+        rotateUp(cId, c, b, false);
+        return cId;
+    }
+    if (heightDifference < -1) {
+        rotateUp(bId, b, c, true);
+        return bId;
+    }
+    return nodeId;
+}
+
+bool AABBTree::isValid() const {
+    if (root == nullNode) return proxyCount == 0;
+    if (nodes[root].parentOrNext != nullNode) return false;
+
+    size_t freeCount = 0;
+    for (ProxyId freeNodeId = freeList; freeNodeId != nullNode; freeNodeId = nodes[freeNodeId].parentOrNext) {
+        freeCount++;
+    }
+    // A tree with n leaves has n - 1 internal nodes
+    if (nodes.size() - freeCount != 2 * proxyCount - 1) return false;
+    return isSubtreeValid(root, nullNode);
+}
+
+bool AABBTree::isSubtreeValid(ProxyId nodeId, ProxyId parent) const {
+    const Node& node = nodes[nodeId];
+    if (node.parentOrNext != parent) return false;
+    if (node.isLeaf()) return node.height == 0 && node.child2 == nullNode;
+
+    const Node& child1 = nodes[node.child1];
+    const Node& child2 = nodes[node.child2];
+    if (node.height != 1 + std::max(child1.height, child2.height)) return false;
+    if (!node.aabb.encloses(child1.aabb) || !node.aabb.encloses(child2.aabb)) return false;
+    return isSubtreeValid(node.child1, nodeId) && isSubtreeValid(node.child2, nodeId);
+}
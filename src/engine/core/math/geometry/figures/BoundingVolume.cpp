@@ -87,8 +87,8 @@ void GLESC::Math::BoundingVolume::updateBoundingBox(const void* data, const unsi
         maxVec.z() = std::max(maxVec.z(), z);
     }
 
-    // Check if the bounding volume is valid (not empty)
-    if (minVec.x() >= maxVec.x() || minVec.y() >= maxVec.y() || minVec.z() >= maxVec.z()) {
+    // Check if the bounding volume is valid (not empty). Flat boxes are valid, they are the bounds of flat meshes
+    if (minVec.x() > maxVec.x() || minVec.y() > maxVec.y() || minVec.z() > maxVec.z()) {
         return;
     }
 
@@ -0,0 +1,440 @@
+#include "engine/core/math/geometry/figures/plane/PlaneSet.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GLESC_GEOMETRY_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(GLESC_GEOMETRY_SSE) && defined(__GNUC__)
+#define GLESC_GEOMETRY_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace GLESC::Math;
+
+namespace {
+    using PackedPlane = std::array<float, 4>;
+    using PackedPlanes = std::vector<PackedPlane>;
+
+    /**
+     * @brief Pointers to the components of the points processed by a kernel.
+     */
+    struct PointComponents {
+        const float* x;
+        const float* y;
+        const float* z;
+    };
+
+    /**
+     * @brief Pointers to the components of the segments processed by a kernel.
+     */
+    struct SegmentComponents {
+        const float* startX;
+        const float* startY;
+        const float* startZ;
+        const float* endX;
+        const float* endY;
+        const float* endZ;
+    };
+
+    float planeSide(const PackedPlane& plane, float x, float y, float z) {
+        return plane[0] * x + plane[1] * y + plane[2] * z + plane[3];
+    }
+
+    // ------------------------------------------------ Scalar kernels ------------------------------------------------
+
+    void insideScalar(const PackedPlanes& planes, const PointComponents& points, size_t begin, size_t end,
+                      std::uint8_t* insideOut) {
+        for (size_t pointIndex = begin; pointIndex < end; pointIndex++) {
+            std::uint8_t inside = 1;
+            for (const PackedPlane& plane : planes) {
+                if (!(planeSide(plane, points.x[pointIndex], points.y[pointIndex], points.z[pointIndex]) > 0.0f)) {
+                    inside = 0;
+                    break;
+                }
+            }
+            insideOut[pointIndex] = inside;
+        }
+    }
+
+    void distancesScalar(const PackedPlane& plane, const PointComponents& points, size_t begin, size_t end,
+                         float* distancesOut) {
+        for (size_t pointIndex = begin; pointIndex < end; pointIndex++) {
+            distancesOut[pointIndex] = planeSide(plane, points.x[pointIndex], points.y[pointIndex],
+                                                 points.z[pointIndex]);
+        }
+    }
+
+    void clipScalar(const PackedPlanes& planes, const SegmentComponents& segments, size_t begin, size_t end,
+                    float* enterOut, float* exitOut, std::uint8_t* intersectsOut) {
+        for (size_t segmentIndex = begin; segmentIndex < end; segmentIndex++) {
+            float enter = 0.0f;
+            float exit = 1.0f;
+            bool rejected = false;
+            for (const PackedPlane& plane : planes) {
+                const float startSide = planeSide(plane, segments.startX[segmentIndex], segments.startY[segmentIndex],
+                                                  segments.startZ[segmentIndex]);
+                const float endSide = planeSide(plane, segments.endX[segmentIndex], segments.endY[segmentIndex],
+                                                segments.endZ[segmentIndex]);
+                if (startSide > 0.0f) {
+                    if (!(endSide > 0.0f)) {
+                        const float crossing = startSide / (startSide - endSide);
+                        exit = crossing < exit ? crossing : exit;
+                    }
+                }
+                else if (endSide > 0.0f) {
+                    const float crossing = startSide / (startSide - endSide);
+                    enter = crossing > enter ? crossing : enter;
+                }
+                else {
+                    // Both ends are outside this plane, so no part of the segment is inside the region
+                    rejected = true;
+                    break;
+                }
+            }
+            enterOut[segmentIndex] = enter;
+            exitOut[segmentIndex] = exit;
+            intersectsOut[segmentIndex] = static_cast<std::uint8_t>(!rejected && enter <= exit);
+        }
+    }
+
+    // -------------------------------------------------- SSE kernels -------------------------------------------------
+
+#ifdef GLESC_GEOMETRY_SSE
+    // Same operation order as the scalar kernels, so the results are identical
+    __m128 planeSideSSE(const PackedPlane& plane, __m128 x, __m128 y, __m128 z) {
+        __m128 side = _mm_mul_ps(_mm_set1_ps(plane[0]), x);
+        side = _mm_add_ps(side, _mm_mul_ps(_mm_set1_ps(plane[1]), y));
+        side = _mm_add_ps(side, _mm_mul_ps(_mm_set1_ps(plane[2]), z));
+        return _mm_add_ps(side, _mm_set1_ps(plane[3]));
+    }
+
+    __m128 selectSSE(__m128 mask, __m128 selected, __m128 other) {
+        return _mm_or_ps(_mm_and_ps(mask, selected), _mm_andnot_ps(mask, other));
+    }
+
+    void storeMaskSSE(__m128 mask, std::uint8_t* out) {
+        const int bits = _mm_movemask_ps(mask);
+        for (int lane = 0; lane < 4; lane++) {
+            out[lane] = static_cast<std::uint8_t>((bits >> lane) & 1);
+        }
+    }
+#endif
+
+    void insideSSE(const PackedPlanes& planes, const PointComponents& points, size_t begin, size_t end,
+                   std::uint8_t* insideOut) {
+        size_t pointIndex = begin;
+#ifdef GLESC_GEOMETRY_SSE
+        const __m128 zero = _mm_setzero_ps();
+        for (; pointIndex + 4 <= end; pointIndex += 4) {
+            const __m128 x = _mm_loadu_ps(points.x + pointIndex);
+            const __m128 y = _mm_loadu_ps(points.y + pointIndex);
+            const __m128 z = _mm_loadu_ps(points.z + pointIndex);
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const PackedPlane& plane : planes) {
+                inside = _mm_and_ps(inside, _mm_cmpgt_ps(planeSideSSE(plane, x, y, z), zero));
+            }
+            storeMaskSSE(inside, insideOut + pointIndex);
+        }
+#endif
+        // The remaining points, or all of them without SSE
+        insideScalar(planes, points, pointIndex, end, insideOut);
+    }
+
+    void distancesSSE(const PackedPlane& plane, const PointComponents& points, size_t begin, size_t end,
+                      float* distancesOut) {
+        size_t pointIndex = begin;
+#ifdef GLESC_GEOMETRY_SSE
+        for (; pointIndex + 4 <= end; pointIndex += 4) {
+            const __m128 distance = planeSideSSE(plane, _mm_loadu_ps(points.x + pointIndex),
+                                                 _mm_loadu_ps(points.y + pointIndex),
+                                                 _mm_loadu_ps(points.z + pointIndex));
+            _mm_storeu_ps(distancesOut + pointIndex, distance);
+        }
+#endif
+        distancesScalar(plane, points, pointIndex, end, distancesOut);
+    }
+
+    void clipSSE(const PackedPlanes& planes, const SegmentComponents& segments, size_t begin, size_t end,
+                 float* enterOut, float* exitOut, std::uint8_t* intersectsOut) {
+        size_t segmentIndex = begin;
+#ifdef GLESC_GEOMETRY_SSE
+        const __m128 zero = _mm_setzero_ps();
+        for (; segmentIndex + 4 <= end; segmentIndex += 4) {
+            const __m128 startX = _mm_loadu_ps(segments.startX + segmentIndex);
+            const __m128 startY = _mm_loadu_ps(segments.startY + segmentIndex);
+            const __m128 startZ = _mm_loadu_ps(segments.startZ + segmentIndex);
+            const __m128 endX = _mm_loadu_ps(segments.endX + segmentIndex);
+            const __m128 endY = _mm_loadu_ps(segments.endY + segmentIndex);
+            const __m128 endZ = _mm_loadu_ps(segments.endZ + segmentIndex);
+            __m128 enter = zero;
+            __m128 exit = _mm_set1_ps(1.0f);
+            __m128 accepted = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const PackedPlane& plane : planes) {
+                const __m128 startSide = planeSideSSE(plane, startX, startY, startZ);
+                const __m128 endSide = planeSideSSE(plane, endX, endY, endZ);
+                const __m128 startInside = _mm_cmpgt_ps(startSide, zero);
+                const __m128 endInside = _mm_cmpgt_ps(endSide, zero);
+                // The lanes where both ends are on the same side divide by zero, their crossing is never selected
+                const __m128 crossing = _mm_div_ps(startSide, _mm_sub_ps(startSide, endSide));
+                exit = selectSSE(_mm_andnot_ps(endInside, startInside), _mm_min_ps(crossing, exit), exit);
+                enter = selectSSE(_mm_andnot_ps(startInside, endInside), _mm_max_ps(crossing, enter), enter);
+                accepted = _mm_and_ps(accepted, _mm_or_ps(startInside, endInside));
+            }
+            _mm_storeu_ps(enterOut + segmentIndex, enter);
+            _mm_storeu_ps(exitOut + segmentIndex, exit);
+            storeMaskSSE(_mm_and_ps(accepted, _mm_cmple_ps(enter, exit)), intersectsOut + segmentIndex);
+        }
+#endif
+        clipScalar(planes, segments, segmentIndex, end, enterOut, exitOut, intersectsOut);
+    }
+
+    // ------------------------------------------------- AVX2 kernels -------------------------------------------------
+
+#ifdef GLESC_GEOMETRY_AVX2
+    // Multiply and add separately (no FMA), so the results are identical to the scalar kernels
+    __attribute__((target("avx2")))
+    __m256 planeSideAVX2(const PackedPlane& plane, __m256 x, __m256 y, __m256 z) {
+        __m256 side = _mm256_mul_ps(_mm256_set1_ps(plane[0]), x);
+        side = _mm256_add_ps(side, _mm256_mul_ps(_mm256_set1_ps(plane[1]), y));
+        side = _mm256_add_ps(side, _mm256_mul_ps(_mm256_set1_ps(plane[2]), z));
+        return _mm256_add_ps(side, _mm256_set1_ps(plane[3]));
+    }
+
+    __attribute__((target("avx2")))
+    void storeMaskAVX2(__m256 mask, std::uint8_t* out) {
+        const int bits = _mm256_movemask_ps(mask);
+        for (int lane = 0; lane < 8; lane++) {
+            out[lane] = static_cast<std::uint8_t>((bits >> lane) & 1);
+        }
+    }
+#endif
+
+#ifdef GLESC_GEOMETRY_AVX2
+    __attribute__((target("avx2")))
+#endif
+    void insideAVX2(const PackedPlanes& planes, const PointComponents& points, size_t begin, size_t end,
+                    std::uint8_t* insideOut) {
+        size_t pointIndex = begin;
+#ifdef GLESC_GEOMETRY_AVX2
+        const __m256 zero = _mm256_setzero_ps();
+        for (; pointIndex + 8 <= end; pointIndex += 8) {
+            const __m256 x = _mm256_loadu_ps(points.x + pointIndex);
+            const __m256 y = _mm256_loadu_ps(points.y + pointIndex);
+            const __m256 z = _mm256_loadu_ps(points.z + pointIndex);
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const PackedPlane& plane : planes) {
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(planeSideAVX2(plane, x, y, z), zero, _CMP_GT_OQ));
+            }
+            storeMaskAVX2(inside, insideOut + pointIndex);
+        }
+#endif
+        // The remaining points use the narrower kernel
+        insideSSE(planes, points, pointIndex, end, insideOut);
+    }
+
+#ifdef GLESC_GEOMETRY_AVX2
+    __attribute__((target("avx2")))
+#endif
+    void distancesAVX2(const PackedPlane& plane, const PointComponents& points, size_t begin, size_t end,
+                       float* distancesOut) {
+        size_t pointIndex = begin;
+#ifdef GLESC_GEOMETRY_AVX2
+        for (; pointIndex + 8 <= end; pointIndex += 8) {
+            const __m256 distance = planeSideAVX2(plane, _mm256_loadu_ps(points.x + pointIndex),
+                                                  _mm256_loadu_ps(points.y + pointIndex),
+                                                  _mm256_loadu_ps(points.z + pointIndex));
+            _mm256_storeu_ps(distancesOut + pointIndex, distance);
+        }
+#endif
+        distancesSSE(plane, points, pointIndex, end, distancesOut);
+    }
+
+#ifdef GLESC_GEOMETRY_AVX2
+    __attribute__((target("avx2")))
+#endif
+    void clipAVX2(const PackedPlanes& planes, const SegmentComponents& segments, size_t begin, size_t end,
+                  float* enterOut, float* exitOut, std::uint8_t* intersectsOut) {
+        size_t segmentIndex = begin;
+#ifdef GLESC_GEOMETRY_AVX2
+        const __m256 zero = _mm256_setzero_ps();
+        for (; segmentIndex + 8 <= end; segmentIndex += 8) {
+            const __m256 startX = _mm256_loadu_ps(segments.startX + segmentIndex);
+            const __m256 startY = _mm256_loadu_ps(segments.startY + segmentIndex);
+            const __m256 startZ = _mm256_loadu_ps(segments.startZ + segmentIndex);
+            const __m256 endX = _mm256_loadu_ps(segments.endX + segmentIndex);
+            const __m256 endY = _mm256_loadu_ps(segments.endY + segmentIndex);
+            const __m256 endZ = _mm256_loadu_ps(segments.endZ + segmentIndex);
+            __m256 enter = zero;
+            __m256 exit = _mm256_set1_ps(1.0f);
+            __m256 accepted = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const PackedPlane& plane : planes) {
+                const __m256 startSide = planeSideAVX2(plane, startX, startY, startZ);
+                const __m256 endSide = planeSideAVX2(plane, endX, endY, endZ);
+                const __m256 startInside = _mm256_cmp_ps(startSide, zero, _CMP_GT_OQ);
+                const __m256 endInside = _mm256_cmp_ps(endSide, zero, _CMP_GT_OQ);
+                const __m256 crossing = _mm256_div_ps(startSide, _mm256_sub_ps(startSide, endSide));
+                exit = _mm256_blendv_ps(exit, _mm256_min_ps(crossing, exit),
+                                        _mm256_andnot_ps(endInside, startInside));
+                enter = _mm256_blendv_ps(enter, _mm256_max_ps(crossing, enter),
+                                         _mm256_andnot_ps(startInside, endInside));
+                accepted = _mm256_and_ps(accepted, _mm256_or_ps(startInside, endInside));
+            }
+            _mm256_storeu_ps(enterOut + segmentIndex, enter);
+            _mm256_storeu_ps(exitOut + segmentIndex, exit);
+            storeMaskAVX2(_mm256_and_ps(accepted, _mm256_cmp_ps(enter, exit, _CMP_LE_OQ)),
+                          intersectsOut + segmentIndex);
+        }
+#endif
+        clipSSE(planes, segments, segmentIndex, end, enterOut, exitOut, intersectsOut);
+    }
+
+    PointComponents getComponents(const PointArrays& points) {
+        return {points.x.data(), points.y.data(), points.z.data()};
+    }
+
+    SegmentComponents getComponents(const SegmentArrays& segments) {
+        return {
+            segments.startX.data(), segments.startY.data(), segments.startZ.data(),
+            segments.endX.data(), segments.endY.data(), segments.endZ.data()
+        };
+    }
+} // namespace
+
+PlaneSet::PlaneSet(const std::vector<Plane>& planesParam) {
+    packedPlanes.reserve(planesParam.size());
+    for (const Plane& plane : planesParam) {
+        addPlane(plane);
+    }
+}
+
+PlaneSet::PlaneSet(const Polyhedron& convexPolyhedron) {
+    D_ASSERT_FALSE(convexPolyhedron.getFaces().empty(), "Polyhedron must have faces");
+    const Points& vertices = convexPolyhedron.getVertices();
+    const Point center = convexPolyhedron.getCenter();
+    packedPlanes.reserve(convexPolyhedron.getFaces().size());
+    for (const PolyhedronFace& face : convexPolyhedron.getFaces()) {
+        const FaceIndices& indices = face.getVertexIndices();
+        const Plane plane(vertices[indices[0]], vertices[indices[1]], vertices[indices[2]]);
+        if (plane.distanceToPoint(center) < 0) {
+            addPlane(Plane(-plane.getNormal(), -plane.getDistance()));
+        }
+        else {
+            addPlane(plane);
+        }
+    }
+}
+
+void PlaneSet::addPlane(const Plane& plane) {
+    const Direction& normal = plane.getNormal();
+    packedPlanes.push_back({normal.getX(), normal.getY(), normal.getZ(), plane.getDistance()});
+}
+
+Plane PlaneSet::getPlane(size_t index) const {
+    D_ASSERT_TRUE(index < packedPlanes.size(), "Plane index out of bounds");
+    const PackedPlane& plane = packedPlanes[index];
+    return Plane(Direction(plane[0], plane[1], plane[2]), plane[3]);
+}
+
+bool PlaneSet::hasInside(const Point& point) const {
+    for (const PackedPlane& plane : packedPlanes) {
+        if (!(planeSide(plane, point.getX(), point.getY(), point.getZ()) > 0.0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PlaneSet::hasInside(const PointArrays& points, std::uint8_t* insideOut, GeometryKernel kernel) const {
+    D_ASSERT_TRUE(isKernelSupported(kernel), "Geometry kernel not supported by the processor");
+    const PointComponents components = getComponents(points);
+    switch (kernel) {
+    case GeometryKernel::Scalar:
+        insideScalar(packedPlanes, components, 0, points.size(), insideOut);
+        return;
+    case GeometryKernel::SSE:
+        insideSSE(packedPlanes, components, 0, points.size(), insideOut);
+        return;
+    case GeometryKernel::AVX2:
+        insideAVX2(packedPlanes, components, 0, points.size(), insideOut);
+        return;
+    }
+}
+
+void PlaneSet::hasInside(const PointArrays& points, std::uint8_t* insideOut) const {
+    hasInside(points, insideOut, getBestKernel());
+}
+
+void PlaneSet::distancesToPoints(size_t planeIndex, const PointArrays& points, float* distancesOut,
+                                 GeometryKernel kernel) const {
+    D_ASSERT_TRUE(isKernelSupported(kernel), "Geometry kernel not supported by the processor");
+    D_ASSERT_TRUE(planeIndex < packedPlanes.size(), "Plane index out of bounds");
+    const PointComponents components = getComponents(points);
+    const PackedPlane& plane = packedPlanes[planeIndex];
+    switch (kernel) {
+    case GeometryKernel::Scalar:
+        distancesScalar(plane, components, 0, points.size(), distancesOut);
+        return;
+    case GeometryKernel::SSE:
+        distancesSSE(plane, components, 0, points.size(), distancesOut);
+        return;
+    case GeometryKernel::AVX2:
+        distancesAVX2(plane, components, 0, points.size(), distancesOut);
+        return;
+    }
+}
+
+void PlaneSet::distancesToPoints(size_t planeIndex, const PointArrays& points, float* distancesOut) const {
+    distancesToPoints(planeIndex, points, distancesOut, getBestKernel());
+}
+
+void PlaneSet::clipSegments(const SegmentArrays& segments, float* enterOut, float* exitOut,
+                            std::uint8_t* intersectsOut, GeometryKernel kernel) const {
+    D_ASSERT_TRUE(isKernelSupported(kernel), "Geometry kernel not supported by the processor");
+    const SegmentComponents components = getComponents(segments);
+    switch (kernel) {
+    case GeometryKernel::Scalar:
+        clipScalar(packedPlanes, components, 0, segments.size(), enterOut, exitOut, intersectsOut);
+        return;
+    case GeometryKernel::SSE:
+        clipSSE(packedPlanes, components, 0, segments.size(), enterOut, exitOut, intersectsOut);
+        return;
+    case GeometryKernel::AVX2:
+        clipAVX2(packedPlanes, components, 0, segments.size(), enterOut, exitOut, intersectsOut);
+        return;
+    }
+}
+
+void PlaneSet::clipSegments(const SegmentArrays& segments, float* enterOut, float* exitOut,
+                            std::uint8_t* intersectsOut) const {
+    clipSegments(segments, enterOut, exitOut, intersectsOut, getBestKernel());
+}
+
+bool PlaneSet::isKernelSupported(GeometryKernel kernel) {
+    switch (kernel) {
+    case GeometryKernel::Scalar:
+        return true;
+    case GeometryKernel::SSE:
+#ifdef GLESC_GEOMETRY_SSE
+        return true;
+#else
+        return false;
+#endif
+    case GeometryKernel::AVX2:
+#ifdef GLESC_GEOMETRY_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+GeometryKernel PlaneSet::getBestKernel() {
+    static const GeometryKernel bestKernel = [] {
+        if (isKernelSupported(GeometryKernel::AVX2)) return GeometryKernel::AVX2;
+        if (isKernelSupported(GeometryKernel::SSE)) return GeometryKernel::SSE;
+        return GeometryKernel::Scalar;
+    }();
+    return bestKernel;
+}
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <engine/core/math/algebra/vector/VectorMixedAlgorithms.h>
 #include "engine/core/math/geometry/figures/polyhedron/Polyhedron.h"
+#include "engine/core/math/geometry/figures/plane/PlaneSet.h"
 
 using namespace GLESC::Math;
 
@@ -87,8 +89,7 @@ Point Polyhedron::getCenter() const {
 }
 
 [[nodiscard]] bool Polyhedron::hasInside(const Point& point) const {
-    (void)point;
-    D_ASSERT_TRUE(false, "Not implemented");
+    return PlaneSet(*this).hasInside(point);
 }
 
 [[nodiscard]] bool Polyhedron::hasInside(const PolyhedronFace& face) {
@@ -101,21 +102,13 @@ Point Polyhedron::getCenter() const {
 }
 
 [[nodiscard]] bool Polyhedron::hasAnyVertexInside(const Polyhedron& polyhedron) const {
-    for (const auto& vertex : polyhedron.getVertices()) {
-        if (hasInside(vertex)) {
-            return true;
-        }
-    }
-    return false;
+    const std::vector<std::uint8_t> inside = verticesInside(polyhedron);
+    return std::find(inside.begin(), inside.end(), 1) != inside.end();
 }
 
 [[nodiscard]] bool Polyhedron::hasInside(const Polyhedron& polyhedron) const {
-    for (const auto& vertex : polyhedron.getVertices()) {
-        if (!hasInside(vertex)) {
-            return false;
-        }
-    }
-    return true;
+    const std::vector<std::uint8_t> inside = verticesInside(polyhedron);
+    return std::find(inside.begin(), inside.end(), 0) == inside.end();
 }
 
 [[nodiscard]] bool Polyhedron::intersects(const Line& line) const {
@@ -147,6 +140,18 @@ Point Polyhedron::getCenter() const {
 
 
 
+std::vector<std::uint8_t> Polyhedron::verticesInside(const Polyhedron& polyhedron) const {
+    // The planes of the faces are computed once and the vertices are tested in batches
+    PointArrays points;
+    points.reserve(polyhedron.getVertices().size());
+    for (const auto& vertex : polyhedron.getVertices()) {
+        points.push_back(vertex);
+    }
+    std::vector<std::uint8_t> inside(points.size());
+    PlaneSet(*this).hasInside(points, inside.data());
+    return inside;
+}
+
 bool Polyhedron::isOutOfBounds(const std::vector<FaceIndices>& faces) const {
     for (const auto& face : faces) {
         if (isOutOfBounds(face)) {
@@ -0,0 +1,49 @@
+#include "engine/core/math/random-generator/RandomGenerator.h"
+
+#include <mutex>
+#include <random>
+
+using namespace GLESC::Math;
+
+namespace {
+    /**
+     * @brief The seed given to setThreadsSeed, the generators of the new threads are derived from it.
+     */
+    struct ThreadsSeed {
+        std::mutex mutex;
+        bool isDeterministic = false;
+        uint64_t seed = 0;
+        uint64_t threadCount = 0;
+    };
+
+    ThreadsSeed& getThreadsSeed() {
+        static ThreadsSeed threadsSeed;
+        return threadsSeed;
+    }
+} // namespace
+
+void RandomGenerator::setThreadsSeed(uint64_t seed) {
+    // Created before restarting the count, so the seeds of the other threads don't depend on whether the calling
+    // thread already had a generator
+    RandomGenerator& generator = getThreadGenerator();
+    ThreadsSeed& threadsSeed = getThreadsSeed();
+    {
+        std::lock_guard lock(threadsSeed.mutex);
+        threadsSeed.isDeterministic = true;
+        threadsSeed.seed = seed;
+        threadsSeed.threadCount = 0;
+    }
+    generator.setSeed(seed);
+}
+
+uint64_t RandomGenerator::nextThreadSeed() {
+    ThreadsSeed& threadsSeed = getThreadsSeed();
+    std::lock_guard lock(threadsSeed.mutex);
+    if (!threadsSeed.isDeterministic) {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+    // Each thread continues the splitmix64 sequence of the seed, so the threads get unrelated sequences
+    uint64_t threadSeed = threadsSeed.seed + ++threadsSeed.threadCount * 0x9E3779B97F4A7C15;
+    return splitMix64(threadSeed);
+}
@@ -0,0 +1,93 @@
+#include "engine/core/threading/ThreadPool.h"
+
+using namespace GLESC;
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    // The calling thread processes the first chunk, so it needs one thread less
+    workers.reserve(threadCount - 1);
+    for (size_t chunkIndex = 1; chunkIndex < threadCount; chunkIndex++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, chunkIndex);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(jobMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const RangeTask& task) {
+    if (count == 0) return;
+    if (workers.empty()) {
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard lock(jobMutex);
+        currentTask = &task;
+        currentCount = count;
+        pendingWorkers = workers.size();
+        firstException = nullptr;
+        jobGeneration++;
+    }
+    jobAvailable.notify_all();
+
+    runChunk(0);
+
+    std::unique_lock lock(jobMutex);
+    jobFinished.wait(lock, [this] { return pendingWorkers == 0; });
+    currentTask = nullptr;
+    if (firstException) {
+        std::rethrow_exception(firstException);
+    }
+}
+
+void ThreadPool::runChunk(size_t chunkIndex) {
+    const size_t threadCount = getThreadCount();
+    const size_t begin = currentCount * chunkIndex / threadCount;
+    const size_t end = currentCount * (chunkIndex + 1) / threadCount;
+    if (begin == end) return;
+    try {
+        (*currentTask)(begin, end);
+    }
+    catch (...) {
+        std::lock_guard lock(jobMutex);
+        if (!firstException) {
+            firstException = std::current_exception();
+        }
+    }
+}
+
+void ThreadPool::workerLoop(size_t chunkIndex) {
+    size_t lastGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock lock(jobMutex);
+            jobAvailable.wait(lock, [this, lastGeneration] {
+                return stopping || jobGeneration != lastGeneration;
+            });
+            if (stopping) return;
+            lastGeneration = jobGeneration;
+        }
+
+        runChunk(chunkIndex);
+
+        {
+            std::lock_guard lock(jobMutex);
+            pendingWorkers--;
+        }
+        jobFinished.notify_one();
+    }
+}
@@ -14,12 +14,11 @@ namespace GLESC::ECS {
     void FogSystem::update() {
         auto entities = getAssociatedEntities();
         D_ASSERT_TRUE(entities.size() <= 1, "For now, only one fog is supported.");
-        if(renderer.hasRenderBeenCalledThisFrame())
-            for (auto& entity : entities) {
-                auto& fog = getComponent<FogComponent>(entity);
-                auto& transform = getComponent<TransformComponent>(entity);
-                renderer.setFog(fog.fog, transform.transform);
-                HudItemsManager::addItem(HudItemType::FOG, transform.transform.getPosition());
-            }
+        for (auto& entity : entities) {
+            auto& fog = getComponent<FogComponent>(entity);
+            auto& transform = getComponent<TransformComponent>(entity);
+            renderer.setFog(fog.fog);
+            HudItemsManager::addItem(HudItemType::FOG, transform.transform.getPosition());
+        }
     }
 } // namespace GLESC::ECS
@@ -12,14 +12,12 @@ namespace GLESC::ECS {
     }
 
     void LightSystem::update() {
-        if (renderer.hasRenderBeenCalledThisFrame()) {
-            renderer.clearLightData();
-            for (const auto& entity : getAssociatedEntities()) {
-                auto& light = getComponent<LightComponent>(entity);
-                auto& transform = getComponent<TransformComponent>(entity);
-                renderer.sendLightPoint(light.light, transform.transform);
-                HudItemsManager::addItem(HudItemType::LIGHT_SPOT, transform.transform.getPosition());
-            }
+        renderer.clearLightData();
+        for (const auto& entity : getAssociatedEntities()) {
+            auto& light = getComponent<LightComponent>(entity);
+            auto& transform = getComponent<TransformComponent>(entity);
+            renderer.sendLightPoint(entity, light.light, transform.transform);
+            HudItemsManager::addItem(HudItemType::LIGHT_SPOT, transform.transform.getPosition());
         }
     }
 } // namespace GLESC::ECS
@@ -12,13 +12,11 @@ RenderSystem::RenderSystem(Render::Renderer& renderer, ECSCoordinator& ecs) :
 
 
 void RenderSystem::update() {
-    if (renderer.hasRenderBeenCalledThisFrame()) {
-        renderer.clearMeshData();
-        for (auto& entity : getAssociatedEntities()) {
-            auto& render = getComponent<RenderComponent>(entity);
-            auto& transform = getComponent<TransformComponent>(entity);
-            render.getMesh().setOwnerName(getEntityName(entity).c_str());
-            renderer.sendMeshData(render.getMesh(), render.getMaterial(), transform.transform);
-        }
+    renderer.clearMeshData();
+    for (auto& entity : getAssociatedEntities()) {
+        auto& render = getComponent<RenderComponent>(entity);
+        auto& transform = getComponent<TransformComponent>(entity);
+        renderer.sendMeshData(entity, render.getMeshHandle(), render.getMaterial(), transform.transform,
+                              render.getLods());
     }
 }
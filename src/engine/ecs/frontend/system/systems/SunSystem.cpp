@@ -14,12 +14,11 @@ namespace GLESC::ECS {
     void SunSystem::update() {
         const std::set<EntityID>& entities = getAssociatedEntities();
         D_ASSERT_TRUE(entities.size() <= 1, "For now, only one sun is supported.");
-        if (renderer.hasRenderBeenCalledThisFrame())
-            for (auto& entity : entities) {
-                auto& sun = getComponent<SunComponent>(entity);
-                auto& transform = getComponent<TransformComponent>(entity);
-                renderer.setSun(sun.sun, sun.globalAmbientLight, transform.transform);
-                HudItemsManager::addItem(HudItemType::SUN, transform.transform.getPosition());
-            }
+        for (auto& entity : entities) {
+            auto& sun = getComponent<SunComponent>(entity);
+            auto& transform = getComponent<TransformComponent>(entity);
+            renderer.setSun(sun.sun, sun.globalAmbientLight);
+            HudItemsManager::addItem(HudItemType::SUN, transform.transform.getPosition());
+        }
     }
 } // namespace GLESC::ECS
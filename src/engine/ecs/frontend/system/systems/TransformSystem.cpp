@@ -1,5 +1,6 @@
 #include "engine/ecs/frontend/system/systems/TransformSystem.h"
 
+#include "engine/ecs/frontend/component/HierarchyComponent.h"
 #include "engine/ecs/frontend/component/TransformComponent.h"
 
 namespace GLESC::ECS {
@@ -7,10 +8,27 @@ namespace GLESC::ECS {
         addComponentRequirement<TransformComponent>();
     }
 
+    bool TransformSystem::hasValidParent(EntityID entity) {
+        if (!hasComponent<HierarchyComponent>(entity)) return false;
+        const EntityID parent = getComponent<HierarchyComponent>(entity).parent;
+        return parent != entity && getAssociatedEntities().count(parent) > 0;
+    }
+
     void TransformSystem::update() {
-        for (auto& entity : getAssociatedEntities()) {
+        const std::set<EntityID>& entities = getAssociatedEntities();
+        // The nodes of the destroyed entities are removed and the new entities are added before linking them
+        std::vector<Transform::TransformHierarchy::NodeID> removedNodes;
+        for (Transform::TransformHierarchy::NodeID node : hierarchy.getUpdateOrder()) {
+            if (entities.count(static_cast<EntityID>(node)) == 0) removedNodes.push_back(node);
+        }
+        for (Transform::TransformHierarchy::NodeID node : removedNodes) {
+            hierarchy.removeNode(node);
+        }
+
+        for (auto& entity : entities) {
             auto& transform = getComponent<TransformComponent>(entity);
             transform.transform.setOwnerName(getEntityName(entity).c_str());
+            if (!hierarchy.hasNode(entity)) hierarchy.addNode(entity);
             Transform::Rotation rotation = transform.transform.getRotation();
             // Use of fmod to avoid floating point errors
             if (rotation.getX() < -360.0f)
@@ -28,5 +46,27 @@ namespace GLESC::ECS {
                 transform.transform.setRotation(Transform::RotationAxis::Roll, -360.0f);
 
         }
+
+        for (auto& entity : entities) {
+            // A parent that would close a cycle is rejected by the hierarchy, the entity stays a root
+            if (hasValidParent(entity) &&
+                hierarchy.setParent(entity, getComponent<HierarchyComponent>(entity).parent)) {
+                hierarchy.setLocalTransform(entity, getComponent<HierarchyComponent>(entity).localTransform);
+            }
+            else {
+                // The roots are where their transform component says, and so are the orphans
+                hierarchy.setParent(entity, Transform::TransformHierarchy::nullNode);
+                hierarchy.setLocalTransform(entity, getComponent<TransformComponent>(entity).transform);
+            }
+        }
+
+        hierarchy.update();
+        // Only the children that moved are written, the world transform of the roots is their own transform
+        for (Transform::TransformHierarchy::NodeID node : hierarchy.getUpdateOrder()) {
+            if (!hierarchy.isWorldUpdated(node) || hierarchy.getParent(node) == Transform::TransformHierarchy::nullNode)
+                continue;
+            const auto entity = static_cast<EntityID>(node);
+            hierarchy.applyWorldPose(node, getComponent<TransformComponent>(entity).transform);
+        }
     }
 } // namespace GLESC::ECS
@@ -1,4 +1,5 @@
 
+#include "engine/Config.h"
 #include "engine/core/counter/FPSManager.h"
 #include "engine/GLESC.h"
 #include <SDL2/SDL_main.h>
@@ -14,6 +15,10 @@ int main(int argc, char* argv[]) {
         fps.startFrame();
 
         glesc.processInput(fps.getTimeOfFrameAfterUpdate());
+#if GLESC_MULTITHREADED_RENDERING
+        // The render thread draws the last published snapshot while this thread updates the next one
+        glesc.render(fps.getTimeOfFrameAfterUpdate());
+#endif
 
         while (fps.isUpdateLagged()) // Update executes in constant intervals no matter how much time it takes
         {
@@ -23,8 +28,10 @@ int main(int argc, char* argv[]) {
             // Break if we get in spiral of death
             if(fps.hasSpiralOfDeathBeenReached()) break;
         }
+#if !GLESC_MULTITHREADED_RENDERING
         //Render executes arbitrarily
         glesc.render(fps.getTimeOfFrameAfterUpdate());
+#endif
     }
     return 0;
 }
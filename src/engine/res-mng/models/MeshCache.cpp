@@ -0,0 +1,130 @@
+#include "engine/res-mng/models/MeshCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "engine/core/file-system/BinPath.h"
+#include "engine/core/file-system/MappedFile.h"
+#include "engine/core/hash/Hasher.h"
+#include "engine/core/logger/Logger.h"
+#include "engine/res-mng/models/MeshFile.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    std::string toHex(MeshCache::Key key) {
+        char name[17];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+        return name;
+    }
+}
+
+MeshCache& MeshCache::get() {
+    static MeshCache instance(BinPath::getExecutableDirectory() + "/cache/meshes");
+    return instance;
+}
+
+MeshCache::MeshCache(std::string directoryParam) : directory(std::move(directoryParam)) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        Logger::get().warning("Mesh cache directory can't be created: " + directory + " (" + error.message() + ")");
+    }
+}
+
+std::optional<ColorMesh> MeshCache::load(Key key) {
+    const auto start = std::chrono::steady_clock::now();
+    std::optional<ColorMesh> mesh = MeshFile::read(getPath(key));
+    const auto end = std::chrono::steady_clock::now();
+    std::lock_guard lock(statsMutex);
+    if (mesh.has_value()) {
+        stats.hits++;
+        stats.loadMillis += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    else {
+        stats.misses++;
+    }
+    return mesh;
+}
+
+bool MeshCache::store(Key key, const ColorMesh& mesh) {
+    return MeshFile::write(getPath(key), mesh);
+}
+
+ColorMesh MeshCache::getOrCreate(Key key, const std::function<ColorMesh()>& create) {
+    std::optional<ColorMesh> cached = load(key);
+    if (cached.has_value()) return std::move(*cached);
+
+    const auto start = std::chrono::steady_clock::now();
+    ColorMesh mesh = create();
+    const auto end = std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(statsMutex);
+        stats.createMillis += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    if (!store(key, mesh)) {
+        Logger::get().warning("Mesh can't be stored in the cache: " + getPath(key));
+    }
+    return mesh;
+}
+
+std::optional<std::vector<ColorMesh>> MeshCache::loadGroup(Key key) {
+    uint64_t meshCount = 0;
+    {
+        std::ifstream file(getGroupPath(key), std::ios::binary);
+        file.read(reinterpret_cast<char*>(&meshCount), sizeof(meshCount));
+        if (!file) {
+            std::lock_guard lock(statsMutex);
+            stats.misses++;
+            return std::nullopt;
+        }
+    }
+    std::vector<ColorMesh> meshes;
+    for (size_t index = 0; index < meshCount; index++) {
+        std::optional<ColorMesh> mesh = load(getGroupMeshKey(key, index));
+        if (!mesh.has_value()) return std::nullopt;
+        meshes.push_back(std::move(*mesh));
+    }
+    return meshes;
+}
+
+bool MeshCache::storeGroup(Key key, const std::vector<const ColorMesh*>& meshes) {
+    for (size_t index = 0; index < meshes.size(); index++) {
+        if (!store(getGroupMeshKey(key, index), *meshes[index])) return false;
+    }
+    const uint64_t meshCount = meshes.size();
+    std::ofstream file(getGroupPath(key), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&meshCount), sizeof(meshCount));
+    return static_cast<bool>(file);
+}
+
+std::string MeshCache::getPath(Key key) const {
+    return directory + "/" + toHex(key) + MeshFile::extension;
+}
+
+std::string MeshCache::getGroupPath(Key key) const {
+    return directory + "/" + toHex(key) + groupExtension;
+}
+
+MeshCache::Key MeshCache::getGroupMeshKey(Key groupKey, size_t meshIndex) {
+    const uint64_t index = meshIndex;
+    return Hasher::hashBytes(&index, sizeof(index), groupKey);
+}
+
+MeshCache::Stats MeshCache::getStats() const {
+    std::lock_guard lock(statsMutex);
+    return stats;
+}
+
+MeshCache::Key MeshCache::hashFile(const std::string& path) {
+    const MappedFile file(path);
+    if (!file.isOpen()) return 0;
+    return Hasher::hashBytes(file.getData(), file.getSize());
+}
+
+MeshCache::Key MeshCache::hashString(const std::string& description) {
+    return Hasher::hashBytes(description.data(), description.size());
+}
@@ -0,0 +1,132 @@
+#include "engine/res-mng/models/MeshFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "engine/core/file-system/MappedFile.h"
+#include "engine/core/hash/Hasher.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+static_assert(sizeof(ColorMesh::Index) == sizeof(uint32_t), "The indices are stored as 32 bits integers");
+
+namespace {
+    uint64_t hashBlobs(const void* vertices, size_t verticesSize, const void* indices, size_t indicesSize) {
+        return Hasher::hashBytes(indices, indicesSize, Hasher::hashBytes(vertices, verticesSize));
+    }
+}
+
+bool MeshFile::write(const std::string& path, const ColorMesh& mesh) {
+    const std::vector<GAPI::Enums::Types>& layout = mesh.getVertexLayout();
+    if (layout.size() > maxAttributes) return false;
+    const std::vector<ColorVertex>& vertices = mesh.getVertices();
+    const std::vector<ColorMesh::Index>& indices = mesh.getIndices();
+    const size_t verticesSize = vertices.size() * sizeof(ColorVertex);
+    const size_t indicesSize = indices.size() * sizeof(ColorMesh::Index);
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.vertexFormat = static_cast<uint32_t>(mesh.getVertexFormat());
+    header.renderType = static_cast<uint32_t>(mesh.getRenderType());
+    header.flags = mesh.areFacesStored() ? storeFacesFlag : 0u;
+    header.vertexStride = sizeof(ColorVertex);
+    header.attributeCount = static_cast<uint32_t>(layout.size());
+    for (size_t attribute = 0; attribute < layout.size(); attribute++) {
+        header.attributeTypes[attribute] = static_cast<uint32_t>(layout[attribute]);
+    }
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+    for (size_t axis = 0; axis < 3; axis++) {
+        header.boundsMin[axis] = mesh.getBoundingVolume().getMin().get(axis);
+        header.boundsMax[axis] = mesh.getBoundingVolume().getMax().get(axis);
+    }
+    header.contentHash = hashBlobs(vertices.data(), verticesSize, indices.data(), indicesSize);
+
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(vertices.data()), static_cast<std::streamsize>(verticesSize));
+        file.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(indicesSize));
+        if (!file) {
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    // std::rename doesn't replace existing files in every platform
+    std::remove(path.c_str());
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+std::optional<ColorMesh> MeshFile::read(const std::string& path) {
+    const MappedFile file(path);
+    if (!file.isOpen() || file.getSize() < sizeof(Header)) return std::nullopt;
+    Header header{};
+    std::memcpy(&header, file.getData(), sizeof(header));
+    if (!isValid(header, file.getSize())) return std::nullopt;
+
+    const uint8_t* verticesData = file.getData() + sizeof(Header);
+    const size_t verticesSize = header.vertexCount * sizeof(ColorVertex);
+    const uint8_t* indicesData = verticesData + verticesSize;
+    const size_t indicesSize = header.indexCount * sizeof(ColorMesh::Index);
+    if (hashBlobs(verticesData, verticesSize, indicesData, indicesSize) != header.contentHash) return std::nullopt;
+
+    // The header keeps the blobs aligned to 4 bytes, and the mapping starts in a page, so the vertices can be
+    // read in place
+    const auto* mappedVertices = reinterpret_cast<const ColorVertex*>(verticesData);
+    std::vector<ColorVertex> vertices(mappedVertices, mappedVertices + header.vertexCount);
+    std::vector<ColorMesh::Index> indices(header.indexCount);
+    std::memcpy(indices.data(), indicesData, indicesSize);
+    for (ColorMesh::Index index : indices) {
+        if (index >= header.vertexCount) return std::nullopt;
+    }
+
+    ColorMesh mesh;
+    mesh.setStoreFaces((header.flags & storeFacesFlag) != 0);
+    mesh.setVertexFormat(static_cast<VertexFormat>(header.vertexFormat));
+    mesh.setRenderType(static_cast<RenderType>(header.renderType));
+    mesh.startBuilding();
+    mesh.appendGeometry(std::move(vertices), std::move(indices));
+    mesh.finishBuilding();
+    return mesh;
+}
+
+std::optional<MeshFile::Header> MeshFile::readHeader(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return std::nullopt;
+    const auto fileSize = static_cast<size_t>(file.tellg());
+    if (fileSize < sizeof(Header)) return std::nullopt;
+    Header header{};
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || !isValid(header, fileSize)) return std::nullopt;
+    return header;
+}
+
+bool MeshFile::isValid(const Header& header, size_t fileSize) {
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) return false;
+    if (header.version != version) return false;
+    if (header.vertexStride != sizeof(ColorVertex)) return false;
+    if (header.vertexFormat > static_cast<uint32_t>(VertexFormat::Quantized)) return false;
+    if (header.renderType > static_cast<uint32_t>(RenderType::BatchedDynamic)) return false;
+
+    const std::vector<GAPI::Enums::Types>& layout = ColorVertex::getLayout();
+    if (header.attributeCount != layout.size()) return false;
+    for (size_t attribute = 0; attribute < layout.size(); attribute++) {
+        if (header.attributeTypes[attribute] != static_cast<uint32_t>(layout[attribute])) return false;
+    }
+
+    if (header.vertexCount == 0 || header.indexCount == 0 || header.indexCount % 3 != 0) return false;
+    // Checked before multiplying, a corrupted count could overflow the expected size
+    const uint64_t maxBlobSize = fileSize - sizeof(Header);
+    if (header.vertexCount > maxBlobSize / sizeof(ColorVertex)) return false;
+    if (header.indexCount > maxBlobSize / sizeof(ColorMesh::Index)) return false;
+    return sizeof(Header) + header.vertexCount * sizeof(ColorVertex) +
+        header.indexCount * sizeof(ColorMesh::Index) == fileSize;
+}
@@ -0,0 +1,325 @@
+#include "engine/res-mng/models/ModelImporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#include <assimp/postprocess.h>
+
+#include "engine/core/hash/Hasher.h"
+#include "engine/core/logger/Logger.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    /**
+     * @brief Version of the conversion to ColorMesh, it must be increased if the conversion changes so the meshes
+     * stored in the cache are not used anymore.
+     */
+    constexpr uint64_t converterVersion = 1;
+
+    double millisSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+ModelImporter::ModelImporter(MeshRegistry& registryParam, MeshCache* cacheParam, size_t workerCount) :
+    registry(registryParam), cache(cacheParam) {
+    if (workerCount == 0) {
+        const size_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = std::max<size_t>(hardwareThreads > 1 ? hardwareThreads - 1 : 1, 1);
+    }
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&ModelImporter::workerLoop, this);
+    }
+}
+
+ModelImporter::~ModelImporter() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ModelImporter::importModel(const std::string& path) {
+    {
+        std::lock_guard lock(mutex);
+        tasks.push_back({path, nullptr, 0});
+        stats.pendingModels++;
+    }
+    taskAvailable.notify_one();
+}
+
+std::vector<ModelImporter::ImportedMesh> ModelImporter::collectImported() {
+    std::lock_guard lock(mutex);
+    std::vector<ImportedMesh> collected;
+    collected.swap(imported);
+    return collected;
+}
+
+void ModelImporter::waitUntilIdle() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return tasks.empty() && runningTasks == 0; });
+}
+
+bool ModelImporter::isIdle() const {
+    std::lock_guard lock(mutex);
+    return tasks.empty() && runningTasks == 0;
+}
+
+ModelImporter::Stats ModelImporter::getStats() const {
+    std::lock_guard lock(mutex);
+    return stats;
+}
+
+unsigned int ModelImporter::getImportFlags() {
+    return aiProcess_Triangulate // Convert all the models to triangles
+        | aiProcess_FlipUVs // OpenGL uses inverted UVs
+        | aiProcess_GenNormals // Generate normals if they are missing
+        | aiProcess_JoinIdenticalVertices // Join identical vertices/positions
+        | aiProcess_SortByPType; // Split the points and lines from the triangles, configureImporter removes them
+}
+
+void ModelImporter::configureImporter(Assimp::Importer& importer) {
+    importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE);
+}
+
+void ModelImporter::workerLoop() {
+    // The importers are not thread safe, every worker reads its models with its own importer
+    Assimp::Importer importer;
+    configureImporter(importer);
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            runningTasks++;
+        }
+        if (task.model == nullptr) {
+            readModel(importer, task.path);
+        }
+        else {
+            convertModelMesh(*task.model, task.meshIndex);
+        }
+        // The model of the task must be released before the importer is idle, it can hold a whole scene
+        task = Task();
+        {
+            std::lock_guard lock(mutex);
+            runningTasks--;
+            if (tasks.empty() && runningTasks == 0) idle.notify_all();
+        }
+    }
+}
+
+void ModelImporter::readModel(Assimp::Importer& importer, const std::string& path) {
+    std::optional<MeshCache::Key> cacheKey;
+    if (cache != nullptr) {
+        const MeshCache::Key fileHash = MeshCache::hashFile(path);
+        if (fileHash != 0) cacheKey = getCacheKey(fileHash);
+    }
+    if (cacheKey.has_value()) {
+        std::optional<std::vector<ColorMesh>> cachedMeshes = cache->loadGroup(*cacheKey);
+        if (cachedMeshes.has_value()) {
+            for (size_t index = 0; index < cachedMeshes->size(); index++) {
+                publish(path, index, std::move((*cachedMeshes)[index]));
+            }
+            finishModel(true, false);
+            return;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const aiScene* scene = importer.ReadFile(path, getImportFlags());
+    const double readMillis = millisSince(start);
+    {
+        std::lock_guard lock(mutex);
+        stats.readMillis += readMillis;
+    }
+    if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0) {
+        Logger::get().error("Failed to import model: " + path + " (" + importer.GetErrorString() + ")");
+        importer.FreeScene();
+        finishModel(false, true);
+        return;
+    }
+    if (scene->mNumMeshes == 0) {
+        importer.FreeScene();
+        finishModel(false, false);
+        return;
+    }
+
+    auto model = std::make_shared<ModelScene>();
+    model->path = path;
+    model->cacheKey = cacheKey;
+    // The scene is taken from the importer so it can be read by the other workers while this one reads other models
+    model->scene.reset(importer.GetOrphanedScene());
+    model->materialColors.reserve(model->scene->mNumMaterials);
+    for (unsigned int material = 0; material < model->scene->mNumMaterials; material++) {
+        model->materialColors.push_back(getMaterialColor(*model->scene->mMaterials[material]));
+    }
+    model->meshes.resize(model->scene->mNumMeshes);
+    model->remainingMeshes = model->scene->mNumMeshes;
+    {
+        std::lock_guard lock(mutex);
+        // In reverse so the meshes are converted in order
+        for (size_t index = model->scene->mNumMeshes; index > 0; index--) {
+            tasks.push_front({path, model, index - 1});
+        }
+    }
+    taskAvailable.notify_all();
+}
+
+void ModelImporter::convertModelMesh(ModelScene& model, size_t meshIndex) {
+    const auto start = std::chrono::steady_clock::now();
+    const aiMesh& assimpMesh = *model.scene->mMeshes[meshIndex];
+    const ColorRgba baseColor = assimpMesh.mMaterialIndex < model.materialColors.size()
+                                    ? model.materialColors[assimpMesh.mMaterialIndex]
+                                    : ColorRgba(255, 255, 255, 255);
+    std::optional<ColorMesh> mesh;
+    try {
+        mesh = convertMesh(assimpMesh, baseColor);
+    }
+    catch (const std::exception& exception) {
+        Logger::get().error("Failed to convert mesh " + std::to_string(meshIndex) + " of model " + model.path +
+            ": " + exception.what());
+    }
+    const double convertMillis = millisSince(start);
+    {
+        std::lock_guard lock(mutex);
+        stats.convertMillis += convertMillis;
+    }
+    if (mesh.has_value()) {
+        model.meshes[meshIndex] = publish(model.path, meshIndex, std::move(*mesh));
+    }
+    else {
+        model.allMeshesConverted = false;
+    }
+
+    // The last mesh of the model stores the model in the cache
+    if (model.remainingMeshes.fetch_sub(1) != 1) return;
+    if (model.cacheKey.has_value() && model.allMeshesConverted) {
+        std::vector<const ColorMesh*> meshes;
+        meshes.reserve(model.meshes.size());
+        for (const MeshHandle& handle : model.meshes) {
+            meshes.push_back(&*handle);
+        }
+        if (!cache->storeGroup(*model.cacheKey, meshes)) {
+            Logger::get().warning("Model can't be stored in the mesh cache: " + model.path);
+        }
+    }
+    finishModel(false, false);
+}
+
+MeshHandle ModelImporter::publish(const std::string& path, size_t meshIndex, ColorMesh&& mesh) {
+    MeshHandle handle = registry.registerMesh(std::move(mesh));
+    std::lock_guard lock(mutex);
+    imported.push_back({path, meshIndex, handle});
+    stats.importedMeshes++;
+    return handle;
+}
+
+void ModelImporter::finishModel(bool cached, bool failed) {
+    std::lock_guard lock(mutex);
+    stats.pendingModels--;
+    if (failed) {
+        stats.failedModels++;
+        return;
+    }
+    stats.importedModels++;
+    if (cached) stats.cachedModels++;
+}
+
+std::optional<ColorMesh> ModelImporter::convertMesh(const aiMesh& mesh, const ColorRgba& baseColor) {
+    std::vector<ColorMesh::Index> indices;
+    indices.reserve(static_cast<size_t>(mesh.mNumFaces) * 3);
+    for (unsigned int face = 0; face < mesh.mNumFaces; face++) {
+        const aiFace& assimpFace = mesh.mFaces[face];
+        if (assimpFace.mNumIndices != 3) continue;
+        indices.insert(indices.end(), assimpFace.mIndices, assimpFace.mIndices + 3);
+    }
+    if (indices.empty() || mesh.mNumVertices == 0) return std::nullopt;
+
+    std::vector<Normal> normals(mesh.mNumVertices, Normal(0, 0, 0));
+    if (mesh.HasNormals()) {
+        for (unsigned int vertex = 0; vertex < mesh.mNumVertices; vertex++) {
+            const aiVector3D& normal = mesh.mNormals[vertex];
+            normals[vertex] = Normal(normal.x, normal.y, normal.z);
+        }
+    }
+    else {
+        // Without normals, each vertex takes the average of the normals of its faces, weighted by their area
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            const aiVector3D& a = mesh.mVertices[indices[index]];
+            const aiVector3D& b = mesh.mVertices[indices[index + 1]];
+            const aiVector3D& c = mesh.mVertices[indices[index + 2]];
+            const aiVector3D faceNormal = (b - a) ^ (c - a);
+            for (size_t corner = 0; corner < 3; corner++) {
+                normals[indices[index + corner]] += Normal(faceNormal.x, faceNormal.y, faceNormal.z);
+            }
+        }
+        for (Normal& normal : normals) {
+            if (normal.length() > 0.0f) normal.normalize();
+        }
+    }
+
+    const bool hasColors = mesh.HasVertexColors(0);
+    std::vector<ColorVertex> vertices;
+    vertices.reserve(mesh.mNumVertices);
+    for (unsigned int vertex = 0; vertex < mesh.mNumVertices; vertex++) {
+        const aiVector3D& position = mesh.mVertices[vertex];
+        ColorRgba color = baseColor;
+        if (hasColors) {
+            const aiColor4D& vertexColor = mesh.mColors[0][vertex];
+            color = ColorRgba(vertexColor.r * 255.0f, vertexColor.g * 255.0f, vertexColor.b * 255.0f,
+                              vertexColor.a * 255.0f);
+        }
+        vertices.emplace_back(Position(position.x, position.y, position.z), normals[vertex], color);
+    }
+
+    ColorMesh colorMesh;
+    colorMesh.startBuilding();
+    colorMesh.appendGeometry(std::move(vertices), std::move(indices));
+    colorMesh.finishBuilding();
+    return colorMesh;
+}
+
+std::vector<std::optional<ColorMesh>> ModelImporter::convertScene(const aiScene& scene, ThreadPool& pool) {
+    std::vector<ColorRgba> materialColors;
+    materialColors.reserve(scene.mNumMaterials);
+    for (unsigned int material = 0; material < scene.mNumMaterials; material++) {
+        materialColors.push_back(getMaterialColor(*scene.mMaterials[material]));
+    }
+    std::vector<std::optional<ColorMesh>> meshes(scene.mNumMeshes);
+    pool.parallelFor(scene.mNumMeshes, [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; index++) {
+            const aiMesh& mesh = *scene.mMeshes[index];
+            const ColorRgba baseColor = mesh.mMaterialIndex < materialColors.size()
+                                            ? materialColors[mesh.mMaterialIndex]
+                                            : ColorRgba(255, 255, 255, 255);
+            meshes[index] = convertMesh(mesh, baseColor);
+        }
+    });
+    return meshes;
+}
+
+MeshCache::Key ModelImporter::getCacheKey(MeshCache::Key fileHash) {
+    // The same file imported with other flags or converted by another version gives other meshes
+    const uint64_t parameters[] = {converterVersion, getImportFlags()};
+    return Hasher::hashBytes(parameters, sizeof(parameters), fileHash);
+}
+
+ColorRgba ModelImporter::getMaterialColor(const aiMaterial& material) {
+    aiColor4D diffuse(1.0f, 1.0f, 1.0f, 1.0f);
+    if (material.Get(AI_MATKEY_COLOR_DIFFUSE, diffuse) != AI_SUCCESS) {
+        return {255, 255, 255, 255};
+    }
+    return {diffuse.r * 255.0f, diffuse.g * 255.0f, diffuse.b * 255.0f, diffuse.a * 255.0f};
+}
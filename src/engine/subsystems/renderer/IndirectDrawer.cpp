@@ -0,0 +1,183 @@
+#include "engine/subsystems/renderer/IndirectDrawer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+IndirectDrawer::IndirectDrawer(GAPI::IGraphicInterface& gapiParam, size_t arenaVerticesParam,
+                               size_t arenaIndicesParam, GAPI::Size streamingBytesParam) :
+    gapi(gapiParam), arenaVertices(arenaVerticesParam), arenaIndices(arenaIndicesParam),
+    streamingRing(gapiParam, streamingBytesParam) {
+}
+
+IndirectDrawer::~IndirectDrawer() {
+    destroyGpuBuffers();
+}
+
+void IndirectDrawer::destroyGpuBuffers() {
+    for (const std::unique_ptr<MeshArena>& arena : arenas) {
+        arena->destroyGpuBuffers();
+    }
+    streamingRing.destroyGpuBuffers();
+    // The next context could be of another device
+    storageBufferAlignment = 0;
+    if (!buffersCreated) return;
+    gapi.deleteBuffer(drawParamsBuffer);
+    gapi.deleteBuffer(commandBuffer);
+    buffersCreated = false;
+}
+
+const MeshArena* IndirectDrawer::getArena(VertexFormat format) const {
+    for (const std::unique_ptr<MeshArena>& arena : arenas) {
+        if (arena->getFormat() == format) return arena.get();
+    }
+    return nullptr;
+}
+
+MeshArena& IndirectDrawer::getOrCreateArena(VertexFormat format) {
+    for (const std::unique_ptr<MeshArena>& arena : arenas) {
+        if (arena->getFormat() == format) return *arena;
+    }
+    arenas.push_back(std::make_unique<MeshArena>(gapi, format, arenaVertices, arenaIndices, &streamingRing));
+    return *arenas.back();
+}
+
+IndirectDrawer::DrawParams IndirectDrawer::createDrawParams(const MV& mv, const MVP& mvp,
+                                                            const NormalMat& normalMat,
+                                                            const VertexPacker::PositionDequantization&
+                                                            dequantization) {
+    DrawParams params{};
+    // The matrices are copied with the same memory layout they're sent to the uniforms with
+    std::memcpy(params.mvp, &mvp[0][0], sizeof(params.mvp));
+    std::memcpy(params.mv, &mv[0][0], sizeof(params.mv));
+    for (size_t column = 0; column < 3; column++) {
+        std::memcpy(&params.normalMat[column * 4], &normalMat[0][0] + column * 3, 3 * sizeof(float));
+    }
+    for (size_t axis = 0; axis < 3; axis++) {
+        params.positionScale[axis] = dequantization.scale[axis];
+        params.positionOffset[axis] = dequantization.offset[axis];
+    }
+    return params;
+}
+
+bool IndirectDrawer::add(const MeshHandle& mesh, const Material& material, const MV& mv, const MVP& mvp,
+                         const NormalMat& normalMat) {
+    MeshArena& arena = getOrCreateArena(mesh->getVertexFormat());
+    const MeshArena::Range* range = arena.getOrAdd(mesh);
+    if (range == nullptr) {
+        rejectedDraws++;
+        return false;
+    }
+    auto [groupIt, isNew] = materialGroups.try_emplace(material, materials.size());
+    if (isNew) materials.push_back(material);
+    pendingDraws.push_back({&arena, range, groupIt->second,
+                            createDrawParams(mv, mvp, normalMat, mesh->getPositionDequantization())});
+    return true;
+}
+
+void IndirectDrawer::submit(const GroupCallback& prepareGroup) {
+    stats = Stats();
+    stats.rejectedDraws = rejectedDraws;
+    stats.streamingStalls = streamingRing.getStallCount();
+    rejectedDraws = 0;
+    drawParams.clear();
+    commands.clear();
+    if (pendingDraws.empty()) {
+        materials.clear();
+        materialGroups.clear();
+        return;
+    }
+
+    // The draws of a group must be consecutive, they're drawn with a single call
+    std::vector<size_t> order(pendingDraws.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t first, size_t second) {
+        const PendingDraw& firstDraw = pendingDraws[first];
+        const PendingDraw& secondDraw = pendingDraws[second];
+        if (firstDraw.arena != secondDraw.arena) {
+            return firstDraw.arena->getFormat() < secondDraw.arena->getFormat();
+        }
+        return firstDraw.materialGroup < secondDraw.materialGroup;
+    });
+
+    drawParams.reserve(pendingDraws.size());
+    commands.reserve(pendingDraws.size());
+    for (size_t drawIndex : order) {
+        const PendingDraw& draw = pendingDraws[drawIndex];
+        // The ranges are read now, the arena could have moved them while the draws were added
+        GAPI::DrawElementsIndirectCommand command;
+        command.count = draw.range->indexCount;
+        command.instanceCount = 1;
+        command.firstIndex = draw.range->firstIndex;
+        command.baseVertex = draw.range->baseVertex;
+        command.baseInstance = static_cast<GAPI::UInt>(commands.size());
+        commands.push_back(command);
+        drawParams.push_back(draw.params);
+        stats.triangles += draw.range->indexCount / 3;
+    }
+
+    const GAPI::UInt firstCommand = uploadDraws();
+
+    size_t groupStart = 0;
+    while (groupStart < order.size()) {
+        const PendingDraw& first = pendingDraws[order[groupStart]];
+        size_t groupEnd = groupStart + 1;
+        while (groupEnd < order.size() && pendingDraws[order[groupEnd]].arena == first.arena &&
+            pendingDraws[order[groupEnd]].materialGroup == first.materialGroup) {
+            groupEnd++;
+        }
+        first.arena->bind();
+        prepareGroup(materials[first.materialGroup], static_cast<GAPI::UInt>(groupStart));
+        gapi.multiDrawTrianglesIndexedIndirect(firstCommand + static_cast<GAPI::UInt>(groupStart),
+                                               static_cast<GAPI::UInt>(groupEnd - groupStart));
+        stats.multiDraws++;
+        groupStart = groupEnd;
+    }
+    stats.draws = commands.size();
+    stats.streamingStalls = streamingRing.getStallCount();
+    streamingRing.endFrame();
+
+    pendingDraws.clear();
+    materials.clear();
+    materialGroups.clear();
+}
+
+GAPI::UInt IndirectDrawer::uploadDraws() {
+    const size_t paramsBytes = drawParams.size() * sizeof(DrawParams);
+    const size_t commandsBytes = commands.size() * sizeof(GAPI::DrawElementsIndirectCommand);
+    if (storageBufferAlignment == 0) storageBufferAlignment = gapi.getStorageBufferOffsetAlignment();
+    // The commands are aligned to their size, so the offset of the first one is an index of the buffer
+    const GAPI::StreamingRing::Allocation streamedParams =
+        streamingRing.allocate(static_cast<GAPI::Size>(paramsBytes), storageBufferAlignment);
+    const GAPI::StreamingRing::Allocation streamedCommands = streamedParams.isValid()
+        ? streamingRing.allocate(static_cast<GAPI::Size>(commandsBytes), sizeof(GAPI::DrawElementsIndirectCommand))
+        : GAPI::StreamingRing::Allocation();
+    if (streamedCommands.isValid()) {
+        std::memcpy(streamedParams.data, drawParams.data(), paramsBytes);
+        std::memcpy(streamedCommands.data, commands.data(), commandsBytes);
+        gapi.bindBufferRange(GAPI::Enums::BufferTypes::ShaderStorage, drawParamsBinding,
+                             streamingRing.getBufferId(), streamedParams.offset, streamedParams.size);
+        gapi.bindBuffer(GAPI::Enums::BufferTypes::DrawIndirect, streamingRing.getBufferId());
+        stats.streamedBytes = paramsBytes + commandsBytes;
+        return streamedCommands.offset / static_cast<GAPI::UInt>(sizeof(GAPI::DrawElementsIndirectCommand));
+    }
+
+    if (!buffersCreated) {
+        gapi.genBuffers(1, drawParamsBuffer);
+        gapi.genBuffers(1, commandBuffer);
+        buffersCreated = true;
+    }
+    // The buffers are reallocated every frame, so the driver doesn't wait for the draws of the previous frame
+    gapi.bindBuffer(GAPI::Enums::BufferTypes::ShaderStorage, drawParamsBuffer);
+    gapi.setBufferData(drawParams.data(), static_cast<GAPI::Size>(drawParams.size()), sizeof(DrawParams),
+                       GAPI::Enums::BufferTypes::ShaderStorage, GAPI::Enums::BufferUsages::StreamDraw);
+    gapi.bindBufferBase(GAPI::Enums::BufferTypes::ShaderStorage, drawParamsBinding, drawParamsBuffer);
+    gapi.bindBuffer(GAPI::Enums::BufferTypes::DrawIndirect, commandBuffer);
+    gapi.setBufferData(commands.data(), static_cast<GAPI::Size>(commands.size()),
+                       sizeof(GAPI::DrawElementsIndirectCommand), GAPI::Enums::BufferTypes::DrawIndirect,
+                       GAPI::Enums::BufferUsages::StreamDraw);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "engine/subsystems/renderer/MeshPrepass.h"
+
+#include <algorithm>
+
+#include "engine/subsystems/renderer/math/MatrixBatch.h"
+
+using namespace GLESC::Render;
+
+void MeshPrepass::run(const std::vector<MeshRenderData>& meshes,
+                      const Transform::TransformStore& transforms,
+                      const Math::AABBTree& meshBounds,
+                      const View& view,
+                      const Projection& projection,
+                      const VP& viewProjection,
+                      const Frustum& frustum,
+                      ThreadPool& workers) {
+    D_ASSERT_EQUAL(meshBounds.getProxyCount(), meshes.size(), "Every mesh must have its bounds in the tree");
+    const size_t meshCount = meshes.size();
+    // Slots are allocated before the pass so the workers never reallocate the arrays
+    mvs.resize(meshCount);
+    mvps.resize(meshCount);
+    normalMats.resize(meshCount);
+    visible.assign(meshCount, 0);
+    lodLevels.assign(meshCount, 0);
+    // The states of the objects are allocated before the pass too, the proxy ids are indices of the tree nodes
+    Math::AABBTree::ProxyId maxProxy = Math::AABBTree::nullNode;
+    for (const MeshRenderData& meshData : meshes) {
+        if (meshData.lods) maxProxy = std::max(maxProxy, meshData.cullingProxy);
+    }
+    if (maxProxy >= static_cast<Math::AABBTree::ProxyId>(lodStates.size())) {
+        lodStates.resize(static_cast<size_t>(maxProxy) + 1);
+    }
+    const float projectionScale = projection[1][1];
+
+    visibleMeshes.clear();
+    candidateBounds.clear();
+    candidateMeshes.clear();
+    // The hierarchy rejects and accepts whole groups of meshes, the meshes at the border of the frustum are
+    // collected and tested together with the batch culling
+    cullingStats = meshBounds.queryDeferringLeaves(
+        [&frustum](const Math::BoundingVolume::AABB& aabb, Frustum::PlaneMask& planeMask) {
+            return frustum.classify(aabb, planeMask);
+        },
+        Frustum::allPlanes,
+        [this](size_t meshIndex) {
+            visible[meshIndex] = 1;
+            visibleMeshes.push_back(meshIndex);
+        },
+        [this](const Math::BoundingVolume::AABB& aabb, size_t meshIndex) {
+            candidateBounds.push_back(aabb);
+            candidateMeshes.push_back(meshIndex);
+        });
+
+    candidateVisible.resize(candidateMeshes.size());
+    frustum.cullAABBs(candidateBounds, candidateVisible.data());
+    for (size_t candidate = 0; candidate < candidateMeshes.size(); candidate++) {
+        if (candidateVisible[candidate] == 0) continue;
+        visible[candidateMeshes[candidate]] = 1;
+        visibleMeshes.push_back(candidateMeshes[candidate]);
+    }
+
+    visibleTransforms.resize(visibleMeshes.size());
+    workers.parallelFor(visibleMeshes.size(), [&](size_t begin, size_t end) {
+        processVisibleMeshes(begin, end, meshes, transforms, view, viewProjection, projectionScale);
+    });
+}
+
+void MeshPrepass::processVisibleMeshes(size_t begin,
+                                       size_t end,
+                                       const std::vector<MeshRenderData>& meshes,
+                                       const Transform::TransformStore& transforms,
+                                       const View& view,
+                                       const VP& viewProjection,
+                                       float projectionScale) {
+    // Gathered so the batch reads consecutive transforms
+    for (size_t visibleIndex = begin; visibleIndex < end; visibleIndex++) {
+        const MeshRenderData& meshData = meshes[visibleMeshes[visibleIndex]];
+        D_ASSERT_TRUE(meshData.transformHandle < transforms.size(), "The transform of the mesh wasn't interpolated");
+        visibleTransforms.set(visibleIndex, transforms, meshData.transformHandle);
+    }
+
+    // The visible indices are the objects of the batch and the mesh indices their slots
+    const MatrixBatchOutput output{nullptr, mvs.data(), mvps.data(), normalMats.data(), visibleMeshes.data()};
+    MatrixBatch::compute(visibleTransforms, begin, end, view, viewProjection, output);
+
+    for (size_t visibleIndex = begin; visibleIndex < end; visibleIndex++) {
+        const size_t meshIndex = visibleMeshes[visibleIndex];
+        const MeshRenderData& meshData = meshes[meshIndex];
+        if (meshData.lods) {
+            selectLod(meshIndex, meshData, visibleTransforms.getScale(visibleIndex), projectionScale);
+        }
+    }
+}
+
+void MeshPrepass::selectLod(size_t meshIndex, const MeshRenderData& meshData, const Transform::Scale& scale,
+                            float projectionScale) {
+    // The bounding sphere of the mesh encloses its bounding box, the model view matrix moves its center to the
+    // camera space, where the camera is at the origin
+    const Math::BoundingVolume::AABB& bounds = meshData.mesh->getBoundingVolume().getBoundingBox();
+    const Position center = (bounds.min + bounds.max) * 0.5f;
+    const float maxScale = std::max({Math::abs(scale.getX()), Math::abs(scale.getY()), Math::abs(scale.getZ())});
+    const float radius = (bounds.max - bounds.min).length() * 0.5f * maxScale;
+    const Vec4F viewCenter = mvs[meshIndex] * Vec4F(center.getX(), center.getY(), center.getZ(), 1.0f);
+    const float distance = Vec3F(viewCenter.getX(), viewCenter.getY(), viewCenter.getZ()).length();
+    const float screenSize = MeshLodChain::computeScreenSize(radius, distance, projectionScale);
+
+    const MeshLodChain& chain = *meshData.lods;
+    size_t level;
+    if (meshData.cullingProxy == Math::AABBTree::nullNode) {
+        level = chain.selectLevel(screenSize);
+    }
+    else {
+        // Every object has its own proxy, so the workers never write the same state
+        LodState& state = lodStates[static_cast<size_t>(meshData.cullingProxy)];
+        level = state.chain == &chain ? chain.selectLevel(screenSize, state.level) : chain.selectLevel(screenSize);
+        state.chain = &chain;
+        state.level = static_cast<std::uint8_t>(level);
+    }
+    lodLevels[meshIndex] = static_cast<std::uint8_t>(level);
+}
+
+void MeshPrepass::clear() {
+    mvs.clear();
+    mvps.clear();
+    normalMats.clear();
+    visible.clear();
+    lodLevels.clear();
+    lodStates.clear();
+    visibleMeshes.clear();
+    visibleTransforms.clear();
+    candidateBounds.clear();
+    candidateMeshes.clear();
+    candidateVisible.clear();
+    cullingStats = Math::AABBTree::QueryStats();
+}
@@ -0,0 +1,140 @@
+#include "engine/subsystems/renderer/RenderThread.h"
+
+#include "engine/core/low-level-renderer/graphic-api/Gapi.h"
+
+using namespace GLESC::Render;
+
+RenderThread::ExclusiveAccess::ExclusiveAccess(RenderThread& renderThreadParam) : renderThread(renderThreadParam) {
+    if (!renderThread.isRunning()) return;
+    // Only the outermost scope pauses the render thread, the nested ones already have the context
+    if (renderThread.exclusiveAccessDepth == 0) renderThread.pause();
+    renderThread.exclusiveAccessDepth++;
+    acquired = true;
+}
+
+RenderThread::ExclusiveAccess::~ExclusiveAccess() {
+    if (!acquired) return;
+    renderThread.exclusiveAccessDepth--;
+    if (renderThread.exclusiveAccessDepth == 0) renderThread.resume();
+}
+
+RenderThread::RenderThread(SDL_Window& windowParam, FrameFunction renderFrameParam) :
+    window(windowParam), renderFrame(std::move(renderFrameParam)) {
+}
+
+RenderThread::~RenderThread() {
+    if (running) {
+        // Exceptions of the render thread can't be propagated from a destructor
+        try {
+            stop();
+        }
+        catch (...) {
+        }
+    }
+}
+
+void RenderThread::start() {
+    if (running) return;
+    stopping = false;
+    renderException = nullptr;
+    getGAPI().releaseContext(window);
+    thread = std::thread(&RenderThread::renderLoop, this);
+    running = true;
+}
+
+void RenderThread::stop() {
+    if (!running) return;
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    renderThreadWakeUp.notify_one();
+    thread.join();
+    running = false;
+    getGAPI().makeContextCurrent(window);
+    rethrowRenderException();
+}
+
+void RenderThread::requestFrame(double timeOfFrame) {
+    if (!running) return;
+    {
+        std::lock_guard lock(mutex);
+        rethrowRenderException();
+        requestedTimeOfFrame = timeOfFrame;
+        frameRequested = true;
+    }
+    renderThreadWakeUp.notify_one();
+}
+
+void RenderThread::pause() {
+    {
+        std::unique_lock lock(mutex);
+        rethrowRenderException();
+        pauseRequested = true;
+        renderThreadWakeUp.notify_one();
+        // The render thread may have stopped because of an exception, in that case it will never park
+        renderThreadParked.wait(lock, [this] { return parked || renderException != nullptr; });
+        if (!parked) {
+            pauseRequested = false;
+            rethrowRenderException();
+        }
+    }
+    getGAPI().makeContextCurrent(window);
+}
+
+void RenderThread::resume() {
+    getGAPI().releaseContext(window);
+    {
+        std::lock_guard lock(mutex);
+        pauseRequested = false;
+    }
+    renderThreadWakeUp.notify_one();
+}
+
+void RenderThread::rethrowRenderException() {
+    if (renderException) {
+        std::exception_ptr exception = renderException;
+        renderException = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void RenderThread::renderLoop() {
+    try {
+        getGAPI().makeContextCurrent(window);
+        while (true) {
+            double timeOfFrame;
+            {
+                std::unique_lock lock(mutex);
+                renderThreadWakeUp.wait(lock, [this] { return stopping || pauseRequested || frameRequested; });
+                if (stopping) break;
+                if (pauseRequested) {
+                    getGAPI().releaseContext(window);
+                    parked = true;
+                    renderThreadParked.notify_one();
+                    renderThreadWakeUp.wait(lock, [this] { return !pauseRequested; });
+                    parked = false;
+                    lock.unlock();
+                    getGAPI().makeContextCurrent(window);
+                    continue;
+                }
+                timeOfFrame = requestedTimeOfFrame;
+                frameRequested = false;
+            }
+            renderFrame(timeOfFrame);
+        }
+        getGAPI().releaseContext(window);
+    }
+    catch (...) {
+        std::exception_ptr exception = std::current_exception();
+        // The context must not stay current in a thread that is not running anymore
+        try {
+            getGAPI().releaseContext(window);
+        }
+        catch (...) {
+        }
+        std::lock_guard lock(mutex);
+        renderException = exception;
+        renderThreadParked.notify_one();
+    }
+}
@@ -1,4 +1,3 @@
-#include <omp.h>
 #include "engine/subsystems/renderer/Renderer.h"
 
 #include "engine/subsystems/transform/Transform.h"
@@ -11,29 +10,21 @@ using namespace GLESC::Render;
 
 
 Counter Renderer::drawCounter{};
+Counter Renderer::triangleCounter{};
 constexpr int reservedSize = 100;
 
 Renderer::Renderer(WindowManager& windowManager) :
-    windowManager(windowManager), shader(Shader("Shader.glsl")),
-    camera(),
+    windowManager(windowManager), indirectDrawer(getGAPI()),
+    shader(Shader("Shader.glsl",
+                  std::vector{Shader::USE_COLOR, Shader::USE_QUANTIZED_POSITIONS, Shader::USE_MULTI_DRAW})),
     projection(createProjectionMatrix(CameraPerspective())),
     view(createViewMatrix(Transform::Transform())),
     viewProjection(projection * view),
     //skybox("sea-day", "jpg"),
     frustum(viewProjection) {
-    camera.camera = &defaultCameraPerspective;
-    camera.transform = &defaultCameraTransform;
-
-    meshesToRender.reserve(reservedSize);
-    meshMaterials.reserve(reservedSize);
-    meshTransforms.reserve(reservedSize);
-    lights.reserve(reservedSize);
-    lightTransforms.reserve(reservedSize);
-    interpolationTransforms.reserve(reservedSize);
-    mvs.reserve(reservedSize);
-    mvps.reserve(reservedSize);
-    normalMats.reserve(reservedSize);
-    isContainedInFrustum.reserve(reservedSize);
+    updateSnapshot.meshes.reserve(reservedSize);
+    updateSnapshot.lights.reserve(reservedSize);
+    cullingProxies.reserve(reservedSize);
 }
 
 // =====================================================================================================================
@@ -67,16 +58,14 @@ void Renderer::start(const double timeOfFrame) {
     });
     getGAPI().clearColor(0.2f, 0.3f, 0.3f, 1.0f);
 
+    // If the update side didn't publish anything new, the last snapshot is rendered again
+    snapshotExchange.acquire(renderSnapshot);
+
     // TODO: Enable the renderer to work with multiple projection and view matrices (multiple cameras)
-    Projection projection;
-    projection.makeProjectionMatrix(camera.camera->getFovDegrees(), camera.camera->getNearPlane(),
-                                    camera.camera->getFarPlane(),
-                                    camera.camera->getViewWidth(),
-                                    camera.camera->getViewHeight());
-    this->setProjection(projection);
+    this->setProjection(createProjectionMatrix(renderSnapshot.camera.perspective));
 
     const Transform::Transform interpolatedTransform =
-        interpolationTransforms[camera.transform].interpolate(static_cast<float>(timeOfFrame));
+        renderSnapshot.camera.interpolator.interpolate(static_cast<float>(timeOfFrame));
     View view;
     view.makeViewMatrixPosRot(interpolatedTransform.getPosition(), interpolatedTransform.getRotation().toRads());
     this->setView(view);
@@ -84,20 +73,16 @@ void Renderer::start(const double timeOfFrame) {
     viewProjection = projection * view;
 }
 
-void Renderer::renderLights(const std::vector<const LightPoint*>& lights,
-                            const std::vector<const Transform::Transform*>& lightTransforms,
-                            const double timeOfFrame) const {
+void Renderer::renderLights(const std::vector<LightRenderData>& lights,
+                            const Transform::TransformStore& transforms) const {
     size_t lightCount = static_cast<int>(lights.size());
     Shader::setUniform("uLights.count", lightCount);
     for (size_t lightIndex = 0; lightIndex < lightCount; lightIndex++) {
-        const LightPoint& light = *lights[lightIndex];
+        const LightPoint& light = lights[lightIndex].light;
         std::string iStr = std::to_string(lightIndex);
-        const Transform::Transform& transform = *lightTransforms[lightIndex];
-        const Transform::Transform& interpolatedTransform =
-            interpolationTransforms.at(&transform).interpolate(static_cast<float>(timeOfFrame));
+        const Position lightPosition = transforms.getPosition(lights[lightIndex].transformHandle);
 
-        Position lightPosViewSpace =
-            Transform::Transformer::transformVector(interpolatedTransform.getPosition(), getView());
+        Position lightPosViewSpace = Transform::Transformer::transformVector(lightPosition, getView());
         Shader::setUniform("uLights.posInViewSpace[" + iStr + "]", lightPosViewSpace);
 
         if (!light.isDirty()) continue;
@@ -113,11 +98,13 @@ void Renderer::renderLights(const std::vector<const LightPoint*>& lights,
     }
 }
 
-void Renderer::applySun(const Sun& sunParam) {
-    if (sunParam.sun == nullptr) return;
-    GlobalSun sun = *sunParam.sun;
-
-    if (!sun.isDirty()) applyAmbientLight(*sunParam.ambientLight);
+void Renderer::applySun(const std::optional<SunRenderData>& sunParam) {
+    if (!sunParam.has_value()) return;
+    const GlobalSun& sun = sunParam->sun;
+    if (!sun.isDirty()) {
+        applyAmbientLight(sunParam->ambientLight);
+        return;
+    }
 
     Vec3F sunColor = sun.getColor().getRGBVec3FNormalized();
     float sunIntensity = sun.getIntensity();
@@ -127,7 +114,7 @@ void Renderer::applySun(const Sun& sunParam) {
     Shader::setUniform("uSunDirection", sunDirection);
     sun.setClean();
 
-    applyAmbientLight(*sunParam.ambientLight);
+    applyAmbientLight(sunParam->ambientLight);
 }
 
 void Renderer::applyAmbientLight(const GlobalAmbientLight& ambientLight) {
@@ -144,11 +131,11 @@ void Renderer::applySkybox(const Skybox& skyboxParam, const View& view, const Pr
     skyboxParam.draw(view, projection);
 }
 
-void Renderer::applyFog(const FogData& fogParam, const Position& cameraPosition) {
-    if (fogParam.fog == nullptr) return;
-    Shader::setUniform("uFog.color", fogParam.fog->getColor().getRGBVec3FNormalized());
-    Shader::setUniform("uFog.density", fogParam.fog->getDensity());
-    Shader::setUniform("uFog.end", fogParam.fog->getEnd());
+void Renderer::applyFog(const std::optional<Fog>& fogParam, const Position& cameraPosition) {
+    if (!fogParam.has_value()) return;
+    Shader::setUniform("uFog.color", fogParam->getColor().getRGBVec3FNormalized());
+    Shader::setUniform("uFog.density", fogParam->getDensity());
+    Shader::setUniform("uFog.end", fogParam->getEnd());
 }
 
 void Renderer::applyMaterial(const Material& material) {
@@ -169,92 +156,132 @@ void Renderer::applyTransform(const MV& MVMat, const MVP& MVPMat, const NormalMa
 
 void Renderer::render(double timeOfFrame) {
     drawCounter.startCounter();
+    triangleCounter.startCounter();
     const View& viewMat = getView();
     const Projection& projMat = getProjection();
     const VP& viewProjMat = getViewProjection();
     shader.bind(); // Activate the shader program before transform, material and lighting setup
     frustum.update(viewProjMat);
 
-    // TODO: Fix parallelization, it is not working, flickering is happening and meshes get swapped
-    //#pragma omp parallel for default(shared) schedule(dynamic)
-    for (int meshIndex = 0; meshIndex < meshesToRender.size(); meshIndex++) {
-        const ColorMesh& mesh = *meshesToRender[meshIndex];
-        const Transform::Transform& transform = *meshTransforms[meshIndex];
-        Transform::Transform interpolatedTransform =
-            interpolationTransforms[&transform].interpolate(static_cast<float>(timeOfFrame));
-
-        Model model = interpolatedTransform.getModelMatrix();
-
-        Math::BoundingVolume transformedBoundingVol =
-            Transform::Transformer::transformBoundingVolume(mesh.getBoundingVolume(), interpolatedTransform);
-        {
-            std::lock_guard lockMutex(frustumMutex);
-            isContainedInFrustum.push_back(frustum.contains(transformedBoundingVol));
-        }
-        MVP MVPMat = viewProjMat * model;
-        MV MV = viewMat * model;
-        NormalMat normalMat;
-        normalMat.makeNormalMatrix(MV);
-        {
-            std::lock_guard lockMVP(mvpMutex);
-            mvs.push_back(MV);
-        }
-        {
-            std::lock_guard lockMV(mvMutex);
-            mvps.push_back(MVPMat);
-        }
-        {
-            std::lock_guard lockNormalMat(normalMatMutex);
-            normalMats.push_back(normalMat);
-        }
-    }
-    renderLights(lights, lightTransforms, timeOfFrame);
-    applySun(sun);
-    applyFog(fog, camera.transform->getPosition());
+    // Only the meshes registered since the last frame are uploaded, each unique mesh is uploaded once. The indirect
+    // drawer stores the meshes in its arenas, the meshes that don't fit there are uploaded when they're drawn
+    if (!indirectDrawing) MeshRegistry::get().uploadPendingMeshes();
+
+    // Every transform of the snapshot is interpolated in a single pass, the meshes and the lights read theirs by
+    // their handles
+    renderSnapshot.transforms.interpolate(static_cast<float>(timeOfFrame), interpolatedTransforms);
+    const std::vector<MeshRenderData>& meshes = renderSnapshot.meshes;
+    meshPrepass.run(meshes, interpolatedTransforms, renderSnapshot.meshBounds, viewMat, projMat, viewProjMat, frustum,
+                    renderWorkers);
+    renderLights(renderSnapshot.lights, interpolatedTransforms);
+    applySun(renderSnapshot.sun);
+    applyFog(renderSnapshot.fog, renderSnapshot.camera.interpolator.interpolate(1.0f).getPosition());
 
     std::string renderedMeshesPtr;
-    for (int i = 0; i < meshesToRender.size(); i++) {
-        if (!isContainedInFrustum[i]) continue;
-        const ColorMesh& mesh = *meshesToRender[i];
-        const Material& material = *meshMaterials[i];
-        applyTransform(mvs[i], mvps[i], normalMats[i], viewMat);
+    for (size_t i = 0; i < meshes.size(); i++) {
+        if (!meshPrepass.isVisible(i)) continue;
+        const MeshHandle& mesh = meshPrepass.getDrawnMeshHandle(meshes[i], i);
+        const Material& material = meshes[i].material;
+        // The meshes that don't fit in the arenas of the indirect drawer are drawn on their own
+        if (indirectDrawing && indirectDrawer.add(mesh, material, meshPrepass.getMVs()[i],
+                                                  meshPrepass.getMVPs()[i], meshPrepass.getNormalMats()[i])) {
+            continue;
+        }
+        applyTransform(meshPrepass.getMVs()[i], meshPrepass.getMVPs()[i], meshPrepass.getNormalMats()[i], viewMat);
         applyMaterial(material);
-        mesh.sendToGpuBuffers();
-        renderMesh(mesh);
+        renderMesh(mesh.get());
         renderedMeshesPtr += std::to_string(i) + " ";
     }
 
+    if (renderSnapshot.staticBatches) renderStaticBatches(*renderSnapshot.staticBatches, viewMat, viewProjMat);
+    submitIndirectDraws(viewMat);
+
     applySkybox(skybox, viewMat, projMat);
-    hasRenderBeenCalled = true;
+    // The meshes of the destroyed entities are only released once no snapshot references them
+    MeshRegistry::get().releaseUnusedMeshes();
 }
 
 void Renderer::clearMeshData() {
-    meshesToRender.clear();
-    meshMaterials.clear();
-    meshTransforms.clear();
+    updateSnapshot.meshes.clear();
     instances.clear();
-    mvs.clear();
-    mvps.clear();
-    normalMats.clear();
-    isContainedInFrustum.clear();
 }
 
 void Renderer::clearLightData() {
-    lights.clear();
-    lightTransforms.clear();
+    updateSnapshot.lights.clear();
+}
+
+void Renderer::publishSnapshot() {
+    removeStaleCullingProxies();
+    // The copy reuses the arrays of the old snapshot, it only allocates when there are more handles
+    updateSnapshot.transforms = interpolations;
+    interpolations.nextUpdate();
+    // Most updates don't change the tree, the snapshot still has it from the last time it was published
+    if (updateSnapshot.meshBoundsVersion != meshBoundsVersion) {
+        updateSnapshot.meshBounds = meshBoundsTree;
+        updateSnapshot.meshBoundsVersion = meshBoundsVersion;
+    }
+    updateSnapshot.staticBatches = staticBatcher.finishUpdate();
+    snapshotExchange.publish(updateSnapshot);
+    // The exchange gives back an old snapshot
+    updateSnapshot.clear();
+    instances.clear();
+    updateNumber++;
 }
 
 
 Renderer::~Renderer() {
+    indirectDrawer.destroyGpuBuffers();
+    MeshRegistry::get().destroyGpuBuffers();
     getGAPI().deleteContext();
 }
 
 
 void Renderer::renderMesh(const ColorMesh& mesh) {
+    MeshRegistry::get().uploadMesh(mesh);
+    const VertexPacker::PositionDequantization dequantization = mesh.getPositionDequantization();
+    Shader::setUniform("uPositionScale", dequantization.scale);
+    Shader::setUniform("uPositionOffset", dequantization.offset);
     // Bind the VAO before drawing
     mesh.getVertexArray().bind();
     getGAPI().drawTrianglesIndexed(mesh.getIndexBuffer().getCount());
     drawCounter.addToCounter(1);
+    triangleCounter.addToCounter(static_cast<float>(mesh.getIndexBuffer().getCount() / 3));
+}
+
+void Renderer::renderStaticBatches(const StaticBatches& batches, const View& frameView,
+                                   const VP& frameViewProjection) {
+    staticClusterVisible.resize(batches.clusters.size());
+    frustum.cullAABBs(batches.bounds, staticClusterVisible.data());
+    visibleStaticClusters = 0;
+    // The vertices of the clusters are in world space, the model matrix is the identity, and the view has no scale
+    NormalMat normalMat;
+    normalMat.makeNormalMatrixUniformScale(frameView);
+    for (size_t cluster = 0; cluster < batches.clusters.size(); cluster++) {
+        if (staticClusterVisible[cluster] == 0) continue;
+        visibleStaticClusters++;
+        const StaticCluster& staticCluster = batches.clusters[cluster];
+        if (indirectDrawing && indirectDrawer.add(staticCluster.mesh, staticCluster.material, frameView,
+                                                  frameViewProjection, normalMat)) {
+            continue;
+        }
+        applyTransform(frameView, frameViewProjection, normalMat, frameView);
+        applyMaterial(staticCluster.material);
+        renderMesh(staticCluster.mesh.get());
+    }
+}
+
+void Renderer::submitIndirectDraws(const View& frameView) {
+    Shader::setUniform("uViewMat", frameView);
+    // The bool uniforms are set as integers
+    Shader::setUniform("uUseDrawParams", GAPI::Int{1});
+    indirectDrawer.submit([](const Material& material, GAPI::UInt firstDraw) {
+        applyMaterial(material);
+        Shader::setUniform("uDrawOffset", static_cast<GAPI::Int>(firstDraw));
+    });
+    Shader::setUniform("uUseDrawParams", GAPI::Int{0});
+    const IndirectDrawer::Stats& indirectStats = indirectDrawer.getStats();
+    drawCounter.addToCounter(static_cast<float>(indirectStats.multiDraws));
+    triangleCounter.addToCounter(static_cast<float>(indirectStats.triangles));
 }
 
 void Renderer::renderInstances(MeshIndex adaptedInstances) {
@@ -264,69 +291,129 @@ void Renderer::renderInstances(MeshIndex adaptedInstances) {
 // ===========================================Public methods (Update methods)===========================================
 // =====================================================================================================================
 
-void Renderer::sendMeshData(const ColorMesh& mesh, const Material& material, const Transform::Transform& transform) {
-    D_ASSERT_TRUE(!mesh.isBeingBuilt(), "Mesh is being built");
+void Renderer::sendMeshData(RenderHandle handle, const MeshHandle& mesh, const Material& material,
+                            const Transform::Transform& transform, const std::shared_ptr<const MeshLodChain>& lods) {
+    D_ASSERT_TRUE(!lods || lods->getLevel(0).mesh == mesh, "The first level of detail must be the mesh");
+    D_ASSERT_TRUE(mesh.isValid(), "Mesh handle doesn't reference any mesh");
 
-    RenderType renderType = mesh.getRenderType();
-    interpolationTransforms[&transform].pushTransform(transform);
+    RenderType renderType = mesh->getRenderType();
+    interpolations.push(handle, transform);
 
-    if (mesh.getVertices().empty()) {
+    if (mesh->getVertices().empty()) {
         Console::warn("Mesh has no vertices");
         return;
     }
 
-    if (renderType == RenderType::SingleDrawStatic) {
-        D_ASSERT_TRUE(false, "Static meshes are not supported");
+    if (renderType == RenderType::BatchedStatic) {
+        staticBatcher.submit(handle, mesh, material, transform);
         return;
     }
-    if (renderType == RenderType::InstancedStatic) {
-        D_ASSERT_TRUE(false, "Instanced static meshes are not supported");
+    // The static meshes only differ from the dynamic ones in the usage of their buffers
+    if (renderType == RenderType::InstancedStatic || renderType == RenderType::InstancedDynamic) {
+        pushMeshRenderData(handle, mesh, material, transform, lods);
+        instances[&mesh.get()].push_back(updateSnapshot.meshes.size());
         return;
     }
-    if (renderType == RenderType::InstancedDynamic) {
-        meshesToRender.push_back(&mesh);
-        meshMaterials.push_back(&material);
-        meshTransforms.push_back(&transform);
-        instances[&mesh].push_back(meshTransforms.size());
-        return;
-    }
-    if (renderType == RenderType::SingleDrawDynamic) {
-        meshesToRender.push_back(&mesh);
-        meshMaterials.push_back(&material);
-        meshTransforms.push_back(&transform);
+    if (renderType == RenderType::SingleDrawStatic || renderType == RenderType::SingleDrawDynamic) {
+        pushMeshRenderData(handle, mesh, material, transform, lods);
         return;
     }
     D_ASSERT_TRUE(false, "Unknown render type");
 }
 
+void Renderer::pushMeshRenderData(RenderHandle handle, const MeshHandle& mesh, const Material& material,
+                                  const Transform::Transform& transform,
+                                  const std::shared_ptr<const MeshLodChain>& lods) {
+    const Math::AABBTree::ProxyId proxyId =
+        updateCullingProxy(handle, mesh.get(), transform, updateSnapshot.meshes.size());
+    updateSnapshot.meshes.push_back({mesh, material, handle, lods, proxyId});
+}
+
+GLESC::Math::AABBTree::ProxyId Renderer::updateCullingProxy(RenderHandle handle, const ColorMesh& mesh,
+                                                            const Transform::Transform& transform,
+                                                            size_t meshIndex) {
+    if (handle >= cullingProxies.size()) cullingProxies.resize(static_cast<size_t>(handle) + 1);
+    CullingProxy& proxy = cullingProxies[handle];
+    const bool isNew = proxy.proxyId == Math::AABBTree::nullNode;
+    proxy.lastUpdateSent = updateNumber;
+
+    const Math::BoundingVolume::AABB& meshBounds = mesh.getBoundingVolume().getBoundingBox();
+    const bool changed = isNew ||
+        transform.getPosition() != proxy.position ||
+        transform.getRotation() != proxy.rotation ||
+        transform.getScale() != proxy.scale ||
+        meshBounds.min != proxy.meshBounds.min ||
+        meshBounds.max != proxy.meshBounds.max;
+
+    // A mesh that stopped moving still needs its bounds shrunk to the current transform
+    if (changed || proxy.moved) {
+        Math::BoundingVolume::AABB bounds =
+            Transform::Transformer::transformBoundingVolume(mesh.getBoundingVolume(), transform).getBoundingBox();
+        // The mesh is drawn interpolated between the previous and the current transform, the bounds enclose both
+        Math::BoundingVolume::AABB interpolationBounds = isNew ? bounds : bounds.combine(proxy.bounds);
+        if (isNew) {
+            proxy.proxyId = meshBoundsTree.createProxy(interpolationBounds, meshIndex);
+            meshBoundsVersion++;
+        }
+        else if (meshBoundsTree.moveProxy(proxy.proxyId, interpolationBounds)) {
+            meshBoundsVersion++;
+        }
+        proxy.bounds = bounds;
+        proxy.meshBounds = meshBounds;
+        proxy.position = transform.getPosition();
+        proxy.rotation = transform.getRotation();
+        proxy.scale = transform.getScale();
+        proxy.moved = changed;
+    }
+    // The index of the mesh in the snapshot changes when the meshes are sent in another order
+    if (meshBoundsTree.getUserData(proxy.proxyId) != meshIndex) {
+        meshBoundsTree.setUserData(proxy.proxyId, meshIndex);
+        meshBoundsVersion++;
+    }
+    return proxy.proxyId;
+}
+
+void Renderer::removeStaleCullingProxies() {
+    for (CullingProxy& proxy : cullingProxies) {
+        if (proxy.proxyId == Math::AABBTree::nullNode || proxy.lastUpdateSent == updateNumber) continue;
+        meshBoundsTree.destroyProxy(proxy.proxyId);
+        meshBoundsVersion++;
+        proxy = CullingProxy();
+    }
+}
 
-void Renderer::sendLightPoint(const LightPoint& light, const Transform::Transform& transform) {
-    this->lightTransforms.push_back(&transform);
-    this->lights.push_back(&light);
-    this->interpolationTransforms[&transform].pushTransform(transform);
+void Renderer::sendLightPoint(RenderHandle handle, const LightPoint& light, const Transform::Transform& transform) {
+    interpolations.push(handle, transform);
+    this->updateSnapshot.lights.push_back({light, handle});
+    // The copy in the snapshot carries the changes to the render side, the light stays clean until it changes again
+    light.setClean();
 }
 
-void Renderer::setSun(const GlobalSun& sun, const GlobalAmbientLight& ambientLight,
-                      const Transform::Transform& transform) {
-    this->sun.sun = &sun;
-    this->sun.ambientLight = &ambientLight;
-    this->sun.transform = &transform;
-    this->interpolationTransforms[&transform].pushTransform(transform);
+void Renderer::setSun(const GlobalSun& sun, const GlobalAmbientLight& ambientLight) {
+    this->updateSnapshot.sun = SunRenderData{sun, ambientLight};
+    sun.setClean();
+    ambientLight.setClean();
 }
 
-void Renderer::setFog(const Fog& fogParam, const Transform::Transform& transform) {
-    this->fog.fog = &fogParam;
-    this->fog.transform = &transform;
-    this->interpolationTransforms[&transform].pushTransform(transform);
+void Renderer::setFog(const Fog& fogParam) {
+    this->updateSnapshot.fog = fogParam;
 }
 
 void Renderer::setCamera(const CameraPerspective& cameraPerspective, const Transform::Transform& transform) {
-    this->camera.camera = &cameraPerspective;
-    this->camera.transform = &transform;
-    this->interpolationTransforms[&transform].pushTransform(transform);
+    cameraInterpolator.pushTransform(transform);
+    this->updateSnapshot.camera = {cameraPerspective, cameraInterpolator};
 }
 
 
-void Renderer::remove(const ColorMesh& mesh, const Transform::Transform& transform) {
-    interpolationTransforms.erase(&transform);
+void Renderer::remove(RenderHandle handle) {
+    interpolations.remove(handle);
+    if (handle < cullingProxies.size() && cullingProxies[handle].proxyId != Math::AABBTree::nullNode) {
+        meshBoundsTree.destroyProxy(cullingProxies[handle].proxyId);
+        meshBoundsVersion++;
+        cullingProxies[handle] = CullingProxy();
+    }
+    staticBatcher.remove(handle);
+    // The published snapshots would still draw the object, the caller has exclusive access to the render side
+    snapshotExchange.removeObject(handle);
+    renderSnapshot.removeObject(handle);
 }
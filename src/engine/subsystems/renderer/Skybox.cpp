@@ -1,6 +1,55 @@
 #include "engine/subsystems/renderer/Skybox.h"
 using namespace GLESC::Render;
 
+/**
+ * @brief The positions of the triangles of the cube around the camera, seen from the inside.
+ * @details Constant, so it's in the read only data of the executable and isn't copied by each skybox.
+ */
+constexpr float skyboxVertices[108] = {
+    // positions
+    -1.0f, 1.0f, -1.0f,
+    -1.0f, -1.0f, -1.0f,
+    1.0f, -1.0f, -1.0f,
+    1.0f, -1.0f, -1.0f,
+    1.0f, 1.0f, -1.0f,
+    -1.0f, 1.0f, -1.0f,
+
+    -1.0f, -1.0f, 1.0f,
+    -1.0f, -1.0f, -1.0f,
+    -1.0f, 1.0f, -1.0f,
+    -1.0f, 1.0f, -1.0f,
+    -1.0f, 1.0f, 1.0f,
+    -1.0f, -1.0f, 1.0f,
+
+    1.0f, -1.0f, -1.0f,
+    1.0f, -1.0f, 1.0f,
+    1.0f, 1.0f, 1.0f,
+    1.0f, 1.0f, 1.0f,
+    1.0f, 1.0f, -1.0f,
+    1.0f, -1.0f, -1.0f,
+
+    -1.0f, -1.0f, 1.0f,
+    -1.0f, 1.0f, 1.0f,
+    1.0f, 1.0f, 1.0f,
+    1.0f, 1.0f, 1.0f,
+    1.0f, -1.0f, 1.0f,
+    -1.0f, -1.0f, 1.0f,
+
+    -1.0f, 1.0f, -1.0f,
+    1.0f, 1.0f, -1.0f,
+    1.0f, 1.0f, 1.0f,
+    1.0f, 1.0f, 1.0f,
+    -1.0f, 1.0f, 1.0f,
+    -1.0f, 1.0f, -1.0f,
+
+    -1.0f, -1.0f, -1.0f,
+    -1.0f, -1.0f, 1.0f,
+    1.0f, -1.0f, -1.0f,
+    1.0f, -1.0f, -1.0f,
+    -1.0f, -1.0f, 1.0f,
+    1.0f, -1.0f, 1.0f
+};
+
 Skybox::Skybox(const std::string& folderName, const std::string& extension)
     : skyboxCubemap(Cubemap(std::array<std::string, 6>{
           "skyboxes/" + folderName + "/" + std::string("right.") + extension,
@@ -10,51 +59,7 @@ Skybox::Skybox(const std::string& folderName, const std::string& extension)
           "skyboxes/" + folderName + "/" + std::string("front.") + extension,
           "skyboxes/" + folderName + "/" + std::string("back.") + extension
       })), skyboxShader("SkyboxShader.glsl"),
-      skyboxVAOID{0}, skyboxVBOID{0},
-      skyboxVertices{
-          // positions
-          -1.0f, 1.0f, -1.0f,
-          -1.0f, -1.0f, -1.0f,
-          1.0f, -1.0f, -1.0f,
-          1.0f, -1.0f, -1.0f,
-          1.0f, 1.0f, -1.0f,
-          -1.0f, 1.0f, -1.0f,
-
-          -1.0f, -1.0f, 1.0f,
-          -1.0f, -1.0f, -1.0f,
-          -1.0f, 1.0f, -1.0f,
-          -1.0f, 1.0f, -1.0f,
-          -1.0f, 1.0f, 1.0f,
-          -1.0f, -1.0f, 1.0f,
-
-          1.0f, -1.0f, -1.0f,
-          1.0f, -1.0f, 1.0f,
-          1.0f, 1.0f, 1.0f,
-          1.0f, 1.0f, 1.0f,
-          1.0f, 1.0f, -1.0f,
-          1.0f, -1.0f, -1.0f,
-
-          -1.0f, -1.0f, 1.0f,
-          -1.0f, 1.0f, 1.0f,
-          1.0f, 1.0f, 1.0f,
-          1.0f, 1.0f, 1.0f,
-          1.0f, -1.0f, 1.0f,
-          -1.0f, -1.0f, 1.0f,
-
-          -1.0f, 1.0f, -1.0f,
-          1.0f, 1.0f, -1.0f,
-          1.0f, 1.0f, 1.0f,
-          1.0f, 1.0f, 1.0f,
-          -1.0f, 1.0f, 1.0f,
-          -1.0f, 1.0f, -1.0f,
-
-          -1.0f, -1.0f, -1.0f,
-          -1.0f, -1.0f, 1.0f,
-          1.0f, -1.0f, -1.0f,
-          1.0f, -1.0f, -1.0f,
-          -1.0f, -1.0f, 1.0f,
-          1.0f, -1.0f, 1.0f
-      } {
+      skyboxVAOID{0}, skyboxVBOID{0} {
     size_t skyboxVerticesCount = sizeof(skyboxVertices) / sizeof(float);
     size_t skyboxVerticesSize = sizeof(float);
     calculateAverageColor();
@@ -62,7 +67,7 @@ Skybox::Skybox(const std::string& folderName, const std::string& extension)
     skyboxVAO = std::make_unique<VertexArray>();
     skyboxVAO->bind();
     skyboxVBO = std::make_unique<VertexBuffer>(
-        &skyboxVertices,
+        skyboxVertices,
         skyboxVerticesCount,
         skyboxVerticesSize,
         Enums::BufferUsages::StaticDraw);
@@ -0,0 +1,202 @@
+#include "engine/subsystems/renderer/StaticBatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "engine/core/hash/Hasher.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+size_t StaticBatcher::GroupKeyHash::operator()(const GroupKey& key) const {
+    size_t hash = std::hash<Material>{}(key.material);
+    Hasher::hashCombine(hash, std::hash<int>{}(key.cellX));
+    Hasher::hashCombine(hash, std::hash<int>{}(key.cellY));
+    Hasher::hashCombine(hash, std::hash<int>{}(key.cellZ));
+    return hash;
+}
+
+StaticBatcher::StaticBatcher(MeshRegistry& registryParam, float cellSizeParam, size_t maxClusterVerticesParam) :
+    registry(registryParam), cellSize(cellSizeParam), maxClusterVertices(maxClusterVerticesParam),
+    batches(std::make_shared<const StaticBatches>()) {
+    D_ASSERT_TRUE(cellSize > 0.0f, "The cells must have a size");
+    D_ASSERT_TRUE(maxClusterVertices > 0, "The clusters must have vertices");
+}
+
+void StaticBatcher::submit(RenderHandle handle, const MeshHandle& mesh, const Material& material,
+                           const Transform::Transform& transform) {
+    D_ASSERT_TRUE(mesh.isValid(), "Mesh handle doesn't reference any mesh");
+    auto [objectIt, isNew] = objects.try_emplace(handle);
+    StaticObject& object = objectIt->second;
+    object.lastUpdateSent = updateNumber;
+    if (!isNew &&
+        object.mesh == mesh &&
+        transform.getPosition() == object.position &&
+        transform.getRotation() == object.rotation &&
+        transform.getScale() == object.scale &&
+        object.material == material) {
+        return;
+    }
+
+    if (!isNew) removeFromGroup(handle, object);
+    object.mesh = mesh;
+    object.material = material;
+    object.position = transform.getPosition();
+    object.rotation = transform.getRotation();
+    object.scale = transform.getScale();
+    object.model = transform.getModelMatrix();
+    object.group = getGroupKey(object);
+    addToGroup(handle, object);
+}
+
+void StaticBatcher::remove(RenderHandle handle) {
+    auto objectIt = objects.find(handle);
+    if (objectIt == objects.end()) return;
+    removeFromGroup(handle, objectIt->second);
+    objects.erase(objectIt);
+}
+
+std::shared_ptr<const StaticBatches> StaticBatcher::finishUpdate() {
+    for (auto objectIt = objects.begin(); objectIt != objects.end();) {
+        if (objectIt->second.lastUpdateSent == updateNumber) {
+            ++objectIt;
+            continue;
+        }
+        removeFromGroup(objectIt->first, objectIt->second);
+        objectIt = objects.erase(objectIt);
+    }
+    updateNumber++;
+    if (changed) rebuildBatches();
+    return batches;
+}
+
+StaticBatcher::GroupKey StaticBatcher::getGroupKey(const StaticObject& object) const {
+    const Math::BoundingVolume::AABB bounds =
+        Transform::Transformer::transformBoundingVolume(object.mesh->getBoundingVolume(), object.model)
+        .getBoundingBox();
+    const Position center = (bounds.min + bounds.max) * 0.5f;
+    GroupKey key;
+    key.material = object.material;
+    key.cellX = static_cast<int>(std::floor(center.getX() / cellSize));
+    key.cellY = static_cast<int>(std::floor(center.getY() / cellSize));
+    key.cellZ = static_cast<int>(std::floor(center.getZ() / cellSize));
+    return key;
+}
+
+void StaticBatcher::addToGroup(RenderHandle handle, const StaticObject& object) {
+    Group& group = groups[object.group];
+    group.objects.push_back(handle);
+    group.dirty = true;
+    changed = true;
+}
+
+void StaticBatcher::removeFromGroup(RenderHandle handle, const StaticObject& object) {
+    auto groupIt = groups.find(object.group);
+    D_ASSERT_TRUE(groupIt != groups.end(), "The object must be in its group");
+    std::vector<RenderHandle>& groupObjects = groupIt->second.objects;
+    groupObjects.erase(std::remove(groupObjects.begin(), groupObjects.end(), handle), groupObjects.end());
+    groupIt->second.dirty = true;
+    changed = true;
+}
+
+void StaticBatcher::bake(const ColorMesh& mesh, const Model& model,
+                         std::vector<ColorVertex>& vertices, std::vector<ColorMesh::Index>& indices) {
+    NormalMat normalMat;
+    normalMat.makeNormalMatrix(model);
+    const auto baseIndex = static_cast<ColorMesh::Index>(vertices.size());
+    vertices.reserve(vertices.size() + mesh.getVertices().size());
+    for (const ColorVertex& vertex : mesh.getVertices()) {
+        ColorVertex baked = vertex;
+        const Position& position = vertex.getPosition();
+        const Vec4F world = model * Vec4F(position.getX(), position.getY(), position.getZ(), 1.0f);
+        baked.setPosition(Position(world.getX(), world.getY(), world.getZ()));
+        Normal normal = normalMat * vertex.getNormal();
+        if (normal.lengthSquared() > 0.0f) normal.normalize();
+        baked.setNormal(normal);
+        vertices.push_back(baked);
+    }
+    indices.reserve(indices.size() + mesh.getIndices().size());
+    for (ColorMesh::Index index : mesh.getIndices()) {
+        indices.push_back(baseIndex + index);
+    }
+}
+
+void StaticBatcher::rebuildGroup(Group& group) {
+    group.clusters.clear();
+    group.clusterBounds.clear();
+    group.dirty = false;
+    if (group.objects.empty()) return;
+
+    // The clusters keep the vertex format of the meshes if all of them agree, the quantized positions are relative
+    // to the bounds of the cluster
+    const VertexFormat firstFormat = objects.at(group.objects.front()).mesh->getVertexFormat();
+    const bool sameFormat = std::all_of(group.objects.begin(), group.objects.end(),
+                                        [this, firstFormat](RenderHandle handle) {
+                                            return objects.at(handle).mesh->getVertexFormat() == firstFormat;
+                                        });
+    VertexFormat format = sameFormat ? firstFormat : VertexFormat::Float;
+    // The half floats of the compact format are absolute, the baked positions are in world space and would lose
+    // precision far from the origin, so they're quantized relative to the cluster instead
+    if (format == VertexFormat::Compact) format = VertexFormat::Quantized;
+    const Material& material = objects.at(group.objects.front()).material;
+
+    std::vector<ColorVertex> vertices;
+    std::vector<ColorMesh::Index> indices;
+    size_t objectCount = 0;
+    auto flushCluster = [&]() {
+        ColorMesh cluster;
+        cluster.setRenderType(RenderType::SingleDrawStatic);
+        cluster.setVertexFormat(format);
+        // The clusters are only drawn, they don't need the faces
+        cluster.setStoreFaces(false);
+        cluster.startBuilding();
+        cluster.appendGeometry(std::move(vertices), std::move(indices));
+        cluster.finishBuilding();
+        group.clusterBounds.push_back(cluster.getBoundingVolume().getBoundingBox());
+        group.clusters.push_back({registry.registerMesh(std::move(cluster)), material, objectCount});
+        vertices = std::vector<ColorVertex>();
+        indices = std::vector<ColorMesh::Index>();
+        objectCount = 0;
+    };
+    for (RenderHandle handle : group.objects) {
+        const StaticObject& object = objects.at(handle);
+        if (objectCount > 0 && vertices.size() + object.mesh->getVertices().size() > maxClusterVertices) {
+            flushCluster();
+        }
+        bake(object.mesh.get(), object.model, vertices, indices);
+        objectCount++;
+    }
+    flushCluster();
+}
+
+void StaticBatcher::rebuildBatches() {
+    const auto start = std::chrono::steady_clock::now();
+    auto rebuilt = std::make_shared<StaticBatches>();
+    size_t vertexCount = 0;
+    for (auto groupIt = groups.begin(); groupIt != groups.end();) {
+        Group& group = groupIt->second;
+        if (group.dirty) {
+            rebuildGroup(group);
+            stats.rebuiltGroups++;
+        }
+        if (group.objects.empty()) {
+            groupIt = groups.erase(groupIt);
+            continue;
+        }
+        for (size_t cluster = 0; cluster < group.clusters.size(); cluster++) {
+            rebuilt->clusters.push_back(group.clusters[cluster]);
+            rebuilt->bounds.push_back(group.clusterBounds[cluster]);
+            vertexCount += group.clusters[cluster].mesh->getVertices().size();
+        }
+        ++groupIt;
+    }
+    batches = std::move(rebuilt);
+    changed = false;
+
+    const auto end = std::chrono::steady_clock::now();
+    stats.objects = objects.size();
+    stats.clusters = batches->clusters.size();
+    stats.vertices = vertexCount;
+    stats.rebuildMillis += std::chrono::duration<double, std::milli>(end - start).count();
+}
@@ -89,6 +89,11 @@ void Frustum::extractPlanes(const VP& VPMatrix) {
         planes[5].setDistance(VPMatrix[3][3] - VPMatrix[2][3]);
         planes[5].normalize();
     }
+
+    for (size_t planeIndex = 0; planeIndex < planes.size(); planeIndex++) {
+        const Math::Direction& normal = planes[planeIndex].getNormal();
+        packedPlanes[planeIndex] = {normal.getX(), normal.getY(), normal.getZ(), planes[planeIndex].getDistance()};
+    }
 }
 
 bool Frustum::contains(const Position& position) const {
@@ -117,3 +122,24 @@ bool Frustum::contains(const Math::BoundingVolume& volume) const {
     }
     return true;
 }
+
+GLESC::Math::Containment Frustum::classify(const Math::BoundingVolume::AABB& aabb, PlaneMask& planeMask) const {
+    for (size_t planeIndex = 0; planeIndex < planes.size(); planeIndex++) {
+        const PlaneMask planeBit = static_cast<PlaneMask>(1u << planeIndex);
+        if ((planeMask & planeBit) == 0) continue;
+
+        const Math::Plane& plane = planes[planeIndex];
+        const Math::Direction& normal = plane.getNormal();
+        // The corner furthest along the normal, and the opposite one
+        Position furthest;
+        Position nearest;
+        for (size_t axis = 0; axis < 3; axis++) {
+            const bool positive = normal.get(axis) >= 0.0f;
+            furthest.set(axis, positive ? aabb.max.get(axis) : aabb.min.get(axis));
+            nearest.set(axis, positive ? aabb.min.get(axis) : aabb.max.get(axis));
+        }
+        if (!plane.hasInside(furthest)) return Math::Containment::Outside;
+        if (plane.hasInside(nearest)) planeMask = static_cast<PlaneMask>(planeMask & ~planeBit);
+    }
+    return planeMask == 0 ? Math::Containment::Inside : Math::Containment::Intersecting;
+}
@@ -0,0 +1,201 @@
+#include "engine/subsystems/renderer/math/Frustum.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GLESC_CULLING_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(GLESC_CULLING_SSE) && defined(__GNUC__)
+#define GLESC_CULLING_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace GLESC::Render;
+
+namespace {
+    /**
+     * @brief For each plane, the corner components furthest along its normal.
+     * @details If the furthest corner is outside the plane, the whole box is outside, so that's the only corner
+     * each kernel needs to test per plane. The choice depends only on the signs of the normal, so it's done once per
+     * batch instead of once per box.
+     */
+    struct FurthestCorners {
+        const float* x[6];
+        const float* y[6];
+        const float* z[6];
+    };
+
+    template <typename Planes, typename Boxes>
+    FurthestCorners selectFurthestCorners(const Planes& packed, const Boxes& boxes) {
+        FurthestCorners corners{};
+        for (size_t planeIndex = 0; planeIndex < 6; planeIndex++) {
+            corners.x[planeIndex] = packed[planeIndex][0] >= 0.0f ? boxes.maxX : boxes.minX;
+            corners.y[planeIndex] = packed[planeIndex][1] >= 0.0f ? boxes.maxY : boxes.minY;
+            corners.z[planeIndex] = packed[planeIndex][2] >= 0.0f ? boxes.maxZ : boxes.minZ;
+        }
+        return corners;
+    }
+}
+
+void Frustum::cullScalar(const PackedPlanes& packed, const AABBComponents& boxes, size_t begin, size_t end,
+                         std::uint8_t* visibleOut) {
+    const FurthestCorners corners = selectFurthestCorners(packed, boxes);
+    for (size_t boxIndex = begin; boxIndex < end; boxIndex++) {
+        std::uint8_t visible = 1;
+        for (size_t planeIndex = 0; planeIndex < 6; planeIndex++) {
+            const std::array<float, 4>& plane = packed[planeIndex];
+            const float side = plane[0] * corners.x[planeIndex][boxIndex] +
+                plane[1] * corners.y[planeIndex][boxIndex] +
+                plane[2] * corners.z[planeIndex][boxIndex] + plane[3];
+            if (!(side > 0.0f)) {
+                visible = 0;
+                break;
+            }
+        }
+        visibleOut[boxIndex] = visible;
+    }
+}
+
+void Frustum::cullSSE(const PackedPlanes& packed, const AABBComponents& boxes, size_t count,
+                      std::uint8_t* visibleOut) {
+    size_t boxIndex = 0;
+#ifdef GLESC_CULLING_SSE
+    const FurthestCorners corners = selectFurthestCorners(packed, boxes);
+    const __m128 zero = _mm_setzero_ps();
+    for (; boxIndex + 4 <= count; boxIndex += 4) {
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (size_t planeIndex = 0; planeIndex < 6; planeIndex++) {
+            const std::array<float, 4>& plane = packed[planeIndex];
+            // Same operation order as the scalar kernel, so the results are identical
+            __m128 side = _mm_mul_ps(_mm_set1_ps(plane[0]), _mm_loadu_ps(corners.x[planeIndex] + boxIndex));
+            side = _mm_add_ps(side, _mm_mul_ps(_mm_set1_ps(plane[1]), _mm_loadu_ps(corners.y[planeIndex] + boxIndex)));
+            side = _mm_add_ps(side, _mm_mul_ps(_mm_set1_ps(plane[2]), _mm_loadu_ps(corners.z[planeIndex] + boxIndex)));
+            side = _mm_add_ps(side, _mm_set1_ps(plane[3]));
+            visible = _mm_and_ps(visible, _mm_cmpgt_ps(side, zero));
+        }
+        const int mask = _mm_movemask_ps(visible);
+        for (int lane = 0; lane < 4; lane++) {
+            visibleOut[boxIndex + static_cast<size_t>(lane)] = static_cast<std::uint8_t>((mask >> lane) & 1);
+        }
+    }
+#endif
+    // The remaining boxes, or all of them without SSE
+    cullScalar(packed, boxes, boxIndex, count, visibleOut);
+}
+
+#ifdef GLESC_CULLING_AVX2
+__attribute__((target("avx2")))
+#endif
+void Frustum::cullAVX2(const PackedPlanes& packed, const AABBComponents& boxes, size_t count,
+                       std::uint8_t* visibleOut) {
+    size_t boxIndex = 0;
+#ifdef GLESC_CULLING_AVX2
+    const FurthestCorners corners = selectFurthestCorners(packed, boxes);
+    const __m256 zero = _mm256_setzero_ps();
+    for (; boxIndex + 8 <= count; boxIndex += 8) {
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (size_t planeIndex = 0; planeIndex < 6; planeIndex++) {
+            const std::array<float, 4>& plane = packed[planeIndex];
+            // Multiply and add separately (no FMA), so the results are identical to the scalar kernel
+            __m256 side = _mm256_mul_ps(_mm256_set1_ps(plane[0]), _mm256_loadu_ps(corners.x[planeIndex] + boxIndex));
+            side = _mm256_add_ps(side, _mm256_mul_ps(_mm256_set1_ps(plane[1]),
+                                                     _mm256_loadu_ps(corners.y[planeIndex] + boxIndex)));
+            side = _mm256_add_ps(side, _mm256_mul_ps(_mm256_set1_ps(plane[2]),
+                                                     _mm256_loadu_ps(corners.z[planeIndex] + boxIndex)));
+            side = _mm256_add_ps(side, _mm256_set1_ps(plane[3]));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(side, zero, _CMP_GT_OQ));
+        }
+        const int mask = _mm256_movemask_ps(visible);
+        for (int lane = 0; lane < 8; lane++) {
+            visibleOut[boxIndex + static_cast<size_t>(lane)] = static_cast<std::uint8_t>((mask >> lane) & 1);
+        }
+    }
+#endif
+    // The remaining boxes use the narrower kernel
+    AABBComponents remaining = boxes;
+    for (const float** component : {&remaining.minX, &remaining.minY, &remaining.minZ,
+                                    &remaining.maxX, &remaining.maxY, &remaining.maxZ}) {
+        *component += boxIndex;
+    }
+    cullSSE(packed, remaining, count - boxIndex, visibleOut + boxIndex);
+}
+
+bool Frustum::isCullingKernelSupported(CullingKernel kernel) {
+    switch (kernel) {
+    case CullingKernel::Scalar:
+        return true;
+    case CullingKernel::SSE:
+#ifdef GLESC_CULLING_SSE
+        return true;
+#else
+        return false;
+#endif
+    case CullingKernel::AVX2:
+#ifdef GLESC_CULLING_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+CullingKernel Frustum::getBestCullingKernel() {
+    static const CullingKernel bestKernel = [] {
+        if (isCullingKernelSupported(CullingKernel::AVX2)) return CullingKernel::AVX2;
+        if (isCullingKernelSupported(CullingKernel::SSE)) return CullingKernel::SSE;
+        return CullingKernel::Scalar;
+    }();
+    return bestKernel;
+}
+
+void Frustum::cullComponents(const AABBComponents& boxes, size_t count, std::uint8_t* visibleOut,
+                             CullingKernel kernel) const {
+    D_ASSERT_TRUE(isCullingKernelSupported(kernel), "Culling kernel not supported by the processor");
+    switch (kernel) {
+    case CullingKernel::Scalar:
+        cullScalar(packedPlanes, boxes, 0, count, visibleOut);
+        return;
+    case CullingKernel::SSE:
+        cullSSE(packedPlanes, boxes, count, visibleOut);
+        return;
+    case CullingKernel::AVX2:
+        cullAVX2(packedPlanes, boxes, count, visibleOut);
+        return;
+    }
+}
+
+void Frustum::cullAABBs(const AABBArrays& boxes, std::uint8_t* visibleOut, CullingKernel kernel) const {
+    const AABBComponents components{
+        boxes.minX.data(), boxes.minY.data(), boxes.minZ.data(),
+        boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data()
+    };
+    cullComponents(components, boxes.size(), visibleOut, kernel);
+}
+
+void Frustum::cullAABBs(const AABBArrays& boxes, std::uint8_t* visibleOut) const {
+    cullAABBs(boxes, visibleOut, getBestCullingKernel());
+}
+
+void Frustum::cullAABBs(const Math::BoundingVolume::AABB* boxes, size_t count, std::uint8_t* visibleOut) const {
+    // Small enough to live in the stack, big enough to amortize the selection of the corners
+    constexpr size_t chunkSize = 256;
+    float components[6][chunkSize];
+    const AABBComponents chunk{
+        components[0], components[1], components[2], components[3], components[4], components[5]
+    };
+    const CullingKernel kernel = getBestCullingKernel();
+    for (size_t chunkBegin = 0; chunkBegin < count; chunkBegin += chunkSize) {
+        const size_t chunkCount = std::min(chunkSize, count - chunkBegin);
+        for (size_t boxIndex = 0; boxIndex < chunkCount; boxIndex++) {
+            const Math::BoundingVolume::AABB& box = boxes[chunkBegin + boxIndex];
+            components[0][boxIndex] = box.min.getX();
+            components[1][boxIndex] = box.min.getY();
+            components[2][boxIndex] = box.min.getZ();
+            components[3][boxIndex] = box.max.getX();
+            components[4][boxIndex] = box.max.getY();
+            components[5][boxIndex] = box.max.getZ();
+        }
+        cullComponents(chunk, chunkCount, visibleOut + chunkBegin, kernel);
+    }
+}
@@ -0,0 +1,228 @@
+#include "engine/subsystems/renderer/math/MatrixBatch.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(_M_X64))
+#define GLESC_MATRIX_SSE
+#define GLESC_MATRIX_AVX2
+#define GLESC_MATRIX_INLINE __attribute__((always_inline)) inline
+#else
+#define GLESC_MATRIX_INLINE inline
+#endif
+
+using namespace GLESC::Render;
+using GLESC::Transform::TransformStore;
+
+namespace {
+#ifdef GLESC_MATRIX_SSE
+    /**
+     * @brief Vectors of the compiler instead of intrinsics, so the same kernel is written once for every width.
+     * @details The operators become SSE instructions, or AVX instructions when the kernel is inlined in a function
+     * compiled for AVX2.
+     */
+    typedef float Float4 __attribute__((vector_size(16)));
+    typedef float Float8 __attribute__((vector_size(32)));
+#endif
+
+    /**
+     * @brief Computes the matrices of the objects [first, first + width), where width is the number of floats in
+     * Lanes, a float for the scalar kernel.
+     * @details Each element of the matrices is computed for all the objects at once, one object per lane. It's
+     * always inlined so the vectors never cross a function call, which keeps the AVX2 instantiation inside the
+     * function compiled for AVX2.
+     */
+    template <typename Lanes>
+    GLESC_MATRIX_INLINE void computeLanes(const TransformStore& transforms, size_t first, const View& view,
+                                          const VP& viewProjection, const MatrixBatchOutput& output) {
+        constexpr size_t width = sizeof(Lanes) / sizeof(float);
+        const std::vector<float>* components[10] = {
+            &transforms.positionX, &transforms.positionY, &transforms.positionZ,
+            &transforms.orientationX, &transforms.orientationY, &transforms.orientationZ, &transforms.orientationW,
+            &transforms.scaleX, &transforms.scaleY, &transforms.scaleZ
+        };
+        Lanes values[10];
+        for (size_t component = 0; component < 10; component++) {
+            std::memcpy(&values[component], components[component]->data() + first, sizeof(Lanes));
+        }
+        const Lanes &x = values[3], &y = values[4], &z = values[5], &w = values[6];
+        const Lanes &sx = values[7], &sy = values[8], &sz = values[9];
+
+        // Same elements as MatrixMixedAlgorithms::calculateModelMatrixFromQuaternion, without the last row. The 2
+        // of the formula is 2 / |q|^2, which gives the rotation of the normalized quaternion without a square root
+        const Lanes xx = x * x, yy = y * y, zz = z * z;
+        const Lanes xy = x * y, xz = x * z, yz = y * z;
+        const Lanes wx = w * x, wy = w * y, wz = w * z;
+        const Lanes two = 2.0f / (xx + yy + zz + w * w);
+        Lanes model[4][3];
+        model[0][0] = (1.0f - two * (yy + zz)) * sx;
+        model[0][1] = two * (xy + wz) * sx;
+        model[0][2] = two * (xz - wy) * sx;
+        model[1][0] = two * (xy - wz) * sy;
+        model[1][1] = (1.0f - two * (xx + zz)) * sy;
+        model[1][2] = two * (yz + wx) * sy;
+        model[2][0] = two * (xz + wy) * sz;
+        model[2][1] = two * (yz - wx) * sz;
+        model[2][2] = (1.0f - two * (xx + yy)) * sz;
+        model[3][0] = values[0];
+        model[3][1] = values[1];
+        model[3][2] = values[2];
+
+        // The last row of the model is (0, 0, 0, 1), so each column of the product only needs three columns of the
+        // left matrix, plus the fourth for the translation
+        Lanes mv[4][4];
+        Lanes mvp[4][4];
+        for (size_t column = 0; column < 4; column++) {
+            for (size_t row = 0; row < 4; row++) {
+                mv[column][row] = model[column][0] * view[0][row] + model[column][1] * view[1][row] +
+                    model[column][2] * view[2][row];
+                mvp[column][row] = model[column][0] * viewProjection[0][row] +
+                    model[column][1] * viewProjection[1][row] + model[column][2] * viewProjection[2][row];
+            }
+        }
+        for (size_t row = 0; row < 4; row++) {
+            mv[3][row] = mv[3][row] + view[3][row];
+            mvp[3][row] = mvp[3][row] + viewProjection[3][row];
+        }
+
+        // The inverse transpose of a 3x3 matrix has the cross products of its columns as columns, divided by the
+        // determinant
+        Lanes normal[3][3];
+        for (size_t column = 0; column < 3; column++) {
+            const Lanes* a = mv[(column + 1) % 3];
+            const Lanes* b = mv[(column + 2) % 3];
+            normal[column][0] = a[1] * b[2] - a[2] * b[1];
+            normal[column][1] = a[2] * b[0] - a[0] * b[2];
+            normal[column][2] = a[0] * b[1] - a[1] * b[0];
+        }
+        const Lanes determinant = mv[0][0] * normal[0][0] + mv[0][1] * normal[0][1] + mv[0][2] * normal[0][2];
+        const Lanes inverseDeterminant = 1.0f / determinant;
+        for (size_t column = 0; column < 3; column++) {
+            for (size_t row = 0; row < 3; row++) {
+                normal[column][row] = normal[column][row] * inverseDeterminant;
+            }
+        }
+
+        // The lanes of each element are consecutive floats, one per object
+        float modelLanes[4][3][width];
+        float mvLanes[4][4][width];
+        float mvpLanes[4][4][width];
+        float normalLanes[3][3][width];
+        std::memcpy(modelLanes, model, sizeof(model));
+        std::memcpy(mvLanes, mv, sizeof(mv));
+        std::memcpy(mvpLanes, mvp, sizeof(mvp));
+        std::memcpy(normalLanes, normal, sizeof(normal));
+        for (size_t lane = 0; lane < width; lane++) {
+            const size_t slot = output.slots ? output.slots[first + lane] : first + lane;
+            if (output.models) {
+                Model& modelOut = output.models[slot];
+                for (size_t column = 0; column < 4; column++) {
+                    for (size_t row = 0; row < 3; row++) modelOut[column][row] = modelLanes[column][row][lane];
+                    modelOut[column][3] = column == 3 ? 1.0f : 0.0f;
+                }
+            }
+            if (output.mvs) {
+                MV& mvOut = output.mvs[slot];
+                for (size_t column = 0; column < 4; column++) {
+                    for (size_t row = 0; row < 4; row++) mvOut[column][row] = mvLanes[column][row][lane];
+                }
+            }
+            if (output.mvps) {
+                MVP& mvpOut = output.mvps[slot];
+                for (size_t column = 0; column < 4; column++) {
+                    for (size_t row = 0; row < 4; row++) mvpOut[column][row] = mvpLanes[column][row][lane];
+                }
+            }
+            if (output.normalMats) {
+                NormalMat& normalOut = output.normalMats[slot];
+                for (size_t column = 0; column < 3; column++) {
+                    for (size_t row = 0; row < 3; row++) normalOut[column][row] = normalLanes[column][row][lane];
+                }
+            }
+        }
+    }
+}
+
+void MatrixBatch::computeScalar(const TransformStore& transforms, size_t begin, size_t end, const View& view,
+                                const VP& viewProjection, const MatrixBatchOutput& output) {
+    for (size_t index = begin; index < end; index++) {
+        computeLanes<float>(transforms, index, view, viewProjection, output);
+    }
+}
+
+void MatrixBatch::computeSSE(const TransformStore& transforms, size_t begin, size_t end, const View& view,
+                             const VP& viewProjection, const MatrixBatchOutput& output) {
+    size_t index = begin;
+#ifdef GLESC_MATRIX_SSE
+    for (; index + 4 <= end; index += 4) {
+        computeLanes<Float4>(transforms, index, view, viewProjection, output);
+    }
+#endif
+    // The remaining objects, or all of them without SSE
+    computeScalar(transforms, index, end, view, viewProjection, output);
+}
+
+#ifdef GLESC_MATRIX_AVX2
+__attribute__((target("avx2")))
+#endif
+void MatrixBatch::computeAVX2(const TransformStore& transforms, size_t begin, size_t end, const View& view,
+                              const VP& viewProjection, const MatrixBatchOutput& output) {
+    size_t index = begin;
+#ifdef GLESC_MATRIX_AVX2
+    for (; index + 8 <= end; index += 8) {
+        computeLanes<Float8>(transforms, index, view, viewProjection, output);
+    }
+#endif
+    // The remaining objects use the narrower kernel
+    computeSSE(transforms, index, end, view, viewProjection, output);
+}
+
+bool MatrixBatch::isKernelSupported(MatrixKernel kernel) {
+    switch (kernel) {
+    case MatrixKernel::Scalar:
+        return true;
+    case MatrixKernel::SSE:
+#ifdef GLESC_MATRIX_SSE
+        return true;
+#else
+        return false;
+#endif
+    case MatrixKernel::AVX2:
+#ifdef GLESC_MATRIX_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+MatrixKernel MatrixBatch::getBestKernel() {
+    static const MatrixKernel bestKernel = [] {
+        if (isKernelSupported(MatrixKernel::AVX2)) return MatrixKernel::AVX2;
+        if (isKernelSupported(MatrixKernel::SSE)) return MatrixKernel::SSE;
+        return MatrixKernel::Scalar;
+    }();
+    return bestKernel;
+}
+
+void MatrixBatch::compute(const TransformStore& transforms, size_t begin, size_t end, const View& view,
+                          const VP& viewProjection, const MatrixBatchOutput& output, MatrixKernel kernel) {
+    D_ASSERT_TRUE(isKernelSupported(kernel), "Matrix kernel not supported by the processor");
+    D_ASSERT_TRUE(begin <= end && end <= transforms.size(), "The range must be inside the store");
+    switch (kernel) {
+    case MatrixKernel::Scalar:
+        computeScalar(transforms, begin, end, view, viewProjection, output);
+        return;
+    case MatrixKernel::SSE:
+        computeSSE(transforms, begin, end, view, viewProjection, output);
+        return;
+    case MatrixKernel::AVX2:
+        computeAVX2(transforms, begin, end, view, viewProjection, output);
+        return;
+    }
+}
+
+void MatrixBatch::compute(const TransformStore& transforms, size_t begin, size_t end, const View& view,
+                          const VP& viewProjection, const MatrixBatchOutput& output) {
+    compute(transforms, begin, end, view, viewProjection, output, getBestKernel());
+}
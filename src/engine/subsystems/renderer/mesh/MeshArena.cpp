@@ -0,0 +1,169 @@
+#include "engine/subsystems/renderer/mesh/MeshArena.h"
+
+#include <cstring>
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+MeshArena::MeshArena(GAPI::IGraphicInterface& gapiParam, VertexFormat formatParam, size_t vertexCapacityParam,
+                     size_t indexCapacityParam, GAPI::StreamingRing* stagingRingParam) :
+    gapi(gapiParam), format(formatParam), stagingRing(stagingRingParam), vertexAllocator(vertexCapacityParam),
+    indexAllocator(indexCapacityParam) {
+    D_ASSERT_TRUE(vertexCapacityParam > 0 && indexCapacityParam > 0, "The arena must be able to store a mesh");
+    for (const GAPI::VertexBufferElement& element : getLayout(format)) {
+        vertexStride += static_cast<size_t>(GAPI::Enums::getTypeSize(element.type));
+    }
+}
+
+MeshArena::~MeshArena() {
+    destroyGpuBuffers();
+}
+
+std::vector<GAPI::VertexBufferElement> MeshArena::getLayout(VertexFormat format) {
+    if (format != VertexFormat::Float) return VertexPacker::getLayout(format);
+    std::vector<GAPI::VertexBufferElement> layout;
+    for (GAPI::Enums::Types type : ColorVertex::getLayout()) {
+        layout.push_back({type, GAPI::Bool::False});
+    }
+    return layout;
+}
+
+void MeshArena::createBuffers() {
+    gapi.genVertexArray(vertexArray);
+    gapi.bindVertexArray(vertexArray);
+
+    gapi.genBuffers(1, vertexBuffer);
+    gapi.bindBuffer(GAPI::Enums::BufferTypes::Vertex, vertexBuffer);
+    gapi.setDynamicBufferData(static_cast<GAPI::UInt>(getVertexCapacity() * vertexStride),
+                              GAPI::Enums::BufferTypes::Vertex);
+    GAPI::UInt offset = 0;
+    const std::vector<GAPI::VertexBufferElement> layout = getLayout(format);
+    for (size_t location = 0; location < layout.size(); location++) {
+        const GAPI::Enums::Types type = layout[location].type;
+        gapi.enableVertexData(static_cast<GAPI::UInt>(location));
+        gapi.createVertexData(static_cast<GAPI::UInt>(location),
+                              static_cast<GAPI::UInt>(GAPI::Enums::getTypeCount(type)),
+                              GAPI::Enums::getTypePrimitiveType(type), layout[location].normalized,
+                              static_cast<GAPI::UInt>(vertexStride), offset);
+        offset += static_cast<GAPI::UInt>(GAPI::Enums::getTypeSize(type));
+    }
+
+    // The index buffer is bound while the vertex array is bound, so it's part of its state
+    gapi.genBuffers(1, indexBuffer);
+    gapi.bindBuffer(GAPI::Enums::BufferTypes::Index, indexBuffer);
+    gapi.setDynamicBufferData(static_cast<GAPI::UInt>(getIndexCapacity() * sizeof(ColorMesh::Index)),
+                              GAPI::Enums::BufferTypes::Index);
+    gapi.unbindVertexArray();
+    buffersCreated = true;
+}
+
+void MeshArena::destroyGpuBuffers() {
+    if (!buffersCreated) return;
+    gapi.deleteVertexArray(vertexArray);
+    gapi.deleteBuffer(vertexBuffer);
+    gapi.deleteBuffer(indexBuffer);
+    buffersCreated = false;
+    entries.clear();
+    vertexAllocator.reset();
+    indexAllocator.reset();
+}
+
+void MeshArena::bind() const {
+    D_ASSERT_TRUE(buffersCreated, "The arena has no meshes");
+    gapi.bindVertexArray(vertexArray);
+}
+
+const MeshArena::Range* MeshArena::getOrAdd(const MeshHandle& mesh) {
+    D_ASSERT_TRUE(mesh->getVertexFormat() == format, "The mesh doesn't have the format of the arena");
+    auto entryIt = entries.find(&mesh.get());
+    // An expired entry is of a destroyed mesh that had the same address
+    if (entryIt != entries.end() && !entryIt->second.mesh.expired()) return &entryIt->second.range;
+    if (entryIt != entries.end()) {
+        release(entryIt->second);
+        entries.erase(entryIt);
+    }
+
+    if (!buffersCreated) createBuffers();
+    Entry entry;
+    if (!upload(mesh.get(), entry)) {
+        releaseDestroyedMeshes();
+        if (!upload(mesh.get(), entry)) return nullptr;
+    }
+    entry.mesh = mesh.getWeakReference();
+    Entry& stored = entries[&mesh.get()];
+    stored = std::move(entry);
+    return &stored.range;
+}
+
+size_t MeshArena::releaseDestroyedMeshes() {
+    size_t released = 0;
+    for (auto entryIt = entries.begin(); entryIt != entries.end();) {
+        if (!entryIt->second.mesh.expired()) {
+            ++entryIt;
+            continue;
+        }
+        release(entryIt->second);
+        entryIt = entries.erase(entryIt);
+        released++;
+    }
+    releasedMeshes += released;
+    return released;
+}
+
+void MeshArena::release(Entry& entry) {
+    vertexAllocator.free(entry.vertices);
+    indexAllocator.free(entry.indices);
+}
+
+bool MeshArena::upload(const ColorMesh& mesh, Entry& entry) {
+    const std::vector<ColorVertex>& vertices = mesh.getVertices();
+    const std::vector<ColorMesh::Index>& indices = mesh.getIndices();
+    if (vertices.empty() || indices.empty()) return false;
+    const GAPI::BufferRangeAllocator::Allocation vertexRange = vertexAllocator.allocate(vertices.size());
+    if (!vertexRange.isValid()) return false;
+    const GAPI::BufferRangeAllocator::Allocation indexRange = indexAllocator.allocate(indices.size());
+    if (!indexRange.isValid()) {
+        vertexAllocator.free(vertexRange);
+        return false;
+    }
+
+    // The packed vertices must live until they're copied to the buffer
+    const void* vertexData = vertices.data();
+    VertexPacker::PackedVertices packedVertices;
+    if (format != VertexFormat::Float) {
+        packedVertices = VertexPacker::pack(vertices, format, mesh.getBoundingVolume().getMin(),
+                                            mesh.getBoundingVolume().getMax());
+        vertexData = packedVertices.data.data();
+    }
+    write(vertexBuffer, GAPI::Enums::BufferTypes::Vertex, vertexData, vertexRange.offset * vertexStride,
+          vertices.size() * vertexStride);
+    write(indexBuffer, GAPI::Enums::BufferTypes::Index, indices.data(),
+          indexRange.offset * sizeof(ColorMesh::Index), indices.size() * sizeof(ColorMesh::Index));
+
+    entry.vertices = vertexRange;
+    entry.indices = indexRange;
+    entry.range.firstIndex = static_cast<GAPI::UInt>(indexRange.offset);
+    entry.range.indexCount = static_cast<GAPI::UInt>(indices.size());
+    entry.range.baseVertex = static_cast<GAPI::Int>(vertexRange.offset);
+    entry.range.vertexCount = static_cast<GAPI::UInt>(vertices.size());
+    return true;
+}
+
+void MeshArena::write(GAPI::UInt buffer, GAPI::Enums::BufferTypes bufferType, const void* data, size_t offset,
+                      size_t size) {
+    if (stagingRing != nullptr) {
+        // The copies are aligned to 4 bytes, the alignment of the index and vertex components
+        const GAPI::StreamingRing::Allocation staging = stagingRing->allocate(static_cast<GAPI::Size>(size), 4);
+        if (staging.isValid()) {
+            std::memcpy(staging.data, data, size);
+            gapi.copyBufferSubData(stagingRing->getBufferId(), buffer, staging.offset, static_cast<GAPI::Size>(offset),
+                                   static_cast<GAPI::Size>(size));
+            stagedBytes += size;
+            return;
+        }
+    }
+    // Binding the index buffer changes the bound vertex array, so the one of the arena is bound first
+    if (bufferType == GAPI::Enums::BufferTypes::Index) gapi.bindVertexArray(vertexArray);
+    gapi.bindBuffer(bufferType, buffer);
+    gapi.setBufferSubData(data, static_cast<GAPI::Size>(offset), static_cast<GAPI::Size>(size), bufferType);
+}
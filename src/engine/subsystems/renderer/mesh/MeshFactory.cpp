@@ -12,25 +12,30 @@ ColorMesh MeshFactory::sphere(const int numSlices, const int numStacks, const fl
     mesh.startBuilding();
 
     constexpr auto piF = Math::pi<float>();
+    // The sines and cosines of the angles of the slices and the stacks, each vertex is made of them, so they're
+    // calculated once instead of several times per vertex
+    std::vector<float> sliceCos(numSlices + 1), sliceSin(numSlices + 1);
+    for (int i = 0; i <= numSlices; ++i) {
+        const float theta = 2 * piF * static_cast<float>(i) / static_cast<float>(numSlices);
+        sliceCos[i] = Math::cos(theta);
+        sliceSin[i] = Math::sin(theta);
+    }
+    std::vector<float> stackCos(numStacks + 1), stackSin(numStacks + 1);
+    for (int j = 0; j <= numStacks; ++j) {
+        const float phi = piF * static_cast<float>(j) / static_cast<float>(numStacks);
+        stackCos[j] = Math::cos(phi);
+        stackSin[j] = Math::sin(phi);
+    }
+    auto spherePoint = [&](int slice, int stack) {
+        return Position(sliceCos[slice] * stackSin[stack], stackCos[stack], sliceSin[slice] * stackSin[stack]);
+    };
+
     // Create the top and bottom cap
     for (int i = 0; i < numSlices; ++i) {
-        float theta1 = 2 * piF * static_cast<float>(i) / static_cast<float>(numSlices);
-        float theta2 = 2 * piF * static_cast<float>(i + 1) / static_cast<float>(numSlices);
-        const auto stacks = static_cast<float>(numStacks);
-
-        Position topP1(Math::cos(theta2) * Math::sin(piF / stacks),
-                       Math::cos(piF / stacks),
-                       Math::sin(theta2) * Math::sin(piF / stacks));
-        Position topP2(Math::cos(theta1) * Math::sin(piF / stacks),
-                       Math::cos(piF / stacks),
-                       Math::sin(theta1) * Math::sin(piF / stacks));
-
-        Position bottomP1(Math::cos(theta2) * Math::sin(piF - piF / stacks),
-                          Math::cos(piF - piF / stacks),
-                          Math::sin(theta2) * Math::sin(piF - piF / stacks));
-        Position bottomP2(Math::cos(theta1) * Math::sin(piF - piF / stacks),
-                          Math::cos(piF - piF / stacks),
-                          Math::sin(theta1) * Math::sin(piF - piF / stacks));
+        const Position topP1 = spherePoint(i + 1, 1);
+        const Position topP2 = spherePoint(i, 1);
+        const Position bottomP1 = spherePoint(i + 1, numStacks - 1);
+        const Position bottomP2 = spherePoint(i, numStacks - 1);
         // Top cap triangles
         mesh.addTris(
             {Position(0, radius, 0), color},
@@ -49,22 +54,11 @@ ColorMesh MeshFactory::sphere(const int numSlices, const int numStacks, const fl
     // Create the middle quads
     for (int j = 1; j < numStacks - 1; ++j) {
         for (int i = 0; i < numSlices; ++i) {
-            float theta1 = 2 * piF * static_cast<float>(i) / static_cast<float>(numSlices);
-            float theta2 = 2 * piF * static_cast<float>(i + 1) / static_cast<float>(numSlices);
-            float phi1 = piF * static_cast<float>(j) / static_cast<float>(numStacks);
-            float phi2 = piF * static_cast<float>(j + 1) / static_cast<float>(numStacks);
-
-            Position p1(Math::cos(theta1) * Math::sin(phi1), Math::cos(phi1), Math::sin(theta1) * Math::sin(phi1));
-            Position p2(Math::cos(theta2) * Math::sin(phi1), Math::cos(phi1), Math::sin(theta2) * Math::sin(phi1));
-            Position p3(Math::cos(theta2) * Math::sin(phi2), Math::cos(phi2), Math::sin(theta2) * Math::sin(phi2));
-            Position p4(Math::cos(theta1) * Math::sin(phi2), Math::cos(phi2), Math::sin(theta1) * Math::sin(phi2));
-
-
             mesh.addQuad(
-                {p1 * radius, color},
-                {p2 * radius, color},
-                {p3 * radius, color},
-                {p4 * radius, color}
+                {spherePoint(i, j) * radius, color},
+                {spherePoint(i + 1, j) * radius, color},
+                {spherePoint(i + 1, j + 1) * radius, color},
+                {spherePoint(i, j + 1) * radius, color}
             );
         }
     }
@@ -72,40 +66,32 @@ ColorMesh MeshFactory::sphere(const int numSlices, const int numStacks, const fl
     return mesh;
 }
 
+/**
+ * @brief The corners of the faces of a cube of half size 1, in the order that makes each face look outwards.
+ * @details The cuboids scale them, so the layout of the faces is fixed at compile time.
+ */
+constexpr float cuboidFaces[6][4][3] = {
+    {{-1, -1, -1}, {1, -1, -1}, {1, -1, 1}, {-1, -1, 1}}, // Bottom
+    {{-1, 1, -1}, {-1, 1, 1}, {1, 1, 1}, {1, 1, -1}}, // Top
+    {{-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}}, // Front
+    {{-1, -1, -1}, {-1, 1, -1}, {1, 1, -1}, {1, -1, -1}}, // Back
+    {{-1, -1, -1}, {-1, -1, 1}, {-1, 1, 1}, {-1, 1, -1}}, // Left
+    {{1, -1, -1}, {1, 1, -1}, {1, 1, 1}, {1, -1, 1}} // Right
+};
+
 ColorMesh MeshFactory::cuboid(const double width, const double height, const double depth, const ColorRgba& color) {
     ColorMesh mesh;
     mesh.startBuilding();
-    double w = width / 2.0, h = height / 2.0, d = depth / 2.0;
-
-    mesh.addQuad({Position(-w, -h, -d), color},
-                 {Position(w, -h, -d), color},
-                 {Position(w, -h, d), color},
-                 {Position(-w, -h, d), color});
-
-    mesh.addQuad({Position(-w, h, -d), color},
-                 {Position(-w, h, d), color},
-                 {Position(w, h, d), color},
-                 {Position(w, h, -d), color});
-
-    mesh.addQuad({Position(-w, -h, d), color},
-                 {Position(w, -h, d), color},
-                 {Position(w, h, d), color},
-                 {Position(-w, h, d), color});
-
-    mesh.addQuad({Position(-w, -h, -d), color},
-                 {Position(-w, h, -d), color},
-                 {Position(w, h, -d), color},
-                 {Position(w, -h, -d), color});
-
-    mesh.addQuad({Position(-w, -h, -d), color},
-                 {Position(-w, -h, d), color},
-                 {Position(-w, h, d), color},
-                 {Position(-w, h, -d), color});
-
-    mesh.addQuad({Position(w, -h, -d), color},
-                 {Position(w, h, -d), color},
-                 {Position(w, h, d), color},
-                 {Position(w, -h, d), color});
+    const auto w = static_cast<float>(width / 2.0);
+    const auto h = static_cast<float>(height / 2.0);
+    const auto d = static_cast<float>(depth / 2.0);
+
+    for (const auto& face : cuboidFaces) {
+        auto corner = [&](int index) {
+            return Position(face[index][0] * w, face[index][1] * h, face[index][2] * d);
+        };
+        mesh.addQuad({corner(0), color}, {corner(1), color}, {corner(2), color}, {corner(3), color});
+    }
     mesh.finishBuilding();
     return mesh;
 }
@@ -0,0 +1,78 @@
+#include "engine/subsystems/renderer/mesh/MeshLod.h"
+
+#include <cstdint>
+#include <limits>
+
+#include "engine/subsystems/renderer/mesh/MeshSimplifier.h"
+
+using namespace GLESC::Render;
+
+void MeshLodChain::addLevel(const MeshHandle& mesh, float minScreenSize) {
+    D_ASSERT_TRUE(mesh.isValid(), "The level must have a mesh");
+    // The renderer stores the selected levels in bytes
+    D_ASSERT_TRUE(levels.size() < std::numeric_limits<std::uint8_t>::max(), "Too many levels in the chain");
+    D_ASSERT_TRUE(levels.empty() || minScreenSize < levels.back().minScreenSize,
+                  "The levels must be added from the biggest screen size to the smallest");
+    levels.push_back({mesh, minScreenSize});
+}
+
+size_t MeshLodChain::selectLevel(float screenSize) const {
+    D_ASSERT_FALSE(levels.empty(), "The chain has no levels");
+    size_t level = 0;
+    while (level + 1 < levels.size() && screenSize < levels[level].minScreenSize) {
+        level++;
+    }
+    return level;
+}
+
+size_t MeshLodChain::selectLevel(float screenSize, size_t currentLevel) const {
+    if (currentLevel >= levels.size()) return selectLevel(screenSize);
+    size_t level = currentLevel;
+    while (level + 1 < levels.size() && screenSize < levels[level].minScreenSize * (1.0f - hysteresis)) {
+        level++;
+    }
+    while (level > 0 && screenSize > levels[level - 1].minScreenSize * (1.0f + hysteresis)) {
+        level--;
+    }
+    return level;
+}
+
+float MeshLodChain::computeScreenSize(float radius, float distance, float projectionScale) {
+    // The camera is inside the sphere
+    if (distance <= radius) return std::numeric_limits<float>::max();
+    return radius * projectionScale / distance;
+}
+
+float MeshLodChain::getGeneratedScreenSize(size_t level, size_t levelCount, float firstScreenSize) {
+    if (level + 1 == levelCount) return 0.0f;
+    return firstScreenSize / static_cast<float>(1u << level);
+}
+
+std::shared_ptr<const MeshLodChain> MeshLodChain::simplify(const ColorMesh& mesh, size_t levelCount,
+                                                           float triangleRatio, float firstScreenSize,
+                                                           MeshRegistry& registry) {
+    D_ASSERT_TRUE(levelCount > 0, "The chain must have at least one level");
+    auto chain = std::make_shared<MeshLodChain>();
+    chain->addLevel(registry.registerMesh(mesh), getGeneratedScreenSize(0, levelCount, firstScreenSize));
+    // Each level is simplified from the previous one, the errors of the previous collapses are already in its
+    // positions
+    ColorMesh previous = mesh;
+    for (size_t level = 1; level < levelCount; level++) {
+        ColorMesh simplified = MeshSimplifier::simplify(previous, triangleRatio);
+        chain->addLevel(registry.registerMesh(simplified), getGeneratedScreenSize(level, levelCount, firstScreenSize));
+        previous = std::move(simplified);
+    }
+    return chain;
+}
+
+std::shared_ptr<const MeshLodChain> MeshLodChain::generate(size_t levelCount,
+                                                           const std::function<ColorMesh(size_t level)>& createLevel,
+                                                           float firstScreenSize, MeshRegistry& registry) {
+    D_ASSERT_TRUE(levelCount > 0, "The chain must have at least one level");
+    auto chain = std::make_shared<MeshLodChain>();
+    for (size_t level = 0; level < levelCount; level++) {
+        chain->addLevel(registry.registerMesh(createLevel(level)),
+                        getGeneratedScreenSize(level, levelCount, firstScreenSize));
+    }
+    return chain;
+}
@@ -0,0 +1,119 @@
+#include "engine/subsystems/renderer/mesh/MeshOptimizer.h"
+
+using namespace GLESC::Render;
+
+namespace {
+    using Index = MeshOptimizer::Index;
+    constexpr int noVertex = -1;
+
+    /**
+     * @brief The triangles that use each vertex, stored contiguously.
+     */
+    struct VertexTriangles {
+        std::vector<size_t> offsets;
+        std::vector<size_t> triangles;
+
+        VertexTriangles(const std::vector<Index>& indices, size_t vertexCount) : offsets(vertexCount + 1, 0) {
+            for (Index index : indices) {
+                offsets[index + 1]++;
+            }
+            for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+                offsets[vertex + 1] += offsets[vertex];
+            }
+            triangles.resize(indices.size());
+            std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+            for (size_t corner = 0; corner < indices.size(); corner++) {
+                triangles[filled[indices[corner]]++] = corner / 3;
+            }
+        }
+    };
+}
+
+std::vector<Index> MeshOptimizer::optimizeVertexCache(const std::vector<Index>& indices, size_t vertexCount,
+                                                      size_t cacheSize) {
+    D_ASSERT_TRUE(indices.size() % 3 == 0, "Indices must be a list of triangles");
+    const size_t triangleCount = indices.size() / 3;
+    const VertexTriangles adjacency(indices, vertexCount);
+
+    // Number of triangles not emitted yet of each vertex
+    std::vector<size_t> liveTriangles(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+        liveTriangles[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+    }
+    // Time each vertex entered the cache, the time only advances with the cache misses
+    std::vector<size_t> cacheTime(vertexCount, 0);
+    size_t time = cacheSize + 1;
+    std::vector<bool> emitted(triangleCount, false);
+    // Vertices of the emitted triangles, used to continue when a fan has no good candidate
+    std::vector<Index> deadEnds;
+    size_t cursor = 0;
+
+    auto skipDeadEnd = [&]() -> int {
+        while (!deadEnds.empty()) {
+            const Index vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (liveTriangles[vertex] > 0) return static_cast<int>(vertex);
+        }
+        for (; cursor < vertexCount; cursor++) {
+            if (liveTriangles[cursor] > 0) return static_cast<int>(cursor);
+        }
+        return noVertex;
+    };
+
+    std::vector<Index> optimized;
+    optimized.reserve(indices.size());
+    std::vector<Index> candidates;
+    int fanVertex = skipDeadEnd();
+    while (fanVertex != noVertex) {
+        candidates.clear();
+        const auto fan = static_cast<size_t>(fanVertex);
+        for (size_t adjacent = adjacency.offsets[fan]; adjacent < adjacency.offsets[fan + 1]; adjacent++) {
+            const size_t triangle = adjacency.triangles[adjacent];
+            if (emitted[triangle]) continue;
+            for (size_t corner = 0; corner < 3; corner++) {
+                const Index vertex = indices[triangle * 3 + corner];
+                optimized.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+                if (time - cacheTime[vertex] > cacheSize) {
+                    cacheTime[vertex] = time;
+                    time++;
+                }
+            }
+            emitted[triangle] = true;
+        }
+
+        // The next fan is the candidate that will still be in the cache after emitting its triangles, and that
+        // entered the cache earlier. If none will be, the fan continues from the most recently used vertex.
+        int nextVertex = noVertex;
+        size_t bestPriority = 0;
+        for (Index vertex : candidates) {
+            if (liveTriangles[vertex] == 0) continue;
+            const size_t age = time - cacheTime[vertex];
+            // Emitting the triangles of the vertex adds at most two new vertices per triangle to the cache
+            if (age + 2 * liveTriangles[vertex] > cacheSize) continue;
+            if (age > bestPriority) {
+                bestPriority = age;
+                nextVertex = static_cast<int>(vertex);
+            }
+        }
+        fanVertex = nextVertex != noVertex ? nextVertex : skipDeadEnd();
+    }
+    return optimized;
+}
+
+float MeshOptimizer::computeACMR(const std::vector<Index>& indices, size_t vertexCount, size_t cacheSize) {
+    if (indices.empty()) return 0.0f;
+    // A vertex is in the cache if less than cacheSize vertices entered after it
+    constexpr size_t neverCached = std::numeric_limits<size_t>::max();
+    std::vector<size_t> cacheTime(vertexCount, neverCached);
+    size_t misses = 0;
+    for (Index index : indices) {
+        if (cacheTime[index] == neverCached || misses - cacheTime[index] >= cacheSize) {
+            cacheTime[index] = misses;
+            misses++;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
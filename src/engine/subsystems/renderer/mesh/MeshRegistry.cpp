@@ -0,0 +1,142 @@
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace GLESC::Render;
+
+MeshHandle MeshRegistry::registerMesh(const ColorMesh& mesh) {
+    D_ASSERT_TRUE(!mesh.isBeingBuilt(), "Mesh is being built");
+    const size_t meshHash = mesh.hash();
+    std::lock_guard lock(mutex);
+    if (std::shared_ptr<const ColorMesh> registered = find(mesh, meshHash)) {
+        return MeshHandle(std::move(registered));
+    }
+    return store(std::make_shared<const ColorMesh>(mesh), meshHash);
+}
+
+MeshHandle MeshRegistry::registerMesh(ColorMesh&& mesh) {
+    D_ASSERT_TRUE(!mesh.isBeingBuilt(), "Mesh is being built");
+    const size_t meshHash = mesh.hash();
+    std::lock_guard lock(mutex);
+    if (std::shared_ptr<const ColorMesh> registered = find(mesh, meshHash)) {
+        return MeshHandle(std::move(registered));
+    }
+    return store(std::make_shared<const ColorMesh>(std::move(mesh)), meshHash);
+}
+
+std::shared_ptr<const ColorMesh> MeshRegistry::find(const ColorMesh& mesh, size_t meshHash) const {
+    auto [begin, end] = meshes.equal_range(meshHash);
+    for (auto meshIt = begin; meshIt != end; ++meshIt) {
+        if (areEqual(*meshIt->second, mesh)) return meshIt->second;
+    }
+    return nullptr;
+}
+
+MeshHandle MeshRegistry::store(std::shared_ptr<const ColorMesh> mesh, size_t meshHash) {
+    cpuBytes += getCpuBytes(*mesh);
+    // The static batched meshes are only drawn baked into the static clusters, their own data never goes to the GPU
+    if (mesh->getRenderType() != RenderType::BatchedStatic) pendingUploads.push_back(mesh.get());
+    meshes.emplace(meshHash, mesh);
+    return MeshHandle(std::move(mesh));
+}
+
+bool MeshRegistry::areEqual(const ColorMesh& first, const ColorMesh& second) {
+    // The same vertices in another format are different data in the GPU
+    return first.getRenderType() == second.getRenderType() && first.getVertexFormat() == second.getVertexFormat() &&
+        first == second;
+}
+
+size_t MeshRegistry::getCpuBytes(const ColorMesh& mesh) {
+    return mesh.getVertices().size() * sizeof(ColorMesh::Vertex) +
+        mesh.getIndices().size() * sizeof(ColorMesh::Index) +
+        mesh.getFaces().size() * sizeof(Math::FaceIndices);
+}
+
+size_t MeshRegistry::getGpuBytes(const ColorMesh& mesh) {
+    return mesh.getVertices().size() * VertexPacker::getStride(mesh.getVertexFormat()) +
+        mesh.getIndices().size() * sizeof(ColorMesh::Index);
+}
+
+void MeshRegistry::uploadPendingMeshes() {
+    std::vector<const ColorMesh*> uploading;
+    {
+        std::lock_guard lock(mutex);
+        if (pendingUploads.empty()) return;
+        std::swap(uploading, pendingUploads);
+    }
+
+    // The upload is done without the lock, so the update side can keep registering meshes meanwhile
+    size_t uploadedBytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const ColorMesh* mesh : uploading) {
+        mesh->sendToGpuBuffers();
+        uploadedBytes += getGpuBytes(*mesh);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    std::lock_guard lock(mutex);
+    gpuBytes += uploadedBytes;
+    uploads += uploading.size();
+    uploadMillis += std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void MeshRegistry::uploadMesh(const ColorMesh& mesh) {
+    // Only the render side sends the meshes, so the flag can't change meanwhile
+    if (mesh.wasDataSentToGpu) return;
+    const auto start = std::chrono::steady_clock::now();
+    mesh.sendToGpuBuffers();
+    const auto end = std::chrono::steady_clock::now();
+
+    std::lock_guard lock(mutex);
+    pendingUploads.erase(std::remove(pendingUploads.begin(), pendingUploads.end(), &mesh), pendingUploads.end());
+    gpuBytes += getGpuBytes(mesh);
+    uploads++;
+    uploadMillis += std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+size_t MeshRegistry::releaseUnusedMeshes() {
+    std::lock_guard lock(mutex);
+    size_t released = 0;
+    for (auto meshIt = meshes.begin(); meshIt != meshes.end();) {
+        // Nobody can copy a handle to the mesh if only the registry has one
+        if (meshIt->second.use_count() > 1) {
+            ++meshIt;
+            continue;
+        }
+        const ColorMesh& mesh = *meshIt->second;
+        if (mesh.wasDataSentToGpu) {
+            gpuBytes -= getGpuBytes(mesh);
+            mesh.destroyBuffers();
+        }
+        cpuBytes -= getCpuBytes(mesh);
+        pendingUploads.erase(std::remove(pendingUploads.begin(), pendingUploads.end(), &mesh), pendingUploads.end());
+        meshIt = meshes.erase(meshIt);
+        released++;
+    }
+    return released;
+}
+
+void MeshRegistry::destroyGpuBuffers() {
+    std::lock_guard lock(mutex);
+    for (const auto& [meshHash, mesh] : meshes) {
+        if (!mesh->wasDataSentToGpu) continue;
+        mesh->destroyBuffers();
+        pendingUploads.push_back(mesh.get());
+    }
+    gpuBytes = 0;
+}
+
+MeshRegistry::Stats MeshRegistry::getStats() const {
+    std::lock_guard lock(mutex);
+    Stats stats;
+    stats.uniqueMeshes = meshes.size();
+    for (const auto& [meshHash, mesh] : meshes) {
+        stats.references += static_cast<size_t>(mesh.use_count()) - 1;
+    }
+    stats.cpuBytes = cpuBytes;
+    stats.gpuBytes = gpuBytes;
+    stats.uploads = uploads;
+    stats.uploadMillis = uploadMillis;
+    return stats;
+}
@@ -0,0 +1,260 @@
+#include "engine/subsystems/renderer/mesh/MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <unordered_map>
+
+using namespace GLESC::Render;
+
+namespace {
+    /**
+     * @brief Symmetric 4x4 matrix of a quadric, only the upper triangle is stored.
+     * @details The error of a point p is [p 1] Q [p 1]^T, the squared distance to the planes summed in Q.
+     */
+    struct Quadric {
+        std::array<double, 10> values{};
+
+        static Quadric fromPlane(double a, double b, double c, double d, double weight) {
+            Quadric quadric;
+            quadric.values = {
+                a * a * weight, a * b * weight, a * c * weight, a * d * weight,
+                b * b * weight, b * c * weight, b * d * weight,
+                c * c * weight, c * d * weight,
+                d * d * weight
+            };
+            return quadric;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            for (size_t index = 0; index < values.size(); index++) {
+                values[index] += other.values[index];
+            }
+            return *this;
+        }
+
+        [[nodiscard]] double error(const Position& point) const {
+            const double x = point.getX();
+            const double y = point.getY();
+            const double z = point.getZ();
+            const auto& q = values;
+            return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+                q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+                q[7] * z * z + 2 * q[8] * z +
+                q[9];
+        }
+    };
+
+    /**
+     * @brief A possible collapse of the position "from" onto the position "to", in the queue of collapses.
+     * @details The versions of the positions when the collapse was computed, if any end changed since then the
+     * collapse is outdated and it's skipped.
+     */
+    struct Collapse {
+        double error;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Collapse& other) const { return error > other.error; }
+    };
+
+    /**
+     * @brief Weight of the planes perpendicular to the open borders, large so the borders are collapsed last.
+     */
+    constexpr double borderWeight = 100.0;
+
+    uint64_t edgeKey(uint32_t first, uint32_t second) {
+        if (first > second) std::swap(first, second);
+        return static_cast<uint64_t>(first) << 32 | second;
+    }
+}
+
+MeshSimplifier::Result MeshSimplifier::simplifyPositions(const std::vector<Position>& positions,
+                                                         const std::vector<Index>& indices,
+                                                         size_t targetTriangleCount,
+                                                         float maxError) {
+    D_ASSERT_TRUE(indices.size() % 3 == 0, "Indices must be a list of triangles");
+    const size_t triangleCount = indices.size() / 3;
+
+    // The vertices with the same position are the same point of the surface
+    std::unordered_map<Position, uint32_t> positionIds;
+    positionIds.reserve(positions.size());
+    std::vector<uint32_t> vertexPositions(positions.size());
+    std::vector<Position> points;
+    for (size_t vertex = 0; vertex < positions.size(); vertex++) {
+        auto [positionIt, isNew] = positionIds.try_emplace(positions[vertex], static_cast<uint32_t>(points.size()));
+        if (isNew) points.push_back(positions[vertex]);
+        vertexPositions[vertex] = positionIt->second;
+    }
+    const size_t pointCount = points.size();
+
+    std::vector<uint32_t> corners(indices.size());
+    for (size_t index = 0; index < indices.size(); index++) {
+        corners[index] = vertexPositions[indices[index]];
+    }
+    std::vector<std::uint8_t> triangleAlive(triangleCount, 1);
+    size_t aliveTriangles = triangleCount;
+    std::vector<std::vector<uint32_t>> pointTriangles(pointCount);
+    std::vector<Quadric> quadrics(pointCount);
+    std::unordered_map<uint64_t, uint32_t> edgeUses;
+    edgeUses.reserve(indices.size());
+
+    for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+        const uint32_t* corner = &corners[triangle * 3];
+        if (corner[0] == corner[1] || corner[1] == corner[2] || corner[0] == corner[2]) {
+            triangleAlive[triangle] = 0;
+            aliveTriangles--;
+            continue;
+        }
+        const Vec3F normal = (points[corner[1]] - points[corner[0]]).cross(points[corner[2]] - points[corner[0]]);
+        const double doubleArea = normal.length();
+        for (size_t index = 0; index < 3; index++) {
+            pointTriangles[corner[index]].push_back(triangle);
+            edgeUses[edgeKey(corner[index], corner[(index + 1) % 3])]++;
+        }
+        if (doubleArea <= 0.0) continue;
+        const double a = normal.getX() / doubleArea;
+        const double b = normal.getY() / doubleArea;
+        const double c = normal.getZ() / doubleArea;
+        const double d = -(a * points[corner[0]].getX() + b * points[corner[0]].getY() + c * points[corner[0]].getZ());
+        // Weighted by the area, so the small triangles don't dominate the error
+        const Quadric quadric = Quadric::fromPlane(a, b, c, d, doubleArea * 0.5);
+        for (size_t index = 0; index < 3; index++) {
+            quadrics[corner[index]] += quadric;
+        }
+    }
+
+    // The edges with a single triangle are open borders, the plane perpendicular to the triangle through the edge
+    // keeps the border in place
+    for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+        if (triangleAlive[triangle] == 0) continue;
+        const uint32_t* corner = &corners[triangle * 3];
+        const Vec3F normal = (points[corner[1]] - points[corner[0]]).cross(points[corner[2]] - points[corner[0]]);
+        for (size_t index = 0; index < 3; index++) {
+            const uint32_t start = corner[index];
+            const uint32_t end = corner[(index + 1) % 3];
+            if (edgeUses[edgeKey(start, end)] != 1) continue;
+            const Vec3F edge = points[end] - points[start];
+            Vec3F borderNormal = edge.cross(normal);
+            const double length = borderNormal.length();
+            if (length <= 0.0) continue;
+            const double a = borderNormal.getX() / length;
+            const double b = borderNormal.getY() / length;
+            const double c = borderNormal.getZ() / length;
+            const double d = -(a * points[start].getX() + b * points[start].getY() + c * points[start].getZ());
+            const Quadric quadric = Quadric::fromPlane(a, b, c, d, borderWeight * edge.lengthSquared());
+            quadrics[start] += quadric;
+            quadrics[end] += quadric;
+        }
+    }
+
+    std::vector<uint32_t> versions(pointCount, 0);
+    std::vector<std::uint8_t> pointAlive(pointCount, 1);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> collapses;
+    // Both directions of the edge are queued, the cheapest is found first
+    auto queueEdge = [&](uint32_t from, uint32_t to) {
+        Quadric quadric = quadrics[from];
+        quadric += quadrics[to];
+        collapses.push({quadric.error(points[to]), from, to, versions[from], versions[to]});
+    };
+    for (const auto& [key, uses] : edgeUses) {
+        const auto first = static_cast<uint32_t>(key >> 32);
+        const auto second = static_cast<uint32_t>(key & 0xFFFFFFFFu);
+        queueEdge(first, second);
+        queueEdge(second, first);
+    }
+
+    // Checks that moving "from" onto "to" doesn't flip any of the triangles that remain around "from", and that
+    // some triangle remains
+    auto isCollapseValid = [&](uint32_t from, uint32_t to) {
+        size_t removedTriangles = 0;
+        for (uint32_t triangle : pointTriangles[from]) {
+            if (triangleAlive[triangle] == 0) continue;
+            const uint32_t* corner = &corners[triangle * 3];
+            if (corner[0] == to || corner[1] == to || corner[2] == to) {
+                removedTriangles++;
+                continue;
+            }
+            Position moved[3] = {points[corner[0]], points[corner[1]], points[corner[2]]};
+            for (size_t index = 0; index < 3; index++) {
+                if (corner[index] == from) moved[index] = points[to];
+            }
+            const Vec3F before =
+                (points[corner[1]] - points[corner[0]]).cross(points[corner[2]] - points[corner[0]]);
+            const Vec3F after = (moved[1] - moved[0]).cross(moved[2] - moved[0]);
+            if (before.dot(after) <= 0.0f) return false;
+        }
+        return removedTriangles < aliveTriangles;
+    };
+
+    double largestError = 0.0;
+    std::vector<uint32_t> neighbours;
+    while (aliveTriangles > targetTriangleCount && !collapses.empty()) {
+        const Collapse collapse = collapses.top();
+        collapses.pop();
+        if (pointAlive[collapse.from] == 0 || pointAlive[collapse.to] == 0 ||
+            versions[collapse.from] != collapse.fromVersion || versions[collapse.to] != collapse.toVersion) {
+            continue;
+        }
+        if (collapse.error > static_cast<double>(maxError)) break;
+        if (!isCollapseValid(collapse.from, collapse.to)) continue;
+
+        largestError = std::max(largestError, collapse.error);
+        pointAlive[collapse.from] = 0;
+        quadrics[collapse.to] += quadrics[collapse.from];
+        versions[collapse.to]++;
+        for (uint32_t triangle : pointTriangles[collapse.from]) {
+            if (triangleAlive[triangle] == 0) continue;
+            uint32_t* corner = &corners[triangle * 3];
+            for (size_t index = 0; index < 3; index++) {
+                if (corner[index] == collapse.from) corner[index] = collapse.to;
+            }
+            if (corner[0] == corner[1] || corner[1] == corner[2] || corner[0] == corner[2]) {
+                triangleAlive[triangle] = 0;
+                aliveTriangles--;
+            }
+            else {
+                pointTriangles[collapse.to].push_back(triangle);
+            }
+        }
+        pointTriangles[collapse.from].clear();
+
+        // The dead triangles are removed from the list of "to" and its edges are queued again
+        std::vector<uint32_t>& toTriangles = pointTriangles[collapse.to];
+        toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(),
+                                         [&](uint32_t triangle) { return triangleAlive[triangle] == 0; }),
+                          toTriangles.end());
+        neighbours.clear();
+        for (uint32_t triangle : toTriangles) {
+            for (size_t index = 0; index < 3; index++) {
+                const uint32_t corner = corners[triangle * 3 + index];
+                if (corner != collapse.to) neighbours.push_back(corner);
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (uint32_t neighbour : neighbours) {
+            queueEdge(collapse.to, neighbour);
+            queueEdge(neighbour, collapse.to);
+        }
+    }
+
+    Result result;
+    result.error = static_cast<float>(largestError);
+    result.positions = positions;
+    result.indices.reserve(aliveTriangles * 3);
+    for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+        if (triangleAlive[triangle] == 0) continue;
+        for (size_t index = 0; index < 3; index++) {
+            const Index vertex = indices[triangle * 3 + index];
+            result.indices.push_back(vertex);
+            // The corners were moved along every collapse of their position
+            result.positions[vertex] = points[corners[triangle * 3 + index]];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,258 @@
+#include "engine/subsystems/renderer/mesh/VertexPacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "engine/core/math/Math.h"
+
+using namespace GLESC::Render;
+using namespace GLESC::GAPI;
+
+namespace {
+    constexpr float snorm16Max = 32767.0f;
+    constexpr float snorm10Max = 511.0f;
+    constexpr uint32_t tenBits = 0x3FFu;
+
+    /**
+     * @brief Divides by the scale of the dequantization, the axes where the mesh is flat are stored as 0.
+     */
+    float quantizeAxis(float value, float scale, float offset) {
+        return GLESC::Math::eq(scale, 0.0f) ? 0.0f : (value - offset) / scale;
+    }
+
+    template <typename PackedVertex, typename PackPosition>
+    void packVertices(const std::vector<ColorVertex>& vertices, std::vector<uint8_t>& data,
+                      PackPosition packPosition) {
+        data.resize(vertices.size() * sizeof(PackedVertex));
+        for (size_t index = 0; index < vertices.size(); index++) {
+            const ColorVertex& vertex = vertices[index];
+            PackedVertex packed{};
+            for (size_t axis = 0; axis < 3; axis++) {
+                packed.position[axis] = packPosition(vertex.getPosition().get(axis), axis);
+            }
+            packed.normal = VertexPacker::packNormal(vertex.getNormal());
+            VertexPacker::packColor(vertex.getColor(), packed.color);
+            std::memcpy(data.data() + index * sizeof(PackedVertex), &packed, sizeof(PackedVertex));
+        }
+    }
+
+    template <typename PackedVertex, typename UnpackPosition>
+    std::vector<ColorVertex> unpackVertices(const std::vector<uint8_t>& data, UnpackPosition unpackPosition) {
+        std::vector<ColorVertex> vertices;
+        vertices.reserve(data.size() / sizeof(PackedVertex));
+        for (size_t offset = 0; offset + sizeof(PackedVertex) <= data.size(); offset += sizeof(PackedVertex)) {
+            PackedVertex packed{};
+            std::memcpy(&packed, data.data() + offset, sizeof(PackedVertex));
+            Position position(unpackPosition(packed.position[0], 0),
+                              unpackPosition(packed.position[1], 1),
+                              unpackPosition(packed.position[2], 2));
+            vertices.emplace_back(position, VertexPacker::unpackNormal(packed.normal),
+                                  VertexPacker::unpackColor(packed.color));
+        }
+        return vertices;
+    }
+}
+
+size_t VertexPacker::getStride(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Compact: return sizeof(CompactColorVertex);
+    case VertexFormat::Quantized: return sizeof(QuantizedColorVertex);
+    default: return sizeof(ColorVertex);
+    }
+}
+
+const std::vector<VertexBufferElement>& VertexPacker::getLayout(VertexFormat format) {
+    static const std::vector<VertexBufferElement> floatLayout{
+        {Enums::Types::Vec3F, Bool::False},
+        {Enums::Types::Vec3F, Bool::False},
+        {Enums::Types::Vec4F, Bool::False}
+    };
+    static const std::vector<VertexBufferElement> compactLayout{
+        {Enums::Types::Vec4H, Bool::False},
+        {Enums::Types::Int2101010Rev, Bool::True},
+        {Enums::Types::Vec4UB, Bool::True}
+    };
+    static const std::vector<VertexBufferElement> quantizedLayout{
+        {Enums::Types::Vec4S, Bool::True},
+        {Enums::Types::Int2101010Rev, Bool::True},
+        {Enums::Types::Vec4UB, Bool::True}
+    };
+    switch (format) {
+    case VertexFormat::Compact: return compactLayout;
+    case VertexFormat::Quantized: return quantizedLayout;
+    default: return floatLayout;
+    }
+}
+
+VertexPacker::PositionDequantization VertexPacker::getDequantization(VertexFormat format, const Position& min,
+                                                                     const Position& max) {
+    PositionDequantization dequantization;
+    if (format != VertexFormat::Quantized) return dequantization;
+    // The normalized shorts go from -1 to 1, the center of the box is 0
+    dequantization.scale = (max - min) / 2.0f;
+    dequantization.offset = (max + min) / 2.0f;
+    return dequantization;
+}
+
+VertexPacker::PackedVertices VertexPacker::pack(const std::vector<ColorVertex>& vertices, VertexFormat format,
+                                                const Position& min, const Position& max) {
+    PackedVertices packed;
+    packed.format = format;
+    packed.stride = getStride(format);
+    packed.dequantization = getDequantization(format, min, max);
+    switch (format) {
+    case VertexFormat::Compact:
+        packVertices<CompactColorVertex>(vertices, packed.data, [](float value, size_t) {
+            return floatToHalf(value);
+        });
+        break;
+    case VertexFormat::Quantized: {
+        const PositionDequantization& dequantization = packed.dequantization;
+        packVertices<QuantizedColorVertex>(vertices, packed.data, [&dequantization](float value, size_t axis) {
+            return floatToSnorm16(quantizeAxis(value, dequantization.scale.get(axis),
+                                               dequantization.offset.get(axis)));
+        });
+        break;
+    }
+    default:
+        packed.data.resize(vertices.size() * sizeof(ColorVertex));
+        std::memcpy(packed.data.data(), vertices.data(), packed.data.size());
+        break;
+    }
+    return packed;
+}
+
+std::vector<ColorVertex> VertexPacker::unpack(const PackedVertices& packed) {
+    switch (packed.format) {
+    case VertexFormat::Compact:
+        return unpackVertices<CompactColorVertex>(packed.data, [](uint16_t value, size_t) {
+            return halfToFloat(value);
+        });
+    case VertexFormat::Quantized: {
+        const PositionDequantization& dequantization = packed.dequantization;
+        return unpackVertices<QuantizedColorVertex>(packed.data, [&dequantization](int16_t value, size_t axis) {
+            return snorm16ToFloat(value) * dequantization.scale.get(axis) + dequantization.offset.get(axis);
+        });
+    }
+    default: {
+        std::vector<ColorVertex> vertices;
+        vertices.reserve(packed.getCount());
+        for (size_t offset = 0; offset < packed.data.size(); offset += sizeof(ColorVertex)) {
+            vertices.push_back(*reinterpret_cast<const ColorVertex*>(packed.data.data() + offset));
+        }
+        return vertices;
+    }
+    }
+}
+
+VertexPacker::ConversionError VertexPacker::measureError(const std::vector<ColorVertex>& vertices,
+                                                         VertexFormat format, const Position& min,
+                                                         const Position& max) {
+    const std::vector<ColorVertex> converted = unpack(pack(vertices, format, min, max));
+    ConversionError error;
+    for (size_t index = 0; index < vertices.size(); index++) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            error.position = std::max(error.position, std::abs(vertices[index].getPosition().get(axis) -
+                                                               converted[index].getPosition().get(axis)));
+            error.normal = std::max(error.normal, std::abs(vertices[index].getNormal().get(axis) -
+                                                           converted[index].getNormal().get(axis)));
+        }
+        for (size_t channel = 0; channel < 4; channel++) {
+            error.color = std::max(error.color, std::abs(vertices[index].getColor().get(channel) -
+                                                         converted[index].getColor().get(channel)));
+        }
+    }
+    return error;
+}
+
+uint16_t VertexPacker::floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+    // Infinity and NaN, the NaN keeps a bit of the mantissa so it doesn't become infinity
+    if (exponent == 0xFFu) return static_cast<uint16_t>(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u));
+
+    const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1F) return static_cast<uint16_t>(sign | 0x7C00u);
+    if (halfExponent <= 0) {
+        // Subnormal half, the implicit bit of the float becomes explicit
+        if (halfExponent < -10) return sign;
+        mantissa |= 0x800000u;
+        const auto shift = static_cast<uint32_t>(14 - halfExponent);
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u) != 0)) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    // Rounding up can carry into the exponent, which is still the right result (up to infinity)
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0)) half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float VertexPacker::halfToFloat(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent == 0) {
+        // Zero or subnormal, the value is the mantissa in units of 2^-24
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+int16_t VertexPacker::floatToSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * snorm16Max));
+}
+
+float VertexPacker::snorm16ToFloat(int16_t value) {
+    // -32768 and -32767 are both -1, as OpenGL does
+    return std::max(static_cast<float>(value) / snorm16Max, -1.0f);
+}
+
+uint32_t VertexPacker::packNormal(const Normal& normal) {
+    uint32_t packed = 0;
+    for (size_t axis = 0; axis < 3; axis++) {
+        const long component = std::lround(std::clamp(normal.get(axis), -1.0f, 1.0f) * snorm10Max);
+        // Two's complement in 10 bits
+        packed |= (static_cast<uint32_t>(component) & tenBits) << (axis * 10);
+    }
+    return packed;
+}
+
+Normal VertexPacker::unpackNormal(uint32_t packed) {
+    Normal normal;
+    for (size_t axis = 0; axis < 3; axis++) {
+        uint32_t bits = (packed >> (axis * 10)) & tenBits;
+        // Sign extension of the 10 bits
+        const int component = (bits & 0x200u) != 0 ? static_cast<int>(bits) - 1024 : static_cast<int>(bits);
+        normal.set(axis, std::max(static_cast<float>(component) / snorm10Max, -1.0f));
+    }
+    return normal;
+}
+
+void VertexPacker::packColor(const ColorRgbaNorm& color, uint8_t (&packed)[4]) {
+    for (size_t channel = 0; channel < 4; channel++) {
+        packed[channel] = static_cast<uint8_t>(std::lround(std::clamp(color.get(channel), 0.0f, 1.0f) * 255.0f));
+    }
+}
+
+ColorRgba VertexPacker::unpackColor(const uint8_t (&packed)[4]) {
+    return {static_cast<float>(packed[0]), static_cast<float>(packed[1]), static_cast<float>(packed[2]),
+            static_cast<float>(packed[3])};
+}
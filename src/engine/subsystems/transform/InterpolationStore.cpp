@@ -0,0 +1,170 @@
+#include "engine/subsystems/transform/InterpolationStore.h"
+
+#include <array>
+#include <cstring>
+
+#include "engine/core/asserts/Asserts.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(_M_X64))
+#define GLESC_INTERPOLATION_SIMD
+#define GLESC_INTERPOLATION_INLINE __attribute__((always_inline)) inline
+#else
+#define GLESC_INTERPOLATION_INLINE inline
+#endif
+
+using namespace GLESC::Transform;
+
+namespace {
+#ifdef GLESC_INTERPOLATION_SIMD
+    // Vectors of the compiler, like the batch matrices, one object per lane
+    typedef float Float4 __attribute__((vector_size(16)));
+    typedef float Float8 __attribute__((vector_size(32)));
+#endif
+
+    /**
+     * @brief The arrays of the components of a store, in the order position, orientation and scale.
+     */
+    template <typename Pointer, typename Store>
+    std::array<Pointer, 10> getComponents(Store& store) {
+        return {
+            store.positionX.data(), store.positionY.data(), store.positionZ.data(),
+            store.orientationX.data(), store.orientationY.data(), store.orientationZ.data(),
+            store.orientationW.data(), store.scaleX.data(), store.scaleY.data(), store.scaleZ.data()
+        };
+    }
+
+    using InputComponents = std::array<const float*, 10>;
+    using OutputComponents = std::array<float*, 10>;
+
+    /**
+     * @brief Interpolates the objects [first, first + width), where width is the number of floats in Lanes.
+     * @details Always inlined so the vectors never cross a function call, see MatrixBatch.
+     */
+    template <typename Lanes>
+    GLESC_INTERPOLATION_INLINE void interpolateLanes(const InputComponents& lastComponents,
+                                                     const InputComponents& currentComponents,
+                                                     const OutputComponents& outputComponents,
+                                                     float alpha, size_t first) {
+        Lanes from[10];
+        Lanes to[10];
+        for (size_t component = 0; component < 10; component++) {
+            std::memcpy(&from[component], lastComponents[component] + first, sizeof(Lanes));
+            std::memcpy(&to[component], currentComponents[component] + first, sizeof(Lanes));
+        }
+        // The quaternion is negated if needed so the rotation takes the shortest arc, like Quaternion::nlerp
+        const Lanes dot = from[3] * to[3] + from[4] * to[4] + from[5] * to[5] + from[6] * to[6];
+        const Lanes one = Lanes{} + 1.0f;
+        const Lanes sign = dot < Lanes{} ? -one : one;
+        for (size_t component = 3; component < 7; component++) {
+            to[component] = to[component] * sign;
+        }
+        for (size_t component = 0; component < 10; component++) {
+            const Lanes value = from[component] + (to[component] - from[component]) * alpha;
+            std::memcpy(outputComponents[component] + first, &value, sizeof(Lanes));
+        }
+    }
+
+    void interpolateScalar(const InputComponents& lastComponents, const InputComponents& currentComponents,
+                           const OutputComponents& outputComponents, float alpha, size_t begin, size_t end) {
+        for (size_t index = begin; index < end; index++) {
+            interpolateLanes<float>(lastComponents, currentComponents, outputComponents, alpha, index);
+        }
+    }
+
+    void interpolateSSE(const InputComponents& lastComponents, const InputComponents& currentComponents,
+                        const OutputComponents& outputComponents, float alpha, size_t begin, size_t end) {
+        size_t index = begin;
+#ifdef GLESC_INTERPOLATION_SIMD
+        for (; index + 4 <= end; index += 4) {
+            interpolateLanes<Float4>(lastComponents, currentComponents, outputComponents, alpha, index);
+        }
+#endif
+        interpolateScalar(lastComponents, currentComponents, outputComponents, alpha, index, end);
+    }
+
+#ifdef GLESC_INTERPOLATION_SIMD
+    __attribute__((target("avx2")))
+    void interpolateAVX2(const InputComponents& lastComponents, const InputComponents& currentComponents,
+                         const OutputComponents& outputComponents, float alpha, size_t begin, size_t end) {
+        size_t index = begin;
+        for (; index + 8 <= end; index += 8) {
+            interpolateLanes<Float8>(lastComponents, currentComponents, outputComponents, alpha, index);
+        }
+        interpolateSSE(lastComponents, currentComponents, outputComponents, alpha, index, end);
+    }
+#endif
+}
+
+void InterpolationStore::push(Handle handle, const Pose& pose) {
+    if (handle >= size()) {
+        last.resize(static_cast<size_t>(handle) + 1);
+        current.resize(static_cast<size_t>(handle) + 1);
+        pushedIn.resize(static_cast<size_t>(handle) + 1, 0);
+    }
+    // Pushed again in the same update, for example by the mesh and the light of the same entity
+    if (pushedIn[handle] == updateNumber) {
+        current.set(handle, pose);
+        return;
+    }
+    const bool pushedInLastUpdate = pushedIn[handle] != 0 && pushedIn[handle] + 1 == updateNumber;
+    if (pushedInLastUpdate && (pose.position - current.getPosition(handle)).length() <= teleportDistance) {
+        last.set(handle, current, handle);
+    }
+    else {
+        last.set(handle, pose);
+    }
+    current.set(handle, pose);
+    pushedIn[handle] = updateNumber;
+}
+
+void InterpolationStore::push(Handle handle, const Transform& transform) {
+    push(handle, Pose{transform.getPosition(), transform.getOrientation(), transform.getScale()});
+}
+
+void InterpolationStore::remove(Handle handle) {
+    if (handle < size()) pushedIn[handle] = 0;
+}
+
+bool InterpolationStore::contains(Handle handle) const {
+    return handle < size() && pushedIn[handle] != 0;
+}
+
+Pose InterpolationStore::interpolate(Handle handle, float alpha) const {
+    D_ASSERT_TRUE(contains(handle), "The handle hasn't been pushed");
+    const float clampedAlpha = Math::min(alpha, 1.0f);
+    const Pose from = last.getPose(handle);
+    const Pose to = current.getPose(handle);
+    return {
+        from.position.lerp(to.position, clampedAlpha),
+        from.orientation.nlerp(to.orientation, clampedAlpha),
+        from.scale.lerp(to.scale, clampedAlpha)
+    };
+}
+
+void InterpolationStore::interpolate(float alpha, size_t begin, size_t end, TransformStore& output) const {
+    D_ASSERT_TRUE(begin <= end && end <= size(), "The range must be inside the store");
+    D_ASSERT_TRUE(output.size() >= end, "The output must have room for the range");
+    const float clampedAlpha = Math::min(alpha, 1.0f);
+    const InputComponents lastComponents = getComponents<const float*>(last);
+    const InputComponents currentComponents = getComponents<const float*>(current);
+    const OutputComponents outputComponents = getComponents<float*>(output);
+#ifdef GLESC_INTERPOLATION_SIMD
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if (hasAVX2) {
+        interpolateAVX2(lastComponents, currentComponents, outputComponents, clampedAlpha, begin, end);
+        return;
+    }
+#endif
+    interpolateSSE(lastComponents, currentComponents, outputComponents, clampedAlpha, begin, end);
+}
+
+void InterpolationStore::interpolate(float alpha, TransformStore& output) const {
+    output.resize(size());
+    interpolate(alpha, 0, size(), output);
+}
+
+void InterpolationStore::clear() {
+    last.clear();
+    current.clear();
+    pushedIn.clear();
+}
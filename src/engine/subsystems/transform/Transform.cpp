@@ -18,6 +18,7 @@ using namespace GLESC::Transform;
 Transform::Transform(Position position, Rotation rotation, Scale scale) :
     position(std::move(position)),
     rotationDegrees(std::move(rotation)),
+    orientation(Orientation::fromEuler(rotationDegrees.toRads())),
     scale(std::move(scale)) {
 }
 
@@ -107,10 +108,30 @@ Rotation Transformer::lookAt(const Position& from, const Position& to, const Mat
 
 GLESC::Math::BoundingVolume Transformer::transformBoundingVolume(const Math::BoundingVolume& boundingVolume,
                                                                  const Render::Model& matrix) {
-    return {
-        transformVector(boundingVolume.getVolume().min, matrix),
-        transformVector(boundingVolume.getVolume().max, matrix)
+    // Arvo's method: the box is transformed as a center and an extent. The center is transformed as a point, and
+    // each component of the new extent is the sum of the old extent weighted by the absolute values of the row of
+    // the linear part of the matrix. This gives the tightest box that encloses the transformed box, even with
+    // rotations, without transforming the 8 corners. The matrix must be affine, as model matrices are.
+    auto element = [&matrix](size_t row, size_t column) {
+        if constexpr (Math::MatrixAlgorithms::columnMajorMatrix) return matrix[column][row];
+        else return matrix[row][column];
     };
+    const Math::BoundingVolume::AABB& box = boundingVolume.getVolume();
+    Position min;
+    Position max;
+    for (size_t row = 0; row < 3; row++) {
+        float center = element(row, 3);
+        float extent = 0.0f;
+        for (size_t column = 0; column < 3; column++) {
+            const float localCenter = (box.min.get(column) + box.max.get(column)) * 0.5f;
+            const float localExtent = (box.max.get(column) - box.min.get(column)) * 0.5f;
+            center += element(row, column) * localCenter;
+            extent += Math::abs(element(row, column)) * localExtent;
+        }
+        min.set(row, center - extent);
+        max.set(row, center + extent);
+    }
+    return {min, max};
 }
 
 GLESC::Math::BoundingVolume Transformer::transformBoundingVolume(const Math::BoundingVolume& boundingVolume,
@@ -165,21 +186,25 @@ void Interpolator::pushTransform(const Transform& transform) {
 }
 
 Transform Interpolator::interpolate(float alphaParam) const {
-    // If rotation difference is more than 180 degrees, don't interpolate
-    if (Math::abs(lastTransform.getRotation().getX() - currentTransform.getRotation().getX()) > 180.0f ||
-        Math::abs(lastTransform.getRotation().getY() - currentTransform.getRotation().getY()) > 180.0f ||
-        Math::abs(lastTransform.getRotation().getZ() - currentTransform.getRotation().getZ()) > 180.0f) {
-        return currentTransform;
-    }
     // Clamp alpha to [0, 1]
     float alpha = Math::min(alphaParam, 1.0f);
     Transform interpolatedTransform;
     interpolatedTransform.setPosition(
         lastTransform.getPosition().lerp(currentTransform.getPosition(), alpha));
-    interpolatedTransform.setRotation(
-        lastTransform.getRotation().lerp(currentTransform.getRotation(), alpha));
     interpolatedTransform.setScale(
         lastTransform.getScale().lerp(currentTransform.getScale(), alpha));
+
+    // Each angle goes the shortest way, 350 to 10 degrees goes through 360 instead of going back 340 degrees
+    Rotation angles;
+    for (size_t axis = 0; axis < 3; axis++) {
+        const RotComp last = lastTransform.getRotation().get(axis);
+        RotComp difference = Math::mod(currentTransform.getRotation().get(axis) - last, 360.0f);
+        if (difference > 180.0f) difference -= 360.0f;
+        else if (difference < -180.0f) difference += 360.0f;
+        angles.set(axis, last + difference * alpha);
+    }
+    interpolatedTransform.setInterpolatedRotation(
+        angles, lastTransform.getOrientation().slerp(currentTransform.getOrientation(), alpha));
     return interpolatedTransform;
 }
 
@@ -190,7 +215,7 @@ std::vector<EntityStatsManager::Value> Transform::getDebuggingValues() {
     EntityStatsManager::Value positionValue;
     positionValue.name = "Position";
     positionValue.data = reinterpret_cast<void*>(&position);
-    positionValue.valueDirty = &dirty;
+    positionValue.valueDirty = &debugValuesEdited;
     positionValue.type = EntityStatsManager::ValueType::VEC3F;
     positionValue.isModifiable = true;
     positionValue.usesSlider = false;
@@ -199,7 +224,7 @@ std::vector<EntityStatsManager::Value> Transform::getDebuggingValues() {
     EntityStatsManager::Value rotationValue;
     rotationValue.name = "Rotation";
     rotationValue.data = reinterpret_cast<void*>(&rotationDegrees);
-    positionValue.valueDirty = &dirty;
+    rotationValue.valueDirty = &debugValuesEdited;
     rotationValue.type = EntityStatsManager::ValueType::VEC3F;
     rotationValue.isModifiable = true;
     rotationValue.usesSlider = true;
@@ -210,7 +235,7 @@ std::vector<EntityStatsManager::Value> Transform::getDebuggingValues() {
     EntityStatsManager::Value scaleValue;
     scaleValue.name = "Scale";
     scaleValue.data = reinterpret_cast<void*>(&scale);
-    positionValue.valueDirty = &dirty;
+    scaleValue.valueDirty = &debugValuesEdited;
     scaleValue.type = EntityStatsManager::ValueType::VEC3F;
     scaleValue.isModifiable = true;
     scaleValue.usesSlider = true;
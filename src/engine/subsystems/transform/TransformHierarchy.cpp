@@ -0,0 +1,205 @@
+#include "engine/subsystems/transform/TransformHierarchy.h"
+
+#include <type_traits>
+
+#include "engine/core/asserts/Asserts.h"
+
+using namespace GLESC::Transform;
+
+void TransformHierarchy::addNode(NodeID node) {
+    D_ASSERT_TRUE(node != nullNode, "The null node can't be added");
+    D_ASSERT_FALSE(hasNode(node), "The node is already in the hierarchy");
+    if (node >= nodeIndices.size()) nodeIndices.resize(static_cast<size_t>(node) + 1, noIndex);
+    nodeIndices[node] = nodes.size();
+    nodes.push_back(node);
+    parents.push_back(nullNode);
+    parentIndices.push_back(noIndex);
+    localPoses.emplace_back();
+    worldPoses.emplace_back();
+    worldMatrices.emplace_back(1.0f);
+    localDirty.push_back(1);
+    worldUpdated.push_back(0);
+    orderDirty = true;
+}
+
+void TransformHierarchy::removeNode(NodeID node) {
+    const size_t index = indexOf(node);
+    for (size_t child = 0; child < nodes.size(); child++) {
+        if (parents[child] != node) continue;
+        parents[child] = nullNode;
+        localDirty[child] = 1;
+    }
+
+    // The last node takes the place of the removed one, the order is restored by the next sort
+    const size_t last = nodes.size() - 1;
+    if (index != last) {
+        nodes[index] = nodes[last];
+        parents[index] = parents[last];
+        localPoses[index] = localPoses[last];
+        worldPoses[index] = worldPoses[last];
+        worldMatrices[index] = worldMatrices[last];
+        localDirty[index] = localDirty[last];
+        worldUpdated[index] = worldUpdated[last];
+        nodeIndices[nodes[index]] = index;
+    }
+    nodes.pop_back();
+    parents.pop_back();
+    parentIndices.pop_back();
+    localPoses.pop_back();
+    worldPoses.pop_back();
+    worldMatrices.pop_back();
+    localDirty.pop_back();
+    worldUpdated.pop_back();
+    nodeIndices[node] = noIndex;
+    orderDirty = true;
+}
+
+bool TransformHierarchy::hasNode(NodeID node) const {
+    return node < nodeIndices.size() && nodeIndices[node] != noIndex;
+}
+
+size_t TransformHierarchy::indexOf(NodeID node) const {
+    D_ASSERT_TRUE(hasNode(node), "The node isn't in the hierarchy");
+    return nodeIndices[node];
+}
+
+bool TransformHierarchy::setParent(NodeID node, NodeID parent) {
+    const size_t index = indexOf(node);
+    if (parents[index] == parent) return true;
+    bool accepted = true;
+    if (parent != nullNode) {
+        D_ASSERT_TRUE(hasNode(parent), "The parent isn't in the hierarchy");
+        // The hierarchy never has cycles, so the walk always ends at a root
+        for (NodeID ancestor = parent; ancestor != nullNode; ancestor = parents[indexOf(ancestor)]) {
+            if (ancestor == node) {
+                accepted = false;
+                parent = nullNode;
+                break;
+            }
+        }
+    }
+    if (parents[index] != parent) {
+        parents[index] = parent;
+        localDirty[index] = 1;
+        orderDirty = true;
+    }
+    return accepted;
+}
+
+TransformHierarchy::NodeID TransformHierarchy::getParent(NodeID node) const {
+    return parents[indexOf(node)];
+}
+
+void TransformHierarchy::setLocalPose(NodeID node, const Pose& pose) {
+    const size_t index = indexOf(node);
+    if (localPoses[index] == pose) return;
+    localPoses[index] = pose;
+    localDirty[index] = 1;
+}
+
+void TransformHierarchy::setLocalTransform(NodeID node, const Transform& transform) {
+    setLocalPose(node, {transform.getPosition(), transform.getOrientation(), transform.getScale()});
+}
+
+bool TransformHierarchy::isWorldUpdated(NodeID node) const {
+    return worldUpdated[indexOf(node)] != 0;
+}
+
+const TransformHierarchy::Pose& TransformHierarchy::getWorldPose(NodeID node) const {
+    return worldPoses[indexOf(node)];
+}
+
+const GLESC::Render::Model& TransformHierarchy::getWorldMatrix(NodeID node) const {
+    return worldMatrices[indexOf(node)];
+}
+
+void TransformHierarchy::applyWorldPose(NodeID node, Transform& transform) const {
+    const Pose& world = getWorldPose(node);
+    transform.setPosition(world.position);
+    transform.setOrientation(world.orientation);
+    transform.setScale(world.scale);
+}
+
+TransformHierarchy::Pose TransformHierarchy::combine(const Pose& parentWorld, const Pose& local) {
+    Pose world;
+    world.position = parentWorld.position + parentWorld.orientation.rotate(parentWorld.scale * local.position);
+    world.orientation = (parentWorld.orientation * local.orientation).normalize();
+    world.scale = parentWorld.scale * local.scale;
+    return world;
+}
+
+void TransformHierarchy::sortNodes() {
+    // Children lists as linked lists over the current indices, built backwards to keep the order of the siblings
+    std::vector<size_t> firstChild(nodes.size(), noIndex);
+    std::vector<size_t> nextSibling(nodes.size(), noIndex);
+    std::vector<size_t> stack;
+    for (size_t index = nodes.size(); index-- > 0;) {
+        if (parents[index] == nullNode) {
+            stack.push_back(index);
+            continue;
+        }
+        const size_t parent = indexOf(parents[index]);
+        nextSibling[index] = firstChild[parent];
+        firstChild[parent] = index;
+    }
+
+    // Depth first from the roots, the stack has the roots in reverse so the first root is visited first
+    std::vector<size_t> order;
+    order.reserve(nodes.size());
+    std::vector<size_t> children;
+    while (!stack.empty()) {
+        const size_t index = stack.back();
+        stack.pop_back();
+        order.push_back(index);
+        children.clear();
+        for (size_t child = firstChild[index]; child != noIndex; child = nextSibling[child]) {
+            children.push_back(child);
+        }
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    D_ASSERT_EQUAL(order.size(), nodes.size(), "Every node must be reachable from a root");
+
+    auto permute = [&order](auto& values) {
+        std::remove_reference_t<decltype(values)> sorted;
+        sorted.reserve(values.size());
+        for (size_t index : order) sorted.push_back(values[index]);
+        values = std::move(sorted);
+    };
+    permute(nodes);
+    permute(parents);
+    permute(localPoses);
+    permute(worldPoses);
+    permute(worldMatrices);
+    permute(localDirty);
+    permute(worldUpdated);
+
+    for (size_t index = 0; index < nodes.size(); index++) {
+        nodeIndices[nodes[index]] = index;
+    }
+    for (size_t index = 0; index < nodes.size(); index++) {
+        parentIndices[index] = parents[index] == nullNode ? noIndex : nodeIndices[parents[index]];
+    }
+    orderDirty = false;
+    stats.sorts++;
+}
+
+void TransformHierarchy::update() {
+    if (orderDirty) sortNodes();
+    stats.nodes = nodes.size();
+    stats.updatedNodes = 0;
+    for (size_t index = 0; index < nodes.size(); index++) {
+        const size_t parent = parentIndices[index];
+        // The parent was already visited in this pass
+        const bool parentUpdated = parent != noIndex && worldUpdated[parent] != 0;
+        if (localDirty[index] == 0 && !parentUpdated) {
+            worldUpdated[index] = 0;
+            continue;
+        }
+        Pose& world = worldPoses[index];
+        world = parent == noIndex ? localPoses[index] : combine(worldPoses[parent], localPoses[index]);
+        worldMatrices[index].makeModelMatrix(world.position, world.orientation, world.scale);
+        localDirty[index] = 0;
+        worldUpdated[index] = 1;
+        stats.updatedNodes++;
+    }
+}
@@ -3,12 +3,14 @@
 #include "engine/ecs/frontend/component/CameraComponent.h"
 #include "engine/ecs/frontend/component/CollisionComponent.h"
 #include "engine/ecs/frontend/component/FogComponent.h"
+#include "engine/ecs/frontend/component/HierarchyComponent.h"
 #include "engine/ecs/frontend/component/InputComponent.h"
 #include "engine/ecs/frontend/component/LightComponent.h"
 #include "engine/ecs/frontend/component/PhysicsComponent.h"
 #include "engine/ecs/frontend/component/RenderComponent.h"
 #include "engine/ecs/frontend/component/SunComponent.h"
 #include "engine/ecs/frontend/component/TransformComponent.h"
+#include "engine/res-mng/models/MeshCache.h"
 #include "engine/subsystems/ingame-debug/Console.h"
 #include "engine/subsystems/renderer/mesh/MeshFactory.h"
 #include "engine/subsystems/sound/SoundPlayer.h"
@@ -53,22 +55,27 @@ void ShootTheChickenGame::createChickenMesh() {
     chickenMesh.attatchMesh(chickenPeak);
     chickenMesh.attatchMesh(chickenEye1);
     chickenMesh.attatchMesh(chickenEye2);
-    chickenMesh.finishBuilding();
+    // The attached parts don't share vertices, optimizing welds them and reorders the triangles for the GPU
+    chickenMesh.finishBuilding(true);
 }
 
-void createGrassBlock(Render::ColorMesh& grassBlock, float grassBlockWidth, int bladesPerBlock) {
+/**
+ * @brief The seeds of the random layout of the vegetation, a rebuilt mesh is the same as the cached one.
+ */
+constexpr uint64_t grassSeed = 1;
+constexpr uint64_t bushesSeed = 2;
+
+void createGrassBlock(Render::ColorMesh& grassBlock, float grassBlockWidth, int bladesPerBlock,
+                      Math::RandomGenerator& random) {
     grassBlock.startBuilding();
     Render::ColorMesh singleGrassBlade =
         Render::MeshFactory::cuboid(0.3f, 0.5f, 0.3f, Render::ColorRgb::Green);
+    // The x and z offsets of all the blades, generated at once
+    std::vector<float> offsets(static_cast<size_t>(bladesPerBlock) * 2);
+    random.fillUniform(offsets.data(), offsets.size(), -grassBlockWidth / 2, grassBlockWidth / 2);
     for (int j = 0; j < bladesPerBlock; j++) {
         Render::ColorMesh grassBlade = singleGrassBlade;
-        Transform::Transformer::translateMesh(grassBlade, {
-                                                  Math::generateRandomNumber(
-                                                      -grassBlockWidth / 2, grassBlockWidth / 2),
-                                                  0,
-                                                  Math::generateRandomNumber(
-                                                      -grassBlockWidth / 2, grassBlockWidth / 2)
-                                              });
+        Transform::Transformer::translateMesh(grassBlade, {offsets[j * 2], 0, offsets[j * 2 + 1]});
         grassBlock.attatchMesh(grassBlade);
     }
     grassBlock.finishBuilding();
@@ -79,12 +86,14 @@ void ShootTheChickenGame::createGrassMesh() {
     int bladesPerBlock = 5;
     int numberOfGrassBlocks = 100;
 
+    Math::RandomGenerator random(grassSeed);
+
     allGrassMesh.startBuilding();
     for (int i = 0; i < numberOfGrassBlocks; i++) {
         for (int j = 0; j < numberOfGrassBlocks; j++) {
-            if (Math::tossCoinWithChance(0.9) == true) continue;
+            if (random.chance(0.9f) == true) continue;
             Render::ColorMesh grassBlock;
-            createGrassBlock(grassBlock, grassBlockWidth, bladesPerBlock);
+            createGrassBlock(grassBlock, grassBlockWidth, bladesPerBlock, random);
             Transform::Transformer::translateMesh(grassBlock,
                                                   {
                                                       static_cast<float>(i) * grassBlockWidth - static_cast<float>(
@@ -96,7 +105,7 @@ void ShootTheChickenGame::createGrassMesh() {
             allGrassMesh.attatchMesh(grassBlock);
         }
     }
-    allGrassMesh.finishBuilding();
+    allGrassMesh.finishBuilding(true);
 }
 
 
@@ -114,13 +123,10 @@ void ShootTheChickenGame::createPlayerMesh() {
     playerGun.attatchMesh(playerHand);
     playerGun.finishBuilding();
 
-    // Rotate the gun to the left
-    Transform::Transformer::rotateMesh(playerGun, {25, 25, 0});
-    // Lift the gun to the player's hands
-    Transform::Transformer::translateMesh(playerGun, {1.3, -1.5, -3});
+    // The gun is placed in the player's hands by the local transform of its entity, see createPlayerEntity
     playerMesh.startBuilding();
     playerMesh.attatchMesh(playerGun);
-    playerMesh.finishBuilding();
+    playerMesh.finishBuilding(true);
 }
 
 void ShootTheChickenGame::createTreeMesh() {
@@ -130,41 +136,42 @@ void ShootTheChickenGame::createTreeMesh() {
     treeMesh.startBuilding();
     treeMesh.attatchMesh(treeTrunk);
     treeMesh.attatchMesh(treeTop);
-    treeMesh.finishBuilding();
+    treeMesh.finishBuilding(true);
 }
 
-Vec3 calculateBerryPosition(float bushWidth, float bushRadius, float bushDepth, float berryRadius) {
+Vec3 calculateBerryPosition(float bushWidth, float bushRadius, float bushDepth, float berryRadius,
+                            Math::RandomGenerator& random) {
     // Randomly select one of the six faces
-    int face = Math::generateRandomNumber(0, 5);
+    int face = random.uniform(0, 5);
 
     // Variables to store berry position
     float x, y, z;
 
     switch (face) {
     case 0: // Front face
-        x = Math::generateRandomNumber(-bushWidth / 2, bushWidth / 2);
-        y = Math::generateRandomNumber(0.0f, bushRadius / 2);
+        x = random.uniform(-bushWidth / 2, bushWidth / 2);
+        y = random.uniform(0.0f, bushRadius / 2);
         z = bushDepth / 2 - berryRadius;
         break;
     case 1: // Back face
-        x = Math::generateRandomNumber(-bushWidth / 2, bushWidth / 2);
-        y = Math::generateRandomNumber(0.0f, bushRadius / 2);
+        x = random.uniform(-bushWidth / 2, bushWidth / 2);
+        y = random.uniform(0.0f, bushRadius / 2);
         z = -bushDepth / 2 + berryRadius;
         break;
     case 2: // Left face
         x = -bushWidth / 2 + berryRadius;
-        y = Math::generateRandomNumber(0.0f, bushRadius / 2);
-        z = Math::generateRandomNumber(-bushDepth / 2, bushDepth / 2);
+        y = random.uniform(0.0f, bushRadius / 2);
+        z = random.uniform(-bushDepth / 2, bushDepth / 2);
         break;
     case 3: // Right face
         x = bushWidth / 2 - berryRadius;
-        y = Math::generateRandomNumber(0.0f, bushRadius / 2);
-        z = Math::generateRandomNumber(-bushDepth / 2, bushDepth / 2);
+        y = random.uniform(0.0f, bushRadius / 2);
+        z = random.uniform(-bushDepth / 2, bushDepth / 2);
         break;
     default: // Top face
-        x = Math::generateRandomNumber(-bushWidth / 2, bushWidth / 2);
+        x = random.uniform(-bushWidth / 2, bushWidth / 2);
         y = bushRadius / 2;
-        z = Math::generateRandomNumber(-bushDepth / 2, bushDepth / 2);
+        z = random.uniform(-bushDepth / 2, bushDepth / 2);
         break;
     }
     return {x, y, z};
@@ -172,13 +179,14 @@ Vec3 calculateBerryPosition(float bushWidth, float bushRadius, float bushDepth,
 
 void ShootTheChickenGame::createBushesMeshes() {
     int numOfBushes = 100;
+    Math::RandomGenerator random(bushesSeed);
     allBushesMesh.startBuilding();
     for (int i = 0; i < numOfBushes; i++) {
-        float bushWidth = Math::generateRandomNumber(4.f, 12.f);
-        float bushHeight = Math::generateRandomNumber(1.f, 5.f);
-        float bushDepth = Math::generateRandomNumber(4.f, 12.f);
-        float bushPositionX = Math::generateRandomNumber(-100.f, 100.f);
-        float bushPositionZ = Math::generateRandomNumber(-100.f, 100.f);
+        float bushWidth = random.uniform(4.f, 12.f);
+        float bushHeight = random.uniform(1.f, 5.f);
+        float bushDepth = random.uniform(4.f, 12.f);
+        float bushPositionX = random.uniform(-100.f, 100.f);
+        float bushPositionZ = random.uniform(-100.f, 100.f);
         float chanceOfHavingBerries = 0.05;
         float radiusOfBerry = 0.4f;
         float bushVolume = bushWidth * bushHeight * bushDepth;
@@ -188,16 +196,16 @@ void ShootTheChickenGame::createBushesMeshes() {
         Render::ColorMesh berryMesh =
             Render::MeshFactory::sphere(6, 6, radiusOfBerry, Render::ColorRgb::Red);
         bush.startBuilding();
-        if (Math::tossCoinWithChance(chanceOfHavingBerries) == true
+        if (random.chance(chanceOfHavingBerries) == true
             // Ensure the berries are close to the player to be visible
             && bushPositionX < 100 && bushPositionZ < 100
             && bushPositionX > -100 && bushPositionZ > -100) {
-            numberOfBerries = static_cast<int>(Math::generateRandomNumber(bushVolume * 0.05f / radiusOfBerry / 2,
-                                                                          bushVolume * 0.05f / radiusOfBerry));
+            numberOfBerries = static_cast<int>(random.uniform(bushVolume * 0.05f / radiusOfBerry / 2,
+                                                              bushVolume * 0.05f / radiusOfBerry));
             for (int j = 0; j < numberOfBerries; j++) {
                 Render::ColorMesh berry = berryMesh;
                 Transform::Transformer::translateMesh(
-                    berry, calculateBerryPosition(bushWidth, bushHeight, bushDepth, radiusOfBerry));
+                    berry, calculateBerryPosition(bushWidth, bushHeight, bushDepth, radiusOfBerry, random));
                 bush.attatchMesh(berry);
             }
         }
@@ -205,7 +213,7 @@ void ShootTheChickenGame::createBushesMeshes() {
         Transform::Transformer::translateMesh(bush, {bushPositionX, 0, bushPositionZ});
         allBushesMesh.attatchMesh(bush);
     }
-    allBushesMesh.finishBuilding();
+    allBushesMesh.finishBuilding(true);
 }
 
 void ShootTheChickenGame::createGrassEntity() {
@@ -404,10 +412,19 @@ void ShootTheChickenGame::createPlayerEntity() {
     shootBulletAction = Input::KeyCommand([&] { shootBulletActionFunc(); });
     jumpAction = Input::KeyCommand([&] { jumpActionFunc(); });
     getCamera().setForce(100.f);
-    getCamera().getEntity().addComponent<ECS::CollisionComponent>().addComponent<ECS::RenderComponent>();
-
-
-    getCamera().getEntity().getComponent<ECS::RenderComponent>().copyMesh(playerMesh);
+    getCamera().getEntity().addComponent<ECS::CollisionComponent>();
+
+    // The gun is attached to the camera, so it follows it without being part of its mesh
+    ECS::Entity gun = createEntity("player_gun");
+    gun.addComponent<ECS::TransformComponent>();
+    gun.addComponent<ECS::RenderComponent>();
+    gun.addComponent<ECS::HierarchyComponent>();
+    gun.getComponent<ECS::RenderComponent>().copyMesh(playerMesh);
+    ECS::HierarchyComponent& gunHierarchy = gun.getComponent<ECS::HierarchyComponent>();
+    gunHierarchy.parent = getCamera().getEntity().getID();
+    // Rotate the gun to the left and lift it to the player's hands
+    gunHierarchy.localTransform.setRotation({25, 25, 0});
+    gunHierarchy.localTransform.setPosition({1.3, -1.5, -3});
     getCamera().getEntity().getComponent<ECS::PhysicsComponent>().physics.setAirFriction(0.01f);
     getCamera().getEntity().getComponent<ECS::PhysicsComponent>().physics.setAffectedByGravity(true);
     getCamera().getEntity().getComponent<ECS::CollisionComponent>().collider.setSolid(true);
@@ -454,12 +471,32 @@ void ShootTheChickenGame::init() {
         SoundPlayer::loadSound("chicken_shot.mp3", "chicken_shot");
         SoundPlayer::loadSound("shoot.mp3", "shoot");
         SoundPlayer::loadSound("chicken_idle.mp3", "chicken_idle");
-        createChickenMesh();
+        // The meshes are built once and then loaded from the cache. The grass and the bushes are random, but with a
+        // fixed seed, so they always get the same layout. Increase the version of a mesh when its creation changes.
+        MeshCache& meshCache = MeshCache::get();
+        chickenMesh = meshCache.getOrCreate(MeshCache::hashString("shoot-the-chicken/chicken-v1"), [this] {
+            createChickenMesh();
+            return std::move(chickenMesh);
+        });
         createBulletMesh();
-        createPlayerMesh();
-        createTreeMesh();
-        createGrassMesh();
-        createBushesMeshes();
+        playerMesh = meshCache.getOrCreate(MeshCache::hashString("shoot-the-chicken/player-v2"), [this] {
+            createPlayerMesh();
+            return std::move(playerMesh);
+        });
+        treeMesh = meshCache.getOrCreate(MeshCache::hashString("shoot-the-chicken/tree-v1"), [this] {
+            createTreeMesh();
+            return std::move(treeMesh);
+        });
+        // The trees never move, they're merged into the static batches
+        treeMesh.setRenderType(Render::RenderType::BatchedStatic);
+        allGrassMesh = meshCache.getOrCreate(MeshCache::hashString("shoot-the-chicken/grass-v2"), [this] {
+            createGrassMesh();
+            return std::move(allGrassMesh);
+        });
+        allBushesMesh = meshCache.getOrCreate(MeshCache::hashString("shoot-the-chicken/bushes-v2"), [this] {
+            createBushesMeshes();
+            return std::move(allBushesMesh);
+        });
         hasAlreadyInitialized = true;
     }
 
@@ -491,7 +528,6 @@ void ShootTheChickenGame::update() {
 
     // Every 1 seconds, give upword force to all chickens
     for (unsigned short chickenID : chickens) {
-        Render::ColorMesh& chickenMesh = getEntity(chickenID).getComponent<ECS::RenderComponent>().getMesh();
         ECS::Entity chicken = getEntity(chickenID);
 
         // Jump every random seconds between 1 and 10
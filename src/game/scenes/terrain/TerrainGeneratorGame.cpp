@@ -3,23 +3,51 @@
 
 #include "engine/ecs/frontend/component/FogComponent.h"
 #include "engine/ecs/frontend/component/SunComponent.h"
+#include "engine/res-mng/models/MeshCache.h"
 
-void TerrainGeneratorGame::generateEntitiesForMap(GLESC::ECS::EntityFactory& entityFactory) {
-    TerrainGenerator terrainGenerator;
-    auto map = terrainGenerator.generateMap();
+namespace {
+    /**
+     * @brief Key of the mesh of a chunk in the mesh cache, it changes with the parameters of the generator.
+     * The version must be increased if the generation or the meshing of the terrain changes.
+     */
+    GLESC::MeshCache::Key getChunkCacheKey(const Vec2I& chunkPosition) {
+        return GLESC::MeshCache::hashString("terrain/chunk-v1 " + chunkPosition.toString() +
+            " size " + std::to_string(CHUNK_SIZE) + " height " + std::to_string(CHUNK_HEIGHT) +
+            " chunks " + std::to_string(MAP_SIZE_IN_CHUNKS));
+    }
+}
 
+void TerrainGeneratorGame::generateEntitiesForMap(GLESC::ECS::EntityFactory& entityFactory) {
     std::vector<Vec2I> keys;
-    keys.reserve(map.size());
-    for (const auto& item : map) {
-        keys.push_back(item.first);
-        createEntity("chunk", {GLESC::EntityType::Instance});
+    keys.reserve(MAP_SIZE_IN_CHUNKS * MAP_SIZE_IN_CHUNKS);
+    for (int x = 0; x < MAP_SIZE_IN_CHUNKS; x++) {
+        for (int z = 0; z < MAP_SIZE_IN_CHUNKS; z++) {
+            keys.emplace_back(x, z);
+            createEntity("chunk", {GLESC::EntityType::Instance});
+        }
+    }
+
+    std::vector<std::optional<GLESC::Render::ColorMesh>> chunkMeshes(keys.size());
+    bool allChunksCached = true;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        chunkMeshes[i] = GLESC::MeshCache::get().load(getChunkCacheKey(keys[i]));
+        allChunksCached = allChunksCached && chunkMeshes[i].has_value();
+    }
+    // The faces of a chunk depend on the chunks around it, so the whole map is generated if any chunk is missing
+    Map map;
+    if (!allChunksCached) {
+        TerrainGenerator terrainGenerator;
+        map = terrainGenerator.generateMap();
     }
 
-#pragma omp parallel for schedule(static, 1) default(none) shared(keys, map, std::cout)
+#pragma omp parallel for schedule(static, 1) default(none) shared(keys, map, chunkMeshes, std::cout)
     for (int i = 0; i < keys.size(); ++i) {
         auto& chunkPosition = keys[i];
-        auto& chunk = map[chunkPosition];
-        GLESC::Render::ColorMesh chunkMesh = MeshTerrain::generateChunkMeshFromMap(chunk, chunkPosition, map);
+        if (!chunkMeshes[i].has_value()) {
+            auto& chunk = map[chunkPosition];
+            chunkMeshes[i] = MeshTerrain::generateChunkMeshFromMap(chunk, chunkPosition, map);
+            GLESC::MeshCache::get().store(getChunkCacheKey(chunkPosition), *chunkMeshes[i]);
+        }
         GLESC::ECS::EntityID entityID = getSceneEntities().at(i);
         GLESC::ECS::Entity entity = getEntity(entityID);
         entity.addComponent<GLESC::ECS::TransformComponent>()
@@ -27,7 +55,9 @@ void TerrainGeneratorGame::generateEntitiesForMap(GLESC::ECS::EntityFactory& ent
         entity.getComponent<GLESC::ECS::TransformComponent>().transform.setPosition({
             chunkPosition.getX() * CHUNK_SIZE, 0, chunkPosition.getY() * CHUNK_SIZE
         });
-        entity.getComponent<GLESC::ECS::RenderComponent>().moveMesh(chunkMesh);
+        // The chunks never move, they're merged into the static batches
+        chunkMeshes[i]->setRenderType(GLESC::Render::RenderType::BatchedStatic);
+        entity.getComponent<GLESC::ECS::RenderComponent>().moveMesh(*chunkMeshes[i]);
 
 
         std::cout << "Created entity for chunk at position " << chunkPosition.toString() << std::endl;
@@ -21,8 +21,17 @@
 #define MATH_GEOMETRY_UNIT_TESTING true
 #define MATH_RANDOM_GENERATION_UNIT_TESTING true
 #define WINDOW_TESTING true
+#define RENDERING_UNIT_TESTING true
+#define TRANSFORM_UNIT_TESTING true
 
 #define ECS_BACKEND_INTEGRATION_TESTING true
 #define ECS_FRONTEND_INTEGRATION_TESTING true
 
-#define RENDERING_INTEGRATION_TESTING true
\ No newline at end of file
+#define RENDERING_INTEGRATION_TESTING true
+
+/**
+ * @brief This flag enables the benchmarks that are executed as tests
+ * @details They print their timings to the standard output, they don't fail on slow results.
+ */
+#define RENDERING_BENCHMARKING false
+#define MATH_BENCHMARKING false
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**************************************************************************************************
+ * @file   ConstexprMathTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Tests of the math that can be evaluated at compile time.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#ifdef MATH_ALGEBRA_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <cmath>
+#include "engine/core/math/algebra/matrix/Matrix.h"
+#include "unit/engine/core/math/MathCustomTestingFramework.h"
+
+using namespace GLESC::Math;
+
+// Evaluated by the compiler, the test fails to compile if any of them isn't constexpr
+constexpr float compileTimeSin = GLESC::Math::sin(0.5f);
+constexpr double compileTimeCos = GLESC::Math::cos(2.5);
+constexpr double compileTimeTan = GLESC::Math::tan(-1.0);
+constexpr double compileTimeSqrt = constexprSqrt(2.0);
+constexpr Matrix<float, 4, 4> compileTimeProjection =
+    Matrix<float, 4, 4>().makeProjectionMatrix(60.0f, 0.1f, 100.0f, 1920.0f, 1080.0f);
+constexpr Matrix<double, 4, 4> compileTimeTranslation =
+    Matrix<double, 4, 4>().makeTranslationMatrix(Vector<double, 3>(1.0, 2.0, 3.0));
+
+namespace {
+    /**
+     * @brief Epsilon comparison usable in static_assert, std::abs isn't constexpr in every compiler.
+     */
+    constexpr bool isNear(double value, double expected, double epsilon = 1e-9) {
+        return value - expected < epsilon && expected - value < epsilon;
+    }
+} // namespace
+
+static_assert(isNear(compileTimeTranslation[3][1], 2.0), "The translation is in the last column");
+static_assert(isNear(compileTimeProjection[2][3], -1.0), "The projection copies -z to w");
+
+TEST(ConstexprMathTests, TrigonometryMatchesTheStandardLibrary) {
+    EXPECT_FLOAT_EQ(compileTimeSin, std::sin(0.5f));
+    EXPECT_DOUBLE_EQ(compileTimeCos, std::cos(2.5));
+    EXPECT_DOUBLE_EQ(compileTimeTan, std::tan(-1.0));
+    EXPECT_DOUBLE_EQ(compileTimeSqrt, std::sqrt(2.0));
+
+    // All the quadrants and several turns, the reduction of the angle must not lose precision
+    for (double angle = -40.0; angle < 40.0; angle += 0.01) {
+        EXPECT_NEAR(constexprSin(angle), std::sin(angle), 1e-14) << "Angle: " << angle;
+        EXPECT_NEAR(constexprCos(angle), std::cos(angle), 1e-14) << "Angle: " << angle;
+        EXPECT_NEAR(constexprSin(static_cast<float>(angle)), std::sin(static_cast<float>(angle)), 1e-6f);
+    }
+    EXPECT_DOUBLE_EQ(constexprSin(pi<double>() / 2), 1.0);
+    EXPECT_DOUBLE_EQ(constexprCos(0.0), 1.0);
+}
+
+TEST(ConstexprMathTests, SquareRootOfSpecialValues) {
+    EXPECT_EQ(constexprSqrt(0.0), 0.0);
+    EXPECT_EQ(constexprSqrt(1.0f), 1.0f);
+    EXPECT_TRUE(std::isnan(constexprSqrt(-1.0)));
+    EXPECT_TRUE(std::isinf(constexprSqrt(std::numeric_limits<double>::infinity())));
+    for (double value : {1e-300, 1e-10, 0.25, 3.0, 1e10, 1e300}) {
+        EXPECT_NEAR(constexprSqrt(value), std::sqrt(value), std::sqrt(value) * 1e-15) << "Value: " << value;
+    }
+}
+
+TEST(ConstexprMathTests, CompileTimeMatricesMatchTheRuntimeOnes) {
+    Matrix<float, 4, 4> runtimeProjection;
+    runtimeProjection.makeProjectionMatrix(60.0f, 0.1f, 100.0f, 1920.0f, 1080.0f);
+    EXPECT_EQ_MAT_EPSILON(compileTimeProjection.data, runtimeProjection.data, 1e-6f);
+
+    Matrix<double, 4, 4> runtimeTranslation;
+    runtimeTranslation.makeTranslationMatrix(Vector<double, 3>(1.0, 2.0, 3.0));
+    EXPECT_EQ_MAT(compileTimeTranslation.data, runtimeTranslation.data);
+}
+#endif
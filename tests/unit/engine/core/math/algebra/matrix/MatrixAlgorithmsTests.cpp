@@ -13,7 +13,11 @@
 #ifdef MATH_ALGEBRA_UNIT_TESTING
 #include <gtest/gtest.h>
 #include <type_traits>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <random>
+#include <vector>
 #include <glm/vec3.hpp>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glm/ext/matrix_transform.hpp>
@@ -719,33 +723,205 @@ TEST(MatrixAlgorithmsTests, InverseAlgorithmExactSolution) {
     TEST_SECTION("Testing Inverse of a 5x5 matrix")
     {
         // Test Inverse of a 5x5 matrix
-        //GLESC::Math::MatrixData<double, 5, 5> matrix5x5({
-        //    {
-        //        {-1, 2, 3, 4, 5},
-        //        {6, 7, 8, -9, 0},
-        //        {11, -21, 31, -41, 51},
-        //        {-61, 71, 81, 91, 10},
-        //        {11.1, 32.1, -53.1, 64.1, -75.1}
-        //    }
-        //});
-
-
-        // @TODO: Implement inverse for any matrix size
-        //GLESC::Math::MatrixData<double, 5, 5> expectedInverse5x5(
-        //    {
-        //        {
-        //            {-0.0935895, -0.0085282, 0.0719947, 0.00517271, 0.043349},
-        //            {0.351945, 0.119422, -0.0858807, -0.0162524, -0.0370535},
-        //            {-0.326954, -0.0438212, 0.0777137, 0.02122, 0.0338326},
-        //            {-0.0792838, -0.0628653, 0.0502792, 0.00966992, 0.0301534},
-        //            {0.300103, 0.0271107, -0.0381003, -0.0129324, -0.020931}
-        //        }
-        //    });
-        //GLESC::Math::MatrixData<double, 5, 5> actualInverse5x5;
-        //GLESC::Math::MatrixAlgorithms::matrixInverse(matrix5x5, actualInverse5x5);
-        //EXPECT_EQ_MAT(actualInverse5x5, expectedInverse5x5);
+        GLESC::Math::MatrixData<double, 5, 5> matrix5x5({
+            {
+                {-1, 2, 3, 4, 5},
+                {6, 7, 8, -9, 0},
+                {11, -21, 31, -41, 51},
+                {-61, 71, 81, 91, 10},
+                {11.1, 32.1, -53.1, 64.1, -75.1}
+            }
+        });
+        GLESC::Math::MatrixData<double, 5, 5> expectedInverse5x5(
+            {
+                {
+                    {-0.0935895, -0.0085282, 0.0719947, 0.00517271, 0.043349},
+                    {0.351945, 0.119422, -0.0858807, -0.0162524, -0.0370535},
+                    {-0.326954, -0.0438212, 0.0777137, 0.02122, 0.0338326},
+                    {-0.0792838, -0.0628653, 0.0502792, 0.00966992, 0.0301534},
+                    {0.300103, 0.0271107, -0.0381003, -0.0129324, -0.020931}
+                }
+            });
+        GLESC::Math::MatrixData<double, 5, 5> actualInverse5x5;
+        GLESC::Math::MatrixAlgorithms::matrixInverse(matrix5x5, actualInverse5x5);
+        EXPECT_EQ_MAT(actualInverse5x5, expectedInverse5x5);
+    }
+}
+
+TEST(MatrixAlgorithmsTests, LUDecompositionAlgorithm) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+    GLESC::Math::MatrixData<double, 6, 6> matrix6x6;
+    for (auto& column : matrix6x6)
+        for (auto& value : column)
+            value = distribution(random);
+
+    GLESC::Math::MatrixData<double, 6, 6> inverse6x6;
+    GLESC::Math::MatrixAlgorithms::matrixInverse(matrix6x6, inverse6x6);
+    GLESC::Math::MatrixData<double, 6, 6> product;
+    GLESC::Math::MatrixAlgorithms::matrixMatrixMulNaiveColMaj(matrix6x6, inverse6x6, product);
+    GLESC::Math::MatrixData<double, 6, 6> identity{};
+    GLESC::Math::MatrixAlgorithms::setMatrixDiagonal(identity, 1.0);
+    EXPECT_EQ_MAT_EPSILON(product, identity, 1e-9);
+
+    const double laplaceDeterminant = GLESC::Math::MatrixAlgorithms::laplaceExpansionDeterminant(matrix6x6);
+    EXPECT_NEAR(GLESC::Math::MatrixAlgorithms::luDeterminant(matrix6x6), laplaceDeterminant,
+                std::abs(laplaceDeterminant) * 1e-9);
+    EXPECT_TRUE(GLESC::Math::MatrixAlgorithms::isInvertible(matrix6x6));
+
+    // The last row is a combination of the first two
+    for (size_t column = 0; column < 6; ++column)
+        matrix6x6[5][column] = matrix6x6[0][column] - 2 * matrix6x6[1][column];
+    EXPECT_FALSE(GLESC::Math::MatrixAlgorithms::isInvertible(matrix6x6));
+}
+
+TEST(MatrixAlgorithmsTests, AffineAndRigidInverseAlgorithms) {
+    GLESC::Math::VectorData<float, 3> position({1, -2, 3});
+    GLESC::Math::VectorData<float, 3> rotationRads({0.3f, -1.2f, 2.5f});
+    GLESC::Math::VectorData<float, 3> scale({2, 0.5f, 3});
+    GLESC::Math::VectorData<float, 3> noScale({1, 1, 1});
+    GLESC::Math::MatrixData<float, 4, 4> expectedInverse;
+
+    GLESC::Math::MatrixData<float, 4, 4> affine;
+    GLESC::Math::MatrixMixedAlgorithms::calculateModelMatrix(position, rotationRads, scale, affine);
+    GLESC::Math::MatrixData<float, 4, 4> affineInverse;
+    GLESC::Math::MatrixAlgorithms::affineInverse(affine, affineInverse);
+    GLESC::Math::MatrixAlgorithms::inverse4x4(affine, expectedInverse);
+    EXPECT_EQ_MAT_EPSILON(affineInverse, expectedInverse, 1e-5f);
+
+    GLESC::Math::MatrixData<float, 4, 4> rigid;
+    GLESC::Math::MatrixMixedAlgorithms::calculateModelMatrix(position, rotationRads, noScale, rigid);
+    GLESC::Math::MatrixData<float, 4, 4> rigidInverse;
+    GLESC::Math::MatrixAlgorithms::rigidInverse(rigid, rigidInverse);
+    GLESC::Math::MatrixAlgorithms::inverse4x4(rigid, expectedInverse);
+    EXPECT_EQ_MAT_EPSILON(rigidInverse, expectedInverse, 1e-5f);
+
+    EXPECT_TRUE(GLESC::Math::MatrixAlgorithms::isAffine(affine));
+    GLESC::Math::MatrixData<float, 4, 4> projection;
+    GLESC::Math::MatrixAlgorithms::perspective(1.0f, 0.1f, 100.0f, 800.0f, 600.0f, projection);
+    EXPECT_FALSE(GLESC::Math::MatrixAlgorithms::isAffine(projection));
+}
+
+TEST(MatrixAlgorithmsTests, NormalMatrixOfUniformScale) {
+    GLESC::Math::VectorData<float, 3> position({1, 2, 3});
+    GLESC::Math::VectorData<float, 3> rotationRads({0.7f, 0.1f, -2.0f});
+    GLESC::Math::VectorData<float, 3> uniformScale({2.5f, 2.5f, 2.5f});
+    GLESC::Math::VectorData<float, 3> nonUniformScale({1, 2, 3});
+    GLESC::Math::MatrixData<float, 4, 4> model;
+    GLESC::Math::MatrixMixedAlgorithms::calculateModelMatrix(position, rotationRads, uniformScale, model);
+    EXPECT_TRUE(GLESC::Math::MatrixAlgorithms::hasUniformScale(model));
+
+    GLESC::Math::MatrixData<float, 3, 3> normalMatrix;
+    GLESC::Math::MatrixAlgorithms::calculateNormalMatrixUniformScale(model, normalMatrix);
+    GLESC::Math::MatrixData<float, 3, 3> expectedNormalMatrix;
+    GLESC::Math::MatrixAlgorithms::calculateNormalMatrix(model, expectedNormalMatrix);
+    EXPECT_EQ_MAT_EPSILON(normalMatrix, expectedNormalMatrix, 1e-5f);
+
+    GLESC::Math::MatrixMixedAlgorithms::calculateModelMatrix(position, rotationRads, nonUniformScale, model);
+    EXPECT_FALSE(GLESC::Math::MatrixAlgorithms::hasUniformScale(model));
+}
+
+#if MATH_BENCHMARKING
+namespace {
+    /**
+     * @brief Measures the average time of an operation over the objects of an array, like the renderer does.
+     * @details The results are added so they aren't optimized away.
+     */
+    template <typename Operation>
+    void measureMatrixOperation(const char* name, Operation&& operation) {
+        constexpr int iterations = 1000000;
+        float checksum = 0;
+        checksum += operation(0); // Warm up
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            checksum += operation(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double nanos = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::cout << name << ": " << nanos << " ns (checksum " << checksum << ")\n";
+    }
+}
+
+TEST(MatrixAlgorithmsTests, BenchmarkInverses) {
+    constexpr size_t count = 1024;
+    std::vector<GLESC::Math::MatrixData<float, 4, 4>> matrices(count);
+    std::vector<GLESC::Math::MatrixData<float, 4, 4>> inverses(count);
+    std::vector<GLESC::Math::MatrixData<float, 3, 3>> normalMatrices(count);
+    std::vector<GLESC::Math::VectorData<float, 3>> positions(count);
+    std::vector<GLESC::Math::VectorData<float, 3>> rotations(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto value = static_cast<float>(i);
+        positions[i] = {value, -value, 2 * value};
+        rotations[i] = {value * 0.01f, value * 0.02f, value * -0.03f};
+        GLESC::Math::VectorData<float, 3> scale({1, 1, 1});
+        GLESC::Math::MatrixMixedAlgorithms::calculateModelMatrix(positions[i], rotations[i], scale, matrices[i]);
+    }
+
+    measureMatrixOperation("inverse4x4", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixAlgorithms::inverse4x4(matrices[index], inverses[index]);
+        return inverses[index][3][0];
+    });
+    measureMatrixOperation("affineInverse", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixAlgorithms::affineInverse(matrices[index], inverses[index]);
+        return inverses[index][3][0];
+    });
+    measureMatrixOperation("rigidInverse", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixAlgorithms::rigidInverse(matrices[index], inverses[index]);
+        return inverses[index][3][0];
+    });
+    measureMatrixOperation("normal matrix from inverse4x4", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixAlgorithms::inverse4x4(matrices[index], inverses[index]);
+        GLESC::Math::MatrixData<float, 4, 4> transposed;
+        GLESC::Math::MatrixAlgorithms::transpose(inverses[index], transposed);
+        GLESC::Math::MatrixAlgorithms::resizeMatrix(transposed, normalMatrices[index]);
+        return normalMatrices[index][0][0];
+    });
+    measureMatrixOperation("calculateNormalMatrix", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixAlgorithms::calculateNormalMatrix(matrices[index], normalMatrices[index]);
+        return normalMatrices[index][0][0];
+    });
+    measureMatrixOperation("calculateNormalMatrixUniformScale", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixAlgorithms::calculateNormalMatrixUniformScale(matrices[index], normalMatrices[index]);
+        return normalMatrices[index][0][0];
+    });
+    measureMatrixOperation("calculateViewMatrixPosRot", [&](int i) {
+        const size_t index = i % count;
+        GLESC::Math::MatrixMixedAlgorithms::calculateViewMatrixPosRot(positions[index], rotations[index],
+                                                                      inverses[index]);
+        return inverses[index][3][0];
+    });
+}
+
+TEST(MatrixAlgorithmsTests, BenchmarkDeterminantOfBigMatrices) {
+    GLESC::Math::MatrixData<double, 8, 8> matrix;
+    std::mt19937 random(3);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    for (auto& column : matrix)
+        for (auto& value : column)
+            value = distribution(random);
+    // The Laplace expansion of a 8x8 matrix is much slower, it's measured fewer times
+    auto start = std::chrono::steady_clock::now();
+    double laplaceDeterminant = 0;
+    for (int i = 0; i < 10; i++) {
+        matrix[0][0] = static_cast<double>(i);
+        laplaceDeterminant += GLESC::Math::MatrixAlgorithms::laplaceExpansionDeterminant(matrix);
     }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "laplaceExpansionDeterminant 8x8: "
+        << std::chrono::duration<double, std::nano>(end - start).count() / 10 << " ns (checksum "
+        << laplaceDeterminant << ")\n";
+    measureMatrixOperation("luDeterminant 8x8", [&](int i) {
+        matrix[0][0] = static_cast<double>(i % 10);
+        return static_cast<float>(GLESC::Math::MatrixAlgorithms::luDeterminant(matrix));
+    });
 }
+#endif
 
 TEST(MatrixAlgorithmsTests, TranslateAlgorithm) {
     GLESC::Math::VectorData<float, 3> translateVec2D({2.0f, 3.0f, 1.0f});
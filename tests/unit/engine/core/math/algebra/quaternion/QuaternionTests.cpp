@@ -0,0 +1,125 @@
+/**************************************************************************************************
+ * @file   QuaternionTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-23
+ * @brief  Tests of the quaternions, their conversions and their interpolation.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if MATH_ALGEBRA_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <random>
+#include "engine/core/math/algebra/matrix/Matrix.h"
+#include "engine/core/math/algebra/quaternion/Quaternion.h"
+
+using namespace GLESC::Math;
+
+namespace {
+    void expectNear(const Mat4F& actual, const Mat4F& expected) {
+        for (size_t column = 0; column < 4; column++) {
+            for (size_t row = 0; row < 4; row++) {
+                EXPECT_NEAR(actual[column][row], expected[column][row], 1e-5f) << "[" << column << "][" << row << "]";
+            }
+        }
+    }
+
+    void expectNear(const Vec3F& actual, const Vec3F& expected) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            EXPECT_NEAR(actual.get(axis), expected.get(axis), 1e-5f) << "Axis " << axis;
+        }
+    }
+
+    /**
+     * @brief The angle of the rotation from a to b, in radians.
+     */
+    float angleBetween(const QuatF& a, const QuatF& b) {
+        return 2.0f * std::acos(std::min(std::abs(a.dot(b)), 1.0f));
+    }
+}
+
+TEST(QuaternionTests, EulerQuaternionGivesTheEulerRotationMatrix) {
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> angle(-pi<float>(), pi<float>());
+    for (int i = 0; i < 100; i++) {
+        const Vec3F rads(angle(random), angle(random), angle(random));
+        Mat4F expected;
+        expected.makeRotationMatrix(rads);
+        Mat4F actual;
+        actual.makeRotationMatrix(QuatF::fromEuler(rads));
+        expectNear(actual, expected);
+    }
+}
+
+TEST(QuaternionTests, ModelMatrixMatchesTheOneOfTheEulerAngles) {
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> angle(-pi<float>(), pi<float>());
+    std::uniform_real_distribution<float> value(0.1f, 10.0f);
+    for (int i = 0; i < 100; i++) {
+        const Vec3F position(value(random), -value(random), value(random));
+        const Vec3F rads(angle(random), angle(random), angle(random));
+        const Vec3F scale(value(random), value(random), value(random));
+        Mat4F expected;
+        expected.makeModelMatrix(position, rads, scale);
+        Mat4F actual;
+        actual.makeModelMatrix(position, QuatF::fromEuler(rads), scale);
+        for (size_t column = 0; column < 4; column++) {
+            for (size_t row = 0; row < 4; row++) {
+                EXPECT_NEAR(actual[column][row], expected[column][row], 1e-4f);
+            }
+        }
+    }
+}
+
+TEST(QuaternionTests, EulerAnglesAreRecovered) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    // The angle around Y is the one limited to [-pi/2, pi/2]
+    std::uniform_real_distribution<float> angleY(-1.5f, 1.5f);
+    for (int i = 0; i < 100; i++) {
+        const Vec3F rads(angle(random), angleY(random), angle(random));
+        const Vec3F recovered = QuatF::fromEuler(rads).toEuler();
+        for (size_t axis = 0; axis < 3; axis++) {
+            EXPECT_NEAR(recovered.get(axis), rads.get(axis), 1e-3f);
+        }
+    }
+}
+
+TEST(QuaternionTests, RotatesVectorsAndComposes) {
+    const QuatF yaw = QuatF::fromAxisAngle(Vec3F(0, 1, 0), pi<float>() / 2);
+    const QuatF pitch = QuatF::fromAxisAngle(Vec3F(2, 0, 0), pi<float>() / 2);
+    expectNear(yaw.rotate(Vec3F(1, 0, 0)), Vec3F(0, 0, -1));
+    expectNear(pitch.rotate(Vec3F(0, 1, 0)), Vec3F(0, 0, 1));
+    // The product applies the right rotation first
+    expectNear((pitch * yaw).rotate(Vec3F(1, 0, 0)), pitch.rotate(yaw.rotate(Vec3F(1, 0, 0))));
+    expectNear((yaw.conjugate() * yaw).rotate(Vec3F(1, 2, 3)), Vec3F(1, 2, 3));
+
+    Mat4F matrix;
+    matrix.makeRotationMatrix(pitch * yaw);
+    expectNear((matrix * Vec4F(1, 2, 3, 1)).dehomogenize(), (pitch * yaw).rotate(Vec3F(1, 2, 3)));
+}
+
+TEST(QuaternionTests, InterpolationTakesTheShortestArc) {
+    const Vec3F up(0, 1, 0);
+    const QuatF start;
+    // 270 degrees one way is 90 degrees the other way
+    const QuatF end = QuatF::fromAxisAngle(up, pi<float>() * 1.5f);
+    const QuatF expectedHalf = QuatF::fromAxisAngle(up, -pi<float>() / 4);
+    const QuatF expectedQuarter = QuatF::fromAxisAngle(up, -pi<float>() / 8);
+
+    EXPECT_NEAR(angleBetween(start.slerp(end, 0.5f), expectedHalf), 0.0f, 2e-3f);
+    EXPECT_NEAR(angleBetween(start.slerp(end, 0.25f), expectedQuarter), 0.0f, 2e-3f);
+    EXPECT_NEAR(angleBetween(start.nlerp(end, 0.5f), expectedHalf), 0.0f, 2e-3f);
+    // nlerp isn't at a constant speed, but it's close for a quarter turn
+    EXPECT_NEAR(angleBetween(start.nlerp(end, 0.25f), expectedQuarter), 0.0f, 0.05f);
+
+    EXPECT_NEAR(angleBetween(start.slerp(end, 0.0f), start), 0.0f, 2e-3f);
+    EXPECT_NEAR(angleBetween(start.slerp(end, 1.0f), end), 0.0f, 2e-3f);
+    EXPECT_NEAR(start.slerp(end, 0.3f).length(), 1.0f, 1e-5f);
+    // Almost equal rotations are interpolated too
+    const QuatF close = QuatF::fromAxisAngle(up, 1e-4f);
+    EXPECT_NEAR(start.slerp(close, 0.5f).length(), 1.0f, 1e-5f);
+}
+#endif
@@ -0,0 +1,87 @@
+/**************************************************************************************************
+ * @file   SimdAlgorithmsTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-26
+ * @brief  Tests of the SIMD paths of the vectors of 4 floats and the 4x4 float matrices.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#ifdef MATH_ALGEBRA_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <random>
+#include "engine/core/math/algebra/matrix/Matrix.h"
+#include "unit/engine/core/math/MathCustomTestingFramework.h"
+
+using namespace GLESC::Math;
+using Float3 = Vector<float, 3>;
+using Float4 = Vector<float, 4>;
+using Float4x4 = Matrix<float, 4, 4>;
+
+namespace {
+    /**
+     * @brief Values that aren't exact in binary, so the order of the operations shows in the last bits.
+     */
+    template <size_t N, size_t M>
+    Matrix<float, N, M> randomMatrix(std::mt19937& random) {
+        std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+        Matrix<float, N, M> matrix;
+        for (size_t column = 0; column < N; ++column) {
+            for (size_t row = 0; row < M; ++row) {
+                matrix[column][row] = distribution(random);
+            }
+        }
+        return matrix;
+    }
+}
+
+TEST(SimdAlgorithmsTests, MatrixProductsMatchTheScalarAlgorithms) {
+    std::mt19937 random(42);
+    for (int i = 0; i < 100; ++i) {
+        const Float4x4 left = randomMatrix<4, 4>(random);
+        const Float4x4 right = randomMatrix<4, 4>(random);
+        Float4x4 expected;
+        MatrixAlgorithms::matrixMatrixMulColMaj(left.data, right.data, expected.data);
+        EXPECT_EQ_MAT_EPSILON((left * right).data, expected.data, 1e-3f);
+
+        // In place, the result is one of the operands
+        Float4x4 inPlace = left;
+        inPlace *= right;
+        EXPECT_EQ_MAT_EPSILON(inPlace.data, expected.data, 1e-3f);
+
+        const Float4 vector(right[0][0], right[1][1], right[2][2], right[3][3]);
+        Float4 expectedVector;
+        for (size_t row = 0; row < 4; ++row) {
+            for (size_t column = 0; column < 4; ++column) {
+                expectedVector[row] += left[column][row] * vector[column];
+            }
+        }
+        const Float4 actualVector = left * vector;
+        for (size_t row = 0; row < 4; ++row) {
+            EXPECT_NEAR(actualVector[row], expectedVector[row], 1e-3f);
+        }
+    }
+}
+
+TEST(SimdAlgorithmsTests, VectorOperationsMatchTheScalarAlgorithms) {
+    const Float4 a(1.5f, -2.25f, 3.0f, 0.1f);
+    const Float4 b(-0.5f, 4.0f, 2.0f, 10.0f);
+    EXPECT_EQ_VEC(a + b, Float4(1.0f, 1.75f, 5.0f, 10.1f));
+    EXPECT_EQ_VEC(a - b, Float4(2.0f, -6.25f, 1.0f, -9.9f));
+    EXPECT_EQ_VEC(a * b, Float4(-0.75f, -9.0f, 6.0f, 1.0f));
+    EXPECT_EQ_VEC(a / b, Float4(-3.0f, -0.5625f, 1.5f, 0.01f));
+    EXPECT_EQ_VEC(a * 2.0f, Float4(3.0f, -4.5f, 6.0f, 0.2f));
+    EXPECT_NEAR(a.dot(b), -0.75f - 9.0f + 6.0f + 1.0f, 1e-5f);
+}
+
+TEST(SimdAlgorithmsTests, LayoutOfTheTypes) {
+    // The size never changes, only the alignment, so the data can still be uploaded as an array of floats
+    EXPECT_EQ(sizeof(Float4), sizeof(float) * 4);
+    EXPECT_EQ(sizeof(Float3), sizeof(float) * 3);
+    EXPECT_EQ(sizeof(Float4x4), sizeof(float) * 16);
+    EXPECT_EQ(alignof(Float4), (vectorAlignment<float, 4>));
+    EXPECT_EQ(alignof(Float4x4), (matrixAlignment<float, 4, 4>));
+}
+#endif
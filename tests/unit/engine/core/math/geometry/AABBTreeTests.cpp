@@ -0,0 +1,146 @@
+/**************************************************************************************************
+ * @file   AABBTreeTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-06
+ * @brief  Tests of the dynamic bounding volume hierarchy.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if MATH_GEOMETRY_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "engine/core/math/geometry/AABBTree.h"
+
+using namespace GLESC::Math;
+using AABB = AABBTree::AABB;
+
+namespace {
+    AABB makeBox(float x, float y, float z, float halfSize) {
+        return {Vec3F(x - halfSize, y - halfSize, z - halfSize), Vec3F(x + halfSize, y + halfSize, z + halfSize)};
+    }
+
+    bool overlaps(const AABB& first, const AABB& second) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (first.max.get(axis) < second.min.get(axis) || first.min.get(axis) > second.max.get(axis))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Classifies the boxes against a query box, like a frustum would do.
+     */
+    Containment classifyAgainst(const AABB& queryBox, const AABB& aabb) {
+        if (!overlaps(queryBox, aabb)) return Containment::Outside;
+        if (queryBox.encloses(aabb)) return Containment::Inside;
+        return Containment::Intersecting;
+    }
+
+    std::vector<size_t> queryBox(const AABBTree& tree, const AABB& box, AABBTree::QueryStats* stats = nullptr) {
+        std::vector<size_t> found;
+        AABBTree::QueryStats queryStats = tree.query(
+            [&box](const AABB& aabb, std::uint8_t&) { return classifyAgainst(box, aabb); }, 0,
+            [&found](size_t userData) { found.push_back(userData); });
+        if (stats) *stats = queryStats;
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+}
+
+TEST(AABBTreeTests, EmptyTree) {
+    AABBTree tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.getHeight(), -1);
+    EXPECT_TRUE(tree.isValid());
+    EXPECT_TRUE(queryBox(tree, makeBox(0, 0, 0, 100)).empty());
+}
+
+TEST(AABBTreeTests, ProxiesAreEnlargedByTheMargin) {
+    AABBTree tree(0.5f);
+    AABBTree::ProxyId proxy = tree.createProxy(makeBox(0, 0, 0, 1), 7);
+    EXPECT_EQ(tree.getUserData(proxy), 7u);
+    EXPECT_EQ(tree.getFatAABB(proxy).min, Vec3F(-1.5f, -1.5f, -1.5f));
+    EXPECT_EQ(tree.getFatAABB(proxy).max, Vec3F(1.5f, 1.5f, 1.5f));
+    EXPECT_EQ(tree.getHeight(), 0);
+}
+
+TEST(AABBTreeTests, SmallMovesDontModifyTheTree) {
+    AABBTree tree(0.5f);
+    AABBTree::ProxyId proxy = tree.createProxy(makeBox(0, 0, 0, 1), 0);
+    tree.createProxy(makeBox(10, 0, 0, 1), 1);
+    EXPECT_FALSE(tree.moveProxy(proxy, makeBox(0.25f, 0, 0, 1)));
+    EXPECT_TRUE(tree.moveProxy(proxy, makeBox(5, 0, 0, 1)));
+    EXPECT_EQ(queryBox(tree, makeBox(5, 0, 0, 0.1f)), std::vector<size_t>{0});
+    EXPECT_TRUE(tree.isValid());
+}
+
+TEST(AABBTreeTests, TreeStaysValidAndBalanced) {
+    AABBTree tree;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::vector<AABBTree::ProxyId> proxies;
+    for (size_t i = 0; i < 1000; i++) {
+        proxies.push_back(tree.createProxy(makeBox(position(random), position(random), position(random), 1), i));
+    }
+    ASSERT_TRUE(tree.isValid());
+    EXPECT_EQ(tree.getProxyCount(), 1000u);
+    // A balanced tree of 1000 leaves is around 10 levels high, a degenerate one would be much higher
+    EXPECT_LT(tree.getHeight(), 25);
+
+    for (size_t i = 0; i < proxies.size(); i += 2) {
+        tree.destroyProxy(proxies[i]);
+    }
+    for (size_t i = 1; i < proxies.size(); i += 2) {
+        tree.moveProxy(proxies[i], makeBox(position(random), position(random), position(random), 1));
+    }
+    ASSERT_TRUE(tree.isValid());
+    EXPECT_EQ(tree.getProxyCount(), 500u);
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_TRUE(tree.isValid());
+}
+
+TEST(AABBTreeTests, QueryFindsTheSameProxiesAsBruteForce) {
+    AABBTree tree;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    std::vector<AABB> fatBoxes;
+    for (size_t i = 0; i < 2000; i++) {
+        AABBTree::ProxyId proxy =
+            tree.createProxy(makeBox(position(random), position(random), position(random), size(random)), i);
+        fatBoxes.push_back(tree.getFatAABB(proxy));
+    }
+
+    for (int query = 0; query < 20; query++) {
+        AABB box = makeBox(position(random), position(random), position(random), 30.0f);
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < fatBoxes.size(); i++) {
+            if (overlaps(box, fatBoxes[i])) expected.push_back(i);
+        }
+        AABBTree::QueryStats stats;
+        EXPECT_EQ(queryBox(tree, box, &stats), expected);
+        EXPECT_EQ(stats.visitedLeaves, expected.size());
+        // Whole subtrees must have been rejected, not every node is tested
+        EXPECT_LT(stats.testedNodes, 2 * fatBoxes.size() - 1);
+    }
+}
+
+TEST(AABBTreeTests, InsideSubtreesAreAcceptedWithoutTestingTheirLeaves) {
+    AABBTree tree;
+    for (size_t i = 0; i < 100; i++) {
+        tree.createProxy(makeBox(static_cast<float>(i), 0, 0, 0.1f), i);
+    }
+    AABBTree::QueryStats stats;
+    std::vector<size_t> found = queryBox(tree, makeBox(0, 0, 0, 1000), &stats);
+    EXPECT_EQ(found.size(), 100u);
+    // The root is inside the query box, it's the only node tested
+    EXPECT_EQ(stats.testedNodes, 1u);
+    EXPECT_EQ(stats.acceptedSubtrees, 1u);
+}
+#endif
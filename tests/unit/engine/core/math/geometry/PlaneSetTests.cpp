@@ -0,0 +1,182 @@
+/**************************************************************************************************
+ * @file   PlaneSetTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-27
+ * @brief  Tests of the batch queries of the plane sets, against the queries of one figure at a time.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if MATH_GEOMETRY_UNIT_TESTING
+#include <gtest/gtest.h>
+#include "engine/core/math/geometry/figures/plane/PlaneSet.h"
+#include "engine/core/math/random-generator/RandomGenerator.h"
+
+using namespace GLESC::Math;
+
+namespace {
+    const GeometryKernel allKernels[] = {GeometryKernel::Scalar, GeometryKernel::SSE, GeometryKernel::AVX2};
+
+    /**
+     * @brief The cube from -1 to 1, with faces wound in both directions so the planes must be turned inwards.
+     */
+    Polyhedron createCube() {
+        Points vertices;
+        for (float z : {-1.0f, 1.0f}) {
+            for (float y : {-1.0f, 1.0f}) {
+                for (float x : {-1.0f, 1.0f}) {
+                    vertices.push_back({x, y, z});
+                }
+            }
+        }
+        const QuadIndices quads[] = {{0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3}};
+        std::vector<FaceIndices> faces;
+        for (const QuadIndices& quad : quads) {
+            faces.push_back({quad[0], quad[1], quad[2]});
+            faces.push_back({quad[0], quad[2], quad[3]});
+        }
+        // Constructed in place, Polyhedron can't be copied without warnings
+        return Polyhedron(vertices, faces);
+    }
+
+    /**
+     * @brief Enough points to go through the wide kernels and their remainders.
+     */
+    PointArrays randomPoints(size_t count) {
+        RandomGenerator generator(7);
+        PointArrays points;
+        for (size_t i = 0; i < count; ++i) {
+            points.push_back(Point(generator.uniform(-2.0f, 2.0f), generator.uniform(-2.0f, 2.0f),
+                                   generator.uniform(-2.0f, 2.0f)));
+        }
+        return points;
+    }
+} // namespace
+
+TEST(PlaneSetTests, PolyhedronPlanesFaceInwards) {
+    const Polyhedron cube = createCube();
+    const PlaneSet planes(cube);
+    ASSERT_EQ(planes.size(), cube.getFaces().size());
+    for (size_t i = 0; i < planes.size(); ++i) {
+        EXPECT_GT(planes.getPlane(i).distanceToPoint(Point(0, 0, 0)), 0.0f);
+    }
+    EXPECT_TRUE(cube.hasInside(Point(0.5f, -0.5f, 0.9f)));
+    EXPECT_FALSE(cube.hasInside(Point(1.5f, 0, 0)));
+    EXPECT_FALSE(cube.hasInside(Point(1, 0, 0))) << "Points on a face aren't inside, the same as in Plane";
+}
+
+TEST(PlaneSetTests, PointsInsideMatchOnePointAtATime) {
+    const PlaneSet planes(createCube());
+    const PointArrays points = randomPoints(1003);
+    for (GeometryKernel kernel : allKernels) {
+        if (!PlaneSet::isKernelSupported(kernel)) continue;
+        std::vector<std::uint8_t> inside(points.size(), 2);
+        planes.hasInside(points, inside.data(), kernel);
+        for (size_t i = 0; i < points.size(); ++i) {
+            const Point point(points.x[i], points.y[i], points.z[i]);
+            const bool expected = std::abs(point.getX()) < 1 && std::abs(point.getY()) < 1 &&
+                std::abs(point.getZ()) < 1;
+            ASSERT_EQ(inside[i], expected) << "Kernel " << static_cast<int>(kernel) << ", point " << i;
+            ASSERT_EQ(inside[i], planes.hasInside(point));
+        }
+    }
+}
+
+TEST(PlaneSetTests, DistancesMatchThePlane) {
+    const Plane plane(Direction(1, -2, 3).normalize(), 0.5f);
+    const PlaneSet planes({Plane(), plane});
+    const PointArrays points = randomPoints(37);
+    for (GeometryKernel kernel : allKernels) {
+        if (!PlaneSet::isKernelSupported(kernel)) continue;
+        std::vector<float> distances(points.size());
+        planes.distancesToPoints(1, points, distances.data(), kernel);
+        for (size_t i = 0; i < points.size(); ++i) {
+            EXPECT_FLOAT_EQ(distances[i], plane.distanceToPoint(Point(points.x[i], points.y[i], points.z[i])));
+        }
+    }
+}
+
+TEST(PlaneSetTests, ClipSegments) {
+    const PlaneSet planes(createCube());
+    SegmentArrays segments;
+    // Goes through the cube along x, from outside to outside
+    segments.push_back(Point(-3, 0, 0), Point(3, 0, 0));
+    // Starts inside and leaves through the top
+    segments.push_back(Point(0, 0, 0), Point(0, 2, 0));
+    // Fully inside
+    segments.push_back(Point(-0.5f, 0, 0), Point(0.5f, 0, 0));
+    // Outside, parallel to a face
+    segments.push_back(Point(-3, 2, 0), Point(3, 2, 0));
+    // Outside, crosses the planes of two faces but not the cube, past the corner
+    segments.push_back(Point(1.5f, 3, 0), Point(3, 1.5f, 0));
+    // Stops before reaching the cube
+    segments.push_back(Point(-3, 0, 0), Point(-2, 0, 0));
+
+    const std::uint8_t expectedIntersects[] = {1, 1, 1, 0, 0, 0};
+    for (GeometryKernel kernel : allKernels) {
+        if (!PlaneSet::isKernelSupported(kernel)) continue;
+        // Repeated so the wide kernels see the same segments as the remainders
+        SegmentArrays repeated;
+        for (size_t copy = 0; copy < 3; ++copy) {
+            for (size_t i = 0; i < segments.size(); ++i) {
+                repeated.push_back(Point(segments.startX[i], segments.startY[i], segments.startZ[i]),
+                                   Point(segments.endX[i], segments.endY[i], segments.endZ[i]));
+            }
+        }
+        std::vector<float> enter(repeated.size());
+        std::vector<float> exit(repeated.size());
+        std::vector<std::uint8_t> intersects(repeated.size());
+        planes.clipSegments(repeated, enter.data(), exit.data(), intersects.data(), kernel);
+        for (size_t i = 0; i < repeated.size(); ++i) {
+            const size_t segment = i % segments.size();
+            ASSERT_EQ(intersects[i], expectedIntersects[segment]) << "Kernel " << static_cast<int>(kernel)
+                << ", segment " << segment;
+        }
+        EXPECT_FLOAT_EQ(enter[0], 1.0f / 3.0f);
+        EXPECT_FLOAT_EQ(exit[0], 2.0f / 3.0f);
+        EXPECT_FLOAT_EQ(enter[1], 0.0f);
+        EXPECT_FLOAT_EQ(exit[1], 0.5f);
+        EXPECT_FLOAT_EQ(enter[2], 0.0f);
+        EXPECT_FLOAT_EQ(exit[2], 1.0f);
+    }
+}
+
+TEST(PlaneSetTests, SegmentsAgainstOnePlane) {
+    const PlaneSet planes({Plane(Direction(0, 1, 0), -1.0f)});
+    SegmentArrays segments;
+    segments.push_back(Point(0, 0, 0), Point(0, 4, 0));
+    segments.push_back(Point(0, 3, 0), Point(0, -1, 0));
+    segments.push_back(Point(0, -1, 0), Point(0, 0, 0));
+    float enter[3];
+    float exit[3];
+    std::uint8_t intersects[3];
+    planes.clipSegments(segments, enter, exit, intersects);
+    EXPECT_EQ(intersects[0], 1);
+    EXPECT_FLOAT_EQ(enter[0], 0.25f) << "The start is outside, the crossing is where it enters";
+    EXPECT_EQ(intersects[1], 1);
+    EXPECT_FLOAT_EQ(exit[1], 0.5f) << "The start is inside, the crossing is where it leaves";
+    EXPECT_EQ(intersects[2], 0);
+}
+
+TEST(PlaneSetTests, PolyhedronVerticesInside) {
+    const Polyhedron cube = createCube();
+    Polyhedron small;
+    small.addVertex({0, 0, 0});
+    small.addVertex({0.5f, 0, 0});
+    small.addVertex({0, 0.5f, 0});
+    small.addVertex({0, 0, 0.5f});
+    small.addFace({0, 1, 2});
+    Polyhedron crossing;
+    crossing.addVertex({0, 0, 0});
+    crossing.addVertex({5, 0, 0});
+    crossing.addVertex({0, 5, 0});
+    crossing.addFace({0, 1, 2});
+
+    EXPECT_TRUE(cube.hasInside(small));
+    EXPECT_TRUE(cube.hasAnyVertexInside(small));
+    EXPECT_FALSE(cube.hasInside(crossing));
+    EXPECT_TRUE(cube.hasAnyVertexInside(crossing));
+}
+#endif
@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <unordered_set>
 #include <cmath>
+#include <thread>
 #include <engine/core/math/Math.h>
 
 // Test fixture for typed tests
@@ -92,4 +93,96 @@ TYPED_TEST(RandomNumberGeneratorTest, GeneratesDecimalsForFloatingPointTypes) {
         
     }
 }
+
+TEST(RandomGeneratorTest, SameSeedGivesTheSameSequenceInEveryPlatform) {
+    // Values of the reference implementation of xoshiro256** seeded with splitmix64
+    GLESC::Math::RandomGenerator generator(42);
+    EXPECT_EQ(generator.next(), 0x15780B2E0C2EC716u);
+    EXPECT_EQ(generator.next(), 0x6104D9866D113A7Eu);
+    EXPECT_EQ(generator.next(), 0xAE17533239E499A1u);
+
+    generator.setSeed(42);
+    EXPECT_EQ(generator.next(), 0x15780B2E0C2EC716u);
+    GLESC::Math::RandomGenerator otherSeed(43);
+    EXPECT_NE(otherSeed.next(), 0x15780B2E0C2EC716u);
+}
+
+TEST(RandomGeneratorTest, IntegersReachBothEndsOfTheRange) {
+    GLESC::Math::RandomGenerator generator(1);
+    int counts[6] = {};
+    for (int i = 0; i < 6000; ++i) {
+        int number = generator.uniform(0, 5);
+        ASSERT_GE(number, 0);
+        ASSERT_LE(number, 5);
+        counts[number]++;
+    }
+    // Each value is expected 1000 times, it's far from the limits unless the generation is biased
+    for (int count : counts) {
+        EXPECT_GT(count, 800);
+        EXPECT_LT(count, 1200);
+    }
+
+    EXPECT_EQ(generator.uniform(-7, -7), -7);
+    // The full range of the type doesn't overflow
+    generator.uniform(std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max());
+    uint64_t big = generator.uniform(uint64_t(1) << 40, (uint64_t(1) << 40) + 3);
+    EXPECT_GE(big, uint64_t(1) << 40);
+    EXPECT_LE(big, (uint64_t(1) << 40) + 3);
+}
+
+TEST(RandomGeneratorTest, FillUniformStaysInTheRange) {
+    GLESC::Math::RandomGenerator generator(7);
+    // Odd, so the last float is made from its own number
+    std::vector<float> floats(1001);
+    generator.fillUniform(floats.data(), floats.size(), -2.0f, 3.0f);
+    float sum = 0;
+    for (float value : floats) {
+        ASSERT_GE(value, -2.0f);
+        ASSERT_LT(value, 3.0f);
+        sum += value;
+    }
+    EXPECT_NEAR(sum / static_cast<float>(floats.size()), 0.5f, 0.2f);
+
+    std::vector<double> doubles(100);
+    generator.fillUniform(doubles.data(), doubles.size(), 10.0, 20.0);
+    for (double value : doubles) {
+        ASSERT_GE(value, 10.0);
+        ASSERT_LT(value, 20.0);
+    }
+
+    // The same seed fills the same values
+    std::vector<float> again(floats.size());
+    GLESC::Math::RandomGenerator(7).fillUniform(again.data(), again.size(), -2.0f, 3.0f);
+    EXPECT_EQ(floats, again);
+}
+
+TEST(RandomGeneratorTest, ChanceFollowsTheProbability) {
+    GLESC::Math::RandomGenerator generator(3);
+    int successes = 0;
+    for (int i = 0; i < 10000; ++i) {
+        successes += generator.chance(0.25f);
+    }
+    EXPECT_NEAR(successes, 2500, 200);
+    EXPECT_FALSE(generator.chance(0.0f));
+    EXPECT_TRUE(generator.chance(1.0f));
+}
+
+TEST(RandomGeneratorTest, ThreadsSeedMakesTheThreadsReproducible) {
+    auto generateInNewThread = [] {
+        uint64_t number = 0;
+        std::thread thread([&number] { number = GLESC::Math::RandomGenerator::getThreadGenerator().next(); });
+        thread.join();
+        return number;
+    };
+    GLESC::Math::RandomGenerator::setThreadsSeed(42);
+    const float first = GLESC::Math::generateRandomNumber(0.0f, 1.0f);
+    const uint64_t firstThread = generateInNewThread();
+
+    GLESC::Math::RandomGenerator::setThreadsSeed(42);
+    EXPECT_EQ(GLESC::Math::generateRandomNumber(0.0f, 1.0f), first);
+    EXPECT_EQ(generateInNewThread(), firstThread);
+    // The new threads don't repeat the sequence of the seeding thread
+    GLESC::Math::RandomGenerator::setThreadsSeed(42);
+    EXPECT_NE(generateInNewThread(), GLESC::Math::RandomGenerator::getThreadGenerator().next());
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**************************************************************************************************
+ * @file   BufferRangeAllocatorTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-22
+ * @brief  Tests of the free list allocator of the ranges of the GPU buffers.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "engine/core/low-level-renderer/buffers/BufferRangeAllocator.h"
+
+using namespace GLESC::GAPI;
+
+TEST(BufferRangeAllocatorTests, RangesAreAllocatedUntilTheBufferIsFull) {
+    BufferRangeAllocator allocator(100);
+    const BufferRangeAllocator::Allocation first = allocator.allocate(30);
+    const BufferRangeAllocator::Allocation second = allocator.allocate(70);
+    ASSERT_TRUE(first.isValid());
+    ASSERT_TRUE(second.isValid());
+    EXPECT_EQ(first.offset, 0u);
+    EXPECT_EQ(second.offset, 30u);
+    EXPECT_EQ(allocator.getUsed(), 100u);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 0u);
+    EXPECT_FALSE(allocator.allocate(1).isValid());
+}
+
+TEST(BufferRangeAllocatorTests, SmallestFreeRangeThatFitsIsUsed) {
+    BufferRangeAllocator allocator(100);
+    const BufferRangeAllocator::Allocation a = allocator.allocate(20);
+    const BufferRangeAllocator::Allocation b = allocator.allocate(10);
+    const BufferRangeAllocator::Allocation c = allocator.allocate(5);
+    const BufferRangeAllocator::Allocation d = allocator.allocate(10);
+    // Free ranges of 20 at 0, 5 at 30 and 55 at 45
+    allocator.free(a);
+    allocator.free(c);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 3u);
+
+    const BufferRangeAllocator::Allocation small = allocator.allocate(4);
+    EXPECT_EQ(small.offset, 30u);
+    const BufferRangeAllocator::Allocation medium = allocator.allocate(15);
+    EXPECT_EQ(medium.offset, 0u);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 55u);
+    allocator.free(b);
+    allocator.free(d);
+}
+
+TEST(BufferRangeAllocatorTests, FreedRangesAreMergedWithTheirNeighbours) {
+    BufferRangeAllocator allocator(90);
+    const BufferRangeAllocator::Allocation a = allocator.allocate(30);
+    const BufferRangeAllocator::Allocation b = allocator.allocate(30);
+    const BufferRangeAllocator::Allocation c = allocator.allocate(30);
+
+    allocator.free(a);
+    allocator.free(c);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 2u);
+    EXPECT_FALSE(allocator.allocate(60).isValid());
+    // The middle range joins the free ranges at both sides
+    allocator.free(b);
+    EXPECT_EQ(allocator.getFreeRangeCount(), 1u);
+    EXPECT_EQ(allocator.getLargestFreeRange(), 90u);
+    EXPECT_EQ(allocator.getUsed(), 0u);
+    const BufferRangeAllocator::Allocation whole = allocator.allocate(90);
+    ASSERT_TRUE(whole.isValid());
+    EXPECT_EQ(whole.offset, 0u);
+}
+
+TEST(BufferRangeAllocatorTests, RandomAllocationsDontOverlap) {
+    constexpr size_t capacity = 4096;
+    BufferRangeAllocator allocator(capacity);
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<size_t> sizes(1, 64);
+    std::vector<BufferRangeAllocator::Allocation> live;
+
+    for (int step = 0; step < 2000; step++) {
+        if (!live.empty() && generator() % 3 == 0) {
+            const size_t index = generator() % live.size();
+            allocator.free(live[index]);
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(index));
+            continue;
+        }
+        const BufferRangeAllocator::Allocation allocation = allocator.allocate(sizes(generator));
+        if (allocation.isValid()) live.push_back(allocation);
+    }
+
+    std::vector<bool> owned(capacity, false);
+    size_t used = 0;
+    for (const BufferRangeAllocator::Allocation& allocation : live) {
+        ASSERT_LE(allocation.offset + allocation.size, capacity);
+        for (size_t unit = allocation.offset; unit < allocation.offset + allocation.size; unit++) {
+            ASSERT_FALSE(owned[unit]) << "Two allocations share the unit " << unit;
+            owned[unit] = true;
+        }
+        used += allocation.size;
+    }
+    EXPECT_EQ(allocator.getUsed(), used);
+
+    for (const BufferRangeAllocator::Allocation& allocation : live) {
+        allocator.free(allocation);
+    }
+    EXPECT_EQ(allocator.getFreeRangeCount(), 1u);
+    EXPECT_EQ(allocator.getLargestFreeRange(), capacity);
+}
+#endif
@@ -0,0 +1,322 @@
+/**************************************************************************************************
+ * @file   IndirectDrawerTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-21
+ * @brief  Tests of the multi draw indirect submission of the meshes stored in the arenas.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <cstring>
+#include <gtest/gtest.h>
+#include "engine/core/low-level-renderer/graphic-api/concrete-apis/recording/RecordingAPI.h"
+#include "engine/subsystems/renderer/IndirectDrawer.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    using DrawKind = GAPI::RecordingAPI::DrawKind;
+    const ColorRgba white(255, 255, 255, 255);
+
+    Material createMaterial(float shininess) {
+        Material material;
+        material.setShininess(shininess);
+        return material;
+    }
+
+    /**
+     * @brief A model view projection that is different for each draw, to tell the parameters apart.
+     */
+    MVP createMVP(float x) {
+        MVP mvp(1.0f);
+        mvp[3][0] = x;
+        return mvp;
+    }
+
+    bool add(IndirectDrawer& drawer, const MeshHandle& mesh, const Material& material, float x = 0.0f) {
+        return drawer.add(mesh, material, MV(1.0f), createMVP(x), NormalMat(1.0f));
+    }
+
+    std::vector<const GAPI::RecordingAPI::DrawCall*> getMultiDraws(const GAPI::RecordingAPI& gapi) {
+        std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws;
+        for (const GAPI::RecordingAPI::DrawCall& drawCall : gapi.getDrawCalls()) {
+            if (drawCall.kind == DrawKind::MultiTrianglesIndexedIndirect) multiDraws.push_back(&drawCall);
+        }
+        return multiDraws;
+    }
+}
+
+TEST(IndirectDrawerTests, MeshesAreStoredOnceInTheArena) {
+    GAPI::RecordingAPI gapi;
+    MeshRegistry registry;
+    IndirectDrawer drawer(gapi, 1000, 3000);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+
+    ASSERT_TRUE(add(drawer, cube, Material()));
+    ASSERT_TRUE(add(drawer, cube, Material(), 1.0f));
+    drawer.submit([](const Material&, GAPI::UInt) {});
+
+    const MeshArena* arena = drawer.getArena(VertexFormat::Float);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(arena->getMeshCount(), 1u);
+    EXPECT_EQ(arena->getUsedVertices(), cube->getVertices().size());
+    EXPECT_EQ(arena->getUsedIndices(), cube->getIndices().size());
+
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 1u);
+    EXPECT_EQ(multiDraws[0]->vertexArray, arena->getVertexArrayId());
+    ASSERT_EQ(multiDraws[0]->commands.size(), 2u);
+    for (GAPI::UInt draw = 0; draw < 2; draw++) {
+        const GAPI::DrawElementsIndirectCommand& command = multiDraws[0]->commands[draw];
+        EXPECT_EQ(command.count, cube->getIndices().size());
+        EXPECT_EQ(command.instanceCount, 1u);
+        EXPECT_EQ(command.firstIndex, 0u);
+        EXPECT_EQ(command.baseVertex, 0);
+        EXPECT_EQ(command.baseInstance, draw);
+    }
+
+    // The index buffer of the vertex array has the indices of the mesh at the start
+    const std::vector<unsigned int> indices = gapi.getBufferDataUI(multiDraws[0]->indexBuffer);
+    ASSERT_EQ(indices.size(), arena->getIndexCapacity());
+    for (size_t index = 0; index < cube->getIndices().size(); index++) {
+        EXPECT_EQ(indices[index], cube->getIndices()[index]);
+    }
+
+    const std::map<GAPI::UInt, GAPI::RecordingAPI::VertexAttribute>& attributes =
+        gapi.getVertexAttributes(arena->getVertexArrayId());
+    ASSERT_EQ(attributes.size(), ColorVertex::getLayout().size());
+    for (const auto& [location, attribute] : attributes) {
+        EXPECT_TRUE(attribute.enabled);
+        EXPECT_EQ(attribute.stride, sizeof(ColorVertex));
+    }
+    const std::vector<std::uint8_t>& vertices = gapi.getBufferBytes(attributes.at(0).buffer);
+    ASSERT_EQ(vertices.size(), arena->getVertexCapacity() * sizeof(ColorVertex));
+    EXPECT_EQ(std::memcmp(vertices.data(), cube->getVertices().data(),
+                          cube->getVertices().size() * sizeof(ColorVertex)), 0);
+}
+
+TEST(IndirectDrawerTests, DrawsAreGroupedByMaterial) {
+    GAPI::RecordingAPI gapi;
+    MeshRegistry registry;
+    IndirectDrawer drawer(gapi, 1000, 3000);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    const MeshHandle pyramid = registry.registerMesh(MeshFactory::pyramid(1, 1, 1, white));
+    const Material first = createMaterial(0.25f);
+    const Material second = createMaterial(0.5f);
+
+    ASSERT_TRUE(add(drawer, cube, first, 0.0f));
+    ASSERT_TRUE(add(drawer, pyramid, second, 1.0f));
+    ASSERT_TRUE(add(drawer, pyramid, first, 2.0f));
+
+    std::vector<std::pair<Material, GAPI::UInt>> groups;
+    drawer.submit([&groups](const Material& material, GAPI::UInt firstDraw) {
+        groups.emplace_back(material, firstDraw);
+    });
+
+    ASSERT_EQ(groups.size(), 2u);
+    EXPECT_EQ(groups[0].first, first);
+    EXPECT_EQ(groups[0].second, 0u);
+    EXPECT_EQ(groups[1].first, second);
+    EXPECT_EQ(groups[1].second, 2u);
+    EXPECT_EQ(drawer.getStats().draws, 3u);
+    EXPECT_EQ(drawer.getStats().multiDraws, 2u);
+    EXPECT_EQ(drawer.getStats().triangles, (cube->getIndices().size() + 2 * pyramid->getIndices().size()) / 3);
+
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 2u);
+    EXPECT_EQ(gapi.getDrawCalls().size(), 2u);
+    ASSERT_EQ(multiDraws[0]->commands.size(), 2u);
+    ASSERT_EQ(multiDraws[1]->commands.size(), 1u);
+    EXPECT_EQ(multiDraws[1]->start, multiDraws[0]->start + 2u);
+
+    // The pyramid is stored after the cube
+    const GAPI::DrawElementsIndirectCommand& pyramidCommand = multiDraws[0]->commands[1];
+    EXPECT_EQ(pyramidCommand.count, pyramid->getIndices().size());
+    EXPECT_EQ(pyramidCommand.firstIndex, cube->getIndices().size());
+    EXPECT_EQ(pyramidCommand.baseVertex, static_cast<GAPI::Int>(cube->getVertices().size()));
+    EXPECT_EQ(pyramidCommand.baseInstance, 1u);
+    // The same mesh is drawn from the same range in every group
+    const GAPI::DrawElementsIndirectCommand& secondGroupCommand = multiDraws[1]->commands[0];
+    EXPECT_EQ(secondGroupCommand.firstIndex, pyramidCommand.firstIndex);
+    EXPECT_EQ(secondGroupCommand.baseVertex, pyramidCommand.baseVertex);
+    EXPECT_EQ(secondGroupCommand.baseInstance, 2u);
+
+    // The parameters are in the order of the draws, the order of the groups
+    const std::vector<IndirectDrawer::DrawParams>& params = drawer.getDrawParams();
+    ASSERT_EQ(params.size(), 3u);
+    const float expectedX[] = {0.0f, 2.0f, 1.0f};
+    for (size_t draw = 0; draw < params.size(); draw++) {
+        const IndirectDrawer::DrawParams expected = IndirectDrawer::createDrawParams(
+            MV(1.0f), createMVP(expectedX[draw]), NormalMat(1.0f), VertexPacker::PositionDequantization());
+        EXPECT_EQ(std::memcmp(&params[draw], &expected, sizeof(expected)), 0);
+    }
+
+    // The shader reads the same parameters from the storage buffer
+    for (const GAPI::RecordingAPI::DrawCall* multiDraw : multiDraws) {
+        ASSERT_EQ(multiDraw->storageBuffers.count(IndirectDrawer::drawParamsBinding), 1u);
+        const GAPI::RecordingAPI::BufferBinding& binding =
+            multiDraw->storageBuffers.at(IndirectDrawer::drawParamsBinding);
+        ASSERT_EQ(binding.size, params.size() * sizeof(IndirectDrawer::DrawParams));
+        const std::vector<std::uint8_t> storage = gapi.getBufferBytes(binding.buffer, binding.offset, binding.size);
+        EXPECT_EQ(std::memcmp(storage.data(), params.data(), storage.size()), 0);
+    }
+}
+
+TEST(IndirectDrawerTests, EachVertexFormatHasItsOwnArena) {
+    GAPI::RecordingAPI gapi;
+    MeshRegistry registry;
+    IndirectDrawer drawer(gapi, 1000, 3000);
+    ColorMesh quantizedMesh = MeshFactory::sphere(8, 8, 2.0f, white);
+    quantizedMesh.setVertexFormat(VertexFormat::Quantized);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    const MeshHandle sphere = registry.registerMesh(quantizedMesh);
+
+    ASSERT_TRUE(add(drawer, sphere, Material()));
+    ASSERT_TRUE(add(drawer, cube, Material()));
+    drawer.submit([](const Material&, GAPI::UInt) {});
+
+    const MeshArena* floatArena = drawer.getArena(VertexFormat::Float);
+    const MeshArena* quantizedArena = drawer.getArena(VertexFormat::Quantized);
+    ASSERT_NE(floatArena, nullptr);
+    ASSERT_NE(quantizedArena, nullptr);
+    EXPECT_EQ(drawer.getArena(VertexFormat::Compact), nullptr);
+    EXPECT_EQ(floatArena->getMeshCount(), 1u);
+    EXPECT_EQ(quantizedArena->getMeshCount(), 1u);
+    EXPECT_EQ(drawer.getStats().multiDraws, 2u);
+
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 2u);
+    EXPECT_EQ(multiDraws[0]->vertexArray, floatArena->getVertexArrayId());
+    EXPECT_EQ(multiDraws[1]->vertexArray, quantizedArena->getVertexArrayId());
+    EXPECT_EQ(gapi.getVertexAttributes(quantizedArena->getVertexArrayId()).size(),
+              VertexPacker::getLayout(VertexFormat::Quantized).size());
+
+    // The quantized positions are restored with the dequantization of the mesh
+    const VertexPacker::PositionDequantization dequantization = sphere->getPositionDequantization();
+    const IndirectDrawer::DrawParams& params = drawer.getDrawParams()[1];
+    for (size_t axis = 0; axis < 3; axis++) {
+        EXPECT_FLOAT_EQ(params.positionScale[axis], dequantization.scale[axis]);
+        EXPECT_FLOAT_EQ(params.positionOffset[axis], dequantization.offset[axis]);
+    }
+    EXPECT_FLOAT_EQ(drawer.getDrawParams()[0].positionScale[0], 1.0f);
+}
+
+TEST(IndirectDrawerTests, RangesOfDestroyedMeshesAreReused) {
+    GAPI::RecordingAPI gapi;
+    MeshRegistry registry;
+    const ColorMesh cubeMesh = MeshFactory::cube(white);
+    IndirectDrawer drawer(gapi, cubeMesh.getVertices().size(), cubeMesh.getIndices().size());
+    MeshHandle cube = registry.registerMesh(cubeMesh);
+    const MeshHandle pyramid = registry.registerMesh(MeshFactory::pyramid(1, 1, 1, white));
+
+    ASSERT_TRUE(add(drawer, cube, Material()));
+    // The cube fills the arena, the pyramid must be drawn on its own
+    EXPECT_FALSE(add(drawer, pyramid, Material()));
+    drawer.submit([](const Material&, GAPI::UInt) {});
+    EXPECT_EQ(drawer.getStats().draws, 1u);
+    EXPECT_EQ(drawer.getStats().rejectedDraws, 1u);
+    EXPECT_EQ(drawer.getArena(VertexFormat::Float)->getReleasedMeshCount(), 0u);
+
+    cube = MeshHandle();
+    EXPECT_EQ(registry.releaseUnusedMeshes(), 1u);
+    gapi.clearDrawCalls();
+
+    ASSERT_TRUE(add(drawer, pyramid, Material()));
+    drawer.submit([](const Material&, GAPI::UInt) {});
+    const MeshArena* arena = drawer.getArena(VertexFormat::Float);
+    EXPECT_EQ(arena->getReleasedMeshCount(), 1u);
+    EXPECT_EQ(arena->getMeshCount(), 1u);
+    EXPECT_EQ(arena->getUsedVertices(), pyramid->getVertices().size());
+    EXPECT_EQ(drawer.getStats().rejectedDraws, 0u);
+
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 1u);
+    ASSERT_EQ(multiDraws[0]->commands.size(), 1u);
+    EXPECT_EQ(multiDraws[0]->commands[0].firstIndex, 0u);
+    EXPECT_EQ(multiDraws[0]->commands[0].baseVertex, 0);
+}
+
+TEST(IndirectDrawerTests, FramesAreStreamedThroughTheRing) {
+    GAPI::RecordingAPI gapi;
+    MeshRegistry registry;
+    IndirectDrawer drawer(gapi, 1000, 3000);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+
+    for (int frame = 0; frame < 4; frame++) {
+        ASSERT_TRUE(add(drawer, cube, Material(), static_cast<float>(frame)));
+        drawer.submit([](const Material&, GAPI::UInt) {});
+    }
+    const GAPI::StreamingRing& ring = drawer.getStreamingRing();
+    EXPECT_EQ(drawer.getStats().streamedBytes,
+              sizeof(IndirectDrawer::DrawParams) + sizeof(GAPI::DrawElementsIndirectCommand));
+    // The mesh was staged once, only the draws of the frames are streamed after that
+    EXPECT_EQ(drawer.getArena(VertexFormat::Float)->getStagedBytes(),
+              cube->getVertices().size() * sizeof(ColorVertex) + cube->getIndices().size() * sizeof(ColorMesh::Index));
+    EXPECT_EQ(gapi.getCopiedBytes(), drawer.getArena(VertexFormat::Float)->getStagedBytes());
+
+    // Each frame is written to the next region of the ring
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 4u);
+    for (size_t frame = 0; frame < multiDraws.size(); frame++) {
+        const GAPI::RecordingAPI::BufferBinding& binding =
+            multiDraws[frame]->storageBuffers.at(IndirectDrawer::drawParamsBinding);
+        EXPECT_EQ(binding.buffer, ring.getBufferId());
+        EXPECT_EQ(binding.offset / ring.getRegionSize(), frame % ring.getRegionCount());
+        EXPECT_EQ(binding.offset % drawer.getStorageBufferAlignment(), 0u);
+        const std::vector<std::uint8_t> params = gapi.getBufferBytes(binding.buffer, binding.offset, binding.size);
+        IndirectDrawer::DrawParams frameParams{};
+        std::memcpy(&frameParams, params.data(), sizeof(frameParams));
+        EXPECT_FLOAT_EQ(frameParams.mvp[12], static_cast<float>(frame));
+    }
+}
+
+TEST(IndirectDrawerTests, StreamedParametersUseTheAlignmentOfTheDevice) {
+    GAPI::RecordingAPI gapi;
+    gapi.setStorageBufferOffsetAlignment(1024);
+    MeshRegistry registry;
+    IndirectDrawer drawer(gapi, 1000, 3000);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    EXPECT_EQ(drawer.getStorageBufferAlignment(), 0u) << "It can't be queried before the context exists";
+
+    ASSERT_TRUE(add(drawer, cube, Material(), 0.0f));
+    drawer.submit([](const Material&, GAPI::UInt) {});
+    EXPECT_EQ(drawer.getStorageBufferAlignment(), 1024u);
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 1u);
+    const GAPI::RecordingAPI::BufferBinding& binding =
+        multiDraws[0]->storageBuffers.at(IndirectDrawer::drawParamsBinding);
+    ASSERT_EQ(binding.buffer, drawer.getStreamingRing().getBufferId());
+    // The mesh was staged before the parameters in the same region
+    EXPECT_GT(binding.offset, 0u);
+    EXPECT_EQ(binding.offset % 1024, 0u);
+}
+
+TEST(IndirectDrawerTests, FramesThatDontFitInTheRingAreUploadedApart) {
+    GAPI::RecordingAPI gapi;
+    MeshRegistry registry;
+    // The ring only has space for the draws of a mesh
+    IndirectDrawer drawer(gapi, 1000, 3000, 512);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+
+    for (int draw = 0; draw < 3; draw++) {
+        ASSERT_TRUE(add(drawer, cube, Material(), static_cast<float>(draw)));
+    }
+    drawer.submit([](const Material&, GAPI::UInt) {});
+    EXPECT_EQ(drawer.getStats().draws, 3u);
+    EXPECT_EQ(drawer.getStats().streamedBytes, 0u);
+
+    const std::vector<const GAPI::RecordingAPI::DrawCall*> multiDraws = getMultiDraws(gapi);
+    ASSERT_EQ(multiDraws.size(), 1u);
+    EXPECT_EQ(multiDraws[0]->start, 0u);
+    ASSERT_EQ(multiDraws[0]->commands.size(), 3u);
+    const GAPI::RecordingAPI::BufferBinding& binding =
+        multiDraws[0]->storageBuffers.at(IndirectDrawer::drawParamsBinding);
+    EXPECT_NE(binding.buffer, drawer.getStreamingRing().getBufferId());
+    EXPECT_EQ(gapi.getBufferBytes(binding.buffer).size(), 3 * sizeof(IndirectDrawer::DrawParams));
+}
+#endif
@@ -0,0 +1,197 @@
+/**************************************************************************************************
+ * @file   MeshBuilderTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-16
+ * @brief  Tests of the building of meshes from several threads.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <tuple>
+#include "engine/core/threading/ThreadPool.h"
+#include "engine/subsystems/renderer/mesh/MeshBuilder.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    const ColorRgba white(255, 255, 255, 255);
+
+    ColorMesh::VertexColorParam gridCorner(size_t x, size_t z) {
+        return {Position(static_cast<float>(x), 0, static_cast<float>(z)), white};
+    }
+
+    void addGridRow(ColorMesh& mesh, size_t x, size_t size) {
+        for (size_t z = 0; z < size; z++) {
+            mesh.addQuad(gridCorner(x, z), gridCorner(x, z + 1), gridCorner(x + 1, z + 1), gridCorner(x + 1, z));
+        }
+    }
+
+    void addGridRow(ColorMeshBuilder::Staging& staging, size_t x, size_t size) {
+        for (size_t z = 0; z < size; z++) {
+            staging.addQuad(gridCorner(x, z), gridCorner(x, z + 1), gridCorner(x + 1, z + 1), gridCorner(x + 1, z));
+        }
+    }
+
+    bool lessPosition(const Position& a, const Position& b) {
+        return std::make_tuple(a.getX(), a.getY(), a.getZ()) < std::make_tuple(b.getX(), b.getY(), b.getZ());
+    }
+
+    /**
+     * @brief The triangles sorted by their vertices, to compare meshes built in different orders.
+     */
+    std::vector<std::vector<Position>> getTriangles(const ColorMesh& mesh) {
+        std::vector<std::vector<Position>> triangles;
+        const auto& indices = mesh.getIndices();
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            triangles.push_back({
+                mesh.getVertices()[indices[index]].getPosition(),
+                mesh.getVertices()[indices[index + 1]].getPosition(),
+                mesh.getVertices()[indices[index + 2]].getPosition()
+            });
+        }
+        std::sort(triangles.begin(), triangles.end(), [](const auto& a, const auto& b) {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), lessPosition);
+        });
+        return triangles;
+    }
+}
+
+TEST(MeshBuilderTests, SingleThreadBuildIsEqualToTheMesh) {
+    constexpr size_t size = 8;
+    ColorMesh expected;
+    expected.startBuilding();
+    for (size_t x = 0; x < size; x++) addGridRow(expected, x, size);
+    expected.finishBuilding();
+
+    ColorMesh built;
+    built.startBuilding();
+    ColorMeshBuilder builder;
+    for (size_t x = 0; x < size; x++) addGridRow(builder.getThreadStaging(), x, size);
+    builder.finishBuilding(built);
+
+    EXPECT_FALSE(built.isBeingBuilt());
+    EXPECT_TRUE(built == expected);
+    ASSERT_EQ(built.getFaces().size(), expected.getFaces().size());
+    for (size_t face = 0; face < built.getFaces().size(); face++) {
+        for (size_t corner = 0; corner < 3; corner++) {
+            EXPECT_EQ(built.getFaces()[face][corner], expected.getFaces()[face][corner]);
+        }
+    }
+    EXPECT_EQ(built.getBoundingVolume().getMin(), expected.getBoundingVolume().getMin());
+    EXPECT_EQ(built.getBoundingVolume().getMax(), expected.getBoundingVolume().getMax());
+}
+
+TEST(MeshBuilderTests, StagingBuffersAreAppendedAfterTheExistingGeometry) {
+    const ColorMesh cube = MeshFactory::cube(white);
+    ColorMesh mesh = cube;
+    mesh.startBuilding();
+    ColorMeshBuilder builder;
+    addGridRow(builder.createStaging(), 0, 2);
+    addGridRow(builder.createStaging(), 1, 2);
+    builder.finishBuilding(mesh);
+
+    const size_t cubeVertices = cube.getVertices().size();
+    ASSERT_EQ(mesh.getVertices().size(), cubeVertices + 16);
+    ASSERT_EQ(mesh.getIndices().size(), cube.getIndices().size() + 24);
+    // The indices of the second staging buffer are rebased after the first one
+    EXPECT_EQ(mesh.getIndices()[cube.getIndices().size()], cubeVertices);
+    EXPECT_EQ(mesh.getIndices()[cube.getIndices().size() + 12], cubeVertices + 8);
+    EXPECT_EQ(mesh.getVertices()[cubeVertices + 8].getPosition(), Position(1, 0, 0));
+}
+
+TEST(MeshBuilderTests, ParallelBuildHasTheSameTriangles) {
+    constexpr size_t size = 64;
+    ColorMesh expected;
+    expected.startBuilding();
+    for (size_t x = 0; x < size; x++) addGridRow(expected, x, size);
+    expected.finishBuilding();
+
+    ThreadPool workers(4);
+    ColorMeshBuilder builder;
+    ColorMesh built;
+    // The builder is reused, the second mesh must not see the staging buffers of the first one
+    for (int build = 0; build < 2; build++) {
+        built = ColorMesh();
+        built.startBuilding();
+        workers.parallelFor(size, [&](size_t begin, size_t end) {
+            ColorMeshBuilder::Staging& staging = builder.getThreadStaging();
+            for (size_t x = begin; x < end; x++) addGridRow(staging, x, size);
+        });
+        builder.finishBuilding(built);
+    }
+
+    ASSERT_EQ(built.getVertices().size(), expected.getVertices().size());
+    ASSERT_EQ(built.getIndices().size(), expected.getIndices().size());
+    for (ColorMesh::Index index : built.getIndices()) {
+        ASSERT_LT(index, built.getVertices().size());
+    }
+    EXPECT_EQ(getTriangles(built), getTriangles(expected));
+}
+
+TEST(MeshBuilderTests, MeshWithoutFacesKeepsItsTriangles) {
+    ColorMesh mesh;
+    mesh.setStoreFaces(false);
+    mesh.startBuilding();
+    addGridRow(mesh, 0, 4);
+    ColorMeshBuilder builder;
+    addGridRow(builder.getThreadStaging(), 1, 4);
+    builder.finishBuilding(mesh);
+
+    EXPECT_FALSE(mesh.areFacesStored());
+    EXPECT_TRUE(mesh.getFaces().empty());
+    EXPECT_EQ(mesh.getIndices().size(), 48u);
+
+    ColorMesh combined;
+    combined.startBuilding();
+    combined.attatchMesh(mesh);
+    combined.finishBuilding();
+    EXPECT_TRUE(combined.areFacesStored());
+    EXPECT_EQ(combined.getFaces().size(), 16u);
+    EXPECT_EQ(getTriangles(combined), getTriangles(mesh));
+}
+
+#if RENDERING_BENCHMARKING
+TEST(MeshBuilderTests, BenchmarkBuildingAChunk) {
+    constexpr size_t size = 300;
+    const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool workers(threadCount);
+
+    auto startTime = std::chrono::steady_clock::now();
+    ColorMesh locked;
+    locked.startBuilding();
+    workers.parallelFor(size, [&](size_t begin, size_t end) {
+        for (size_t x = begin; x < end; x++) addGridRow(locked, x, size);
+    });
+    locked.finishBuilding();
+    auto endTime = std::chrono::steady_clock::now();
+    const double lockedMillis = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    startTime = std::chrono::steady_clock::now();
+    ColorMesh built;
+    built.setStoreFaces(false);
+    built.startBuilding();
+    ColorMeshBuilder builder;
+    workers.parallelFor(size, [&](size_t begin, size_t end) {
+        ColorMeshBuilder::Staging& staging = builder.getThreadStaging();
+        for (size_t x = begin; x < end; x++) addGridRow(staging, x, size);
+    });
+    builder.finishBuilding(built);
+    endTime = std::chrono::steady_clock::now();
+    const double builderMillis = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    EXPECT_EQ(built.getIndices().size(), locked.getIndices().size());
+    std::cout << "Mesh of " << size * size << " quads, " << threadCount << " threads: locked " << lockedMillis
+              << " ms, builder " << builderMillis << " ms, speedup x" << lockedMillis / builderMillis << "\n";
+}
+#endif
+#endif
@@ -0,0 +1,205 @@
+/**************************************************************************************************
+ * @file   MeshCacheTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-18
+ * @brief  Tests of the binary mesh files and the mesh cache.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "engine/core/hash/Hasher.h"
+#include "engine/res-mng/models/MeshCache.h"
+#include "engine/res-mng/models/MeshFile.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+class MeshCacheTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory = (std::filesystem::temp_directory_path() / "glesc-mesh-cache-tests").string();
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    static ColorMesh createMesh() {
+        ColorMesh mesh = MeshFactory::sphere(16, 16, 2.0f, ColorRgba(200, 30, 10, 255));
+        mesh.setVertexFormat(VertexFormat::Compact);
+        mesh.setRenderType(RenderType::SingleDrawStatic);
+        return mesh;
+    }
+
+    static void expectSameMesh(const ColorMesh& actual, const ColorMesh& expected) {
+        ASSERT_EQ(actual.getVertices().size(), expected.getVertices().size());
+        for (size_t index = 0; index < expected.getVertices().size(); index++) {
+            EXPECT_EQ(actual.getVertices()[index], expected.getVertices()[index]);
+        }
+        EXPECT_EQ(actual.getIndices(), expected.getIndices());
+        EXPECT_EQ(actual.getFaces().size(), expected.getFaces().size());
+        EXPECT_EQ(actual.areFacesStored(), expected.areFacesStored());
+        EXPECT_EQ(actual.getVertexFormat(), expected.getVertexFormat());
+        EXPECT_EQ(actual.getRenderType(), expected.getRenderType());
+        EXPECT_EQ(actual.getBoundingVolume().getMin(), expected.getBoundingVolume().getMin());
+        EXPECT_EQ(actual.getBoundingVolume().getMax(), expected.getBoundingVolume().getMax());
+        EXPECT_FALSE(actual.isBeingBuilt());
+    }
+
+    static void overwriteBytes(const std::string& path, std::streamoff offset, const std::string& bytes) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::string directory;
+};
+
+TEST_F(MeshCacheTests, MeshFileRoundTrip) {
+    MeshCache cache(directory);
+    const std::string path = cache.getPath(1);
+    ColorMesh mesh = createMesh();
+    ASSERT_TRUE(MeshFile::write(path, mesh));
+
+    std::optional<ColorMesh> loaded = MeshFile::read(path);
+    ASSERT_TRUE(loaded.has_value());
+    expectSameMesh(*loaded, mesh);
+
+    std::optional<MeshFile::Header> header = MeshFile::readHeader(path);
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->vertexCount, mesh.getVertices().size());
+    EXPECT_EQ(header->indexCount, mesh.getIndices().size());
+    EXPECT_EQ(header->boundsMax[1], mesh.getBoundingVolume().getMax().get(1));
+    EXPECT_EQ(std::filesystem::file_size(path), sizeof(MeshFile::Header) +
+              mesh.getVertices().size() * sizeof(ColorVertex) + mesh.getIndices().size() * sizeof(unsigned int));
+
+    // The meshes without faces are loaded without faces
+    ColorMesh withoutFaces = createMesh();
+    withoutFaces.setStoreFaces(false);
+    ASSERT_TRUE(MeshFile::write(path, withoutFaces));
+    loaded = MeshFile::read(path);
+    ASSERT_TRUE(loaded.has_value());
+    expectSameMesh(*loaded, withoutFaces);
+    EXPECT_TRUE(loaded->getFaces().empty());
+}
+
+TEST_F(MeshCacheTests, InvalidFilesAreRejected) {
+    MeshCache cache(directory);
+    const std::string path = cache.getPath(2);
+    EXPECT_FALSE(MeshFile::read(path).has_value());
+    EXPECT_FALSE(MeshFile::readHeader(path).has_value());
+
+    const ColorMesh mesh = createMesh();
+    ASSERT_TRUE(MeshFile::write(path, mesh));
+    const auto fileSize = std::filesystem::file_size(path);
+
+    // Truncated
+    std::filesystem::resize_file(path, fileSize - 4);
+    EXPECT_FALSE(MeshFile::read(path).has_value());
+    EXPECT_FALSE(MeshFile::readHeader(path).has_value());
+
+    // Corrupted vertices
+    ASSERT_TRUE(MeshFile::write(path, mesh));
+    overwriteBytes(path, static_cast<std::streamoff>(sizeof(MeshFile::Header) + 5), "xyz");
+    EXPECT_FALSE(MeshFile::read(path).has_value());
+
+    // Other version of the format
+    ASSERT_TRUE(MeshFile::write(path, mesh));
+    overwriteBytes(path, offsetof(MeshFile::Header, version), std::string("\x7f\0\0\0", 4));
+    EXPECT_FALSE(MeshFile::read(path).has_value());
+
+    // Not a mesh file
+    ASSERT_TRUE(MeshFile::write(path, mesh));
+    overwriteBytes(path, 0, "OBJ ");
+    EXPECT_FALSE(MeshFile::read(path).has_value());
+
+    // The cache treats them as missing and writes them again
+    int creations = 0;
+    const ColorMesh created = cache.getOrCreate(2, [&creations] {
+        creations++;
+        return createMesh();
+    });
+    EXPECT_EQ(creations, 1);
+    EXPECT_TRUE(MeshFile::read(path).has_value());
+}
+
+TEST_F(MeshCacheTests, MeshesAreOnlyCreatedOnce) {
+    const MeshCache::Key key = MeshCache::hashString("tests/sphere-v1");
+    int creations = 0;
+    auto create = [&creations] {
+        creations++;
+        return createMesh();
+    };
+    {
+        MeshCache cache(directory);
+        const ColorMesh created = cache.getOrCreate(key, create);
+        EXPECT_EQ(cache.getStats().misses, 1u);
+    }
+    // A new cache in the same directory, as in the next run of the game
+    MeshCache cache(directory);
+    const ColorMesh loaded = cache.getOrCreate(key, create);
+    EXPECT_EQ(creations, 1);
+    EXPECT_EQ(cache.getStats().hits, 1u);
+    EXPECT_EQ(cache.getStats().misses, 0u);
+    expectSameMesh(loaded, createMesh());
+
+    // Other keys are other meshes
+    EXPECT_NE(MeshCache::hashString("tests/sphere-v2"), key);
+    EXPECT_FALSE(cache.load(MeshCache::hashString("tests/sphere-v2")).has_value());
+}
+
+TEST_F(MeshCacheTests, ContentHashesAreStable) {
+    // The keys are stored on disk, so they must not depend on the build or the run
+    EXPECT_EQ(Hasher::hashBytes("", 0), 0xcbf29ce484222325ull);
+    EXPECT_EQ(Hasher::hashBytes("a", 1), 0xaf63dc4c8601ec8cull);
+    EXPECT_EQ(MeshCache::hashString("foobar"), 0x85944171f73967e8ull);
+    // Hashing in parts is the same as hashing everything
+    EXPECT_EQ(Hasher::hashBytes("bar", 3, Hasher::hashBytes("foo", 3)), MeshCache::hashString("foobar"));
+
+    MeshCache cache(directory);
+    const std::string path = directory + "/source.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "foobar";
+    }
+    EXPECT_EQ(MeshCache::hashFile(path), MeshCache::hashString("foobar"));
+    EXPECT_EQ(MeshCache::hashFile(directory + "/missing.bin"), 0u);
+}
+
+#if RENDERING_BENCHMARKING
+TEST_F(MeshCacheTests, BenchmarkLoadAgainstCreate) {
+    MeshCache cache(directory);
+    auto create = [] {
+        ColorMesh mesh;
+        mesh.startBuilding();
+        const ColorMesh cube = MeshFactory::cube(ColorRgba(100, 100, 100, 255));
+        for (int i = 0; i < 2000; i++) {
+            mesh.attatchMesh(cube);
+        }
+        mesh.finishBuilding();
+        return mesh;
+    };
+    auto startTime = std::chrono::steady_clock::now();
+    const ColorMesh created = cache.getOrCreate(3, create);
+    auto endTime = std::chrono::steady_clock::now();
+    const double createMillis = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    startTime = std::chrono::steady_clock::now();
+    const ColorMesh loaded = cache.getOrCreate(3, create);
+    endTime = std::chrono::steady_clock::now();
+    const double loadMillis = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    std::cout << "Mesh of " << created.getVertices().size() << " vertices created and stored in " << createMillis
+              << " ms, loaded from the cache in " << loadMillis << " ms\n";
+}
+#endif
+#endif
@@ -0,0 +1,201 @@
+/**************************************************************************************************
+ * @file   MeshLodTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-20
+ * @brief  Tests of the simplification of the meshes and the selection of their levels of detail.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include "engine/core/threading/ThreadPool.h"
+#include "engine/subsystems/renderer/MeshPrepass.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+#include "engine/subsystems/renderer/mesh/MeshLod.h"
+#include "engine/subsystems/renderer/mesh/MeshSimplifier.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    const ColorRgba white(255, 255, 255, 255);
+
+    /**
+     * @brief Creates a flat grid in the plane y = 0 with two triangles per cell, built with addTris.
+     */
+    ColorMesh createGrid(int cells) {
+        ColorMesh mesh;
+        mesh.startBuilding();
+        for (int x = 0; x < cells; x++) {
+            for (int z = 0; z < cells; z++) {
+                const auto x0 = static_cast<float>(x);
+                const auto z0 = static_cast<float>(z);
+                mesh.addTris({Position(x0, 0, z0), white}, {Position(x0, 0, z0 + 1), white},
+                             {Position(x0 + 1, 0, z0 + 1), white});
+                mesh.addTris({Position(x0, 0, z0), white}, {Position(x0 + 1, 0, z0 + 1), white},
+                             {Position(x0 + 1, 0, z0), white});
+            }
+        }
+        mesh.finishBuilding();
+        return mesh;
+    }
+
+    size_t getTriangleCount(const ColorMesh& mesh) {
+        return mesh.getIndices().size() / 3;
+    }
+}
+
+TEST(MeshSimplifierTests, FlatRegionsAreSimplifiedWithoutError) {
+    const ColorMesh grid = createGrid(8);
+    std::vector<Position> positions;
+    for (const ColorVertex& vertex : grid.getVertices()) {
+        positions.push_back(vertex.getPosition());
+    }
+    const MeshSimplifier::Result result = MeshSimplifier::simplifyPositions(positions, grid.getIndices(), 2);
+    // A square can't have less than two triangles, and the border keeps the corners in place
+    EXPECT_EQ(result.indices.size(), 6u);
+    EXPECT_NEAR(result.error, 0.0f, 1e-4f);
+
+    // Removing the corners has an error, so the simplification stops before them
+    const ColorMesh simplified = MeshSimplifier::simplify(grid, 0.0f, 1e-4f);
+    EXPECT_EQ(getTriangleCount(simplified), 2u);
+    EXPECT_EQ(simplified.getVertices().size(), 4u);
+    EXPECT_EQ(simplified.getBoundingVolume().getMin(), Position(0, 0, 0));
+    EXPECT_EQ(simplified.getBoundingVolume().getMax(), Position(8, 0, 8));
+    for (const ColorVertex& vertex : simplified.getVertices()) {
+        EXPECT_EQ(vertex.getNormal(), Normal(0, 1, 0));
+        EXPECT_EQ(vertex.getColor(), ColorRgbaNorm(white));
+    }
+}
+
+TEST(MeshSimplifierTests, SimplifiedMeshesKeepTheirShape) {
+    const ColorMesh sphere = MeshFactory::sphere(32, 32, 2.0f, white);
+    const ColorMesh simplified = MeshSimplifier::simplify(sphere, 0.25f);
+    EXPECT_FALSE(simplified.isBeingBuilt());
+    EXPECT_LE(getTriangleCount(simplified), getTriangleCount(sphere) / 4);
+    EXPECT_GT(getTriangleCount(simplified), getTriangleCount(sphere) / 8);
+
+    // The positions are a subset of the original ones, so every vertex is still on the sphere
+    for (const ColorVertex& vertex : simplified.getVertices()) {
+        EXPECT_NEAR(vertex.getPosition().length(), 2.0f, 1e-3f);
+    }
+    const Position sizeBefore = sphere.getBoundingVolume().getMax() - sphere.getBoundingVolume().getMin();
+    const Position sizeAfter = simplified.getBoundingVolume().getMax() - simplified.getBoundingVolume().getMin();
+    for (size_t axis = 0; axis < 3; axis++) {
+        EXPECT_GT(sizeAfter[axis], sizeBefore[axis] * 0.9f);
+    }
+    // No face is flipped, the faces still point out of the sphere
+    const std::vector<ColorMesh::Index>& indices = simplified.getIndices();
+    const std::vector<ColorVertex>& vertices = simplified.getVertices();
+    for (size_t index = 0; index < indices.size(); index += 3) {
+        const Position center = (vertices[indices[index]].getPosition() +
+            vertices[indices[index + 1]].getPosition() + vertices[indices[index + 2]].getPosition()) / 3.0f;
+        EXPECT_GT(vertices[indices[index]].getNormal().dot(center), 0.0f);
+    }
+}
+
+TEST(MeshLodTests, LevelsAreSelectedWithHysteresis) {
+    MeshRegistry registry;
+    const std::shared_ptr<const MeshLodChain> chain = MeshLodChain::generate(3, [](size_t level) {
+        const int detail = 32 >> level;
+        return MeshFactory::sphere(detail, detail, 1.0f, white);
+    }, 0.25f, registry);
+    ASSERT_EQ(chain->getLevelCount(), 3u);
+    EXPECT_GT(getTriangleCount(chain->getMesh(0)), getTriangleCount(chain->getMesh(1)));
+    EXPECT_GT(getTriangleCount(chain->getMesh(1)), getTriangleCount(chain->getMesh(2)));
+    EXPECT_FLOAT_EQ(chain->getLevel(1).minScreenSize, 0.125f);
+
+    EXPECT_EQ(chain->selectLevel(0.3f), 0u);
+    EXPECT_EQ(chain->selectLevel(0.2f), 1u);
+    EXPECT_EQ(chain->selectLevel(0.01f), 2u);
+    // Close to a threshold the level doesn't change
+    EXPECT_EQ(chain->selectLevel(0.24f, 0), 0u);
+    EXPECT_EQ(chain->selectLevel(0.26f, 1), 1u);
+    EXPECT_EQ(chain->selectLevel(0.2f, 0), 1u);
+    EXPECT_EQ(chain->selectLevel(0.3f, 1), 0u);
+    // Far from the thresholds it can skip levels
+    EXPECT_EQ(chain->selectLevel(1.0f, 2), 0u);
+    EXPECT_EQ(chain->selectLevel(0.01f, 0), 2u);
+}
+
+TEST(MeshLodTests, SimplifiedChainsHaveLessTrianglesPerLevel) {
+    MeshRegistry registry;
+    const ColorMesh sphere = MeshFactory::sphere(24, 24, 1.0f, white);
+    const std::shared_ptr<const MeshLodChain> chain = MeshLodChain::simplify(sphere, 4, 0.5f, 0.5f, registry);
+    ASSERT_EQ(chain->getLevelCount(), 4u);
+    EXPECT_EQ(getTriangleCount(chain->getMesh(0)), getTriangleCount(sphere));
+    for (size_t level = 1; level < chain->getLevelCount(); level++) {
+        EXPECT_LE(getTriangleCount(chain->getMesh(level)), getTriangleCount(chain->getMesh(level - 1)) / 2 + 1);
+        EXPECT_LT(chain->getLevel(level).minScreenSize, chain->getLevel(level - 1).minScreenSize);
+    }
+    EXPECT_EQ(chain->getLevel(3).minScreenSize, 0.0f);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 4u);
+}
+
+TEST(MeshLodTests, PrepassSelectsTheLevelByScreenSize) {
+    MeshRegistry registry;
+    const std::shared_ptr<const MeshLodChain> chain = MeshLodChain::generate(3, [](size_t level) {
+        const int detail = 16 >> level;
+        return MeshFactory::sphere(detail, detail, 1.0f, white);
+    }, 0.25f, registry);
+    Projection projection;
+    projection.makeProjectionMatrix(90.0f, 0.1f, 1000.0f, 800.0f, 800.0f);
+    View view;
+    view.makeViewMatrixPosRot(Position(0, 0, 0), Transform::Rotation(0, 0, 0).toRads());
+    const VP viewProjection = projection * view;
+    const Frustum frustum(viewProjection);
+    ThreadPool workers(2);
+    MeshPrepass prepass;
+
+    // With a field of view of 90 degrees the screen size is the radius divided by the distance, the bounding
+    // sphere of a unit sphere has a radius of sqrt(3)
+    const float radius = Math::sqrt(3.0f);
+    std::vector<MeshRenderData> meshes;
+    Transform::InterpolationStore interpolations;
+    Transform::TransformStore transforms;
+    Math::AABBTree meshBounds;
+    auto placeMeshes = [&](const std::vector<float>& distances) {
+        meshes.clear();
+        meshBounds.clear();
+        interpolations.clear();
+        for (size_t index = 0; index < distances.size(); index++) {
+            Transform::Transform transform;
+            transform.setPosition(Transform::Position(0, 0, -distances[index]));
+            const auto handle = static_cast<RenderHandle>(index);
+            MeshRenderData meshData{chain->getLevel(0).mesh, Material(), handle, chain};
+            interpolations.push(handle, transform);
+            meshData.cullingProxy = meshBounds.createProxy(
+                Transform::Transformer::transformBoundingVolume(chain->getMesh(0).getBoundingVolume(), transform)
+                .getBoundingBox(), index);
+            meshes.push_back(meshData);
+        }
+        interpolations.interpolate(1.0f, transforms);
+        prepass.run(meshes, transforms, meshBounds, view, projection, viewProjection, frustum, workers);
+    };
+
+    placeMeshes({radius / 0.5f, radius / 0.2f, radius / 0.05f});
+    EXPECT_EQ(prepass.getLodLevel(0), 0u);
+    EXPECT_EQ(prepass.getLodLevel(1), 1u);
+    EXPECT_EQ(prepass.getLodLevel(2), 2u);
+    EXPECT_EQ(&prepass.getDrawnMesh(meshes[1], 1), &chain->getMesh(1));
+
+    // The objects keep their level while they move a bit past the thresholds
+    placeMeshes({radius / 0.24f, radius / 0.26f, radius / 0.05f});
+    EXPECT_EQ(prepass.getLodLevel(0), 0u);
+    EXPECT_EQ(prepass.getLodLevel(1), 1u);
+    placeMeshes({radius / 0.2f, radius / 0.3f, radius / 0.05f});
+    EXPECT_EQ(prepass.getLodLevel(0), 1u);
+    EXPECT_EQ(prepass.getLodLevel(1), 0u);
+}
+
+TEST(MeshLodTests, ScreenSizeDependsOnTheDistance) {
+    EXPECT_FLOAT_EQ(MeshLodChain::computeScreenSize(1.0f, 10.0f, 1.0f), 0.1f);
+    EXPECT_FLOAT_EQ(MeshLodChain::computeScreenSize(1.0f, 20.0f, 1.0f), 0.05f);
+    EXPECT_FLOAT_EQ(MeshLodChain::computeScreenSize(1.0f, 10.0f, 2.0f), 0.2f);
+    // Inside the sphere the mesh covers the whole screen
+    EXPECT_GT(MeshLodChain::computeScreenSize(1.0f, 0.5f, 1.0f), 1.0f);
+}
+#endif
@@ -0,0 +1,179 @@
+/**************************************************************************************************
+ * @file   MeshOptimizerTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-14
+ * @brief  Tests of the welding and reordering of the mesh data.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include "engine/subsystems/renderer/mesh/Mesh.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+#include "engine/subsystems/renderer/mesh/MeshOptimizer.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+using Index = MeshOptimizer::Index;
+
+namespace {
+    const ColorRgba white(255, 255, 255, 255);
+
+    /**
+     * @brief Adds a flat grid of quads, every quad adds its own 4 vertices.
+     */
+    void addGrid(ColorMesh& mesh, int size) {
+        for (int x = 0; x < size; x++) {
+            for (int z = 0; z < size; z++) {
+                auto xF = static_cast<float>(x);
+                auto zF = static_cast<float>(z);
+                mesh.addQuad({Position(xF, 0, zF), white},
+                             {Position(xF, 0, zF + 1), white},
+                             {Position(xF + 1, 0, zF + 1), white},
+                             {Position(xF + 1, 0, zF), white});
+            }
+        }
+    }
+
+    bool lessPosition(const Position& a, const Position& b) {
+        return std::make_tuple(a.getX(), a.getY(), a.getZ()) < std::make_tuple(b.getX(), b.getY(), b.getZ());
+    }
+
+    /**
+     * @brief The triangles as sorted lists of their vertices, to compare meshes whose indices were reordered.
+     */
+    std::vector<std::vector<Position>> getTriangles(const ColorMesh& mesh) {
+        std::vector<std::vector<Position>> triangles;
+        const auto& indices = mesh.getIndices();
+        for (size_t index = 0; index < indices.size(); index += 3) {
+            std::vector<Position> triangle;
+            for (size_t corner = 0; corner < 3; corner++) {
+                triangle.push_back(mesh.getVertices()[indices[index + corner]].getPosition());
+            }
+            // Rotate so the triangle starts at its smallest vertex, the winding is preserved
+            auto smallest = std::min_element(triangle.begin(), triangle.end(), lessPosition);
+            std::rotate(triangle.begin(), smallest, triangle.end());
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end(), [](const auto& a, const auto& b) {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), lessPosition);
+        });
+        return triangles;
+    }
+}
+
+TEST(MeshOptimizerTests, ACMROfIsolatedTrianglesIsThree) {
+    const std::vector<Index> indices{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_FLOAT_EQ(MeshOptimizer::computeACMR(indices, 9), 3.0f);
+    // The second triangle reuses two vertices of the first one
+    EXPECT_FLOAT_EQ(MeshOptimizer::computeACMR({0, 1, 2, 2, 1, 3}, 4), 2.0f);
+    EXPECT_FLOAT_EQ(MeshOptimizer::computeACMR({}, 0), 0.0f);
+}
+
+TEST(MeshOptimizerTests, WeldingMergesTheSharedCornersOfTheGrid) {
+    ColorMesh mesh;
+    mesh.startBuilding();
+    addGrid(mesh, 10);
+    mesh.finishBuilding();
+    std::vector<ColorVertex> vertices = mesh.getVertices();
+    std::vector<Index> indices = mesh.getIndices();
+    ASSERT_EQ(vertices.size(), 400u);
+
+    MeshOptimizer::weldVertices(vertices, indices);
+    EXPECT_EQ(vertices.size(), 121u);
+    EXPECT_EQ(indices.size(), mesh.getIndices().size());
+    for (size_t index = 0; index < indices.size(); index++) {
+        EXPECT_EQ(vertices[indices[index]], mesh.getVertices()[mesh.getIndices()[index]]);
+    }
+}
+
+TEST(MeshOptimizerTests, VerticesWithDifferentNormalsAreNotWelded) {
+    // Each face of the cube has its own normal, so its corners can't be shared
+    ColorMesh cube = MeshFactory::cube(white);
+    std::vector<ColorVertex> vertices = cube.getVertices();
+    std::vector<Index> indices = cube.getIndices();
+    MeshOptimizer::weldVertices(vertices, indices);
+    EXPECT_EQ(vertices.size(), cube.getVertices().size());
+}
+
+TEST(MeshOptimizerTests, OptimizationKeepsTheSameTriangles) {
+    ColorMesh mesh;
+    mesh.startBuilding();
+    addGrid(mesh, 12);
+    mesh.attatchMesh(MeshFactory::sphere(10, 10, 3, white));
+    mesh.finishBuilding();
+    ColorMesh optimized = mesh;
+    optimized.startBuilding();
+    optimized.finishBuilding(true);
+
+    EXPECT_EQ(getTriangles(optimized), getTriangles(mesh));
+    ASSERT_EQ(optimized.getFaces().size(), optimized.getIndices().size() / 3);
+    for (size_t face = 0; face < optimized.getFaces().size(); face++) {
+        for (size_t corner = 0; corner < 3; corner++) {
+            EXPECT_EQ(optimized.getFaces()[face][corner], optimized.getIndices()[face * 3 + corner]);
+        }
+    }
+    EXPECT_EQ(optimized.getBoundingVolume().getMin(), mesh.getBoundingVolume().getMin());
+    EXPECT_EQ(optimized.getBoundingVolume().getMax(), mesh.getBoundingVolume().getMax());
+    EXPECT_FALSE(mesh.getOptimizationReport().has_value());
+}
+
+TEST(MeshOptimizerTests, OptimizationReducesTheCacheMisses) {
+    ColorMesh mesh;
+    mesh.startBuilding();
+    addGrid(mesh, 30);
+    mesh.finishBuilding(true);
+
+    ASSERT_TRUE(mesh.getOptimizationReport().has_value());
+    const MeshOptimizer::Report& report = *mesh.getOptimizationReport();
+    EXPECT_EQ(report.verticesBefore, 3600u);
+    EXPECT_EQ(report.verticesAfter, 961u);
+    EXPECT_EQ(report.triangles, 1800u);
+    // Without welding, the 4 vertices of each quad are only shared by its 2 triangles
+    EXPECT_FLOAT_EQ(report.acmrBefore, 2.0f);
+    // A grid can't be below 0.5, a good order with a cache of 16 is well under 1
+    EXPECT_LT(report.acmrAfter, 0.9f);
+    EXPECT_GE(report.acmrAfter, 0.5f);
+    EXPECT_FLOAT_EQ(MeshOptimizer::computeACMR(mesh.getIndices(), mesh.getVertices().size()), report.acmrAfter);
+}
+
+TEST(MeshOptimizerTests, VertexCacheOrderBeatsARandomOrder) {
+    ColorMesh mesh;
+    mesh.startBuilding();
+    addGrid(mesh, 30);
+    mesh.finishBuilding();
+    std::vector<ColorVertex> vertices = mesh.getVertices();
+    std::vector<Index> indices = mesh.getIndices();
+    MeshOptimizer::weldVertices(vertices, indices);
+
+    // Shuffle the triangles
+    std::vector<size_t> order(indices.size() / 3);
+    for (size_t triangle = 0; triangle < order.size(); triangle++) order[triangle] = triangle;
+    std::shuffle(order.begin(), order.end(), std::mt19937(3));
+    std::vector<Index> shuffled;
+    for (size_t triangle : order) {
+        shuffled.insert(shuffled.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3);
+    }
+
+    const float shuffledACMR = MeshOptimizer::computeACMR(shuffled, vertices.size());
+    const std::vector<Index> optimized = MeshOptimizer::optimizeVertexCache(shuffled, vertices.size());
+    ASSERT_EQ(optimized.size(), shuffled.size());
+    EXPECT_LT(MeshOptimizer::computeACMR(optimized, vertices.size()), shuffledACMR * 0.5f);
+
+    // Vertex fetch order, the vertices are used in increasing order
+    std::vector<Index> fetchIndices = optimized;
+    MeshOptimizer::optimizeVertexFetch(vertices, fetchIndices);
+    Index nextNewVertex = 0;
+    for (Index index : fetchIndices) {
+        EXPECT_LE(index, nextNewVertex);
+        if (index == nextNewVertex) nextNewVertex++;
+    }
+    EXPECT_EQ(nextNewVertex, vertices.size());
+}
+#endif
@@ -0,0 +1,219 @@
+/**************************************************************************************************
+ * @file   MeshPrepassTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-02
+ * @brief  Tests and benchmark of the per-mesh matrix and culling stage of the renderer.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include "engine/core/threading/ThreadPool.h"
+#include "engine/subsystems/renderer/MeshPrepass.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+#include "unit/engine/core/math/MathCustomTestingFramework.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+class MeshPrepassTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        cube = meshRegistry.registerMesh(MeshFactory::cube(ColorRgba(255, 255, 255, 255)));
+        projection.makeProjectionMatrix(45.0f, 0.1f, 1000.0f, 800.0f, 600.0f);
+        view.makeViewMatrixPosRot(Position(0, 0, 0), Transform::Rotation(0, 0, 0).toRads());
+        viewProjection = projection * view;
+    }
+
+    /**
+     * @brief Fills the scene with meshes spread in a grid around the camera, so some of them are culled.
+     * @details Each mesh moves up between two updates, the transforms are interpolated halfway.
+     */
+    void createScene(size_t meshCount) {
+        meshes.clear();
+        meshBounds.clear();
+        interpolations.clear();
+        std::vector<Transform::Transform> movedTransforms;
+        for (size_t i = 0; i < meshCount; i++) {
+            Transform::Transform transform;
+            auto x = static_cast<float>(i % 100) - 50.0f;
+            auto z = static_cast<float>(i / 100 % 100) - 50.0f;
+            transform.setPosition(Transform::Position(x, 0, z));
+            transform.setRotation(Transform::Rotation(0, static_cast<float>(i % 360), 0));
+            const auto handle = static_cast<RenderHandle>(i);
+            interpolations.push(handle, transform);
+            Math::BoundingVolume::AABB bounds = worldBounds(transform);
+            transform.addPosition(Transform::Position(0, 1, 0));
+            movedTransforms.push_back(transform);
+            bounds = bounds.combine(worldBounds(transform));
+            const Math::AABBTree::ProxyId proxyId = meshBounds.createProxy(bounds, meshes.size());
+            meshes.push_back({cube, Material(), handle, nullptr, proxyId});
+        }
+        interpolations.nextUpdate();
+        for (size_t i = 0; i < meshCount; i++) {
+            interpolations.push(static_cast<RenderHandle>(i), movedTransforms[i]);
+        }
+        interpolations.interpolate(0.5f, transforms);
+    }
+
+    /**
+     * @brief The model matrix of a mesh halfway between its two updates.
+     */
+    [[nodiscard]] Model interpolatedModel(size_t meshIndex) const {
+        const Transform::Pose pose = interpolations.interpolate(meshes[meshIndex].transformHandle, 0.5f);
+        Model model;
+        model.makeModelMatrix(pose.position, pose.orientation, pose.scale);
+        return model;
+    }
+
+    [[nodiscard]] Math::BoundingVolume::AABB worldBounds(const Transform::Transform& transform) const {
+        return Transform::Transformer::transformBoundingVolume(cube->getBoundingVolume(), transform)
+            .getBoundingBox();
+    }
+
+    void runPrepass(MeshPrepass& prepass, ThreadPool& workers) const {
+        Frustum frustum(viewProjection);
+        prepass.run(meshes, transforms, meshBounds, view, projection, viewProjection, frustum, workers);
+    }
+
+    MeshRegistry meshRegistry;
+    MeshHandle cube;
+    Projection projection;
+    View view;
+    VP viewProjection;
+    std::vector<MeshRenderData> meshes;
+    Transform::InterpolationStore interpolations;
+    Transform::TransformStore transforms;
+    Math::AABBTree meshBounds;
+};
+
+TEST(ThreadPoolTests, ParallelForVisitsEveryIndexOnce) {
+    for (size_t threadCount : {1u, 2u, 3u, 8u}) {
+        ThreadPool pool(threadCount);
+        EXPECT_EQ(pool.getThreadCount(), threadCount);
+        for (size_t count : {0u, 1u, 7u, 1000u}) {
+            std::vector<std::atomic<int>> visits(count);
+            pool.parallelFor(count, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    visits[i]++;
+                }
+            });
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(visits[i].load(), 1) << "Index " << i << " with " << threadCount << " threads";
+            }
+        }
+    }
+}
+
+TEST(ThreadPoolTests, ParallelForRethrowsExceptions) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallelFor(100, [](size_t /*begin*/, size_t end) {
+                     if (end == 100) throw std::runtime_error("Last chunk failed");
+                 }), std::runtime_error);
+    // The pool must still be usable after an exception
+    std::atomic<size_t> processed{0};
+    pool.parallelFor(100, [&](size_t begin, size_t end) { processed += end - begin; });
+    EXPECT_EQ(processed.load(), 100u);
+}
+
+TEST_F(MeshPrepassTests, ParallelResultsMatchSerial) {
+    createScene(1000);
+    ThreadPool serialWorkers(1);
+    ThreadPool parallelWorkers(4);
+    MeshPrepass serialPrepass;
+    MeshPrepass parallelPrepass;
+    runPrepass(serialPrepass, serialWorkers);
+    runPrepass(parallelPrepass, parallelWorkers);
+
+    ASSERT_EQ(serialPrepass.size(), meshes.size());
+    ASSERT_EQ(parallelPrepass.size(), meshes.size());
+    size_t visibleCount = 0;
+    for (size_t i = 0; i < meshes.size(); i++) {
+        EXPECT_EQ(parallelPrepass.isVisible(i), serialPrepass.isVisible(i));
+        if (!serialPrepass.isVisible(i)) continue;
+        EXPECT_EQ_MAT(parallelPrepass.getMVs()[i], serialPrepass.getMVs()[i]);
+        EXPECT_EQ_MAT(parallelPrepass.getMVPs()[i], serialPrepass.getMVPs()[i]);
+        EXPECT_EQ_MAT(parallelPrepass.getNormalMats()[i], serialPrepass.getNormalMats()[i]);
+        visibleCount++;
+    }
+    EXPECT_EQ(serialPrepass.getVisibleCount(), visibleCount);
+    // The camera looks at -z from the middle of the grid, it can't see everything
+    EXPECT_GT(visibleCount, 0u);
+    EXPECT_LT(visibleCount, meshes.size());
+}
+
+TEST_F(MeshPrepassTests, ResultsAreIndexedLikeTheInput) {
+    createScene(64);
+    ThreadPool workers(4);
+    MeshPrepass prepass;
+    runPrepass(prepass, workers);
+    ASSERT_GT(prepass.getVisibleCount(), 0u);
+    for (size_t i = 0; i < meshes.size(); i++) {
+        if (!prepass.isVisible(i)) continue;
+        EXPECT_EQ_MAT(prepass.getMVs()[i], view * interpolatedModel(i));
+    }
+    prepass.clear();
+    EXPECT_EQ(prepass.size(), 0u);
+}
+
+TEST_F(MeshPrepassTests, NoMeshInsideTheFrustumIsCulled) {
+    createScene(1000);
+    ThreadPool workers(1);
+    MeshPrepass prepass;
+    runPrepass(prepass, workers);
+
+    Frustum frustum(viewProjection);
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const Transform::Pose pose = interpolations.interpolate(meshes[i].transformHandle, 0.5f);
+        Transform::Transform interpolated;
+        interpolated.setPosition(pose.position);
+        interpolated.setOrientation(pose.orientation);
+        interpolated.setScale(pose.scale);
+        if (frustum.contains(Transform::Transformer::transformBoundingVolume(cube->getBoundingVolume(),
+                                                                             interpolated))) {
+            EXPECT_TRUE(prepass.isVisible(i)) << "Mesh " << i << " is inside the frustum but was culled";
+        }
+    }
+    // The hierarchy must avoid testing every mesh
+    const Math::AABBTree::QueryStats& stats = prepass.getCullingStats();
+    EXPECT_LE(prepass.getVisibleCount(), stats.visitedLeaves + stats.deferredLeaves);
+    EXPECT_GT(stats.rejectedNodes + stats.acceptedSubtrees, 0u);
+}
+
+#if RENDERING_BENCHMARKING
+TEST_F(MeshPrepassTests, BenchmarkThreadScaling) {
+    constexpr size_t meshCount = 10000;
+    constexpr int iterations = 10;
+    createScene(meshCount);
+    MeshPrepass prepass;
+
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> threadCounts;
+    for (size_t threadCount = 1; threadCount < maxThreads; threadCount *= 2) {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(maxThreads);
+
+    double serialMillis = 0.0;
+    for (size_t threadCount : threadCounts) {
+        ThreadPool workers(threadCount);
+        runPrepass(prepass, workers); // Warm up, allocates the slots
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            runPrepass(prepass, workers);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double millis = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+        if (threadCount == 1) serialMillis = millis;
+        std::cout << "MeshPrepass " << meshCount << " meshes, " << threadCount << " threads: " << millis
+                  << " ms/frame, speedup x" << serialMillis / millis << "\n";
+    }
+}
+#endif
+#endif
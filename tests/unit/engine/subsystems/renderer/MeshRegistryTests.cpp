@@ -0,0 +1,119 @@
+/**************************************************************************************************
+ * @file   MeshRegistryTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-12
+ * @brief  Tests of the shared storage of the meshes.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include "engine/subsystems/renderer/RenderSnapshot.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    const ColorRgba white(255, 255, 255, 255);
+
+    ColorMesh createTriangles(size_t triangleCount) {
+        ColorMesh mesh;
+        mesh.startBuilding();
+        for (size_t i = 0; i < triangleCount; i++) {
+            auto x = static_cast<float>(i);
+            mesh.addTris({Position(x, 0, 0), white}, {Position(x + 1, 0, 0), white}, {Position(x, 1, 0), white});
+        }
+        mesh.finishBuilding();
+        return mesh;
+    }
+}
+
+TEST(MeshRegistryTests, EqualMeshesAreStoredOnce) {
+    MeshRegistry registry;
+    const ColorMesh cube = MeshFactory::cube(white);
+    std::vector<MeshHandle> handles;
+    for (int i = 0; i < 100; i++) {
+        handles.push_back(registry.registerMesh(MeshFactory::cube(white)));
+    }
+    for (const MeshHandle& handle : handles) {
+        EXPECT_EQ(handle, handles.front());
+    }
+
+    MeshRegistry::Stats stats = registry.getStats();
+    EXPECT_EQ(stats.uniqueMeshes, 1u);
+    EXPECT_EQ(stats.references, 100u);
+    const size_t meshBytes = cube.getVertices().size() * sizeof(ColorVertex) +
+        cube.getIndices().size() * sizeof(ColorMesh::Index) + cube.getFaces().size() * sizeof(Math::FaceIndices);
+    EXPECT_EQ(stats.cpuBytes, meshBytes);
+    // Nothing is uploaded until the render side asks for it
+    EXPECT_EQ(stats.gpuBytes, 0u);
+    EXPECT_EQ(stats.uploads, 0u);
+}
+
+TEST(MeshRegistryTests, DifferentMeshesAreStoredSeparately) {
+    MeshRegistry registry;
+    MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    MeshHandle redCube = registry.registerMesh(MeshFactory::cube(ColorRgba(255, 0, 0, 255)));
+    MeshHandle sphere = registry.registerMesh(MeshFactory::sphere(8, 8, 1, white));
+    ColorMesh instancedCube = MeshFactory::cube(white);
+    instancedCube.setRenderType(RenderType::InstancedDynamic);
+    MeshHandle instanced = registry.registerMesh(instancedCube);
+
+    EXPECT_NE(cube, redCube);
+    EXPECT_NE(cube, sphere);
+    EXPECT_NE(cube, instanced);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 4u);
+    EXPECT_EQ(instanced->getRenderType(), RenderType::InstancedDynamic);
+}
+
+TEST(MeshRegistryTests, RebuiltMeshIsFoundByItsNewContent) {
+    MeshRegistry registry;
+    ColorMesh mesh = createTriangles(2);
+    MeshHandle first = registry.registerMesh(mesh);
+    // The same mesh object is rebuilt with other content, its hash must not be the one of the old content
+    mesh.startBuilding();
+    mesh.addTris({Position(5, 0, 0), white}, {Position(6, 0, 0), white}, {Position(5, 1, 0), white});
+    mesh.finishBuilding();
+    MeshHandle second = registry.registerMesh(mesh);
+    ColorMesh sameContent = createTriangles(2);
+    sameContent.startBuilding();
+    sameContent.addTris({Position(5, 0, 0), white}, {Position(6, 0, 0), white}, {Position(5, 1, 0), white});
+    sameContent.finishBuilding();
+    MeshHandle third = registry.registerMesh(sameContent);
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(second, third);
+    EXPECT_EQ(second->getIndices().size(), 9u);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 2u);
+}
+
+TEST(MeshRegistryTests, OnlyUnreferencedMeshesAreReleased) {
+    MeshRegistry registry;
+    MeshHandle kept = registry.registerMesh(createTriangles(1));
+    RenderSnapshot snapshot;
+    {
+        MeshHandle destroyed = registry.registerMesh(createTriangles(2));
+        MeshHandle inSnapshot = registry.registerMesh(createTriangles(3));
+        snapshot.meshes.push_back({inSnapshot, Material(), 0, nullptr, Math::AABBTree::nullNode});
+    }
+    EXPECT_EQ(registry.getStats().references, 2u);
+
+    EXPECT_EQ(registry.releaseUnusedMeshes(), 1u);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 2u);
+    // The snapshot keeps its mesh alive until it's cleared
+    EXPECT_EQ(snapshot.meshes.front().mesh->getIndices().size(), 9u);
+
+    snapshot.clear();
+    EXPECT_EQ(registry.releaseUnusedMeshes(), 1u);
+    MeshRegistry::Stats stats = registry.getStats();
+    EXPECT_EQ(stats.uniqueMeshes, 1u);
+    EXPECT_EQ(stats.references, 1u);
+    EXPECT_EQ(stats.cpuBytes, 3 * sizeof(ColorVertex) + 3 * sizeof(ColorMesh::Index) + sizeof(Math::FaceIndices));
+    EXPECT_EQ(kept->getIndices().size(), 3u);
+}
+#endif
@@ -0,0 +1,187 @@
+/**************************************************************************************************
+ * @file   ModelImporterTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-19
+ * @brief  Tests of the conversion of the models to engine meshes.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "engine/res-mng/models/ModelImporter.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    const ColorRgba red(255, 0, 0, 255);
+
+    /**
+     * @brief Creates a quad in the plane y = 0, from (0, 0) to (2, 3), as Assimp would read it.
+     */
+    std::unique_ptr<aiMesh> createAssimpQuad(bool withNormals, bool withColors) {
+        auto mesh = std::make_unique<aiMesh>();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 4;
+        mesh->mVertices = new aiVector3D[4]{{0, 0, 0}, {0, 0, 3}, {2, 0, 3}, {2, 0, 0}};
+        if (withNormals) {
+            mesh->mNormals = new aiVector3D[4]{{0, 1, 0}, {0, 1, 0}, {0, 1, 0}, {0, 1, 0}};
+        }
+        if (withColors) {
+            mesh->mColors[0] = new aiColor4D[4]{{0, 0, 1, 1}, {0, 0, 1, 1}, {0, 1, 0, 1}, {0, 1, 0, 1}};
+        }
+        const unsigned int faces[2][3] = {{0, 1, 2}, {0, 2, 3}};
+        mesh->mNumFaces = 2;
+        mesh->mFaces = new aiFace[2];
+        for (unsigned int face = 0; face < 2; face++) {
+            mesh->mFaces[face].mNumIndices = 3;
+            mesh->mFaces[face].mIndices = new unsigned int[3]{faces[face][0], faces[face][1], faces[face][2]};
+        }
+        return mesh;
+    }
+}
+
+TEST(ModelImporterTests, MeshesAreConverted) {
+    std::unique_ptr<aiMesh> assimpMesh = createAssimpQuad(true, true);
+    std::optional<ColorMesh> mesh = ModelImporter::convertMesh(*assimpMesh, red);
+    ASSERT_TRUE(mesh.has_value());
+    EXPECT_FALSE(mesh->isBeingBuilt());
+    ASSERT_EQ(mesh->getVertices().size(), 4u);
+    EXPECT_EQ(mesh->getIndices(), (std::vector<ColorMesh::Index>{0, 1, 2, 0, 2, 3}));
+    EXPECT_EQ(mesh->getFaces().size(), 2u);
+    EXPECT_EQ(mesh->getVertices()[2].getPosition(), Position(2, 0, 3));
+    EXPECT_EQ(mesh->getVertices()[2].getNormal(), Normal(0, 1, 0));
+    // The colors of the vertices are used instead of the color of the material
+    EXPECT_EQ(mesh->getVertices()[0].getColor(), ColorRgbaNorm(ColorRgba(0, 0, 255, 255)));
+    EXPECT_EQ(mesh->getVertices()[3].getColor(), ColorRgbaNorm(ColorRgba(0, 255, 0, 255)));
+    EXPECT_EQ(mesh->getBoundingVolume().getMin(), Position(0, 0, 0));
+    EXPECT_EQ(mesh->getBoundingVolume().getMax(), Position(2, 0, 3));
+}
+
+TEST(ModelImporterTests, MissingAttributesAreFilled) {
+    std::unique_ptr<aiMesh> assimpMesh = createAssimpQuad(false, false);
+    std::optional<ColorMesh> mesh = ModelImporter::convertMesh(*assimpMesh, red);
+    ASSERT_TRUE(mesh.has_value());
+    for (const ColorVertex& vertex : mesh->getVertices()) {
+        // Counter-clockwise seen from above
+        EXPECT_EQ(vertex.getNormal(), Normal(0, 1, 0));
+        EXPECT_EQ(vertex.getColor(), ColorRgbaNorm(red));
+    }
+
+    // Points and lines are not converted
+    assimpMesh->mFaces[0].mNumIndices = 2;
+    assimpMesh->mFaces[1].mNumIndices = 1;
+    EXPECT_FALSE(ModelImporter::convertMesh(*assimpMesh, red).has_value());
+}
+
+class ModelImporterFilesTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path() / "glesc-model-importer-tests";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    /**
+     * @brief Writes a model with two objects: a quad and a triangle, each one is a mesh.
+     */
+    std::string writeModel(const std::string& name) const {
+        const std::string path = (directory / name).string();
+        std::ofstream file(path);
+        file << "o quad\n"
+            "v 0 0 0\nv 0 0 3\nv 2 0 3\nv 2 0 0\n"
+            "f 1 2 3 4\n"
+            "o triangle\n"
+            "v 5 1 5\nv 6 1 5\nv 5 2 5\n"
+            "f 5 6 7\n";
+        return path;
+    }
+
+    static std::vector<ModelImporter::ImportedMesh> sortByIndex(std::vector<ModelImporter::ImportedMesh> meshes) {
+        std::sort(meshes.begin(), meshes.end(), [](const auto& first, const auto& second) {
+            return first.meshIndex < second.meshIndex;
+        });
+        return meshes;
+    }
+
+    std::filesystem::path directory;
+};
+
+TEST_F(ModelImporterFilesTests, ModelsAreImportedInBackground) {
+    MeshRegistry registry;
+    MeshCache cache((directory / "cache").string());
+    ModelImporter importer(registry, &cache, 2);
+    EXPECT_EQ(importer.getWorkerCount(), 2u);
+    const std::string path = writeModel("model.obj");
+    importer.importModel(path);
+    importer.importModel((directory / "missing.obj").string());
+    importer.waitUntilIdle();
+    EXPECT_TRUE(importer.isIdle());
+
+    const std::vector<ModelImporter::ImportedMesh> meshes = sortByIndex(importer.collectImported());
+    ASSERT_EQ(meshes.size(), 2u);
+    EXPECT_EQ(meshes[0].path, path);
+    EXPECT_EQ(meshes[0].meshIndex, 0u);
+    EXPECT_EQ(meshes[0].mesh->getIndices().size(), 6u);
+    EXPECT_EQ(meshes[0].mesh->getBoundingVolume().getMax(), Position(2, 0, 3));
+    EXPECT_EQ(meshes[1].mesh->getIndices().size(), 3u);
+    EXPECT_EQ(meshes[1].mesh->getBoundingVolume().getMin(), Position(5, 1, 5));
+    // The meshes are collected once
+    EXPECT_TRUE(importer.collectImported().empty());
+
+    const ModelImporter::Stats stats = importer.getStats();
+    EXPECT_EQ(stats.pendingModels, 0u);
+    EXPECT_EQ(stats.importedModels, 1u);
+    EXPECT_EQ(stats.failedModels, 1u);
+    EXPECT_EQ(stats.importedMeshes, 2u);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 2u);
+}
+
+TEST_F(ModelImporterFilesTests, ImportedModelsAreCached) {
+    MeshCache cache((directory / "cache").string());
+    const std::string path = writeModel("model.obj");
+    std::vector<ModelImporter::ImportedMesh> imported;
+    {
+        MeshRegistry registry;
+        ModelImporter importer(registry, &cache, 1);
+        importer.importModel(path);
+        importer.waitUntilIdle();
+        imported = sortByIndex(importer.collectImported());
+        EXPECT_EQ(importer.getStats().cachedModels, 0u);
+    }
+
+    MeshRegistry registry;
+    ModelImporter importer(registry, &cache, 1);
+    importer.importModel(path);
+    importer.waitUntilIdle();
+    const std::vector<ModelImporter::ImportedMesh> cached = sortByIndex(importer.collectImported());
+    EXPECT_EQ(importer.getStats().cachedModels, 1u);
+    EXPECT_EQ(importer.getStats().readMillis, 0.0);
+    ASSERT_EQ(cached.size(), imported.size());
+    for (size_t index = 0; index < cached.size(); index++) {
+        EXPECT_EQ(cached[index].meshIndex, imported[index].meshIndex);
+        EXPECT_EQ(cached[index].mesh->getIndices(), imported[index].mesh->getIndices());
+        EXPECT_EQ(cached[index].mesh->getVertices().size(), imported[index].mesh->getVertices().size());
+    }
+
+    // A changed file is imported again
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "v 9 9 9\n";
+    }
+    importer.importModel(path);
+    importer.waitUntilIdle();
+    EXPECT_EQ(importer.getStats().cachedModels, 1u);
+    EXPECT_EQ(importer.collectImported().size(), 2u);
+}
+#endif
@@ -0,0 +1,139 @@
+/**************************************************************************************************
+ * @file   RenderSnapshotTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-04
+ * @brief  Tests of the exchange of render snapshots between the update and the render side.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <thread>
+#include "engine/subsystems/renderer/RenderSnapshot.h"
+
+using namespace GLESC::Render;
+
+namespace {
+    void fillSnapshot(RenderSnapshot& snapshot, size_t lightCount) {
+        snapshot.clear();
+        for (size_t i = 0; i < lightCount; i++) {
+            snapshot.lights.push_back(LightRenderData());
+        }
+    }
+}
+
+TEST(RenderSnapshotTests, NothingToAcquireBeforePublishing) {
+    RenderSnapshotExchange exchange;
+    RenderSnapshot reading;
+    EXPECT_FALSE(exchange.acquire(reading));
+}
+
+TEST(RenderSnapshotTests, AcquireReturnsThePublishedSnapshotOnce) {
+    RenderSnapshotExchange exchange;
+    RenderSnapshot writing;
+    RenderSnapshot reading;
+    fillSnapshot(writing, 3);
+    exchange.publish(writing);
+
+    ASSERT_TRUE(exchange.acquire(reading));
+    EXPECT_EQ(reading.lights.size(), 3u);
+    // Nothing new was published, the render side keeps the snapshot it has
+    EXPECT_FALSE(exchange.acquire(reading));
+    EXPECT_EQ(reading.lights.size(), 3u);
+}
+
+TEST(RenderSnapshotTests, OnlyTheLatestSnapshotIsAcquired) {
+    RenderSnapshotExchange exchange;
+    RenderSnapshot writing;
+    RenderSnapshot reading;
+    fillSnapshot(writing, 1);
+    exchange.publish(writing);
+    fillSnapshot(writing, 2);
+    exchange.publish(writing);
+
+    ASSERT_TRUE(exchange.acquire(reading));
+    EXPECT_EQ(reading.lights.size(), 2u);
+}
+
+TEST(RenderSnapshotTests, RemovedObjectsArePurgedFromThePublishedSnapshot) {
+    RenderSnapshotExchange exchange;
+    RenderSnapshot writing;
+    RenderSnapshot reading;
+    for (RenderHandle handle : {1u, 2u, 1u}) {
+        MeshRenderData mesh;
+        mesh.transformHandle = handle;
+        mesh.cullingProxy = writing.meshBounds.createProxy(GLESC::Math::AABBTree::AABB(), writing.meshes.size());
+        writing.meshes.push_back(mesh);
+        writing.lights.push_back({LightPoint(), handle});
+    }
+    writing.meshBoundsVersion = 3;
+    exchange.publish(writing);
+    exchange.removeObject(1);
+
+    ASSERT_TRUE(exchange.acquire(reading));
+    ASSERT_EQ(reading.meshes.size(), 1u);
+    EXPECT_EQ(reading.meshes[0].transformHandle, 2u);
+    EXPECT_EQ(reading.meshBounds.getProxyCount(), 1u);
+    EXPECT_EQ(reading.meshBounds.getUserData(reading.meshes[0].cullingProxy), 0u);
+    EXPECT_EQ(reading.meshBoundsVersion, 0u) << "The bounds must be copied again when the snapshot is reused";
+    ASSERT_EQ(reading.lights.size(), 1u);
+    EXPECT_EQ(reading.lights[0].transformHandle, 2u);
+    EXPECT_TRUE(reading.lights[0].light.isDirty()) << "The light moved to another uniform, it must be uploaded";
+}
+
+TEST(RenderSnapshotTests, ClearKeepsTheMeshBounds) {
+    RenderSnapshot snapshot;
+    snapshot.meshes.push_back(MeshRenderData());
+    snapshot.meshes[0].cullingProxy = snapshot.meshBounds.createProxy(GLESC::Math::AABBTree::AABB(), 0);
+    snapshot.meshBoundsVersion = 3;
+    snapshot.clear();
+    EXPECT_TRUE(snapshot.meshes.empty());
+    EXPECT_EQ(snapshot.meshBounds.getProxyCount(), 1u);
+    EXPECT_EQ(snapshot.meshBoundsVersion, 3u);
+}
+
+TEST(RenderSnapshotTests, ChangesOfSkippedSnapshotsAreKept) {
+    RenderSnapshotExchange exchange;
+    RenderSnapshot writing;
+    RenderSnapshot reading;
+    fillSnapshot(writing, 2);
+    writing.lights[1].light.setClean();
+    exchange.publish(writing);
+    // The second snapshot replaces the first before it's rendered, the lights didn't change in between
+    fillSnapshot(writing, 2);
+    writing.lights[0].light.setClean();
+    writing.lights[1].light.setClean();
+    exchange.publish(writing);
+
+    ASSERT_TRUE(exchange.acquire(reading));
+    EXPECT_TRUE(reading.lights[0].light.isDirty());
+    EXPECT_FALSE(reading.lights[1].light.isDirty());
+}
+
+TEST(RenderSnapshotTests, SidesNeverShareASnapshot) {
+    RenderSnapshotExchange exchange;
+    constexpr size_t snapshotCount = 200;
+    std::thread renderSide([&exchange] {
+        RenderSnapshot reading;
+        size_t lastAcquired = 0;
+        while (lastAcquired < snapshotCount) {
+            if (!exchange.acquire(reading)) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Each snapshot is filled with as many lights as its number, it must arrive complete and in order
+            EXPECT_GT(reading.lights.size(), lastAcquired);
+            lastAcquired = reading.lights.size();
+        }
+    });
+    RenderSnapshot writing;
+    for (size_t i = 1; i <= snapshotCount; i++) {
+        fillSnapshot(writing, i);
+        exchange.publish(writing);
+    }
+    renderSide.join();
+}
+#endif
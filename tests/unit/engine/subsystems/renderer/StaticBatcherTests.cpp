@@ -0,0 +1,208 @@
+/**************************************************************************************************
+ * @file   StaticBatcherTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-20
+ * @brief  Tests of the merging of the static meshes into world space clusters.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include "engine/subsystems/renderer/StaticBatcher.h"
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    const ColorRgba white(255, 255, 255, 255);
+
+    Transform::Transform createTransform(const Transform::Position& position) {
+        Transform::Transform transform;
+        transform.setPosition(position);
+        return transform;
+    }
+
+    size_t countObjects(const StaticBatches& batches) {
+        size_t objects = 0;
+        for (const StaticCluster& cluster : batches.clusters) {
+            objects += cluster.objectCount;
+        }
+        return objects;
+    }
+}
+
+TEST(StaticBatcherTests, BakedVerticesAreInWorldSpace) {
+    ColorMesh mesh;
+    mesh.startBuilding();
+    mesh.addTris({Position(0, 0, 0), white}, {Position(1, 0, 0), white}, {Position(0, 1, 0), white});
+    mesh.finishBuilding();
+
+    Transform::Transform transform;
+    transform.setPosition(Transform::Position(10, 0, 0));
+    transform.setRotation(Transform::Rotation(0, 90, 0));
+    transform.setScale(Transform::Scale(2, 2, 2));
+    const Model model = transform.getModelMatrix();
+
+    std::vector<ColorVertex> vertices{mesh.getVertices().front()};
+    std::vector<ColorMesh::Index> indices;
+    StaticBatcher::bake(mesh, model, vertices, indices);
+    ASSERT_EQ(vertices.size(), 4u);
+    ASSERT_EQ(indices.size(), 3u);
+    // The indices are rebased to the vertices already in the buffer
+    for (size_t index = 0; index < indices.size(); index++) {
+        EXPECT_EQ(indices[index], mesh.getIndices()[index] + 1);
+    }
+    NormalMat normalMat;
+    normalMat.makeNormalMatrix(model);
+    for (size_t vertex = 0; vertex < mesh.getVertices().size(); vertex++) {
+        const Position& position = mesh.getVertices()[vertex].getPosition();
+        const Vec4F expected = model * Vec4F(position.getX(), position.getY(), position.getZ(), 1.0f);
+        const ColorVertex& baked = vertices[vertex + 1];
+        EXPECT_NEAR(baked.getPosition().getX(), expected.getX(), 1e-4f);
+        EXPECT_NEAR(baked.getPosition().getY(), expected.getY(), 1e-4f);
+        EXPECT_NEAR(baked.getPosition().getZ(), expected.getZ(), 1e-4f);
+        // The normals are rotated but not scaled
+        const Normal expectedNormal = (normalMat * mesh.getVertices()[vertex].getNormal()).normalize();
+        EXPECT_NEAR(baked.getNormal().length(), 1.0f, 1e-4f);
+        EXPECT_NEAR(baked.getNormal().dot(expectedNormal), 1.0f, 1e-4f);
+        EXPECT_EQ(baked.getColor(), mesh.getVertices()[vertex].getColor());
+    }
+}
+
+TEST(StaticBatcherTests, ObjectsAreGroupedByCellAndMaterial) {
+    MeshRegistry registry;
+    StaticBatcher batcher(registry, 16.0f);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    Material red;
+    red.setDiffuseColor(ColorRgb(255, 0, 0));
+
+    const Transform::Transform first = createTransform(Transform::Position(2, 2, 2));
+    const Transform::Transform sameCell = createTransform(Transform::Position(6, 2, 2));
+    const Transform::Transform otherCell = createTransform(Transform::Position(40, 2, 2));
+    const Transform::Transform otherMaterial = createTransform(Transform::Position(4, 2, 2));
+    batcher.submit(0, cube, Material(), first);
+    batcher.submit(1, cube, Material(), sameCell);
+    batcher.submit(2, cube, Material(), otherCell);
+    batcher.submit(3, cube, red, otherMaterial);
+    const std::shared_ptr<const StaticBatches> batches = batcher.finishUpdate();
+
+    ASSERT_EQ(batches->clusters.size(), 3u);
+    ASSERT_EQ(batches->bounds.size(), 3u);
+    EXPECT_EQ(countObjects(*batches), 4u);
+    size_t redClusters = 0;
+    for (size_t cluster = 0; cluster < batches->clusters.size(); cluster++) {
+        const StaticCluster& staticCluster = batches->clusters[cluster];
+        if (staticCluster.material == red) {
+            redClusters++;
+            EXPECT_EQ(staticCluster.objectCount, 1u);
+        }
+        EXPECT_EQ(staticCluster.mesh->getVertices().size(), cube->getVertices().size() * staticCluster.objectCount);
+        // The bounds are the world bounds of the merged objects
+        const Math::BoundingVolume::AABB bounds = staticCluster.mesh->getBoundingVolume().getBoundingBox();
+        EXPECT_EQ(batches->bounds.minX[cluster], bounds.min.getX());
+        EXPECT_EQ(batches->bounds.maxX[cluster], bounds.max.getX());
+    }
+    EXPECT_EQ(redClusters, 1u);
+
+    const StaticBatcher::Stats stats = batcher.getStats();
+    EXPECT_EQ(stats.objects, 4u);
+    EXPECT_EQ(stats.clusters, 3u);
+    EXPECT_EQ(stats.vertices, cube->getVertices().size() * 4);
+    EXPECT_EQ(stats.rebuiltGroups, 3u);
+}
+
+TEST(StaticBatcherTests, ClustersAreSplitByTheVertexLimit) {
+    MeshRegistry registry;
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    StaticBatcher batcher(registry, 1000.0f, cube->getVertices().size() * 2);
+
+    std::vector<Transform::Transform> transforms;
+    for (int object = 0; object < 5; object++) {
+        transforms.push_back(createTransform(Transform::Position(static_cast<float>(object) * 3.0f, 0, 0)));
+    }
+    for (size_t object = 0; object < transforms.size(); object++) {
+        batcher.submit(static_cast<RenderHandle>(object), cube, Material(), transforms[object]);
+    }
+    const std::shared_ptr<const StaticBatches> batches = batcher.finishUpdate();
+    ASSERT_EQ(batches->clusters.size(), 3u);
+    EXPECT_EQ(countObjects(*batches), 5u);
+    for (const StaticCluster& cluster : batches->clusters) {
+        EXPECT_LE(cluster.mesh->getVertices().size(), cube->getVertices().size() * 2);
+        EXPECT_EQ(cluster.mesh->getRenderType(), RenderType::SingleDrawStatic);
+    }
+}
+
+TEST(StaticBatcherTests, CompactMeshesAreQuantizedRelativeToTheCluster) {
+    MeshRegistry registry;
+    StaticBatcher batcher(registry, 16.0f);
+    ColorMesh compactCube = MeshFactory::cube(white);
+    compactCube.setVertexFormat(VertexFormat::Compact);
+    const MeshHandle cube = registry.registerMesh(compactCube);
+    // Far from the origin, where the half floats are only precise to several units
+    const Transform::Transform farAway = createTransform(Transform::Position(5000, 0, 0));
+    batcher.submit(0, cube, Material(), farAway);
+    const std::shared_ptr<const StaticBatches> batches = batcher.finishUpdate();
+
+    ASSERT_EQ(batches->clusters.size(), 1u);
+    EXPECT_EQ(batches->clusters[0].mesh->getVertexFormat(), VertexFormat::Quantized);
+}
+
+TEST(StaticBatcherTests, ClustersAreOnlyRebuiltWhenTheObjectsChange) {
+    MeshRegistry registry;
+    StaticBatcher batcher(registry, 16.0f);
+    const MeshHandle cube = registry.registerMesh(MeshFactory::cube(white));
+    Transform::Transform first = createTransform(Transform::Position(2, 2, 2));
+    const Transform::Transform second = createTransform(Transform::Position(40, 2, 2));
+    auto update = [&](bool submitSecond) {
+        batcher.submit(0, cube, Material(), first);
+        if (submitSecond) batcher.submit(1, cube, Material(), second);
+        return batcher.finishUpdate();
+    };
+
+    const std::shared_ptr<const StaticBatches> initial = update(true);
+    EXPECT_EQ(batcher.getStats().rebuiltGroups, 2u);
+    // Submitting the same objects keeps the batches
+    EXPECT_EQ(update(true), initial);
+    EXPECT_EQ(batcher.getStats().rebuiltGroups, 2u);
+    // The objects are identified by their handles, a transform moved to another address is the same object
+    const Transform::Transform relocatedFirst = first;
+    batcher.submit(0, cube, Material(), relocatedFirst);
+    batcher.submit(1, cube, Material(), second);
+    EXPECT_EQ(batcher.finishUpdate(), initial);
+    EXPECT_EQ(batcher.getStats().rebuiltGroups, 2u);
+
+    // Moving an object inside its cell only rebuilds its group
+    first.setPosition(Transform::Position(3, 2, 2));
+    const std::shared_ptr<const StaticBatches> moved = update(true);
+    EXPECT_NE(moved, initial);
+    EXPECT_EQ(batcher.getStats().rebuiltGroups, 3u);
+    ASSERT_EQ(moved->clusters.size(), 2u);
+    // The batches of the previous update are immutable, they can still be drawn by the render side
+    EXPECT_EQ(initial->clusters.size(), 2u);
+
+    // The objects not submitted in an update are removed
+    const std::shared_ptr<const StaticBatches> removed = update(false);
+    EXPECT_EQ(batcher.getStats().rebuiltGroups, 4u);
+    ASSERT_EQ(removed->clusters.size(), 1u);
+    EXPECT_EQ(batcher.getStats().objects, 1u);
+
+    batcher.remove(0);
+    EXPECT_TRUE(batcher.finishUpdate()->clusters.empty());
+    EXPECT_EQ(batcher.getStats().objects, 0u);
+}
+
+TEST(StaticBatcherTests, BatchedMeshesAreNotUploaded) {
+    MeshRegistry registry;
+    ColorMesh mesh = MeshFactory::cube(white);
+    mesh.setRenderType(RenderType::BatchedStatic);
+    const MeshHandle batched = registry.registerMesh(mesh);
+    // No graphic context is needed, nothing is sent to the GPU
+    registry.uploadPendingMeshes();
+    EXPECT_EQ(registry.getStats().uploads, 0u);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 1u);
+}
+#endif
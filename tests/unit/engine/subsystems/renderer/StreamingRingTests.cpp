@@ -0,0 +1,105 @@
+/**************************************************************************************************
+ * @file   StreamingRingTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-22
+ * @brief  Tests of the persistently mapped ring the per-frame data is uploaded through.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <cstring>
+#include <gtest/gtest.h>
+#include "engine/core/exceptions/core/low-level-renderer/GAPIException.h"
+#include "engine/core/low-level-renderer/buffers/StreamingRing.h"
+#include "engine/core/low-level-renderer/graphic-api/concrete-apis/recording/RecordingAPI.h"
+
+using namespace GLESC::GAPI;
+
+TEST(StreamingRingTests, AllocationsAreAlignedInsideTheRegionOfTheFrame) {
+    RecordingAPI gapi;
+    StreamingRing ring(gapi, 1000);
+
+    const StreamingRing::Allocation first = ring.allocate(10, 4);
+    const StreamingRing::Allocation second = ring.allocate(100, 256);
+    const StreamingRing::Allocation third = ring.allocate(20, 20);
+    ASSERT_TRUE(first.isValid());
+    ASSERT_TRUE(second.isValid());
+    ASSERT_TRUE(third.isValid());
+    EXPECT_EQ(first.offset, 0u);
+    EXPECT_EQ(second.offset, 256u);
+    EXPECT_EQ(third.offset, 360u);
+    EXPECT_EQ(ring.getUsedBytes(), 380u);
+    // The region is full even if the other regions aren't
+    EXPECT_FALSE(ring.allocate(700, 4).isValid());
+
+    // The data is written straight to the buffer
+    const char text[] = "streamed";
+    std::memcpy(second.data, text, sizeof(text));
+    const std::vector<std::uint8_t> bytes = gapi.getBufferBytes(ring.getBufferId(), second.offset, sizeof(text));
+    EXPECT_EQ(std::memcmp(bytes.data(), text, sizeof(text)), 0);
+
+    ring.endFrame();
+    EXPECT_EQ(ring.getCurrentRegion(), 1u);
+    const StreamingRing::Allocation nextFrame = ring.allocate(10, 256);
+    ASSERT_TRUE(nextFrame.isValid());
+    EXPECT_EQ(nextFrame.offset, 1024u);
+}
+
+TEST(StreamingRingTests, RegionsAreReusedOnceTheirFenceIsSignaled) {
+    RecordingAPI gapi;
+    StreamingRing ring(gapi, 64);
+    // The GPU takes two waits to finish each frame
+    gapi.setFenceLatency(2);
+
+    for (UInt frame = 0; frame < ring.getRegionCount(); frame++) {
+        ASSERT_TRUE(ring.allocate(16, 4).isValid());
+        ring.endFrame();
+    }
+    // A fence per frame in flight, the CPU didn't wait for any
+    EXPECT_EQ(gapi.getFenceCount(), ring.getRegionCount());
+    EXPECT_EQ(ring.getStallCount(), 0u);
+
+    // The first region is written again, after its frame is done
+    EXPECT_EQ(ring.getCurrentRegion(), 0u);
+    ASSERT_TRUE(ring.allocate(16, 4).isValid());
+    EXPECT_EQ(ring.getStallCount(), 2u);
+    EXPECT_EQ(gapi.getFenceTimeouts(), 2u);
+    EXPECT_EQ(gapi.getFenceCount(), ring.getRegionCount() - 1);
+    // The region was already acquired in this frame
+    ASSERT_TRUE(ring.allocate(16, 4).isValid());
+    EXPECT_EQ(ring.getStallCount(), 2u);
+}
+
+TEST(StreamingRingTests, FailedWaitsThrowInsteadOfWaitingForever) {
+    RecordingAPI gapi;
+    StreamingRing ring(gapi, 64, 1);
+    ASSERT_TRUE(ring.allocate(16, 4).isValid());
+    ring.endFrame();
+
+    gapi.setFenceWaitsFail(true);
+    EXPECT_THROW((void)ring.allocate(16, 4), GAPIException);
+    EXPECT_EQ(gapi.getFenceCount(), 0u);
+    EXPECT_EQ(ring.getStallCount(), 0u);
+}
+
+TEST(StreamingRingTests, FramesWithoutAllocationsKeepTheirRegion) {
+    RecordingAPI gapi;
+    StreamingRing ring(gapi, 64);
+    ring.endFrame();
+    EXPECT_EQ(ring.getCurrentRegion(), 0u);
+    EXPECT_EQ(gapi.getFenceCount(), 0u);
+
+    ASSERT_TRUE(ring.allocate(8, 4).isValid());
+    ring.endFrame();
+    ring.endFrame();
+    EXPECT_EQ(ring.getCurrentRegion(), 1u);
+    EXPECT_EQ(gapi.getFenceCount(), 1u);
+
+    ring.destroyGpuBuffers();
+    EXPECT_EQ(gapi.getFenceCount(), 0u);
+    EXPECT_EQ(gapi.getBufferCount(), 0u);
+}
+#endif
@@ -0,0 +1,213 @@
+/**************************************************************************************************
+ * @file   VertexPackerTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-17
+ * @brief  Tests of the compact vertex formats.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include "engine/subsystems/renderer/mesh/MeshFactory.h"
+#include "engine/subsystems/renderer/mesh/MeshRegistry.h"
+#include "engine/subsystems/renderer/mesh/VertexPacker.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+
+namespace {
+    const ColorRgba white(255, 255, 255, 255);
+    const std::vector<VertexFormat> formats{VertexFormat::Float, VertexFormat::Compact, VertexFormat::Quantized};
+
+    std::vector<ColorVertex> createRandomVertices(size_t count, float minPosition, float maxPosition,
+                                                  unsigned int seed) {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> position(minPosition, maxPosition);
+        std::uniform_real_distribution<float> normal(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> channel(0, 255);
+        std::vector<ColorVertex> vertices;
+        for (size_t i = 0; i < count; i++) {
+            vertices.emplace_back(Position(position(generator), position(generator), position(generator)),
+                                  Normal(normal(generator), normal(generator), normal(generator)).normalize(),
+                                  ColorRgba(static_cast<float>(channel(generator)),
+                                            static_cast<float>(channel(generator)),
+                                            static_cast<float>(channel(generator)),
+                                            static_cast<float>(channel(generator))));
+        }
+        return vertices;
+    }
+}
+
+TEST(VertexPackerTests, HalfFloatConversion) {
+    for (float value : {0.0f, 1.0f, -2.5f, 0.5f, 500.5f, -1023.5f, 2048.0f, 65504.0f}) {
+        EXPECT_EQ(VertexPacker::halfToFloat(VertexPacker::floatToHalf(value)), value);
+    }
+    EXPECT_EQ(VertexPacker::floatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(VertexPacker::floatToHalf(-2.0f), 0xC000);
+    // Too big values become infinity, too small ones zero or subnormals
+    EXPECT_TRUE(std::isinf(VertexPacker::halfToFloat(VertexPacker::floatToHalf(70000.0f))));
+    EXPECT_EQ(VertexPacker::floatToHalf(1e-9f), 0x0000);
+    EXPECT_EQ(VertexPacker::floatToHalf(std::ldexp(1.0f, -24)), 0x0001);
+    EXPECT_EQ(VertexPacker::halfToFloat(0x0001), std::ldexp(1.0f, -24));
+    EXPECT_TRUE(std::isnan(VertexPacker::halfToFloat(VertexPacker::floatToHalf(std::nanf("")))));
+    // Halfway values round to the even mantissa
+    EXPECT_EQ(VertexPacker::floatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);
+    EXPECT_EQ(VertexPacker::floatToHalf(1.0f + 3 * std::ldexp(1.0f, -11)), 0x3C02);
+
+    // The relative error is at most half of the precision of the half floats
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> distribution(-60000.0f, 60000.0f);
+    for (int i = 0; i < 10000; i++) {
+        const float value = distribution(generator);
+        const float converted = VertexPacker::halfToFloat(VertexPacker::floatToHalf(value));
+        EXPECT_LE(std::abs(converted - value), std::abs(value) * std::ldexp(1.0f, -11));
+    }
+}
+
+TEST(VertexPackerTests, NormalsAndColorsConversion) {
+    for (const Normal& axis : {Normal(1, 0, 0), Normal(0, -1, 0), Normal(0, 0, 1), Normal(-1, 0, 0)}) {
+        const Normal converted = VertexPacker::unpackNormal(VertexPacker::packNormal(axis));
+        for (size_t component = 0; component < 3; component++) {
+            EXPECT_FLOAT_EQ(converted.get(component), axis.get(component));
+        }
+    }
+    // The last 2 bits are unused
+    EXPECT_EQ(VertexPacker::packNormal(Normal(-1, -1, -1)) >> 30, 0u);
+
+    const ColorRgba color(12, 200, 0, 255);
+    uint8_t packed[4];
+    VertexPacker::packColor(ColorRgbaNorm(color), packed);
+    EXPECT_EQ(packed[0], 12);
+    EXPECT_EQ(packed[1], 200);
+    EXPECT_EQ(packed[2], 0);
+    EXPECT_EQ(packed[3], 255);
+    EXPECT_EQ(VertexPacker::unpackColor(packed), color);
+
+    EXPECT_EQ(VertexPacker::floatToSnorm16(1.0f), 32767);
+    EXPECT_EQ(VertexPacker::floatToSnorm16(-2.0f), -32767);
+    EXPECT_FLOAT_EQ(VertexPacker::snorm16ToFloat(-32768), -1.0f);
+}
+
+TEST(VertexPackerTests, LayoutsMatchTheStrides) {
+    for (VertexFormat format : formats) {
+        size_t layoutBytes = 0;
+        for (const GAPI::VertexBufferElement& element : VertexPacker::getLayout(format)) {
+            layoutBytes += static_cast<size_t>(GAPI::Enums::getTypeSize(element.type));
+        }
+        EXPECT_EQ(layoutBytes, VertexPacker::getStride(format));
+        EXPECT_EQ(VertexPacker::getLayout(format).size(), ColorVertex::getLayout().size());
+    }
+    EXPECT_EQ(VertexPacker::getStride(VertexFormat::Float), sizeof(ColorVertex));
+    EXPECT_EQ(VertexPacker::getStride(VertexFormat::Float), 40u);
+    EXPECT_EQ(VertexPacker::getStride(VertexFormat::Compact), 16u);
+    EXPECT_EQ(VertexPacker::getStride(VertexFormat::Quantized), 16u);
+}
+
+TEST(VertexPackerTests, BlocksAreExactInTheCompactFormat) {
+    // Faces of blocks, like the terrain: corners at multiples of 0.5, axis aligned normals and 8 bits colors
+    ColorMesh mesh;
+    mesh.startBuilding();
+    for (int block = 0; block < 500; block += 7) {
+        const float x = static_cast<float>(block);
+        mesh.addQuad({Position(x - 0.5f, 99.5f, x - 0.5f), ColorRgba(38, 204, 25, 255)},
+                     {Position(x + 0.5f, 99.5f, x - 0.5f), ColorRgba(38, 204, 25, 255)},
+                     {Position(x + 0.5f, 99.5f, x + 0.5f), ColorRgba(38, 204, 25, 255)},
+                     {Position(x - 0.5f, 99.5f, x + 0.5f), ColorRgba(38, 204, 25, 255)});
+    }
+    mesh.finishBuilding();
+
+    const VertexPacker::ConversionError error = VertexPacker::measureError(
+        mesh.getVertices(), VertexFormat::Compact, mesh.getBoundingVolume().getMin(),
+        mesh.getBoundingVolume().getMax());
+    EXPECT_EQ(error.position, 0.0f);
+    EXPECT_EQ(error.normal, 0.0f);
+    EXPECT_LE(error.color, 1e-6f);
+}
+
+TEST(VertexPackerTests, ConversionErrorIsBounded) {
+    const Position min(-100, -100, -100);
+    const Position max(300, 300, 300);
+    const std::vector<ColorVertex> vertices = createRandomVertices(5000, -100, 300, 7);
+
+    const VertexPacker::ConversionError floatError = VertexPacker::measureError(
+        vertices, VertexFormat::Float, min, max);
+    EXPECT_EQ(floatError.position, 0.0f);
+    EXPECT_EQ(floatError.normal, 0.0f);
+    EXPECT_EQ(floatError.color, 0.0f);
+
+    // Half of the precision of a half float at 256-512
+    const VertexPacker::ConversionError compactError = VertexPacker::measureError(
+        vertices, VertexFormat::Compact, min, max);
+    EXPECT_LE(compactError.position, 0.125f);
+    EXPECT_LE(compactError.normal, 0.5f / 511.0f + 1e-6f);
+    EXPECT_LE(compactError.color, 1e-6f);
+
+    // Half of the size of the box divided by the steps of the normalized shorts
+    const VertexPacker::ConversionError quantizedError = VertexPacker::measureError(
+        vertices, VertexFormat::Quantized, min, max);
+    EXPECT_LE(quantizedError.position, 0.5f * 400.0f / 65534.0f + 1e-4f);
+    EXPECT_LT(quantizedError.position, compactError.position);
+    EXPECT_LE(quantizedError.normal, 0.5f / 511.0f + 1e-6f);
+}
+
+TEST(VertexPackerTests, FlatMeshesCanBeQuantized) {
+    // The bounding box of a flat mesh has no size in one axis
+    const std::vector<ColorVertex> vertices{
+        ColorVertex(Position(0, 2, 0), Normal(0, 1, 0), white),
+        ColorVertex(Position(1, 2, 0), Normal(0, 1, 0), white),
+        ColorVertex(Position(0, 2, 1), Normal(0, 1, 0), white)
+    };
+    const VertexPacker::PackedVertices packed = VertexPacker::pack(vertices, VertexFormat::Quantized,
+                                                                   Position(0, 2, 0), Position(1, 2, 1));
+    EXPECT_EQ(packed.getCount(), 3u);
+    EXPECT_EQ(packed.dequantization.scale, Vec3F(0.5f, 0.0f, 0.5f));
+    EXPECT_EQ(packed.dequantization.offset, Vec3F(0.5f, 2.0f, 0.5f));
+    const std::vector<ColorVertex> unpacked = VertexPacker::unpack(packed);
+    ASSERT_EQ(unpacked.size(), vertices.size());
+    for (size_t index = 0; index < vertices.size(); index++) {
+        EXPECT_EQ(unpacked[index], vertices[index]);
+    }
+}
+
+TEST(VertexPackerTests, MeshesInDifferentFormatsAreNotShared) {
+    MeshRegistry registry;
+    ColorMesh compactCube = MeshFactory::cube(white);
+    compactCube.setVertexFormat(VertexFormat::Compact);
+    MeshHandle floatHandle = registry.registerMesh(MeshFactory::cube(white));
+    MeshHandle compactHandle = registry.registerMesh(compactCube);
+    EXPECT_NE(floatHandle, compactHandle);
+    EXPECT_EQ(compactHandle->getVertexFormat(), VertexFormat::Compact);
+    EXPECT_EQ(registry.getStats().uniqueMeshes, 2u);
+}
+
+#if RENDERING_BENCHMARKING
+TEST(VertexPackerTests, BenchmarkFormats) {
+    constexpr size_t vertexCount = 1000000;
+    const std::vector<ColorVertex> vertices = createRandomVertices(vertexCount, 0, 500, 11);
+    const Position min(0, 0, 0);
+    const Position max(500, 500, 500);
+    for (VertexFormat format : formats) {
+        auto start = std::chrono::steady_clock::now();
+        const VertexPacker::PackedVertices packed = VertexPacker::pack(vertices, format, min, max);
+        auto end = std::chrono::steady_clock::now();
+        const double millis = std::chrono::duration<double, std::milli>(end - start).count();
+        const double megabytes = static_cast<double>(packed.data.size()) / (1024.0 * 1024.0);
+        const VertexPacker::ConversionError error = VertexPacker::measureError(
+            std::vector<ColorVertex>(vertices.begin(), vertices.begin() + 10000), format, min, max);
+        std::cout << "Vertex format " << static_cast<int>(format) << ": " << packed.stride << " bytes/vertex, "
+                  << megabytes << " MB for " << vertexCount << " vertices (x"
+                  << static_cast<double>(sizeof(ColorVertex)) / static_cast<double>(packed.stride)
+                  << " smaller), packed in " << millis << " ms (" << static_cast<double>(vertexCount) / millis / 1000.0
+                  << " M vertices/s), max position error " << error.position << "\n";
+    }
+}
+#endif
+#endif
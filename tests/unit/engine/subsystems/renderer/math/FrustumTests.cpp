@@ -0,0 +1,145 @@
+/**************************************************************************************************
+ * @file   FrustumTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-08
+ * @brief  Tests and benchmark of the culling of bounding boxes with the frustum.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "engine/subsystems/renderer/math/Frustum.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+using AABB = Math::BoundingVolume::AABB;
+
+class FrustumTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Projection projection;
+        projection.makeProjectionMatrix(45.0f, 0.1f, 100.0f, 800.0f, 600.0f);
+        View view;
+        view.makeViewMatrixPosRot(Position(0, 0, 0), Vec3F(0.0f, 0.3f, 0.0f));
+        viewProjection = projection * view;
+    }
+
+    /**
+     * @brief Creates boxes around the camera, some inside, some outside and some crossing the planes.
+     */
+    [[nodiscard]] std::vector<AABB> createBoxes(size_t count) const {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+        std::uniform_real_distribution<float> halfSize(0.1f, 10.0f);
+        std::vector<AABB> boxes;
+        for (size_t i = 0; i < count; i++) {
+            Vec3F center(position(random), position(random) * 0.25f, position(random));
+            Vec3F extent(halfSize(random), halfSize(random), halfSize(random));
+            boxes.push_back({center - extent, center + extent});
+        }
+        return boxes;
+    }
+
+    static AABBArrays toArrays(const std::vector<AABB>& boxes) {
+        AABBArrays arrays;
+        arrays.reserve(boxes.size());
+        for (const AABB& box : boxes) {
+            arrays.push_back(box);
+        }
+        return arrays;
+    }
+
+    VP viewProjection;
+};
+
+TEST_F(FrustumTests, EveryKernelMatchesContains) {
+    Frustum frustum(viewProjection);
+    // Not a multiple of 8 nor 4, so the tails of the vector kernels are tested too
+    const std::vector<AABB> boxes = createBoxes(1003);
+    const AABBArrays arrays = toArrays(boxes);
+
+    size_t visibleCount = 0;
+    for (CullingKernel kernel : {CullingKernel::Scalar, CullingKernel::SSE, CullingKernel::AVX2}) {
+        if (!Frustum::isCullingKernelSupported(kernel)) continue;
+        std::vector<std::uint8_t> visible(boxes.size(), 2);
+        frustum.cullAABBs(arrays, visible.data(), kernel);
+        visibleCount = 0;
+        for (size_t i = 0; i < boxes.size(); i++) {
+            const bool expected = frustum.contains(Math::BoundingVolume(boxes[i].min, boxes[i].max));
+            EXPECT_EQ(visible[i], expected ? 1 : 0) << "Box " << i << " with kernel " << static_cast<int>(kernel);
+            visibleCount += expected ? 1 : 0;
+        }
+    }
+    EXPECT_GT(visibleCount, 0u);
+    EXPECT_LT(visibleCount, boxes.size());
+}
+
+TEST_F(FrustumTests, ArrayOfBoxesMatchesStructureOfArrays) {
+    Frustum frustum(viewProjection);
+    // More than one chunk of the conversion
+    const std::vector<AABB> boxes = createBoxes(1000);
+    std::vector<std::uint8_t> fromArrays(boxes.size());
+    std::vector<std::uint8_t> fromBoxes(boxes.size());
+    frustum.cullAABBs(toArrays(boxes), fromArrays.data());
+    frustum.cullAABBs(boxes.data(), boxes.size(), fromBoxes.data());
+    EXPECT_EQ(fromBoxes, fromArrays);
+}
+
+TEST_F(FrustumTests, ClassifyAgreesWithContains) {
+    Frustum frustum(viewProjection);
+    size_t insideCount = 0;
+    for (const AABB& box : createBoxes(1000)) {
+        Frustum::PlaneMask planeMask = Frustum::allPlanes;
+        Math::Containment containment = frustum.classify(box, planeMask);
+        const bool contained = frustum.contains(Math::BoundingVolume(box.min, box.max));
+        EXPECT_EQ(containment != Math::Containment::Outside, contained);
+        if (containment == Math::Containment::Inside) {
+            EXPECT_EQ(planeMask, 0);
+            insideCount++;
+        }
+    }
+    EXPECT_GT(insideCount, 0u);
+}
+
+#if RENDERING_BENCHMARKING
+TEST_F(FrustumTests, BenchmarkBatchCulling) {
+    constexpr size_t boxCount = 100000;
+    constexpr int iterations = 20;
+    Frustum frustum(viewProjection);
+    const std::vector<AABB> boxes = createBoxes(boxCount);
+    const AABBArrays arrays = toArrays(boxes);
+    std::vector<std::uint8_t> visible(boxCount);
+
+    auto measure = [&](const char* name, auto&& cull) {
+        cull(); // Warm up
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            cull();
+        }
+        auto end = std::chrono::steady_clock::now();
+        double millis = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+        std::cout << "Culling " << boxCount << " boxes, " << name << ": " << millis << " ms\n";
+    };
+
+    measure("contains() per box", [&] {
+        for (size_t i = 0; i < boxCount; i++) {
+            visible[i] = frustum.contains(Math::BoundingVolume(boxes[i].min, boxes[i].max)) ? 1 : 0;
+        }
+    });
+    const char* kernelNames[] = {"scalar kernel", "SSE kernel", "AVX2 kernel"};
+    for (CullingKernel kernel : {CullingKernel::Scalar, CullingKernel::SSE, CullingKernel::AVX2}) {
+        if (!Frustum::isCullingKernelSupported(kernel)) continue;
+        measure(kernelNames[static_cast<int>(kernel)], [&] {
+            frustum.cullAABBs(arrays, visible.data(), kernel);
+        });
+    }
+    measure("array of boxes", [&] { frustum.cullAABBs(boxes.data(), boxCount, visible.data()); });
+}
+#endif
+#endif
@@ -0,0 +1,167 @@
+/**************************************************************************************************
+ * @file   MatrixBatchTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-24
+ * @brief  Tests and benchmark of the batch computation of the matrices of many transforms.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if RENDERING_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "engine/subsystems/renderer/math/MatrixBatch.h"
+
+using namespace GLESC;
+using namespace GLESC::Render;
+using Transform::TransformStore;
+
+class MatrixBatchTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Projection projection;
+        projection.makeProjectionMatrix(45.0f, 0.1f, 100.0f, 800.0f, 600.0f);
+        view.makeViewMatrixPosRot(Position(1, 2, 3), Vec3F(0.2f, 0.3f, 0.1f));
+        viewProjection = projection * view;
+    }
+
+    /**
+     * @brief Creates transforms with random positions and rotations and non uniform scales.
+     */
+    static std::vector<Transform::Transform> createTransforms(size_t count) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+        std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+        std::vector<Transform::Transform> transforms;
+        for (size_t i = 0; i < count; i++) {
+            transforms.emplace_back(Transform::Position(position(random), position(random), position(random)),
+                                    Transform::Rotation(angle(random), angle(random), angle(random)),
+                                    Transform::Scale(scale(random), scale(random), scale(random)));
+        }
+        return transforms;
+    }
+
+    static TransformStore toStore(const std::vector<Transform::Transform>& transforms) {
+        TransformStore store;
+        store.reserve(transforms.size());
+        for (const Transform::Transform& transform : transforms) {
+            store.push_back(transform);
+        }
+        return store;
+    }
+
+    template <size_t N>
+    static void expectNear(const Math::Matrix<float, N, N>& actual, const Math::Matrix<float, N, N>& expected) {
+        for (size_t column = 0; column < N; column++) {
+            for (size_t row = 0; row < N; row++) {
+                const float tolerance = 1e-4f * std::max(1.0f, std::abs(expected[column][row]));
+                EXPECT_NEAR(actual[column][row], expected[column][row], tolerance)
+                    << "[" << column << "][" << row << "]";
+            }
+        }
+    }
+
+    View view;
+    VP viewProjection;
+};
+
+TEST_F(MatrixBatchTests, KernelsGiveTheMatricesOfEachTransform) {
+    // Not a multiple of the width of the kernels, so the remaining objects go through the narrower kernels
+    constexpr size_t count = 37;
+    const std::vector<Transform::Transform> transforms = createTransforms(count);
+    const TransformStore store = toStore(transforms);
+
+    for (MatrixKernel kernel : {MatrixKernel::Scalar, MatrixKernel::SSE, MatrixKernel::AVX2}) {
+        if (!MatrixBatch::isKernelSupported(kernel)) continue;
+        std::vector<Model> models(count);
+        std::vector<MV> mvs(count);
+        std::vector<MVP> mvps(count);
+        std::vector<NormalMat> normalMats(count);
+        MatrixBatch::compute(store, 0, count, view, viewProjection,
+                             {models.data(), mvs.data(), mvps.data(), normalMats.data()}, kernel);
+        for (size_t i = 0; i < count; i++) {
+            SCOPED_TRACE("Kernel " + std::to_string(static_cast<int>(kernel)) + ", object " + std::to_string(i));
+            const Model& model = transforms[i].getModelMatrix();
+            NormalMat normalMat;
+            normalMat.makeNormalMatrix(view * model);
+            expectNear(models[i], model);
+            expectNear(mvs[i], view * model);
+            expectNear(mvps[i], viewProjection * model);
+            expectNear(normalMats[i], normalMat);
+        }
+    }
+}
+
+TEST_F(MatrixBatchTests, ObjectsAreWrittenToTheirSlots) {
+    constexpr size_t count = 24;
+    const std::vector<Transform::Transform> transforms = createTransforms(count);
+    const TransformStore store = toStore(transforms);
+    std::vector<size_t> slots(count);
+    for (size_t i = 0; i < count; i++) slots[i] = count - 1 - i;
+
+    // Only the model view matrices of the objects [5, 21), written in reverse order
+    std::vector<MV> mvs(count, MV(0.0f));
+    MatrixBatchOutput output;
+    output.mvs = mvs.data();
+    output.slots = slots.data();
+    MatrixBatch::compute(store, 5, 21, view, viewProjection, output);
+    for (size_t i = 0; i < count; i++) {
+        const size_t slot = slots[i];
+        if (i < 5 || i >= 21) {
+            expectNear(mvs[slot], MV(0.0f));
+            continue;
+        }
+        expectNear(mvs[slot], view * transforms[i].getModelMatrix());
+    }
+}
+
+#if RENDERING_BENCHMARKING
+TEST_F(MatrixBatchTests, BenchmarkBatchMatrices) {
+    constexpr int iterations = 10;
+    for (size_t count : {10000u, 100000u}) {
+        const std::vector<Transform::Transform> transforms = createTransforms(count);
+        const TransformStore store = toStore(transforms);
+        std::vector<MV> mvs(count);
+        std::vector<MVP> mvps(count);
+        std::vector<NormalMat> normalMats(count);
+        const MatrixBatchOutput output{nullptr, mvs.data(), mvps.data(), normalMats.data()};
+
+        auto measure = [&](const char* name, auto&& computeMatrices) {
+            computeMatrices(); // Warm up
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) {
+                computeMatrices();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double millis = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+            std::cout << "Matrices of " << count << " transforms, " << name << ": " << millis << " ms\n";
+        };
+
+        measure("one matrix at a time", [&] {
+            for (size_t i = 0; i < count; i++) {
+                const Transform::Transform& transform = transforms[i];
+                Model model;
+                model.makeModelMatrix(transform.getPosition(), transform.getOrientation(), transform.getScale());
+                mvps[i] = viewProjection * model;
+                mvs[i] = view * model;
+                normalMats[i].makeNormalMatrix(mvs[i]);
+            }
+        });
+        const char* kernelNames[] = {"scalar kernel", "SSE kernel", "AVX2 kernel"};
+        for (MatrixKernel kernel : {MatrixKernel::Scalar, MatrixKernel::SSE, MatrixKernel::AVX2}) {
+            if (!MatrixBatch::isKernelSupported(kernel)) continue;
+            measure(kernelNames[static_cast<int>(kernel)], [&] {
+                MatrixBatch::compute(store, 0, count, view, viewProjection, output, kernel);
+            });
+        }
+    }
+}
+#endif
+#endif
@@ -0,0 +1,113 @@
+/**************************************************************************************************
+ * @file   InterpolationStoreTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-25
+ * @brief  Tests of the interpolation of the transforms of many objects keyed by their handles.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if TRANSFORM_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <cmath>
+#include "engine/subsystems/transform/InterpolationStore.h"
+
+using namespace GLESC;
+using Transform::InterpolationStore;
+using Transform::Orientation;
+using Transform::Pose;
+using Transform::Position;
+using Transform::Rotation;
+using Transform::Scale;
+
+namespace {
+    Pose makePose(const Position& position, const Rotation& rotation, const Scale& scale) {
+        return {position, Orientation::fromEuler(rotation.toRads()), scale};
+    }
+
+    void expectNear(const Pose& actual, const Pose& expected) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            EXPECT_NEAR(actual.position[axis], expected.position[axis], 1e-4f) << "Position " << axis;
+            EXPECT_NEAR(actual.scale[axis], expected.scale[axis], 1e-4f) << "Scale " << axis;
+        }
+        // Both quaternions represent the same rotation
+        EXPECT_NEAR(std::abs(actual.orientation.dot(expected.orientation)), 1.0f, 1e-4f);
+    }
+}
+
+TEST(InterpolationStoreTests, BatchInterpolationMatchesEachObject) {
+    InterpolationStore store;
+    // Not a multiple of the width of the kernels
+    constexpr InterpolationStore::Handle count = 21;
+    for (InterpolationStore::Handle handle = 0; handle < count; handle++) {
+        const auto value = static_cast<float>(handle);
+        store.push(handle, makePose(Position(value, 0, -value), Rotation(0, value * 10.0f, 0), Scale(1, 1, 1)));
+    }
+    store.nextUpdate();
+    for (InterpolationStore::Handle handle = 0; handle < count; handle++) {
+        const auto value = static_cast<float>(handle);
+        // The rotations cross 180 degrees, where the quaternion of the target changes its sign
+        store.push(handle, makePose(Position(value + 2, 1, -value), Rotation(0, value * 10.0f + 30.0f, 0),
+                                    Scale(2, 1, 1)));
+    }
+
+    Transform::TransformStore interpolated;
+    store.interpolate(0.25f, interpolated);
+    ASSERT_EQ(interpolated.size(), static_cast<size_t>(count));
+    for (InterpolationStore::Handle handle = 0; handle < count; handle++) {
+        SCOPED_TRACE("Handle " + std::to_string(handle));
+        Pose batchPose = interpolated.getPose(handle);
+        batchPose.orientation = batchPose.orientation.normalize();
+        const Pose pose = store.interpolate(handle, 0.25f);
+        expectNear(batchPose, pose);
+        EXPECT_NEAR(pose.position.getX(), static_cast<float>(handle) + 0.5f, 1e-4f);
+        EXPECT_NEAR(pose.scale.getX(), 1.25f, 1e-4f);
+    }
+}
+
+TEST(InterpolationStoreTests, ObjectsThatWerentPushedLastUpdateAreNotInterpolated) {
+    InterpolationStore store;
+    const Pose start = makePose(Position(0, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1));
+    const Pose moved = makePose(Position(4, 0, 0), Rotation(0, 90, 0), Scale(1, 1, 1));
+    const Pose teleported = makePose(Position(4 + InterpolationStore::teleportDistance * 2, 0, 0),
+                                     Rotation(0, 0, 0), Scale(1, 1, 1));
+    store.push(3, start);
+    EXPECT_TRUE(store.contains(3));
+    EXPECT_FALSE(store.contains(2));
+    expectNear(store.interpolate(3, 0.5f), start);
+
+    store.nextUpdate();
+    store.push(3, moved);
+    expectNear(store.interpolate(3, 0.5f), makePose(Position(2, 0, 0), Rotation(0, 45, 0), Scale(1, 1, 1)));
+
+    // Too far away to be interpolated
+    store.nextUpdate();
+    store.push(3, teleported);
+    expectNear(store.interpolate(3, 0.5f), teleported);
+
+    // Skipping an update, or being removed, also starts again from the pushed transform
+    store.nextUpdate();
+    store.nextUpdate();
+    store.push(3, start);
+    expectNear(store.interpolate(3, 0.5f), start);
+    store.remove(3);
+    EXPECT_FALSE(store.contains(3));
+    store.nextUpdate();
+    store.push(3, moved);
+    expectNear(store.interpolate(3, 0.5f), moved);
+}
+
+TEST(InterpolationStoreTests, PushingTwiceInTheSameUpdateReplacesTheCurrentTransform) {
+    InterpolationStore store;
+    store.push(0, makePose(Position(0, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    store.nextUpdate();
+    store.push(0, makePose(Position(1, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    store.push(0, makePose(Position(2, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    // The last transform is still the one of the previous update
+    expectNear(store.interpolate(0, 0.5f), makePose(Position(1, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    // The alpha is clamped, the objects are never extrapolated
+    expectNear(store.interpolate(0, 2.0f), makePose(Position(2, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+}
+#endif
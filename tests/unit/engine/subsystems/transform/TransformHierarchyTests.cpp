@@ -0,0 +1,154 @@
+/**************************************************************************************************
+ * @file   TransformHierarchyTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-23
+ * @brief  Tests of the parent and child relations of the transforms.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if TRANSFORM_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "engine/subsystems/transform/TransformHierarchy.h"
+
+using namespace GLESC;
+using Transform::Position;
+using Transform::Rotation;
+using Transform::Scale;
+using Transform::TransformHierarchy;
+
+namespace {
+    TransformHierarchy::Pose createPose(const Position& position, const Rotation& rotationDegrees,
+                                        const Scale& scale) {
+        return {position, Transform::Orientation::fromEuler(rotationDegrees.toRads()), scale};
+    }
+
+    void expectNear(const Vec3F& actual, const Vec3F& expected) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            EXPECT_NEAR(actual.get(axis), expected.get(axis), 1e-4f) << "Axis " << axis;
+        }
+    }
+
+    size_t positionOf(const TransformHierarchy& hierarchy, TransformHierarchy::NodeID node) {
+        const std::vector<TransformHierarchy::NodeID>& order = hierarchy.getUpdateOrder();
+        return static_cast<size_t>(std::find(order.begin(), order.end(), node) - order.begin());
+    }
+}
+
+TEST(TransformHierarchyTests, ChildrenAreRelativeToTheirParent) {
+    TransformHierarchy hierarchy;
+    hierarchy.addNode(0);
+    hierarchy.addNode(1);
+    hierarchy.setParent(1, 0);
+    hierarchy.setLocalPose(0, createPose(Position(10, 0, 0), Rotation(0, 90, 0), Scale(2, 2, 2)));
+    hierarchy.setLocalPose(1, createPose(Position(1, 0, 0), Rotation(30, 0, 0), Scale(1, 2, 3)));
+    hierarchy.update();
+
+    // The child is 2 units along the x axis of the parent, which points to -z after the rotation
+    const TransformHierarchy::Pose& world = hierarchy.getWorldPose(1);
+    expectNear(world.position, Position(10, 0, -2));
+    expectNear(world.scale, Scale(2, 4, 6));
+
+    // With a uniform scale in the parent, the world matrix is the product of the matrices
+    Render::Model localMatrix;
+    const TransformHierarchy::Pose local = createPose(Position(1, 0, 0), Rotation(30, 0, 0), Scale(1, 2, 3));
+    localMatrix.makeModelMatrix(local.position, local.orientation, local.scale);
+    const Render::Model expected = hierarchy.getWorldMatrix(0) * localMatrix;
+    for (size_t column = 0; column < 4; column++) {
+        for (size_t row = 0; row < 4; row++) {
+            EXPECT_NEAR(hierarchy.getWorldMatrix(1)[column][row], expected[column][row], 1e-4f);
+        }
+    }
+
+    Transform::Transform transform;
+    hierarchy.applyWorldPose(1, transform);
+    expectNear(transform.getPosition(), Position(10, 0, -2));
+    expectNear(transform.getScale(), Scale(2, 4, 6));
+}
+
+TEST(TransformHierarchyTests, OnlyTheSubtreesThatChangedAreRecomputed) {
+    // 0 -> 1 -> 2, and 3 on its own
+    TransformHierarchy hierarchy;
+    for (TransformHierarchy::NodeID node = 0; node < 4; node++) hierarchy.addNode(node);
+    hierarchy.setParent(1, 0);
+    hierarchy.setParent(2, 1);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getStats().updatedNodes, 4u);
+
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getStats().updatedNodes, 0u);
+
+    hierarchy.setLocalPose(1, createPose(Position(0, 1, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getStats().updatedNodes, 2u);
+    EXPECT_FALSE(hierarchy.isWorldUpdated(0));
+    EXPECT_TRUE(hierarchy.isWorldUpdated(1));
+    EXPECT_TRUE(hierarchy.isWorldUpdated(2));
+    EXPECT_FALSE(hierarchy.isWorldUpdated(3));
+    expectNear(hierarchy.getWorldPose(2).position, Position(0, 1, 0));
+
+    // Setting the same transform again doesn't recompute anything
+    hierarchy.setLocalPose(1, createPose(Position(0, 1, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getStats().updatedNodes, 0u);
+
+    hierarchy.setLocalPose(0, createPose(Position(5, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getStats().updatedNodes, 3u);
+    expectNear(hierarchy.getWorldPose(2).position, Position(5, 1, 0));
+}
+
+TEST(TransformHierarchyTests, ParentsAreUpdatedBeforeTheirChildren) {
+    // The children are added before their parents and linked in any order
+    TransformHierarchy hierarchy;
+    for (TransformHierarchy::NodeID node : {7u, 3u, 9u, 1u, 4u, 8u}) hierarchy.addNode(node);
+    hierarchy.setParent(7, 3);
+    hierarchy.setParent(9, 1);
+    hierarchy.setParent(3, 1);
+    hierarchy.setParent(8, 4);
+    hierarchy.setLocalPose(1, createPose(Position(1, 0, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    hierarchy.setLocalPose(3, createPose(Position(0, 1, 0), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    hierarchy.setLocalPose(7, createPose(Position(0, 0, 1), Rotation(0, 0, 0), Scale(1, 1, 1)));
+    hierarchy.update();
+
+    for (TransformHierarchy::NodeID node : hierarchy.getUpdateOrder()) {
+        const TransformHierarchy::NodeID parent = hierarchy.getParent(node);
+        if (parent == TransformHierarchy::nullNode) continue;
+        EXPECT_LT(positionOf(hierarchy, parent), positionOf(hierarchy, node));
+    }
+    // The subtree of 1 is contiguous: 1, 3, 7 and 9
+    const size_t subtreeStart = positionOf(hierarchy, 1);
+    EXPECT_LT(positionOf(hierarchy, 9), subtreeStart + 4);
+    EXPECT_LT(positionOf(hierarchy, 7), subtreeStart + 4);
+    expectNear(hierarchy.getWorldPose(7).position, Position(1, 1, 1));
+
+    // A removed parent leaves its children where their local transform says
+    hierarchy.removeNode(3);
+    EXPECT_EQ(hierarchy.getParent(7), TransformHierarchy::nullNode);
+    hierarchy.update();
+    expectNear(hierarchy.getWorldPose(7).position, Position(0, 0, 1));
+    EXPECT_EQ(hierarchy.getStats().nodes, 5u);
+    EXPECT_FALSE(hierarchy.hasNode(3));
+}
+
+TEST(TransformHierarchyTests, ParentsThatCloseACycleAreRejected) {
+    TransformHierarchy hierarchy;
+    for (TransformHierarchy::NodeID node : {0u, 1u, 2u}) hierarchy.addNode(node);
+    EXPECT_TRUE(hierarchy.setParent(1, 0));
+    EXPECT_TRUE(hierarchy.setParent(2, 1));
+    EXPECT_FALSE(hierarchy.setParent(0, 2));
+    EXPECT_FALSE(hierarchy.setParent(0, 0));
+    EXPECT_EQ(hierarchy.getParent(0), TransformHierarchy::nullNode);
+
+    // A node that was a child becomes a root when its new parent is rejected
+    EXPECT_FALSE(hierarchy.setParent(1, 2));
+    EXPECT_EQ(hierarchy.getParent(1), TransformHierarchy::nullNode);
+    EXPECT_EQ(hierarchy.getParent(2), 1u);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.getUpdateOrder().size(), 3u);
+    EXPECT_LT(positionOf(hierarchy, 1), positionOf(hierarchy, 2));
+}
+#endif
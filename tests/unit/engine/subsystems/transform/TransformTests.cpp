@@ -0,0 +1,81 @@
+/**************************************************************************************************
+ * @file   TransformTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-23
+ * @brief  Tests of the rotation of the transforms and of their interpolation.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if TRANSFORM_UNIT_TESTING
+#include <gtest/gtest.h>
+#include "engine/subsystems/transform/Transform.h"
+
+using namespace GLESC;
+using Transform::Orientation;
+using Transform::Position;
+using Transform::Rotation;
+using Transform::Scale;
+
+namespace {
+    void expectNear(const Render::Model& actual, const Render::Model& expected) {
+        for (size_t column = 0; column < 4; column++) {
+            for (size_t row = 0; row < 4; row++) {
+                EXPECT_NEAR(actual[column][row], expected[column][row], 1e-4f) << "[" << column << "][" << row << "]";
+            }
+        }
+    }
+
+    Render::Model eulerModelMatrix(const Position& position, const Rotation& rotationDegrees, const Scale& scale) {
+        Render::Model model;
+        model.makeModelMatrix(position, rotationDegrees.toRads(), scale);
+        return model;
+    }
+}
+
+TEST(TransformTests, ModelMatrixFollowsTheSetters) {
+    Transform::Transform transform(Position(1, 2, 3), Rotation(10, 20, 30), Scale(1, 2, 3));
+    expectNear(transform.getModelMatrix(), eulerModelMatrix(Position(1, 2, 3), Rotation(10, 20, 30), Scale(1, 2, 3)));
+
+    transform.setPosition(Position(-4, 5, 6));
+    transform.setRotation(Transform::RotationAxis::Yaw, 90.0f);
+    transform.addRotation(Rotation(5, 0, 0));
+    transform.setScale(Transform::Axis::Z, 0.5f);
+    expectNear(transform.getModelMatrix(),
+               eulerModelMatrix(Position(-4, 5, 6), Rotation(15, 90, 30), Scale(1, 2, 0.5f)));
+}
+
+TEST(TransformTests, OrientationAndEulerAnglesAreTheSameRotation) {
+    Transform::Transform transform;
+    const Orientation halfTurn = Orientation::fromAxisAngle(Vec3F(0, 1, 0), Math::pi<float>());
+    transform.setOrientation(halfTurn);
+    EXPECT_NEAR(transform.getOrientation().dot(halfTurn), 1.0f, 1e-5f);
+    // The Euler angles are the ones of the quaternion, even if they aren't the ones it was created with
+    expectNear(transform.getModelMatrix(),
+               eulerModelMatrix(Position(0, 0, 0), transform.getRotation(), Scale(1, 1, 1)));
+
+    transform.setRotation(Rotation(0, 180, 0));
+    EXPECT_NEAR(std::abs(transform.getOrientation().dot(halfTurn)), 1.0f, 1e-5f);
+}
+
+TEST(TransformTests, InterpolationDoesntSnapWhenTheAnglesWrapAround) {
+    Transform::Interpolator interpolator;
+    interpolator.pushTransform(Transform::Transform(Position(0, 0, 0), Rotation(0, 170, 0), Scale(1, 1, 1)));
+    interpolator.pushTransform(Transform::Transform(Position(2, 0, 0), Rotation(0, -170, 0), Scale(1, 1, 1)));
+
+    // Halfway the rotation is at 180 degrees, not at 0 degrees or at the last rotation
+    const Transform::Transform halfway = interpolator.interpolate(0.5f);
+    EXPECT_NEAR(halfway.getRotation().getY(), 180.0f, 1e-3f);
+    expectNear(halfway.getModelMatrix(), eulerModelMatrix(Position(1, 0, 0), Rotation(0, 180, 0), Scale(1, 1, 1)));
+
+    const Transform::Transform quarter = interpolator.interpolate(0.25f);
+    EXPECT_NEAR(quarter.getRotation().getY(), 175.0f, 1e-3f);
+    expectNear(quarter.getModelMatrix(), eulerModelMatrix(Position(0.5f, 0, 0), Rotation(0, 175, 0), Scale(1, 1, 1)));
+
+    const Transform::Transform end = interpolator.interpolate(2.0f);
+    EXPECT_NEAR(end.getRotation().getY(), 190.0f, 1e-3f);
+    expectNear(end.getModelMatrix(), eulerModelMatrix(Position(2, 0, 0), Rotation(0, -170, 0), Scale(1, 1, 1)));
+}
+#endif
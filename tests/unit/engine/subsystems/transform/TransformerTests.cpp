@@ -0,0 +1,135 @@
+/**************************************************************************************************
+ * @file   TransformerTests.cpp
+ * @author Valentin Dumitru
+ * @date   2024-06-10
+ * @brief  Tests of the transformation of bounding volumes.
+ *
+ * Copyright (c) 2024 Valentin Dumitru. Licensed under the MIT License.
+ * See LICENSE.txt in the project root for license information.
+ **************************************************************************************************/
+
+#include "TestsConfig.h"
+#if TRANSFORM_UNIT_TESTING
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "engine/subsystems/transform/Transform.h"
+#include "unit/engine/core/math/MathCustomTestingFramework.h"
+
+using namespace GLESC;
+using Transform::Position;
+using Transform::Rotation;
+using Transform::Scale;
+using Transform::Transformer;
+
+namespace {
+    /**
+     * @brief Reference implementation, transforms the 8 corners and takes the box that encloses them.
+     */
+    Math::BoundingVolume transformCorners(const Math::BoundingVolume& boundingVolume, const Render::Model& model) {
+        const auto& box = boundingVolume.getVolume();
+        Position min(std::numeric_limits<float>::max());
+        Position max(std::numeric_limits<float>::lowest());
+        for (int corner = 0; corner < 8; corner++) {
+            Position point((corner & 1) ? box.max.getX() : box.min.getX(),
+                           (corner & 2) ? box.max.getY() : box.min.getY(),
+                           (corner & 4) ? box.max.getZ() : box.min.getZ());
+            Position transformed = Transformer::transformVector(point, model);
+            for (size_t axis = 0; axis < 3; axis++) {
+                min.set(axis, std::min(min.get(axis), transformed.get(axis)));
+                max.set(axis, std::max(max.get(axis), transformed.get(axis)));
+            }
+        }
+        return {min, max};
+    }
+
+    void expectNear(const Vec3F& actual, const Vec3F& expected) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            EXPECT_NEAR(actual.get(axis), expected.get(axis), 1e-4f) << "Axis " << axis;
+        }
+    }
+}
+
+TEST(TransformerTests, BoundingVolumeIsTranslated) {
+    Math::BoundingVolume box(Vec3F(-1, -2, -3), Vec3F(1, 2, 3));
+    Transform::Transform transform(Position(10, 20, 30), Rotation(0, 0, 0), Scale(1, 1, 1));
+    Math::BoundingVolume transformed = Transformer::transformBoundingVolume(box, transform);
+    expectNear(transformed.getMin(), Vec3F(9, 18, 27));
+    expectNear(transformed.getMax(), Vec3F(11, 22, 33));
+}
+
+TEST(TransformerTests, BoundingVolumeIsScaled) {
+    Math::BoundingVolume box(Vec3F(0, 0, 0), Vec3F(1, 1, 1));
+    Transform::Transform transform(Position(0, 0, 0), Rotation(0, 0, 0), Scale(2, 3, 4));
+    Math::BoundingVolume transformed = Transformer::transformBoundingVolume(box, transform);
+    expectNear(transformed.getMin(), Vec3F(0, 0, 0));
+    expectNear(transformed.getMax(), Vec3F(2, 3, 4));
+}
+
+TEST(TransformerTests, NegativeScaleDoesNotInvertTheBox) {
+    Math::BoundingVolume box(Vec3F(-1, -1, -1), Vec3F(2, 2, 2));
+    Transform::Transform transform(Position(0, 0, 0), Rotation(0, 0, 0), Scale(-1, 1, 1));
+    Math::BoundingVolume transformed = Transformer::transformBoundingVolume(box, transform);
+    expectNear(transformed.getMin(), Vec3F(-2, -1, -1));
+    expectNear(transformed.getMax(), Vec3F(1, 2, 2));
+}
+
+TEST(TransformerTests, RotatedBoundingVolumeEnclosesTheCorners) {
+    // A unit cube rotated 45 degrees around y is sqrt(2) wide in x and z
+    Math::BoundingVolume box(Vec3F(-1, -1, -1), Vec3F(1, 1, 1));
+    Transform::Transform transform(Position(0, 0, 0), Rotation(0, 45, 0), Scale(1, 1, 1));
+    Math::BoundingVolume transformed = Transformer::transformBoundingVolume(box, transform);
+    const float halfDiagonal = std::sqrt(2.0f);
+    expectNear(transformed.getMin(), Vec3F(-halfDiagonal, -1, -halfDiagonal));
+    expectNear(transformed.getMax(), Vec3F(halfDiagonal, 1, halfDiagonal));
+}
+
+TEST(TransformerTests, MatchesTransformingTheEightCorners) {
+    std::mt19937 random(99);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 5.0f);
+    for (int i = 0; i < 200; i++) {
+        Vec3F min(position(random), position(random), position(random));
+        Vec3F size(scale(random), scale(random), scale(random));
+        Math::BoundingVolume box(min, min + size);
+        Transform::Transform transform(Position(position(random), position(random), position(random)),
+                                       Rotation(angle(random), angle(random), angle(random)),
+                                       Scale(scale(random), scale(random), scale(random)));
+        Render::Model model = transform.getModelMatrix();
+
+        Math::BoundingVolume transformed = Transformer::transformBoundingVolume(box, model);
+        Math::BoundingVolume expected = transformCorners(box, model);
+        for (size_t axis = 0; axis < 3; axis++) {
+            EXPECT_LE(transformed.getMin().get(axis), transformed.getMax().get(axis));
+            // Both compute the same bound with a different order of operations, only the rounding differs
+            EXPECT_NEAR(transformed.getMin().get(axis), expected.getMin().get(axis), 1e-3f);
+            EXPECT_NEAR(transformed.getMax().get(axis), expected.getMax().get(axis), 1e-3f);
+        }
+    }
+}
+
+#if RENDERING_BENCHMARKING
+TEST(TransformerTests, BenchmarkBoundingVolumeTransform) {
+    constexpr int iterations = 100000;
+    Math::BoundingVolume box(Vec3F(-1, -2, -3), Vec3F(1, 2, 3));
+    Transform::Transform transform(Position(1, 2, 3), Rotation(30, 60, 90), Scale(1, 2, 3));
+    Render::Model model = transform.getModelMatrix();
+
+    auto measure = [&](const char* name, auto&& transformBox) {
+        float checksum = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            model[3][0] = static_cast<float>(i % 7);
+            checksum += transformBox().getMax().getX();
+        }
+        auto end = std::chrono::steady_clock::now();
+        double nanos = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::cout << "Bounding volume transform, " << name << ": " << nanos << " ns (" << checksum << ")\n";
+    };
+    measure("center and extent", [&] { return Transformer::transformBoundingVolume(box, model); });
+    measure("eight corners", [&] { return transformCorners(box, model); });
+}
+#endif
+#endif